@@ -54,6 +54,9 @@
  * Local Variables
  *****************************************************************************/
 
+/** Simulated elapsed time in ms, which is added to the timestamp. */
+static unsigned long gMillisOffset = 0UL;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -74,7 +77,12 @@ extern unsigned long millis()
 {
     clock_t now = clock();
 
-    return (now * 1000UL) / CLOCKS_PER_SEC;
+    return ((now * 1000UL) / CLOCKS_PER_SEC) + gMillisOffset;
+}
+
+extern void advanceMillis(unsigned long period)
+{
+    gMillisOffset += period;
 }
 
 extern uint32_t esp_log_timestamp(void)
@@ -82,6 +90,18 @@ extern uint32_t esp_log_timestamp(void)
     return millis();
 }
 
+extern long random(long howBig)
+{
+    long value = 0L;
+
+    if (0L < howBig)
+    {
+        value = rand() % howBig;
+    }
+
+    return value;
+}
+
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
\ No newline at end of file
@@ -85,6 +85,23 @@ extern unsigned long millis();
  */
 extern uint32_t esp_log_timestamp(void);
 
+/**
+ * Advance the timestamp, which is returned by millis(). This simulates
+ * elapsed time in the tests, without waiting for it.
+ * 
+ * @param[in] period    Period in ms
+ */
+extern void advanceMillis(unsigned long period);
+
+/**
+ * Get a pseudo random number.
+ * 
+ * @param[in] howBig    Upper bound of the random number, exclusive.
+ * 
+ * @return Random number between 0 and howBig - 1.
+ */
+extern long random(long howBig);
+
 #endif  /* ARDUINO_H */
 
 /** @} */
\ No newline at end of file
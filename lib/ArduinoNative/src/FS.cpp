@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "FS.h"
 
+#include <sys/stat.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -58,6 +60,76 @@
  * Public Methods
  *****************************************************************************/
 
+size_t File::size() const
+{
+    size_t fileSize = 0U;
+
+    if (nullptr != m_fd)
+    {
+        long pos = ftell(m_fd);
+
+        if (0 == fseek(m_fd, 0, SEEK_END))
+        {
+            fileSize = ftell(m_fd);
+        }
+
+        (void)fseek(m_fd, pos, SEEK_SET);
+    }
+
+    return fileSize;
+}
+
+time_t File::getLastWrite()
+{
+    time_t      lastWrite = 0;
+    struct stat fileStat;
+
+    if ((nullptr != m_fd) &&
+        (0 == fstat(fileno(m_fd), &fileStat)))
+    {
+        lastWrite = fileStat.st_mtime;
+    }
+
+    return lastWrite;
+}
+
+size_t File::write(uint8_t data)
+{
+    return write(&data, sizeof(data));
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    size_t written = 0U;
+
+    if (nullptr != m_fd)
+    {
+        written = fwrite(buf, 1, size, m_fd);
+    }
+
+    return written;
+}
+
+bool FS::remove(const char* path)
+{
+    return (0 == ::remove(path));
+}
+
+bool FS::remove(const String& path)
+{
+    return remove(path.c_str());
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo)
+{
+    return (0 == ::rename(pathFrom, pathTo));
+}
+
+bool FS::rename(const String& pathFrom, const String& pathTo)
+{
+    return rename(pathFrom.c_str(), pathTo.c_str());
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -43,8 +43,10 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 /******************************************************************************
  * Macros
@@ -301,6 +303,15 @@ public:
         return *this;
     }
 
+    String& operator +=(int value)
+    {
+        char buffer[12];
+
+        (void)snprintf(buffer, sizeof(buffer), "%d", value);
+
+        return *this += String(buffer);
+    }
+
     String operator +(const String& str) const
     {
         String tmp = *this;
@@ -399,6 +410,74 @@ public:
         return out;
     }
 
+    /**
+     * Get the index of the last occurrence of the character.
+     *
+     * @param[in] c Character
+     *
+     * @return Index of the character. If not found, it will return -1.
+     */
+    int lastIndexOf(char c) const
+    {
+        int index = -1;
+
+        if (nullptr != m_buffer)
+        {
+            const char* ptr = strrchr(m_buffer, c);
+
+            if (nullptr != ptr)
+            {
+                index = static_cast<int>(ptr - m_buffer);
+            }
+        }
+
+        return index;
+    }
+
+    /**
+     * Get the index of the first occurrence of the character, starting at
+     * the given index.
+     *
+     * @param[in] c         Character
+     * @param[in] fromIndex Index, where to start the search.
+     *
+     * @return Index of the character. If not found, it will return -1.
+     */
+    int indexOf(char c, unsigned int fromIndex = 0U) const
+    {
+        int index = -1;
+
+        if ((nullptr != m_buffer) &&
+            (length() > fromIndex))
+        {
+            const char* ptr = strchr(&m_buffer[fromIndex], c);
+
+            if (nullptr != ptr)
+            {
+                index = static_cast<int>(ptr - m_buffer);
+            }
+        }
+
+        return index;
+    }
+
+    /**
+     * Ends string with given pattern?
+     *
+     * @param[in] s2    Pattern
+     *
+     * @return If string ends with pattern, it will return true otherwise false.
+     */
+    unsigned char endsWith(const String &s2) const
+    {
+        if(length() < s2.length())
+        {
+            return 0U;
+        }
+
+        return startsWith(s2, length() - s2.length());
+    }
+
     /**
      * Starts string with given pattern?
      *
@@ -436,6 +515,75 @@ public:
         return 0 == strncmp(&m_buffer[offset], s2.m_buffer, s2.length());
     }
 
+    /**
+     * Compare two strings case insensitive.
+     *
+     * @param[in] s2    String, which to compare with.
+     *
+     * @return If the strings are equal, it will return true otherwise false.
+     */
+    unsigned char equalsIgnoreCase(const String &s2) const
+    {
+        const char*     str1    = c_str();
+        const char*     str2    = s2.c_str();
+        unsigned int    index   = 0U;
+
+        if (length() != s2.length())
+        {
+            return 0U;
+        }
+
+        while('\0' != str1[index])
+        {
+            if (tolower(static_cast<unsigned char>(str1[index])) != tolower(static_cast<unsigned char>(str2[index])))
+            {
+                return 0U;
+            }
+
+            ++index;
+        }
+
+        return 1U;
+    }
+
+    /**
+     * Remove all characters from the index to the end.
+     *
+     * @param[in] index Index
+     */
+    void remove(unsigned int index)
+    {
+        if (length() > index)
+        {
+            m_buffer[index] = '\0';
+        }
+    }
+
+    /**
+     * Remove leading and trailing whitespace.
+     */
+    void trim()
+    {
+        unsigned int    len     = length();
+        unsigned int    begin   = 0U;
+
+        while((len > begin) && (0 != isspace(static_cast<unsigned char>(m_buffer[begin]))))
+        {
+            ++begin;
+        }
+
+        while((begin < len) && (0 != isspace(static_cast<unsigned char>(m_buffer[len - 1U]))))
+        {
+            --len;
+        }
+
+        if (nullptr != m_buffer)
+        {
+            memmove(m_buffer, &m_buffer[begin], len - begin);
+            m_buffer[len - begin] = '\0';
+        }
+    }
+
     /**
      * Clear string.
      */
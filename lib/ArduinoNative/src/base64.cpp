@@ -0,0 +1,116 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Base64 encoding for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "base64.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Base64 alphabet */
+static const char   BASE64_ALPHABET[]   = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+String base64::encode(const uint8_t* data, size_t length)
+{
+    String  result;
+    size_t  index   = 0U;
+
+    while(length > index)
+    {
+        uint32_t    value   = static_cast<uint32_t>(data[index]) << 16U;
+        size_t      count   = length - index;
+
+        if (1U < count)
+        {
+            value |= static_cast<uint32_t>(data[index + 1U]) << 8U;
+        }
+
+        if (2U < count)
+        {
+            value |= static_cast<uint32_t>(data[index + 2U]);
+        }
+
+        result += BASE64_ALPHABET[(value >> 18U) & 0x3FU];
+        result += BASE64_ALPHABET[(value >> 12U) & 0x3FU];
+        result += (1U < count) ? BASE64_ALPHABET[(value >> 6U) & 0x3FU] : '=';
+        result += (2U < count) ? BASE64_ALPHABET[value & 0x3FU] : '=';
+
+        index += 3U;
+    }
+
+    return result;
+}
+
+String base64::encode(const String& text)
+{
+    const void* vText = text.c_str();
+
+    return encode(static_cast<const uint8_t*>(vText), text.length());
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,206 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  SHA-1 for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "sha1.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t rotateLeft(uint32_t value, uint32_t bits);
+static void processBlock(uint32_t state[5], const unsigned char block[64]);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern int mbedtls_sha1_ret(const unsigned char* input, size_t ilen, unsigned char output[20])
+{
+    uint32_t        state[5]    = { 0x67452301U, 0xEFCDAB89U, 0x98BADCFEU, 0x10325476U, 0xC3D2E1F0U };
+    unsigned char   block[64];
+    size_t          index       = 0U;
+    size_t          rest        = 0U;
+    uint64_t        bitLength   = static_cast<uint64_t>(ilen) * 8U;
+
+    while(64U <= (ilen - index))
+    {
+        processBlock(state, &input[index]);
+        index += 64U;
+    }
+
+    /* Padding: 0x80, zeros and the message length in bit (big endian). */
+    rest = ilen - index;
+    memset(block, 0, sizeof(block));
+    memcpy(block, &input[index], rest);
+    block[rest] = 0x80U;
+
+    if (56U <= (rest + 1U))
+    {
+        processBlock(state, block);
+        memset(block, 0, sizeof(block));
+    }
+
+    for(index = 0U; index < 8U; ++index)
+    {
+        block[63U - index] = static_cast<unsigned char>(bitLength >> (8U * index));
+    }
+
+    processBlock(state, block);
+
+    for(index = 0U; index < 20U; ++index)
+    {
+        output[index] = static_cast<unsigned char>(state[index / 4U] >> (24U - (8U * (index % 4U))));
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Rotate left.
+ *
+ * @param[in] value Value
+ * @param[in] bits  Number of bits
+ *
+ * @return Rotated value
+ */
+static uint32_t rotateLeft(uint32_t value, uint32_t bits)
+{
+    return (value << bits) | (value >> (32U - bits));
+}
+
+/**
+ * Process a single 64 byte block.
+ *
+ * @param[in,out]   state   Hash state
+ * @param[in]       block   Block
+ */
+static void processBlock(uint32_t state[5], const unsigned char block[64])
+{
+    uint32_t    w[80];
+    uint32_t    a       = state[0];
+    uint32_t    b       = state[1];
+    uint32_t    c       = state[2];
+    uint32_t    d       = state[3];
+    uint32_t    e       = state[4];
+    size_t      index   = 0U;
+
+    for(index = 0U; index < 16U; ++index)
+    {
+        w[index] = (static_cast<uint32_t>(block[4U * index]) << 24U) |
+                   (static_cast<uint32_t>(block[(4U * index) + 1U]) << 16U) |
+                   (static_cast<uint32_t>(block[(4U * index) + 2U]) << 8U) |
+                   static_cast<uint32_t>(block[(4U * index) + 3U]);
+    }
+
+    for(index = 16U; index < 80U; ++index)
+    {
+        w[index] = rotateLeft(w[index - 3U] ^ w[index - 8U] ^ w[index - 14U] ^ w[index - 16U], 1U);
+    }
+
+    for(index = 0U; index < 80U; ++index)
+    {
+        uint32_t f      = 0U;
+        uint32_t k      = 0U;
+        uint32_t temp   = 0U;
+
+        if (20U > index)
+        {
+            f = (b & c) | ((~b) & d);
+            k = 0x5A827999U;
+        }
+        else if (40U > index)
+        {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1U;
+        }
+        else if (60U > index)
+        {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDCU;
+        }
+        else
+        {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6U;
+        }
+
+        temp    = rotateLeft(a, 5U) + f + e + k + w[index];
+        e       = d;
+        d       = c;
+        c       = rotateLeft(b, 30U);
+        b       = a;
+        a       = temp;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
@@ -33,9 +33,12 @@
  * Includes
  *****************************************************************************/
 #include "AsyncHttpClient.h"
+#include "HttpScheduler.h"
+#include "HttpStatus.h"
 
 #include <Util.h>
 #include <Logging.h>
+#include <Tracer.h>
 #include <base64.h>
 
 /******************************************************************************
@@ -58,33 +61,24 @@
  * Local Variables
  *****************************************************************************/
 
-/** Mutex buffer required for counting semaphore. */
-static StaticSemaphore_t    gxMutexBuffer;
-
-/**
- * Counting semaphore to serialize all asynchronous HTTP client requests.
- *  This is necessary, because a secure connection needs about 50k of heap.
- */
-static SemaphoreHandle_t    ghMutex         = xSemaphoreCreateMutexStatic(&gxMutexBuffer);
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 AsyncHttpClient::AsyncHttpClient() :
-    m_processTaskHandle(nullptr),
-    m_processTaskExit(false),
-    m_processTaskSemaphore(nullptr),
-    m_tcpClient(),
-    m_cmdQueue(),
-    m_evtQueue(),
     m_mutex(),
-    m_hasGlobalMutex(false),
     m_isConnected(false),
     m_isReqOpen(false),
+    m_connection(nullptr),
+    m_isReusedConnection(false),
+    m_isRetry(false),
+    m_isCacheable(false),
+    m_isRevalidating(false),
     m_onRspCallback(nullptr),
+    m_onRspPayloadCallback(nullptr),
     m_onClosedCallback(),
     m_onErrorCallback(),
+    m_url(),
     m_hostname(),
     m_port(0U),
     m_isSecure(false),
@@ -94,7 +88,9 @@ AsyncHttpClient::AsyncHttpClient() :
     m_method(),
     m_userAgent("AsyncHttpClient"),
     m_isHttpVer10(false),
-    m_isKeepAlive(false),
+    m_isKeepAlive(true),
+    m_priority(PRIORITY_NORMAL),
+    m_isCacheEnabled(true),
     m_urlEncodedPars(),
     m_payload(nullptr),
     m_payloadSize(0U),
@@ -106,107 +102,21 @@ AsyncHttpClient::AsyncHttpClient() :
     m_contentIndex(0U),
     m_chunkSize(0U),
     m_chunkIndex(0U),
-    m_chunkBodyPart(CHUNK_SIZE)
+    m_chunkBodyPart(CHUNK_SIZE),
+    m_isRspKeepAlive(false),
+    m_isRspCacheable(false),
+    m_rspMaxAge(0U),
+    m_cacheWriter()
 {
-    (void)m_cmdQueue.create(CMD_QUEUE_SIZE);
-    (void)m_evtQueue.create(EVT_QUEUE_SIZE);
     (void)m_mutex.create();
-
-    m_tcpClient.onConnect(  [this](void* arg, AsyncClient* client)
-                            {
-                                Event   evt;
-
-                                UTIL_NOT_USED(arg);
-                                UTIL_NOT_USED(client);
-
-                                memset(&evt, 0, sizeof(evt));
-                                evt.id = EVENT_ID_CONNECTED;
-
-                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
-                            });
-
-    m_tcpClient.onDisconnect(   [this](void* arg, AsyncClient* client)
-                                {
-                                    Event   evt;
-                                    
-                                    UTIL_NOT_USED(arg);
-                                    UTIL_NOT_USED(client);
-
-                                    memset(&evt, 0, sizeof(evt));
-                                    evt.id = EVENT_ID_DISCONNECTED;
-                                    
-                                    (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
-                                });
-
-    m_tcpClient.onError(    [this](void* arg, AsyncClient* client, int8_t error)
-                            {
-                                Event   evt;
-
-                                UTIL_NOT_USED(arg);
-                                UTIL_NOT_USED(client);
-
-                                memset(&evt, 0, sizeof(evt));
-                                evt.id      = EVENT_ID_ERROR;
-                                evt.u.error = error;
-
-                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
-                            });
-
-    m_tcpClient.onData( [this](void* arg, AsyncClient* client, void* data, size_t len)
-                        {
-                            Event   evt;
-
-                            UTIL_NOT_USED(arg);
-
-                            memset(&evt, 0, sizeof(evt));
-                            evt.id          = EVENT_ID_DATA;
-                            evt.u.data.data = new(std::nothrow) uint8_t[len];
-
-                            if (nullptr == evt.u.data.data)
-                            {
-                                LOG_ERROR("Couldn't allocate %u memory.", len);
-
-                                evt.u.data.size = 0U;
-                            }
-                            else
-                            {
-                                evt.u.data.size = len;
-                                memcpy(evt.u.data.data, data, len);
-                            }
-
-                            (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
-                        });
-
-    m_tcpClient.onTimeout(  [this](void* arg, AsyncClient* client, uint32_t timeout)
-                            {
-                                Event   evt;
-
-                                UTIL_NOT_USED(arg);
-
-                                memset(&evt, 0, sizeof(evt));
-                                evt.id          = EVENT_ID_TIMEOUT;
-                                evt.u.timeout   = timeout;
-
-                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
-                            });
 }
 
 AsyncHttpClient::~AsyncHttpClient()
 {
-    /* Unregister first all callbacks before cleaning the
-     * event queue.
-     */
-    m_tcpClient.onConnect(nullptr);
-    m_tcpClient.onDisconnect(nullptr);
-    m_tcpClient.onError(nullptr);
-    m_tcpClient.onData(nullptr);
-    m_tcpClient.onTimeout(nullptr);
     end();
 
     /* Destroy at the end. */
     m_mutex.destroy();
-    m_evtQueue.destroy();
-    m_cmdQueue.destroy();
 }
 
 bool AsyncHttpClient::begin(const String& url)
@@ -215,11 +125,6 @@ bool AsyncHttpClient::begin(const String& url)
     int     index       = url.indexOf(':');
     bool    isReqOpen   = false;
 
-    if (nullptr == m_processTaskHandle)
-    {
-        status = createProcessTask();
-    }
-
     /* Protect against concurrent access. */
     {
         MutexGuard<Mutex>   guard(m_mutex);
@@ -227,13 +132,8 @@ bool AsyncHttpClient::begin(const String& url)
         isReqOpen = m_isReqOpen;
     }
 
-    /* Task couldn't be created? */
-    if (false == status)
-    {
-        ;
-    }
     /* If a response is pending, abort. */
-    else if (true == isReqOpen)
+    if (true == isReqOpen)
     {
         status = false;
     }
@@ -338,6 +238,8 @@ bool AsyncHttpClient::begin(const String& url)
 
             if (true == status)
             {
+                m_url = url;
+
                 LOG_INFO("Host: %s", m_hostname.c_str());
                 LOG_INFO("Port: %u", m_port);
                 LOG_INFO("URI: %s", m_uri.c_str());
@@ -364,11 +266,17 @@ bool AsyncHttpClient::begin(const String& url)
 
 void AsyncHttpClient::end()
 {
-    destroyProcessTask();
-    clearCmdQueue();
-    clearEvtQueue();
+    HttpScheduler::getInstance().removeClient(*this);
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+
+        m_isConnected = false;
+    }
+
+    m_connection = nullptr;
     clear();
-    giveGlobalMutex();
 }
 
 bool AsyncHttpClient::isConnected()
@@ -389,6 +297,16 @@ void AsyncHttpClient::setKeepAlive(bool keepAlive)
     m_isKeepAlive = keepAlive;
 }
 
+void AsyncHttpClient::setPriority(Priority priority)
+{
+    m_priority = priority;
+}
+
+void AsyncHttpClient::setCacheEnabled(bool isEnabled)
+{
+    m_isCacheEnabled = isEnabled;
+}
+
 void AsyncHttpClient::addHeader(const String& name, const String& value)
 {
     /* Only add header if not handled by the client itself. */
@@ -437,6 +355,11 @@ void AsyncHttpClient::regOnResponse(const OnResponse& onResponse)
     m_onRspCallback = onResponse;
 }
 
+void AsyncHttpClient::regOnRspPayload(const OnRspPayload& onRspPayload)
+{
+    m_onRspPayloadCallback = onRspPayload;
+}
+
 void AsyncHttpClient::regOnClosed(const OnClosed& onClosed)
 {
     m_onClosedCallback = onClosed;
@@ -449,36 +372,17 @@ void AsyncHttpClient::regOnError(const OnError& onError)
 
 bool AsyncHttpClient::GET()
 {
-    Cmd cmd;
-    
-    memset(&cmd, 0, sizeof(cmd));
-    cmd.id = CMD_ID_GET;
-
-    return m_cmdQueue.sendToBack(cmd, portMAX_DELAY);
+    return queueRequest("GET", nullptr, 0U);
 }
 
 bool AsyncHttpClient::POST(const uint8_t* payload, size_t size)
 {
-    Cmd cmd;
-    
-    memset(&cmd, 0, sizeof(cmd));
-    cmd.id = CMD_ID_POST;
-    cmd.u.data.data = payload;
-    cmd.u.data.size = size;
-
-    return m_cmdQueue.sendToBack(cmd, portMAX_DELAY);
+    return queueRequest("POST", payload, size);
 }
 
 bool AsyncHttpClient::POST(const String& payload)
 {
-    Cmd cmd;
-    
-    memset(&cmd, 0, sizeof(cmd));
-    cmd.id = CMD_ID_POST;
-    cmd.u.data.data = reinterpret_cast<const uint8_t*>(payload.c_str());
-    cmd.u.data.size = payload.length();
-
-    return m_cmdQueue.sendToBack(cmd, portMAX_DELAY);
+    return queueRequest("POST", reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length());
 }
 
 /******************************************************************************
@@ -489,224 +393,160 @@ bool AsyncHttpClient::POST(const String& payload)
  * Private Methods
  *****************************************************************************/
 
-bool AsyncHttpClient::createProcessTask()
+bool AsyncHttpClient::queueRequest(const char* method, const uint8_t* payload, size_t size)
 {
     bool isSuccessful = false;
 
-    if (nullptr == m_processTaskSemaphore)
+    /* Protect against concurrent access. */
     {
-        /* Create binary semaphore to signal task exit. */
-        m_processTaskSemaphore = xSemaphoreCreateBinary();
+        MutexGuard<Mutex>   guard(m_mutex);
 
-        if (nullptr != m_processTaskSemaphore)
+        /* Only one request at a time and begin() must be successful called before. */
+        if ((false == m_isReqOpen) &&
+            (false == m_hostname.isEmpty()))
         {
-            BaseType_t  osRet   = pdFAIL;
-
-            /* Task shall run */
-            m_processTaskExit = false;
-
-            osRet = xTaskCreateUniversal(   processTask,
-                                            "AsyncHttpClientTask",
-                                            PROCESS_TASK_STACK_SIZE,
-                                            this,
-                                            PROCESS_TASK_PRIORITY,
-                                            &m_processTaskHandle,
-                                            PROCESS_TASK_RUN_CORE);
-
-            /* Couldn't task be created? */
-            if (pdPASS != osRet)
-            {
-                vSemaphoreDelete(m_processTaskSemaphore);
-                m_processTaskSemaphore = nullptr;
-            }
-            else
-            {
-                (void)xSemaphoreGive(m_processTaskSemaphore);
-                isSuccessful = true;
-            }
+            m_isReqOpen     = true;
+            isSuccessful    = true;
         }
     }
-    
-    return isSuccessful;
-}
 
-void AsyncHttpClient::destroyProcessTask()
-{
-    /* Is the task running? */
-    if (nullptr != m_processTaskSemaphore)
+    if (true == isSuccessful)
     {
-        /* Request task to exit and wait until its done. */
-        m_processTaskExit = true;
-        (void)xSemaphoreTake(m_processTaskSemaphore, portMAX_DELAY);
-        m_processTaskHandle = nullptr;
+        m_method                = method;
+        m_payload               = payload;
+        m_payloadSize           = size;
+        m_isReusedConnection    = false;
+        m_isRetry               = false;
+        m_isRevalidating        = false;
+
+        /* Only the response of a plain GET request is cached. */
+        m_isCacheable           = (true == m_isCacheEnabled) &&
+                                  (0 == strcmp(method, "GET")) &&
+                                  (nullptr == payload) &&
+                                  (true == m_urlEncodedPars.isEmpty());
+
+        if (false == HttpScheduler::getInstance().addRequest(*this))
+        {
+            MutexGuard<Mutex>   guard(m_mutex);
 
-        /* After task is destroyed, the signal semaphore can safely be destroyed. */
-        vSemaphoreDelete(m_processTaskSemaphore);
-        m_processTaskSemaphore = nullptr;
+            m_isReqOpen     = false;
+            isSuccessful    = false;
+        }
     }
+
+    return isSuccessful;
 }
 
-void AsyncHttpClient::clearCmdQueue()
+void AsyncHttpClient::onConnect()
 {
-    Cmd cmd;
+    TRACE_INSTANT("http.connect");
 
-    while(true == m_cmdQueue.receive(&cmd, 0U))
+    /* A kept alive connection is already established. */
+    if (false == m_isReusedConnection)
     {
-        (void)cmd;
+        LOG_INFO("Connected to %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
+        LOG_DEBUG("Available heap: %u", ESP.getFreeHeap());
     }
-}
 
-void AsyncHttpClient::clearEvtQueue()
-{
-    Event evt;
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
 
-    while(true == m_evtQueue.receive(&evt, 0U))
+        m_isConnected = true;
+    }
+
+    if (false == sendRequest())
     {
-        if (EVENT_ID_DATA == evt.id)
-        {
-            if (nullptr != evt.u.data.data)
-            {
-                delete[] evt.u.data.data;
-                evt.u.data.data = nullptr;
-                evt.u.data.size = 0U;
-            }
-        }
+        disconnect();
     }
 }
 
-void AsyncHttpClient::processTask(void* parameters)
+void AsyncHttpClient::onDisconnect()
 {
-    AsyncHttpClient* tthis = static_cast<AsyncHttpClient*>(parameters);
-
-    if ((nullptr != tthis) &&
-        (nullptr != tthis->m_processTaskSemaphore))
-    {
-        (void)xSemaphoreTake(tthis->m_processTaskSemaphore, portMAX_DELAY);
-
-        while(false == tthis->m_processTaskExit)
-        {
-            tthis->processCmdQueue();
-            tthis->processEvtQueue();
+    TRACE_INSTANT("http.disconnect");
 
-            delay(PROCESS_TASK_PERIOD);
-        }
-
-        /* Ensure that any pending request/connection is aborted. */
-        tthis->abort();
+    LOG_INFO("Disconnected from %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
+    LOG_DEBUG("Available heap: %u", ESP.getFreeHeap());
 
-        (void)xSemaphoreGive(tthis->m_processTaskSemaphore);
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        
+        m_isConnected = false;
     }
 
-    vTaskDelete(nullptr);
-}
+    m_connection = nullptr;
 
-void AsyncHttpClient::processCmdQueue()
-{
-    if (true == takeGlobalMutex())
+    /* A kept alive connection may be closed by the server in the meantime,
+     * before it received the request. In this case the request is retried
+     * once with a new connection.
+     */
+    if ((true == m_isReusedConnection) &&
+        (false == m_isRetry) &&
+        (RESPONSE_PART_STATUS_LINE == m_rspPart) &&
+        (true == m_rspLine.isEmpty()))
     {
-        Cmd cmd;
+        LOG_INFO("Retry request to %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
 
-        if (true == m_cmdQueue.receive(&cmd, 0U))
-        {
-            switch(cmd.id)
-            {
-            case CMD_ID_GET:
-                if (false == getRequest())
-                {
-                    giveGlobalMutex();
-                }
-                break;
-
-            case CMD_ID_POST:
-                if (false == postRequest(cmd.u.data.data, cmd.u.data.size))
-                {
-                    giveGlobalMutex();
-                }
-                break;
+        m_isReusedConnection    = false;
+        m_isRetry               = true;
 
-            default:
-                break;
-            };
-        }
-        else
+        if (false == HttpScheduler::getInstance().addRequest(*this))
         {
-            giveGlobalMutex();
+            clear();
+            notifyError();
+            notifyClosed();
         }
     }
-}
-
-void AsyncHttpClient::processEvtQueue()
-{
-    Event evt;
-
-    while(true == m_evtQueue.receive(&evt, 0U))
+    else
     {
-        switch(evt.id)
-        {
-        case EVENT_ID_CONNECTED:
-            onConnect();
-            break;
-
-        case EVENT_ID_DISCONNECTED:
-            onDisconnect();
-            break;
-
-        case EVENT_ID_ERROR:
-            onError(evt.u.error);
-            break;
-
-        case EVENT_ID_DATA:
-            onData(evt.u.data.data, evt.u.data.size);
-
-            if (nullptr != evt.u.data.data)
-            {
-                delete[] evt.u.data.data;
-                evt.u.data.data = nullptr;
-                evt.u.data.size = 0U;
-            }
-            break;
-
-        case EVENT_ID_TIMEOUT:
-            onTimeout(evt.u.timeout);
-            break;
-
-        default:
-            break;
-        };
+        clear();
+        notifyClosed();
     }
 }
 
-void AsyncHttpClient::onConnect()
+bool AsyncHttpClient::isCacheFresh()
 {
-    bool isReqOpen = false;
-
-    LOG_INFO("Connected to %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
-    LOG_DEBUG("Available heap: %u", ESP.getFreeHeap());
+    return (true == m_isCacheable) && (true == HttpCache::getInstance().isFresh(m_url));
+}
 
-    /* Protect against concurrent access. */
+void AsyncHttpClient::serveFromCache()
+{
+    if (true == replayCachedRsp())
     {
-        MutexGuard<Mutex>   guard(m_mutex);
+        LOG_INFO("Served from cache: %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
 
-        m_isConnected   = true;
-        isReqOpen       = m_isReqOpen;
-        m_isReqOpen     = false;
+        notifyResponse();
+        clear();
+        notifyClosed();
     }
-
-    /* Is there a queued request, which to send? */
-    if (true == isReqOpen)
+    /* The cached response is lost, request it from the server. */
+    else
     {
-        if (false == sendRequest())
+        m_rsp.clear();
+
+        if (false == HttpScheduler::getInstance().addRequest(*this))
         {
-            m_tcpClient.close();
+            onRequestFailed();
         }
     }
 }
 
-void AsyncHttpClient::onDisconnect()
+bool AsyncHttpClient::replayCachedRsp()
 {
-    LOG_INFO("Disconnected from %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
-    LOG_DEBUG("Available heap: %u", ESP.getFreeHeap());
+    m_rsp.clear();
+    m_rsp.addStatusLine("HTTP/1.1 200 OK");
+
+    return HttpCache::getInstance().read(
+        m_url,
+        [this](const uint8_t* data, size_t size)
+        {
+            handleRspPayload(data, size);
+        });
+}
 
+void AsyncHttpClient::onRequestFailed()
+{
     /* Protect against concurrent access. */
     {
         MutexGuard<Mutex>   guard(m_mutex);
@@ -714,10 +554,11 @@ void AsyncHttpClient::onDisconnect()
         m_isConnected = false;
     }
 
+    m_connection = nullptr;
+
     clear();
+    notifyError();
     notifyClosed();
-
-    giveGlobalMutex();
 }
 
 void AsyncHttpClient::onError(int8_t error)
@@ -746,6 +587,8 @@ void AsyncHttpClient::onError(int8_t error)
 
 void AsyncHttpClient::onData(const uint8_t* data, size_t len)
 {
+    TRACE_SCOPE("http.data");
+
     size_t      index       = 0U;
     const void* vData       = data;
     const char* asciiData   = static_cast<const char*>(vData);
@@ -759,7 +602,10 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
      *                [ message-body ]
      */
 
-    while((len > index) && (false == isError))
+    /* If the response is complete and the connection is released, any
+     * further data is not handled anymore.
+     */
+    while((len > index) && (false == isError) && (nullptr != m_connection))
     {
         switch(m_rspPart)
         {
@@ -786,18 +632,35 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
                 {
                     /* Not nice, but anyway. */
                     LOG_ERROR("Header error.");
-                    m_tcpClient.close();
+                    disconnect();
                     isError = true;
                 }
-                else if (TRANSFER_CODING_IDENTITY == m_transferCoding)
+                else if (true == isRspWithoutBody())
+                {
+                    handleRspComplete();
+                }
+                else
                 {
-                    /* "Content-Length" may be missing. */
-                    if (0U == m_contentLength)
+                    if (TRANSFER_CODING_IDENTITY == m_transferCoding)
                     {
-                        m_contentLength = len - index;
+                        /* "Content-Length" may be missing. */
+                        if (0U == m_contentLength)
+                        {
+                            m_contentLength = len - index;
+                        }
+
+                        /* Allocate the whole payload at once, instead of extending it
+                         * with every received part.
+                         */
+                        if ((nullptr == m_onRspPayloadCallback) &&
+                            (0U < m_contentLength))
+                        {
+                            m_rsp.extendPayload(m_contentLength);
+                        }
                     }
+
+                    m_rspPart = RESPONSE_PART_BODY;
                 }
-                m_rspPart = RESPONSE_PART_BODY;
             }
             break;
 
@@ -806,11 +669,7 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
             {
                 if (true == parseChunkedResponse(data, len, index))
                 {
-                    notifyResponse();
-
-                    m_transferCoding = TRANSFER_CODING_IDENTITY;
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
+                    handleRspComplete();
                 }
             }
             else
@@ -828,25 +687,20 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
                     copySize = available;
                 }
 
-                m_rsp.addPayload(&data[index], copySize);
+                handleRspPayload(&data[index], copySize);
                 m_contentIndex += copySize;
                 index += copySize;
 
                 if (m_contentLength <= m_contentIndex)
                 {
-                    notifyResponse();
-
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
-                    m_contentLength = 0U;
-                    m_contentIndex = 0U;
+                    handleRspComplete();
                 }
             }
             break;
 
         default:
             LOG_FATAL("Internal error.");
-            m_tcpClient.close();
+            disconnect();
             isError = true;
             break;
         }
@@ -858,117 +712,23 @@ void AsyncHttpClient::onTimeout(uint32_t timeout)
     UTIL_NOT_USED(timeout);
 
     LOG_WARNING("Connection timeout of %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
-    m_tcpClient.close();
-}
-
-bool AsyncHttpClient::connect()
-{
-    LOG_INFO("Connecting to %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
-    LOG_DEBUG("Available heap: %u", ESP.getFreeHeap());
-
-    return m_tcpClient.connect(m_hostname.c_str(), m_port, m_isSecure);
+    disconnect();
 }
 
 void AsyncHttpClient::disconnect()
 {
-    if (true == m_tcpClient.connected())
+    if ((nullptr != m_connection) &&
+        (true == m_connection->getTcpClient().connected()))
     {
         LOG_INFO("Disconnecting from %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
-        m_tcpClient.close();
-    }
-}
-
-void AsyncHttpClient::abort()
-{
-    if (true == m_tcpClient.connected())
-    {
-        LOG_INFO("Aborting connection to %s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
-        m_tcpClient.abort();
-    }
-}
-
-bool AsyncHttpClient::getRequest()
-{
-    bool status     = false;
-    bool isReqOpen  = false;
-
-    /* Protect against concurrent access. */
-    {
-        MutexGuard<Mutex>   guard(m_mutex);
-
-        isReqOpen = m_isReqOpen;
-    }
-
-    if (false == isReqOpen)
-    {
-        m_method        = "GET";
-        m_payload       = nullptr;
-        m_payloadSize   = 0U;
-
-        if (false == m_tcpClient.connected())
-        {
-            status = connect();
-            isReqOpen = status;
-        }
-        else
-        {
-            status = sendRequest();
-            isReqOpen = false;
-        }
-
-        /* Protect against concurrent access. */
-        {
-            MutexGuard<Mutex>   guard(m_mutex);
-
-            m_isReqOpen = isReqOpen;
-        }
+        m_connection->getTcpClient().close();
     }
-
-    return status;
-}
-
-bool AsyncHttpClient::postRequest(const uint8_t* payload, size_t size)
-{
-    bool status     = false;
-    bool isReqOpen  = false;
-
-    /* Protect against concurrent access. */
-    {
-        MutexGuard<Mutex>   guard(m_mutex);
-
-        isReqOpen = m_isReqOpen;
-    }
-
-    if (false == isReqOpen)
-    {
-        m_method        = "POST";
-        m_payload       = payload;
-        m_payloadSize   = size;
-
-        if (false == m_tcpClient.connected())
-        {
-            status = connect();
-            isReqOpen = status;
-        }
-        else
-        {
-            status = sendRequest();
-            isReqOpen = false;
-        }
-
-        /* Protect against concurrent access. */
-        {
-            MutexGuard<Mutex>   guard(m_mutex);
-
-            m_isReqOpen = isReqOpen;
-        }
-    }
-
-    return status;
 }
 
 bool AsyncHttpClient::sendRequest()
 {
+    TRACE_SCOPE("http.request");
+
     bool        status      = false;
     String      request;
     const char* PROTOCOL    = "HTTP";
@@ -1101,18 +861,46 @@ bool AsyncHttpClient::sendRequest()
         m_payloadSize   = m_urlEncodedPars.length();
     }
 
+    /* Revalidate a stale cached response with its validators. The server
+     * answers with "304 Not Modified", if it is still valid.
+     */
+    if (true == m_isCacheable)
+    {
+        String eTag;
+        String lastModified;
+
+        if (true == HttpCache::getInstance().getValidators(m_url, eTag, lastModified))
+        {
+            if (false == eTag.isEmpty())
+            {
+                request += "If-None-Match: ";
+                request += eTag;
+                request += CRLF;
+            }
+
+            if (false == lastModified.isEmpty())
+            {
+                request += "If-Modified-Since: ";
+                request += lastModified;
+                request += CRLF;
+            }
+
+            m_isRevalidating = (false == eTag.isEmpty()) || (false == lastModified.isEmpty());
+        }
+    }
+
     request += m_headers;
     request += CRLF;
 
     /* Send header */
-    status = (request.length() == m_tcpClient.write(request.c_str(), request.length()));
+    status = (request.length() == m_connection->getTcpClient().write(request.c_str(), request.length()));
 
     /* Send payload */
     if ((true == status) &&
         (nullptr != m_payload) &&
         (0U < m_payloadSize))
     {
-        status = (m_payloadSize == m_tcpClient.write(reinterpret_cast<const char*>(m_payload), m_payloadSize, 0));
+        status = (m_payloadSize == m_connection->getTcpClient().write(reinterpret_cast<const char*>(m_payload), m_payloadSize, 0));
     }
 
     return status;
@@ -1120,6 +908,7 @@ bool AsyncHttpClient::sendRequest()
 
 void AsyncHttpClient::clear()
 {
+    m_url.clear();
     m_hostname.clear();
     m_port = 0U;
     m_base64Authorization.clear();
@@ -1136,6 +925,12 @@ void AsyncHttpClient::clear()
     m_chunkSize = 0U;
     m_chunkIndex = 0U;
     m_chunkBodyPart = CHUNK_SIZE;
+    m_isRspKeepAlive = false;
+    m_isCacheable = false;
+    m_isRevalidating = false;
+    m_isRspCacheable = false;
+    m_rspMaxAge = 0U;
+    m_cacheWriter.abort();
 
     /* Protect against concurrent access. */
     {
@@ -1180,6 +975,12 @@ bool AsyncHttpClient::handleRspHeader()
     bool    isSuccess = true;
     String  value;
 
+    /* Only HTTP/1.1 connections are kept alive. Whether a secure connection
+     * is kept alive, is decided by the scheduler after the connection is
+     * released, because of its heap consumption.
+     */
+    m_isRspKeepAlive = (true == m_isKeepAlive) && (false == m_isHttpVer10);
+
     /* Connection = "Connection" ":" 1#(connection-token)
      * connection-token = token
      *
@@ -1195,10 +996,10 @@ bool AsyncHttpClient::handleRspHeader()
         if (0 <= value.indexOf("close"))
         {
             /* Client want a permanent connection? */
-            if (true == m_isKeepAlive)
+            if (true == m_isRspKeepAlive)
             {
-                LOG_WARNING("Connection can not be kept-alive.");
-                m_isKeepAlive = false;
+                LOG_DEBUG("Connection can not be kept-alive.");
+                m_isRspKeepAlive = false;
             }
         }
     }
@@ -1229,10 +1030,147 @@ bool AsyncHttpClient::handleRspHeader()
             isSuccess = false;
         }
     }
+    /* Without "Content-Length", the end of the body is only recognized by closing the connection. */
+    else if ((true == m_rsp.getHeader("Content-Length").isEmpty()) &&
+             (false == isRspWithoutBody()))
+    {
+        m_isRspKeepAlive = false;
+    }
+    else
+    {
+        ;
+    }
+
+    if (true == isSuccess)
+    {
+        handleRspCacheHeader();
+    }
 
     return isSuccess;
 }
 
+void AsyncHttpClient::handleRspCacheHeader()
+{
+    String  cacheControl    = m_rsp.getHeader("Cache-Control");
+    bool    isStorable      = true;
+    int     index           = 0;
+
+    m_isRspCacheable    = false;
+    m_rspMaxAge         = 0U;
+
+    /* RFC7234 - 5.2.2. Response Cache-Control Directives
+     * Without "max-age" the response is stale immediately and must be
+     * revalidated, the same as with "no-cache".
+     */
+    cacheControl.toLowerCase();
+
+    if (0 <= cacheControl.indexOf("no-store"))
+    {
+        isStorable = false;
+    }
+    else if (0 <= cacheControl.indexOf("no-cache"))
+    {
+        m_rspMaxAge = 0U;
+    }
+    else
+    {
+        index = cacheControl.indexOf("max-age=");
+
+        if (0 <= index)
+        {
+            long maxAge = cacheControl.substring(index + 8).toInt();
+
+            if (0 < maxAge)
+            {
+                m_rspMaxAge = static_cast<uint32_t>(maxAge);
+            }
+        }
+    }
+
+    if ((true == m_isCacheable) &&
+        (true == isStorable) &&
+        (HttpStatus::STATUS_CODE_OK == m_rsp.getStatusCode()) &&
+        ((0U < m_rspMaxAge) ||
+         (false == m_rsp.getHeader("ETag").isEmpty()) ||
+         (false == m_rsp.getHeader("Last-Modified").isEmpty())))
+    {
+        /* The payload size must be known in advance, otherwise it would
+         * be necessary to wait for the connection close.
+         */
+        if (TRANSFER_CODING_CHUNKED == m_transferCoding)
+        {
+            m_isRspCacheable = true;
+        }
+        else if ((false == m_rsp.getHeader("Content-Length").isEmpty()) &&
+                 (HttpCache::MAX_ENTRY_SIZE >= m_contentLength))
+        {
+            m_isRspCacheable = true;
+        }
+        else
+        {
+            ;
+        }
+
+        /* The payload is provided to the application part by part,
+         * therefore a copy is needed for the cache. If the payload size
+         * is unknown, the copy stops as soon as it can't be cached anymore.
+         */
+        if ((true == m_isRspCacheable) &&
+            (nullptr != m_onRspPayloadCallback))
+        {
+            size_t expectedSize = (TRANSFER_CODING_CHUNKED == m_transferCoding) ? 0U : m_contentLength;
+
+            m_isRspCacheable = m_cacheWriter.begin(expectedSize);
+        }
+    }
+}
+
+void AsyncHttpClient::handleRspCache()
+{
+    uint16_t statusCode = m_rsp.getStatusCode();
+
+    if ((true == m_isRevalidating) &&
+        (HttpStatus::STATUS_CODE_NOT_MODIFIED == statusCode))
+    {
+        HttpCache::getInstance().refresh(m_url, m_rspMaxAge);
+
+        /* The application gets the cached response instead. */
+        if (false == replayCachedRsp())
+        {
+            LOG_WARNING("Cached response of %s:%u%s lost.", m_hostname.c_str(), m_port, m_uri.c_str());
+        }
+    }
+    else if (true == m_isRspCacheable)
+    {
+        if (nullptr != m_onRspPayloadCallback)
+        {
+            HttpCache::getInstance().write(m_url, m_cacheWriter, m_rsp.getHeader("ETag"), m_rsp.getHeader("Last-Modified"), m_rspMaxAge);
+        }
+        else
+        {
+            size_t          size    = 0U;
+            const uint8_t*  payload = m_rsp.getPayload(size);
+
+            HttpCache::getInstance().write(m_url, payload, size, m_rsp.getHeader("ETag"), m_rsp.getHeader("Last-Modified"), m_rspMaxAge);
+        }
+    }
+    /* A outdated cached response shall not be used anymore. */
+    else if ((true == m_isRevalidating) &&
+             (HttpStatus::STATUS_CODE_OK == statusCode))
+    {
+        HttpCache::getInstance().remove(m_url);
+    }
+    else
+    {
+        ;
+    }
+
+    m_isRevalidating = false;
+    m_isRspCacheable = false;
+    m_rspMaxAge = 0U;
+    m_cacheWriter.abort();
+}
+
 bool AsyncHttpClient::parseChunkedResponseSize(const char* data, size_t len, size_t& index)
 {
     bool isSizeEOF = false;
@@ -1275,7 +1213,7 @@ bool AsyncHttpClient::parseChunkedResponseChunkData(const uint8_t* data, size_t
         copySize = available;
     }
 
-    m_rsp.addPayload(&data[index], copySize);
+    handleRspPayload(&data[index], copySize);
     index += copySize;
     m_chunkIndex += copySize;
 
@@ -1382,8 +1320,11 @@ bool AsyncHttpClient::parseChunkedResponse(const uint8_t* data, size_t len, size
                 {
                     m_chunkBodyPart = CHUNK_DATA;
 
-                    /* Extend response payload */
-                    m_rsp.extendPayload(m_chunkSize);
+                    /* Extend response payload, if its stored. */
+                    if (nullptr == m_onRspPayloadCallback)
+                    {
+                        m_rsp.extendPayload(m_chunkSize);
+                    }
                 }
             }
             break;
@@ -1480,6 +1421,72 @@ bool AsyncHttpClient::parseRspHeader(const char* data, size_t len, size_t& index
     return isHeaderEOF;
 }
 
+void AsyncHttpClient::handleRspComplete()
+{
+    handleRspCache();
+    notifyResponse();
+
+    m_transferCoding = TRANSFER_CODING_IDENTITY;
+    m_rspPart = RESPONSE_PART_STATUS_LINE;
+    m_rsp.clear();
+    m_contentLength = 0U;
+    m_contentIndex = 0U;
+
+    /* Release the connection for the next request. Otherwise the request
+     * is finished as soon as the server closes the connection.
+     */
+    if ((true == m_isRspKeepAlive) &&
+        (nullptr != m_connection))
+    {
+        HttpConnection* connection = m_connection;
+
+        /* Protect against concurrent access. */
+        {
+            MutexGuard<Mutex>   guard(m_mutex);
+
+            m_isConnected = false;
+        }
+
+        m_connection = nullptr;
+        HttpScheduler::getInstance().releaseConnection(*connection);
+
+        clear();
+        notifyClosed();
+    }
+}
+
+bool AsyncHttpClient::isRspWithoutBody()
+{
+    const uint16_t  STATUS_CODE_NO_CONTENT      = 204U;
+    const uint16_t  STATUS_CODE_NOT_MODIFIED    = 304U;
+    uint16_t        statusCode                  = m_rsp.getStatusCode();
+
+    /* RFC7230 - 3.3.3. Message Body Length */
+    return ((STATUS_CODE_NO_CONTENT == statusCode) ||
+            (STATUS_CODE_NOT_MODIFIED == statusCode) ||
+            ((TRANSFER_CODING_IDENTITY == m_transferCoding) &&
+             (false == m_rsp.getHeader("Content-Length").isEmpty()) &&
+             (0U == m_contentLength)));
+}
+
+void AsyncHttpClient::handleRspPayload(const uint8_t* payload, size_t size)
+{
+    if (nullptr != m_onRspPayloadCallback)
+    {
+        m_onRspPayloadCallback(payload, size);
+
+        /* Keep a copy for the cache, as long as it can be cached. */
+        if (true == m_isRspCacheable)
+        {
+            m_isRspCacheable = m_cacheWriter.write(payload, size);
+        }
+    }
+    else
+    {
+        m_rsp.addPayload(payload, size);
+    }
+}
+
 void AsyncHttpClient::notifyResponse()
 {
     if (nullptr != m_onRspCallback)
@@ -1638,34 +1645,6 @@ const char* AsyncHttpClient::errorToStr(int8_t error)
     return errorDescription;
 }
 
-bool AsyncHttpClient::takeGlobalMutex()
-{
-    bool isTaken = false;
-
-    if (false == m_hasGlobalMutex)
-    {
-        const uint32_t MAX_WAIT_TIME = 100U; /* ms */
-
-        if (pdTRUE == xSemaphoreTake(ghMutex, MAX_WAIT_TIME * portTICK_PERIOD_MS))
-        {
-            m_hasGlobalMutex = true;
-
-            isTaken = true;
-        }
-    }
-    
-    return isTaken;
-}
-
-void AsyncHttpClient::giveGlobalMutex()
-{
-    if (true == m_hasGlobalMutex)
-    {
-        (void)xSemaphoreGive(ghMutex);
-        m_hasGlobalMutex = false;
-    }
-}
-
 /******************************************************************************
  * External Functions
  *****************************************************************************/
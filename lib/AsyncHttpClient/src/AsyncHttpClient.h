@@ -43,12 +43,11 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include <freertos/FreeRTOS.h>
-#include <AsyncTCP.h>
-#include <Queue.hpp>
 #include <Mutex.hpp>
+#include <HttpCache.h>
 
 #include "HttpResponse.h"
+#include "HttpConnection.hpp"
 
 /******************************************************************************
  * Macros
@@ -61,6 +60,11 @@
 /**
  * Asynchronous HTTP client
  *
+ * The requests of all clients are served by the HTTP scheduler, which
+ * reuses kept alive connections to the same server. Responses of GET
+ * requests are cached according to the server cache directives and
+ * shared by all clients.
+ *
  * Used RFCs:
  * - RFC2616 (obsolete, because of RFC7230)
  * - RFC7230
@@ -74,6 +78,11 @@ public:
      */
     typedef std::function<void(const HttpResponse& rsp)> OnResponse;
 
+    /**
+     * Prototype of HTTP response callback for a received part of the response payload.
+     */
+    typedef std::function<void(const uint8_t* payload, size_t size)> OnRspPayload;
+
     /**
      * Prototype of HTTP response callback for a closed connection.
      */
@@ -84,6 +93,16 @@ public:
      */
     typedef std::function<void()> OnError;
 
+    /**
+     * Request priority. Queued requests with a higher priority are served first.
+     */
+    enum Priority
+    {
+        PRIORITY_LOW = 0,   /**< Low priority, e.g. for background updates. */
+        PRIORITY_NORMAL,    /**< Normal priority (default) */
+        PRIORITY_HIGH       /**< High priority, e.g. for time critical notifications. */
+    };
+
     /**
      * Constructs a http client.
      */
@@ -125,11 +144,41 @@ public:
 
     /**
      * Keep connection alive or close it after a request.
+     * A kept alive connection is reused by the next request to the same server.
+     * Default is to keep it alive. Only one secure connection is kept alive
+     * at a time and only if enough heap is left, because of its heap
+     * consumption.
      *
      * @param[in] keepAlive Keep alive (true) or close (false) it.
      */
     void setKeepAlive(bool keepAlive);
 
+    /**
+     * Set the priority of the following requests.
+     *
+     * @param[in] priority  Request priority
+     */
+    void setPriority(Priority priority);
+
+    /**
+     * Enable or disable the response cache for the following requests.
+     * The cache is enabled by default and considers only GET requests.
+     * Disable it for requests with side effects, e.g. notifications.
+     *
+     * @param[in] isEnabled Enable (true) or disable (false) it.
+     */
+    void setCacheEnabled(bool isEnabled);
+
+    /**
+     * Get the request priority.
+     *
+     * @return Request priority
+     */
+    Priority getPriority() const
+    {
+        return m_priority;
+    }
+
     /**
      * Add header to request header.
      *
@@ -167,8 +216,23 @@ public:
      */
     void regOnResponse(const OnResponse& onResponse);
 
+    /**
+     * Register callback function on response payload reception.
+     *
+     * If registered, the response payload is provided part by part as soon
+     * as it is received and it will not be stored in the response anymore.
+     * This avoids to hold a big response payload completely in memory.
+     * The response callback is still called after the response is complete,
+     * but without payload.
+     *
+     * @param[in] onRspPayload  Callback
+     */
+    void regOnRspPayload(const OnRspPayload& onRspPayload);
+
     /**
      * Register callback function on closed connection.
+     * It is called after the request is finished and the connection is
+     * either closed or released for the next request.
      *
      * @param[in] onClosed  Callback
      */
@@ -183,8 +247,9 @@ public:
     
     /**
      * Send GET request to host.
+     * The request is queued and sent as soon as the HTTP scheduler serves it.
      *
-     * @return If request is successful sent, it will return true otherwise false.
+     * @return If request is successful queued, it will return true otherwise false.
      */
     bool GET();
 
@@ -194,7 +259,7 @@ public:
      * @param[in] payload   Payload, which must be kept alive until response is available!
      * @param[in] size      Payload size in byte
      *
-     * @return If request is successful sent, it will return true otherwise false.
+     * @return If request is successful queued, it will return true otherwise false.
      */
     bool POST(const uint8_t* payload = nullptr, size_t size = 0U);
 
@@ -203,107 +268,14 @@ public:
      *
      * @param[in] payload   Payload, which must be kept alive until response is available!
      *
-     * @return If request is successful sent, it will return true otherwise false.
+     * @return If request is successful queued, it will return true otherwise false.
      */
     bool POST(const String& payload);
 
 private:
 
-    /** The process task stack size in bytes */
-    static const uint32_t       PROCESS_TASK_STACK_SIZE = 4096U;
-
-    /** The process task period in ms. */
-    static const uint32_t       PROCESS_TASK_PERIOD     = 20U;
-
-    /** The process task shall run on the APP MCU core. */
-    static const BaseType_t     PROCESS_TASK_RUN_CORE   = APP_CPU_NUM;
-
-    /** The process task priority shall be equal than the Arduino loop task priority. */
-    static const UBaseType_t    PROCESS_TASK_PRIORITY   = 1U;
-
-    /**
-     * Max. number of commands which can be queued.
-     */
-    static const size_t CMD_QUEUE_SIZE  = 10U;
-
-    /**
-     * Max. number of events which can be queued.
-     */
-    static const size_t EVT_QUEUE_SIZE  = 10U;
-
-    /**
-     * Command ids are used to identify what the user requests.
-     */
-    enum CmdId
-    {
-        CMD_ID_GET = 0, /**< GET request */
-        CMD_ID_POST     /**< POST request */
-    };
-
-    /**
-     * A command is a combination of request and its corresponding data.
-     */
-    struct Cmd
-    {
-        CmdId   id;     /**< The command id identifies the kind of request. */
-
-        /**
-         * The union contains the event id specific parameters.
-         * Note not every command id must have parameters.
-         */
-        union
-        {
-            /**
-             * Data parameters, only valid for CMD_ID_POST.
-             */
-            struct
-            {
-                const uint8_t*  data;   /**< Command specific data. */
-                size_t          size;   /**< Command specific data size in byte. */
-            } data;
-
-        } u;
-    };
-
-    /**
-     * Event ids used to identify the informations notified by the TCP/IP stack.
-     */
-    enum EventId
-    {
-        EVENT_ID_CONNECTED = 0, /**< Connection is established. */
-        EVENT_ID_DISCONNECTED,  /**< Connection is disconnected. */
-        EVENT_ID_ERROR,         /**< A error happened. */
-        EVENT_ID_DATA,          /**< Data is received. */
-        EVENT_ID_TIMEOUT        /**< A connection timeout happened. */
-
-    };
-
-    /**
-     * A event is a combination of notification and its corresponding data.
-     */
-    struct Event
-    {
-        EventId     id;     /**< Event id to identify the kind of notification. */
-
-        /**
-         * The union contains the event id specific parameters.
-         * Note not every event id must have parameters.
-         */
-        union
-        {
-            /**
-             * Data parameters, only valid for EVENT_ID_DATA.
-             */
-            struct
-            {
-                uint8_t*    data;   /**< Event specific data. */
-                size_t      size;   /**< Event specific data size in byte. */
-            } data;
-
-            int8_t      error;      /**< Error id, valid only for EVENT_ID_ERROR */
-            uint32_t    timeout;    /**< Timeout in ms, valid only for EVENT_ID_TIMEOUT */
-        } u;
-    };
+    /* The HTTP scheduler serves the requests and forwards the connection events. */
+    friend class HttpScheduler;
 
     /**
      * HTTP response parts.
@@ -341,25 +313,25 @@ private:
     /** HTTPS port */
     static const uint16_t   HTTPS_PORT  = 443U;
 
-    TaskHandle_t        m_processTaskHandle;    /**< Process task handle */
-    bool                m_processTaskExit;      /**< Flag to signal the process task to exit. */
-    SemaphoreHandle_t   m_processTaskSemaphore; /**< Binary semaphore used to signal the process task exited. */
-
-
-    AsyncClient     m_tcpClient;            /**< Asynchronous TCP client */
-    Queue<Cmd>      m_cmdQueue;             /**< Command queue */
-    Queue<Event>    m_evtQueue;             /**< Event queue */
     Mutex           m_mutex;                /**< Used to protect against concurrent access. */
-    bool            m_hasGlobalMutex;       /**< Has the task the global mutex? */
 
     /* Protected data */
     bool            m_isConnected;          /**< Is a connection established? */
-    bool            m_isReqOpen;            /**< Is a request open? */
+    bool            m_isReqOpen;            /**< Is a request open (queued or pending)? */
+
+    /* Data, which is only accessed by the HTTP scheduler task after the request is queued. */
+    HttpConnection* m_connection;           /**< Connection, assigned by the HTTP scheduler */
+    bool            m_isReusedConnection;   /**< Is the request sent via a kept alive connection? */
+    bool            m_isRetry;              /**< Is the request already retried? */
+    bool            m_isCacheable;          /**< Is the response of the request cacheable? */
+    bool            m_isRevalidating;       /**< Is the request conditional to revalidate the cached response? */
 
     /* Non-protected data */
     OnResponse      m_onRspCallback;        /**< Callback which to call for a complete response. */
+    OnRspPayload    m_onRspPayloadCallback; /**< Callback which to call for a received part of the response payload. */
     OnClosed        m_onClosedCallback;     /**< Callback which to call for a closed connection. */
     OnError         m_onErrorCallback;      /**< Callback which to call for a connection error. */
+    String          m_url;                  /**< Request URL, used to identify the cached response */
     String          m_hostname;             /**< Server hostname */
     uint16_t        m_port;                 /**< Server port */
     bool            m_isSecure;             /**< Secure transport (true) or not (false) */
@@ -370,6 +342,8 @@ private:
     String          m_userAgent;            /**< User agent */
     bool            m_isHttpVer10;          /**< Use HTTP/1.0 (true) instead of HTTP/1.1 (false) */
     bool            m_isKeepAlive;          /**< Keep connection alive or not? */
+    Priority        m_priority;             /**< Request priority */
+    bool            m_isCacheEnabled;       /**< Is the response cache enabled? */
     String          m_urlEncodedPars;       /**< URL encoded parameters (application/x-www-form-urlencoded) */
     const uint8_t*  m_payload;              /**< Request payload */
     size_t          m_payloadSize;          /**< Request payload size in byte */
@@ -383,58 +357,63 @@ private:
     size_t          m_chunkSize;            /**< Chunk size in byte */
     size_t          m_chunkIndex;           /**< Chunk body index */
     ChunkBodyPart   m_chunkBodyPart;        /**< Current part of chunked response */
+    bool            m_isRspKeepAlive;       /**< Is the connection kept alive after the response? */
+    bool            m_isRspCacheable;       /**< Shall the response be cached? */
+    uint32_t        m_rspMaxAge;            /**< Period in s, the response is fresh. */
+    HttpCache::Writer m_cacheWriter;        /**< Collects a copy of the response payload for the cache, if provided to the application part by part. */
 
     AsyncHttpClient(const AsyncHttpClient& client);
     AsyncHttpClient& operator=(const AsyncHttpClient& client);
 
     /**
-     * Create the process task which is responsible to process all commands and events.
-     * 
-     * @return If successful it will return true otherwise false.
-     */
-    bool createProcessTask();
-
-    /**
-     * Destroy the process task gracefully.
-     */
-    void destroyProcessTask();
-
-    /**
-     * Clear the command queue.
-     * Attention, all commands will be lost and not acknowledged.
+     * Queue request with the given method and payload.
+     *
+     * @param[in] method    Request method, e.g. GET, POST, etc.
+     * @param[in] payload   Payload, which must be kept alive until response is available!
+     * @param[in] size      Payload size in byte
+     *
+     * @return If request is successful queued, it will return true otherwise false.
      */
-    void clearCmdQueue();
+    bool queueRequest(const char* method, const uint8_t* payload, size_t size);
 
     /**
-     * Clear the event queue.
-     * Attention, all events will be lost and not acknowledged.
+     * This method is called if a connection is successful established or
+     * a kept alive connection is assigned for the request.
      */
-    void clearEvtQueue();
+    void onConnect();
 
     /**
-     * Processing task.
+     * This method is called if a connection is disconnected.
      */
-    static void processTask(void* parameters);
+    void onDisconnect();
 
     /**
-     * Process the command queue.
+     * Is a fresh response of the request cached, which can be served
+     * without any connection?
+     *
+     * @return If a fresh response is cached, it will return true otherwise false.
      */
-    void processCmdQueue();
+    bool isCacheFresh();
 
     /**
-     * Process the event queue.
+     * Serve the request from the response cache. This is called by the
+     * HTTP scheduler instead of establishing a connection. If the cached
+     * response is lost in the meantime, the request is queued again.
      */
-    void processEvtQueue();
+    void serveFromCache();
 
     /**
-     * This method is called if a connection is successful established.
+     * Replace the response with the cached response.
+     *
+     * @return If successful, it will return true otherwise false.
      */
-    void onConnect();
+    bool replayCachedRsp();
 
     /**
-     * This method is called if a connection is disconnected.
+     * This method is called if the request failed without any connection,
+     * e.g. the connection couldn't be established or the request timed out.
      */
-    void onDisconnect();
+    void onRequestFailed();
 
     /**
      * This method is called if a error occurred.
@@ -458,40 +437,11 @@ private:
      */
     void onTimeout(uint32_t timeout);
 
-    /**
-     * Establish TCP connection.
-     *
-     * @return If the connection procedure is pending, it will return true otherwise false.
-     */
-    bool connect();
-
     /**
      * Disconnect TCP connection gracefully.
      */
     void disconnect();
 
-    /**
-     * Abort TCP connection (non-gracefully) and avoid any follow up callback.
-     */
-    void abort();
-
-    /**
-     * Send GET request to host.
-     *
-     * @return If request is successful sent, it will return true otherwise false.
-     */
-    bool getRequest();
-
-    /**
-     * Send POST request to host.
-     *
-     * @param[in] payload   Payload, which must be kept alive until response is available!
-     * @param[in] size      Payload size in byte
-     *
-     * @return If request is successful sent, it will return true otherwise false.
-     */
-    bool postRequest(const uint8_t* payload = nullptr, size_t size = 0U);
-
     /**
      * Send request to host.
      *
@@ -598,6 +548,40 @@ private:
      */
     bool parseRspHeader(const char* data, size_t len, size_t& index);
 
+    /**
+     * Handle a complete response. If the connection is kept alive, it will be
+     * released for the next request, otherwise the server closes it.
+     */
+    void handleRspComplete();
+
+    /**
+     * Examine the response cache directives and validators, to determine
+     * whether the response shall be cached.
+     */
+    void handleRspCacheHeader();
+
+    /**
+     * Update the response cache with the complete response. A not modified
+     * response is replaced by the cached one.
+     */
+    void handleRspCache();
+
+    /**
+     * Does the response have no body, independent of the header fields?
+     *
+     * @return If the response has no body, it will return true otherwise false.
+     */
+    bool isRspWithoutBody();
+
+    /**
+     * Handle a received part of the response payload. It is either provided
+     * to the application or stored in the response.
+     *
+     * @param[in] payload   Part of the response payload
+     * @param[in] size      Size in byte
+     */
+    void handleRspPayload(const uint8_t* payload, size_t size);
+
     /**
      * This method will be called for every complete response and provides
      * it to the application, depended on whether a application callback
@@ -636,18 +620,6 @@ private:
      * @return User friendly error information. May be nullptr in case of unknown error id.
      */
     const char* errorToStr(int8_t error);
-
-    /**
-     * Take global mutex to serialize all AsyncHttpClient's.
-     * 
-     * @return If taken, it will return true otherwise false. If already taken, it will return false.
-     */
-    bool takeGlobalMutex();
-
-    /**
-     * Give global mutex back for the next one.
-     */
-    void giveGlobalMutex();
 };
 
 /******************************************************************************
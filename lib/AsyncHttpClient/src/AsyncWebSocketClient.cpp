@@ -0,0 +1,588 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Asynchronous websocket client
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "AsyncWebSocketClient.h"
+
+#include <Util.h>
+#include <Logging.h>
+#include <base64.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+AsyncWebSocketClient::AsyncWebSocketClient() :
+    m_mutex(),
+    m_tcpClient(),
+    m_state(STATE_CLOSED),
+    m_onOpenCallback(),
+    m_onTextCallback(),
+    m_onClosedCallback(),
+    m_onErrorCallback(),
+    m_hostname(),
+    m_port(0U),
+    m_uri(),
+    m_handshake(),
+    m_frameParser()
+{
+    (void)m_mutex.create();
+
+    m_tcpClient.onConnect(  [this](void* arg, AsyncClient* client)
+                            {
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                onConnect();
+                            });
+
+    m_tcpClient.onDisconnect(   [this](void* arg, AsyncClient* client)
+                                {
+                                    UTIL_NOT_USED(arg);
+                                    UTIL_NOT_USED(client);
+
+                                    onDisconnect();
+                                });
+
+    m_tcpClient.onError(    [this](void* arg, AsyncClient* client, int8_t error)
+                            {
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                onError(error);
+                            });
+
+    m_tcpClient.onData( [this](void* arg, AsyncClient* client, void* data, size_t len)
+                        {
+                            UTIL_NOT_USED(arg);
+                            UTIL_NOT_USED(client);
+
+                            onData(static_cast<const uint8_t*>(data), len);
+                        });
+
+    m_tcpClient.onTimeout(  [this](void* arg, AsyncClient* client, uint32_t timeout)
+                            {
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                LOG_WARNING("Websocket timeout: %u ms", timeout);
+                                m_tcpClient.close();
+                            });
+}
+
+AsyncWebSocketClient::~AsyncWebSocketClient()
+{
+    /* No callback shall be called after the client is destroyed. */
+    m_tcpClient.onConnect(nullptr);
+    m_tcpClient.onDisconnect(nullptr);
+    m_tcpClient.onError(nullptr);
+    m_tcpClient.onData(nullptr);
+    m_tcpClient.onTimeout(nullptr);
+
+    if (STATE_CLOSED != m_state)
+    {
+        m_tcpClient.abort();
+    }
+
+    /* Destroy at the end. */
+    m_mutex.destroy();
+}
+
+bool AsyncWebSocketClient::connect(const String& url)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+
+    if (STATE_CLOSED != m_state)
+    {
+        LOG_WARNING("Websocket is not closed.");
+    }
+    else if (false == parseUrl(url))
+    {
+        LOG_ERROR("Invalid websocket URL: %s", url.c_str());
+    }
+    else
+    {
+        LOG_INFO("Connecting to ws://%s:%u%s.", m_hostname.c_str(), m_port, m_uri.c_str());
+
+        /* The connect callback may be called before connect() returns. */
+        m_state = STATE_CONNECTING;
+
+        if (false == m_tcpClient.connect(m_hostname.c_str(), m_port))
+        {
+            LOG_WARNING("Connecting to %s:%u failed.", m_hostname.c_str(), m_port);
+            m_state = STATE_CLOSED;
+        }
+        else
+        {
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void AsyncWebSocketClient::disconnect()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if (STATE_OPEN == m_state)
+    {
+        const uint8_t   NORMAL_CLOSURE[]    = { 0x03U, 0xE8U }; /* 1000 */
+
+        (void)sendFrame(WebSocketFrameParser::OPCODE_CLOSE, NORMAL_CLOSURE, sizeof(NORMAL_CLOSURE));
+    }
+
+    if ((STATE_CLOSED != m_state) &&
+        (STATE_CLOSING != m_state))
+    {
+        m_state = STATE_CLOSING;
+        m_tcpClient.close();
+    }
+}
+
+bool AsyncWebSocketClient::isOpen()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    return (STATE_OPEN == m_state);
+}
+
+bool AsyncWebSocketClient::isClosed()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    return (STATE_CLOSED == m_state);
+}
+
+bool AsyncWebSocketClient::sendText(const String& text)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+
+    if (STATE_OPEN == m_state)
+    {
+        const void* vText = text.c_str();
+
+        isSuccessful = sendFrame(WebSocketFrameParser::OPCODE_TEXT, static_cast<const uint8_t*>(vText), text.length());
+    }
+
+    return isSuccessful;
+}
+
+void AsyncWebSocketClient::regOnOpen(const OnOpen& onOpen)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_onOpenCallback = onOpen;
+}
+
+void AsyncWebSocketClient::regOnText(const OnText& onText)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_onTextCallback = onText;
+}
+
+void AsyncWebSocketClient::regOnClosed(const OnClosed& onClosed)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_onClosedCallback = onClosed;
+}
+
+void AsyncWebSocketClient::regOnError(const OnError& onError)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_onErrorCallback = onError;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool AsyncWebSocketClient::parseUrl(const String& url)
+{
+    bool        isSuccessful    = false;
+    const char* PROTOCOL        = "ws://";
+
+    if (true == url.startsWith(PROTOCOL))
+    {
+        int     hostBegin   = strlen(PROTOCOL);
+        int     index       = url.indexOf('/', hostBegin);
+        String  host;
+
+        if (0 > index)
+        {
+            host    = url.substring(hostBegin);
+            m_uri   = "/";
+        }
+        else
+        {
+            host    = url.substring(hostBegin, index);
+            m_uri   = url.substring(index);
+        }
+
+        index = host.indexOf(':');
+
+        if (0 > index)
+        {
+            m_hostname      = host;
+            m_port          = WS_PORT;
+            isSuccessful    = true;
+        }
+        else
+        {
+            long portNo = host.substring(index + 1).toInt();
+
+            if ((0 < portNo) &&
+                (UINT16_MAX >= portNo))
+            {
+                m_hostname      = host.substring(0, index);
+                m_port          = static_cast<uint16_t>(portNo);
+                isSuccessful    = true;
+            }
+        }
+
+        if (true == m_hostname.isEmpty())
+        {
+            isSuccessful = false;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void AsyncWebSocketClient::onConnect()
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint8_t                     key[WebSocketHandshake::KEY_SIZE];
+    size_t                      index           = 0U;
+    String                      request;
+
+    LOG_INFO("Connected to %s:%u.", m_hostname.c_str(), m_port);
+
+    /* The key shall be a randomly selected 16-byte value, see RFC6455 chapter 4.1. */
+    for(index = 0U; index < WebSocketHandshake::KEY_SIZE; ++index)
+    {
+        key[index] = static_cast<uint8_t>(random(256));
+    }
+
+    m_handshake.begin(base64::encode(key, WebSocketHandshake::KEY_SIZE));
+    m_frameParser.reset();
+    m_state = STATE_HANDSHAKE;
+
+    request = m_handshake.getRequest(m_hostname, m_port, m_uri);
+
+    if (request.length() != m_tcpClient.write(request.c_str(), request.length()))
+    {
+        LOG_WARNING("Failed to send websocket handshake.");
+        m_state = STATE_CLOSING;
+        m_tcpClient.close();
+    }
+}
+
+void AsyncWebSocketClient::onDisconnect()
+{
+    OnClosed onClosed;
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        LOG_INFO("Disconnected from %s:%u.", m_hostname.c_str(), m_port);
+
+        closeConnection();
+        onClosed = m_onClosedCallback;
+    }
+
+    if (nullptr != onClosed)
+    {
+        onClosed();
+    }
+}
+
+void AsyncWebSocketClient::onError(int8_t error)
+{
+    OnError onError;
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        onError = m_onErrorCallback;
+    }
+
+    LOG_WARNING("Websocket error occurred: %d", error);
+
+    if (nullptr != onError)
+    {
+        onError();
+    }
+}
+
+void AsyncWebSocketClient::onData(const uint8_t* data, size_t len)
+{
+    size_t  index       = 0U;
+    bool    isParsing   = true;
+
+    while((len > index) && (true == isParsing))
+    {
+        OnOpen  onOpen;
+        OnText  onText;
+        char*   text        = nullptr;
+        size_t  textSize    = 0U;
+
+        /* Protect against concurrent access. The callbacks are called after
+         * the lock is released, because they may use the client again.
+         */
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            if (STATE_HANDSHAKE == m_state)
+            {
+                isParsing = parseHandshake(data, len, index, onOpen);
+            }
+            else if (STATE_OPEN == m_state)
+            {
+                isParsing = parseFrame(data, len, index, text, textSize, onText);
+            }
+            /* Any data in other states is discarded. */
+            else
+            {
+                isParsing = false;
+            }
+        }
+
+        if (nullptr != onOpen)
+        {
+            onOpen();
+        }
+
+        if (nullptr != text)
+        {
+            if (nullptr != onText)
+            {
+                onText(text, textSize);
+            }
+
+            delete[] text;
+        }
+    }
+}
+
+bool AsyncWebSocketClient::parseHandshake(const uint8_t* data, size_t len, size_t& index, OnOpen& onOpen)
+{
+    bool isParsing = true;
+
+    switch(m_handshake.parse(data, len, index))
+    {
+    case WebSocketHandshake::RESULT_PENDING:
+        /* Wait for more data. */
+        break;
+
+    case WebSocketHandshake::RESULT_ACCEPTED:
+        LOG_INFO("Websocket to %s:%u%s open.", m_hostname.c_str(), m_port, m_uri.c_str());
+
+        m_state = STATE_OPEN;
+        onOpen  = m_onOpenCallback;
+        break;
+
+    case WebSocketHandshake::RESULT_REJECTED:
+        /* fallthrough */
+    default:
+        m_state     = STATE_CLOSING;
+        m_tcpClient.close();
+        isParsing   = false;
+        break;
+    }
+
+    return isParsing;
+}
+
+bool AsyncWebSocketClient::parseFrame(const uint8_t* data, size_t len, size_t& index, char*& text, size_t& textSize, OnText& onText)
+{
+    bool            isParsing   = true;
+    const uint8_t*  payload     = nullptr;
+    size_t          payloadSize = 0U;
+
+    switch(m_frameParser.parse(data, len, index))
+    {
+    case WebSocketFrameParser::EVENT_NONE:
+        /* Wait for more data. */
+        break;
+
+    case WebSocketFrameParser::EVENT_TEXT:
+        text    = m_frameParser.takeText(textSize);
+        onText  = m_onTextCallback;
+        break;
+
+    case WebSocketFrameParser::EVENT_PING:
+        payload = m_frameParser.getCtrlPayload(payloadSize);
+        (void)sendFrame(WebSocketFrameParser::OPCODE_PONG, payload, payloadSize);
+        break;
+
+    case WebSocketFrameParser::EVENT_CLOSE:
+        /* Respond with the received status code and close the connection. */
+        payload = m_frameParser.getCtrlPayload(payloadSize);
+        (void)sendFrame(WebSocketFrameParser::OPCODE_CLOSE, payload, (2U <= payloadSize) ? 2U : 0U);
+        m_state     = STATE_CLOSING;
+        m_tcpClient.close();
+        isParsing   = false;
+        break;
+
+    case WebSocketFrameParser::EVENT_ERROR:
+        /* fallthrough */
+    default:
+        disconnect();
+        isParsing = false;
+        break;
+    }
+
+    return isParsing;
+}
+
+bool AsyncWebSocketClient::sendFrame(WebSocketFrameParser::Opcode opcode, const uint8_t* payload, size_t size)
+{
+    const uint8_t   FIN_FLAG    = 0x80U;
+    const uint8_t   MASK_FLAG   = 0x80U;
+    bool            isSuccessful    = false;
+    size_t          headerSize      = 2U + MASK_KEY_SIZE;
+    uint8_t*        frame           = nullptr;
+
+    if (125U < size)
+    {
+        headerSize += (UINT16_MAX < size) ? 8U : 2U;
+    }
+
+    frame = new(std::nothrow) uint8_t[headerSize + size];
+
+    if (nullptr == frame)
+    {
+        LOG_ERROR("Couldn't allocate %u memory.", headerSize + size);
+    }
+    else
+    {
+        uint8_t*    mask    = &frame[headerSize - MASK_KEY_SIZE];
+        size_t      index   = 0U;
+
+        frame[0] = FIN_FLAG | static_cast<uint8_t>(opcode);
+
+        /* Extended payload length in network byte order. */
+        if (125U >= size)
+        {
+            frame[1] = MASK_FLAG | static_cast<uint8_t>(size);
+        }
+        else if (UINT16_MAX >= size)
+        {
+            frame[1] = MASK_FLAG | 126U;
+            frame[2] = static_cast<uint8_t>(size >> 8U);
+            frame[3] = static_cast<uint8_t>(size);
+        }
+        else
+        {
+            uint64_t extSize = size;
+
+            frame[1] = MASK_FLAG | 127U;
+
+            for(index = 0U; index < 8U; ++index)
+            {
+                frame[9U - index] = static_cast<uint8_t>(extSize);
+                extSize >>= 8U;
+            }
+        }
+
+        /* A client shall mask all frames, see RFC6455 chapter 5.3. */
+        for(index = 0U; index < MASK_KEY_SIZE; ++index)
+        {
+            mask[index] = static_cast<uint8_t>(random(256));
+        }
+
+        for(index = 0U; index < size; ++index)
+        {
+            frame[headerSize + index] = payload[index] ^ mask[index % MASK_KEY_SIZE];
+        }
+
+        if ((headerSize + size) == m_tcpClient.write(reinterpret_cast<const char*>(frame), headerSize + size))
+        {
+            isSuccessful = true;
+        }
+        else
+        {
+            LOG_WARNING("Failed to send websocket frame.");
+        }
+
+        delete[] frame;
+    }
+
+    return isSuccessful;
+}
+
+void AsyncWebSocketClient::closeConnection()
+{
+    m_state = STATE_CLOSED;
+    m_frameParser.reset();
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
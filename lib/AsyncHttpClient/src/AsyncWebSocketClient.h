@@ -0,0 +1,307 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Asynchronous websocket client
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef ASYNC_WEBSOCKET_CLIENT_H
+#define ASYNC_WEBSOCKET_CLIENT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <Mutex.hpp>
+#include <WebSocketHandshake.h>
+#include <WebSocketFrameParser.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Asynchronous websocket client, which keeps a persistent connection to a
+ * server and notifies every received text message.
+ *
+ * In contrast to the HTTP clients, the connection is not served by the HTTP
+ * scheduler, because it would block it permanently.
+ *
+ * Limitations:
+ * - Only unsecure connections (ws://) are supported.
+ * - Binary messages are discarded.
+ * - Messages greater than MAX_MESSAGE_SIZE are discarded.
+ *
+ * The callbacks are called without holding the internal lock, therefore they
+ * may use the client, e.g. to send a text message.
+ *
+ * Used RFCs:
+ * - RFC6455
+ */
+class AsyncWebSocketClient
+{
+public:
+
+    /**
+     * Prototype of callback for a established connection, after the
+     * opening handshake.
+     */
+    typedef std::function<void()> OnOpen;
+
+    /**
+     * Prototype of callback for a received text message. The text is
+     * always terminated.
+     */
+    typedef std::function<void(const char* text, size_t size)> OnText;
+
+    /**
+     * Prototype of callback for a closed connection.
+     */
+    typedef std::function<void()> OnClosed;
+
+    /**
+     * Prototype of callback in case a error happened.
+     */
+    typedef std::function<void()> OnError;
+
+    /**
+     * Constructs a websocket client.
+     */
+    AsyncWebSocketClient();
+
+    /**
+     * Destroys the websocket client.
+     */
+    ~AsyncWebSocketClient();
+
+    /**
+     * Connect to the server. The opening handshake is done automatically.
+     *
+     * @param[in] url   URL, e.g. ws://host:port/path?query
+     *
+     * @return If the connection establishment is pending, it will return true otherwise false.
+     */
+    bool connect(const String& url);
+
+    /**
+     * Close the connection.
+     */
+    void disconnect();
+
+    /**
+     * Is the connection established and the opening handshake done?
+     *
+     * @return If open, it will return true otherwise false.
+     */
+    bool isOpen();
+
+    /**
+     * Is the connection completely closed?
+     *
+     * @return If closed, it will return true otherwise false.
+     */
+    bool isClosed();
+
+    /**
+     * Send a text message.
+     *
+     * @param[in] text  Text message
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool sendText(const String& text);
+
+    /**
+     * Register callback function for a established connection.
+     * Note, the callback is running in a different task context.
+     *
+     * @param[in] onOpen    Callback
+     */
+    void regOnOpen(const OnOpen& onOpen);
+
+    /**
+     * Register callback function for received text messages.
+     * Note, the callback is running in a different task context.
+     *
+     * @param[in] onText    Callback
+     */
+    void regOnText(const OnText& onText);
+
+    /**
+     * Register callback function on connection close.
+     * Note, the callback is running in a different task context.
+     *
+     * @param[in] onClosed  Callback
+     */
+    void regOnClosed(const OnClosed& onClosed);
+
+    /**
+     * Register callback function on error.
+     * Note, the callback is running in a different task context.
+     *
+     * @param[in] onError   Callback
+     */
+    void regOnError(const OnError& onError);
+
+    /** Default websocket port */
+    static const uint16_t   WS_PORT             = 80U;
+
+    /** Max. size in byte of a received message. */
+    static const size_t     MAX_MESSAGE_SIZE    = WebSocketFrameParser::MAX_MESSAGE_SIZE;
+
+private:
+
+    /**
+     * Connection states.
+     */
+    enum State
+    {
+        STATE_CLOSED = 0,   /**< Connection is closed. */
+        STATE_CONNECTING,   /**< TCP connection establishment is pending. */
+        STATE_HANDSHAKE,    /**< Waiting for the handshake response of the server. */
+        STATE_OPEN,         /**< Connection is established. */
+        STATE_CLOSING       /**< Connection is closed, but the disconnect is still pending. */
+    };
+
+    /** Mask key size in byte. */
+    static const size_t     MASK_KEY_SIZE   = 4U;
+
+    MutexRecursive          m_mutex;            /**< Used to protect against concurrent access. */
+    AsyncClient             m_tcpClient;        /**< Asynchronous TCP client */
+    State                   m_state;            /**< Connection state */
+    OnOpen                  m_onOpenCallback;   /**< Callback for established connection */
+    OnText                  m_onTextCallback;   /**< Callback for received text message */
+    OnClosed                m_onClosedCallback; /**< Callback for closed connection */
+    OnError                 m_onErrorCallback;  /**< Callback for any error */
+    String                  m_hostname;         /**< Server hostname */
+    uint16_t                m_port;             /**< Server port */
+    String                  m_uri;              /**< Request URI incl. query */
+    WebSocketHandshake      m_handshake;        /**< Opening handshake */
+    WebSocketFrameParser    m_frameParser;      /**< Parser of the received frames */
+
+    AsyncWebSocketClient(const AsyncWebSocketClient& client);
+    AsyncWebSocketClient& operator=(const AsyncWebSocketClient& client);
+
+    /**
+     * Parse the URL and store hostname, port and URI.
+     *
+     * @param[in] url   URL
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool parseUrl(const String& url);
+
+    /**
+     * Handle connection establishment, by sending the opening handshake.
+     */
+    void onConnect();
+
+    /**
+     * Handle connection disconnect.
+     */
+    void onDisconnect();
+
+    /**
+     * Handle connection error.
+     *
+     * @param[in] error Error id
+     */
+    void onError(int8_t error);
+
+    /**
+     * Handle received data.
+     *
+     * @param[in] data  Data
+     * @param[in] len   Data length in byte
+     */
+    void onData(const uint8_t* data, size_t len);
+
+    /**
+     * Parse the handshake response.
+     *
+     * @param[in]       data    Data
+     * @param[in]       len     Data length in byte
+     * @param[in,out]   index   Index of the next byte, which to parse.
+     * @param[out]      onOpen  Callback, which to call after the lock is released.
+     *
+     * @return If parsing shall be continued, it will return true otherwise false.
+     */
+    bool parseHandshake(const uint8_t* data, size_t len, size_t& index, OnOpen& onOpen);
+
+    /**
+     * Parse received frames until the next frame parser event.
+     *
+     * @param[in]       data        Data
+     * @param[in]       len         Data length in byte
+     * @param[in,out]   index       Index of the next byte, which to parse.
+     * @param[out]      text        Received text message, which the caller shall release with delete[].
+     * @param[out]      textSize    Received text message size in byte
+     * @param[out]      onText      Callback, which to call after the lock is released.
+     *
+     * @return If parsing shall be continued, it will return true otherwise false.
+     */
+    bool parseFrame(const uint8_t* data, size_t len, size_t& index, char*& text, size_t& textSize, OnText& onText);
+
+    /**
+     * Send a masked frame.
+     *
+     * @param[in] opcode    Opcode
+     * @param[in] payload   Payload
+     * @param[in] size      Payload size in byte
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool sendFrame(WebSocketFrameParser::Opcode opcode, const uint8_t* payload, size_t size);
+
+    /**
+     * Close the TCP connection and reset the parser.
+     */
+    void closeConnection();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* ASYNC_WEBSOCKET_CLIENT_H */
+
+/** @} */
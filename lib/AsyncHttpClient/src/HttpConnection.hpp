@@ -0,0 +1,110 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP connection
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef HTTP_CONNECTION_HPP
+#define HTTP_CONNECTION_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <HttpConnectionSlot.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class AsyncHttpClient;
+
+/**
+ * A TCP connection to a server, which is managed by the HTTP scheduler.
+ * It is used by one HTTP client at a time. After a completed request it
+ * may be kept alive and reused by the next request to the same server.
+ */
+class HttpConnection : public HttpConnectionSlot<AsyncHttpClient>
+{
+public:
+
+    /**
+     * Constructs a closed connection.
+     */
+    HttpConnection() :
+        HttpConnectionSlot<AsyncHttpClient>(),
+        m_tcpClient()
+    {
+    }
+
+    /**
+     * Destroys the connection.
+     */
+    ~HttpConnection()
+    {
+    }
+
+    /**
+     * Get the TCP client.
+     *
+     * @return TCP client
+     */
+    AsyncClient& getTcpClient()
+    {
+        return m_tcpClient;
+    }
+
+private:
+
+    AsyncClient m_tcpClient;    /**< Asynchronous TCP client */
+
+    HttpConnection(const HttpConnection& connection);
+    HttpConnection& operator=(const HttpConnection& connection);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTTP_CONNECTION_HPP */
+
+/** @} */
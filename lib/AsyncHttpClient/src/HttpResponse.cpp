@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include "HttpResponse.h"
 #include <new>
+#include <HeapAccounting.hpp>
 
 /******************************************************************************
  * Compiler Switches
@@ -71,19 +72,17 @@ HttpResponse& HttpResponse::operator=(const HttpResponse& rsp)
 
         clearPayload();
 
-        if (nullptr != rsp.m_payload)
+        if ((nullptr != rsp.m_payload) &&
+            (0U < rsp.m_wrIndex))
         {
-            m_payload = new(std::nothrow) uint8_t[rsp.m_size];
+            m_payload = new(std::nothrow) uint8_t[rsp.m_wrIndex];
 
-            if (nullptr == m_payload)
-            {
-                m_size = 0U;
-                m_wrIndex = 0U;
-            }
-            else
+            HeapAccounting::getInstance().track(HeapAccounting::TAG_HTTP, m_payload, rsp.m_wrIndex);
+
+            if (nullptr != m_payload)
             {
-                memcpy(m_payload, rsp.m_payload, rsp.m_size);
-                m_size = rsp.m_size;
+                memcpy(m_payload, rsp.m_payload, rsp.m_wrIndex);
+                m_size = rsp.m_wrIndex;
                 m_wrIndex = rsp.m_wrIndex;
             }
         }
@@ -164,34 +163,54 @@ void HttpResponse::addHeader(const String& line)
 
 void HttpResponse::extendPayload(size_t size)
 {
-    uint8_t* tmp = m_payload;
+    /* Only if the payload buffer has not enough room left. */
+    if ((nullptr == m_payload) ||
+        ((m_size - m_wrIndex) < size))
+    {
+        uint8_t*    tmp     = m_payload;
+        size_t      tmpSize = m_size;
+        size_t      newSize = m_wrIndex + size;
+
+        /* Grow geometrically, otherwise a payload which is received in many
+         * parts would be copied again for every part.
+         */
+        if ((nullptr != tmp) &&
+            ((2U * m_size) > newSize))
+        {
+            newSize = 2U * m_size;
+        }
 
-    m_payload = new(std::nothrow) uint8_t[m_size + size];
+        m_payload = new(std::nothrow) uint8_t[newSize];
 
-    if (nullptr != m_payload)
-    {
-        m_size += size;
-    }
+        HeapAccounting::getInstance().track(HeapAccounting::TAG_HTTP, m_payload, newSize);
 
-    if ((nullptr != m_payload) &&
-        (nullptr != tmp))
-    {
-        memcpy(m_payload, tmp, m_wrIndex);
-    }
+        if (nullptr == m_payload)
+        {
+            /* The already received payload is lost. */
+            m_size      = 0U;
+            m_wrIndex   = 0U;
+        }
+        else
+        {
+            if (nullptr != tmp)
+            {
+                memcpy(m_payload, tmp, m_wrIndex);
+            }
 
-    if (nullptr != tmp)
-    {
-        delete[] tmp;
+            m_size = newSize;
+        }
+
+        if (nullptr != tmp)
+        {
+            HeapAccounting::getInstance().released(HeapAccounting::TAG_HTTP, tmpSize);
+            delete[] tmp;
+        }
     }
 }
 
 void HttpResponse::addPayload(const uint8_t* payload, size_t size)
 {
-    if ((nullptr == m_payload) ||
-        ((m_size - m_wrIndex) < size))
-    {
-        extendPayload(size);
-    }
+    extendPayload(size);
 
     if ((nullptr != m_payload) &&
         ((m_size - m_wrIndex) >= size))
@@ -246,7 +265,7 @@ String HttpResponse::getHeader(const String& name)
 
 const uint8_t* HttpResponse::getPayload(size_t& size) const
 {
-    size = m_size;
+    size = m_wrIndex;
     return m_payload;
 }
 
@@ -275,11 +294,13 @@ void HttpResponse::clearPayload()
 {
     if (nullptr != m_payload)
     {
+        HeapAccounting::getInstance().released(HeapAccounting::TAG_HTTP, m_size);
         delete[] m_payload;
         m_payload = nullptr;
     }
 
     m_size = 0U;
+    m_wrIndex = 0U;
 }
 
 /******************************************************************************
@@ -131,7 +131,9 @@ public:
     void addHeader(const String& line);
 
     /**
-     * Extend payload size in bytes.
+     * Extend the payload buffer, so that at least the given number of bytes
+     * can be added. If there is already enough room, nothing happens.
+     * The buffer grows geometrically.
      *
      * @param[in] size  Size in bytes
      */
@@ -176,7 +178,7 @@ public:
     /**
      * Get payload.
      *
-     * @param[out] size Payload size in byte
+     * @param[out] size Size of the received payload in byte
      *
      * @return Payload buffer
      */
@@ -189,7 +191,7 @@ private:
     String                      m_reasonPhrase; /**< Reason phrase */
     DLinkedList<HttpHeader*>    m_headers;      /**< List of headers */
     uint8_t*                    m_payload;      /**< Payload */
-    size_t                      m_size;         /**< Payload size in byte */
+    size_t                      m_size;         /**< Payload buffer size in byte */
     size_t                      m_wrIndex;      /**< Payload write index */
 
     /**
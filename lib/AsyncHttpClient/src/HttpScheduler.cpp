@@ -0,0 +1,781 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP request scheduler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpScheduler.h"
+#include "AsyncHttpClient.h"
+
+#include <WiFi.h>
+#include <Util.h>
+#include <Logging.h>
+#include <HeapAccounting.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool HttpScheduler::addRequest(AsyncHttpClient& client)
+{
+    bool                        isSuccessful    = false;
+    bool                        isCacheHit      = client.isCacheFresh(); /* The cache is protected by its own. */
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    if (nullptr == m_processTaskHandle)
+    {
+        if (false == createProcessTask())
+        {
+            LOG_ERROR("Couldn't create HTTP scheduler task.");
+        }
+    }
+
+    if (nullptr == m_processTaskHandle)
+    {
+        ;
+    }
+    /* A cache hit needs no connection, therefore it doesn't wait for one. */
+    else if (true == isCacheHit)
+    {
+        if (false == m_cacheHits.add(client))
+        {
+            LOG_WARNING("HTTP cache hit queue is full.");
+        }
+        else
+        {
+            isSuccessful = true;
+        }
+    }
+    else if (false == m_requests.add(client))
+    {
+        LOG_WARNING("HTTP request queue is full.");
+    }
+    else
+    {
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void HttpScheduler::removeClient(AsyncHttpClient& client)
+{
+    size_t                      index           = 0U;
+    MutexGuard<MutexRecursive>  callbackGuard(m_callbackMutex);
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    m_requests.remove(client);
+    m_cacheHits.remove(client);
+
+    for(index = 0U; index < MAX_CONNECTIONS; ++index)
+    {
+        HttpConnection& connection = m_connections[index];
+
+        if (&client == connection.getOwner())
+        {
+            if (&connection == m_activeConnection)
+            {
+                m_activeConnection = nullptr;
+            }
+
+            /* Any further event of the connection is discarded, because the owner is removed. */
+            connection.setOwner(nullptr);
+
+            if (HttpConnection::STATE_CLOSED != connection.getState())
+            {
+                LOG_INFO("Aborting connection to %s:%u.", connection.getHostname().c_str(), connection.getPort());
+                connection.getTcpClient().abort();
+                connection.setState(HttpConnection::STATE_CLOSING);
+            }
+        }
+    }
+}
+
+void HttpScheduler::releaseConnection(HttpConnection& connection)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    if (&connection == m_activeConnection)
+    {
+        m_activeConnection = nullptr;
+    }
+
+    connection.setOwner(nullptr);
+
+    /* A idle secure connection blocks the heap of its TLS session. */
+    if ((true == connection.isSecure()) &&
+        (SECURE_KEEP_ALIVE_HEAP > ESP.getFreeHeap()))
+    {
+        LOG_DEBUG("Not enough heap to keep connection to %s:%u alive.", connection.getHostname().c_str(), connection.getPort());
+        closeConnection(connection);
+    }
+    else
+    {
+        LOG_DEBUG("Keep connection to %s:%u alive.", connection.getHostname().c_str(), connection.getPort());
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+HttpScheduler::HttpScheduler() :
+    m_processTaskHandle(nullptr),
+    m_mutex(),
+    m_callbackMutex(),
+    m_evtQueue(),
+    m_requests(),
+    m_cacheHits(),
+    m_connections(),
+    m_activeConnection(nullptr),
+    m_dnsCache()
+{
+    size_t index = 0U;
+
+    (void)m_mutex.create();
+    (void)m_callbackMutex.create();
+    (void)m_evtQueue.create(EVT_QUEUE_SIZE);
+
+    for(index = 0U; index < MAX_CONNECTIONS; ++index)
+    {
+        registerCallbacks(m_connections[index]);
+    }
+}
+
+HttpScheduler::~HttpScheduler()
+{
+    /* The scheduler lives as long as the application. */
+    m_evtQueue.destroy();
+    m_callbackMutex.destroy();
+    m_mutex.destroy();
+}
+
+void HttpScheduler::registerCallbacks(HttpConnection& connection)
+{
+    HttpConnection* pConnection = &connection;
+
+    connection.getTcpClient().onConnect(    [this, pConnection](void* arg, AsyncClient* client)
+                                            {
+                                                Event   evt;
+
+                                                UTIL_NOT_USED(arg);
+                                                UTIL_NOT_USED(client);
+
+                                                memset(&evt, 0, sizeof(evt));
+                                                evt.id          = EVENT_ID_CONNECTED;
+                                                evt.connection  = pConnection;
+                                                evt.generation  = pConnection->getGeneration();
+
+                                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                                            });
+
+    connection.getTcpClient().onDisconnect( [this, pConnection](void* arg, AsyncClient* client)
+                                            {
+                                                Event   evt;
+
+                                                UTIL_NOT_USED(arg);
+                                                UTIL_NOT_USED(client);
+
+                                                memset(&evt, 0, sizeof(evt));
+                                                evt.id          = EVENT_ID_DISCONNECTED;
+                                                evt.connection  = pConnection;
+                                                evt.generation  = pConnection->getGeneration();
+
+                                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                                            });
+
+    connection.getTcpClient().onError(  [this, pConnection](void* arg, AsyncClient* client, int8_t error)
+                                        {
+                                            Event   evt;
+
+                                            UTIL_NOT_USED(arg);
+                                            UTIL_NOT_USED(client);
+
+                                            memset(&evt, 0, sizeof(evt));
+                                            evt.id          = EVENT_ID_ERROR;
+                                            evt.connection  = pConnection;
+                                            evt.generation  = pConnection->getGeneration();
+                                            evt.u.error     = error;
+
+                                            (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                                        });
+
+    connection.getTcpClient().onData(   [this, pConnection](void* arg, AsyncClient* client, void* data, size_t len)
+                                        {
+                                            Event   evt;
+
+                                            UTIL_NOT_USED(arg);
+                                            UTIL_NOT_USED(client);
+
+                                            memset(&evt, 0, sizeof(evt));
+                                            evt.id          = EVENT_ID_DATA;
+                                            evt.connection  = pConnection;
+                                            evt.generation  = pConnection->getGeneration();
+                                            evt.u.data.data = new(std::nothrow) uint8_t[len];
+
+                                            if (nullptr == evt.u.data.data)
+                                            {
+                                                LOG_ERROR("Couldn't allocate %u memory.", len);
+
+                                                evt.u.data.size = 0U;
+                                            }
+                                            else
+                                            {
+                                                HeapAccounting::getInstance().track(HeapAccounting::TAG_HTTP, evt.u.data.data, len);
+
+                                                evt.u.data.size = len;
+                                                memcpy(evt.u.data.data, data, len);
+                                            }
+
+                                            (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                                        });
+
+    connection.getTcpClient().onTimeout(    [this, pConnection](void* arg, AsyncClient* client, uint32_t timeout)
+                                            {
+                                                Event   evt;
+
+                                                UTIL_NOT_USED(arg);
+                                                UTIL_NOT_USED(client);
+
+                                                memset(&evt, 0, sizeof(evt));
+                                                evt.id          = EVENT_ID_TIMEOUT;
+                                                evt.connection  = pConnection;
+                                                evt.generation  = pConnection->getGeneration();
+                                                evt.u.timeout   = timeout;
+
+                                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                                            });
+}
+
+bool HttpScheduler::createProcessTask()
+{
+    bool        isSuccessful    = false;
+    BaseType_t  osRet           = xTaskCreateUniversal( processTask,
+                                                        "httpSchedulerTask",
+                                                        PROCESS_TASK_STACK_SIZE,
+                                                        this,
+                                                        PROCESS_TASK_PRIORITY,
+                                                        &m_processTaskHandle,
+                                                        PROCESS_TASK_RUN_CORE);
+
+    /* Couldn't task be created? */
+    if (pdPASS != osRet)
+    {
+        m_processTaskHandle = nullptr;
+    }
+    else
+    {
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void HttpScheduler::processTask(void* parameters)
+{
+    HttpScheduler* tthis = static_cast<HttpScheduler*>(parameters);
+
+    if (nullptr != tthis)
+    {
+        /* The scheduler serves all HTTP clients, therefore it runs forever. */
+        while(true)
+        {
+            tthis->processEvtQueue();
+            tthis->processConnections();
+            tthis->processCacheHits();
+            tthis->processRequests();
+
+            delay(PROCESS_TASK_PERIOD);
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void HttpScheduler::processEvtQueue()
+{
+    Event evt;
+
+    while(true == m_evtQueue.receive(&evt, 0U))
+    {
+        MutexGuard<MutexRecursive>  callbackGuard(m_callbackMutex);
+        AsyncHttpClient*            client          = nullptr;
+
+        /* Protect against concurrent access. */
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            client = handleEvent(evt);
+        }
+
+        /* The client is notified without the mutex, because it may call the
+         * scheduler or wait for other resources.
+         */
+        if (nullptr != client)
+        {
+            notifyClient(evt, *client);
+        }
+
+        if ((EVENT_ID_DATA == evt.id) &&
+            (nullptr != evt.u.data.data))
+        {
+            HeapAccounting::getInstance().released(HeapAccounting::TAG_HTTP, evt.u.data.size);
+            delete[] evt.u.data.data;
+            evt.u.data.data = nullptr;
+            evt.u.data.size = 0U;
+        }
+    }
+}
+
+AsyncHttpClient* HttpScheduler::handleEvent(const Event& evt)
+{
+    HttpConnection*     connection  = evt.connection;
+    AsyncHttpClient*    client      = connection->getOwner();
+
+    if (evt.generation != connection->getGeneration())
+    {
+        LOG_DEBUG("Stale event %d of %s:%u discarded.", evt.id, connection->getHostname().c_str(), connection->getPort());
+        client = nullptr;
+    }
+    else
+    {
+        switch(evt.id)
+        {
+        case EVENT_ID_CONNECTED:
+            connection->setState(HttpConnection::STATE_CONNECTED);
+
+            /* Nobody is interested anymore. */
+            if (nullptr == client)
+            {
+                closeConnection(*connection);
+            }
+            break;
+
+        case EVENT_ID_DISCONNECTED:
+            connection->setState(HttpConnection::STATE_CLOSED);
+
+            if (nullptr != client)
+            {
+                if (connection == m_activeConnection)
+                {
+                    m_activeConnection = nullptr;
+                }
+
+                connection->setOwner(nullptr);
+            }
+            break;
+
+        case EVENT_ID_ERROR:
+            /* The server may have a new IP-address. */
+            m_dnsCache.invalidate(connection->getHostname());
+            break;
+
+        case EVENT_ID_DATA:
+            if (nullptr == client)
+            {
+                LOG_WARNING("Unexpected data from %s:%u discarded.", connection->getHostname().c_str(), connection->getPort());
+            }
+            break;
+
+        case EVENT_ID_TIMEOUT:
+            if (nullptr == client)
+            {
+                closeConnection(*connection);
+            }
+            break;
+
+        default:
+            client = nullptr;
+            break;
+        };
+    }
+
+    return client;
+}
+
+void HttpScheduler::notifyClient(const Event& evt, AsyncHttpClient& client)
+{
+    switch(evt.id)
+    {
+    case EVENT_ID_CONNECTED:
+        client.onConnect();
+        break;
+
+    case EVENT_ID_DISCONNECTED:
+        client.onDisconnect();
+        break;
+
+    case EVENT_ID_ERROR:
+        client.onError(evt.u.error);
+        break;
+
+    case EVENT_ID_DATA:
+        client.onData(evt.u.data.data, evt.u.data.size);
+        break;
+
+    case EVENT_ID_TIMEOUT:
+        client.onTimeout(evt.u.timeout);
+        break;
+
+    default:
+        break;
+    };
+}
+
+void HttpScheduler::processConnections()
+{
+    size_t                      index           = 0U;
+    AsyncHttpClient*            failedClient    = nullptr;
+    MutexGuard<MutexRecursive>  callbackGuard(m_callbackMutex);
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        for(index = 0U; index < MAX_CONNECTIONS; ++index)
+        {
+            HttpConnection& connection = m_connections[index];
+
+            if (true == connection.isKeepAliveExpired())
+            {
+                LOG_DEBUG("Keep-alive of connection to %s:%u expired.", connection.getHostname().c_str(), connection.getPort());
+                closeConnection(connection);
+            }
+            else if (true == connection.isCloseExpired())
+            {
+                connection.setState(HttpConnection::STATE_CLOSED);
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        /* Abort a stuck request, otherwise all other requests would wait forever. */
+        if ((nullptr != m_activeConnection) &&
+            (true == m_activeConnection->isRequestExpired()))
+        {
+            HttpConnection* connection = m_activeConnection;
+
+            LOG_WARNING("Request to %s:%u timed out.", connection->getHostname().c_str(), connection->getPort());
+
+            failedClient        = connection->getOwner();
+            m_activeConnection  = nullptr;
+            connection->setOwner(nullptr);
+            connection->getTcpClient().abort();
+            connection->setState(HttpConnection::STATE_CLOSING);
+        }
+    }
+
+    if (nullptr != failedClient)
+    {
+        failedClient->onRequestFailed();
+    }
+}
+
+void HttpScheduler::processCacheHits()
+{
+    size_t                      count           = 0U;
+    MutexGuard<MutexRecursive>  callbackGuard(m_callbackMutex);
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        count = m_cacheHits.getCount();
+    }
+
+    /* Only the already queued cache hits are served, because a client may
+     * request again in its callback.
+     */
+    while(0U < count)
+    {
+        AsyncHttpClient* client = nullptr;
+
+        /* Protect against concurrent access. */
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            client = m_cacheHits.getNext();
+            m_cacheHits.removeNext();
+        }
+
+        /* The client may be removed meanwhile. */
+        if (nullptr == client)
+        {
+            count = 0U;
+        }
+        else
+        {
+            client->serveFromCache();
+            --count;
+        }
+    }
+}
+
+void HttpScheduler::processRequests()
+{
+    AsyncHttpClient*            client          = nullptr;
+    AsyncHttpClient*            cachedClient    = nullptr;
+    AsyncHttpClient*            failedClient    = nullptr;
+    HttpConnection*             connection      = nullptr;
+    bool                        isReused        = false;
+    String                      hostname;
+    bool                        isSecure        = false;
+    MutexGuard<MutexRecursive>  callbackGuard(m_callbackMutex);
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if ((nullptr == m_activeConnection) &&
+            (0U < m_requests.getCount()))
+        {
+            client = m_requests.getNext();
+
+            /* The response may be cached meanwhile by another request. */
+            if (true == client->isCacheFresh())
+            {
+                m_requests.removeNext();
+                cachedClient = client;
+            }
+            else
+            {
+                connection = acquireConnection(*client);
+            }
+
+            /* If no connection is available, try again next time. */
+            if (nullptr != connection)
+            {
+                m_requests.removeNext();
+
+                m_activeConnection = connection;
+                connection->setOwner(client);
+                client->m_connection = connection;
+
+                /* Reuse connection, which was kept alive? */
+                if (HttpConnection::STATE_CONNECTED == connection->getState())
+                {
+                    LOG_INFO("Reusing connection to %s:%u.", connection->getHostname().c_str(), connection->getPort());
+
+                    client->m_isReusedConnection = true;
+                    isReused = true;
+                }
+                else
+                {
+                    client->m_isReusedConnection = false;
+
+                    hostname    = client->m_hostname;
+                    isSecure    = client->m_isSecure;
+                }
+            }
+        }
+    }
+
+    if (nullptr != cachedClient)
+    {
+        cachedClient->serveFromCache();
+    }
+    else if (true == isReused)
+    {
+        client->onConnect();
+    }
+    /* New connection necessary? */
+    else if (nullptr != connection)
+    {
+        IPAddress   ipAddress;
+        bool        isResolved  = false;
+
+        /* A secure connection needs the hostname for the server name indication (SNI),
+         * therefore the TCP client resolves the hostname itself.
+         */
+        if (false == isSecure)
+        {
+            isResolved = resolve(hostname, ipAddress);
+        }
+
+        /* Protect against concurrent access. */
+        {
+            MutexGuard<MutexRecursive> guard(m_mutex);
+
+            /* The client may be removed meanwhile. */
+            if (client == connection->getOwner())
+            {
+                if (false == connect(*connection, ipAddress, isResolved))
+                {
+                    LOG_WARNING("Couldn't connect to %s:%u.", connection->getHostname().c_str(), connection->getPort());
+
+                    m_activeConnection = nullptr;
+                    connection->setOwner(nullptr);
+                    failedClient = client;
+                }
+            }
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    if (nullptr != failedClient)
+    {
+        failedClient->onRequestFailed();
+    }
+}
+
+HttpConnection* HttpScheduler::acquireConnection(const AsyncHttpClient& client)
+{
+    HttpConnection* lruIdleConnection   = nullptr;
+    HttpConnection* connection          = m_connections.acquire(client.m_hostname, client.m_port, client.m_isSecure, lruIdleConnection);
+
+    /* Make room for the next time. */
+    if (nullptr != lruIdleConnection)
+    {
+        closeConnection(*lruIdleConnection);
+    }
+
+    return connection;
+}
+
+void HttpScheduler::closeConnection(HttpConnection& connection)
+{
+    if (true == connection.getTcpClient().connected())
+    {
+        LOG_INFO("Disconnecting from %s:%u.", connection.getHostname().c_str(), connection.getPort());
+        connection.getTcpClient().close();
+        connection.setState(HttpConnection::STATE_CLOSING);
+    }
+    else
+    {
+        connection.setState(HttpConnection::STATE_CLOSED);
+    }
+}
+
+bool HttpScheduler::connect(HttpConnection& connection, const IPAddress& ipAddress, bool isResolved)
+{
+    bool isSuccessful = false;
+
+    LOG_INFO("Connecting to %s:%u.", connection.getHostname().c_str(), connection.getPort());
+    LOG_DEBUG("Available heap: %u", ESP.getFreeHeap());
+
+    /* Any event, which is still queued, belongs to the former TCP connection. */
+    connection.nextGeneration();
+
+    if (true == isResolved)
+    {
+        isSuccessful = connection.getTcpClient().connect(ipAddress, connection.getPort());
+    }
+    else
+    {
+        isSuccessful = connection.getTcpClient().connect(connection.getHostname().c_str(), connection.getPort(), connection.isSecure());
+    }
+
+    if (true == isSuccessful)
+    {
+        connection.setState(HttpConnection::STATE_CONNECTING);
+    }
+
+    return isSuccessful;
+}
+
+bool HttpScheduler::resolve(const String& hostname, IPAddress& ipAddress)
+{
+    bool        isResolved          = false;
+    uint32_t    cachedIpAddress     = 0U;
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if (true == m_dnsCache.find(hostname, cachedIpAddress))
+        {
+            ipAddress   = cachedIpAddress;
+            isResolved  = true;
+        }
+    }
+
+    if (true == isResolved)
+    {
+        ;
+    }
+    /* No need to resolve a IP-address. */
+    else if (true == ipAddress.fromString(hostname))
+    {
+        isResolved = true;
+    }
+    /* Resolving may take a while, therefore its done without taking the mutex. */
+    else if (1 == WiFi.hostByName(hostname.c_str(), ipAddress))
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        m_dnsCache.add(hostname, static_cast<uint32_t>(ipAddress));
+
+        isResolved = true;
+    }
+    else
+    {
+        LOG_WARNING("Couldn't resolve %s.", hostname.c_str());
+    }
+
+    return isResolved;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,334 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP request scheduler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef HTTP_SCHEDULER_H
+#define HTTP_SCHEDULER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <freertos/FreeRTOS.h>
+#include <IPAddress.h>
+#include <Queue.hpp>
+#include <Mutex.hpp>
+#include <DnsCache.h>
+#include <HttpRequestQueue.hpp>
+#include <HttpConnectionPool.hpp>
+
+#include "HttpConnection.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HTTP request scheduler serves the requests of all asynchronous HTTP
+ * clients in a single task. The requests are queued by priority and handled
+ * one after another, because a secure connection needs about 50k of heap.
+ *
+ * Connections are kept alive after a request (if possible) and reused by
+ * the next request to the same server. Resolved hostnames are cached.
+ * Only one secure connection exists at a time. It is kept alive only, if
+ * enough heap is left for the other subsystems. A secure request to another
+ * server waits until the kept alive one is closed.
+ *
+ * The HTTP clients are notified without the scheduler mutex taken, so they
+ * may call the scheduler. Requests, which can be served from the cache, don't
+ * wait for a connection.
+ */
+class HttpScheduler
+{
+public:
+
+    /**
+     * Get the HTTP scheduler instance.
+     *
+     * @return HTTP scheduler instance
+     */
+    static HttpScheduler& getInstance()
+    {
+        static HttpScheduler instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Add request of the HTTP client to the request queue.
+     * The request is served as soon as all requests with a higher priority
+     * and all earlier requests with the same priority are served. A fresh
+     * cached response is served without waiting for a connection.
+     *
+     * @param[in] client    HTTP client
+     *
+     * @return If successful queued, it will return true otherwise false.
+     */
+    bool addRequest(AsyncHttpClient& client);
+
+    /**
+     * Remove all queued requests of the HTTP client and abort its connection.
+     * If the client is notified right now, it waits until the notification
+     * is finished. Therefore the client shall not be removed, while a
+     * resource is held, which the client needs in its callbacks.
+     *
+     * @param[in] client    HTTP client
+     */
+    void removeClient(AsyncHttpClient& client);
+
+    /**
+     * Release the connection after a completed request. The connection is
+     * kept alive for the next request to the same server. A secure connection
+     * is closed, if not enough heap is left.
+     *
+     * @param[in] connection    Connection
+     */
+    void releaseConnection(HttpConnection& connection);
+
+    /** Max. number of queued requests. */
+    static const size_t         MAX_REQUESTS            = 16U;
+
+    /** Max. number of connections. */
+    static const size_t         MAX_CONNECTIONS         = 3U;
+
+    /** Min. free heap in byte, which shall be left while a secure connection is kept alive. */
+    static const uint32_t       SECURE_KEEP_ALIVE_HEAP  = 40960U;
+
+private:
+
+    /** The process task stack size in bytes */
+    static const uint32_t       PROCESS_TASK_STACK_SIZE = 4096U;
+
+    /** The process task period in ms. */
+    static const uint32_t       PROCESS_TASK_PERIOD     = 20U;
+
+    /** The process task shall run on the APP MCU core. */
+    static const BaseType_t     PROCESS_TASK_RUN_CORE   = APP_CPU_NUM;
+
+    /** The process task priority shall be equal than the Arduino loop task priority. */
+    static const UBaseType_t    PROCESS_TASK_PRIORITY   = 1U;
+
+    /** Max. number of events which can be queued. */
+    static const size_t         EVT_QUEUE_SIZE          = 20U;
+
+    /**
+     * Event ids used to identify the informations notified by the TCP/IP stack.
+     */
+    enum EventId
+    {
+        EVENT_ID_CONNECTED = 0, /**< Connection is established. */
+        EVENT_ID_DISCONNECTED,  /**< Connection is disconnected. */
+        EVENT_ID_ERROR,         /**< A error happened. */
+        EVENT_ID_DATA,          /**< Data is received. */
+        EVENT_ID_TIMEOUT        /**< A connection timeout happened. */
+    };
+
+    /**
+     * A event is a combination of notification and its corresponding data.
+     */
+    struct Event
+    {
+        EventId         id;         /**< Event id to identify the kind of notification. */
+        HttpConnection* connection; /**< Connection, which notified the event. */
+        uint32_t        generation; /**< Generation of the transport connection, which notified the event. */
+
+        /**
+         * The union contains the event id specific parameters.
+         * Note not every event id must have parameters.
+         */
+        union
+        {
+            /**
+             * Data parameters, only valid for EVENT_ID_DATA.
+             */
+            struct
+            {
+                uint8_t*    data;   /**< Event specific data. */
+                size_t      size;   /**< Event specific data size in byte. */
+            } data;
+
+            int8_t      error;      /**< Error id, valid only for EVENT_ID_ERROR */
+            uint32_t    timeout;    /**< Timeout in ms, valid only for EVENT_ID_TIMEOUT */
+        } u;
+    };
+
+    /** Queued requests of the HTTP clients */
+    typedef HttpRequestQueue<AsyncHttpClient, MAX_REQUESTS> RequestQueue;
+
+    /** Connections to the servers */
+    typedef HttpConnectionPool<HttpConnection, MAX_CONNECTIONS> ConnectionPool;
+
+    TaskHandle_t        m_processTaskHandle;    /**< Process task handle */
+    MutexRecursive      m_mutex;                /**< Used to protect against concurrent access. */
+    MutexRecursive      m_callbackMutex;        /**< Held while a HTTP client is notified, so it can't be removed meanwhile. */
+    Queue<Event>        m_evtQueue;             /**< Event queue */
+    RequestQueue        m_requests;             /**< Queued requests of the HTTP clients */
+    RequestQueue        m_cacheHits;            /**< Queued requests, which are served from the cache */
+    ConnectionPool      m_connections;          /**< Connections */
+    HttpConnection*     m_activeConnection;     /**< Connection of the request, which is currently served. */
+    DnsCache            m_dnsCache;             /**< Resolved hostnames */
+
+    /**
+     * Constructs the HTTP scheduler.
+     */
+    HttpScheduler();
+
+    /**
+     * Destroys the HTTP scheduler.
+     */
+    ~HttpScheduler();
+
+    HttpScheduler(const HttpScheduler& scheduler);
+    HttpScheduler& operator=(const HttpScheduler& scheduler);
+
+    /**
+     * Register the TCP callbacks of the connection, which forward everything
+     * to the event queue.
+     *
+     * @param[in] connection    Connection
+     */
+    void registerCallbacks(HttpConnection& connection);
+
+    /**
+     * Create the process task which is responsible to process all requests and events.
+     *
+     * @return If successful it will return true otherwise false.
+     */
+    bool createProcessTask();
+
+    /**
+     * Processing task.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void processTask(void* parameters);
+
+    /**
+     * Process the event queue.
+     */
+    void processEvtQueue();
+
+    /**
+     * Handle the bookkeeping of a single event. Shall be called with the
+     * mutex taken. Events of a former transport connection of the same
+     * connection slot are stale and discarded, otherwise they would reach
+     * the client, which uses the connection now.
+     *
+     * @param[in] evt   Event
+     *
+     * @return HTTP client, which shall be notified. If none, it will return nullptr.
+     */
+    AsyncHttpClient* handleEvent(const Event& evt);
+
+    /**
+     * Notify the HTTP client about the event. Shall be called without the
+     * mutex taken.
+     *
+     * @param[in] evt       Event
+     * @param[in] client    HTTP client
+     */
+    void notifyClient(const Event& evt, AsyncHttpClient& client);
+
+    /**
+     * Process the connections: Close idle connections, whose keep-alive period
+     * expired and abort the current request in case of a timeout.
+     */
+    void processConnections();
+
+    /**
+     * Serve the queued cache hits, independent of the currently served request.
+     */
+    void processCacheHits();
+
+    /**
+     * Serve the next queued request, if no other request is currently served.
+     */
+    void processRequests();
+
+    /**
+     * Get a connection for the HTTP client. Preferred is a idle connection
+     * to the same server, then a closed one. If none is available, the least
+     * recently used idle connection will be closed.
+     *
+     * @param[in]   client      HTTP client
+     *
+     * @return Connection. If none is available, it will return nullptr.
+     */
+    HttpConnection* acquireConnection(const AsyncHttpClient& client);
+
+    /**
+     * Close the connection gracefully.
+     *
+     * @param[in] connection    Connection
+     */
+    void closeConnection(HttpConnection& connection);
+
+    /**
+     * Establish TCP connection to the server. The IP-address is only used
+     * if resolved, otherwise the hostname is resolved by the TCP client.
+     *
+     * @param[in] connection    Connection
+     * @param[in] ipAddress     IP-address of the server
+     * @param[in] isResolved    Is the IP-address resolved?
+     *
+     * @return If the connection procedure is pending, it will return true otherwise false.
+     */
+    bool connect(HttpConnection& connection, const IPAddress& ipAddress, bool isResolved);
+
+    /**
+     * Resolve hostname to IP-address by using the DNS cache.
+     * Note, the mutex shall not be taken, because it may block.
+     *
+     * @param[in]   hostname    Hostname
+     * @param[out]  ipAddress   Resolved IP-address
+     *
+     * @return If successful resolved, it will return true otherwise false.
+     */
+    bool resolve(const String& hostname, IPAddress& ipAddress);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTTP_SCHEDULER_H */
+
+/** @} */
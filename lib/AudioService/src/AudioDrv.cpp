@@ -35,6 +35,7 @@
 #include "AudioDrv.h"
 
 #include <Logging.h>
+#include <Tracer.h>
 #include <Board.h>
 
 /******************************************************************************
@@ -219,6 +220,8 @@ void AudioDrv::process()
         /* One DMA block finished? */
         else if (I2S_EVENT_RX_DONE == i2sEvt.type)
         {
+            TRACE_SCOPE("audio.dmaBlock");
+
             uint16_t            sampleIdx       = 0U;
             MutexGuard<Mutex>   guard(m_mutex);
 
@@ -254,6 +257,8 @@ void AudioDrv::process()
 
                         m_sampleWriteIndex = 0U;
 
+                        TRACE_BEGIN("audio.notify");
+
                         while(observerIndex < MAX_OBSERVERS)
                         {
                             IAudioObserver* observer = m_observers[observerIndex];
@@ -265,6 +270,8 @@ void AudioDrv::process()
 
                             ++observerIndex;
                         }
+
+                        TRACE_END("audio.notify");
                     }
                 }
             }
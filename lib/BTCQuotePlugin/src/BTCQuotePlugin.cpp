@@ -97,6 +97,9 @@ void BTCQuotePlugin::start(uint16_t width, uint16_t height)
         m_textWidget.move(0, offsY);
     }
 
+    /* The quote is only requested, if the slot is shown soon. */
+    (void)PollingService::getInstance().registerPoll(getUID(), UPDATE_PERIOD, 0U);
+
     initHttpClient();
 }
 
@@ -104,7 +107,7 @@ void BTCQuotePlugin::stop()
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
-    m_requestTimer.stop();
+    PollingService::getInstance().unregisterPoll(getUID());
 }
 
 void BTCQuotePlugin::process(bool isConnected)
@@ -113,44 +116,15 @@ void BTCQuotePlugin::process(bool isConnected)
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Only if a network connection is established the required information
-     * shall be periodically requested via REST API.
+     * shall be requested via REST API. When is decided by the polling service,
+     * depended on the slot schedule.
      */
-    if (false == m_requestTimer.isTimerRunning())
+    if ((true == isConnected) &&
+        (true == PollingService::getInstance().isPollDue(getUID())))
     {
-        if (true == isConnected)
+        if (false == startHttpRequest())
         {
-            if (false == startHttpRequest())
-            {
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
-        }
-    }
-    else
-    {
-        /* If the connection is lost, stop periodically requesting information
-         * via REST API.
-         */
-        if (false == isConnected)
-        {
-            m_requestTimer.stop();
-        }
-        /* Network connection is available and next request may be necessary for
-         * information update.
-         */
-        else if (true == m_requestTimer.isTimeout())
-        {
-            if (false == startHttpRequest())
-            {
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
+            PollingService::getInstance().reportResult(getUID(), false);
         }
     }
 
@@ -169,6 +143,13 @@ void BTCQuotePlugin::process(bool isConnected)
                 delete msg.rsp;
                 msg.rsp = nullptr;
             }
+
+            PollingService::getInstance().reportResult(getUID(), true);
+            break;
+
+        case MSG_TYPE_CONN_CLOSED:
+            /* Closed without a valid response before? */
+            PollingService::getInstance().reportResult(getUID(), false);
             break;
 
         default:
@@ -202,6 +183,15 @@ bool BTCQuotePlugin::startHttpRequest()
 
     if (true == m_client.begin(url))
     {
+        /* The stream filter gets its own copy of the filter, because the
+         * HTTP client task must never read plugin owned JSON.
+         */
+        {
+            MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+            (void)m_jsonStreamFilter.begin(m_jsonFilterDoc.as<JsonVariantConst>());
+        }
+
         if (false == m_client.GET())
         {
             LOG_WARNING("GET %s failed.", url.c_str());
@@ -220,7 +210,8 @@ void BTCQuotePlugin::initHttpClient()
 {
     /* Note: All registered callbacks are running in a different task context!
      *       Therefore it is not allowed to access a member here directly.
-     *       The processing must be deferred via task proxy.
+     *       The processing must be deferred via task proxy. The only exception
+     *       is the stream filter, which is protected by its own mutex.
      */
     m_client.regOnResponse(
         [this](const HttpResponse& rsp)
@@ -228,6 +219,27 @@ void BTCQuotePlugin::initHttpClient()
             handleAsyncWebResponse(rsp);
         }
     );
+
+    m_client.regOnRspPayload(
+        [this](const uint8_t* payload, size_t size)
+        {
+            /* Only the stream filter is accessed, which is protected by its own mutex. */
+            MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+            (void)m_jsonStreamFilter.write(payload, size);
+        }
+    );
+
+    m_client.regOnClosed(
+        [this]()
+        {
+            Msg msg;
+
+            msg.type = MSG_TYPE_CONN_CLOSED;
+
+            (void)this->m_taskProxy.send(msg);
+        }
+    );
 }
 
 void BTCQuotePlugin::handleAsyncWebResponse(const HttpResponse& rsp)
@@ -239,44 +251,31 @@ void BTCQuotePlugin::handleAsyncWebResponse(const HttpResponse& rsp)
 
         if (nullptr != jsonDoc)
         {
-            size_t                          payloadSize = 0U;
-            const void*                     vPayload    = rsp.getPayload(payloadSize);
-            const char*                     payload     = static_cast<const char*>(vPayload);
-            const size_t                    FILTER_SIZE = 128U;
-            StaticJsonDocument<FILTER_SIZE> filter;
+            DeserializationError error;
 
-            filter["bpi"]["USD"]["rate_float"]  = true;
-            filter["bpi"]["USD"]["rate"]        = true;
-
-            if (true == filter.overflowed())
             {
-                LOG_ERROR("Less memory for filter available.");
+                MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+                error = m_jsonStreamFilter.deserialize(*jsonDoc);
             }
-            else if ((nullptr == payload) ||
-                     (0U == payloadSize))
+
+            if (DeserializationError::Ok != error.code())
             {
-                LOG_ERROR("No payload.");
+                LOG_ERROR("Invalid JSON message received: %s", error.c_str());
+                delete jsonDoc;
+                jsonDoc = nullptr;
             }
             else
             {
-                DeserializationError error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+                Msg msg;
 
-                if (DeserializationError::Ok != error.code())
-                {
-                    LOG_ERROR("Invalid JSON message received: %s", error.c_str());
-                }
-                else
-                {
-                    Msg msg;
+                msg.type    = MSG_TYPE_RSP;
+                msg.rsp     = jsonDoc;
 
-                    msg.type    = MSG_TYPE_RSP;
-                    msg.rsp     = jsonDoc;
-
-                    if (false == this->m_taskProxy.send(msg))
-                    {
-                        delete jsonDoc;
-                        jsonDoc = nullptr;
-                    }
+                if (false == this->m_taskProxy.send(msg))
+                {
+                    delete jsonDoc;
+                    jsonDoc = nullptr;
                 }
             }
         }
@@ -52,6 +52,8 @@
 #include <SimpleTimer.hpp>
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
+#include <JsonStreamFilter.h>
+#include <PollingService.h>
 
 /******************************************************************************
  * Macros
@@ -86,11 +88,17 @@ public:
         m_textWidget("\\calign?"),
         m_relevantResponsePart(""),
         m_client(),
+        m_jsonFilterDoc(),
+        m_jsonStreamFilter(JSON_STREAM_FILTER_SIZE, JSON_FILTER_DOC_SIZE),
+        m_streamFilterMutex(),
         m_mutex(),
-        m_requestTimer(),
         m_taskProxy()
     {
         (void)m_mutex.create();
+        (void)m_streamFilterMutex.create();
+
+        m_jsonFilterDoc["bpi"]["USD"]["rate_float"]  = true;
+        m_jsonFilterDoc["bpi"]["USD"]["rate"]        = true;
     }
 
     /**
@@ -99,6 +107,7 @@ public:
     ~BTCQuotePlugin()
     {
         m_client.regOnResponse(nullptr);
+        m_client.regOnRspPayload(nullptr);
         m_client.regOnClosed(nullptr);
         m_client.regOnError(nullptr);
 
@@ -109,6 +118,7 @@ public:
         
         clearQueue();
 
+        m_streamFilterMutex.destroy();
         m_mutex.destroy();
     }
 
@@ -209,15 +219,23 @@ private:
     static const char*      BTC_USD_IMAGE_PATH;
     /**
      * Period in ms for requesting quotes from Server (15 Minutes) (1 for testing!)
-     * This is used in case the last request to the server was successful.
+     * This is used while the slot is shown. Failed requests are retried by
+     * the polling service.
      */
     static const uint32_t   UPDATE_PERIOD       = SIMPLE_TIMER_MINUTES(15U);
 
     /**
-     * Short period in ms for requesting quote from server.
-     * This is used in case the request to the server failed.
+     * Size in byte of the JSON filter document, which is used to select the
+     * relevant parts of the response.
+     */
+    static const size_t     JSON_FILTER_DOC_SIZE    = 128U;
+
+    /**
+     * Size in byte of the buffer, which contains the filtered response.
+     * The response is filtered while its received, therefore only the
+     * relevant parts need to fit into.
      */
-    static const uint32_t   UPDATE_PERIOD_SHORT = SIMPLE_TIMER_MINUTES(1U);
+    static const size_t     JSON_STREAM_FILTER_SIZE = 128U;
 
     Fonts::FontType     m_fontType;                 /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup         m_textCanvas;               /**< Canvas used for the text widget. */
@@ -226,8 +244,10 @@ private:
     TextWidget          m_textWidget;               /**< Text widget, used for showing the text. */
     String              m_relevantResponsePart;     /**< String used for the relevant part of the HTTP response. */
     AsyncHttpClient     m_client;                   /**< Asynchronous HTTP client. */
+    StaticJsonDocument<JSON_FILTER_DOC_SIZE>    m_jsonFilterDoc;    /**< Filter used to select the relevant parts of the response. */
+    JsonStreamFilter    m_jsonStreamFilter;         /**< Filters the response while its received. */
+    Mutex               m_streamFilterMutex;        /**< Protects the stream filter, which is fed by the HTTP client task. */
     MutexRecursive      m_mutex;                    /**< Mutex to protect against concurrent access. */
-    SimpleTimer         m_requestTimer;             /**< Timer is used for cyclic weather http request. */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
@@ -235,7 +255,8 @@ private:
     enum MsgType
     {
         MSG_TYPE_INVALID = 0,   /**< Invalid message type. */
-        MSG_TYPE_RSP            /**< A response, caused by a previous request. */
+        MSG_TYPE_RSP,           /**< A response, caused by a previous request. */
+        MSG_TYPE_CONN_CLOSED    /**< The connection is closed. */
     };
 
     /**
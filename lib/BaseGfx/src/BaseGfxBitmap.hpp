@@ -47,6 +47,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <BaseGfx.hpp>
+#include <HeapAccounting.hpp>
 #include <new>
 
 /******************************************************************************
@@ -362,7 +363,11 @@ public:
                     m_height    = 0U;
                 }
 
-                m_pixels = allocatePixels(bitmap.m_width, bitmap.m_height);
+                /* Keep the existing pixel buffer, if it has already the right size. */
+                if (nullptr == m_pixels)
+                {
+                    m_pixels = allocatePixels(bitmap.m_width, bitmap.m_height);
+                }
 
                 if (nullptr != m_pixels)
                 {
@@ -514,6 +519,28 @@ public:
         }
     }
 
+    /**
+     * Get direct access to the pixels of a single row. This is intended for
+     * image decoders, which write whole rows and shall avoid the overhead of
+     * drawing pixel by pixel.
+     *
+     * @param[in] y y-coordinate of the row
+     *
+     * @return If available, it will return the pixels of the row otherwise nullptr.
+     */
+    TColor* getRow(uint16_t y)
+    {
+        TColor* row = nullptr;
+
+        if ((nullptr != m_pixels) &&
+            (m_height > y))
+        {
+            row = &m_pixels[pixelMap(0U, y)];
+        }
+
+        return row;
+    }
+
     /**
      * Use this function to determine whether a internal bitmap buffer is allocated or not.
      * 
@@ -546,6 +573,7 @@ private:
 
     /**
      * Release pixel buffer if allocated.
+     * The bitmap dimensions must still be the ones of the pixel buffer.
      * 
      * @param[inout] pixels     Pixel buffer which to release.
      */
@@ -553,6 +581,8 @@ private:
     {
         if (nullptr != pixels)
         {
+            HeapAccounting::getInstance().released(HeapAccounting::TAG_GFX, m_width * m_height * sizeof(TColor));
+
             delete[] pixels;
             pixels = nullptr;
         }
@@ -574,6 +604,8 @@ private:
             (0U < height))
         {
             buffer = new(std::nothrow) TColor[width * height];
+
+            HeapAccounting::getInstance().track(HeapAccounting::TAG_GFX, buffer, width * height * sizeof(TColor));
         }
 
         return buffer;
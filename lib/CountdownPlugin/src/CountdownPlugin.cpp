@@ -159,19 +159,6 @@ bool CountdownPlugin::setTopic(const String& topic, const JsonObjectConst& value
     return isSuccessful;
 }
 
-bool CountdownPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void CountdownPlugin::start(uint16_t width, uint16_t height)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -211,15 +198,6 @@ void CountdownPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
-
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
 
     calculateRemainingDays();
 }
@@ -229,9 +207,8 @@ void CountdownPlugin::stop()
     String                      configurationFilename   = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -244,34 +221,23 @@ void CountdownPlugin::process(bool isConnected)
     PLUGIN_NOT_USED(isConnected);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -302,9 +268,7 @@ void CountdownPlugin::update(YAGfx& gfx)
 
 void CountdownPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void CountdownPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -357,7 +321,7 @@ bool CountdownPlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_targetDateInformation.plural      = jsonDescPlural.as<String>();
         m_targetDateInformation.singular    = jsonDescSingular.as<String>();
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
@@ -51,7 +51,6 @@
 #include <BitmapWidget.h>
 #include <stdint.h>
 #include <TextWidget.h>
-#include <SimpleTimer.hpp>
 #include <Mutex.hpp>
 #include <FileSystem.h>
 
@@ -189,10 +188,7 @@ public:
         m_targetDateInformation(),
         m_remainingDays(""),
         m_mutex(),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
-        m_reloadConfigReq(false),
-        m_hasTopicChanged(false)
+        m_reloadConfigReq(false)
     {
         /* Example data, used to generate the very first configuration file. */
         m_targetDate.day                    = 1U;
@@ -302,17 +298,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -388,13 +373,6 @@ private:
     */
     static const int16_t    TM_OFFSET_YEAR  = 1900;
 
-    /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
-     */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
-
     Fonts::FontType         m_fontType;                 /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup             m_textCanvas;               /**< Canvas used for the text widget. */
     WidgetGroup             m_iconCanvas;               /**< Canvas used for the bitmap widget. */
@@ -405,10 +383,7 @@ private:
     TargetDayDescription    m_targetDateInformation;    /**< String used for configured additional target date information. */
     String                  m_remainingDays;            /**< String used for displaying the remaining days untril the target date. */
     mutable MutexRecursive  m_mutex;                    /**< Mutex to protect against concurrent access. */
-    SimpleTimer             m_cfgReloadTimer;           /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;           /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;          /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;          /**< Has the topic content changed? */
 
     /**
      * Request to store configuration to persistent memory.
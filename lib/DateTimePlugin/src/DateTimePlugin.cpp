@@ -174,19 +174,6 @@ bool DateTimePlugin::setTopic(const String& topic, const JsonObjectConst& value)
     return isSuccessful;
 }
 
-bool DateTimePlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void DateTimePlugin::setSlot(const ISlotPlugin* slotInterf)
 {
     m_slotInterf = slotInterf;
@@ -238,15 +225,6 @@ void DateTimePlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
-
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
 
     m_lampCanvas.setPosAndSize(1, height - 1, width, 1U);
 
@@ -275,9 +253,8 @@ void DateTimePlugin::stop()
     String                      configurationFilename   = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -290,34 +267,23 @@ void DateTimePlugin::process(bool isConnected)
     PLUGIN_NOT_USED(isConnected);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -380,9 +346,7 @@ void DateTimePlugin::update(YAGfx& gfx)
 
 void DateTimePlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void DateTimePlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -443,7 +407,7 @@ bool DateTimePlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_dayOnColor    = colorFromHtml(jsonDayOnColor.as<String>());
         m_dayOffColor   = colorFromHtml(jsonDayOffColor.as<String>());
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
@@ -95,10 +95,7 @@ public:
         m_dayOffColor(DAY_OFF_COLOR),
         m_slotInterf(nullptr),
         m_mutex(),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
-        m_reloadConfigReq(false),
-        m_hasTopicChanged(false)
+        m_reloadConfigReq(false)
     {
         (void)m_mutex.create();
     }
@@ -176,17 +173,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Set the slot interface, which the plugin can used to request information
      * from the slot, it is plugged in.
@@ -298,13 +284,6 @@ private:
      */
     static const uint32_t   DURATION_DEFAULT        = SIMPLE_TIMER_SECONDS(30U);
 
-    /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
-     */
-    static const uint32_t   CFG_RELOAD_PERIOD       = SIMPLE_TIMER_SECONDS(30U);
-
     TextWidget              m_textWidget;               /**< Text widget, used for showing the text. */
     WidgetGroup             m_textCanvas;               /**< Canvas used for the text widget. */
     WidgetGroup             m_lampCanvas;               /**< Canvas used for the lamp widget. */
@@ -322,10 +301,7 @@ private:
     Color                   m_dayOffColor;              /**< Color of the other days in the day of the week bar. */
     const ISlotPlugin*      m_slotInterf;               /**< Slot interface */
     mutable MutexRecursive  m_mutex;                    /**< Mutex to protect against concurrent access. */
-    SimpleTimer             m_cfgReloadTimer;           /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;           /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;          /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;          /**< Has the topic content changed? */
 
     /**
      * Request to store configuration to persistent memory.
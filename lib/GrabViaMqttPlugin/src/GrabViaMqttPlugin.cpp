@@ -181,19 +181,6 @@ bool GrabViaMqttPlugin::setTopic(const String& topic, const JsonObjectConst& val
     return isSuccessful;
 }
 
-bool GrabViaMqttPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void GrabViaMqttPlugin::start(uint16_t width, uint16_t height)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -237,21 +224,12 @@ void GrabViaMqttPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
 
     if (false == m_iconPath.isEmpty())
     {
         (void)m_iconWidget.load(FILESYSTEM, m_iconPath);
     }
 
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
-
     subscribe();
 }
 
@@ -260,10 +238,9 @@ void GrabViaMqttPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
     unsubscribe();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -274,34 +251,23 @@ void GrabViaMqttPlugin::process(bool isConnected)
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -339,9 +305,7 @@ void GrabViaMqttPlugin::update(YAGfx& gfx)
 
 void GrabViaMqttPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void GrabViaMqttPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -446,7 +410,7 @@ bool GrabViaMqttPlugin::setConfiguration(JsonObjectConst& jsonCfg)
             }
         }
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
@@ -90,10 +90,7 @@ public:
         m_multiplier(1.0f),
         m_offset(0.0f),
         m_mutex(),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
-        m_reloadConfigReq(false),
-        m_hasTopicChanged(false)
+        m_reloadConfigReq(false)
     {
         (void)m_mutex.create();
     }
@@ -196,17 +193,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -265,13 +251,6 @@ private:
      */
     static const char*      TOPIC_CONFIG;
 
-    /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
-     */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
-
     Fonts::FontType         m_fontType;             /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup             m_layoutRight;          /**< Canvas used for the text widget in a layout with icon on the left side. */
     WidgetGroup             m_layoutLeft;           /**< Canvas used for the bitmap widget in a layout with text on the right side. */
@@ -286,10 +265,7 @@ private:
     float                   m_multiplier;           /**< If grabbed value is a number, it will be multiplied with the multiplier. */
     float                   m_offset;               /**< If grabbed value is a number, the offset will be added after the multiplication with the multiplier. */
     mutable MutexRecursive  m_mutex;                /**< Mutex to protect against concurrent access. */
-    SimpleTimer             m_cfgReloadTimer;       /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;       /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;      /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;      /**< Has the topic content changed? */
 
     /**
      * Request to store configuration to persistent memory.
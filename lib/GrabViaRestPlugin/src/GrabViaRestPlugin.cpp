@@ -188,19 +188,6 @@ bool GrabViaRestPlugin::setTopic(const String& topic, const JsonObjectConst& val
     return isSuccessful;
 }
 
-bool GrabViaRestPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void GrabViaRestPlugin::start(uint16_t width, uint16_t height)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -244,20 +231,14 @@ void GrabViaRestPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
 
     if (false == m_iconPath.isEmpty())
     {
         (void)m_iconWidget.load(FILESYSTEM, m_iconPath);
     }
 
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
+    /* The data is only requested, if the slot is shown soon. */
+    (void)PollingService::getInstance().registerPoll(getUID(), UPDATE_PERIOD, 0U);
 
     initHttpClient();
 }
@@ -267,10 +248,9 @@ void GrabViaRestPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
-    m_requestTimer.stop();
+    PollingService::getInstance().unregisterPoll(getUID());
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -282,34 +262,23 @@ void GrabViaRestPlugin::process(bool isConnected)
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -319,52 +288,19 @@ void GrabViaRestPlugin::process(bool isConnected)
     }
 
     /* Only if a network connection is established the required information
-     * shall be periodically requested via REST API.
+     * shall be requested via REST API. When is decided by the polling service,
+     * depended on the slot schedule.
      */
-    if (false == m_requestTimer.isTimerRunning())
+    if ((true == isConnected) &&
+        (true == PollingService::getInstance().isPollDue(getUID())))
     {
-        if (true == isConnected)
-        {
-            if (false == startHttpRequest())
-            {
-                /* If a request fails, a '?' will be shown. */
-                m_textWidgetRight.setFormatStr("\\calign?");
-                m_textWidgetTextOnly.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
-        }
-    }
-    else
-    {
-        /* If the connection is lost, stop periodically requesting information
-         * via REST API.
-         */
-        if (false == isConnected)
-        {
-            m_requestTimer.stop();
-        }
-        /* Network connection is available and next request may be necessary for
-         * information update.
-         */
-        else if (true == m_requestTimer.isTimeout())
+        if (false == startHttpRequest())
         {
-            if (false == startHttpRequest())
-            {
-                /* If a request fails, a '?' will be shown. */
-                m_textWidgetRight.setFormatStr("\\calign?");
-                m_textWidgetTextOnly.setFormatStr("\\calign?");
+            /* If a request fails, a '?' will be shown. */
+            m_textWidgetRight.setFormatStr("\\calign?");
+            m_textWidgetTextOnly.setFormatStr("\\calign?");
 
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
+            PollingService::getInstance().reportResult(getUID(), false);
         }
     }
 
@@ -383,6 +319,8 @@ void GrabViaRestPlugin::process(bool isConnected)
                 delete msg.rsp;
                 msg.rsp = nullptr;
             }
+
+            PollingService::getInstance().reportResult(getUID(), true);
             break;
 
         case MSG_TYPE_CONN_CLOSED:
@@ -393,10 +331,11 @@ void GrabViaRestPlugin::process(bool isConnected)
                 /* If a request fails, show standard icon and a '?' */
                 m_textWidgetRight.setFormatStr("\\calign?");
                 m_textWidgetTextOnly.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
             }
             m_isConnectionError = false;
+
+            /* Closed without a valid response before? */
+            PollingService::getInstance().reportResult(getUID(), false);
             break;
 
         case MSG_TYPE_CONN_ERROR:
@@ -439,9 +378,7 @@ void GrabViaRestPlugin::update(YAGfx& gfx)
 
 void GrabViaRestPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void GrabViaRestPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -515,7 +452,7 @@ bool GrabViaRestPlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_offset        = jsonOffset.as<float>();
 
         /* Force update on display */
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        PollingService::getInstance().triggerPoll(getUID());
 
         /* Load icon immediately */
         if (true == reqIcon)
@@ -544,7 +481,7 @@ bool GrabViaRestPlugin::setConfiguration(JsonObjectConst& jsonCfg)
             }
         }
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
@@ -558,8 +495,21 @@ bool GrabViaRestPlugin::startHttpRequest()
 
     if (false == m_url.isEmpty())
     {
-        if (true == m_client.begin(m_url))
+        if (true == m_filter.overflowed())
         {
+            LOG_ERROR("Less memory for filter available.");
+        }
+        else if (true == m_client.begin(m_url))
+        {
+            /* The stream filter gets its own copy of the filter, because the
+             * HTTP client task must never read the plugin configuration.
+             */
+            {
+                MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+                (void)m_jsonStreamFilter.begin(m_filter.as<JsonVariantConst>());
+            }
+
             if (true == m_method.equalsIgnoreCase("GET"))
             {
                 if (false == m_client.GET())
@@ -596,7 +546,8 @@ void GrabViaRestPlugin::initHttpClient()
 {
     /* Note: All registered callbacks are running in a different task context!
      *       Therefore it is not allowed to access a member here directly.
-     *       The processing must be deferred via task proxy.
+     *       The processing must be deferred via task proxy. The only exception
+     *       is the stream filter, which is protected by its own mutex.
      */
     m_client.regOnResponse(
         [this](const HttpResponse& rsp)
@@ -605,6 +556,16 @@ void GrabViaRestPlugin::initHttpClient()
         }
     );
 
+    m_client.regOnRspPayload(
+        [this](const uint8_t* payload, size_t size)
+        {
+            /* Only the stream filter is accessed, which is protected by its own mutex. */
+            MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+            (void)m_jsonStreamFilter.write(payload, size);
+        }
+    );
+
     m_client.regOnClosed(
         [this]()
         {
@@ -637,39 +598,31 @@ void GrabViaRestPlugin::handleAsyncWebResponse(const HttpResponse& rsp)
 
         if (nullptr != jsonDoc)
         {
-            size_t                  payloadSize = 0U;
-            const void*             vPayload    = rsp.getPayload(payloadSize);
-            const char*             payload     = static_cast<const char*>(vPayload);
-            
-            if (true == m_filter.overflowed())
+            DeserializationError error;
+
             {
-                LOG_ERROR("Less memory for filter available.");
+                MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+                error = m_jsonStreamFilter.deserialize(*jsonDoc);
             }
-            else if ((nullptr == payload) ||
-                     (0U == payloadSize))
+
+            if (DeserializationError::Ok != error.code())
             {
-                LOG_ERROR("No payload.");
+                LOG_WARNING("JSON parse error: %s", error.c_str());
+                delete jsonDoc;
+                jsonDoc = nullptr;
             }
             else
             {
-                DeserializationError error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(m_filter));
-
-                if (DeserializationError::Ok != error.code())
-                {
-                    LOG_WARNING("JSON parse error: %s", error.c_str());
-                }
-                else
-                {
-                    Msg msg;
+                Msg msg;
 
-                    msg.type    = MSG_TYPE_RSP;
-                    msg.rsp     = jsonDoc;
+                msg.type    = MSG_TYPE_RSP;
+                msg.rsp     = jsonDoc;
 
-                    if (false == this->m_taskProxy.send(msg))
-                    {
-                        delete jsonDoc;
-                        jsonDoc = nullptr;
-                    }
+                if (false == this->m_taskProxy.send(msg))
+                {
+                    delete jsonDoc;
+                    jsonDoc = nullptr;
                 }
             }
         }
@@ -53,6 +53,8 @@
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
 #include <FileSystem.h>
+#include <PollingService.h>
+#include <JsonStreamFilter.h>
 
 /******************************************************************************
  * Macros
@@ -87,22 +89,21 @@ public:
         m_textWidgetTextOnly("\\calign?"),
         m_method("GET"),
         m_url(),
-        m_filter(1024U),
+        m_filter(JSON_FILTER_SIZE),
         m_client(),
+        m_jsonStreamFilter(JSON_STREAM_FILTER_SIZE, JSON_FILTER_SIZE),
+        m_streamFilterMutex(),
         m_iconPath(),
         m_format("%s"),
         m_multiplier(1.0f),
         m_offset(0.0f),
-        m_requestTimer(),
         m_mutex(),
         m_isConnectionError(false),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
         m_reloadConfigReq(false),
-        m_hasTopicChanged(false),
         m_taskProxy()
     {
         (void)m_mutex.create();
+        (void)m_streamFilterMutex.create();
     }
 
     /**
@@ -111,6 +112,7 @@ public:
     ~GrabViaRestPlugin()
     {
         m_client.regOnResponse(nullptr);
+        m_client.regOnRspPayload(nullptr);
         m_client.regOnClosed(nullptr);
         m_client.regOnError(nullptr);
 
@@ -121,6 +123,7 @@ public:
         
         clearQueue();
 
+        m_streamFilterMutex.destroy();
         m_mutex.destroy();
     }
 
@@ -214,17 +217,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -284,23 +276,22 @@ private:
     static const char*      TOPIC_CONFIG;
 
     /**
-     * Period in ms for requesting data from server.
-     * This is used in case the last request to the server was successful.
+     * Period in ms for requesting data from server, while the slot is shown.
+     * Failed requests are retried by the polling service.
      */
     static const uint32_t   UPDATE_PERIOD       = SIMPLE_TIMER_MINUTES(2U);
 
     /**
-     * Short period in ms for requesting data from server.
-     * This is used in case the request to the server failed.
+     * Size in byte of the buffer, which contains the filtered response.
+     * The response is filtered while its received, therefore only the
+     * relevant parts need to fit into.
      */
-    static const uint32_t   UPDATE_PERIOD_SHORT = SIMPLE_TIMER_SECONDS(10U);
+    static const size_t     JSON_STREAM_FILTER_SIZE = 512U;
 
     /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
+     * Size in byte of the JSON document, which contains the response filter.
      */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
+    static const size_t     JSON_FILTER_SIZE        = 1024U;
 
     Fonts::FontType         m_fontType;             /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup             m_layoutRight;          /**< Canvas used for the text widget in a layout with icon on the left side. */
@@ -313,17 +304,15 @@ private:
     String                  m_url;                  /**< REST URL. */
     DynamicJsonDocument     m_filter;               /**< Filter used for the response in JSON format. */
     AsyncHttpClient         m_client;               /**< Asynchronous HTTP client. */
+    JsonStreamFilter        m_jsonStreamFilter;     /**< Filters the response while its received. */
+    Mutex                   m_streamFilterMutex;    /**< Protects the stream filter, which is fed by the HTTP client task. */
     String                  m_iconPath;             /**< Icon filename with path. */
     String                  m_format;               /**< Format used to embed the retrieved filtered value. */
     float                   m_multiplier;           /**< If grabbed value is a number, it will be multiplied with the multiplier. */
     float                   m_offset;               /**< If grabbed value is a number, the offset will be added after the multiplication with the multiplier. */
-    SimpleTimer             m_requestTimer;         /**< Timer used for cyclic request of new data. */
     mutable MutexRecursive  m_mutex;                /**< Mutex to protect against concurrent access. */
     bool                    m_isConnectionError;    /**< Is connection error happened? */
-    SimpleTimer             m_cfgReloadTimer;       /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;       /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;      /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;      /**< Has the topic content changed? */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
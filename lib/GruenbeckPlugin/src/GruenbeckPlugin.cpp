@@ -132,19 +132,6 @@ bool GruenbeckPlugin::setTopic(const String& topic, const JsonObjectConst& value
     return isSuccessful;
 }
 
-bool GruenbeckPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void GruenbeckPlugin::start(uint16_t width, uint16_t height)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -187,15 +174,9 @@ void GruenbeckPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
 
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
+    /* The value is only requested, if the slot is shown soon. */
+    (void)PollingService::getInstance().registerPoll(getUID(), UPDATE_PERIOD, 0U);
 
     initHttpClient();
 }
@@ -205,10 +186,9 @@ void GruenbeckPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
-    m_requestTimer.stop();
+    PollingService::getInstance().unregisterPoll(getUID());
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -220,34 +200,23 @@ void GruenbeckPlugin::process(bool isConnected)
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -257,50 +226,18 @@ void GruenbeckPlugin::process(bool isConnected)
     }
 
     /* Only if a network connection is established the required information
-     * shall be periodically requested via REST API.
+     * shall be requested via REST API. When is decided by the polling service,
+     * depended on the slot schedule.
      */
-    if (false == m_requestTimer.isTimerRunning())
-    {
-        if (true == isConnected)
-        {
-            if (false == startHttpRequest())
-            {
-                /* If a request fails, show standard icon and a '?' */
-                m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
-        }
-    }
-    else
+    if ((true == isConnected) &&
+        (true == PollingService::getInstance().isPollDue(getUID())))
     {
-        /* If the connection is lost, stop periodically requesting information
-         * via REST API.
-         */
-        if (false == isConnected)
-        {
-            m_requestTimer.stop();
-        }
-        /* Network connection is available and next request may be necessary for
-         * information update.
-         */
-        else if (true == m_requestTimer.isTimeout())
+        if (false == startHttpRequest())
         {
-            if (false == startHttpRequest())
-            {
-                /* If a request fails, show standard icon and a '?' */
-                m_textWidget.setFormatStr("\\calign?");
+            /* If a request fails, show standard icon and a '?' */
+            m_textWidget.setFormatStr("\\calign?");
 
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
+            PollingService::getInstance().reportResult(getUID(), false);
         }
     }
 
@@ -319,6 +256,8 @@ void GruenbeckPlugin::process(bool isConnected)
                 delete msg.rsp;
                 msg.rsp = nullptr;
             }
+
+            PollingService::getInstance().reportResult(getUID(), true);
             break;
 
         case MSG_TYPE_CONN_CLOSED:
@@ -328,10 +267,11 @@ void GruenbeckPlugin::process(bool isConnected)
             {
                 /* If a request fails, show a '?' */
                 m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
             }
             m_isConnectionError = false;
+
+            /* Closed without a valid response before? */
+            PollingService::getInstance().reportResult(getUID(), false);
             break;
 
         case MSG_TYPE_CONN_ERROR:
@@ -388,9 +328,7 @@ void GruenbeckPlugin::update(YAGfx& gfx)
 
 void GruenbeckPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void GruenbeckPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -416,9 +354,9 @@ bool GruenbeckPlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_ipAddress = jsonIpAddress.as<String>();
 
         /* Force update on display */
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        PollingService::getInstance().triggerPoll(getUID());
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
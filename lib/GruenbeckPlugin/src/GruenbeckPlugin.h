@@ -54,6 +54,7 @@
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
 #include <FileSystem.h>
+#include <PollingService.h>
 
 /******************************************************************************
  * Macros
@@ -89,13 +90,9 @@ public:
         m_httpResponseReceived(false),
         m_relevantResponsePart(),
         m_client(),
-        m_requestTimer(),
         m_mutex(),
         m_isConnectionError(false),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
         m_reloadConfigReq(false),
-        m_hasTopicChanged(false),
         m_taskProxy()
     {
         (void)m_mutex.create();
@@ -210,17 +207,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -299,24 +285,11 @@ private:
     static const char*      TOPIC_CONFIG;
 
     /**
-     * Period in ms for requesting data from server.
-     * This is used in case the last request to the server was successful.
+     * Period in ms for requesting data from server, while the slot is shown.
+     * Failed requests are retried by the polling service.
      */
     static const uint32_t   UPDATE_PERIOD       = SIMPLE_TIMER_MINUTES(60U);
 
-    /**
-     * Short period in ms for requesting data from server.
-     * This is used in case the request to the server failed.
-     */
-    static const uint32_t   UPDATE_PERIOD_SHORT = SIMPLE_TIMER_SECONDS(10U);
-
-    /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
-     */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
-
     Fonts::FontType         m_fontType;                 /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup             m_textCanvas;               /**< Canvas used for the text widget. */
     WidgetGroup             m_iconCanvas;               /**< Canvas used for the bitmap widget. */
@@ -326,13 +299,9 @@ private:
     bool                    m_httpResponseReceived;     /**< Flag to indicate a received HTTP response. */
     String                  m_relevantResponsePart;     /**< String used for the relevant part of the HTTP response. */
     AsyncHttpClient         m_client;                   /**< Asynchronous HTTP client. */
-    SimpleTimer             m_requestTimer;             /**< Timer, used for cyclic request of new data. */
     mutable MutexRecursive  m_mutex;                    /**< Mutex to protect against concurrent access. */
     bool                    m_isConnectionError;        /**< Is connection error happened? */
-    SimpleTimer             m_cfgReloadTimer;           /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;           /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;          /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;          /**< Has the topic content changed? */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
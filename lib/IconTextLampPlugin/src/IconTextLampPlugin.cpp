@@ -36,6 +36,7 @@
 #include "FileSystem.h"
 
 #include <Logging.h>
+#include <NativeImg.h>
 #include <ArduinoJson.h>
 #include <Util.h>
 
@@ -297,48 +298,6 @@ bool IconTextLampPlugin::setTopic(const String& topic, const JsonObjectConst& va
     return isSuccessful;
 }
 
-bool IconTextLampPlugin::hasTopicChanged(const String& topic)
-{
-    bool hasTopicChanged = false;
-
-    if (0U != topic.equals(TOPIC_TEXT))
-    {
-        MutexGuard<MutexRecursive> guard(m_mutex);
-
-        hasTopicChanged = m_hasTopicTextChanged;
-        m_hasTopicTextChanged = false;
-    }
-    else if (0U != topic.equals(TOPIC_LAMPS))
-    {
-        MutexGuard<MutexRecursive> guard(m_mutex);
-
-        hasTopicChanged = m_hasTopicLampsChanged;
-        m_hasTopicLampsChanged = false;
-    }
-    else if (0U != topic.startsWith(String(TOPIC_LAMP) + "/"))
-    {
-        uint32_t    indexBeginLampId    = topic.lastIndexOf("/") + 1U;
-        String      lampIdStr           = topic.substring(indexBeginLampId);
-        uint8_t     lampId              = MAX_LAMPS;
-        bool        status              = Util::strToUInt8(lampIdStr, lampId);
-
-        if ((true == status) &&
-            (MAX_LAMPS > lampId))
-        {
-            MutexGuard<MutexRecursive> guard(m_mutex);
-            
-            hasTopicChanged = m_hasTopicLampChanged[lampId];
-            m_hasTopicLampChanged[lampId] = false;
-        }
-    }
-    else
-    {
-        ;
-    }
-
-    return hasTopicChanged;
-}
-
 bool IconTextLampPlugin::isUploadAccepted(const String& topic, const String& srcFilename, String& dstFilename)
 {
     bool isAccepted = false;
@@ -451,8 +410,10 @@ void IconTextLampPlugin::stop()
     String                      spriteSheetFullPath  = getFileName(FILE_EXT_SPRITE_SHEET);
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    /* Remove icon which is specific for the plugin instance. */
-    if (false != FILESYSTEM.remove(bitmapFullPath))
+    /* Remove icon which is specific for the plugin instance. It may be
+     * stored as native image.
+     */
+    if (false != NativeImg::remove(FILESYSTEM, bitmapFullPath))
     {
         LOG_INFO("File %s removed", bitmapFullPath.c_str());
     }
@@ -492,7 +453,7 @@ void IconTextLampPlugin::setText(const String& formatText)
     {
         m_textWidget.setFormatStr(formatText);
 
-        m_hasTopicTextChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 }
 
@@ -505,7 +466,7 @@ bool IconTextLampPlugin::loadBitmap(const String& filename)
     {
         m_iconPath = filename;
 
-        m_hasTopicTextChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 
     if (false == m_spriteSheetPath.isEmpty())
@@ -530,7 +491,7 @@ bool IconTextLampPlugin::loadSpriteSheet(const String& filename)
     {
         m_spriteSheetPath = filename;
 
-        m_hasTopicTextChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 
     if (false == m_iconPath.isEmpty())
@@ -550,7 +511,7 @@ void IconTextLampPlugin::clearBitmap()
         m_iconPath.clear();
         m_bitmapWidget.clear(ColorDef::BLACK);
 
-        m_hasTopicTextChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 }
 
@@ -562,7 +523,7 @@ void IconTextLampPlugin::clearSpriteSheet()
     {
         m_spriteSheetPath.clear();
 
-        m_hasTopicTextChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 
     if (false == m_iconPath.isEmpty())
@@ -609,8 +570,8 @@ void IconTextLampPlugin::setLamp(uint8_t lampId, bool state)
         {
             m_lampWidgets[lampId].setOnState(state);
 
-            m_hasTopicLampsChanged = true;
-            m_hasTopicLampChanged[lampId] = true;
+            notifyTopicChanged(TOPIC_LAMPS);
+            notifyTopicChanged(String(TOPIC_LAMP) + "/" + lampId);
         }
     }
 }
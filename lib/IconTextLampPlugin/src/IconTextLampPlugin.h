@@ -86,10 +86,7 @@ public:
         m_iconPath(),
         m_spriteSheetPath(),
         m_lampWidgets(),
-        m_mutex(),
-        m_hasTopicTextChanged(false),
-        m_hasTopicLampsChanged(false),
-        m_hasTopicLampChanged{false, false, false, false}
+        m_mutex()
     {
         (void)m_mutex.create();
     }
@@ -167,17 +164,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-
     /**
      * Is a upload request accepted or rejected?
      * 
@@ -353,9 +339,6 @@ private:
     String                  m_spriteSheetPath;                  /**< Full path to spritesheet. */
     LampWidget              m_lampWidgets[MAX_LAMPS];           /**< Lamp widgets, used to signal different things. */
     mutable MutexRecursive  m_mutex;                            /**< Mutex to protect against concurrent access. */
-    bool                    m_hasTopicTextChanged;              /**< Has the topic text content changed? */
-    bool                    m_hasTopicLampsChanged;             /**< Has the topic lamps content changed? */
-    bool                    m_hasTopicLampChanged[MAX_LAMPS];   /**< Has the topic lamp content changed? */
 
     /**
      * Get filename with path.
@@ -36,6 +36,7 @@
 #include "FileSystem.h"
 
 #include <Logging.h>
+#include <NativeImg.h>
 #include <ArduinoJson.h>
 
 /******************************************************************************
@@ -70,6 +71,9 @@ const char* IconTextPlugin::TOPIC_SPRITESHEET       = "/spritesheet";
 /* Initialize bitmap image filename extension. */
 const char* IconTextPlugin::FILE_EXT_BITMAP         = ".bmp";
 
+/* Initialize GIF image filename extension. */
+const char* IconTextPlugin::FILE_EXT_GIF            = ".gif";
+
 /* Initialize sprite sheet parameter filename extension. */
 const char* IconTextPlugin::FILE_EXT_SPRITE_SHEET   = ".sprite";
 
@@ -224,30 +228,17 @@ bool IconTextPlugin::setTopic(const String& topic, const JsonObjectConst& value)
     return isSuccessful;
 }
 
-bool IconTextPlugin::hasTopicChanged(const String& topic)
-{
-    bool hasTopicChanged = false;
-
-    if (0U != topic.equals(TOPIC_TEXT))
-    {
-        MutexGuard<MutexRecursive> guard(m_mutex);
-
-        hasTopicChanged = m_hasTopicChanged;
-
-        m_hasTopicChanged = false;
-    }
-
-    return hasTopicChanged;
-}
-
 bool IconTextPlugin::isUploadAccepted(const String& topic, const String& srcFilename, String& dstFilename)
 {
     bool isAccepted = false;
 
     if (0U != topic.equals(TOPIC_ICON))
     {
-        /* Accept upload of bitmap file. */
-        if (0U != srcFilename.endsWith(FILE_EXT_BITMAP))
+        /* Accept upload of bitmap or GIF file. The GIF image is stored as
+         * icon file too, because the image format is detected by content.
+         */
+        if ((0U != srcFilename.endsWith(FILE_EXT_BITMAP)) ||
+            (0U != srcFilename.endsWith(FILE_EXT_GIF)))
         {
             dstFilename = getFileName(FILE_EXT_BITMAP);
 
@@ -328,8 +319,10 @@ void IconTextPlugin::stop()
     String                      spriteSheetFullPath  = getFileName(FILE_EXT_SPRITE_SHEET);
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    /* Remove icon which is specific for the plugin instance. */
-    if (false != FILESYSTEM.remove(bitmapFullPath))
+    /* Remove icon which is specific for the plugin instance. It may be
+     * stored as native image.
+     */
+    if (false != NativeImg::remove(FILESYSTEM, bitmapFullPath))
     {
         LOG_INFO("File %s removed", bitmapFullPath.c_str());
     }
@@ -368,7 +361,7 @@ void IconTextPlugin::setText(const String& formatText)
     {
         m_textWidget.setFormatStr(formatText);
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 }
 
@@ -381,7 +374,7 @@ bool IconTextPlugin::loadBitmap(const String& filename)
     {
         m_iconPath = filename;
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 
     if (false == m_spriteSheetPath.isEmpty())
@@ -406,7 +399,7 @@ bool IconTextPlugin::loadSpriteSheet(const String& filename)
     {
         m_spriteSheetPath = filename;
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 
     if (false == m_iconPath.isEmpty())
@@ -426,7 +419,7 @@ void IconTextPlugin::clearBitmap()
         m_iconPath.clear();
         m_bitmapWidget.clear(ColorDef::BLACK);
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 }
 
@@ -438,7 +431,7 @@ void IconTextPlugin::clearSpriteSheet()
     {
         m_spriteSheetPath.clear();
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 
     if (false == m_iconPath.isEmpty())
@@ -84,8 +84,7 @@ public:
         m_iconPath(),
         m_spriteSheetPath(),
         m_isUploadError(false),
-        m_mutex(),
-        m_hasTopicChanged(false)
+        m_mutex()
     {
         (void)m_mutex.create();
     }
@@ -195,17 +194,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-
     /**
      * Is a upload request accepted or rejected?
      * 
@@ -335,6 +323,11 @@ private:
      */
     static const char*      FILE_EXT_BITMAP;
 
+    /**
+     * Filename extension of GIF image file.
+     */
+    static const char*      FILE_EXT_GIF;
+
     /**
      * Filename extension of sprite sheet parameter file.
      */
@@ -349,7 +342,6 @@ private:
     String                  m_spriteSheetPath;  /**< Full path to spritesheet. */
     bool                    m_isUploadError;    /**< Flag to signal a upload error. */
     mutable MutexRecursive  m_mutex;            /**< Mutex to protect against concurrent access. */
-    bool                    m_hasTopicChanged;  /**< Has the topic text content changed? */
 
     /**
      * Get filename with path.
@@ -133,19 +133,6 @@ bool JustTextPlugin::setTopic(const String& topic, const JsonObjectConst& value)
     return isSuccessful;
 }
 
-bool JustTextPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void JustTextPlugin::start(uint16_t width, uint16_t height)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
@@ -198,7 +185,7 @@ void JustTextPlugin::setText(const String& formatText)
     {
         m_textWidget.setFormatStr(formatText);
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_TEXT);
     }
 }
 
@@ -75,8 +75,7 @@ public:
         Plugin(name, uid),
         m_fontType(Fonts::FONT_TYPE_DEFAULT),
         m_textWidget(),
-        m_mutex(),
-        m_hasTopicChanged(false)
+        m_mutex()
     {
         (void)m_mutex.create();
     }
@@ -186,17 +185,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -249,7 +237,6 @@ private:
     Fonts::FontType         m_fontType;         /**< Font type which shall be used if there is no conflict with the layout. */
     TextWidget              m_textWidget;       /**< Text widget, used for showing the text. */
     mutable MutexRecursive  m_mutex;            /**< Mutex to protect against concurrent access. */
-    bool                    m_hasTopicChanged;  /**< Has the topic text content changed? */
 };
 
 /******************************************************************************
@@ -37,6 +37,10 @@
 #include <SettingsService.h>
 #include <Logging.h>
 #include <MqttService.h>
+#include <PersistenceService.h>
+#include <FileSystem.h>
+#include <JsonFile.h>
+#include <Util.h>
 #include <WiFi.h>
 
 /******************************************************************************
@@ -83,6 +87,15 @@ const char* HomeAssistantMqtt::NAME_HA_DISCOVERY_ENABLE     = "Enable Home Assis
 /* Initialize Home Assistant discovery enable flag default value */
 const bool  HomeAssistantMqtt::DEFAULT_HA_DISCOVERY_ENABLE  = false;
 
+/* Initialize full path of the published discovery information hashes file. */
+const char* HomeAssistantMqtt::HASHES_FILE_NAME             = "/haDiscovery.json";
+
+/* Initialize Home Assistant birth message topic. */
+const char* HomeAssistantMqtt::BIRTH_TOPIC                  = "/status";
+
+/* Initialize Home Assistant birth message payload. */
+const char* HomeAssistantMqtt::BIRTH_PAYLOAD_ONLINE         = "online";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -109,6 +122,35 @@ void HomeAssistantMqtt::start()
         m_haDiscoveryEnabled    = m_haDiscoveryEnabledSetting.getValue();
 
         settings.close();
+
+        if (true == m_haDiscoveryEnabled)
+        {
+            loadPublishedHashes();
+
+            /* Home Assistant announces with its birth message, that it is
+             * online again. It may have lost the retained discovery
+             * informations in the meantime.
+             */
+            if (false == m_haDiscoveryPrefix.isEmpty())
+            {
+                MqttService&                mqttService     = MqttService::getInstance();
+                MqttService::TopicCallback  birthCallback   =
+                    [this](const String& mqttTopic, const uint8_t* payload, size_t size)
+                    {
+                        UTIL_NOT_USED(mqttTopic);
+
+                        this->onBirthMessage(payload, size);
+                    };
+
+                m_birthTopic = m_haDiscoveryPrefix + BIRTH_TOPIC;
+
+                if (false == mqttService.subscribe(m_birthTopic, birthCallback))
+                {
+                    LOG_WARNING("Couldn't subscribe %s.", m_birthTopic.c_str());
+                    m_birthTopic.clear();
+                }
+            }
+        }
     }
 }
 
@@ -119,7 +161,22 @@ void HomeAssistantMqtt::stop()
     settings.unregisterSetting(&m_haDiscoveryPrefixSetting);
     settings.unregisterSetting(&m_haDiscoveryEnabledSetting);
 
+    if (false == m_birthTopic.isEmpty())
+    {
+        MqttService::getInstance().unsubscribe(m_birthTopic);
+        m_birthTopic.clear();
+    }
+
+    /* Losing pending hashes only results in publishing again, but try
+     * to keep them.
+     */
+    if (true == PersistenceService::getInstance().isWriteDue(HASHES_FILE_NAME))
+    {
+        savePublishedHashes();
+    }
+
     clearMqttDiscoveryInfoList();
+    m_publishedHashes.clear();
 }
 
 void HomeAssistantMqtt::process(bool isConnected)
@@ -130,15 +187,51 @@ void HomeAssistantMqtt::process(bool isConnected)
         if (true == isConnected)
         {
             /* Connection to broker re-estiablished?
-             * All automatic discovery info's need to be published again.
+             * All automatic discovery info's need to be checked again,
+             * but only new or changed ones will be published.
              */
             if (false == m_isConnected)
             {
+                String  localIp     = WiFi.localIP().toString();
+                String  brokerUrl   = MqttService::getInstance().getBrokerUrl();
+
+                /* The hashes are only valid for the broker, which retains
+                 * the published discovery informations.
+                 */
+                if (brokerUrl != m_brokerUrl)
+                {
+                    clearPublishedHashes();
+                    m_brokerUrl = brokerUrl;
+                }
+
+                /* The payload contains the local IP address. */
+                if (localIp != m_localIp)
+                {
+                    ListOfMqttDiscoveryInfo::iterator listOfMqttDiscoveryInfoIt = m_mqttDiscoveryInfoList.begin();
+
+                    while(m_mqttDiscoveryInfoList.end() != listOfMqttDiscoveryInfoIt)
+                    {
+                        if (nullptr != (*listOfMqttDiscoveryInfoIt))
+                        {
+                            (*listOfMqttDiscoveryInfoIt)->hash = 0U;
+                        }
+
+                        ++listOfMqttDiscoveryInfoIt;
+                    }
+
+                    m_localIp = localIp;
+                }
+
                 requestToPublishAllAutoDiscoveryInfos();
             }
 
             publishAutoDiscoveryInfosOnDemand();
         }
+
+        if (true == PersistenceService::getInstance().isWriteDue(HASHES_FILE_NAME))
+        {
+            savePublishedHashes();
+        }
     }
 
     m_isConnected = isConnected;
@@ -189,6 +282,12 @@ void HomeAssistantMqtt::registerMqttDiscovery(const String& deviceId, const Stri
                     }
 
                     m_mqttDiscoveryInfoList.push_back(mqttDiscoveryInfo);
+
+                    /* Publish initially, if not already retained by the broker. */
+                    if (true == m_isConnected)
+                    {
+                        requestToPublishAutoDiscoveryInfo(mqttDiscoveryInfo);
+                    }
                 }
             }
         }
@@ -263,8 +362,8 @@ void HomeAssistantMqtt::unregisterMqttDiscovery(const String& deviceId, const St
 
                 getConfigTopic(mqttTopic, mqttDiscoveryInfo->component, mqttDiscoveryInfo->nodeId, mqttDiscoveryInfo->objectId);
 
-                /* Purge discovery info. */
-                if (false == mqttService.publish(mqttTopic, ""))
+                /* Purge retained discovery info. */
+                if (false == mqttService.publish(mqttTopic, "", true))
                 {
                     LOG_WARNING("Failed to purge HA discovery info of %s.", mqttDiscoveryInfo->objectId.c_str());
                 }
@@ -273,6 +372,13 @@ void HomeAssistantMqtt::unregisterMqttDiscovery(const String& deviceId, const St
                     LOG_INFO("HA discovery info of %s purged.", mqttDiscoveryInfo->objectId.c_str());
                 }
 
+                /* Publish it again after a later registration. */
+                if (0U < m_publishedHashes.erase(calcHash(mqttTopic)))
+                {
+                    PersistenceService::getInstance().requestWrite(HASHES_FILE_NAME);
+                }
+
+                removePendingAutoDiscoveryInfo(mqttDiscoveryInfo);
                 listOfMqttDiscoveryInfoIt = m_mqttDiscoveryInfoList.erase(listOfMqttDiscoveryInfoIt);
 
                 delete mqttDiscoveryInfo;
@@ -305,6 +411,8 @@ void HomeAssistantMqtt::clearMqttDiscoveryInfoList()
 {
     ListOfMqttDiscoveryInfo::iterator listOfMqttDiscoveryInfoIt = m_mqttDiscoveryInfoList.begin();
 
+    m_pendingQueue.clear();
+
     while(m_mqttDiscoveryInfoList.end() != listOfMqttDiscoveryInfoIt)
     {
         MqttDiscoveryInfo* mqttDiscoveryInfo = *listOfMqttDiscoveryInfoIt;
@@ -331,17 +439,12 @@ void HomeAssistantMqtt::getConfigTopic(String& haConfigTopic, const String& comp
     haConfigTopic += "/config";
 }
 
-void HomeAssistantMqtt::publishAutoDiscoveryInfo(MqttDiscoveryInfo& mqttDiscoveryInfo)
+bool HomeAssistantMqtt::createAutoDiscoveryInfo(String& payload, const MqttDiscoveryInfo& mqttDiscoveryInfo)
 {
     const size_t            JSON_DOC_SIZE               = 1024U;
     DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
-    MqttService&            mqttService                 = MqttService::getInstance();
-    String                  mqttTopic;
-    String                  discoveryInfo;
     JsonObjectConstIterator discoveryDetailsIt          = mqttDiscoveryInfo.discoveryDetails.as<JsonObjectConst>().begin();
 
-    getConfigTopic(mqttTopic, mqttDiscoveryInfo.component, mqttDiscoveryInfo.nodeId, mqttDiscoveryInfo.objectId);
-
     /* The object id (object_id) is used to generate the entity id. */
     jsonDoc["obj_id"]               = mqttDiscoveryInfo.objectId;
     /* The unique id (unique_id) identifies the device and its entity. */
@@ -366,17 +469,18 @@ void HomeAssistantMqtt::publishAutoDiscoveryInfo(MqttDiscoveryInfo& mqttDiscover
         ++discoveryDetailsIt;
     }
 
-    /* Send the JSON as string. */
-    if (0U < serializeJson(jsonDoc, discoveryInfo))
+    payload.clear();
+
+    return (0U < serializeJson(jsonDoc, payload));
+}
+
+void HomeAssistantMqtt::requestToPublishAutoDiscoveryInfo(MqttDiscoveryInfo* mqttDiscoveryInfo)
+{
+    if ((nullptr != mqttDiscoveryInfo) &&
+        (false == mqttDiscoveryInfo->isReqToPublish))
     {
-        if (false == mqttService.publish(mqttTopic, discoveryInfo))
-        {
-            LOG_WARNING("Failed to provide HA discovery info of %s.", mqttDiscoveryInfo.objectId.c_str());
-        }
-        else
-        {
-            LOG_INFO("HA discovery info of %s published.", mqttDiscoveryInfo.objectId.c_str());
-        }
+        mqttDiscoveryInfo->isReqToPublish = true;
+        m_pendingQueue.push_back(mqttDiscoveryInfo);
     }
 }
 
@@ -386,40 +490,226 @@ void HomeAssistantMqtt::requestToPublishAllAutoDiscoveryInfos()
 
     while(m_mqttDiscoveryInfoList.end() != listOfMqttDiscoveryInfoIt)
     {
-        MqttDiscoveryInfo*  mqttDiscoveryInfo   = *listOfMqttDiscoveryInfoIt;
+        requestToPublishAutoDiscoveryInfo(*listOfMqttDiscoveryInfoIt);
 
-        if (nullptr != mqttDiscoveryInfo)
+        ++listOfMqttDiscoveryInfoIt;
+    }
+}
+
+void HomeAssistantMqtt::removePendingAutoDiscoveryInfo(const MqttDiscoveryInfo* mqttDiscoveryInfo)
+{
+    if ((nullptr != mqttDiscoveryInfo) &&
+        (true == mqttDiscoveryInfo->isReqToPublish))
+    {
+        PendingQueue::iterator it = m_pendingQueue.begin();
+
+        while(m_pendingQueue.end() != it)
         {
-            mqttDiscoveryInfo->isReqToPublish = true;
+            if (mqttDiscoveryInfo == *it)
+            {
+                it = m_pendingQueue.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
-
-        ++listOfMqttDiscoveryInfoIt;
     }
 }
 
 void HomeAssistantMqtt::publishAutoDiscoveryInfosOnDemand()
 {
-    ListOfMqttDiscoveryInfo::iterator listOfMqttDiscoveryInfoIt = m_mqttDiscoveryInfoList.begin();
+    uint32_t    checks      = 0U;
+    bool        isPublished = false;
 
-    while(m_mqttDiscoveryInfoList.end() != listOfMqttDiscoveryInfoIt)
+    /* Publish at most one discovery info per call cycle, but skip the
+     * unchanged ones in between.
+     */
+    while((false == m_pendingQueue.empty()) &&
+          (false == isPublished) &&
+          (MAX_CHECKS_PER_CYCLE > checks))
     {
-        MqttDiscoveryInfo*  mqttDiscoveryInfo   = *listOfMqttDiscoveryInfoIt;
+        MqttDiscoveryInfo* mqttDiscoveryInfo = m_pendingQueue.front();
+
+        m_pendingQueue.pop_front();
 
         if (nullptr != mqttDiscoveryInfo)
         {
-            if (true == mqttDiscoveryInfo->isReqToPublish)
+            String                          mqttTopic;
+            uint32_t                        topicHash   = 0U;
+            PublishedHashes::const_iterator hashIt;
+
+            mqttDiscoveryInfo->isReqToPublish = false;
+
+            getConfigTopic(mqttTopic, mqttDiscoveryInfo->component, mqttDiscoveryInfo->nodeId, mqttDiscoveryInfo->objectId);
+            topicHash   = calcHash(mqttTopic);
+            hashIt      = m_publishedHashes.find(topicHash);
+
+            /* The payload needs to be created only, if its hash is unknown
+             * or it differs from the retained one.
+             */
+            if ((0U == mqttDiscoveryInfo->hash) ||
+                (m_publishedHashes.end() == hashIt) ||
+                (hashIt->second != mqttDiscoveryInfo->hash))
             {
-                publishAutoDiscoveryInfo(*mqttDiscoveryInfo);
+                String payload;
+
+                if (true == createAutoDiscoveryInfo(payload, *mqttDiscoveryInfo))
+                {
+                    mqttDiscoveryInfo->hash = calcHash(payload);
+
+                    if ((m_publishedHashes.end() == hashIt) ||
+                        (hashIt->second != mqttDiscoveryInfo->hash))
+                    {
+                        MqttService& mqttService = MqttService::getInstance();
 
-                mqttDiscoveryInfo->isReqToPublish = false;
+                        if (false == mqttService.publish(mqttTopic, payload, true))
+                        {
+                            LOG_WARNING("Failed to provide HA discovery info of %s.", mqttDiscoveryInfo->objectId.c_str());
+                        }
+                        else
+                        {
+                            LOG_INFO("HA discovery info of %s published.", mqttDiscoveryInfo->objectId.c_str());
 
-                /* Continue with next call cycle. */
-                break;
+                            m_publishedHashes[topicHash] = mqttDiscoveryInfo->hash;
+                            PersistenceService::getInstance().requestWrite(HASHES_FILE_NAME);
+                        }
+
+                        isPublished = true;
+                    }
+                }
             }
         }
 
-        ++listOfMqttDiscoveryInfoIt;
+        ++checks;
+    }
+}
+
+void HomeAssistantMqtt::onBirthMessage(const uint8_t* payload, size_t size)
+{
+    const size_t    ONLINE_LEN  = strlen(BIRTH_PAYLOAD_ONLINE);
+
+    if ((nullptr != payload) &&
+        (ONLINE_LEN == size) &&
+        (0 == memcmp(payload, BIRTH_PAYLOAD_ONLINE, ONLINE_LEN)))
+    {
+        LOG_INFO("Home Assistant is online, provide HA discovery infos again.");
+
+        clearPublishedHashes();
+
+        if (true == m_isConnected)
+        {
+            requestToPublishAllAutoDiscoveryInfos();
+        }
+    }
+}
+
+void HomeAssistantMqtt::clearPublishedHashes()
+{
+    if (false == m_publishedHashes.empty())
+    {
+        m_publishedHashes.clear();
+        PersistenceService::getInstance().requestWrite(HASHES_FILE_NAME);
+    }
+}
+
+void HomeAssistantMqtt::loadPublishedHashes()
+{
+    const size_t        JSON_DOC_SIZE   = 8192U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonFile            jsonFile(FILESYSTEM);
+
+    m_publishedHashes.clear();
+    m_brokerUrl.clear();
+
+    if (true == jsonFile.load(HASHES_FILE_NAME, jsonDoc))
+    {
+        JsonArrayConst      jsonHashes  = jsonDoc["hashes"];
+        JsonVariantConst    jsonBroker  = jsonDoc["broker"];
+
+        /* Hashes without broker are dropped at the first connection. */
+        if (true == jsonBroker.is<String>())
+        {
+            m_brokerUrl = jsonBroker.as<String>();
+        }
+
+        for(JsonVariantConst jsonHash : jsonHashes)
+        {
+            JsonVariantConst jsonTopicHash      = jsonHash[0];
+            JsonVariantConst jsonPayloadHash    = jsonHash[1];
+
+            if ((true == jsonTopicHash.is<uint32_t>()) &&
+                (true == jsonPayloadHash.is<uint32_t>()))
+            {
+                m_publishedHashes[jsonTopicHash.as<uint32_t>()] = jsonPayloadHash.as<uint32_t>();
+            }
+        }
+
+        LOG_INFO("HA discovery hashes loaded: %u", m_publishedHashes.size());
+    }
+}
+
+void HomeAssistantMqtt::savePublishedHashes()
+{
+    const size_t                    JSON_DOC_SIZE   = JSON_OBJECT_SIZE(2U) + JSON_ARRAY_SIZE(m_publishedHashes.size()) + (m_publishedHashes.size() * JSON_ARRAY_SIZE(2U));
+    DynamicJsonDocument             jsonDoc(JSON_DOC_SIZE);
+    JsonArray                       jsonHashes      = jsonDoc.createNestedArray("hashes");
+    JsonFile                        jsonFile(FILESYSTEM);
+    PublishedHashes::const_iterator it              = m_publishedHashes.begin();
+    bool                            isSuccessful    = true;
+
+    while(m_publishedHashes.end() != it)
+    {
+        JsonArray jsonHash = jsonHashes.createNestedArray();
+
+        (void)jsonHash.add(it->first);
+        (void)jsonHash.add(it->second);
+
+        ++it;
+    }
+
+    /* The URL is stored by pointer, no copy needed. */
+    jsonDoc["broker"] = m_brokerUrl.c_str();
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("Less memory for HA discovery hashes.");
+        isSuccessful = false;
+    }
+    else if (false == jsonFile.save(HASHES_FILE_NAME, jsonDoc))
+    {
+        LOG_ERROR("Couldn't save HA discovery hashes.");
+        isSuccessful = false;
+    }
+    else
+    {
+        ;
+    }
+
+    PersistenceService::getInstance().reportWrite(HASHES_FILE_NAME, isSuccessful);
+}
+
+uint32_t HomeAssistantMqtt::calcHash(const String& str)
+{
+    const uint32_t  FNV_OFFSET_BASIS    = 2166136261U;
+    const uint32_t  FNV_PRIME           = 16777619U;
+    uint32_t        hash                = FNV_OFFSET_BASIS;
+    const char*     data                = str.c_str();
+
+    while('\0' != *data)
+    {
+        hash ^= static_cast<uint8_t>(*data);
+        hash *= FNV_PRIME;
+        ++data;
     }
+
+    /* 0 is reserved for "not calculated". */
+    if (0U == hash)
+    {
+        hash = 1U;
+    }
+
+    return hash;
 }
 
 /******************************************************************************
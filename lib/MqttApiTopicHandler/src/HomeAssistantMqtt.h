@@ -48,6 +48,8 @@
 #include <KeyValueBool.h>
 #include <ArduinoJson.h>
 #include <vector>
+#include <deque>
+#include <unordered_map>
 
 /******************************************************************************
  * Macros
@@ -60,6 +62,12 @@
 /**
  * Home Assistant MQTT extension, which supports the MQTT discovery.
  * https://www.home-assistant.io/integrations/mqtt/
+ *
+ * The discovery informations are published retained. A hash of every
+ * published discovery information is persisted, so after a reconnect or
+ * restart only new or changed discovery informations are published again.
+ * The hashes are dropped, if the broker changes or Home Assistant sends its
+ * birth message, because the retained discovery informations may be lost.
  */
 class HomeAssistantMqtt
 {
@@ -73,6 +81,12 @@ public:
         m_haDiscoveryEnabledSetting(KEY_HA_DISCOVERY_ENABLE, NAME_HA_DISCOVERY_ENABLE, DEFAULT_HA_DISCOVERY_ENABLE),
         m_haDiscoveryPrefix(),
         m_haDiscoveryEnabled(false),
+        m_mqttDiscoveryInfoList(),
+        m_pendingQueue(),
+        m_publishedHashes(),
+        m_brokerUrl(),
+        m_birthTopic(),
+        m_localIp(),
         m_isConnected(false)
     {
     }
@@ -152,6 +166,21 @@ private:
     /** Home Assistant discovery enable flag default value */
     static const bool   DEFAULT_HA_DISCOVERY_ENABLE;
 
+    /** Full path of the file, which contains the hashes of the published discovery informations. */
+    static const char*  HASHES_FILE_NAME;
+
+    /** Home Assistant birth message topic, which is appended to the discovery prefix. */
+    static const char*  BIRTH_TOPIC;
+
+    /** Home Assistant birth message payload */
+    static const char*  BIRTH_PAYLOAD_ONLINE;
+
+    /**
+     * Max. number of pending discovery informations, which are checked per
+     * process cycle. Unchanged ones are skipped without publishing.
+     */
+    static const uint32_t   MAX_CHECKS_PER_CYCLE    = 16U;
+
     /** Information necessary for Home Assistant MQTT discovery. */
     struct MqttDiscoveryInfo
     {
@@ -159,7 +188,8 @@ private:
         String              nodeId;             /**< Home Assistant node id */
         String              objectId;           /**< Home Assistant object id */
         DynamicJsonDocument discoveryDetails;   /**< Additional discovery information. */
-        bool                isReqToPublish;     /**< Is requested to publish this discovery info? */
+        bool                isReqToPublish;     /**< Is requested to publish this discovery info? If true, it is in the pending queue. */
+        uint32_t            hash;               /**< Hash of the discovery information payload. 0 if not calculated yet. */
 
         /** Construct Home Assistant MQTT discovery information. */
         MqttDiscoveryInfo() :
@@ -167,7 +197,8 @@ private:
             nodeId(),
             objectId(),
             discoveryDetails(368U),
-            isReqToPublish(true)
+            isReqToPublish(false),
+            hash(0U)
         {
         }
     };
@@ -175,11 +206,22 @@ private:
     /** List of Home Assistant MQTT discovery information. */
     typedef std::vector<MqttDiscoveryInfo*> ListOfMqttDiscoveryInfo;
 
+    /** Queue of Home Assistant MQTT discovery information, which is pending to be published. */
+    typedef std::deque<MqttDiscoveryInfo*> PendingQueue;
+
+    /** Payload hash of published discovery information by the hash of its config topic. */
+    typedef std::unordered_map<uint32_t, uint32_t> PublishedHashes;
+
     KeyValueString          m_haDiscoveryPrefixSetting;     /**< Setting for the Home Assistant MQTT discovery prefix. */
     KeyValueBool            m_haDiscoveryEnabledSetting;    /**< Setting for the Home Assistant MQTT discovery enable flag. */
     String                  m_haDiscoveryPrefix;            /**< Home Assistant MQTT discovery prefix. */
     bool                    m_haDiscoveryEnabled;           /**< Is the Home Assistant MQTT discovery enabled or not. */
     ListOfMqttDiscoveryInfo m_mqttDiscoveryInfoList;        /**< List of Home Assistant MQTT discovery informations. */
+    PendingQueue            m_pendingQueue;                 /**< Discovery informations in the order they requested to be published. */
+    PublishedHashes         m_publishedHashes;              /**< Hashes of the discovery informations, which are retained by the broker. */
+    String                  m_brokerUrl;                    /**< URL of the MQTT broker, which the published hashes belong to. */
+    String                  m_birthTopic;                   /**< Subscribed Home Assistant birth message topic, empty if not subscribed. */
+    String                  m_localIp;                      /**< Local IP address, which the payload hashes are based on. */
     bool                    m_isConnected;                  /**< Is MQTT broker connection established? */
 
     HomeAssistantMqtt(const HomeAssistantMqtt& ext);
@@ -210,22 +252,80 @@ private:
     void getConfigTopic(String& haConfigTopic, const String& component, const String& nodeId, const String& objectId);
 
     /**
-     * Publish the MQTT auto discovery information.
+     * Create the MQTT auto discovery information payload.
+     * 
+     * @param[out]  payload             Discovery information payload
+     * @param[in]   mqttDiscoveryInfo   Discovery information
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool createAutoDiscoveryInfo(String& payload, const MqttDiscoveryInfo& mqttDiscoveryInfo);
+
+    /**
+     * Request to publish the automatic discovery info. If already requested,
+     * nothing happens.
+     * 
+     * @param[in] mqttDiscoveryInfo Discovery information
      */
-    void publishAutoDiscoveryInfo(MqttDiscoveryInfo& mqttDiscoveryInfo);
+    void requestToPublishAutoDiscoveryInfo(MqttDiscoveryInfo* mqttDiscoveryInfo);
 
     /**
      * Request to publish all automatic discovery info's.
      */
     void requestToPublishAllAutoDiscoveryInfos();
 
+    /**
+     * Remove the automatic discovery info from the pending queue.
+     * 
+     * @param[in] mqttDiscoveryInfo Discovery information
+     */
+    void removePendingAutoDiscoveryInfo(const MqttDiscoveryInfo* mqttDiscoveryInfo);
+
     /**
      * Publish MQTT auto discovery informations, which are requested.
+     * Discovery informations, which are already retained by the broker
+     * with the same content, are skipped.
      * 
      * Note: Need to be called continously and will only publish one info per
      *       call cycle.
      */
     void publishAutoDiscoveryInfosOnDemand();
+
+    /**
+     * Handle the Home Assistant birth message. If Home Assistant comes
+     * online, all discovery informations are published again.
+     * 
+     * @param[in] payload   Message payload
+     * @param[in] size      Message payload size in byte
+     */
+    void onBirthMessage(const uint8_t* payload, size_t size);
+
+    /**
+     * Forget all published discovery informations, so they will be
+     * published again.
+     */
+    void clearPublishedHashes();
+
+    /**
+     * Load the hashes of the published discovery informations from the
+     * filesystem.
+     */
+    void loadPublishedHashes();
+
+    /**
+     * Save the hashes of the published discovery informations to the
+     * filesystem.
+     */
+    void savePublishedHashes();
+
+    /**
+     * Calculate the hash (FNV-1a) of a string.
+     * 
+     * @param[in] str   String
+     * 
+     * @return Hash, which is never 0.
+     */
+    static uint32_t calcHash(const String& str);
 };
 
 /******************************************************************************
@@ -109,7 +109,7 @@ void MqttApiTopicHandler::registerTopic(const String& deviceId, const String& en
                 topicUriReadable = mqttTopicNameBase + MQTT_ENDPOINT_READ_ACCESS;
 
                 /* Publish initially. */
-                topicState->isPublishReq = true;
+                requestToPublishTopicState(topicState);
             }
 
             /* Is the topic writeable? */
@@ -197,6 +197,7 @@ void MqttApiTopicHandler::unregisterTopic(const String& deviceId, const String&
                 /* Handle Home Assistant extension */
                 m_haExtension.unregisterMqttDiscovery(deviceId, entityId, topicUriReadable, topicUriWriteable);
 
+                removePendingPublish(topicState);
                 topicStateIt = m_listOfTopicStates.erase(topicStateIt);
 
                 delete topicState;
@@ -222,7 +223,11 @@ void MqttApiTopicHandler::process()
 
     {
         m_isMqttConnected = true;
-        
+
+        /* Start with a full publish budget. */
+        m_publishBudget             = CONFIG_MQTT_API_PUBLISH_BYTES_PER_SEC;
+        m_publishBudgetTimestamp    = millis();
+
         /* Publish after connection establishment. */
         requestToPublishAllTopicStates();
     }
@@ -238,13 +243,15 @@ void MqttApiTopicHandler::process()
 
     if (true == m_isMqttConnected)
     {
-        /* If necessary, a topic state will be published.
+        /* If necessary, topic states will be published.
          *
-         * Don't publish all of them at once, only one per process cycle.
-         * This has the advantage to detect lost MQTT connection, because remember
-         * its cooperative! As long as the MQTT service is not called, no update
-         * about the connection status will appear.
+         * Don't publish all of them at once, only a limited number per process
+         * cycle and only within the publish budget. This has the advantage to
+         * detect lost MQTT connection, because remember its cooperative! As long
+         * as the MQTT service is not called, no update about the connection
+         * status will appear.
          */
+        refillPublishBudget();
         publishTopicStatesOnDemand();
     }
 
@@ -269,7 +276,7 @@ void MqttApiTopicHandler::notify(const String& deviceId, const String& entityId,
                 (entityId == topicState->entityId) &&
                 (topic == topicState->topic))
             {
-                topicState->isPublishReq = true;
+                requestToPublishTopicState(topicState);
             }
 
             ++topicStateIt;
@@ -285,52 +292,113 @@ void MqttApiTopicHandler::notify(const String& deviceId, const String& entityId,
  * Private Methods
  *****************************************************************************/
 
+void MqttApiTopicHandler::requestToPublishTopicState(TopicState* topicState)
+{
+    if ((nullptr != topicState) &&
+        (false == topicState->deviceId.isEmpty()) &&
+        (false == topicState->entityId.isEmpty()) &&
+        (nullptr != topicState->getTopicFunc))
+    {
+        /* If already pending, the topic content is retrieved at the time
+         * of publishing. Therefore several changes are coalesced.
+         */
+        if (false == topicState->isPublishReq)
+        {
+            topicState->isPublishReq = true;
+            m_pendingPublishQueue.push_back(topicState);
+        }
+    }
+}
+
 void MqttApiTopicHandler::requestToPublishAllTopicStates()
 {
     ListOfTopicStates::iterator topicStateIt = m_listOfTopicStates.begin();
 
-    /* Set the publish request flag for all topic states. */
+    /* Request all topic states in the order they were registered. */
     while(m_listOfTopicStates.end() != topicStateIt)
     {
-        TopicState* topicState = *topicStateIt;
+        requestToPublishTopicState(*topicStateIt);
+
+        ++topicStateIt;
+    }
+}
 
-        if ((nullptr != topicState) &&
-            (false == topicState->deviceId.isEmpty()) &&
-            (false == topicState->entityId.isEmpty()) &&
-            (nullptr != topicState->getTopicFunc))
+void MqttApiTopicHandler::removePendingPublish(const TopicState* topicState)
+{
+    if ((nullptr != topicState) &&
+        (true == topicState->isPublishReq))
+    {
+        PendingPublishQueue::iterator it = m_pendingPublishQueue.begin();
+
+        while(m_pendingPublishQueue.end() != it)
         {
-            topicState->isPublishReq = true;
+            if (topicState == *it)
+            {
+                it = m_pendingPublishQueue.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
+    }
+}
 
-        ++topicStateIt;
+void MqttApiTopicHandler::refillPublishBudget()
+{
+    const int32_t   MAX_BUDGET  = static_cast<int32_t>(CONFIG_MQTT_API_PUBLISH_BYTES_PER_SEC);
+    uint32_t        timestamp   = millis();
+    uint32_t        elapsed     = timestamp - m_publishBudgetTimestamp;
+    uint64_t        refill      = (static_cast<uint64_t>(elapsed) * CONFIG_MQTT_API_PUBLISH_BYTES_PER_SEC) / 1000U;
+
+    /* Keep the timestamp until at least one byte is refilled, otherwise
+     * short process cycles would never refill anything.
+     */
+    if (0U < refill)
+    {
+        m_publishBudgetTimestamp = timestamp;
+
+        if (static_cast<uint64_t>(MAX_BUDGET - m_publishBudget) <= refill)
+        {
+            m_publishBudget = MAX_BUDGET;
+        }
+        else
+        {
+            m_publishBudget += static_cast<int32_t>(refill);
+        }
     }
 }
 
 void MqttApiTopicHandler::publishTopicStatesOnDemand()
 {
-    ListOfTopicStates::iterator topicStateIt = m_listOfTopicStates.begin();
+    uint32_t count = 0U;
 
-    while(m_listOfTopicStates.end() != topicStateIt)
+    while((false == m_pendingPublishQueue.empty()) &&
+          (CONFIG_MQTT_API_PUBLISH_MSG_PER_CYCLE > count) &&
+          (0 < m_publishBudget))
     {
-        TopicState* topicState = *topicStateIt;
+        TopicState* topicState = m_pendingPublishQueue.front();
+
+        m_pendingPublishQueue.pop_front();
 
-        if ((nullptr != topicState) &&
-            (false == topicState->deviceId.isEmpty()) &&
-            (false == topicState->entityId.isEmpty()) &&
-            (nullptr != topicState->getTopicFunc))
+        if (nullptr != topicState)
         {
-            if (true == topicState->isPublishReq)
-            {
-                publish(topicState->deviceId, topicState->entityId, topicState->topic, topicState->getTopicFunc);
+            size_t publishedBytes = 0U;
 
-                topicState->isPublishReq = false;
+            /* Clear the request before publishing, so a change notified
+             * during publishing will be queued again.
+             */
+            topicState->isPublishReq = false;
 
-                /* Continue next process cycle. */
-                break;
-            }
+            publishedBytes = publish(topicState->deviceId, topicState->entityId, topicState->topic, topicState->getTopicFunc);
+
+            /* A big message may lead to a negative budget, which delays
+             * the following messages accordingly.
+             */
+            m_publishBudget -= static_cast<int32_t>(publishedBytes);
         }
 
-        ++topicStateIt;
+        ++count;
     }
 }
 
@@ -424,8 +492,10 @@ void MqttApiTopicHandler::write(const String& deviceId, const String& entityId,
     }
 }
 
-void MqttApiTopicHandler::publish(const String& deviceId, const String& entityId, const String& topic, GetTopicFunc getTopicFunc)
+size_t MqttApiTopicHandler::publish(const String& deviceId, const String& entityId, const String& topic, GetTopicFunc getTopicFunc)
 {
+    size_t publishedBytes = 0U;
+
     if (nullptr != getTopicFunc)
     {
         const size_t        JSON_DOC_SIZE       = 1024U;
@@ -449,10 +519,14 @@ void MqttApiTopicHandler::publish(const String& deviceId, const String& entityId
                 else
                 {
                     LOG_INFO("Published: %s", topicStateUri.c_str());
+
+                    publishedBytes = topicStateUri.length() + topicContent.length();
                 }
             }
         }
     }
+
+    return publishedBytes;
 }
 
 void MqttApiTopicHandler::clearTopicStates()
@@ -460,6 +534,8 @@ void MqttApiTopicHandler::clearTopicStates()
     MqttService&                mqttService     = MqttService::getInstance();
     ListOfTopicStates::iterator topicStateIt    = m_listOfTopicStates.begin();
 
+    m_pendingPublishQueue.clear();
+
     while(m_listOfTopicStates.end() != topicStateIt)
     {
         TopicState* topicState = *topicStateIt;
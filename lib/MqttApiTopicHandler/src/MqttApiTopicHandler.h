@@ -40,12 +40,32 @@
  * Compile Switches
  *****************************************************************************/
 
+#ifndef CONFIG_MQTT_API_PUBLISH_MSG_PER_CYCLE
+
+/**
+ * Max. number of topic states, which are published per process cycle.
+ */
+#define CONFIG_MQTT_API_PUBLISH_MSG_PER_CYCLE   (4U)
+
+#endif  /* CONFIG_MQTT_API_PUBLISH_MSG_PER_CYCLE */
+
+#ifndef CONFIG_MQTT_API_PUBLISH_BYTES_PER_SEC
+
+/**
+ * Max. number of bytes (topic and payload) per second, which are published
+ * in average. Up to one second of unused budget can be spent at once.
+ */
+#define CONFIG_MQTT_API_PUBLISH_BYTES_PER_SEC   (8192U)
+
+#endif  /* CONFIG_MQTT_API_PUBLISH_BYTES_PER_SEC */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <ITopicHandler.h>
 #include <vector>
+#include <deque>
 
 #include "HomeAssistantMqtt.h"
 
@@ -70,6 +90,9 @@ public:
     MqttApiTopicHandler() :
         ITopicHandler(),
         m_listOfTopicStates(),
+        m_pendingPublishQueue(),
+        m_publishBudget(0),
+        m_publishBudgetTimestamp(0U),
         m_isMqttConnected(false),
         m_haExtension()
     {
@@ -140,7 +163,7 @@ private:
         GetTopicFunc    getTopicFunc;   /**< Function used to get topic content. */
         SetTopicFunc    setTopicFunc;   /**< Function used to set topic content. */
         UploadReqFunc   uploadReqFunc;  /**< Function used to check whether a file upload is allowed. */
-        bool            isPublishReq;   /**< Is it required to publish the state? */
+        bool            isPublishReq;   /**< Is it required to publish the state? If true, it is in the pending publish queue. */
 
         /** Construct topic state. */
         TopicState() :
@@ -158,6 +181,9 @@ private:
     /** List of topic states. */
     typedef std::vector<TopicState*> ListOfTopicStates;
 
+    /** Queue of topic states, which are pending to be published. */
+    typedef std::deque<TopicState*> PendingPublishQueue;
+
     /**
      * Max. file size in byte.
      */
@@ -169,23 +195,48 @@ private:
     /** MQTT path endpoint for write access. */
     static const char*  MQTT_ENDPOINT_WRITE_ACCESS;
 
-    ListOfTopicStates   m_listOfTopicStates;    /**< List of registered topic states. */
-    bool                m_isMqttConnected;      /**< Is the MQTT connection to the broker established? */
-    HomeAssistantMqtt   m_haExtension;          /**< Home Assistant extension */
+    ListOfTopicStates   m_listOfTopicStates;        /**< List of registered topic states. */
+    PendingPublishQueue m_pendingPublishQueue;      /**< Topic states in the order they requested to be published. */
+    int32_t             m_publishBudget;            /**< Remaining publish budget in byte, may become negative by a big message. */
+    uint32_t            m_publishBudgetTimestamp;   /**< Timestamp in ms of the last publish budget refill. */
+    bool                m_isMqttConnected;          /**< Is the MQTT connection to the broker established? */
+    HomeAssistantMqtt   m_haExtension;              /**< Home Assistant extension */
 
     MqttApiTopicHandler(const MqttApiTopicHandler& adapter);
     MqttApiTopicHandler& operator=(const MqttApiTopicHandler& adapter);
 
+    /**
+     * Request to publish the topic state. If the topic state is already
+     * pending, the requests are coalesced and it will be published only once
+     * with its latest content.
+     * 
+     * @param[in] topicState    The topic state which to publish.
+     */
+    void requestToPublishTopicState(TopicState* topicState);
+
     /**
      * Request to publish all topic states.
      */
     void requestToPublishAllTopicStates();
 
     /**
-     * Publish topic states, which are requested.
+     * Remove the topic state from the pending publish queue.
      * 
-     * Note: Need to be called continously and will only publish one info per
-     *       call cycle.
+     * @param[in] topicState    The topic state which to remove.
+     */
+    void removePendingPublish(const TopicState* topicState);
+
+    /**
+     * Refill the publish budget according to the elapsed time.
+     */
+    void refillPublishBudget();
+
+    /**
+     * Publish pending topic states in the order they were requested.
+     * 
+     * Note: Need to be called continously. Per call cycle it will publish
+     *       at most CONFIG_MQTT_API_PUBLISH_MSG_PER_CYCLE topic states and
+     *       only as long as publish budget is available.
      */
     void publishTopicStatesOnDemand();
 
@@ -209,8 +260,10 @@ private:
      * @param[in] entityId      The entity id which represents the entity of the device.
      * @param[in] topic         The topic name.
      * @param[in] getTopicFunc  Function to get the topic content.
+     * 
+     * @return Number of published bytes (topic and payload). If nothing was published, it will return 0.
      */
-    void publish(const String& deviceId, const String& entityId, const String& topic, GetTopicFunc getTopicFunc);
+    size_t publish(const String& deviceId, const String& entityId, const String& topic, GetTopicFunc getTopicFunc);
 
     /**
      * Clear all topic states.
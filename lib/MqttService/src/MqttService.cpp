@@ -158,14 +158,19 @@ MqttService::State MqttService::getState() const
     return m_state;
 }
 
-bool MqttService::publish(const String& topic, const String& msg)
+const String& MqttService::getBrokerUrl() const
 {
-    return publish(topic.c_str(), msg.c_str());
+    return m_url;
 }
 
-bool MqttService::publish(const char* topic, const char* msg)
+bool MqttService::publish(const String& topic, const String& msg, bool retained)
 {
-    return m_mqttClient.publish(topic, msg);
+    return publish(topic.c_str(), msg.c_str(), retained);
+}
+
+bool MqttService::publish(const char* topic, const char* msg, bool retained)
+{
+    return m_mqttClient.publish(topic, msg, retained);
 }
 
 bool MqttService::subscribe(const String& topic, TopicCallback callback)
@@ -177,57 +182,27 @@ bool MqttService::subscribe(const char* topic, TopicCallback callback)
 {
     bool isSuccessful = false;
 
-    if (nullptr != topic)
+    if (false == SubscriberTrie::isFilterValid(topic))
     {
-        SubscriberList::const_iterator it;
-
-        /* Register a topic only once! */
-        for(it = m_subscriberList.begin(); it != m_subscriberList.end(); ++it)
+        LOG_WARNING("Invalid MQTT topic filter.");
+    }
+    /* Register a topic only once! */
+    else if (nullptr == m_subscribers.find(topic))
+    {
+        if ((true == m_mqttClient.connected()) &&
+            (false == m_mqttClient.subscribe(topic)))
         {
-            if (nullptr != (*it))
-            {
-                if (0 == strcmp((*it)->topic.c_str(), topic))
-                {
-                    break;
-                }
-            }
+            LOG_WARNING("MQTT topic subscription not possible: %s", topic);
         }
-
-        if (it == m_subscriberList.end())
+        else
         {
-            Subscriber* subscriber = new(std::nothrow) Subscriber;
-
-            if (nullptr != subscriber)
-            {
-                subscriber->topic       = topic;
-                subscriber->callback    = callback;
-
-                if (false == m_mqttClient.connected())
-                {
-                    m_subscriberList.push_back(subscriber);
-                    isSuccessful = true;
-                }
-                else
-                {
-                    if (false == m_mqttClient.subscribe(topic))
-                    {
-                        LOG_WARNING("MQTT topic subscription not possible: %s", topic);
-                    }
-                    else
-                    {
-                        m_subscriberList.push_back(subscriber);
-                        isSuccessful = true;
-                    }
-                }
-
-                if (false == isSuccessful)
-                {
-                    delete subscriber;
-                    subscriber = nullptr;
-                }
-            }
+            isSuccessful = m_subscribers.insert(topic, callback);
         }
     }
+    else
+    {
+        ;
+    }
 
     return isSuccessful;
 }
@@ -239,29 +214,9 @@ void MqttService::unsubscribe(const String& topic)
 
 void MqttService::unsubscribe(const char* topic)
 {
-    if (nullptr != topic)
+    if (true == m_subscribers.remove(topic))
     {
-        SubscriberList::iterator it = m_subscriberList.begin();
-
-        while(m_subscriberList.end() != it)
-        {
-            if (nullptr != (*it))
-            {
-                if (0 == strcmp((*it)->topic.c_str(), topic))
-                {
-                    Subscriber* subscriber = *it;
-
-                    m_mqttClient.unsubscribe(subscriber->topic.c_str());
-
-                    (void)m_subscriberList.erase(it);
-                    delete subscriber;
-
-                    break;
-                }
-            }
-
-            ++it;
-        }
+        (void)m_mqttClient.unsubscribe(topic);
     }
 }
 
@@ -349,6 +304,10 @@ void MqttService::connectedState()
         /* Try to reconnect later. */
         m_reconnectTimer.restart();
     }
+    else
+    {
+        processResubscription();
+    }
 }
 
 void MqttService::idleState()
@@ -358,38 +317,57 @@ void MqttService::idleState()
 
 void MqttService::rxCallback(char* topic, uint8_t* payload, uint32_t length)
 {
-    SubscriberList::const_iterator it;
+    std::vector<TopicCallback>                  callbacks;
+    std::vector<TopicCallback>::const_iterator  it;
+    String                                      topicStr(topic);
+
+    /* Collect the callbacks first, because a callback may subscribe or
+     * unsubscribe, which modifies the trie.
+     */
+    (void)m_subscribers.match(topic, [&callbacks](TopicCallback& callback) {
+        callbacks.push_back(callback);
+    });
 
-    for(it = m_subscriberList.begin(); it != m_subscriberList.end(); ++it)
+    for(it = callbacks.begin(); it != callbacks.end(); ++it)
     {
         if (nullptr != (*it))
         {
-            if (0 == strcmp((*it)->topic.c_str(), topic))
-            {
-                Subscriber* subscriber = *it;
-
-                subscriber->callback(topic, payload, length);
-                break;
-            }
+            (*it)(topicStr, payload, length);
         }
     }
 }
 
 void MqttService::resubscribe()
 {
-    SubscriberList::const_iterator it;
+    TopicList& resubscribeList = m_resubscribeList;
+
+    m_resubscribeList.clear();
+    m_subscribers.forEachTopic([&resubscribeList](const String& topic, TopicCallback& callback) {
+        (void)callback;
+        resubscribeList.push_back(topic);
+    });
+}
+
+void MqttService::processResubscription()
+{
+    size_t count = 0U;
 
-    for(it = m_subscriberList.begin(); it != m_subscriberList.end(); ++it)
+    while((false == m_resubscribeList.empty()) && (RESUBSCRIBE_BATCH_SIZE > count))
     {
-        if (nullptr != (*it))
-        {
-            Subscriber* subscriber = *it;
+        const String& topic = m_resubscribeList.back();
 
-            if (false == m_mqttClient.subscribe(subscriber->topic.c_str()))
+        /* Skip topics, which were unsubscribed in the meantime. */
+        if (nullptr != m_subscribers.find(topic.c_str()))
+        {
+            if (false == m_mqttClient.subscribe(topic.c_str()))
             {
-                LOG_WARNING("MQTT topic subscription not possible: %s", subscriber->topic.c_str());
+                LOG_WARNING("MQTT topic subscription not possible: %s", topic.c_str());
             }
+
+            ++count;
         }
+
+        m_resubscribeList.pop_back();
     }
 }
 
@@ -47,6 +47,7 @@
 #include <functional>
 #include <vector>
 #include <SimpleTimer.hpp>
+#include <TopicTrie.hpp>
 
 /******************************************************************************
  * Compiler Switches
@@ -116,25 +117,34 @@ public:
      */
     State getState() const;
 
+    /**
+     * Get the URL of the MQTT broker, without protocol and credentials.
+     * 
+     * @return MQTT broker URL
+     */
+    const String& getBrokerUrl() const;
+
     /**
      * Publish a message for a topic.
      * 
-     * @param[in] topic Message topic
-     * @param[in] msg   Message itself
+     * @param[in] topic     Message topic
+     * @param[in] msg       Message itself
+     * @param[in] retained  Shall the broker retain the message?
      * 
      * @return If successful published, it will return true otherwise false.
      */
-    bool publish(const String& topic, const String& msg);
+    bool publish(const String& topic, const String& msg, bool retained = false);
 
     /**
      * Publish a message for a topic.
      * 
-     * @param[in] topic Message topic
-     * @param[in] msg   Message itself
+     * @param[in] topic     Message topic
+     * @param[in] msg       Message itself
+     * @param[in] retained  Shall the broker retain the message?
      * 
      * @return If successful published, it will return true otherwise false.
      */
-    bool publish(const char* topic, const char* msg);
+    bool publish(const char* topic, const char* msg, bool retained = false);
 
     /**
      * Subscribe for a topic. The callback will be called every time a message
@@ -151,6 +161,10 @@ public:
      * Subscribe for a topic. The callback will be called every time a message
      * is received for the topic.
      * 
+     * The topic may be a topic filter with the wildcards '+' (single level)
+     * and '#' (multi level). A received message is dispatched to every
+     * subscriber, whose topic filter matches.
+     * 
      * @param[in] topic     The topic which to subscribe for.
      * @param[in] callback  The callback which to call for any received topic message.
      * 
@@ -175,18 +189,14 @@ public:
 private:
 
     /**
-     * Subscriber information
+     * This type defines the subscribers, stored by their topic filter.
      */
-    struct Subscriber
-    {
-        String          topic;      /**< The subscriber topic */
-        TopicCallback   callback;   /**< The subscriber callback */
-    };
+    typedef TopicTrie<TopicCallback>    SubscriberTrie;
 
     /**
-     * This type defines a list of subscribers.
+     * This type defines a list of topic filters.
      */
-    typedef std::vector<Subscriber*>    SubscriberList;
+    typedef std::vector<String>         TopicList;
 
     /** MQTT port */
     static const uint16_t   MQTT_PORT                   = 1883U;
@@ -217,6 +227,12 @@ private:
      */
     static const size_t     MAX_BUFFER_SIZE             = 2048U;
 
+    /**
+     * Max. number of topics, which are resubscribed per process cycle after
+     * a reconnect. This avoids a long blocking burst of subscriptions.
+     */
+    static const size_t     RESUBSCRIBE_BATCH_SIZE      = 8U;
+
     KeyValueString          m_mqttBrokerUrlSetting; /**< URL of the MQTT broker setting */
     String                  m_url;                  /**< URL of the MQTT broker */
     String                  m_user;                 /**< MQTT authentication: user name */
@@ -225,7 +241,8 @@ private:
     WiFiClient              m_wifiClient;           /**< WiFi client */
     PubSubClient            m_mqttClient;           /**< MQTT client */
     State                   m_state;                /**< Connection state */
-    SubscriberList          m_subscriberList;       /**< List of subscribers */
+    SubscriberTrie          m_subscribers;          /**< Subscribers by topic filter */
+    TopicList               m_resubscribeList;      /**< Topic filters, which still need to be resubscribed. */
     SimpleTimer             m_reconnectTimer;       /**< Timer used for periodically reconnecting. */
 
     /**
@@ -241,7 +258,8 @@ private:
         m_wifiClient(),
         m_mqttClient(m_wifiClient),
         m_state(STATE_DISCONNECTED),
-        m_subscriberList(),
+        m_subscribers(),
+        m_resubscribeList(),
         m_reconnectTimer()
     {
     }
@@ -283,10 +301,16 @@ private:
     void rxCallback(char* topic, uint8_t* payload, uint32_t length);
 
     /**
-     * Resubscribe all topics.
+     * Prepare the resubscription of all topics. The topics are resubscribed
+     * in batches by processResubscription().
      */
     void resubscribe();
 
+    /**
+     * Resubscribe the next batch of pending topics.
+     */
+    void processResubscription();
+
     /**
      * Parse MQTT broker URL and derive the raw URL, the user and password.
      * 
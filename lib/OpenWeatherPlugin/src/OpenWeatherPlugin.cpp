@@ -41,6 +41,7 @@
 #include <Util.h>
 #include <math.h>
 #include <HttpStatus.h>
+#include <NativeImg.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -226,19 +227,6 @@ bool OpenWeatherPlugin::setTopic(const String& topic, const JsonObjectConst& val
     return isSuccessful;
 }
 
-bool OpenWeatherPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void OpenWeatherPlugin::setSlot(const ISlotPlugin* slotInterf)
 {
     m_slotInterf = slotInterf;
@@ -283,15 +271,9 @@ void OpenWeatherPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
 
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
+    /* The weather info is only requested, if the slot is shown soon. */
+    (void)PollingService::getInstance().registerPoll(getUID(), m_updatePeriod, 0U);
 
     initHttpClient();
 }
@@ -301,10 +283,9 @@ void OpenWeatherPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
-    m_requestTimer.stop();
+    PollingService::getInstance().unregisterPoll(getUID());
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -316,34 +297,23 @@ void OpenWeatherPlugin::process(bool isConnected)
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -353,48 +323,17 @@ void OpenWeatherPlugin::process(bool isConnected)
     }
 
     /* Only if a network connection is established the required information
-     * shall be periodically requested via REST API.
+     * shall be requested via REST API. When is decided by the polling service,
+     * depended on the slot schedule.
      */
-    if (false == m_requestTimer.isTimerRunning())
+    if ((true == isConnected) &&
+        (true == PollingService::getInstance().isPollDue(getUID())))
     {
-        if (true == isConnected)
+        if (false == startHttpRequest())
         {
-            if (false == startHttpRequest())
-            {
-                LOG_WARNING("Failed to request weather info.");
-                
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(m_updatePeriod);
-            }
-        }
-    }
-    else
-    {
-        /* If the connection is lost, stop periodically requesting information
-         * via REST API.
-         */
-        if (false == isConnected)
-        {
-            m_requestTimer.stop();
-        }
-        /* Network connection is available and next request may be necessary for
-         * information update.
-         */
-        else if (true == m_requestTimer.isTimeout())
-        {
-            if (false == startHttpRequest())
-            {
-                LOG_WARNING("Failed to request weather info.");
+            LOG_WARNING("Failed to request weather info.");
 
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(m_updatePeriod);
-            }
+            PollingService::getInstance().reportResult(getUID(), false);
         }
     }
 
@@ -420,21 +359,19 @@ void OpenWeatherPlugin::process(bool isConnected)
                 delete msg.rsp;
                 msg.rsp = nullptr;
             }
+
+            PollingService::getInstance().reportResult(getUID(), true);
             break;
 
         case MSG_TYPE_CONN_CLOSED:
             LOG_INFO("Connection closed.");
 
-            if (true == m_isConnectionError)
-            {
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            m_isConnectionError = false;
+            /* Closed without a valid response before? */
+            PollingService::getInstance().reportResult(getUID(), false);
             break;
 
         case MSG_TYPE_CONN_ERROR:
             LOG_WARNING("Connection error.");
-            m_isConnectionError = true;
             break;
 
         default:
@@ -526,9 +463,7 @@ void OpenWeatherPlugin::destroyOpenWeatherSource()
 
 void OpenWeatherPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void OpenWeatherPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -632,9 +567,10 @@ bool OpenWeatherPlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_additionalInformation = static_cast<OtherWeatherInformation>(jsonOther.as<int>());
 
         /* Force update on display */
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        (void)PollingService::getInstance().registerPoll(getUID(), m_updatePeriod, 0U);
+        PollingService::getInstance().triggerPoll(getUID());
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
@@ -809,12 +745,28 @@ bool OpenWeatherPlugin::startHttpRequest()
         (false == m_source->getLongitude().isEmpty()) &&
         (false == m_source->getUnits().isEmpty()))
     {
-        String url = OPEN_WEATHER_BASE_URI;
+        String                                      url = OPEN_WEATHER_BASE_URI;
+        StaticJsonDocument<JSON_FILTER_DOC_SIZE>    jsonFilterDoc;
 
         m_source->getUrl(url);
+        m_source->getFilter(jsonFilterDoc);
 
-        if (true == m_client.begin(url))
+        if (true == jsonFilterDoc.overflowed())
+        {
+            LOG_ERROR("Less memory for filter available.");
+        }
+        else if (true == m_client.begin(url))
         {
+            /* The stream filter keeps its own copy of the filter until the
+             * next request, because the HTTP client task must never read
+             * the plugin owned filter.
+             */
+            {
+                MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+                (void)m_jsonStreamFilter.begin(jsonFilterDoc.as<JsonVariantConst>());
+            }
+
             if (false == m_client.GET())
             {
                 LOG_WARNING("GET %s failed.", url.c_str());
@@ -833,7 +785,8 @@ void OpenWeatherPlugin::initHttpClient()
 {
     /* Note: All registered callbacks are running in a different task context!
      *       Therefore it is not allowed to access a member here directly.
-     *       The processing must be deferred via task proxy.
+     *       The processing must be deferred via task proxy. The only exception
+     *       is the stream filter, which is protected by its own mutex.
      */
     m_client.regOnResponse(
         [this](const HttpResponse& rsp)
@@ -842,6 +795,16 @@ void OpenWeatherPlugin::initHttpClient()
         }
     );
 
+    m_client.regOnRspPayload(
+        [this](const uint8_t* payload, size_t size)
+        {
+            /* Only the stream filter is accessed, which is protected by its own mutex. */
+            MutexGuard<Mutex> guard(m_streamFilterMutex);
+
+            (void)m_jsonStreamFilter.write(payload, size);
+        }
+    );
+
     m_client.regOnClosed(
         [this]()
         {
@@ -869,51 +832,36 @@ void OpenWeatherPlugin::handleAsyncWebResponse(const HttpResponse& rsp)
 {
     if (HttpStatus::STATUS_CODE_OK == rsp.getStatusCode())
     {
-        if (nullptr != m_source)
+        const size_t            JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+
+        if (nullptr != jsonDoc)
         {
-            const size_t            JSON_DOC_SIZE   = 512U;
-            DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+            DeserializationError error;
 
-            if (nullptr != jsonDoc)
             {
-                size_t                          payloadSize     = 0U;
-                const void*                     vPayload        = rsp.getPayload(payloadSize);
-                const char*                     payload         = static_cast<const char*>(vPayload);
-                const size_t                    FILTER_SIZE     = 128U;
-                StaticJsonDocument<FILTER_SIZE> jsonFilterDoc;
-
-                m_source->getFilter(jsonFilterDoc);
+                MutexGuard<Mutex> guard(m_streamFilterMutex);
 
-                if (true == jsonFilterDoc.overflowed())
-                {
-                    LOG_ERROR("Less memory for filter available.");
-                }
-                else if ((nullptr == payload) ||
-                         (0U == payloadSize))
-                {
-                    LOG_ERROR("No payload.");
-                }
-                else
-                {
-                    DeserializationError error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(jsonFilterDoc));
+                error = m_jsonStreamFilter.deserialize(*jsonDoc);
+            }
 
-                    if (DeserializationError::Ok != error.code())
-                    {
-                        LOG_WARNING("JSON parse error: %s", error.c_str());
-                    }
-                    else
-                    {
-                        Msg msg;
+            if (DeserializationError::Ok != error.code())
+            {
+                LOG_WARNING("JSON parse error: %s", error.c_str());
+                delete jsonDoc;
+                jsonDoc = nullptr;
+            }
+            else
+            {
+                Msg msg;
 
-                        msg.type    = MSG_TYPE_RSP;
-                        msg.rsp     = jsonDoc;
+                msg.type    = MSG_TYPE_RSP;
+                msg.rsp     = jsonDoc;
 
-                        if (false == this->m_taskProxy.send(msg))
-                        {
-                            delete jsonDoc;
-                            jsonDoc = nullptr;
-                        }
-                    }
+                if (false == this->m_taskProxy.send(msg))
+                {
+                    delete jsonDoc;
+                    jsonDoc = nullptr;
                 }
             }
         }
@@ -999,7 +947,7 @@ void OpenWeatherPlugin::prepareDataToShow()
          * If this is not available too, use the standard OpenWeather icon.
          */
         weatherConditionIconFullPath = IMAGE_PATH + weatherIconId + FILE_EXT_BITMAP;
-        if (false == FILESYSTEM.exists(weatherConditionIconFullPath))
+        if (false == NativeImg::exists(FILESYSTEM, weatherConditionIconFullPath))
         {
             weatherConditionIconFullPath  = IMAGE_PATH + weatherIconId.substring(0U, weatherIconId.length() - 1U);
             weatherConditionIconFullPath += FILE_EXT_BITMAP;
@@ -54,6 +54,8 @@
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
 #include <FileSystem.h>
+#include <JsonStreamFilter.h>
+#include <PollingService.h>
 
 /******************************************************************************
  * Macros
@@ -111,10 +113,10 @@ public:
         m_additionalInformation(OTHER_WEATHER_INFO_OFF),
         m_configurationFilename(),
         m_client(),
-        m_requestTimer(),
+        m_jsonStreamFilter(JSON_STREAM_FILTER_SIZE, JSON_FILTER_DOC_SIZE),
+        m_streamFilterMutex(),
         m_updateContentTimer(),
         m_mutex(),
-        m_isConnectionError(false),
         m_currentTemp("\\calign?"),
         m_currentWeatherIconFullPath(IMAGE_PATH_STD_ICON),
         m_currentUvIndex("\\calign?"),
@@ -124,13 +126,11 @@ public:
         m_slotInterf(nullptr),
         m_durationCounter(0u),
         m_isUpdateAvailable(false),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
         m_reloadConfigReq(false),
-        m_hasTopicChanged(false),
         m_taskProxy()
     {
         (void)m_mutex.create();
+        (void)m_streamFilterMutex.create();
         createOpenWeatherSource(m_sourceId); /* Default */
     }
 
@@ -140,6 +140,7 @@ public:
     ~OpenWeatherPlugin()
     {
         m_client.regOnResponse(nullptr);
+        m_client.regOnRspPayload(nullptr);
         m_client.regOnClosed(nullptr);
         m_client.regOnError(nullptr);
 
@@ -151,6 +152,7 @@ public:
         clearQueue();
         destroyOpenWeatherSource();
         
+        m_streamFilterMutex.destroy();
         m_mutex.destroy();
     }
 
@@ -244,17 +246,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Set the slot interface, which the plugin can used to request information
      * from the slot, it is plugged in.
@@ -446,28 +437,28 @@ private:
     static const char*      FILE_EXT_SPRITE_SHEET;
 
     /**
-     * Period in ms for requesting data from server.
-     * This is used in case the last request to the server was successful.
+     * Period in ms for requesting data from server, while the slot is shown.
+     * Failed requests are retried by the polling service.
      * 
      * Note, the OpenWeather recommendation is no more than once in 10 minutes.
      */
     static const uint32_t   UPDATE_PERIOD           = SIMPLE_TIMER_MINUTES(10U);
 
-    /**
-     * Short period in ms for requesting data from server.
-     * This is used in case the request to the server failed.
-     */
-    static const uint32_t   UPDATE_PERIOD_SHORT     = SIMPLE_TIMER_SECONDS(10U);
-
     /** Time for duration tick period in ms */
     static const uint32_t   DURATION_TICK_PERIOD    = SIMPLE_TIMER_SECONDS(1U);
 
     /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
+     * Size in byte of the JSON filter document, which is used to select the
+     * relevant parts of the response.
+     */
+    static const size_t     JSON_FILTER_DOC_SIZE    = 128U;
+
+    /**
+     * Size in byte of the buffer, which contains the filtered response.
+     * The response is filtered while its received, therefore only the
+     * relevant parts need to fit into.
      */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
+    static const size_t     JSON_STREAM_FILTER_SIZE = 256U;
     
     Fonts::FontType             m_fontType;                     /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup                 m_textCanvas;                   /**< Canvas used for the text widget. */
@@ -475,15 +466,15 @@ private:
     BitmapWidget                m_bitmapWidget;                 /**< Bitmap widget, used to show the icon. */
     TextWidget                  m_textWidget;                   /**< Text widget, used for showing the text. */
     OpenWeatherSource           m_sourceId;                     /**< OpenWeather source id. */
-    uint32_t                    m_updatePeriod;                 /**< Period in ms for requesting data from server. This is used in case the last request to the server was successful. */
+    uint32_t                    m_updatePeriod;                 /**< Period in ms for requesting data from server, while the slot is shown. */
     IOpenWeatherSource*         m_source;                       /**< OpenWeather source to use to retrieve weather information. */
     OtherWeatherInformation     m_additionalInformation;        /**< The configured additional weather information. */
     String                      m_configurationFilename;        /**< String used for specifying the configuration filename. */
     AsyncHttpClient             m_client;                       /**< Asynchronous HTTP client. */
-    SimpleTimer                 m_requestTimer;                 /**< Timer used for cyclic request of new data. */
+    JsonStreamFilter            m_jsonStreamFilter;             /**< Filters the response while its received. */
+    Mutex                       m_streamFilterMutex;            /**< Protects the stream filter, which is fed by the HTTP client task. */
     SimpleTimer                 m_updateContentTimer;           /**< Timer used for duration ticks in [s]. */
     mutable MutexRecursive      m_mutex;                        /**< Mutex to protect against concurrent access. */
-    bool                        m_isConnectionError;            /**< Is connection error happened? */
     String                      m_currentTemp;                  /**< The current temperature. */
     String                      m_currentWeatherIconFullPath;   /**< The current weather condition icon full path. */
     String                      m_currentUvIndex;               /**< The current UV index. */
@@ -493,10 +484,7 @@ private:
     const ISlotPlugin*          m_slotInterf;                   /**< Slot interface */
     uint8_t                     m_durationCounter;              /**< Variable to count the Plugin duration in DURATION_TICK_PERIOD ticks. */
     bool                        m_isUpdateAvailable;            /**< Flag to indicate an updated date value. */
-    SimpleTimer                 m_cfgReloadTimer;               /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                        m_storeConfigReq;               /**< Is requested to store the configuration in persistent memory? */
     bool                        m_reloadConfigReq;              /**< Is requested to reload the configuration from persistent memory? */
-    bool                        m_hasTopicChanged;              /**< Has the topic content changed? */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
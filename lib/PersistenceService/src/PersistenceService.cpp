@@ -0,0 +1,260 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Persistence service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PersistenceService.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Protect the service against concurrent access for the rest of the scope. */
+#define PERSISTENCE_SERVICE_LOCK()  MutexGuard<MutexRecursive> guard(m_mutex)
+
+#else   /* NATIVE */
+
+/** The native test environment runs single threaded. */
+#define PERSISTENCE_SERVICE_LOCK()
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool PersistenceService::start()
+{
+    PERSISTENCE_SERVICE_LOCK();
+
+    m_isFlushing = false;
+    m_flushStart = 0U;
+
+    LOG_INFO("Persistence service started.");
+
+    return true;
+}
+
+void PersistenceService::stop()
+{
+    PERSISTENCE_SERVICE_LOCK();
+
+    /* The service is stopped before a restart, therefore every pending
+     * write is due now. The owners write in their own context, the
+     * restart waits for them with isFlushFinished().
+     */
+    m_isFlushing = true;
+    m_flushStart = millis();
+
+    LOG_INFO("Persistence service stopped, %u write(s) pending.", static_cast<uint32_t>(m_entries.size()));
+}
+
+void PersistenceService::process()
+{
+    /* Nothing to do. The owners ask whether their write is due. */
+}
+
+void PersistenceService::requestWrite(const String& fullPath)
+{
+    PERSISTENCE_SERVICE_LOCK();
+    EntryList::iterator it  = find(fullPath);
+    uint32_t            now = millis();
+
+    ++m_statistics.requests;
+
+    if (m_entries.end() != it)
+    {
+        it->lastRequest = now;
+
+        ++m_statistics.coalesced;
+    }
+    else
+    {
+        Entry entry;
+
+        entry.fullPath      = fullPath;
+        entry.firstRequest  = now;
+        entry.lastRequest   = now;
+
+        m_entries.push_back(entry);
+    }
+}
+
+bool PersistenceService::isWriteDue(const String& fullPath)
+{
+    PERSISTENCE_SERVICE_LOCK();
+    bool    isDue   = false;
+
+    /* Most of the time nothing is pending. */
+    if (false == m_entries.empty())
+    {
+        EntryList::iterator it = find(fullPath);
+
+        if (m_entries.end() != it)
+        {
+            uint32_t now = millis();
+
+            if ((true == m_isFlushing) ||
+                (QUIET_PERIOD <= (now - it->lastRequest)) ||
+                (MAX_DELAY <= (now - it->firstRequest)))
+            {
+                isDue = true;
+            }
+        }
+    }
+
+    return isDue;
+}
+
+void PersistenceService::reportWrite(const String& fullPath, bool isSuccessful)
+{
+    PERSISTENCE_SERVICE_LOCK();
+    EntryList::iterator it  = find(fullPath);
+
+    if (m_entries.end() != it)
+    {
+        (void)m_entries.erase(it);
+    }
+
+    if (true == isSuccessful)
+    {
+        ++m_statistics.writes;
+    }
+    else
+    {
+        ++m_statistics.failed;
+
+        LOG_WARNING("Failed to write %s.", fullPath.c_str());
+    }
+}
+
+void PersistenceService::cancelWrite(const String& fullPath)
+{
+    PERSISTENCE_SERVICE_LOCK();
+    EntryList::iterator it  = find(fullPath);
+
+    if (m_entries.end() != it)
+    {
+        (void)m_entries.erase(it);
+    }
+}
+
+void PersistenceService::getStatistics(Statistics& statistics) const
+{
+    PERSISTENCE_SERVICE_LOCK();
+
+    statistics          = m_statistics;
+    statistics.pending  = static_cast<uint32_t>(m_entries.size());
+}
+
+bool PersistenceService::isFlushFinished() const
+{
+    PERSISTENCE_SERVICE_LOCK();
+    bool    isFinished  = false;
+
+    if (false == m_isFlushing)
+    {
+        /* Not stopped yet, the pending writes are not due. */
+        ;
+    }
+    else if (true == m_entries.empty())
+    {
+        isFinished = true;
+    }
+    else if (FLUSH_TIMEOUT <= (millis() - m_flushStart))
+    {
+        LOG_WARNING("Flush timeout, %u write(s) lost.", static_cast<uint32_t>(m_entries.size()));
+        isFinished = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return isFinished;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+PersistenceService::EntryList::iterator PersistenceService::find(const String& fullPath)
+{
+    EntryList::iterator it      = m_entries.begin();
+    bool                isFound = false;
+
+    while((m_entries.end() != it) && (false == isFound))
+    {
+        if (fullPath == it->fullPath)
+        {
+            isFound = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return it;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,252 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Persistence service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup service
+ *
+ * @{
+ */
+
+#ifndef PERSISTENCE_SERVICE_H
+#define PERSISTENCE_SERVICE_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <IService.hpp>
+#include <SimpleTimer.hpp>
+#include <vector>
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The persistence service coalesces writes of configuration files to the
+ * filesystem (write-behind). The owner of a configuration keeps it in RAM
+ * and requests to write it on every change. The service decides when the
+ * write is due:
+ * - After a quiet period without further changes.
+ * - After a max. delay, even if the configuration is still changed.
+ * - Immediately after the service is stopped, e.g. before a restart.
+ *   The restart waits until all pending writes are finished, but not
+ *   longer than the flush timeout.
+ *
+ * The owner writes the file in its own context and reports the result.
+ * Every write is counted, to make the flash wear visible.
+ */
+class PersistenceService : public IService
+{
+public:
+
+    /**
+     * Write statistics since startup.
+     */
+    struct Statistics
+    {
+        uint32_t    requests;   /**< Number of write requests */
+        uint32_t    coalesced;  /**< Number of write requests, which were merged into an already pending write */
+        uint32_t    writes;     /**< Number of successful file writes */
+        uint32_t    failed;     /**< Number of failed file writes */
+        uint32_t    pending;    /**< Number of currently pending writes */
+    };
+
+    /**
+     * Get the persistence service instance.
+     *
+     * @return Persistence service instance
+     */
+    static PersistenceService& getInstance()
+    {
+        static PersistenceService instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Start the service.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool start() final;
+
+    /**
+     * Stop the service. All pending writes are due immediately and the
+     * flush timeout starts.
+     */
+    void stop() final;
+
+    /**
+     * Process the service.
+     */
+    void process() final;
+
+    /**
+     * Request to write the file. If a write of the file is already pending,
+     * the request is merged and the quiet period restarts.
+     *
+     * @param[in] fullPath  Full path of the file
+     */
+    void requestWrite(const String& fullPath);
+
+    /**
+     * Is the pending write of the file due?
+     *
+     * @param[in] fullPath  Full path of the file
+     *
+     * @return If due, it will return true otherwise false.
+     */
+    bool isWriteDue(const String& fullPath);
+
+    /**
+     * Report that the file was written. A pending write of the file is
+     * finished. Writes without a request are counted as well.
+     *
+     * @param[in] fullPath      Full path of the file
+     * @param[in] isSuccessful  Was the file successful written?
+     */
+    void reportWrite(const String& fullPath, bool isSuccessful);
+
+    /**
+     * Cancel a pending write of the file, e.g. because the configuration
+     * in RAM was replaced by the file content.
+     *
+     * @param[in] fullPath  Full path of the file
+     */
+    void cancelWrite(const String& fullPath);
+
+    /**
+     * Get the write statistics.
+     *
+     * @param[out] statistics   Write statistics
+     */
+    void getStatistics(Statistics& statistics) const;
+
+    /**
+     * Is the flush after the service was stopped finished? It is finished
+     * if all pending writes are written or canceled, or if the flush timeout
+     * elapsed. Only then the filesystem may be unmounted.
+     *
+     * @return If finished, it will return true otherwise false.
+     */
+    bool isFlushFinished() const;
+
+    /** A requested write is due after this period in ms without further requests. */
+    static const uint32_t   QUIET_PERIOD    = SIMPLE_TIMER_SECONDS(5U);
+
+    /** A requested write is due at the latest after this period in ms. */
+    static const uint32_t   MAX_DELAY       = SIMPLE_TIMER_SECONDS(60U);
+
+    /** After the service is stopped, the pending writes are waited for at most this period in ms. */
+    static const uint32_t   FLUSH_TIMEOUT   = SIMPLE_TIMER_SECONDS(3U);
+
+private:
+
+    /**
+     * A pending write.
+     */
+    struct Entry
+    {
+        String      fullPath;       /**< Full path of the file */
+        uint32_t    firstRequest;   /**< Timestamp in ms of the first request */
+        uint32_t    lastRequest;    /**< Timestamp in ms of the last request */
+    };
+
+    /** List of pending writes */
+    typedef std::vector<Entry> EntryList;
+
+#ifndef NATIVE
+    mutable MutexRecursive  m_mutex;        /**< Used to protect against concurrent access. */
+#endif  /* NATIVE */
+    EntryList               m_entries;      /**< Pending writes */
+    Statistics              m_statistics;   /**< Write statistics */
+    bool                    m_isFlushing;   /**< Are all pending writes due immediately? */
+    uint32_t                m_flushStart;   /**< Timestamp in ms, when the flush started. Only valid if flushing. */
+
+    /**
+     * Constructs the service instance.
+     */
+    PersistenceService() :
+        IService(),
+#ifndef NATIVE
+        m_mutex(),
+#endif  /* NATIVE */
+        m_entries(),
+        m_statistics(),
+        m_isFlushing(false),
+        m_flushStart(0U)
+    {
+#ifndef NATIVE
+        (void)m_mutex.create();
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Destroys the service instance.
+     */
+    ~PersistenceService()
+    {
+        /* Never called. */
+    }
+
+    /* An instance shall not be copied. */
+    PersistenceService(const PersistenceService& service);
+    PersistenceService& operator=(const PersistenceService& service);
+
+    /**
+     * Find the pending write of the file.
+     *
+     * @param[in] fullPath  Full path of the file
+     *
+     * @return Iterator to the entry. If not found, it will return the end.
+     */
+    EntryList::iterator find(const String& fullPath);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* PERSISTENCE_SERVICE_H */
+
+/** @} */
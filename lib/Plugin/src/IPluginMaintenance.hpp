@@ -44,10 +44,13 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <new>
 #include <YAGfx.h>
+#include <HeapAccounting.hpp>
 #include <ArduinoJson.h>
 #include <Fonts.h>
 #include "ISlotPlugin.hpp"
+#include "ITopicChangeListener.hpp"
 
 /******************************************************************************
  * Macros
@@ -76,6 +79,57 @@ public:
     {
     }
 
+    /**
+     * Allocate memory for a plugin instance. The instance size is accounted
+     * with the plugin tag of the heap accounting.
+     *
+     * @param[in] size  Instance size in byte
+     *
+     * @return Allocated memory
+     */
+    static void* operator new(size_t size)
+    {
+        void* ptr = ::operator new(size);
+
+        HeapAccounting::getInstance().allocated(HeapAccounting::TAG_PLUGIN, size);
+
+        return ptr;
+    }
+
+    /**
+     * Allocate memory for a plugin instance, without throwing an exception.
+     * The instance size is accounted with the plugin tag of the heap accounting.
+     *
+     * @param[in] size      Instance size in byte
+     * @param[in] nothrow   No exception tag
+     *
+     * @return If successful, it will return the allocated memory otherwise nullptr.
+     */
+    static void* operator new(size_t size, const std::nothrow_t& nothrow) noexcept
+    {
+        void* ptr = ::operator new(size, nothrow);
+
+        HeapAccounting::getInstance().track(HeapAccounting::TAG_PLUGIN, ptr, size);
+
+        return ptr;
+    }
+
+    /**
+     * Release the memory of a plugin instance.
+     *
+     * @param[in] ptr   Memory of the plugin instance
+     * @param[in] size  Instance size in byte
+     */
+    static void operator delete(void* ptr, size_t size) noexcept
+    {
+        if (nullptr != ptr)
+        {
+            HeapAccounting::getInstance().released(HeapAccounting::TAG_PLUGIN, size);
+        }
+
+        ::operator delete(ptr);
+    }
+
     /**
      * Set the slot interface, which the plugin can used to request information
      * from the slot, it is plugged in.
@@ -176,15 +230,13 @@ public:
     virtual bool setTopic(const String& topic, const JsonObjectConst& value) = 0;
 
     /**
-     * Has the topic content changed since last time?
+     * Set the listener, which the plugin shall inform about topic content changes.
      * Every readable volatile topic shall support this. Otherwise the topic
      * handlers might not be able to provide updated information.
      * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
+     * @param[in] listener  Topic change listener, may be nullptr to remove it.
      */
-    virtual bool hasTopicChanged(const String& topic) = 0;
+    virtual void setTopicChangeListener(ITopicChangeListener* listener) = 0;
 
     /**
      * Is a upload request accepted or rejected?
@@ -48,6 +48,8 @@
 #include <stdint.h>
 #include <YAGfx.h>
 #include <JsonFile.h>
+#include <ConfigChangeNotifier.h>
+#include <PersistenceService.h>
 #include <ArduinoJson.h>
 
 /******************************************************************************
@@ -208,18 +210,13 @@ public:
     }
 
     /**
-     * Has the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
+     * Set the listener, which the plugin shall inform about topic content changes.
      * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
+     * @param[in] listener  Topic change listener, may be nullptr to remove it.
      */
-    bool hasTopicChanged(const String& topic) override
+    void setTopicChangeListener(ITopicChangeListener* listener) final
     {
-        PLUGIN_NOT_USED(topic);
-        return false;
+        m_topicChangeListener = listener;
     }
 
     /**
@@ -356,15 +353,34 @@ protected:
         m_isEnabled(false),
         m_uid(uid),
         m_alias(),
-        m_name(name)
+        m_name(name),
+        m_topicChangeListener(nullptr)
+    {
+    }
+
+    /**
+     * Inform about a changed topic content. Every readable volatile topic
+     * shall call it after its content changed. Otherwise the topic handlers
+     * might not be able to provide updated information.
+     *
+     * @param[in] topic The topic, which content changed.
+     */
+    void notifyTopicChanged(const String& topic)
     {
+        ITopicChangeListener* listener = m_topicChangeListener;
+
+        if (nullptr != listener)
+        {
+            listener->onTopicChanged(this, topic);
+        }
     }
 
 private:
 
-    const uint16_t  m_uid;      /**< Unique id */
-    String          m_alias;    /**< Alias name */
-    String          m_name;     /**< Plugin name */
+    const uint16_t          m_uid;                  /**< Unique id */
+    String                  m_alias;                /**< Alias name */
+    String                  m_name;                 /**< Plugin name */
+    ITopicChangeListener*   m_topicChangeListener;  /**< Listener, which is informed about topic content changes. */
 
     Plugin();
     Plugin(const Plugin& plugin);
@@ -376,8 +392,11 @@ private:
  * Use it for loading and saving the configuration, as well as checking
  * whether the configuration file was changed without the handlers
  * knowledge.
+ *
+ * Changes of the configuration file are pushed by the configuration change
+ * notifier, therefore checking for updates doesn't access the filesystem.
  */
-class PluginConfigFsHandler
+class PluginConfigFsHandler : private ConfigChangeNotifier::Listener
 {
 public:
 
@@ -386,6 +405,7 @@ public:
      */
     ~PluginConfigFsHandler()
     {
+        ConfigChangeNotifier::getInstance().unregisterListener(this);
     }
 
     /**
@@ -420,9 +440,11 @@ public:
 
 protected:
 
-    const uint16_t  m_uid;                          /**< Unique id */
-    FS&             m_fs;                           /**< Filesystem used to load and save the configuration file. */
-    time_t          m_timestampOfLastFileUpdate;    /**< Configuration in persistent memory written the last time (unix timeformat). */
+    const uint16_t      m_uid;              /**< Unique id */
+    FS&                 m_fs;               /**< Filesystem used to load and save the configuration file. */
+    const String        m_configFullPath;   /**< Full path to the configuration file, kept to avoid building it periodically. */
+    volatile uint32_t   m_configUpdateCnt;  /**< Number of notified configuration file updates. Incremented by the notifier in the writers context. */
+    uint32_t            m_configHandledCnt; /**< Number of configuration file updates, which are already considered by the plugin. */
 
     PluginConfigFsHandler();
     PluginConfigFsHandler(const PluginConfigFsHandler& handler);
@@ -437,8 +459,11 @@ protected:
     PluginConfigFsHandler(uint16_t uid, FS& fs) :
         m_uid(uid),
         m_fs(fs),
-        m_timestampOfLastFileUpdate(0U)
+        m_configFullPath(generateFullPath(uid, ".json")),
+        m_configUpdateCnt(0U),
+        m_configHandledCnt(0U)
     {
+        (void)ConfigChangeNotifier::getInstance().registerListener(m_configFullPath, this);
     }
 
     /**
@@ -458,50 +483,35 @@ protected:
     virtual bool setConfiguration(JsonObjectConst& cfg) = 0;
 
     /**
-     * Update the internal timestamp of the last configuration file update.
+     * Is the configuration in persistent memory updated without using the
+     * plugin API? The filesystem is not accessed.
+     * 
+     * @return If updated, it will return true otherwise false.
      */
-    void updateTimestampLastUpdate()
+    bool isConfigurationUpdated() const
     {
-        m_timestampOfLastFileUpdate = getLastConfigurationUpdate();
+        return (m_configUpdateCnt != m_configHandledCnt);
     }
 
     /**
-     * Get timestamp of the last configuration update in the persistent memory.
-     * 
-     * @return Timestamp in unix time format.
+     * Request to save the configuration to persistent memory. The request
+     * is deferred by the persistence service, so that several changes in a
+     * short time are written only once.
      */
-    time_t getLastConfigurationUpdate() const
+    void requestSaveConfiguration()
     {
-        String  configurationFilename   = getFullPathToConfiguration();
-        File    fd                      = m_fs.open(configurationFilename, "r");
-        time_t  timestamp               = 0U;
-
-        if (true == fd)
-        {
-            timestamp = fd.getLastWrite();
-            fd.close();
-        }
-
-        return timestamp;
+        PersistenceService::getInstance().requestWrite(m_configFullPath);
     }
 
     /**
-     * Is the configuration in persistent memory updated without using the
-     * plugin API?
+     * Is a requested save of the configuration due? If so, the caller shall
+     * save it with saveConfiguration().
      * 
-     * @return If updated, it will return true otherwise false.
+     * @return If due, it will return true otherwise false.
      */
-    bool isConfigurationUpdated() const
+    bool isSaveConfigurationDue()
     {
-        bool    isConfigurationUpdated      = false;
-        time_t  timestampOfLastFileUpdate   = getLastConfigurationUpdate();
-        
-        if (timestampOfLastFileUpdate != m_timestampOfLastFileUpdate)
-        {
-            isConfigurationUpdated = true;
-        }
-
-        return isConfigurationUpdated;
+        return PersistenceService::getInstance().isWriteDue(m_configFullPath);
     }
 
     /**
@@ -512,7 +522,7 @@ protected:
     bool saveConfiguration()
     {
         bool                status                  = true;
-        JsonFile            jsonFile(m_fs);
+        JsonFile            jsonFile(m_fs, JsonFile::STORAGE_CONFIG);
         const size_t        JSON_DOC_SIZE           = 1024U;
         DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
         JsonObject          jsonRootObject          = jsonDoc.to<JsonObject>();
@@ -526,12 +536,32 @@ protected:
         }
         else
         {
-            m_timestampOfLastFileUpdate = getLastConfigurationUpdate();
+            /* The own update is notified exactly once and must not cause a
+             * reload. Only this notification is considered as handled, an
+             * update by someone else is still pending.
+             */
+            ++m_configHandledCnt;
         }
 
+        PersistenceService::getInstance().reportWrite(configurationFilename, status);
+
         return status;
     }
 
+    /**
+     * Remove configuration file. A pending save is canceled.
+     * 
+     * @return If successful removed, it will return true otherwise false.
+     */
+    bool removeConfiguration()
+    {
+        JsonFile jsonFile(m_fs, JsonFile::STORAGE_CONFIG);
+
+        PersistenceService::getInstance().cancelWrite(m_configFullPath);
+
+        return jsonFile.remove(m_configFullPath);
+    }
+
     /**
      * Load configuration from JSON file.
      * 
@@ -540,12 +570,18 @@ protected:
     bool loadConfiguration()
     {
         bool                status                  = true;
-        JsonFile            jsonFile(m_fs);
+        JsonFile            jsonFile(m_fs, JsonFile::STORAGE_CONFIG);
         const size_t        JSON_DOC_SIZE           = 1024U;
         DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
         JsonObjectConst     jsonRootObject          = jsonDoc.to<JsonObject>();
         String              configurationFilename   = getFullPathToConfiguration();
 
+        /* Updates notified from now on, are considered by the next reload. */
+        m_configHandledCnt = m_configUpdateCnt;
+
+        /* The configuration in RAM is replaced, a pending save is obsolete. */
+        PersistenceService::getInstance().cancelWrite(configurationFilename);
+
         if (false == jsonFile.load(configurationFilename, jsonDoc))
         {
             status = false;
@@ -560,6 +596,18 @@ protected:
 
 private:
 
+    /**
+     * The configuration file was written or removed by someone else.
+     * Called in the context of the writer.
+     *
+     * @param[in] fullPath  Full path of the configuration file
+     */
+    void onConfigChanged(const String& fullPath) override
+    {
+        PLUGIN_NOT_USED(fullPath);
+
+        ++m_configUpdateCnt;
+    }
 };
 
 /******************************************************************************
@@ -0,0 +1,382 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Polling service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PollingService.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Protect the service against concurrent access for the rest of the scope. */
+#define POLLING_SERVICE_LOCK()  MutexGuard<MutexRecursive> guard(m_mutex)
+
+#else   /* NATIVE */
+
+/** The native test environment runs single threaded. */
+#define POLLING_SERVICE_LOCK()
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool PollingService::start()
+{
+    LOG_INFO("Polling service started.");
+
+    return true;
+}
+
+void PollingService::stop()
+{
+    /* The registered plugins are kept, because the service is stopped
+     * in case the network connection is lost.
+     */
+    LOG_INFO("Polling service stopped.");
+}
+
+void PollingService::process()
+{
+    POLLING_SERVICE_LOCK();
+    uint32_t             now = millis();
+    EntryList::iterator  it  = m_entries.begin();
+
+    /* A poll, whose result is never reported, shall not block the
+     * plugin forever.
+     */
+    while(m_entries.end() != it)
+    {
+        if ((true == it->isPending) &&
+            (RESULT_TIMEOUT <= (now - it->lastPoll)))
+        {
+            LOG_WARNING("Poll of plugin UID %u timed out.", it->uid);
+
+            it->isPending = false;
+
+            if (UINT8_MAX > it->failures)
+            {
+                ++it->failures;
+            }
+        }
+
+        ++it;
+    }
+}
+
+bool PollingService::registerPoll(uint16_t uid, uint32_t period, uint32_t idlePeriod)
+{
+    POLLING_SERVICE_LOCK();
+    Entry*  entry = find(uid);
+
+    if (nullptr != entry)
+    {
+        entry->period       = period;
+        entry->idlePeriod   = idlePeriod;
+    }
+    else
+    {
+        Entry newEntry;
+
+        newEntry.uid            = uid;
+        newEntry.period         = period;
+        newEntry.idlePeriod     = idlePeriod;
+        newEntry.lastPoll       = 0U;
+        newEntry.jitterRatio    = 0U;
+        newEntry.failures       = 0U;
+        newEntry.isPolled       = false;
+        newEntry.isPending      = false;
+        newEntry.isTriggered    = false;
+        newEntry.scheduleState  = SCHEDULE_STATE_UNKNOWN;
+        newEntry.activation     = 0U;
+
+        m_entries.push_back(newEntry);
+    }
+
+    return true;
+}
+
+void PollingService::unregisterPoll(uint16_t uid)
+{
+    POLLING_SERVICE_LOCK();
+    EntryList::iterator  it = m_entries.begin();
+
+    while(m_entries.end() != it)
+    {
+        if (uid == it->uid)
+        {
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void PollingService::triggerPoll(uint16_t uid)
+{
+    POLLING_SERVICE_LOCK();
+    Entry*  entry = find(uid);
+
+    if (nullptr != entry)
+    {
+        entry->isTriggered  = true;
+        entry->failures     = 0U;
+    }
+}
+
+bool PollingService::isPollDue(uint16_t uid)
+{
+    POLLING_SERVICE_LOCK();
+    Entry*  entry = find(uid);
+    bool    isDue = false;
+
+    if ((nullptr != entry) &&
+        (false == entry->isPending))
+    {
+        uint32_t now = millis();
+
+        if (true == entry->isTriggered)
+        {
+            isDue = true;
+        }
+        else
+        {
+            uint32_t period = getPollPeriod(*entry, now);
+
+            if (0U < period)
+            {
+                if (false == entry->isPolled)
+                {
+                    isDue = true;
+                }
+                else if ((period + getJitter(*entry, period)) <= (now - entry->lastPoll))
+                {
+                    isDue = true;
+                }
+                else
+                {
+                    ;
+                }
+            }
+        }
+
+        if (true == isDue)
+        {
+            entry->lastPoll     = now;
+            entry->jitterRatio  = static_cast<uint8_t>(random(100));
+            entry->isPolled     = true;
+            entry->isPending    = true;
+            entry->isTriggered  = false;
+        }
+    }
+
+    return isDue;
+}
+
+void PollingService::reportResult(uint16_t uid, bool isSuccessful)
+{
+    POLLING_SERVICE_LOCK();
+    Entry*  entry = find(uid);
+
+    /* Only the first result of a poll counts. */
+    if ((nullptr != entry) &&
+        (true == entry->isPending))
+    {
+        entry->isPending = false;
+
+        if (true == isSuccessful)
+        {
+            entry->failures = 0U;
+        }
+        else if (UINT8_MAX > entry->failures)
+        {
+            ++entry->failures;
+        }
+        else
+        {
+            ;
+        }
+    }
+}
+
+void PollingService::clearSchedule()
+{
+    POLLING_SERVICE_LOCK();
+    EntryList::iterator  it = m_entries.begin();
+
+    while(m_entries.end() != it)
+    {
+        it->scheduleState = SCHEDULE_STATE_NONE;
+        ++it;
+    }
+}
+
+void PollingService::setSchedule(uint16_t uid, uint32_t timeUntilActive)
+{
+    POLLING_SERVICE_LOCK();
+    Entry*  entry = find(uid);
+
+    if (nullptr != entry)
+    {
+        entry->scheduleState    = SCHEDULE_STATE_PLANNED;
+        entry->activation       = millis() + timeUntilActive;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+PollingService::Entry* PollingService::find(uint16_t uid)
+{
+    Entry*              entry   = nullptr;
+    EntryList::iterator it      = m_entries.begin();
+
+    while((m_entries.end() != it) && (nullptr == entry))
+    {
+        if (uid == it->uid)
+        {
+            entry = &(*it);
+        }
+
+        ++it;
+    }
+
+    return entry;
+}
+
+bool PollingService::isActiveSoon(const Entry& entry, uint32_t now) const
+{
+    bool isActiveSoon = false;
+
+    if (SCHEDULE_STATE_UNKNOWN == entry.scheduleState)
+    {
+        isActiveSoon = true;
+    }
+    else if (SCHEDULE_STATE_PLANNED == entry.scheduleState)
+    {
+        /* The activation timestamp is in the past, if the slot is already active. */
+        int32_t timeUntilActive = static_cast<int32_t>(entry.activation - now);
+
+        isActiveSoon = (static_cast<int32_t>(PREFETCH_PERIOD) >= timeUntilActive);
+    }
+    else
+    {
+        ;
+    }
+
+    return isActiveSoon;
+}
+
+uint32_t PollingService::getPollPeriod(const Entry& entry, uint32_t now) const
+{
+    uint32_t period = entry.idlePeriod;
+
+    if (true == isActiveSoon(entry, now))
+    {
+        period = entry.period;
+    }
+
+    /* Retry with exponential backoff after failed polls. A long period is
+     * not exceeded, but a short one is extended to avoid flooding a server,
+     * which is not available.
+     */
+    if ((0U < period) &&
+        (0U < entry.failures))
+    {
+        const uint8_t   MAX_SHIFT   = 16U;
+        uint8_t         shift       = entry.failures - 1U;
+        uint32_t        retryPeriod = 0U;
+
+        if (MAX_SHIFT < shift)
+        {
+            shift = MAX_SHIFT;
+        }
+
+        retryPeriod = RETRY_PERIOD << shift;
+
+        if (RETRY_PERIOD_MAX < retryPeriod)
+        {
+            retryPeriod = RETRY_PERIOD_MAX;
+        }
+
+        if ((RETRY_PERIOD > period) ||
+            (retryPeriod < period))
+        {
+            period = retryPeriod;
+        }
+    }
+
+    return period;
+}
+
+uint32_t PollingService::getJitter(const Entry& entry, uint32_t period)
+{
+    return ((period / JITTER_DIVISOR) * entry.jitterRatio) / 100U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,295 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Polling service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup service
+ *
+ * @{
+ */
+
+#ifndef POLLING_SERVICE_H
+#define POLLING_SERVICE_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IService.hpp>
+#include <SimpleTimer.hpp>
+#include <vector>
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The polling service decides for all plugins, which periodically request
+ * data from the network, when the next request shall be started.
+ *
+ * A plugin is polled with its period only, if its slot is active or will be
+ * activated soon (prefetch). Otherwise it is polled with its idle period, which
+ * may be 0 to stop polling at all. The activation times of the slots are
+ * provided by the display manager.
+ *
+ * Failed requests are retried with an exponential backoff and every period is
+ * extended by a random jitter, to avoid that several requests bunch up.
+ */
+class PollingService : public IService
+{
+public:
+
+    /**
+     * Get the polling service instance.
+     *
+     * @return Polling service instance
+     */
+    static PollingService& getInstance()
+    {
+        static PollingService instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Start the service.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool start() final;
+
+    /**
+     * Stop the service.
+     */
+    void stop() final;
+
+    /**
+     * Process the service.
+     */
+    void process() final;
+
+    /**
+     * Register a plugin for polling. If the plugin is already registered,
+     * only its periods are updated.
+     *
+     * @param[in] uid           Plugin UID
+     * @param[in] period        Polling period in ms, while the slot is active or will be soon.
+     * @param[in] idlePeriod    Polling period in ms, while the slot is far from activation or disabled. Use 0 to stop polling.
+     *
+     * @return If successful registered, it will return true otherwise false.
+     */
+    bool registerPoll(uint16_t uid, uint32_t period, uint32_t idlePeriod);
+
+    /**
+     * Unregister a plugin.
+     *
+     * @param[in] uid   Plugin UID
+     */
+    void unregisterPoll(uint16_t uid);
+
+    /**
+     * Request the next poll as soon as possible, e.g. after a configuration
+     * change. A running backoff is cancelled.
+     *
+     * @param[in] uid   Plugin UID
+     */
+    void triggerPoll(uint16_t uid);
+
+    /**
+     * Is the next poll due? If yes, the plugin shall start its request
+     * and report the result with reportResult().
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return If the poll is due, it will return true otherwise false.
+     */
+    bool isPollDue(uint16_t uid);
+
+    /**
+     * Report the result of a poll.
+     *
+     * @param[in] uid           Plugin UID
+     * @param[in] isSuccessful  Was the request successful?
+     */
+    void reportResult(uint16_t uid, bool isSuccessful);
+
+    /**
+     * Mark all registered plugins as not scheduled for activation.
+     * This is called by the display manager, before it sets the activation
+     * times of all scheduled slots.
+     */
+    void clearSchedule();
+
+    /**
+     * Set the time until the slot of the plugin will be activated.
+     *
+     * @param[in] uid               Plugin UID
+     * @param[in] timeUntilActive   Time in ms until the slot is active, 0 if its already active.
+     */
+    void setSchedule(uint16_t uid, uint32_t timeUntilActive);
+
+    /** A slot which is activated within this period in ms, is polled with its period. */
+    static const uint32_t   PREFETCH_PERIOD     = SIMPLE_TIMER_SECONDS(10U);
+
+    /** Period in ms of the first retry after a failed poll. */
+    static const uint32_t   RETRY_PERIOD        = SIMPLE_TIMER_SECONDS(10U);
+
+    /** Max. period in ms between two retries. */
+    static const uint32_t   RETRY_PERIOD_MAX    = SIMPLE_TIMER_MINUTES(5U);
+
+    /** A poll without any reported result is considered as failed after this period in ms. */
+    static const uint32_t   RESULT_TIMEOUT      = SIMPLE_TIMER_MINUTES(1U);
+
+    /** The max. jitter is the period divided by this divisor. */
+    static const uint32_t   JITTER_DIVISOR      = 10U;
+
+private:
+
+    /**
+     * Schedule state of a slot.
+     */
+    enum ScheduleState
+    {
+        SCHEDULE_STATE_UNKNOWN = 0, /**< No activation time known, therefore always polled with its period. */
+        SCHEDULE_STATE_PLANNED,     /**< Activation time is known. */
+        SCHEDULE_STATE_NONE         /**< Slot is disabled or will not be activated. */
+    };
+
+    /**
+     * A registered plugin.
+     */
+    struct Entry
+    {
+        uint16_t        uid;            /**< Plugin UID */
+        uint32_t        period;         /**< Polling period in ms, while the slot is active or will be soon. */
+        uint32_t        idlePeriod;     /**< Polling period in ms, while the slot is far from activation. */
+        uint32_t        lastPoll;       /**< Timestamp in ms of the last poll */
+        uint8_t         jitterRatio;    /**< Random jitter in percent of the max. jitter, chosen at the last poll */
+        uint8_t         failures;       /**< Number of consecutive failed polls */
+        bool            isPolled;       /**< Was the plugin ever polled? */
+        bool            isPending;      /**< Is a poll pending, which result is not reported yet? */
+        bool            isTriggered;    /**< Is a poll requested as soon as possible? */
+        ScheduleState   scheduleState;  /**< Schedule state of the slot */
+        uint32_t        activation;     /**< Timestamp in ms, when the slot will be active. Only valid if planned. */
+    };
+
+    /** List of registered plugins */
+    typedef std::vector<Entry> EntryList;
+
+#ifndef NATIVE
+    mutable MutexRecursive  m_mutex;        /**< Used to protect against concurrent access. */
+#endif  /* NATIVE */
+    EntryList               m_entries;      /**< Registered plugins */
+
+    /**
+     * Constructs the service instance.
+     */
+    PollingService() :
+        IService(),
+#ifndef NATIVE
+        m_mutex(),
+#endif  /* NATIVE */
+        m_entries()
+    {
+#ifndef NATIVE
+        (void)m_mutex.create();
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Destroys the service instance.
+     */
+    ~PollingService()
+    {
+        /* Never called. */
+    }
+
+    /* An instance shall not be copied. */
+    PollingService(const PollingService& service);
+    PollingService& operator=(const PollingService& service);
+
+    /**
+     * Find the registered plugin.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return Entry of the plugin. If not found, it will return nullptr.
+     */
+    Entry* find(uint16_t uid);
+
+    /**
+     * Is the slot of the plugin active or will it be activated soon?
+     *
+     * @param[in] entry     Entry of the plugin
+     * @param[in] now       Current timestamp in ms
+     *
+     * @return If active or activated soon, it will return true otherwise false.
+     */
+    bool isActiveSoon(const Entry& entry, uint32_t now) const;
+
+    /**
+     * Get the period in ms until the next poll, considering the slot schedule
+     * and the backoff after failed polls. The jitter is not included.
+     *
+     * @param[in] entry     Entry of the plugin
+     * @param[in] now       Current timestamp in ms
+     *
+     * @return Period in ms. If the plugin shall not be polled, it will return 0.
+     */
+    uint32_t getPollPeriod(const Entry& entry, uint32_t now) const;
+
+    /**
+     * Get the jitter of the plugin for the given period.
+     *
+     * @param[in] entry     Entry of the plugin
+     * @param[in] period    Period in ms
+     *
+     * @return Jitter in ms
+     */
+    static uint32_t getJitter(const Entry& entry, uint32_t period);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* POLLING_SERVICE_H */
+
+/** @} */
@@ -41,6 +41,9 @@
 
 #include <Logging.h>
 #include <Util.h>
+#include <TrackedJsonDocument.hpp>
+#include <ImageCache.h>
+#include <NativeImg.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -166,7 +169,7 @@ void RestApiTopicHandler::webReqHandler(AsyncWebServerRequest *request, TopicMet
 {
     String              content;
     const size_t        JSON_DOC_SIZE   = 2048U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
     JsonObject          dataObj         = jsonDoc.createNestedObject("data");
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
@@ -199,7 +202,7 @@ void RestApiTopicHandler::webReqHandler(AsyncWebServerRequest *request, TopicMet
     else if ((HTTP_POST == request->method()) &&
              (nullptr != topicMetaData->setTopicFunc))
     {
-        DynamicJsonDocument jsonDocPar(JSON_DOC_SIZE);
+        TrackedJsonDocument jsonDocPar(JSON_DOC_SIZE);
         JsonObjectConst     jsonValue;
         
         /* Topic data is in the HTTP parameters and needs to be converted to JSON. */
@@ -322,6 +325,27 @@ void RestApiTopicHandler::uploadHandler(AsyncWebServerRequest *request, const St
             LOG_INFO("Upload of %s finished.", filename.c_str());
 
             request->_tempFile.close();
+
+            /* A native image, which belongs to the overwritten image, is
+             * outdated. Bitmap images are converted on the fly to the native
+             * image format, which is decoded faster and needs less space.
+             * If the conversion fails, e.g. because its a GIF image, the
+             * file is kept as it is.
+             */
+            NativeImg::removeFileOf(FILESYSTEM, topicMetaData->fullPath);
+
+            if (true == topicMetaData->fullPath.endsWith(".bmp"))
+            {
+                NativeImg nativeImg;
+
+                if (false == nativeImg.convert(FILESYSTEM, topicMetaData->fullPath))
+                {
+                    LOG_INFO("File %s kept in its image format.", topicMetaData->fullPath.c_str());
+                }
+            }
+
+            /* A decoded image of the overwritten file is outdated. */
+            ImageCache::getInstance().invalidate(topicMetaData->fullPath);
         }
     }
 }
@@ -82,10 +82,7 @@ public:
         m_sensorIdx(0U),
         m_channelIdx(0U),
         m_sensorChannel(nullptr),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
-        m_reloadConfigReq(false),
-        m_hasTopicChanged(false)
+        m_reloadConfigReq(false)
     {
         (void)m_mutex.create();
     }
@@ -188,17 +185,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -247,13 +233,6 @@ private:
     /** Sensor value update period in ms. */
     static const uint32_t   UPDATE_PERIOD   = SIMPLE_TIMER_SECONDS(2U);
 
-    /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
-     */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
-
     Fonts::FontType         m_fontType;                 /**< Font type which shall be used if there is no conflict with the layout. */
     TextWidget              m_textWidget;               /**< Text widget, used for showing the text. */
     mutable MutexRecursive  m_mutex;                    /**< Mutex to protect against concurrent access. */
@@ -261,10 +240,7 @@ private:
     uint8_t                 m_channelIdx;               /**< Index of selected channel. */
     ISensorChannel*         m_sensorChannel;            /**< Values of this channel will be shown. */
     SimpleTimer             m_updateTimer;              /**< Sensor value update timer. */
-    SimpleTimer             m_cfgReloadTimer;           /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;           /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;          /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;          /**< Has the topic content changed? */
 
     /**
      * Request to store configuration to persistent memory.
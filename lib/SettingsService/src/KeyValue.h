@@ -44,6 +44,8 @@
  * Includes
  *****************************************************************************/
 #include <Preferences.h>
+#include <Mutex.hpp>
+#include <nvs.h>
 
 /******************************************************************************
  * Macros
@@ -83,10 +85,58 @@ public:
      * Set the persistent storage where the key value pair shall be read/write.
      * 
      * @param[in] pref  Persistent storage
+     * @param[in] mutex Mutex, which protects the value in RAM against concurrent access.
      */
-    void setPersistentStorage(Preferences& pref)
+    void setPersistentStorage(Preferences& pref, MutexRecursive& mutex)
     {
-        m_preferences = &pref;
+        m_preferences   = &pref;
+        m_mutex         = &mutex;
+    }
+
+    /**
+     * Load the value from persistent storage into RAM. Afterwards the value
+     * is read from RAM only. The persistent storage must be opened.
+     */
+    virtual void load() = 0;
+
+    /**
+     * Write a changed value to the NVS, without committing it.
+     * 
+     * @param[in] handle    NVS handle, opened in read/write mode.
+     * 
+     * @return If successful written or unchanged, it will return true otherwise false.
+     */
+    virtual bool write(nvs_handle_t handle) = 0;
+
+    /**
+     * Is the value loaded into RAM?
+     * 
+     * @return If loaded, it will return true otherwise false.
+     */
+    bool isLoaded() const
+    {
+        return m_isLoaded;
+    }
+
+    /**
+     * Is the value changed, but not written to persistent storage yet?
+     * 
+     * @return If changed, it will return true otherwise false.
+     */
+    bool isDirty() const
+    {
+        return m_isDirty;
+    }
+
+    /**
+     * Forget the value in RAM, e.g. because the persistent storage was cleared.
+     */
+    void invalidate()
+    {
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_isLoaded  = false;
+        m_isDirty   = false;
     }
 
     /**
@@ -113,12 +163,18 @@ public:
 protected:
 
     Preferences*    m_preferences;  /**< Persistent storage */
+    MutexRecursive* m_mutex;        /**< Protects the value in RAM against concurrent access. */
+    bool            m_isLoaded;     /**< Is the value loaded into RAM? */
+    bool            m_isDirty;      /**< Is the value changed, but not written to persistent storage yet? */
 
     /**
      * Constructs a key value pair.
      */
     KeyValue() :
-        m_preferences(nullptr)
+        m_preferences(nullptr),
+        m_mutex(nullptr),
+        m_isLoaded(false),
+        m_isDirty(false)
     {
     }
 
@@ -128,7 +184,10 @@ protected:
      * @param[in] pref  Persistent storage
      */
     KeyValue(Preferences& pref) :
-        m_preferences(&pref)
+        m_preferences(&pref),
+        m_mutex(nullptr),
+        m_isLoaded(false),
+        m_isDirty(false)
     {
     }
 
@@ -151,7 +210,8 @@ public:
         m_name(name),
         m_defValue(defValue),
         m_min(min),
-        m_max(max)
+        m_max(max),
+        m_value(defValue)
     {
     }
 
@@ -164,7 +224,8 @@ public:
         m_name(name),
         m_defValue(defValue),
         m_min(min),
-        m_max(max)
+        m_max(max),
+        m_value(defValue)
     {
     }
 
@@ -216,18 +277,76 @@ public:
     }
 
     /**
-     * Get value.
+     * Get value from RAM. The settings service loads it from persistent
+     * storage, when the service starts or the setting is registered. Until
+     * then the default value is provided.
      *
      * @return Value
      */
-    virtual T getValue() const = 0;
+    T getValue() const
+    {
+        MutexGuard<MutexRecursive>  guard(*m_mutex);
+        T                           value   = m_value;
+
+        if (false == m_isLoaded)
+        {
+            value = getDefault();
+        }
+
+        return value;
+    }
 
     /**
-     * Set value.
+     * Set value. It will be written to persistent storage by closing the
+     * settings.
      *
      * @param[in] value Value
      */
-    virtual void setValue(T value) = 0;
+    void setValue(T value)
+    {
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_value     = value;
+        m_isLoaded  = true;
+        m_isDirty   = true;
+    }
+
+    /**
+     * Load the value from persistent storage into RAM.
+     */
+    void load() final
+    {
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_value     = readValue();
+        m_isLoaded  = true;
+        m_isDirty   = false;
+    }
+
+    /**
+     * Write a changed value to the NVS, without committing it.
+     * 
+     * @param[in] handle    NVS handle, opened in read/write mode.
+     * 
+     * @return If successful written or unchanged, it will return true otherwise false.
+     */
+    bool write(nvs_handle_t handle) final
+    {
+        MutexGuard<MutexRecursive>  guard(*m_mutex);
+        bool                        isSuccessful    = true;
+
+        if (true == m_isDirty)
+        {
+            isSuccessful = writeValue(handle, m_value);
+
+            if (true == isSuccessful)
+            {
+                m_isDirty = false;
+            }
+        }
+
+        return isSuccessful;
+    }
 
     /**
      * Get default value.
@@ -246,6 +365,24 @@ protected:
     T               m_defValue; /**< Default value */
     T               m_min;      /**< Min. length */
     T               m_max;      /**< Max. length */
+    T               m_value;    /**< Value in RAM */
+
+    /**
+     * Read value from persistent storage.
+     *
+     * @return Value
+     */
+    virtual T readValue() const = 0;
+
+    /**
+     * Write value to the NVS, without committing it.
+     *
+     * @param[in] handle    NVS handle
+     * @param[in] value     Value
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    virtual bool writeValue(nvs_handle_t handle, T value) const = 0;
 
 private:
 
@@ -67,7 +67,8 @@ public:
         KeyValue(),
         m_key(key),
         m_name(name),
-        m_defValue(defValue)
+        m_defValue(defValue),
+        m_value(defValue)
     {
     }
 
@@ -78,7 +79,8 @@ public:
         KeyValue(pref),
         m_key(key),
         m_name(name),
-        m_defValue(defValue)
+        m_defValue(defValue),
+        m_value(defValue)
     {
     }
 
@@ -120,23 +122,75 @@ public:
     }
 
     /**
-     * Get value.
+     * Get value from RAM. The settings service loads it from persistent
+     * storage, when the service starts or the setting is registered. Until
+     * then the default value is provided.
      *
      * @return Value
      */
     bool getValue() const
     {
-        return m_preferences->getBool(m_key, getDefault());
+        MutexGuard<MutexRecursive>  guard(*m_mutex);
+        bool                        value   = m_value;
+
+        if (false == m_isLoaded)
+        {
+            value = getDefault();
+        }
+
+        return value;
     }
 
     /**
-     * Set value.
+     * Set value. It will be written to persistent storage by closing the
+     * settings.
      *
      * @param[in] value Value
      */
     void setValue(bool value)
     {
-        m_preferences->putBool(m_key, value);
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_value     = value;
+        m_isLoaded  = true;
+        m_isDirty   = true;
+    }
+
+    /**
+     * Load the value from persistent storage into RAM.
+     */
+    void load() final
+    {
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_value     = m_preferences->getBool(m_key, getDefault());
+        m_isLoaded  = true;
+        m_isDirty   = false;
+    }
+
+    /**
+     * Write a changed value to the NVS, without committing it.
+     * 
+     * @param[in] handle    NVS handle, opened in read/write mode.
+     * 
+     * @return If successful written or unchanged, it will return true otherwise false.
+     */
+    bool write(nvs_handle_t handle) final
+    {
+        MutexGuard<MutexRecursive>  guard(*m_mutex);
+        bool                        isSuccessful    = true;
+
+        if (true == m_isDirty)
+        {
+            isSuccessful = (ESP_OK == nvs_set_u8(handle, m_key, (true == m_value) ? 1U : 0U));
+
+            if (true == isSuccessful)
+            {
+                m_isDirty = false;
+            }
+        }
+
+        return isSuccessful;
     }
 
     /**
@@ -154,6 +208,7 @@ private:
     const char*     m_key;      /**< Key */
     const char*     m_name;     /**< Name */
     bool            m_defValue; /**< Default value */
+    bool            m_value;    /**< Value in RAM */
 
     /* An instance shall not be copied. */
     KeyValueBool(const KeyValueBool& kv);
@@ -93,28 +93,31 @@ public:
         return TYPE_INT32;
     }
 
+private:
+
     /**
-     * Get value.
+     * Read value from persistent storage.
      *
      * @return Value
      */
-    int32_t getValue() const final
+    int32_t readValue() const final
     {
         return m_preferences->getInt(m_key, m_defValue);
     }
 
     /**
-     * Set value.
+     * Write value to the NVS, without committing it.
+     *
+     * @param[in] handle    NVS handle
+     * @param[in] value     Value
      *
-     * @param[in] value Value
+     * @return If successful, it will return true otherwise false.
      */
-    void setValue(int32_t value) final
+    bool writeValue(nvs_handle_t handle, int32_t value) const final
     {
-        m_preferences->putInt(m_key, value);
+        return (ESP_OK == nvs_set_i32(handle, m_key, value));
     }
 
-private:
-
     /* An instance shall not be copied. */
     KeyValueInt32(const KeyValueInt32& kv);
     KeyValueInt32& operator=(const KeyValueInt32& kv);
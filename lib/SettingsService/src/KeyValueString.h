@@ -160,23 +160,75 @@ public:
     }
 
     /**
-     * Get value.
+     * Get value from RAM. The settings service loads it from persistent
+     * storage, when the service starts or the setting is registered. Until
+     * then the default value is provided.
      *
      * @return Value
      */
     String getValue() const
     {
-        return m_preferences->getString(m_key, getDefault());
+        MutexGuard<MutexRecursive>  guard(*m_mutex);
+        String                      value   = m_value;
+
+        if (false == m_isLoaded)
+        {
+            value = getDefault();
+        }
+
+        return value;
     }
 
     /**
-     * Set value.
+     * Set value. It will be written to persistent storage by closing the
+     * settings.
      *
      * @param[in] value Value
      */
     void setValue(const String& value)
     {
-        m_preferences->putString(m_key, value);
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_value     = value;
+        m_isLoaded  = true;
+        m_isDirty   = true;
+    }
+
+    /**
+     * Load the value from persistent storage into RAM.
+     */
+    void load() final
+    {
+        MutexGuard<MutexRecursive> guard(*m_mutex);
+
+        m_value     = m_preferences->getString(m_key, getDefault());
+        m_isLoaded  = true;
+        m_isDirty   = false;
+    }
+
+    /**
+     * Write a changed value to the NVS, without committing it.
+     * 
+     * @param[in] handle    NVS handle, opened in read/write mode.
+     * 
+     * @return If successful written or unchanged, it will return true otherwise false.
+     */
+    bool write(nvs_handle_t handle) final
+    {
+        MutexGuard<MutexRecursive>  guard(*m_mutex);
+        bool                        isSuccessful    = true;
+
+        if (true == m_isDirty)
+        {
+            isSuccessful = (ESP_OK == nvs_set_str(handle, m_key, m_value.c_str()));
+
+            if (true == isSuccessful)
+            {
+                m_isDirty = false;
+            }
+        }
+
+        return isSuccessful;
     }
 
     /**
@@ -211,6 +263,13 @@ public:
     void setUniqueId(const String& uniqueId)
     {
         m_uniqueId = uniqueId;
+
+        /* A default value in RAM is outdated now, therefore load it again. */
+        if ((nullptr != m_mutex) &&
+            (false == m_isDirty))
+        {
+            invalidate();
+        }
     }
 
 private:
@@ -222,6 +281,7 @@ private:
     const size_t    m_max;      /**< Max. length */
     const bool      m_isSecret; /**< Is the value a secret value? */
     String          m_uniqueId; /**< Unique id to make the default value unique. */
+    String          m_value;    /**< Value in RAM */
 
     /* An instance shall not be copied. */
     KeyValueString(const KeyValueString& kv);
@@ -93,28 +93,31 @@ public:
         return TYPE_UINT32;
     }
 
+private:
+
     /**
-     * Get value.
+     * Read value from persistent storage.
      *
      * @return Value
      */
-    uint32_t getValue() const final
+    uint32_t readValue() const final
     {
         return m_preferences->getUInt(m_key, m_defValue);
     }
 
     /**
-     * Set value.
+     * Write value to the NVS, without committing it.
+     *
+     * @param[in] handle    NVS handle
+     * @param[in] value     Value
      *
-     * @param[in] value Value
+     * @return If successful, it will return true otherwise false.
      */
-    void setValue(uint32_t value) final
+    bool writeValue(nvs_handle_t handle, uint32_t value) const final
     {
-        m_preferences->putUInt(m_key, value);
+        return (ESP_OK == nvs_set_u32(handle, m_key, value));
     }
 
-private:
-
     /* An instance shall not be copied. */
     KeyValueUInt32(const KeyValueUInt32& kv);
     KeyValueUInt32& operator=(const KeyValueUInt32& kv);
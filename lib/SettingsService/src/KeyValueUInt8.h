@@ -93,28 +93,31 @@ public:
         return TYPE_UINT8;
     }
 
+private:
+
     /**
-     * Get value.
+     * Read value from persistent storage.
      *
      * @return Value
      */
-    uint8_t getValue() const final
+    uint8_t readValue() const final
     {
         return m_preferences->getUChar(m_key, m_defValue);
     }
 
     /**
-     * Set value.
+     * Write value to the NVS, without committing it.
+     *
+     * @param[in] handle    NVS handle
+     * @param[in] value     Value
      *
-     * @param[in] value Value
+     * @return If successful, it will return true otherwise false.
      */
-    void setValue(uint8_t value) final
+    bool writeValue(nvs_handle_t handle, uint8_t value) const final
     {
-        m_preferences->putUChar(m_key, value);
+        return (ESP_OK == nvs_set_u8(handle, m_key, value));
     }
 
-private:
-
     /* An instance shall not be copied. */
     KeyValueUInt8(const KeyValueUInt8& kv);
     KeyValueUInt8& operator=(const KeyValueUInt8& kv);
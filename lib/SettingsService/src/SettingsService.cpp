@@ -325,13 +325,25 @@ static const size_t     MAX_VALUE_NOTIFY_URL            = 64U;
 
 bool SettingsService::start()
 {
-    LOG_INFO("Settings service started.");
+    bool isSuccessful = loadSettings();
 
-    return true;
+    if (false == isSuccessful)
+    {
+        LOG_ERROR("Failed to load settings.");
+    }
+    else
+    {
+        LOG_INFO("Settings service started.");
+    }
+
+    return isSuccessful;
 }
 
 void SettingsService::stop()
 {
+    /* Pending changes shall not get lost. */
+    flush();
+
     LOG_INFO("Settings service stopped.");
 }
 
@@ -342,32 +354,40 @@ void SettingsService::process()
 
 bool SettingsService::open(bool readOnly)
 {
-    /* Open Preferences with namespace. Each application module, library, etc
-     * has to use a namespace name to prevent key name collisions. We will open storage in
-     * RW-mode (second parameter has to be false).
-     * Note: Namespace name is limited to 15 chars.
-     */
-    bool status = m_preferences.begin(PREF_NAMESPACE, readOnly);
+    bool isSuccessful = loadSettings();
 
-    /* If settings storage doesn't exist, it will be created. */
-    if ((false == status) &&
-        (true == readOnly))
+    /* Remember the task, because only its close() shall write the changed settings. */
+    if ((true == isSuccessful) &&
+        (false == readOnly))
     {
-        status = m_preferences.begin(PREF_NAMESPACE, false);
+        MutexGuard<MutexRecursive> guard(m_mutex);
 
-        if (true == status)
-        {
-            m_preferences.end();
-            status = m_preferences.begin(PREF_NAMESPACE, readOnly);
-        }
+        m_writers.push_back(xTaskGetCurrentTaskHandle());
     }
 
-    return status;
+    return isSuccessful;
 }
 
 void SettingsService::close()
 {
-    m_preferences.end();
+    bool isWriter = false;
+
+    {
+        MutexGuard<MutexRecursive>          guard(m_mutex);
+        std::vector<TaskHandle_t>::iterator it  = std::find(m_writers.begin(), m_writers.end(), xTaskGetCurrentTaskHandle());
+
+        if (m_writers.end() != it)
+        {
+            (void)m_writers.erase(it);
+            isWriter = true;
+        }
+    }
+
+    /* A read only access shall never write values, which another task changed. */
+    if (true == isWriter)
+    {
+        flush();
+    }
 }
 
 void SettingsService::cleanUp()
@@ -377,53 +397,101 @@ void SettingsService::cleanUp()
     /* Clean up is only necessary, if settings version is different. */
     if (VERSION != storedVersion)
     {
-        nvs_iterator_t it = nvs_entry_find(NVS_DEFAULT_PART_NAME, PREF_NAMESPACE, NVS_TYPE_ANY);
+        nvs_handle_t handle;
 
-        while (nullptr != it)
+        if (ESP_OK != nvs_open(PREF_NAMESPACE, NVS_READWRITE, &handle))
         {
-            nvs_entry_info_t info;
-
-            nvs_entry_info(it, &info);
-            it = nvs_entry_next(it);
+            LOG_ERROR("Failed to open settings for clean up.");
+        }
+        else
+        {
+            nvs_iterator_t it = nvs_entry_find(NVS_DEFAULT_PART_NAME, PREF_NAMESPACE, NVS_TYPE_ANY);
 
-            /* Obsolete setting?
-             * m_version key must be handled separate, because its not part of the settings list.
-             */
-            if ((0 != strcmp(m_version.getKey(), info.key)) &&
-                (nullptr == getSettingByKey(info.key)))
+            while (nullptr != it)
             {
-                LOG_WARNING("Obsolete key %s removed from settings.", info.key);
+                nvs_entry_info_t info;
 
-                if (false == m_preferences.remove(info.key))
+                nvs_entry_info(it, &info);
+                it = nvs_entry_next(it);
+
+                /* Obsolete setting?
+                 * m_version key must be handled separate, because its not part of the settings list.
+                 */
+                if ((0 != strcmp(m_version.getKey(), info.key)) &&
+                    (nullptr == getSettingByKey(info.key)))
                 {
-                    LOG_ERROR("Failed to remove key %s removed from settings.", info.key);
+                    LOG_WARNING("Obsolete key %s removed from settings.", info.key);
+
+                    if (ESP_OK != nvs_erase_key(handle, info.key))
+                    {
+                        LOG_ERROR("Failed to remove key %s removed from settings.", info.key);
+                    }
                 }
-            }
-            else
+                else
+                {
+                    LOG_INFO("SettingsService key %s is valid.", info.key);
+                }
+            };
+
+            if (ESP_OK != nvs_commit(handle))
             {
-                LOG_INFO("SettingsService key %s is valid.", info.key);
+                LOG_ERROR("Failed to commit settings clean up.");
             }
-        };
 
-        /* Update version */
+            nvs_close(handle);
+        }
+
+        /* Update version, which is written by close(). */
         m_version.setValue(VERSION);
     }
 }
 
-KeyValue* SettingsService::getSettingByKey(const char* key)
+bool SettingsService::clear()
 {
-    std::vector<KeyValue*>::const_iterator  it;
-    KeyValue*                               keyValuePair    = nullptr;
+    MutexGuard<MutexRecursive>          guard(m_mutex);
+    bool                                isSuccessful    = false;
+    nvs_handle_t                        handle;
+    std::vector<KeyValue*>::iterator    it;
+
+    if (ESP_OK == nvs_open(PREF_NAMESPACE, NVS_READWRITE, &handle))
+    {
+        if ((ESP_OK == nvs_erase_all(handle)) &&
+            (ESP_OK == nvs_commit(handle)))
+        {
+            isSuccessful = true;
+        }
+
+        nvs_close(handle);
+    }
+
+    /* The settings in RAM are outdated now and are loaded again, which results in the defaults. */
+    m_version.invalidate();
 
     for(it = m_keyValueList.begin(); it != m_keyValueList.end(); ++it)
     {
-        if (nullptr != *it)
+        (*it)->invalidate();
+    }
+
+    if (false == loadSettings())
+    {
+        isSuccessful = false;
+    }
+
+    return isSuccessful;
+}
+
+KeyValue* SettingsService::getSettingByKey(const char* key)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    KeyValue*                   keyValuePair    = nullptr;
+
+    if (nullptr != key)
+    {
+        KeyValueMap::const_iterator it = m_keyValueMap.find(key);
+
+        if (m_keyValueMap.end() != it)
         {
-            if (0 == strcmp((*it)->getKey(), key))
-            {
-                keyValuePair = *it;
-                break;
-            }
+            keyValuePair = it->second;
         }
     }
 
@@ -432,15 +500,21 @@ KeyValue* SettingsService::getSettingByKey(const char* key)
 
 bool SettingsService::registerSetting(KeyValue* setting)
 {
-    bool isSuccessful = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
 
     if (nullptr != setting)
     {
         /* Register setting only once! */
-        if (std::find(m_keyValueList.begin(), m_keyValueList.end(), setting) == m_keyValueList.end())
+        if (m_keyValueMap.end() == m_keyValueMap.find(setting->getKey()))
         {
-            setting->setPersistentStorage(m_preferences);
-            m_keyValueList.push_back(setting);
+            addSetting(setting);
+
+            /* Load it right now, because its value is only read from RAM. */
+            if (false == loadSettings())
+            {
+                LOG_WARNING("Failed to load setting %s.", setting->getKey());
+            }
 
             isSuccessful = true;
         }
@@ -451,14 +525,17 @@ bool SettingsService::registerSetting(KeyValue* setting)
 
 void SettingsService::unregisterSetting(KeyValue* setting)
 {
-    std::vector<KeyValue*>::iterator it = m_keyValueList.begin();
+    MutexGuard<MutexRecursive>          guard(m_mutex);
+    std::vector<KeyValue*>::iterator    it      = m_keyValueList.begin();
+    bool                                isFound = false;
 
-    while(m_keyValueList.end() != it)
+    while((false == isFound) && (m_keyValueList.end() != it))
     {
         if (setting == *it)
         {
+            (void)m_keyValueMap.erase(setting->getKey());
             it = m_keyValueList.erase(it);
-            break;
+            isFound = true;
         }
         else
         {
@@ -467,6 +544,32 @@ void SettingsService::unregisterSetting(KeyValue* setting)
     }
 }
 
+bool SettingsService::subscribe(Subscriber* subscriber)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+
+    if (nullptr != subscriber)
+    {
+        /* Subscribe only once! */
+        if (std::find(m_subscribers.begin(), m_subscribers.end(), subscriber) == m_subscribers.end())
+        {
+            m_subscribers.push_back(subscriber);
+        }
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void SettingsService::unsubscribe(Subscriber* subscriber)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    m_subscribers.erase(std::remove(m_subscribers.begin(), m_subscribers.end(), subscriber), m_subscribers.end());
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -476,8 +579,12 @@ void SettingsService::unregisterSetting(KeyValue* setting)
  *****************************************************************************/
 
 SettingsService::SettingsService() :
+    m_mutex(),
     m_preferences(),
     m_keyValueList(),
+    m_keyValueMap(),
+    m_subscribers(),
+    m_writers(),
     m_version               (m_preferences, KEY_VERSION,                NAME_VERSION,               DEFAULT_VERSION,                MIN_VALUE_VERSION,              MAX_VALUE_VERSION),
     m_wifiSSID              (m_preferences, KEY_WIFI_SSID,              NAME_WIFI_SSID,             DEFAULT_WIFI_SSID,              MIN_VALUE_WIFI_SSID,            MAX_VALUE_WIFI_SSID),
     m_wifiPassphrase        (m_preferences, KEY_WIFI_PASSPHRASE,        NAME_WIFI_PASSPHRASE,       DEFAULT_WIFI_PASSPHRASE,        MIN_VALUE_WIFI_PASSPHRASE,      MAX_VALUE_WIFI_PASSPHRASE,      true),
@@ -495,29 +602,177 @@ SettingsService::SettingsService() :
     m_notifyURL             (m_preferences, KEY_NOTIFY_URL,             NAME_NOTIFY_URL,            DEFAULT_NOTIFY_URL,             MIN_VALUE_NOTIFY_URL,           MAX_VALUE_NOTIFY_URL),
     m_quietMode             (m_preferences, KEY_QUIET_MODE,             NAME_QUIET_MODE,            DEFAULT_QUIET_MODE)
 {
+    (void)m_mutex.create();
+
+    m_version.setPersistentStorage(m_preferences, m_mutex);
 
     /* Skip m_version, because it shall not be modified by the user. */
-    m_keyValueList.push_back(&m_wifiSSID);
-    m_keyValueList.push_back(&m_wifiPassphrase);
-    m_keyValueList.push_back(&m_apSSID);
-    m_keyValueList.push_back(&m_apPassphrase);
-    m_keyValueList.push_back(&m_webLoginUser);
-    m_keyValueList.push_back(&m_webLoginPassword);
-    m_keyValueList.push_back(&m_hostname);
-    m_keyValueList.push_back(&m_brightness);
-    m_keyValueList.push_back(&m_autoBrightnessCtrl);
-    m_keyValueList.push_back(&m_timezone);
-    m_keyValueList.push_back(&m_ntpServer);
-    m_keyValueList.push_back(&m_maxSlots);
-    m_keyValueList.push_back(&m_scrollPause);
-    m_keyValueList.push_back(&m_notifyURL);
-    m_keyValueList.push_back(&m_quietMode);
+    addSetting(&m_wifiSSID);
+    addSetting(&m_wifiPassphrase);
+    addSetting(&m_apSSID);
+    addSetting(&m_apPassphrase);
+    addSetting(&m_webLoginUser);
+    addSetting(&m_webLoginPassword);
+    addSetting(&m_hostname);
+    addSetting(&m_brightness);
+    addSetting(&m_autoBrightnessCtrl);
+    addSetting(&m_timezone);
+    addSetting(&m_ntpServer);
+    addSetting(&m_maxSlots);
+    addSetting(&m_scrollPause);
+    addSetting(&m_notifyURL);
+    addSetting(&m_quietMode);
 }
 
 SettingsService::~SettingsService()
 {
 }
 
+void SettingsService::addSetting(KeyValue* setting)
+{
+    setting->setPersistentStorage(m_preferences, m_mutex);
+    m_keyValueList.push_back(setting);
+    m_keyValueMap[setting->getKey()] = setting;
+}
+
+bool SettingsService::loadSettings()
+{
+    MutexGuard<MutexRecursive>          guard(m_mutex);
+    bool                                isSuccessful    = true;
+    bool                                isLoadRequired  = (false == m_version.isLoaded());
+    std::vector<KeyValue*>::iterator    it              = m_keyValueList.begin();
+
+    /* Persistent storage is only accessed if a setting is not loaded yet,
+     * e.g. the first time or after a setting was registered.
+     */
+    while((false == isLoadRequired) && (m_keyValueList.end() != it))
+    {
+        if (false == (*it)->isLoaded())
+        {
+            isLoadRequired = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (true == isLoadRequired)
+    {
+        /* Open Preferences with namespace. Each application module, library, etc
+         * has to use a namespace name to prevent key name collisions.
+         * Note: Namespace name is limited to 15 chars.
+         */
+        isSuccessful = m_preferences.begin(PREF_NAMESPACE, true);
+
+        /* If settings storage doesn't exist, it will be created. */
+        if (false == isSuccessful)
+        {
+            isSuccessful = m_preferences.begin(PREF_NAMESPACE, false);
+        }
+
+        if (true == isSuccessful)
+        {
+            if (false == m_version.isLoaded())
+            {
+                m_version.load();
+            }
+
+            for(it = m_keyValueList.begin(); it != m_keyValueList.end(); ++it)
+            {
+                if (false == (*it)->isLoaded())
+                {
+                    (*it)->load();
+                }
+            }
+
+            m_preferences.end();
+        }
+    }
+
+    return isSuccessful;
+}
+
+void SettingsService::flush()
+{
+    std::vector<KeyValue*>              changed;
+    std::vector<Subscriber*>            subscribers;
+    std::vector<KeyValue*>::iterator    itSetting;
+    std::vector<Subscriber*>::iterator  itSubscriber;
+
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        if (false == writeSettings(changed))
+        {
+            LOG_ERROR("Failed to write settings.");
+        }
+
+        subscribers = m_subscribers;
+    }
+
+    /* Inform the subscribers without holding the lock, because they may access the settings. */
+    for(itSetting = changed.begin(); itSetting != changed.end(); ++itSetting)
+    {
+        for(itSubscriber = subscribers.begin(); itSubscriber != subscribers.end(); ++itSubscriber)
+        {
+            (*itSubscriber)->onSettingChanged(**itSetting);
+        }
+    }
+}
+
+bool SettingsService::writeSettings(std::vector<KeyValue*>& changed)
+{
+    MutexGuard<MutexRecursive>          guard(m_mutex);
+    bool                                isSuccessful    = true;
+    std::vector<KeyValue*>::iterator    it;
+
+    for(it = m_keyValueList.begin(); it != m_keyValueList.end(); ++it)
+    {
+        if (true == (*it)->isDirty())
+        {
+            changed.push_back(*it);
+        }
+    }
+
+    if ((true == m_version.isDirty()) ||
+        (false == changed.empty()))
+    {
+        nvs_handle_t handle;
+
+        if (ESP_OK != nvs_open(PREF_NAMESPACE, NVS_READWRITE, &handle))
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            if (false == m_version.write(handle))
+            {
+                isSuccessful = false;
+            }
+
+            for(it = changed.begin(); it != changed.end(); ++it)
+            {
+                if (false == (*it)->write(handle))
+                {
+                    LOG_ERROR("Failed to write setting %s.", (*it)->getKey());
+                    isSuccessful = false;
+                }
+            }
+
+            /* All changes are committed at once. */
+            if (ESP_OK != nvs_commit(handle))
+            {
+                isSuccessful = false;
+            }
+
+            nvs_close(handle);
+        }
+    }
+
+    return isSuccessful;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -45,7 +45,12 @@
  *****************************************************************************/
 #include <Preferences.h>
 #include <IService.hpp>
+#include <Mutex.hpp>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <vector>
+#include <unordered_map>
+#include <string.h>
 
 #include "KeyValue.h"
 #include "KeyValueString.h"
@@ -65,11 +70,50 @@
 
 /**
  * Persistent storage of key value pairs.
+ *
+ * All registered key value pairs are kept in RAM. They are loaded once from
+ * the persistent storage, when the service starts or the key value pair is
+ * registered. Changed values are written with a single commit by the close()
+ * of a read/write access. Subscribers are informed about changed values after
+ * they were written.
  */
 class SettingsService : public IService
 {
 public:
 
+    /**
+     * The subscriber is informed about changed settings.
+     */
+    class Subscriber
+    {
+    public:
+
+        /**
+         * Destroys the subscriber.
+         */
+        virtual ~Subscriber()
+        {
+        }
+
+        /**
+         * Setting was changed and written to persistent storage.
+         * It is called in the context of the writer, therefore the subscriber
+         * shall only remember the change and handle it in its own context.
+         *
+         * @param[in] setting   Changed setting
+         */
+        virtual void onSettingChanged(const KeyValue& setting) = 0;
+
+    protected:
+
+        /**
+         * Constructs the subscriber.
+         */
+        Subscriber()
+        {
+        }
+    };
+
     /**
      * Get settings service.
      * 
@@ -102,6 +146,9 @@ public:
     /**
      * Open settings.
      * If the settings storage doesn't exist, it will be created.
+     * Settings which are not in RAM yet, will be loaded. Otherwise the
+     * persistent storage is not accessed.
+     * Only a read/write access may change settings.
      *
      * @param[in] readOnly  Open read only or read/write
      *
@@ -113,6 +160,9 @@ public:
 
     /**
      * Close settings.
+     * If the calling task opened the settings read/write, all changed settings
+     * are written with a single commit to the persistent storage and the
+     * subscribers are informed. A read only access writes nothing.
      */
     void close();
 
@@ -151,6 +201,22 @@ public:
      */
     void unregisterSetting(KeyValue* setting);
 
+    /**
+     * Subscribe for setting changes.
+     *
+     * @param[in] subscriber    Subscriber, which to inform about changes
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribe(Subscriber* subscriber);
+
+    /**
+     * Unsubscribe from setting changes.
+     *
+     * @param[in] subscriber    Subscriber, which to unsubscribe
+     */
+    void unsubscribe(Subscriber* subscriber);
+
     /**
      * Get a list of all key value pairs.
      *
@@ -170,10 +236,7 @@ public:
      *
      * @return If successful cleared, it will return true otherwise false.
      */
-    bool clear()
-    {
-        return m_preferences.clear();
-    }
+    bool clear();
 
     /**
      * Get remote wifi network SSID.
@@ -336,25 +399,78 @@ public:
 
 private:
 
-    Preferences             m_preferences;          /**< Persistent storage */
-    std::vector<KeyValue*>  m_keyValueList;         /**< List of key/value pairs, stored in persistent storage. */
-
-    KeyValueUInt32          m_version;              /**< Settings version (just an consequtive incremented number) */
-    KeyValueString          m_wifiSSID;             /**< Remote wifi network SSID */
-    KeyValueString          m_wifiPassphrase;       /**< Remote wifi network passphrase */
-    KeyValueString          m_apSSID;               /**< Access point SSID */
-    KeyValueString          m_apPassphrase;         /**< Access point passphrase */
-    KeyValueString          m_webLoginUser;         /**< Website login user account */
-    KeyValueString          m_webLoginPassword;     /**< Website login user password */
-    KeyValueString          m_hostname;             /**< Hostname */
-    KeyValueUInt8           m_brightness;           /**< The brightness level in % set at startup. */
-    KeyValueBool            m_autoBrightnessCtrl;   /**< Automatic brightness control switch */
-    KeyValueString          m_timezone;             /**< POSIX timezone string */
-    KeyValueString          m_ntpServer;            /**< NTP server address */
-    KeyValueUInt8           m_maxSlots;             /**< Max. number of display slots. */
-    KeyValueUInt32          m_scrollPause;          /**< Text scroll pause */
-    KeyValueString          m_notifyURL;            /**< URL to be triggered when PIXELIX has connected to a remote network. */
-    KeyValueBool            m_quietMode;            /**< Quiet mode (skip unnecessary system messages) */
+    /**
+     * Hash function for keys, which are zero-terminated strings (FNV-1a).
+     */
+    struct KeyHash
+    {
+        /**
+         * Calculate hash of key.
+         *
+         * @param[in] key   Key
+         *
+         * @return Hash
+         */
+        size_t operator()(const char* key) const
+        {
+            uint32_t hash = 2166136261U;
+
+            while ('\0' != *key)
+            {
+                hash ^= static_cast<uint8_t>(*key);
+                hash *= 16777619U;
+                ++key;
+            }
+
+            return hash;
+        }
+    };
+
+    /**
+     * Compares two keys, which are zero-terminated strings.
+     */
+    struct KeyEqual
+    {
+        /**
+         * Are both keys equal?
+         *
+         * @param[in] lhs   Left key
+         * @param[in] rhs   Right key
+         *
+         * @return If equal, it will return true otherwise false.
+         */
+        bool operator()(const char* lhs, const char* rhs) const
+        {
+            return (0 == strcmp(lhs, rhs));
+        }
+    };
+
+    /** Key value pairs by their keys. */
+    typedef std::unordered_map<const char*, KeyValue*, KeyHash, KeyEqual> KeyValueMap;
+
+    MutexRecursive              m_mutex;                /**< Protects the settings in RAM against concurrent access. */
+    Preferences                 m_preferences;          /**< Persistent storage */
+    std::vector<KeyValue*>      m_keyValueList;         /**< List of key/value pairs, stored in persistent storage. */
+    KeyValueMap                 m_keyValueMap;          /**< Key/value pairs by their keys for fast access. */
+    std::vector<Subscriber*>    m_subscribers;          /**< Subscribers of setting changes */
+    std::vector<TaskHandle_t>   m_writers;              /**< Tasks, which opened the settings read/write. */
+
+    KeyValueUInt32              m_version;              /**< Settings version (just an consequtive incremented number) */
+    KeyValueString              m_wifiSSID;             /**< Remote wifi network SSID */
+    KeyValueString              m_wifiPassphrase;       /**< Remote wifi network passphrase */
+    KeyValueString              m_apSSID;               /**< Access point SSID */
+    KeyValueString              m_apPassphrase;         /**< Access point passphrase */
+    KeyValueString              m_webLoginUser;         /**< Website login user account */
+    KeyValueString              m_webLoginPassword;     /**< Website login user password */
+    KeyValueString              m_hostname;             /**< Hostname */
+    KeyValueUInt8               m_brightness;           /**< The brightness level in % set at startup. */
+    KeyValueBool                m_autoBrightnessCtrl;   /**< Automatic brightness control switch */
+    KeyValueString              m_timezone;             /**< POSIX timezone string */
+    KeyValueString              m_ntpServer;            /**< NTP server address */
+    KeyValueUInt8               m_maxSlots;             /**< Max. number of display slots. */
+    KeyValueUInt32              m_scrollPause;          /**< Text scroll pause */
+    KeyValueString              m_notifyURL;            /**< URL to be triggered when PIXELIX has connected to a remote network. */
+    KeyValueBool                m_quietMode;            /**< Quiet mode (skip unnecessary system messages) */
 
     /**
      * Constructs the settings service instance.
@@ -366,6 +482,34 @@ private:
      */
     ~SettingsService();
 
+    /**
+     * Add a key value pair to the list of registered settings.
+     *
+     * @param[in] setting   Setting which to add
+     */
+    void addSetting(KeyValue* setting);
+
+    /**
+     * Load all settings into RAM, which are not loaded yet.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool loadSettings();
+
+    /**
+     * Write all changed settings and inform the subscribers about them.
+     */
+    void flush();
+
+    /**
+     * Write all changed settings with a single commit to the persistent storage.
+     *
+     * @param[out] changed  List of written settings
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeSettings(std::vector<KeyValue*>& changed);
+
     /* An instance shall not be copied. */
     SettingsService(const SettingsService& service);
     SettingsService& operator=(const SettingsService& service);
@@ -194,19 +194,6 @@ bool SignalDetectorPlugin::setTopic(const String& topic, const JsonObjectConst&
     return isSuccessful;
 }
 
-bool SignalDetectorPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void SignalDetectorPlugin::setSlot(const ISlotPlugin* slotInterf)
 {
     m_slotInterf = slotInterf;
@@ -245,15 +232,6 @@ void SignalDetectorPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
-
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
 
     initHttpClient();
 }
@@ -263,9 +241,8 @@ void SignalDetectorPlugin::stop()
     MutexGuard<MutexRecursive>  guard(m_mutex);
     String                      configurationFilename   = getFullPathToConfiguration();
 
-    m_cfgReloadTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -334,34 +311,23 @@ void SignalDetectorPlugin::process(bool isConnected)
     }
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -395,9 +361,7 @@ void SignalDetectorPlugin::update(YAGfx& gfx)
 
 void SignalDetectorPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void SignalDetectorPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -501,7 +465,7 @@ bool SignalDetectorPlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_textWidget.setFormatStr(jsonText.as<String>());
         m_pushUrl = jsonPushUrl.as<String>();
 
-        m_hasTopicChanged = true;
+        notifyTopicChanged(TOPIC_CONFIG);
     }
 
     return status;
@@ -567,6 +531,12 @@ bool SignalDetectorPlugin::startHttpRequest()
 
 void SignalDetectorPlugin::initHttpClient()
 {
+    /* A detected signal shall be reported before any periodic update of other plugins. */
+    m_client.setPriority(AsyncHttpClient::PRIORITY_HIGH);
+
+    /* Every push notification shall reach the server. */
+    m_client.setCacheEnabled(false);
+
     /* Note: All registered callbacks are running in a different task context! */
     m_client.regOnResponse([](const HttpResponse& rsp) {
         uint16_t statusCode = rsp.getStatusCode();
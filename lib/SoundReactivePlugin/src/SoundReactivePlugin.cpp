@@ -147,19 +147,6 @@ bool SoundReactivePlugin::setTopic(const String& topic, const JsonObjectConst& v
     return isSuccessful;
 }
 
-bool SoundReactivePlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void SoundReactivePlugin::start(uint16_t width, uint16_t height)
 {
     SpectrumAnalyzer*           spectrumAnalyzer = AudioService::getInstance().getSpectrumAnalyzer();
@@ -190,15 +177,6 @@ void SoundReactivePlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
-
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
 }
 
 void SoundReactivePlugin::stop()
@@ -206,7 +184,6 @@ void SoundReactivePlugin::stop()
     MutexGuard<MutexRecursive>  guard(m_mutex);
     String                      configurationFilename   = getFullPathToConfiguration();
 
-    m_cfgReloadTimer.stop();
     m_decayPeakTimer.stop();
 
     if (nullptr != m_freqBins)
@@ -215,7 +192,7 @@ void SoundReactivePlugin::stop()
         m_freqBins = nullptr;
     }
 
-    if (false != FILESYSTEM.remove(configurationFilename))
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -229,34 +206,23 @@ void SoundReactivePlugin::process(bool isConnected)
     PLUGIN_NOT_USED(isConnected);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -341,9 +307,7 @@ void SoundReactivePlugin::update(YAGfx& gfx)
 
 void SoundReactivePlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void SoundReactivePlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -377,7 +341,7 @@ bool SoundReactivePlugin::setConfiguration(JsonObjectConst& jsonCfg)
 
             m_numOfFreqBands = numOfBands;
 
-            m_hasTopicChanged = true;
+            notifyTopicChanged(TOPIC_CONFIG);
 
             status = true;
         }
@@ -280,30 +280,6 @@ bool ThreeIconPlugin::setTopic(const String& topic, const JsonObjectConst& value
     return isSuccessful;
 }
 
-bool ThreeIconPlugin::hasTopicChanged(const String& topic)
-{
-    bool hasTopicChanged = false;
-
-    if (0U != topic.startsWith(String(TOPIC_ANIMATION) + "/"))
-    {
-        uint32_t    indexBeginIconId    = topic.lastIndexOf("/") + 1U;
-        String      iconIdStr           = topic.substring(indexBeginIconId);
-        uint8_t     iconId              = MAX_ICONS;
-        bool        status              = Util::strToUInt8(iconIdStr, iconId);
-
-        if ((true == status) &&
-            (MAX_ICONS > iconId))
-        {
-            MutexGuard<MutexRecursive> guard(m_mutex);
-
-            hasTopicChanged             = m_hasTopicChanged[iconId];
-            m_hasTopicChanged[iconId]   = false;
-        }
-    }
-
-    return hasTopicChanged;
-}
-
 bool ThreeIconPlugin::isUploadAccepted(const String& topic, const String& srcFilename, String& dstFilename)
 {
     bool isAccepted = false;
@@ -383,7 +359,7 @@ void ThreeIconPlugin::start(uint16_t width, uint16_t height)
             m_spriteSheetPaths[iconId]  = spriteSheetFullPath;
         }
 
-        m_hasTopicChanged[iconId] = true;
+        notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
     }
 }
 
@@ -427,8 +403,9 @@ bool ThreeIconPlugin::loadBitmap(uint8_t iconId, const String& filename)
 
         if (m_iconPaths[iconId] != filename)
         {
-            m_iconPaths[iconId]         = filename;
-            m_hasTopicChanged[iconId]   = true;
+            m_iconPaths[iconId] = filename;
+
+            notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
         }
 
         if (false == m_spriteSheetPaths->isEmpty())
@@ -455,8 +432,9 @@ bool ThreeIconPlugin::loadSpriteSheet(uint8_t iconId, const String& filename)
 
         if (m_spriteSheetPaths[iconId] != filename)
         {
-            m_spriteSheetPaths[iconId]  = filename;
-            m_hasTopicChanged[iconId]   = true;
+            m_spriteSheetPaths[iconId] = filename;
+
+            notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
         }
 
         if (false == m_iconPaths[iconId].isEmpty())
@@ -491,7 +469,7 @@ void ThreeIconPlugin::setIsForward(uint8_t iconId, bool state)
         {
             m_bitmapWidgets[iconId].setSpriteSheetForward(state);
 
-            m_hasTopicChanged[iconId] = true;
+            notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
         }
     }
 }
@@ -519,7 +497,7 @@ void ThreeIconPlugin::setIsRepeat(uint8_t iconId, bool state)
         {
             m_bitmapWidgets[iconId].setSpriteSheetRepeatInfinite(state);
 
-            m_hasTopicChanged[iconId] = true;
+            notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
         }
     }
 }
@@ -535,7 +513,7 @@ void ThreeIconPlugin::clearBitmap(uint8_t iconId)
             m_iconPaths[iconId].clear();
             m_bitmapWidgets[iconId].clear(ColorDef::BLACK);
 
-            m_hasTopicChanged[iconId] = true;
+            notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
         }
     }
 }
@@ -550,7 +528,7 @@ void ThreeIconPlugin::clearSpriteSheet(uint8_t iconId)
         {
             m_spriteSheetPaths[iconId].clear();
 
-            m_hasTopicChanged[iconId] = true;
+            notifyTopicChanged(String(TOPIC_ANIMATION) + "/" + iconId);
         }
 
         if (false == m_iconPaths[iconId].isEmpty())
@@ -78,8 +78,7 @@ public:
         m_iconPaths(),
         m_spriteSheetPaths(),
         m_isUploadError(false),
-        m_mutex(),
-        m_hasTopicChanged()
+        m_mutex()
     {
         (void)m_mutex.create();
     }
@@ -157,17 +156,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
     
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Is a upload request accepted or rejected?
      * 
@@ -343,7 +331,6 @@ private:
     String                  m_spriteSheetPaths[MAX_ICONS];  /**< Full path to spritesheets. */
     bool                    m_isUploadError;                /**< Flag to signal a upload error. */
     mutable MutexRecursive  m_mutex;                        /**< Mutex to protect against concurrent access. */
-    bool                    m_hasTopicChanged[MAX_ICONS];  /**< Has the topic content changed? */
 
     /**
      * Get image filename with path.
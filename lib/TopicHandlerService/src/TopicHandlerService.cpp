@@ -36,6 +36,7 @@
 #include "TopicHandlers.h"
 
 #include <Logging.h>
+#include <TrackedJsonDocument.hpp>
 
 /******************************************************************************
  * Compiler Switches
@@ -77,6 +78,12 @@ bool TopicHandlerService::start()
 
 void TopicHandlerService::stop()
 {
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        m_changedTopics.clear();
+    }
+
     m_onChangeTimer.stop();
 
     stopAllHandlers();
@@ -101,8 +108,15 @@ void TopicHandlerService::registerTopics(const String& deviceId, IPluginMaintena
         (nullptr != plugin))
     {
         const size_t        JSON_DOC_SIZE   = 1024U;
-        DynamicJsonDocument topicsDoc(JSON_DOC_SIZE);
+        TrackedJsonDocument topicsDoc(JSON_DOC_SIZE);
         JsonArray           jsonTopics      = topicsDoc.createNestedArray("topics");
+        String              entityIdByUid   = getEntityIdByPluginUid(plugin->getUID());
+        String              entityIdByAlias;
+
+        if (false == plugin->getAlias().isEmpty())
+        {
+            entityIdByAlias = getEntityIdByPluginAlias(plugin->getAlias());
+        }
 
         /* Get topics from plugin. */
         plugin->getTopics(jsonTopics);
@@ -158,17 +172,18 @@ void TopicHandlerService::registerTopics(const String& deviceId, IPluginMaintena
                     strToAccess(plugin, topicAccess, getTopicFunc, setTopicFunc, uploadReqFunc);
                     
                     /* Register plugin topic with plugin UID as entity id. */
-                    registerTopic(deviceId, getEntityIdByPluginUid(plugin->getUID()), topicName, extra, getTopicFunc, nullptr, setTopicFunc, uploadReqFunc);
+                    registerTopic(deviceId, entityIdByUid, topicName, extra, getTopicFunc, nullptr, setTopicFunc, uploadReqFunc);
 
                     /* Register plugin topic with plugin alias as entity id (if possible). */
-                    if (false == plugin->getAlias().isEmpty())
+                    if (false == entityIdByAlias.isEmpty())
                     {
-                        registerTopic(deviceId, getEntityIdByPluginAlias(plugin->getAlias()), topicName, extra, getTopicFunc, nullptr, setTopicFunc, uploadReqFunc);
+                        registerTopic(deviceId, entityIdByAlias, topicName, extra, getTopicFunc, nullptr, setTopicFunc, uploadReqFunc);
                     }
-
-                    addToPluginMetaDataList(deviceId, plugin, topicName);
                 }
             }
+
+            /* The plugin informs about its changed topics from now on. */
+            addPluginMetaData(deviceId, plugin);
         }
     }
 }
@@ -179,8 +194,18 @@ void TopicHandlerService::unregisterTopics(const String& deviceId, IPluginMainte
         (nullptr != plugin))
     {
         const size_t        JSON_DOC_SIZE   = 512U;
-        DynamicJsonDocument topicsDoc(JSON_DOC_SIZE);
+        TrackedJsonDocument topicsDoc(JSON_DOC_SIZE);
         JsonArray           jsonTopics      = topicsDoc.createNestedArray("topics");
+        String              entityIdByUid   = getEntityIdByPluginUid(plugin->getUID());
+        String              entityIdByAlias;
+
+        if (false == plugin->getAlias().isEmpty())
+        {
+            entityIdByAlias = getEntityIdByPluginAlias(plugin->getAlias());
+        }
+
+        /* Stop listening to topic changes and discard the not forwarded ones. */
+        removePluginMetaData(plugin);
 
         /* Get topics from plugin. */
         plugin->getTopics(jsonTopics);
@@ -216,15 +241,13 @@ void TopicHandlerService::unregisterTopics(const String& deviceId, IPluginMainte
                 if (false == topicName.isEmpty())
                 {
                     /* Unregister plugin topic with plugin UID as entity id. */
-                    unregisterTopic(deviceId, getEntityIdByPluginUid(plugin->getUID()), topicName);
+                    unregisterTopic(deviceId, entityIdByUid, topicName);
 
                     /* Unregister plugin topic with plugin UID as entity id (if possible). */
-                    if (false == plugin->getAlias().isEmpty())
+                    if (false == entityIdByAlias.isEmpty())
                     {
-                        unregisterTopic(deviceId, getEntityIdByPluginAlias(plugin->getAlias()), topicName);
+                        unregisterTopic(deviceId, entityIdByAlias, topicName);
                     }
-
-                    removeFromPluginMetaDataList(deviceId, plugin);
                 }
             }
         }
@@ -312,6 +335,18 @@ void TopicHandlerService::unregisterTopic(const String& deviceId, const String&
     }
 }
 
+void TopicHandlerService::notifyTopicChanged(const String& deviceId, const String& entityId, const String& topic)
+{
+    if ((false == deviceId.isEmpty()) &&
+        (false == entityId.isEmpty()) &&
+        (false == topic.isEmpty()))
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        addChangedTopic(nullptr, deviceId, entityId, topic);
+    }
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -425,75 +460,128 @@ void TopicHandlerService::removeFromTopicMetaDataList(const String& deviceId, co
     }
 }
 
-void TopicHandlerService::addToPluginMetaDataList(const String& deviceId, IPluginMaintenance* plugin, const String& topic)
+void TopicHandlerService::addPluginMetaData(const String& deviceId, IPluginMaintenance* plugin)
 {
     if ((false == deviceId.isEmpty()) &&
-        (nullptr != plugin) &&
-        (false == topic.isEmpty()))
+        (nullptr != plugin))
     {
-        PluginMetaData* pluginMetaData = new(std::nothrow) PluginMetaData();
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        PluginMetaData&             pluginMetaData  = m_pluginMetaDataMap[plugin];
+
+        /* Cache the entity ids, because they are needed for every topic change. */
+        pluginMetaData.deviceId         = deviceId;
+        pluginMetaData.entityIdByUid    = getEntityIdByPluginUid(plugin->getUID());
 
-        if (nullptr != pluginMetaData)
+        if (false == plugin->getAlias().isEmpty())
         {
-            pluginMetaData->deviceId    = deviceId;
-            pluginMetaData->plugin      = plugin;
-            pluginMetaData->topic       = topic;
+            pluginMetaData.entityIdByAlias = getEntityIdByPluginAlias(plugin->getAlias());
+        }
+        else
+        {
+            pluginMetaData.entityIdByAlias.clear();
+        }
+
+        plugin->setTopicChangeListener(this);
+    }
+}
+
+void TopicHandlerService::removePluginMetaData(IPluginMaintenance* plugin)
+{
+    if (nullptr != plugin)
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        ChangedTopicList::iterator  changedTopicsIt = m_changedTopics.begin();
+
+        plugin->setTopicChangeListener(nullptr);
+
+        (void)m_pluginMetaDataMap.erase(plugin);
 
-            m_pluginMetaDataList.push_back(pluginMetaData);
+        while(m_changedTopics.end() != changedTopicsIt)
+        {
+            if (plugin == changedTopicsIt->plugin)
+            {
+                changedTopicsIt = m_changedTopics.erase(changedTopicsIt);
+            }
+            else
+            {
+                ++changedTopicsIt;
+            }
         }
     }
 }
 
-void TopicHandlerService::removeFromPluginMetaDataList(const String& deviceId, IPluginMaintenance* plugin)
+void TopicHandlerService::onTopicChanged(IPluginMaintenance* plugin, const String& topic)
 {
-    PluginMetaDataList::iterator pluginMetaDataListIt = m_pluginMetaDataList.begin();
+    MutexGuard<MutexRecursive>          guard(m_mutex);
+    PluginMetaDataMap::const_iterator   it      = m_pluginMetaDataMap.find(plugin);
 
-    while(m_pluginMetaDataList.end() != pluginMetaDataListIt)
+    if ((m_pluginMetaDataMap.end() != it) &&
+        (false == topic.isEmpty()))
     {
-        PluginMetaData* pluginMetaData = *pluginMetaDataListIt;
+        const PluginMetaData& pluginMetaData = it->second;
 
-        if ((nullptr != pluginMetaData) &&
-            (deviceId == pluginMetaData->deviceId) &&
-            (plugin == pluginMetaData->plugin))
+        addChangedTopic(plugin, pluginMetaData.deviceId, pluginMetaData.entityIdByUid, topic);
+
+        if (false == pluginMetaData.entityIdByAlias.isEmpty())
         {
-            pluginMetaDataListIt = m_pluginMetaDataList.erase(pluginMetaDataListIt);
-            
-            delete pluginMetaData;
-            pluginMetaData = nullptr;
+            addChangedTopic(plugin, pluginMetaData.deviceId, pluginMetaData.entityIdByAlias, topic);
+        }
+    }
+}
+
+void TopicHandlerService::addChangedTopic(IPluginMaintenance* plugin, const String& deviceId, const String& entityId, const String& topic)
+{
+    ChangedTopicList::const_iterator    changedTopicsIt = m_changedTopics.begin();
+    bool                                isPending       = false;
+
+    /* A topic which changed several times is forwarded only once. */
+    while((false == isPending) && (m_changedTopics.end() != changedTopicsIt))
+    {
+        if ((topic == changedTopicsIt->topic) &&
+            (entityId == changedTopicsIt->entityId) &&
+            (deviceId == changedTopicsIt->deviceId))
+        {
+            isPending = true;
         }
         else
         {
-            ++pluginMetaDataListIt;
+            ++changedTopicsIt;
         }
     }
+
+    if (false == isPending)
+    {
+        ChangedTopic changedTopic;
+
+        changedTopic.plugin     = plugin;
+        changedTopic.deviceId   = deviceId;
+        changedTopic.entityId   = entityId;
+        changedTopic.topic      = topic;
+
+        m_changedTopics.push_back(changedTopic);
+    }
 }
 
 void TopicHandlerService::processOnChange()
 {
-    PluginMetaDataList::iterator    pluginMetaDataListIt    = m_pluginMetaDataList.begin();
+    ChangedTopicList                changedTopics;
+    ChangedTopicList::iterator      changedTopicsIt;
     TopicMetaDataList::iterator     topicMetaDataListIt     = m_topicMetaDataList.begin();
-    
-    /** Process all plugin related topics. */
-    while(m_pluginMetaDataList.end() != pluginMetaDataListIt)
-    {
-        PluginMetaData* pluginMetaData = *pluginMetaDataListIt;
 
-        if ((nullptr != pluginMetaData) &&
-            (nullptr != pluginMetaData->plugin) &&
-            (true == pluginMetaData->plugin->hasTopicChanged(pluginMetaData->topic)))
-        {
-            notifyAllHandlers(pluginMetaData->deviceId, getEntityIdByPluginUid(pluginMetaData->plugin->getUID()), pluginMetaData->topic);
+    /* Take the changed topics over, so the handlers can be informed without holding the lock. */
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
 
-            if (false == pluginMetaData->plugin->getAlias().isEmpty())
-            {
-                notifyAllHandlers(pluginMetaData->deviceId, getEntityIdByPluginAlias(pluginMetaData->plugin->getAlias()), pluginMetaData->topic);
-            }
-        }
+        changedTopics.swap(m_changedTopics);
+    }
 
-        ++pluginMetaDataListIt;
+    /** Process all changed topics. */
+    for(changedTopicsIt = changedTopics.begin(); changedTopicsIt != changedTopics.end(); ++changedTopicsIt)
+    {
+        notifyAllHandlers(changedTopicsIt->deviceId, changedTopicsIt->entityId, changedTopicsIt->topic);
     }
 
-    /** Proces all topics which are independent from plugins. */
+    /** Proces all topics which are independent from plugins and not pushed by their owner. */
     while(m_topicMetaDataList.end() != topicMetaDataListIt)
     {
         TopicMetaData* topicMetaData = *topicMetaDataListIt;
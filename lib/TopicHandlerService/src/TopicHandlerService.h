@@ -44,7 +44,9 @@
 #include <ITopicHandler.h>
 #include <IPluginMaintenance.hpp>
 #include <SimpleTimer.hpp>
+#include <Mutex.hpp>
 #include <vector>
+#include <unordered_map>
 
 /******************************************************************************
  * Compiler Switches
@@ -60,8 +62,12 @@
 
 /**
  * The topic handler service manages all topic handlers.
+ *
+ * Changed topics are pushed by their owners, e.g. a plugin informs via
+ * its topic change listener. Only the changed topics are forwarded to
+ * the topic handlers, instead of polling all registered topics.
  */
-class TopicHandlerService : public IService
+class TopicHandlerService : public IService, private ITopicChangeListener
 {
 public:
 
@@ -120,6 +126,7 @@ public:
      * @param[in] extra             Extra JSON parameters for concrete topic handlers, which are pushed through.
      * @param[in] getTopicFunc      Function which is called to read the topic.
      * @param[in] hasChangedFunc    Function which is periodically called to check whether the topic has changed.
+     *                              Not necessary, if the topic owner calls notifyTopicChanged().
      * @param[in] setTopicFunc      Function which is called to set the topic.
      * @param[in] uploadReqFunc     Function which is called to accept a file upload or not.
      */
@@ -134,6 +141,16 @@ public:
      */
     void unregisterTopic(const String& deviceId, const String& entityId, const String& topic);
 
+    /**
+     * Notify about a changed topic content. The topic handlers are informed
+     * later in the context of the service.
+     * 
+     * @param[in] deviceId  The device id which represents the physical device.
+     * @param[in] entityId  The entity id which represents the entity of the device.
+     * @param[in] topic     The topic which content changed.
+     */
+    void notifyTopicChanged(const String& deviceId, const String& entityId, const String& topic);
+
 private:
 
     /** Default topic accessibility. */
@@ -170,43 +187,77 @@ private:
     typedef std::vector<TopicMetaData*>   TopicMetaDataList;
 
     /**
-     * Plugin meta data, used to determine whether publishing
-     * of a topic shall take place or not.
+     * Plugin meta data, used to forward changed plugin topics
+     * without building the entity ids again.
      */
     struct PluginMetaData
     {
-        String              deviceId;   /**< Id of the device this data is related to. */
-        IPluginMaintenance* plugin;     /**< Plugin which topics are handled. */
-        String              topic;      /**< The topic this data is related to. */
+        String  deviceId;           /**< Id of the device this data is related to. */
+        String  entityIdByUid;      /**< Entity id, based on the plugin UID. */
+        String  entityIdByAlias;    /**< Entity id, based on the plugin alias. Empty if plugin has no alias. */
 
         /**
-         * Construct topic meta data instance.
+         * Construct plugin meta data instance.
          */
         PluginMetaData() :
+            deviceId(),
+            entityIdByUid(),
+            entityIdByAlias()
+        {
+        }
+    };
+
+    /**
+     * Plugin meta data by plugin.
+     */
+    typedef std::unordered_map<IPluginMaintenance*, PluginMetaData> PluginMetaDataMap;
+
+    /**
+     * A changed topic, which the topic handlers shall be informed about.
+     */
+    struct ChangedTopic
+    {
+        IPluginMaintenance* plugin;     /**< Plugin which topic changed or nullptr if its not a plugin topic. */
+        String              deviceId;   /**< Id of the device this topic is related to. */
+        String              entityId;   /**< Id of the entity this topic is related to. */
+        String              topic;      /**< The topic which content changed. */
+
+        /**
+         * Construct changed topic instance.
+         */
+        ChangedTopic() :
             plugin(nullptr),
+            deviceId(),
+            entityId(),
             topic()
         {
         }
     };
 
     /**
-     * List of plugin meta data.
+     * List of changed topics.
      */
-    typedef std::vector<PluginMetaData*>    PluginMetaDataList;
+    typedef std::vector<ChangedTopic>   ChangedTopicList;
 
-    TopicMetaDataList   m_topicMetaDataList;    /**< List of readable topics and the required meta data. */
-    PluginMetaDataList  m_pluginMetaDataList;   /**< List of plugins, which topics are handled. */
-    SimpleTimer         m_onChangeTimer;        /**< Timer for on change processing period. */
+    mutable MutexRecursive  m_mutex;                /**< Protects the plugin meta data and the changed topics against concurrent access. */
+    TopicMetaDataList       m_topicMetaDataList;    /**< List of readable topics and the required meta data. */
+    PluginMetaDataMap       m_pluginMetaDataMap;    /**< Plugins, which topics are handled. */
+    ChangedTopicList        m_changedTopics;        /**< Changed topics, which are not forwarded to the topic handlers yet. */
+    SimpleTimer             m_onChangeTimer;        /**< Timer for on change processing period. */
 
     /**
      * Constructs the service instance.
      */
     TopicHandlerService() :
         IService(),
+        ITopicChangeListener(),
+        m_mutex(),
         m_topicMetaDataList(),
-        m_pluginMetaDataList(),
+        m_pluginMetaDataMap(),
+        m_changedTopics(),
         m_onChangeTimer()
     {
+        (void)m_mutex.create();
     }
 
     /**
@@ -270,25 +321,45 @@ private:
     void removeFromTopicMetaDataList(const String& deviceId, const String& entityId, const String& topic);
 
     /**
-     * Add plugin meta data to list of automatic publishing on change.
+     * Add plugin meta data for automatic publishing on change and
+     * listen to its topic changes.
      * 
      * @param[in] deviceId  The device id which represents the physical device.
      * @param[in] plugin    The related plugin.
-     * @param[in] topic     The topic name.
      */
-    void addToPluginMetaDataList(const String& deviceId, IPluginMaintenance* plugin, const String& topic);
+    void addPluginMetaData(const String& deviceId, IPluginMaintenance* plugin);
 
     /**
-     * Remove plugin meta data from list of automatic publishing on change.
+     * Remove plugin meta data from automatic publishing on change and
+     * stop listening to its topic changes.
      * 
-     * @param[in] deviceId  The device id which represents the physical device.
      * @param[in] plugin    The related plugin.
      */
-    void removeFromPluginMetaDataList(const String& deviceId, IPluginMaintenance* plugin);
+    void removePluginMetaData(IPluginMaintenance* plugin);
+
+    /**
+     * The topic content of the plugin changed.
+     * It is called in the context of the plugin.
+     *
+     * @param[in] plugin    The plugin, which topic content changed.
+     * @param[in] topic     The topic, which content changed.
+     */
+    void onTopicChanged(IPluginMaintenance* plugin, const String& topic) final;
+
+    /**
+     * Add a topic to the changed topics, if its not already there.
+     * The mutex must be taken by the caller.
+     *
+     * @param[in] plugin    The plugin, which topic content changed or nullptr.
+     * @param[in] deviceId  The device id which represents the physical device.
+     * @param[in] entityId  The entity id which represents the entity of the device.
+     * @param[in] topic     The topic which content changed.
+     */
+    void addChangedTopic(IPluginMaintenance* plugin, const String& deviceId, const String& entityId, const String& topic);
 
     /**
-     * Process all plugin topics to check which one has changed.
-     * For every changed one, notify the handlers about.
+     * Forward all changed topics to the handlers and check the topics,
+     * which are not pushed by their owners.
      */
     void processOnChange();
 
@@ -0,0 +1,162 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Configuration change notifier
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ConfigChangeNotifier.h"
+#include "ConfigSnapshot.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Protect the registrations against concurrent access for the rest of the scope. */
+#define CONFIG_CHANGE_NOTIFIER_LOCK()   MutexGuard<MutexRecursive> guard(m_mutex)
+
+#else   /* NATIVE */
+
+/** The native test environment runs single threaded. */
+#define CONFIG_CHANGE_NOTIFIER_LOCK()
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool ConfigChangeNotifier::registerListener(const String& fullPath, Listener* listener)
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != listener) &&
+        (false == fullPath.isEmpty()))
+    {
+        Registration registration;
+        CONFIG_CHANGE_NOTIFIER_LOCK();
+
+        registration.fullPath = fullPath;
+        registration.listener = listener;
+
+        m_registrations.push_back(registration);
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void ConfigChangeNotifier::unregisterListener(Listener* listener)
+{
+    RegistrationList::iterator  it;
+    CONFIG_CHANGE_NOTIFIER_LOCK();
+
+    it = m_registrations.begin();
+
+    while(m_registrations.end() != it)
+    {
+        if (listener == it->listener)
+        {
+            it = m_registrations.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ConfigChangeNotifier::notify(const String& fullPath)
+{
+    RegistrationList::iterator  it;
+    CONFIG_CHANGE_NOTIFIER_LOCK();
+
+    /* The snapshot in RAM doesn't reflect the file anymore. */
+    ConfigSnapshot::getInstance().invalidate(fullPath);
+
+    for(it = m_registrations.begin(); it != m_registrations.end(); ++it)
+    {
+        if (fullPath == it->fullPath)
+        {
+            it->listener->onConfigChanged(fullPath);
+        }
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ConfigChangeNotifier::ConfigChangeNotifier() :
+#ifndef NATIVE
+    m_mutex(),
+#endif  /* NATIVE */
+    m_registrations()
+{
+#ifndef NATIVE
+    (void)m_mutex.create();
+#endif  /* NATIVE */
+}
+
+ConfigChangeNotifier::~ConfigChangeNotifier()
+{
+    /* Never called. */
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,181 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Configuration change notifier
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef CONFIG_CHANGE_NOTIFIER_H
+#define CONFIG_CHANGE_NOTIFIER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <vector>
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The configuration change notifier informs the owner of a configuration file
+ * immediately, if the file is written or removed by someone else. This way
+ * the owner doesn't need to poll the filesystem for changes.
+ *
+ * Everyone who writes or removes files in the filesystem shall call notify().
+ * The listener is called in the context of the writer, therefore it shall
+ * only remember the change and handle it later in its own context.
+ */
+class ConfigChangeNotifier
+{
+public:
+
+    /**
+     * The listener is informed about changes of its configuration file.
+     */
+    class Listener
+    {
+    public:
+
+        /**
+         * Destroys the listener.
+         */
+        virtual ~Listener()
+        {
+        }
+
+        /**
+         * Configuration file was written or removed.
+         *
+         * @param[in] fullPath  Full path of the configuration file
+         */
+        virtual void onConfigChanged(const String& fullPath) = 0;
+
+    protected:
+
+        /**
+         * Constructs the listener.
+         */
+        Listener()
+        {
+        }
+    };
+
+    /**
+     * Get the configuration change notifier instance.
+     *
+     * @return Configuration change notifier instance
+     */
+    static ConfigChangeNotifier& getInstance()
+    {
+        static ConfigChangeNotifier instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Register a listener for a configuration file.
+     *
+     * @param[in] fullPath  Full path of the configuration file
+     * @param[in] listener  Listener, which to inform about changes
+     *
+     * @return If successful registered, it will return true otherwise false.
+     */
+    bool registerListener(const String& fullPath, Listener* listener);
+
+    /**
+     * Unregister the listener from all configuration files.
+     *
+     * @param[in] listener  Listener, which to unregister
+     */
+    void unregisterListener(Listener* listener);
+
+    /**
+     * Notify about a written or removed file. Only the listeners of this
+     * file are informed. A snapshot of the file in RAM is invalidated.
+     *
+     * @param[in] fullPath  Full path of the file
+     */
+    void notify(const String& fullPath);
+
+private:
+
+    /**
+     * A listener registration.
+     */
+    struct Registration
+    {
+        String      fullPath;   /**< Full path of the configuration file */
+        Listener*   listener;   /**< Listener of the configuration file */
+    };
+
+    /** List of listener registrations */
+    typedef std::vector<Registration> RegistrationList;
+
+#ifndef NATIVE
+    mutable MutexRecursive  m_mutex;            /**< Used to protect against concurrent access. */
+#endif  /* NATIVE */
+    RegistrationList        m_registrations;    /**< Listener registrations */
+
+    /**
+     * Constructs the configuration change notifier.
+     */
+    ConfigChangeNotifier();
+
+    /**
+     * Destroys the configuration change notifier.
+     */
+    ~ConfigChangeNotifier();
+
+    ConfigChangeNotifier(const ConfigChangeNotifier& notifier);
+    ConfigChangeNotifier& operator=(const ConfigChangeNotifier& notifier);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* CONFIG_CHANGE_NOTIFIER_H */
+
+/** @} */
@@ -0,0 +1,241 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Configuration snapshot
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ConfigSnapshot.h"
+
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Protect the snapshots against concurrent access for the rest of the scope. */
+#define CONFIG_SNAPSHOT_LOCK()  MutexGuard<MutexRecursive> guard(m_mutex)
+
+#else   /* NATIVE */
+
+/** The native test environment runs single threaded. */
+#define CONFIG_SNAPSHOT_LOCK()
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool ConfigSnapshot::get(const String& fullPath, JsonDocument& doc) const
+{
+    bool                        isSuccessful    = false;
+    bool                        isFound         = false;
+    String                      basePath        = getBasePath(fullPath);
+    EntryList::const_iterator   it;
+    CONFIG_SNAPSHOT_LOCK();
+
+    it = m_entries.begin();
+
+    while((m_entries.end() != it) && (false == isFound))
+    {
+        if (basePath == it->basePath)
+        {
+            isFound = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (true == isFound)
+    {
+        /* Deserialize from a const buffer, otherwise ArduinoJson would
+         * modify the snapshot in zero-copy mode.
+         */
+        const char*             input   = reinterpret_cast<const char*>(it->data);
+        DeserializationError    error   = deserializeMsgPack(doc, input, it->size);
+
+        if (DeserializationError::Ok == error.code())
+        {
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void ConfigSnapshot::put(const String& fullPath, const JsonDocument& doc)
+{
+    String  basePath    = getBasePath(fullPath);
+    size_t  size        = measureMsgPack(doc);
+    CONFIG_SNAPSHOT_LOCK();
+
+    remove(basePath);
+
+    if ((0U < size) &&
+        (MEMORY_LIMIT >= (m_memoryUsage + size)))
+    {
+        uint8_t* data = new(std::nothrow) uint8_t[size];
+
+        if (nullptr != data)
+        {
+            if (size != serializeMsgPack(doc, reinterpret_cast<char*>(data), size))
+            {
+                delete[] data;
+            }
+            else
+            {
+                Entry entry;
+
+                entry.basePath  = basePath;
+                entry.data      = data;
+                entry.size      = size;
+
+                m_entries.push_back(entry);
+                m_memoryUsage += size;
+            }
+        }
+    }
+}
+
+void ConfigSnapshot::invalidate(const String& fullPath)
+{
+    CONFIG_SNAPSHOT_LOCK();
+
+    remove(getBasePath(fullPath));
+}
+
+void ConfigSnapshot::clear()
+{
+    EntryList::iterator it;
+    CONFIG_SNAPSHOT_LOCK();
+
+    for(it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        delete[] it->data;
+    }
+
+    m_entries.clear();
+    m_memoryUsage = 0U;
+}
+
+String ConfigSnapshot::getBasePath(const String& fullPath)
+{
+    int     dotIndex    = fullPath.lastIndexOf('.');
+    int     slashIndex  = fullPath.lastIndexOf('/');
+    String  basePath;
+
+    /* A dot in a directory name is not an extension. */
+    if (slashIndex < dotIndex)
+    {
+        basePath = fullPath.substring(0, dotIndex);
+    }
+    else
+    {
+        basePath = fullPath;
+    }
+
+    return basePath;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ConfigSnapshot::ConfigSnapshot() :
+#ifndef NATIVE
+    m_mutex(),
+#endif  /* NATIVE */
+    m_entries(),
+    m_memoryUsage(0U)
+{
+#ifndef NATIVE
+    (void)m_mutex.create();
+#endif  /* NATIVE */
+}
+
+ConfigSnapshot::~ConfigSnapshot()
+{
+    clear();
+}
+
+void ConfigSnapshot::remove(const String& basePath)
+{
+    EntryList::iterator it      = m_entries.begin();
+    bool                isFound = false;
+
+    while((m_entries.end() != it) && (false == isFound))
+    {
+        if (basePath == it->basePath)
+        {
+            m_memoryUsage -= it->size;
+            delete[] it->data;
+
+            (void)m_entries.erase(it);
+            isFound = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
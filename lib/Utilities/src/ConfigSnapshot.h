@@ -0,0 +1,200 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Configuration snapshot
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef CONFIG_SNAPSHOT_H
+#define CONFIG_SNAPSHOT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef CONFIG_CONFIG_SNAPSHOT_MEMORY_LIMIT
+
+/**
+ * Max. memory in byte, which is used by all configuration snapshots together.
+ * A configuration, which doesn't fit anymore, is simply not kept in RAM.
+ */
+#define CONFIG_CONFIG_SNAPSHOT_MEMORY_LIMIT (8192U)
+
+#endif  /* CONFIG_CONFIG_SNAPSHOT_MEMORY_LIMIT */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <vector>
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The configuration snapshot keeps the content of configuration files in RAM,
+ * serialized as MessagePack. Loading a configuration from the snapshot avoids
+ * the filesystem access and is faster to parse than the pretty printed JSON
+ * file.
+ *
+ * A snapshot is invalidated by the configuration change notifier, whenever the
+ * file is written or removed. Files with the same path and name, but a
+ * different extension are considered as the same configuration, because the
+ * configuration may be stored as JSON or as MessagePack.
+ */
+class ConfigSnapshot
+{
+public:
+
+    /**
+     * Get the configuration snapshot instance.
+     *
+     * @return Configuration snapshot instance
+     */
+    static ConfigSnapshot& getInstance()
+    {
+        static ConfigSnapshot instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Get configuration from its snapshot.
+     *
+     * @param[in]   fullPath    Full path of the configuration file
+     * @param[out]  doc         JSON document, which shall contain the configuration.
+     *
+     * @return If a valid snapshot is available, it will return true otherwise false.
+     */
+    bool get(const String& fullPath, JsonDocument& doc) const;
+
+    /**
+     * Take a snapshot of the configuration. An older snapshot is replaced.
+     * If the memory limit would be exceeded, no snapshot is kept.
+     *
+     * @param[in] fullPath  Full path of the configuration file
+     * @param[in] doc       JSON document with the configuration
+     */
+    void put(const String& fullPath, const JsonDocument& doc);
+
+    /**
+     * Invalidate the snapshot of a configuration file.
+     *
+     * @param[in] fullPath  Full path of the configuration file, the extension doesn't matter.
+     */
+    void invalidate(const String& fullPath);
+
+    /**
+     * Invalidate all snapshots.
+     */
+    void clear();
+
+    /**
+     * Get the memory in byte, which is used by all snapshots.
+     *
+     * @return Used memory in byte
+     */
+    size_t getMemoryUsage() const
+    {
+        return m_memoryUsage;
+    }
+
+    /**
+     * Get the full path of a file without its extension.
+     *
+     * @param[in] fullPath  Full path of the file
+     *
+     * @return Full path without extension
+     */
+    static String getBasePath(const String& fullPath);
+
+    /** Max. memory in byte, which is used by all snapshots together. */
+    static const size_t MEMORY_LIMIT    = CONFIG_CONFIG_SNAPSHOT_MEMORY_LIMIT;
+
+private:
+
+    /**
+     * A configuration snapshot.
+     */
+    struct Entry
+    {
+        String      basePath;   /**< Full path of the configuration file without extension */
+        uint8_t*    data;       /**< Configuration serialized as MessagePack */
+        size_t      size;       /**< Size of the serialized configuration in byte */
+    };
+
+    /** List of configuration snapshots */
+    typedef std::vector<Entry> EntryList;
+
+#ifndef NATIVE
+    mutable MutexRecursive  m_mutex;        /**< Used to protect against concurrent access. */
+#endif  /* NATIVE */
+    EntryList               m_entries;      /**< Configuration snapshots */
+    size_t                  m_memoryUsage;  /**< Memory in byte, used by all snapshots */
+
+    /**
+     * Constructs the configuration snapshot.
+     */
+    ConfigSnapshot();
+
+    /**
+     * Destroys the configuration snapshot.
+     */
+    ~ConfigSnapshot();
+
+    ConfigSnapshot(const ConfigSnapshot& snapshot);
+    ConfigSnapshot& operator=(const ConfigSnapshot& snapshot);
+
+    /**
+     * Remove the snapshot and release its memory.
+     *
+     * @param[in] basePath  Full path of the configuration file without extension
+     */
+    void remove(const String& basePath);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* CONFIG_SNAPSHOT_H */
+
+/** @} */
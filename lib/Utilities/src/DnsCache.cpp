@@ -0,0 +1,177 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DnsCache.h"
+
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+DnsCache::DnsCache() :
+    m_entries()
+{
+    clear();
+}
+
+DnsCache::~DnsCache()
+{
+}
+
+bool DnsCache::find(const String& hostname, uint32_t& ipAddress) const
+{
+    bool    isFound = false;
+    size_t  index   = findEntry(hostname);
+
+    if (MAX_ENTRIES > index)
+    {
+        const Entry& entry = m_entries[index];
+
+        if (TIMEOUT > (millis() - entry.timestamp))
+        {
+            ipAddress   = entry.ipAddress;
+            isFound     = true;
+        }
+    }
+
+    return isFound;
+}
+
+void DnsCache::add(const String& hostname, uint32_t ipAddress)
+{
+    uint32_t    now     = millis();
+    size_t      index   = findEntry(hostname);
+
+    /* Use a free or the oldest entry. */
+    if (MAX_ENTRIES <= index)
+    {
+        size_t idx = 0U;
+
+        index = 0U;
+
+        while((MAX_ENTRIES > idx) && (false == m_entries[index].hostname.isEmpty()))
+        {
+            if (true == m_entries[idx].hostname.isEmpty())
+            {
+                index = idx;
+            }
+            else if ((now - m_entries[index].timestamp) < (now - m_entries[idx].timestamp))
+            {
+                index = idx;
+            }
+            else
+            {
+                ;
+            }
+
+            ++idx;
+        }
+    }
+
+    m_entries[index].hostname   = hostname;
+    m_entries[index].ipAddress  = ipAddress;
+    m_entries[index].timestamp  = now;
+}
+
+void DnsCache::invalidate(const String& hostname)
+{
+    size_t index = findEntry(hostname);
+
+    if (MAX_ENTRIES > index)
+    {
+        m_entries[index].hostname.clear();
+    }
+}
+
+void DnsCache::clear()
+{
+    size_t index = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        m_entries[index].hostname.clear();
+        m_entries[index].ipAddress  = 0U;
+        m_entries[index].timestamp  = 0U;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+size_t DnsCache::findEntry(const String& hostname) const
+{
+    size_t index = 0U;
+
+    while((MAX_ENTRIES > index) &&
+          ((true == m_entries[index].hostname.isEmpty()) ||
+           (0U == m_entries[index].hostname.equalsIgnoreCase(hostname))))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
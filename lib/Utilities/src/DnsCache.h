@@ -0,0 +1,151 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <WString.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The DNS cache keeps resolved hostnames for a while, to avoid resolving
+ * them again for every request. If the cache is full, the oldest entry is
+ * replaced.
+ *
+ * The IPv4 address is stored in network byte order, like the IPAddress
+ * conversion to uint32_t provides it.
+ *
+ * The cache is not protected against concurrent access, this is up to the
+ * user.
+ */
+class DnsCache
+{
+public:
+
+    /**
+     * Constructs an empty DNS cache.
+     */
+    DnsCache();
+
+    /**
+     * Destroys the DNS cache.
+     */
+    ~DnsCache();
+
+    /**
+     * Find a resolved hostname, which is not expired.
+     *
+     * @param[in]   hostname    Hostname
+     * @param[out]  ipAddress   Resolved IPv4 address
+     *
+     * @return If found, it will return true otherwise false.
+     */
+    bool find(const String& hostname, uint32_t& ipAddress) const;
+
+    /**
+     * Add a resolved hostname. An already cached one is updated.
+     *
+     * @param[in] hostname  Hostname
+     * @param[in] ipAddress Resolved IPv4 address
+     */
+    void add(const String& hostname, uint32_t ipAddress);
+
+    /**
+     * Remove a hostname, e.g. because the server may have a new IP-address.
+     *
+     * @param[in] hostname  Hostname
+     */
+    void invalidate(const String& hostname);
+
+    /**
+     * Remove all hostnames.
+     */
+    void clear();
+
+    /** Max. number of cached resolved hostnames. */
+    static const size_t     MAX_ENTRIES = 8U;
+
+    /** A resolved hostname is cached for this period in ms. */
+    static const uint32_t   TIMEOUT     = 600000U;
+
+private:
+
+    /**
+     * A cached resolved hostname.
+     */
+    struct Entry
+    {
+        String      hostname;   /**< Hostname, empty if entry is not used. */
+        uint32_t    ipAddress;  /**< Resolved IPv4 address */
+        uint32_t    timestamp;  /**< Timestamp in ms when it was resolved */
+    };
+
+    Entry   m_entries[MAX_ENTRIES]; /**< Resolved hostnames */
+
+    DnsCache(const DnsCache& cache);
+    DnsCache& operator=(const DnsCache& cache);
+
+    /**
+     * Find the entry of the hostname, independent of its age.
+     *
+     * @param[in] hostname  Hostname
+     *
+     * @return Entry index. If not found, it will return MAX_ENTRIES.
+     */
+    size_t findEntry(const String& hostname) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* DNS_CACHE_H */
+
+/** @} */
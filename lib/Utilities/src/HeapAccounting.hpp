@@ -0,0 +1,313 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap accounting per subsystem
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef HEAP_ACCOUNTING_HPP
+#define HEAP_ACCOUNTING_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Heap accounting, which tracks the dynamic memory of the subsystems by tag.
+ * The allocation sites report their allocations and releases explicitly.
+ * All methods are lock-free and can be called from any task.
+ */
+class HeapAccounting
+{
+public:
+
+    /**
+     * Subsystem tags.
+     */
+    enum Tag
+    {
+        TAG_GFX = 0,    /**< Graphic buffers, e.g. bitmaps and framebuffers. */
+        TAG_HTTP,       /**< HTTP payloads */
+        TAG_JSON,       /**< JSON documents */
+        TAG_PLUGIN,     /**< Plugin instances */
+        TAG_WEBSOCKET,  /**< Websocket message queues */
+        TAG_MAX         /**< Number of tags */
+    };
+
+    /**
+     * Statistics of a single tag.
+     */
+    struct Stats
+    {
+        size_t      current;        /**< Currently allocated memory in byte. */
+        size_t      peak;           /**< High-water mark of allocated memory in byte. */
+        uint32_t    allocations;    /**< Number of successful allocations. */
+        uint32_t    failures;       /**< Number of failed allocations. */
+        size_t      lastFailedSize; /**< Requested size of the last failed allocation in byte. */
+    };
+
+    /**
+     * Get heap accounting instance.
+     *
+     * @return Heap accounting instance
+     */
+    static HeapAccounting& getInstance()
+    {
+        static HeapAccounting instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Report a successful allocation.
+     *
+     * @param[in] tag   Subsystem tag
+     * @param[in] size  Allocated size in byte
+     */
+    void allocated(Tag tag, size_t size)
+    {
+        if (TAG_MAX > tag)
+        {
+            Counters&   counters    = m_counters[tag];
+            size_t      current     = counters.current.fetch_add(size) + size;
+            size_t      peak        = counters.peak.load();
+
+            /* Update the high-water mark, if no other task raised it meanwhile. */
+            while ((current > peak) &&
+                   (false == counters.peak.compare_exchange_weak(peak, current)))
+            {
+                ;
+            }
+
+            counters.allocations.fetch_add(1U);
+        }
+    }
+
+    /**
+     * Report a release of previously allocated memory.
+     *
+     * @param[in] tag   Subsystem tag
+     * @param[in] size  Released size in byte
+     */
+    void released(Tag tag, size_t size)
+    {
+        if (TAG_MAX > tag)
+        {
+            (void)m_counters[tag].current.fetch_sub(size);
+        }
+    }
+
+    /**
+     * Report a failed allocation.
+     *
+     * @param[in] tag   Subsystem tag
+     * @param[in] size  Requested size in byte
+     */
+    void failed(Tag tag, size_t size)
+    {
+        if (TAG_MAX > tag)
+        {
+            m_counters[tag].failures.fetch_add(1U);
+            m_counters[tag].lastFailedSize.store(size);
+        }
+    }
+
+    /**
+     * Report the result of an allocation. Convenience method, which calls
+     * allocated() or failed() depended on the allocated pointer.
+     *
+     * @param[in] tag   Subsystem tag
+     * @param[in] ptr   Allocated memory or nullptr
+     * @param[in] size  Requested size in byte
+     */
+    void track(Tag tag, const void* ptr, size_t size)
+    {
+        if (nullptr == ptr)
+        {
+            failed(tag, size);
+        }
+        else
+        {
+            allocated(tag, size);
+        }
+    }
+
+    /**
+     * Get statistics of a tag.
+     *
+     * @param[in]   tag     Subsystem tag
+     * @param[out]  stats   Statistics
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool getStats(Tag tag, Stats& stats) const
+    {
+        bool isSuccessful = false;
+
+        if (TAG_MAX > tag)
+        {
+            const Counters& counters = m_counters[tag];
+
+            stats.current           = counters.current.load();
+            stats.peak              = counters.peak.load();
+            stats.allocations       = counters.allocations.load();
+            stats.failures          = counters.failures.load();
+            stats.lastFailedSize    = counters.lastFailedSize.load();
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Reset the high-water marks to the currently allocated memory.
+     */
+    void resetPeaks()
+    {
+        uint8_t idx = 0U;
+
+        while (TAG_MAX > idx)
+        {
+            m_counters[idx].peak.store(m_counters[idx].current.load());
+            ++idx;
+        }
+    }
+
+    /**
+     * Get tag name.
+     *
+     * @param[in] tag   Subsystem tag
+     *
+     * @return Tag name
+     */
+    static const char* tagToStr(Tag tag)
+    {
+        const char* str = "unknown";
+
+        switch (tag)
+        {
+        case TAG_GFX:
+            str = "gfx";
+            break;
+
+        case TAG_HTTP:
+            str = "http";
+            break;
+
+        case TAG_JSON:
+            str = "json";
+            break;
+
+        case TAG_PLUGIN:
+            str = "plugin";
+            break;
+
+        case TAG_WEBSOCKET:
+            str = "websocket";
+            break;
+
+        default:
+            break;
+        }
+
+        return str;
+    }
+
+private:
+
+    /**
+     * Counters of a single tag.
+     */
+    struct Counters
+    {
+        std::atomic<size_t>     current;        /**< Currently allocated memory in byte. */
+        std::atomic<size_t>     peak;           /**< High-water mark of allocated memory in byte. */
+        std::atomic<uint32_t>   allocations;    /**< Number of successful allocations. */
+        std::atomic<uint32_t>   failures;       /**< Number of failed allocations. */
+        std::atomic<size_t>     lastFailedSize; /**< Requested size of the last failed allocation in byte. */
+    };
+
+    Counters    m_counters[TAG_MAX];    /**< Counters per tag. */
+
+    /**
+     * Constructs the heap accounting.
+     */
+    HeapAccounting() :
+        m_counters()
+    {
+        uint8_t idx = 0U;
+
+        while (TAG_MAX > idx)
+        {
+            m_counters[idx].current.store(0U);
+            m_counters[idx].peak.store(0U);
+            m_counters[idx].allocations.store(0U);
+            m_counters[idx].failures.store(0U);
+            m_counters[idx].lastFailedSize.store(0U);
+            ++idx;
+        }
+    }
+
+    /**
+     * Destroys the heap accounting.
+     */
+    ~HeapAccounting()
+    {
+        /* Will never be called. */
+    }
+
+    HeapAccounting(const HeapAccounting& accounting);
+    HeapAccounting& operator=(const HeapAccounting& accounting);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HEAP_ACCOUNTING_HPP */
+
+/** @} */
@@ -0,0 +1,847 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP response cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpCache.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+#include <HeapAccounting.hpp>
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+#include <FileSystem.h>
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Protect the cache against concurrent access for the rest of the scope. */
+#define HTTP_CACHE_LOCK()   MutexGuard<MutexRecursive> guard(m_mutex)
+
+#else   /* NATIVE */
+
+/** The native test environment runs single threaded. */
+#define HTTP_CACHE_LOCK()
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+HttpCache::Writer::Writer() :
+    m_data(nullptr),
+    m_capacity(0U),
+    m_size(0U),
+    m_isValid(false)
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+    ,
+    m_fd(),
+    m_fileName()
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+{
+}
+
+HttpCache::Writer::~Writer()
+{
+    abort();
+}
+
+bool HttpCache::Writer::begin(size_t expectedSize)
+{
+    abort();
+
+    /* A payload which can't be cached, is not collected at all. */
+    if (MAX_ENTRY_SIZE >= expectedSize)
+    {
+        m_isValid = true;
+
+        if (0U == expectedSize)
+        {
+            ;
+        }
+        else if (MAX_MEMORY_ENTRY_SIZE >= expectedSize)
+        {
+            m_isValid = reserve(expectedSize);
+        }
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+        else
+        {
+            m_isValid = spill();
+        }
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+    }
+
+    return m_isValid;
+}
+
+bool HttpCache::Writer::write(const uint8_t* data, size_t size)
+{
+    if ((true == m_isValid) &&
+        (nullptr != data) &&
+        (0U < size))
+    {
+        bool    isSuccessful    = false;
+        bool    isInFile        = false;
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+        /* Continue in the filesystem, as soon as the payload doesn't fit into memory anymore. */
+        if ((true == m_fileName.isEmpty()) &&
+            (MAX_MEMORY_ENTRY_SIZE < (m_size + size)) &&
+            (MAX_ENTRY_SIZE >= (m_size + size)))
+        {
+            (void)spill();
+        }
+
+        isInFile = (false == m_fileName.isEmpty());
+
+        if ((true == isInFile) &&
+            (MAX_ENTRY_SIZE >= (m_size + size)))
+        {
+            isSuccessful = (size == m_fd.write(data, size));
+        }
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+        if ((false == isInFile) &&
+            (true == reserve(size)))
+        {
+            memcpy(&m_data[m_size], data, size);
+            isSuccessful = true;
+        }
+
+        if (false == isSuccessful)
+        {
+            abort();
+        }
+        else
+        {
+            m_size += size;
+        }
+    }
+
+    return m_isValid;
+}
+
+void HttpCache::Writer::abort()
+{
+    releaseBuffer();
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+    removeFile();
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+    m_size      = 0U;
+    m_isValid   = false;
+}
+
+bool HttpCache::isFresh(const String& url)
+{
+    bool    isFresh = false;
+    HTTP_CACHE_LOCK();
+    size_t  index   = find(url);
+
+    if (MAX_ENTRIES > index)
+    {
+        const Entry& entry = m_entries[index];
+
+        isFresh = (entry.maxAge > (millis() - entry.timestamp));
+    }
+
+    return isFresh;
+}
+
+bool HttpCache::getValidators(const String& url, String& eTag, String& lastModified)
+{
+    bool    isCached    = false;
+    HTTP_CACHE_LOCK();
+    size_t  index       = find(url);
+
+    if (MAX_ENTRIES > index)
+    {
+        eTag            = m_entries[index].eTag;
+        lastModified    = m_entries[index].lastModified;
+        isCached        = true;
+    }
+
+    return isCached;
+}
+
+bool HttpCache::read(const String& url, const OnData& onData)
+{
+    bool    isSuccessful    = false;
+    HTTP_CACHE_LOCK();
+    size_t  index           = find(url);
+
+    if ((MAX_ENTRIES > index) &&
+        (nullptr != onData))
+    {
+        Entry& entry = m_entries[index];
+
+        entry.lastUsed = millis();
+
+        if (false == entry.isSpilled)
+        {
+            onData(entry.data, entry.size);
+            isSuccessful = true;
+        }
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+        else
+        {
+            File fd = FILESYSTEM.open(getSpillFileName(index), "r");
+
+            if (false == fd)
+            {
+                LOG_WARNING("Couldn't open spilled response of %s.", url.c_str());
+            }
+            else
+            {
+                uint8_t buffer[READ_CHUNK_SIZE];
+                size_t  available   = entry.size;
+
+                while(0U < available)
+                {
+                    size_t  chunkSize   = (READ_CHUNK_SIZE < available) ? READ_CHUNK_SIZE : available;
+                    size_t  readSize    = fd.read(buffer, chunkSize);
+
+                    if (0U == readSize)
+                    {
+                        break;
+                    }
+
+                    onData(buffer, readSize);
+                    available -= readSize;
+                }
+
+                fd.close();
+
+                isSuccessful = (0U == available);
+            }
+        }
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+        /* Don't provide the broken response again. */
+        if (false == isSuccessful)
+        {
+            freeEntry(index);
+        }
+    }
+
+    return isSuccessful;
+}
+
+void HttpCache::write(const String& url, const uint8_t* data, size_t size, const String& eTag, const String& lastModified, uint32_t maxAge)
+{
+    HTTP_CACHE_LOCK();
+    size_t  index   = find(url);
+
+    /* Replace the old response in any case. */
+    if (MAX_ENTRIES > index)
+    {
+        freeEntry(index);
+    }
+
+    if ((nullptr == data) ||
+        (0U == size) ||
+        (MAX_ENTRY_SIZE < size))
+    {
+        LOG_DEBUG("Response of %s not cached (%u byte).", url.c_str(), size);
+    }
+    else
+    {
+        bool isStored = false;
+
+        index = getFreeEntry();
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+        /* A response, which would displace most others from memory, is stored in the filesystem. */
+        if (MAX_MEMORY_ENTRY_SIZE < size)
+        {
+            isStored = spill(index, data, size);
+        }
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+        if ((false == isStored) &&
+            (MEMORY_LIMIT >= size))
+        {
+            makeRoom(size);
+
+            isStored = store(index, data, size);
+        }
+
+        if (false == isStored)
+        {
+            LOG_DEBUG("Response of %s not cached (%u byte).", url.c_str(), size);
+        }
+        else
+        {
+            setEntry(index, url, size, eTag, lastModified, maxAge);
+        }
+    }
+}
+
+void HttpCache::write(const String& url, Writer& writer, const String& eTag, const String& lastModified, uint32_t maxAge)
+{
+    HTTP_CACHE_LOCK();
+    size_t  index       = find(url);
+    size_t  size        = writer.m_size;
+    bool    isStored    = false;
+
+    /* Replace the old response in any case. */
+    if (MAX_ENTRIES > index)
+    {
+        freeEntry(index);
+    }
+
+    if ((true == writer.m_isValid) &&
+        (0U < size))
+    {
+        index = getFreeEntry();
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+        /* The temporary file becomes the spilled response. */
+        if (false == writer.m_fileName.isEmpty())
+        {
+            String fileName = getSpillFileName(index);
+
+            writer.m_fd.close();
+
+            /* A file with the same name may be left over from a previous run. */
+            (void)FILESYSTEM.remove(fileName);
+
+            if (true == FILESYSTEM.rename(writer.m_fileName, fileName))
+            {
+                writer.m_fileName.clear();
+                m_entries[index].isSpilled = true;
+
+                isStored = true;
+            }
+        }
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+        if (nullptr != writer.m_data)
+        {
+            makeRoom(size);
+
+            /* Take the payload buffer over, if it fits exactly. Otherwise
+             * a copy avoids to waste the unused part of the buffer.
+             */
+            if (size == writer.m_capacity)
+            {
+                m_entries[index].data       = writer.m_data;
+                m_entries[index].isSpilled  = false;
+                m_memoryUsed               += size;
+
+                writer.m_data       = nullptr;
+                writer.m_capacity   = 0U;
+
+                isStored = true;
+            }
+            else
+            {
+                isStored = store(index, writer.m_data, size);
+            }
+        }
+    }
+
+    if (false == isStored)
+    {
+        LOG_DEBUG("Response of %s not cached (%u byte).", url.c_str(), size);
+    }
+    else
+    {
+        setEntry(index, url, size, eTag, lastModified, maxAge);
+    }
+
+    writer.abort();
+}
+
+void HttpCache::refresh(const String& url, uint32_t maxAge)
+{
+    HTTP_CACHE_LOCK();
+    size_t  index   = find(url);
+
+    if (MAX_ENTRIES > index)
+    {
+        m_entries[index].timestamp  = millis();
+        m_entries[index].maxAge     = maxAge * 1000U;
+    }
+}
+
+void HttpCache::remove(const String& url)
+{
+    HTTP_CACHE_LOCK();
+    size_t  index   = find(url);
+
+    if (MAX_ENTRIES > index)
+    {
+        freeEntry(index);
+    }
+}
+
+void HttpCache::clear()
+{
+    HTTP_CACHE_LOCK();
+    size_t  index   = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        freeEntry(index);
+    }
+}
+
+size_t HttpCache::getMemoryUsed() const
+{
+    HTTP_CACHE_LOCK();
+
+    return m_memoryUsed;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool HttpCache::Writer::reserve(size_t size)
+{
+    bool isSuccessful = true;
+
+    if (MAX_MEMORY_ENTRY_SIZE < (m_size + size))
+    {
+        isSuccessful = false;
+    }
+    else if ((m_capacity - m_size) < size)
+    {
+        size_t      capacity    = m_size + size;
+        uint8_t*    data        = nullptr;
+
+        /* Grow geometrically, otherwise a payload which is received in many
+         * parts would be copied again for every part.
+         */
+        if ((2U * m_capacity) > capacity)
+        {
+            capacity = 2U * m_capacity;
+        }
+
+        if (MAX_MEMORY_ENTRY_SIZE < capacity)
+        {
+            capacity = MAX_MEMORY_ENTRY_SIZE;
+        }
+
+        data = new(std::nothrow) uint8_t[capacity];
+
+        HeapAccounting::getInstance().track(HeapAccounting::TAG_HTTP, data, capacity);
+
+        if (nullptr == data)
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            if (nullptr != m_data)
+            {
+                memcpy(data, m_data, m_size);
+            }
+
+            releaseBuffer();
+
+            m_data      = data;
+            m_capacity  = capacity;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+void HttpCache::Writer::releaseBuffer()
+{
+    if (nullptr != m_data)
+    {
+        HeapAccounting::getInstance().released(HeapAccounting::TAG_HTTP, m_capacity);
+        delete[] m_data;
+        m_data = nullptr;
+    }
+
+    m_capacity = 0U;
+}
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+
+bool HttpCache::Writer::spill()
+{
+    bool    isSuccessful    = false;
+    String  fileName        = HttpCache::getInstance().getTempFileName();
+
+    m_fd = FILESYSTEM.open(fileName, "w");
+
+    if (false == m_fd)
+    {
+        LOG_WARNING("Couldn't create %s.", fileName.c_str());
+    }
+    else
+    {
+        m_fileName = fileName;
+
+        isSuccessful = (nullptr == m_data) || (m_size == m_fd.write(m_data, m_size));
+
+        /* The payload is continued in the filesystem. */
+        releaseBuffer();
+
+        if (false == isSuccessful)
+        {
+            removeFile();
+        }
+    }
+
+    return isSuccessful;
+}
+
+void HttpCache::Writer::removeFile()
+{
+    if (true == m_fd)
+    {
+        m_fd.close();
+    }
+
+    if (false == m_fileName.isEmpty())
+    {
+        (void)FILESYSTEM.remove(m_fileName);
+        m_fileName.clear();
+    }
+}
+
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+HttpCache::HttpCache() :
+#ifndef NATIVE
+    m_mutex(),
+#endif  /* NATIVE */
+    m_entries(),
+    m_memoryUsed(0U),
+    m_isSpillPrepared(false),
+    m_tempFileId(0U)
+{
+    size_t index = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        m_entries[index].timestamp  = 0U;
+        m_entries[index].maxAge     = 0U;
+        m_entries[index].lastUsed   = 0U;
+        m_entries[index].data       = nullptr;
+        m_entries[index].size       = 0U;
+        m_entries[index].isSpilled  = false;
+    }
+
+#ifndef NATIVE
+    (void)m_mutex.create();
+#endif  /* NATIVE */
+}
+
+HttpCache::~HttpCache()
+{
+    clear();
+
+#ifndef NATIVE
+    m_mutex.destroy();
+#endif  /* NATIVE */
+}
+
+size_t HttpCache::find(const String& url) const
+{
+    size_t index = 0U;
+
+    while((MAX_ENTRIES > index) &&
+          ((true == m_entries[index].url.isEmpty()) || (m_entries[index].url != url)))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+size_t HttpCache::getFreeEntry()
+{
+    size_t index       = 0U;
+    size_t lruIndex    = 0U;
+
+    while((MAX_ENTRIES > index) &&
+          (false == m_entries[index].url.isEmpty()))
+    {
+        if ((millis() - m_entries[lruIndex].lastUsed) < (millis() - m_entries[index].lastUsed))
+        {
+            lruIndex = index;
+        }
+
+        ++index;
+    }
+
+    if (MAX_ENTRIES <= index)
+    {
+        freeEntry(lruIndex);
+        index = lruIndex;
+    }
+
+    return index;
+}
+
+bool HttpCache::store(size_t index, const uint8_t* data, size_t size)
+{
+    bool isSuccessful = false;
+
+    m_entries[index].data = new(std::nothrow) uint8_t[size];
+
+    HeapAccounting::getInstance().track(HeapAccounting::TAG_HTTP, m_entries[index].data, size);
+
+    if (nullptr != m_entries[index].data)
+    {
+        memcpy(m_entries[index].data, data, size);
+        m_entries[index].isSpilled = false;
+        m_memoryUsed += size;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void HttpCache::freeEntry(size_t index)
+{
+    Entry& entry = m_entries[index];
+
+    if (nullptr != entry.data)
+    {
+        HeapAccounting::getInstance().released(HeapAccounting::TAG_HTTP, entry.size);
+        delete[] entry.data;
+        entry.data = nullptr;
+
+        m_memoryUsed -= entry.size;
+    }
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+    if (true == entry.isSpilled)
+    {
+        (void)FILESYSTEM.remove(getSpillFileName(index));
+    }
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+    entry.url.clear();
+    entry.eTag.clear();
+    entry.lastModified.clear();
+    entry.timestamp = 0U;
+    entry.maxAge    = 0U;
+    entry.lastUsed  = 0U;
+    entry.size      = 0U;
+    entry.isSpilled = false;
+}
+
+void HttpCache::makeRoom(size_t size)
+{
+    while(MEMORY_LIMIT < (m_memoryUsed + size))
+    {
+        size_t  index       = 0U;
+        size_t  lruIndex    = MAX_ENTRIES;
+
+        /* Find least recently used response in memory. */
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            if ((nullptr != m_entries[index].data) &&
+                ((MAX_ENTRIES == lruIndex) ||
+                 ((millis() - m_entries[lruIndex].lastUsed) < (millis() - m_entries[index].lastUsed))))
+            {
+                lruIndex = index;
+            }
+        }
+
+        if (MAX_ENTRIES == lruIndex)
+        {
+            break;
+        }
+        else
+        {
+            Entry&      entry       = m_entries[lruIndex];
+            bool        isSpilled   = false;
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+            isSpilled = spill(lruIndex, entry.data, entry.size);
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+            if (false == isSpilled)
+            {
+                freeEntry(lruIndex);
+            }
+            else
+            {
+                HeapAccounting::getInstance().released(HeapAccounting::TAG_HTTP, entry.size);
+                delete[] entry.data;
+                entry.data = nullptr;
+
+                m_memoryUsed -= entry.size;
+            }
+        }
+    }
+}
+
+bool HttpCache::spill(size_t index, const uint8_t* data, size_t size)
+{
+    bool isSuccessful = false;
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+
+    prepareSpill();
+
+    File fd = FILESYSTEM.open(getSpillFileName(index), "w");
+
+    if (false == fd)
+    {
+        LOG_WARNING("Couldn't create %s.", getSpillFileName(index).c_str());
+    }
+    else
+    {
+        isSuccessful = (size == fd.write(data, size));
+        fd.close();
+
+        if (false == isSuccessful)
+        {
+            (void)FILESYSTEM.remove(getSpillFileName(index));
+        }
+        else
+        {
+            m_entries[index].isSpilled = true;
+        }
+    }
+
+#else  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+    (void)index;
+    (void)data;
+    (void)size;
+
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+    return isSuccessful;
+}
+
+String HttpCache::getSpillFileName(size_t index) const
+{
+    String fileName = SPILL_PATH;
+
+    fileName += "/";
+    fileName += index;
+    fileName += ".bin";
+
+    return fileName;
+}
+
+void HttpCache::prepareSpill()
+{
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+
+    /* Files of a previous run are overwritten, because the file names depend only on the entry index. */
+    if (false == m_isSpillPrepared)
+    {
+        if (false == FILESYSTEM.exists(SPILL_PATH))
+        {
+            (void)FILESYSTEM.mkdir(SPILL_PATH);
+        }
+
+        m_isSpillPrepared = true;
+    }
+
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+}
+
+String HttpCache::getTempFileName()
+{
+    HTTP_CACHE_LOCK();
+    String  fileName    = SPILL_PATH;
+
+    prepareSpill();
+
+    /* The id starts again with every run, so left over files are overwritten. */
+    fileName += "/w";
+    fileName += m_tempFileId;
+    fileName += ".tmp";
+
+    ++m_tempFileId;
+
+    return fileName;
+}
+
+void HttpCache::setEntry(size_t index, const String& url, size_t size, const String& eTag, const String& lastModified, uint32_t maxAge)
+{
+    Entry& entry = m_entries[index];
+
+    entry.url           = url;
+    entry.eTag          = eTag;
+    entry.lastModified  = lastModified;
+    entry.timestamp     = millis();
+    entry.maxAge        = maxAge * 1000U;
+    entry.lastUsed      = entry.timestamp;
+    entry.size          = size;
+
+    LOG_DEBUG("Response of %s cached (%u byte, max. age %u s).", url.c_str(), size, maxAge);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
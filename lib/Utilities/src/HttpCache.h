@@ -0,0 +1,475 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP response cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef CONFIG_FEATURE_HTTP_CACHE_SPILL
+
+/**
+ * Spill cached responses to the filesystem (1), if they don't fit into the
+ * memory limit. Otherwise (0) they are dropped.
+ */
+#define CONFIG_FEATURE_HTTP_CACHE_SPILL (0)
+
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <WString.h>
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+#include <FS.h>
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HTTP response cache holds the payload of successful GET responses,
+ * keyed by the URL. A response is fresh for the period given by the server
+ * via "Cache-Control: max-age". Afterwards it is revalidated with its entity
+ * tag or last modification date.
+ *
+ * The cache is shared by all HTTP clients, therefore several clients which
+ * request the same URL, cause only one request to the server.
+ */
+class HttpCache
+{
+public:
+
+    /**
+     * Prototype of the callback, which gets the cached payload part by part.
+     */
+    typedef std::function<void(const uint8_t* data, size_t size)> OnData;
+
+    /** Max. number of cached responses. */
+    static const size_t     MAX_ENTRIES     = 8U;
+
+    /** Max. memory in byte, which is used by the cached payloads. */
+    static const size_t     MEMORY_LIMIT    = 16384U;
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+
+    /** Max. payload size in byte of a single response, which is cached. */
+    static const size_t     MAX_ENTRY_SIZE          = 32768U;
+
+    /**
+     * Max. payload size in byte of a single response, which is kept in
+     * memory. A larger one would displace most others, therefore it is
+     * stored in the filesystem.
+     */
+    static const size_t     MAX_MEMORY_ENTRY_SIZE   = MEMORY_LIMIT / 2U;
+
+#else  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+    /** Max. payload size in byte of a single response, which is cached. */
+    static const size_t     MAX_ENTRY_SIZE          = MEMORY_LIMIT;
+
+    /** Max. payload size in byte of a single response, which is kept in memory. */
+    static const size_t     MAX_MEMORY_ENTRY_SIZE   = MEMORY_LIMIT;
+
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+    /**
+     * Collects a response payload, which is received part by part, until it
+     * is complete and can be cached. The payload is kept in memory as long
+     * as it fits, otherwise it is written to a temporary file in the
+     * filesystem (only if spilling is enabled). As soon as the payload can't
+     * be cached anymore, the writer becomes invalid and releases everything.
+     */
+    class Writer
+    {
+    public:
+
+        /**
+         * Constructs a invalid writer.
+         */
+        Writer();
+
+        /**
+         * Destroys the writer and releases the collected payload.
+         */
+        ~Writer();
+
+        /**
+         * Begin to collect a new payload. A already collected payload is
+         * released.
+         *
+         * @param[in] expectedSize  Expected payload size in byte. Use 0 if unknown.
+         *
+         * @return If the payload can be cached, it will return true otherwise false.
+         */
+        bool begin(size_t expectedSize);
+
+        /**
+         * Add a part of the payload.
+         *
+         * @param[in] data  Payload part
+         * @param[in] size  Payload part size in byte
+         *
+         * @return If the payload can still be cached, it will return true otherwise false.
+         */
+        bool write(const uint8_t* data, size_t size);
+
+        /**
+         * Release the collected payload. The writer becomes invalid.
+         */
+        void abort();
+
+        /**
+         * Is the writer valid, which means the collected payload can be cached?
+         *
+         * @return If valid, it will return true otherwise false.
+         */
+        bool isValid() const
+        {
+            return m_isValid;
+        }
+
+        /**
+         * Get the size of the collected payload.
+         *
+         * @return Payload size in byte
+         */
+        size_t getSize() const
+        {
+            return m_size;
+        }
+
+    private:
+
+        friend class HttpCache;
+
+        uint8_t*    m_data;         /**< Payload in memory, nullptr if not available or spilling. */
+        size_t      m_capacity;     /**< Size of the payload buffer in byte */
+        size_t      m_size;         /**< Collected payload size in byte */
+        bool        m_isValid;      /**< Can the collected payload be cached? */
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+        File        m_fd;           /**< Temporary file, used as soon as the payload doesn't fit into memory anymore. */
+        String      m_fileName;     /**< Full path of the temporary file, empty if not used. */
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+
+        Writer(const Writer& writer);
+        Writer& operator=(const Writer& writer);
+
+        /**
+         * Ensure that the payload buffer has room for further bytes.
+         * The buffer grows geometrically, but not beyond the max. payload
+         * size in memory.
+         *
+         * @param[in] size  Number of bytes, which shall be added.
+         *
+         * @return If successful, it will return true otherwise false.
+         */
+        bool reserve(size_t size);
+
+        /**
+         * Release the payload buffer.
+         */
+        void releaseBuffer();
+
+#if CONFIG_FEATURE_HTTP_CACHE_SPILL == 1
+
+        /**
+         * Move the payload from memory to a temporary file.
+         *
+         * @return If successful, it will return true otherwise false.
+         */
+        bool spill();
+
+        /**
+         * Close and remove the temporary file.
+         */
+        void removeFile();
+
+#endif  /* CONFIG_FEATURE_HTTP_CACHE_SPILL == 1 */
+    };
+
+    /**
+     * Get the HTTP cache instance.
+     *
+     * @return HTTP cache instance
+     */
+    static HttpCache& getInstance()
+    {
+        static HttpCache instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Is a fresh response for the URL cached, which doesn't need to be
+     * revalidated?
+     *
+     * @param[in] url   URL
+     *
+     * @return If a fresh response is cached, it will return true otherwise false.
+     */
+    bool isFresh(const String& url);
+
+    /**
+     * Get the validators of a cached response, which shall be used for
+     * a conditional request.
+     *
+     * @param[in]   url             URL
+     * @param[out]  eTag            Entity tag, may be empty.
+     * @param[out]  lastModified    Last modification date, may be empty.
+     *
+     * @return If a response is cached, it will return true otherwise false.
+     */
+    bool getValidators(const String& url, String& eTag, String& lastModified);
+
+    /**
+     * Read the cached response payload.
+     *
+     * @param[in] url       URL
+     * @param[in] onData    Callback which gets the payload part by part.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool read(const String& url, const OnData& onData);
+
+    /**
+     * Cache the response payload. A already cached response of the same URL
+     * is replaced.
+     *
+     * @param[in] url           URL
+     * @param[in] data          Response payload
+     * @param[in] size          Response payload size in byte
+     * @param[in] eTag          Entity tag, may be empty.
+     * @param[in] lastModified  Last modification date, may be empty.
+     * @param[in] maxAge        Period in s, the response is fresh.
+     */
+    void write(const String& url, const uint8_t* data, size_t size, const String& eTag, const String& lastModified, uint32_t maxAge);
+
+    /**
+     * Cache the response payload, which was collected by the writer.
+     * A already cached response of the same URL is replaced. The writer
+     * hands its payload over and becomes invalid.
+     *
+     * @param[in] url           URL
+     * @param[in] writer        Writer with the collected response payload
+     * @param[in] eTag          Entity tag, may be empty.
+     * @param[in] lastModified  Last modification date, may be empty.
+     * @param[in] maxAge        Period in s, the response is fresh.
+     */
+    void write(const String& url, Writer& writer, const String& eTag, const String& lastModified, uint32_t maxAge);
+
+    /**
+     * The server confirmed that the cached response is still valid.
+     *
+     * @param[in] url       URL
+     * @param[in] maxAge    Period in s, the response is fresh.
+     */
+    void refresh(const String& url, uint32_t maxAge);
+
+    /**
+     * Remove cached response of the URL.
+     *
+     * @param[in] url   URL
+     */
+    void remove(const String& url);
+
+    /**
+     * Remove all cached responses.
+     */
+    void clear();
+
+    /**
+     * Get the memory in byte, which is used by the cached payloads.
+     *
+     * @return Used memory in byte
+     */
+    size_t getMemoryUsed() const;
+
+private:
+
+    /** Directory in the filesystem, where the spilled responses are stored. */
+    static constexpr const char*    SPILL_PATH  = "/cache";
+
+    /** Size in byte of a single part, which is read from a spilled response. */
+    static const size_t     READ_CHUNK_SIZE = 512U;
+
+    /**
+     * A cached response.
+     */
+    struct Entry
+    {
+        String      url;            /**< URL, empty if not used. */
+        String      eTag;           /**< Entity tag */
+        String      lastModified;   /**< Last modification date */
+        uint32_t    timestamp;      /**< Timestamp in ms, when the response was received or revalidated. */
+        uint32_t    maxAge;         /**< Period in ms, the response is fresh. */
+        uint32_t    lastUsed;       /**< Timestamp in ms, when the response was used the last time. */
+        uint8_t*    data;           /**< Payload in memory, nullptr if spilled. */
+        size_t      size;           /**< Payload size in byte */
+        bool        isSpilled;      /**< Is the payload stored in the filesystem? */
+    };
+
+#ifndef NATIVE
+    mutable MutexRecursive  m_mutex;        /**< Used to protect against concurrent access. */
+#endif  /* NATIVE */
+    Entry           m_entries[MAX_ENTRIES]; /**< Cached responses */
+    size_t          m_memoryUsed;           /**< Memory in byte, used by the payloads. */
+    bool            m_isSpillPrepared;      /**< Is the spill directory prepared? */
+    uint32_t        m_tempFileId;           /**< Id of the next temporary file of a writer. */
+
+    /**
+     * Constructs the HTTP cache.
+     */
+    HttpCache();
+
+    /**
+     * Destroys the HTTP cache.
+     */
+    ~HttpCache();
+
+    HttpCache(const HttpCache& cache);
+    HttpCache& operator=(const HttpCache& cache);
+
+    /**
+     * Find the cached response of the URL.
+     *
+     * @param[in] url   URL
+     *
+     * @return Index of the entry. If not found, it will return MAX_ENTRIES.
+     */
+    size_t find(const String& url) const;
+
+    /**
+     * Get a unused entry. If all are used, the least recently used one is
+     * freed.
+     *
+     * @return Index of the entry.
+     */
+    size_t getFreeEntry();
+
+    /**
+     * Store the payload in memory. The caller must ensure that there is
+     * room for it.
+     *
+     * @param[in] index Index of the entry
+     * @param[in] data  Payload
+     * @param[in] size  Payload size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool store(size_t index, const uint8_t* data, size_t size);
+
+    /**
+     * Free the entry and its payload.
+     *
+     * @param[in] index Index of the entry
+     */
+    void freeEntry(size_t index);
+
+    /**
+     * Make room in memory for the given payload size, by spilling or
+     * freeing the least recently used responses.
+     *
+     * @param[in] size  Payload size in byte
+     */
+    void makeRoom(size_t size);
+
+    /**
+     * Store the payload in the filesystem.
+     *
+     * @param[in] index Index of the entry
+     * @param[in] data  Payload
+     * @param[in] size  Payload size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool spill(size_t index, const uint8_t* data, size_t size);
+
+    /**
+     * Get the full path of the file, which contains the spilled payload.
+     *
+     * @param[in] index Index of the entry
+     *
+     * @return Full path of the file
+     */
+    String getSpillFileName(size_t index) const;
+
+    /**
+     * Prepare the directory of the spilled responses.
+     */
+    void prepareSpill();
+
+    /**
+     * Get the full path of a new temporary file, used by a writer.
+     *
+     * @return Full path of the file
+     */
+    String getTempFileName();
+
+    /**
+     * Set the meta data of a entry, which payload is stored.
+     *
+     * @param[in] index         Index of the entry
+     * @param[in] url           URL
+     * @param[in] size          Payload size in byte
+     * @param[in] eTag          Entity tag, may be empty.
+     * @param[in] lastModified  Last modification date, may be empty.
+     * @param[in] maxAge        Period in s, the response is fresh.
+     */
+    void setEntry(size_t index, const String& url, size_t size, const String& eTag, const String& lastModified, uint32_t maxAge);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTTP_CACHE_H */
+
+/** @} */
@@ -0,0 +1,215 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP connection pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef HTTP_CONNECTION_POOL_HPP
+#define HTTP_CONNECTION_POOL_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <WString.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A fixed number of connections, which are assigned to the requests.
+ * A connection kept alive to the same server is preferred, then a closed one.
+ * Only one secure connection exists at a time, because each one needs a lot
+ * of heap.
+ *
+ * @tparam TConnection      Connection type, derived from HttpConnectionSlot.
+ * @tparam maxConnections   Max. number of connections.
+ */
+template < typename TConnection, size_t maxConnections >
+class HttpConnectionPool
+{
+public:
+
+    /**
+     * Constructs a pool with closed connections.
+     */
+    HttpConnectionPool() :
+        m_connections()
+    {
+    }
+
+    /**
+     * Destroys the pool.
+     */
+    ~HttpConnectionPool()
+    {
+    }
+
+    /**
+     * Get connection by index.
+     *
+     * @param[in] index Connection index
+     *
+     * @return Connection
+     */
+    TConnection& operator[](size_t index)
+    {
+        return m_connections[index];
+    }
+
+    /**
+     * Get max. number of connections.
+     *
+     * @return Max. number of connections
+     */
+    size_t getSize() const
+    {
+        return maxConnections;
+    }
+
+    /**
+     * Acquire a connection for the server. Preferred is an idle connection
+     * to the same server, then a closed one, which is set up for the server.
+     * If none is available, the least recently used idle connection is
+     * provided, which the caller shall close to make room for the next time.
+     *
+     * A secure connection to a new server is only provided, if no other
+     * secure connection exists. Otherwise the idle secure connection is
+     * provided to be closed.
+     *
+     * @param[in]   hostname            Server hostname
+     * @param[in]   port                Server port
+     * @param[in]   isSecure            Secure transport (true) or not (false)
+     * @param[out]  lruIdleConnection   Least recently used idle connection, only set if no connection is available.
+     *
+     * @return Connection. If none is available, it will return nullptr.
+     */
+    TConnection* acquire(const String& hostname, uint16_t port, bool isSecure, TConnection*& lruIdleConnection)
+    {
+        TConnection*    connection          = nullptr;
+        TConnection*    closedConnection    = nullptr;
+        TConnection*    lruIdle             = nullptr;
+        TConnection*    secureConnection    = nullptr;
+        size_t          index               = 0U;
+
+        while((maxConnections > index) && (nullptr == connection))
+        {
+            TConnection& candidate = m_connections[index];
+
+            if ((true == candidate.isSecure()) &&
+                (TConnection::STATE_CLOSED != candidate.getState()))
+            {
+                secureConnection = &candidate;
+            }
+
+            if (true == candidate.isIdle())
+            {
+                if (true == candidate.isServer(hostname, port, isSecure))
+                {
+                    connection = &candidate;
+                }
+                else if ((nullptr == lruIdle) ||
+                         (lruIdle->getDuration() < candidate.getDuration()))
+                {
+                    lruIdle = &candidate;
+                }
+                else
+                {
+                    ;
+                }
+            }
+            else if ((TConnection::STATE_CLOSED == candidate.getState()) &&
+                     (nullptr == candidate.getOwner()) &&
+                     (nullptr == closedConnection))
+            {
+                closedConnection = &candidate;
+            }
+            else
+            {
+                ;
+            }
+
+            ++index;
+        }
+
+        lruIdleConnection = nullptr;
+
+        if (nullptr != connection)
+        {
+            ;
+        }
+        /* Wait until the other secure connection is closed. */
+        else if ((true == isSecure) &&
+                 (nullptr != secureConnection))
+        {
+            if (true == secureConnection->isIdle())
+            {
+                lruIdleConnection = secureConnection;
+            }
+        }
+        else if (nullptr != closedConnection)
+        {
+            connection = closedConnection;
+            connection->setServer(hostname, port, isSecure);
+        }
+        else
+        {
+            lruIdleConnection = lruIdle;
+        }
+
+        return connection;
+    }
+
+private:
+
+    TConnection m_connections[maxConnections];  /**< Connections */
+
+    HttpConnectionPool(const HttpConnectionPool& pool);
+    HttpConnectionPool& operator=(const HttpConnectionPool& pool);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTTP_CONNECTION_POOL_HPP */
+
+/** @} */
@@ -0,0 +1,305 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP connection slot
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef HTTP_CONNECTION_SLOT_HPP
+#define HTTP_CONNECTION_SLOT_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The bookkeeping of a connection to a server, independent of the transport.
+ * It is used by one owner at a time. After a completed request it may be
+ * kept alive and reused by the next request to the same server.
+ *
+ * Every transport connection, which is established via the slot, gets its
+ * own generation. Notifications of a former transport connection can be
+ * recognized by their generation and discarded.
+ *
+ * @tparam TOwner   Type of the owner, which uses the connection.
+ */
+template < typename TOwner >
+class HttpConnectionSlot
+{
+public:
+
+    /**
+     * Connection states.
+     */
+    enum State
+    {
+        STATE_CLOSED = 0,   /**< Connection is closed and may be used for any server. */
+        STATE_CONNECTING,   /**< Connection establishment is pending. */
+        STATE_CONNECTED,    /**< Connection is established. */
+        STATE_CLOSING       /**< Connection is closed, but the disconnect is still pending. */
+    };
+
+    /**
+     * Constructs a closed connection slot.
+     */
+    HttpConnectionSlot() :
+        m_state(STATE_CLOSED),
+        m_hostname(),
+        m_port(0U),
+        m_isSecure(false),
+        m_owner(nullptr),
+        m_timestamp(0U),
+        m_generation(0U)
+    {
+    }
+
+    /**
+     * Destroys the connection slot.
+     */
+    ~HttpConnectionSlot()
+    {
+    }
+
+    /**
+     * Get connection state.
+     *
+     * @return Connection state
+     */
+    State getState() const
+    {
+        return m_state;
+    }
+
+    /**
+     * Set connection state. The timestamp is updated too.
+     *
+     * @param[in] state Connection state
+     */
+    void setState(State state)
+    {
+        m_state     = state;
+        m_timestamp = millis();
+    }
+
+    /**
+     * Set the server, which the connection is used for.
+     *
+     * @param[in] hostname  Server hostname
+     * @param[in] port      Server port
+     * @param[in] isSecure  Secure transport (true) or not (false)
+     */
+    void setServer(const String& hostname, uint16_t port, bool isSecure)
+    {
+        m_hostname  = hostname;
+        m_port      = port;
+        m_isSecure  = isSecure;
+    }
+
+    /**
+     * Is the connection used for the given server?
+     *
+     * @param[in] hostname  Server hostname
+     * @param[in] port      Server port
+     * @param[in] isSecure  Secure transport (true) or not (false)
+     *
+     * @return If connection is used for the server, it will return true otherwise false.
+     */
+    bool isServer(const String& hostname, uint16_t port, bool isSecure) const
+    {
+        return ((port == m_port) &&
+                (isSecure == m_isSecure) &&
+                (0U != hostname.equalsIgnoreCase(m_hostname)));
+    }
+
+    /**
+     * Get server hostname.
+     *
+     * @return Server hostname
+     */
+    const String& getHostname() const
+    {
+        return m_hostname;
+    }
+
+    /**
+     * Get server port.
+     *
+     * @return Server port
+     */
+    uint16_t getPort() const
+    {
+        return m_port;
+    }
+
+    /**
+     * Is it a secure connection?
+     *
+     * @return If secure, it will return true otherwise false.
+     */
+    bool isSecure() const
+    {
+        return m_isSecure;
+    }
+
+    /**
+     * Get the owner, which uses the connection.
+     *
+     * @return Owner. If the connection is not used, it will return nullptr.
+     */
+    TOwner* getOwner() const
+    {
+        return m_owner;
+    }
+
+    /**
+     * Set the owner, which uses the connection. The timestamp is updated too.
+     *
+     * @param[in] owner Owner or nullptr to release it.
+     */
+    void setOwner(TOwner* owner)
+    {
+        m_owner     = owner;
+        m_timestamp = millis();
+    }
+
+    /**
+     * Get the generation of the current transport connection.
+     *
+     * @return Generation
+     */
+    uint32_t getGeneration() const
+    {
+        return m_generation;
+    }
+
+    /**
+     * Start the next generation. Shall be called before a new transport
+     * connection is established.
+     */
+    void nextGeneration()
+    {
+        ++m_generation;
+    }
+
+    /**
+     * Is the connection established and not used by any owner?
+     *
+     * @return If idle, it will return true otherwise false.
+     */
+    bool isIdle() const
+    {
+        return ((STATE_CONNECTED == m_state) && (nullptr == m_owner));
+    }
+
+    /**
+     * Get the duration since the last state or owner change.
+     *
+     * @return Duration in ms
+     */
+    uint32_t getDuration() const
+    {
+        return millis() - m_timestamp;
+    }
+
+    /**
+     * Is the connection idle for longer than the keep-alive period?
+     *
+     * @return If expired, it will return true otherwise false.
+     */
+    bool isKeepAliveExpired() const
+    {
+        return ((true == isIdle()) && (KEEP_ALIVE_TIMEOUT <= getDuration()));
+    }
+
+    /**
+     * Is the disconnect pending for longer than the close period?
+     * If so, the connection can be considered as closed.
+     *
+     * @return If expired, it will return true otherwise false.
+     */
+    bool isCloseExpired() const
+    {
+        return ((STATE_CLOSING == m_state) && (CLOSE_TIMEOUT <= getDuration()));
+    }
+
+    /**
+     * Is the connection used by an owner for longer than the request period?
+     *
+     * @return If expired, it will return true otherwise false.
+     */
+    bool isRequestExpired() const
+    {
+        return ((nullptr != m_owner) && (REQUEST_TIMEOUT <= getDuration()));
+    }
+
+    /** An idle connection is closed after this period in ms. */
+    static const uint32_t   KEEP_ALIVE_TIMEOUT  = 15000U;
+
+    /** A request is aborted, if its not completed within this period in ms. */
+    static const uint32_t   REQUEST_TIMEOUT     = 30000U;
+
+    /** A closing connection is considered as closed after this period in ms, if no disconnect event is received. */
+    static const uint32_t   CLOSE_TIMEOUT       = 2000U;
+
+private:
+
+    State       m_state;        /**< Connection state */
+    String      m_hostname;     /**< Server hostname */
+    uint16_t    m_port;         /**< Server port */
+    bool        m_isSecure;     /**< Secure transport (true) or not (false) */
+    TOwner*     m_owner;        /**< Owner, which uses the connection */
+    uint32_t    m_timestamp;    /**< Timestamp in ms of the last state or owner change */
+    uint32_t    m_generation;   /**< Generation of the current transport connection */
+
+    HttpConnectionSlot(const HttpConnectionSlot& slot);
+    HttpConnectionSlot& operator=(const HttpConnectionSlot& slot);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTTP_CONNECTION_SLOT_HPP */
+
+/** @} */
@@ -0,0 +1,231 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP request queue
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef HTTP_REQUEST_QUEUE_HPP
+#define HTTP_REQUEST_QUEUE_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Queue of the requests, which wait to be served. The next request is the
+ * earliest one with the highest priority.
+ *
+ * @tparam TRequest     Request type, which provides getPriority().
+ * @tparam maxRequests  Max. number of queued requests.
+ */
+template < typename TRequest, size_t maxRequests >
+class HttpRequestQueue
+{
+public:
+
+    /**
+     * Constructs an empty request queue.
+     */
+    HttpRequestQueue() :
+        m_requests(),
+        m_requestCnt(0U)
+    {
+    }
+
+    /**
+     * Destroys the request queue.
+     */
+    ~HttpRequestQueue()
+    {
+    }
+
+    /**
+     * Add request to the end of the queue.
+     *
+     * @param[in] request   Request
+     *
+     * @return If successful queued, it will return true otherwise false.
+     */
+    bool add(TRequest& request)
+    {
+        bool isSuccessful = false;
+
+        if (maxRequests > m_requestCnt)
+        {
+            m_requests[m_requestCnt] = &request;
+            ++m_requestCnt;
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Get the next request, which to serve. Its the earliest request with
+     * the highest priority.
+     *
+     * @return Request. If the queue is empty, it will return nullptr.
+     */
+    TRequest* getNext() const
+    {
+        TRequest* request = nullptr;
+
+        if (0U < m_requestCnt)
+        {
+            request = m_requests[getNextIndex()];
+        }
+
+        return request;
+    }
+
+    /**
+     * Remove the next request from the queue.
+     */
+    void removeNext()
+    {
+        if (0U < m_requestCnt)
+        {
+            removeIndex(getNextIndex());
+        }
+    }
+
+    /**
+     * Remove the request from the queue. If it is queued several times,
+     * all of them are removed.
+     *
+     * @param[in] request   Request
+     */
+    void remove(const TRequest& request)
+    {
+        size_t index = 0U;
+
+        while(m_requestCnt > index)
+        {
+            if (&request == m_requests[index])
+            {
+                removeIndex(index);
+            }
+            else
+            {
+                ++index;
+            }
+        }
+    }
+
+    /**
+     * Get number of queued requests.
+     *
+     * @return Number of queued requests
+     */
+    size_t getCount() const
+    {
+        return m_requestCnt;
+    }
+
+private:
+
+    TRequest*   m_requests[maxRequests];    /**< Queued requests in order of arrival */
+    size_t      m_requestCnt;               /**< Number of queued requests */
+
+    HttpRequestQueue(const HttpRequestQueue& queue);
+    HttpRequestQueue& operator=(const HttpRequestQueue& queue);
+
+    /**
+     * Get the index of the next request, which to serve.
+     * The queue must not be empty.
+     *
+     * @return Request index
+     */
+    size_t getNextIndex() const
+    {
+        size_t  nextIndex   = 0U;
+        size_t  index       = 1U;
+
+        /* The requests are stored in order of arrival, therefore the first one
+         * with the highest priority is the next one.
+         */
+        while(m_requestCnt > index)
+        {
+            if (m_requests[nextIndex]->getPriority() < m_requests[index]->getPriority())
+            {
+                nextIndex = index;
+            }
+
+            ++index;
+        }
+
+        return nextIndex;
+    }
+
+    /**
+     * Remove request from queue.
+     *
+     * @param[in] index Request index
+     */
+    void removeIndex(size_t index)
+    {
+        if (m_requestCnt > index)
+        {
+            --m_requestCnt;
+
+            while(m_requestCnt > index)
+            {
+                m_requests[index] = m_requests[index + 1U];
+                ++index;
+            }
+
+            m_requests[m_requestCnt] = nullptr;
+        }
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTTP_REQUEST_QUEUE_HPP */
+
+/** @} */
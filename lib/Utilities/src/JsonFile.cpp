@@ -33,6 +33,8 @@
  * Includes
  *****************************************************************************/
 #include "JsonFile.h"
+#include "ConfigChangeNotifier.h"
+#include "ConfigSnapshot.h"
 
 #ifndef NATIVE
 
@@ -61,24 +63,182 @@
  * Local Variables
  *****************************************************************************/
 
+/* Initialize static members */
+const char* JsonFile::TMP_FILE_SUFFIX           = ".tmp";
+const char* JsonFile::JSON_FILE_EXTENSION       = ".json";
+const char* JsonFile::MSGPACK_FILE_EXTENSION    = ".msgpack";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 bool JsonFile::load(const String& fileName, JsonDocument& doc)
+{
+    bool isSuccessful = false;
+
+    if (STORAGE_CONFIG == m_storage)
+    {
+        isSuccessful = ConfigSnapshot::getInstance().get(fileName, doc);
+
+        if (false == isSuccessful)
+        {
+            isSuccessful = loadConfig(fileName, doc);
+
+            if (true == isSuccessful)
+            {
+                ConfigSnapshot::getInstance().put(fileName, doc);
+            }
+        }
+    }
+    else
+    {
+        isSuccessful = readFile(fileName, doc, false);
+    }
+
+    return isSuccessful;
+}
+
+bool JsonFile::save(const String& fileName, const JsonDocument& doc)
+{
+    bool isSuccessful   = false;
+    bool isMsgPack      = false;
+
+#if (0 != CONFIG_JSON_FILE_MSGPACK)
+    isMsgPack = (STORAGE_CONFIG == m_storage);
+#endif  /* (0 != CONFIG_JSON_FILE_MSGPACK) */
+
+    if (false == isMsgPack)
+    {
+        isSuccessful = writeFile(fileName, doc, false);
+    }
+    else
+    {
+        isSuccessful = writeFile(getMsgPackFileName(fileName), doc, true);
+
+        /* An outdated JSON file would take precedence at loading. */
+        if ((true == isSuccessful) &&
+            (true == m_fs.exists(fileName)))
+        {
+            (void)m_fs.remove(fileName);
+        }
+    }
+
+    if (true == isSuccessful)
+    {
+        /* The notification invalidates the snapshot too, therefore the
+         * snapshot is taken afterwards.
+         */
+        ConfigChangeNotifier::getInstance().notify(fileName);
+
+        if (STORAGE_CONFIG == m_storage)
+        {
+            ConfigSnapshot::getInstance().put(fileName, doc);
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool JsonFile::remove(const String& fileName)
+{
+    bool isRemoved = m_fs.remove(fileName);
+
+#if (0 != CONFIG_JSON_FILE_MSGPACK)
+
+    if ((STORAGE_CONFIG == m_storage) &&
+        (true == m_fs.remove(getMsgPackFileName(fileName))))
+    {
+        isRemoved = true;
+    }
+
+#endif  /* (0 != CONFIG_JSON_FILE_MSGPACK) */
+
+    ConfigChangeNotifier::getInstance().notify(fileName);
+
+    return isRemoved;
+}
+
+String JsonFile::getMsgPackFileName(const String& fileName)
+{
+    return ConfigSnapshot::getBasePath(fileName) + MSGPACK_FILE_EXTENSION;
+}
+
+String JsonFile::getJsonFileName(const String& fileName)
+{
+    String jsonFileName = fileName;
+
+    if (true == fileName.endsWith(MSGPACK_FILE_EXTENSION))
+    {
+        jsonFileName = ConfigSnapshot::getBasePath(fileName) + JSON_FILE_EXTENSION;
+    }
+
+    return jsonFileName;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool JsonFile::loadConfig(const String& fileName, JsonDocument& doc)
+{
+    bool isSuccessful = false;
+
+#if (0 != CONFIG_JSON_FILE_MSGPACK)
+
+    if (false == m_fs.exists(fileName))
+    {
+        isSuccessful = readFile(getMsgPackFileName(fileName), doc, true);
+    }
+    else
+    {
+        isSuccessful = readFile(fileName, doc, false);
+
+        /* Migrate the JSON file to MessagePack once. The content doesn't
+         * change, therefore nobody is notified.
+         */
+        if ((true == isSuccessful) &&
+            (true == writeFile(getMsgPackFileName(fileName), doc, true)))
+        {
+            (void)m_fs.remove(fileName);
+        }
+    }
+
+#else   /* (0 != CONFIG_JSON_FILE_MSGPACK) */
+
+    isSuccessful = readFile(fileName, doc, false);
+
+#endif  /* (0 != CONFIG_JSON_FILE_MSGPACK) */
+
+    return isSuccessful;
+}
+
+bool JsonFile::readFile(const String& fileName, JsonDocument& doc, bool isMsgPack)
 {
     bool    isSuccessful    = false;
     File    fd              = m_fs.open(fileName, "r");
 
     if (true == fd)
     {
+        DeserializationError    error;
 #ifdef NATIVE
-        DeserializationError    error   = deserializeJson(doc, fd);
+        File&                   input   = fd;
 #else   /* NATIVE */
-        ReadBufferingStream     bufferedStream(fd, CHUNK_SIZE);
-        DeserializationError    error   = deserializeJson(doc, bufferedStream);
+        ReadBufferingStream     input(fd, CHUNK_SIZE);
 #endif  /* NATIVE */
 
+        if (true == isMsgPack)
+        {
+            error = deserializeMsgPack(doc, input);
+        }
+        else
+        {
+            error = deserializeJson(doc, input);
+        }
+
         if (DeserializationError::Ok == error.code())
         {
             isSuccessful = true;
@@ -90,46 +250,70 @@ bool JsonFile::load(const String& fileName, JsonDocument& doc)
     return isSuccessful;
 }
 
-bool JsonFile::save(const String& fileName, const JsonDocument& doc)
+bool JsonFile::writeFile(const String& fileName, const JsonDocument& doc, bool isMsgPack)
 {
     bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "w");
+    String  tmpFileName     = fileName + TMP_FILE_SUFFIX;
+    File    fd              = m_fs.open(tmpFileName, "w");
 
     if (true == fd)
     {
-#ifndef NATIVE
-        WriteBufferingStream    bufferedStream(fd, CHUNK_SIZE);
-#endif  /* NATIVE */
-
-        size_t                  write   = measureJsonPretty(doc);
-        
-#ifdef NATIVE        
-        if (write == serializeJsonPretty(doc, fd))
+#ifdef NATIVE
+        File&                   output  = fd;
 #else   /* NATIVE */
-        if (write == serializeJsonPretty(doc, bufferedStream))
+        WriteBufferingStream    output(fd, CHUNK_SIZE);
 #endif  /* NATIVE */
+        size_t                  write   = 0U;
+        size_t                  written = 0U;
+
+        if (true == isMsgPack)
+        {
+            write   = measureMsgPack(doc);
+            written = serializeMsgPack(doc, output);
+        }
+        else
+        {
+            write   = measureJsonPretty(doc);
+            written = serializeJsonPretty(doc, output);
+        }
+
+        if (write == written)
         {
             isSuccessful = true;
         }
 
 #ifndef NATIVE
-        bufferedStream.flush();
+        output.flush();
 #endif  /* NATIVE*/
 
         fd.close();
+
+        /* Replace the file only if it was written completely. */
+        if (false == isSuccessful)
+        {
+            (void)m_fs.remove(tmpFileName);
+        }
+        else
+        {
+            /* Renaming overwrites an existing file on LittleFS. Other
+             * filesystems need to remove it first.
+             */
+            if (false == m_fs.rename(tmpFileName, fileName))
+            {
+                (void)m_fs.remove(fileName);
+
+                if (false == m_fs.rename(tmpFileName, fileName))
+                {
+                    (void)m_fs.remove(tmpFileName);
+                    isSuccessful = false;
+                }
+            }
+        }
     }
 
     return isSuccessful;
 }
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
-
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
-
 /******************************************************************************
  * External Functions
  *****************************************************************************/
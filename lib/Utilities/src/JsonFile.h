@@ -40,6 +40,16 @@
  * Compile Switches
  *****************************************************************************/
 
+#ifndef CONFIG_JSON_FILE_MSGPACK
+
+/**
+ * Store configuration files as MessagePack instead of pretty printed JSON.
+ * Existing JSON configuration files are converted once at loading.
+ */
+#define CONFIG_JSON_FILE_MSGPACK    (0)
+
+#endif  /* CONFIG_JSON_FILE_MSGPACK */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
@@ -56,18 +66,35 @@
 
 /**
  * JSON file handler, which uses buffered i/o access to improve performance.
+ * Saving a file is notified to the configuration change notifier.
+ *
+ * Configuration files are kept as snapshot in RAM after loading or saving,
+ * so loading them again doesn't access the filesystem. Depended on
+ * CONFIG_JSON_FILE_MSGPACK they are stored as MessagePack, but always
+ * addressed by their JSON filename.
  */
 class JsonFile
 {
 public:
 
+    /**
+     * How the file is stored.
+     */
+    enum Storage
+    {
+        STORAGE_JSON = 0,   /**< Always stored as pretty printed JSON file. */
+        STORAGE_CONFIG      /**< Configuration file, with snapshot in RAM and stored depended on CONFIG_JSON_FILE_MSGPACK. */
+    };
+
     /**
      * Constructs the JSON file handler.
      * 
-     * @param[in] fs    Filesystem
+     * @param[in] fs        Filesystem
+     * @param[in] storage   How the file is stored.
      */
-    JsonFile(FS& fs) :
-        m_fs(fs)
+    JsonFile(FS& fs, Storage storage = STORAGE_JSON) :
+        m_fs(fs),
+        m_storage(storage)
     {
     }
 
@@ -78,7 +105,8 @@ public:
      * @param[in] jsonFile  JSON file handler
      */
     JsonFile(const JsonFile& jsonFile) :
-        m_fs(jsonFile.m_fs)
+        m_fs(jsonFile.m_fs),
+        m_storage(jsonFile.m_storage)
     {
     }
 
@@ -109,6 +137,46 @@ public:
      */
     bool save(const String& fileName, const JsonDocument& doc);
 
+    /**
+     * Remove JSON file. A configuration file is removed independent of how
+     * it is stored.
+     * 
+     * @param[in] fileName  Name of the JSON file.
+     * 
+     * @return If a file was removed, it will return true otherwise false.
+     */
+    bool remove(const String& fileName);
+
+    /**
+     * Get the name of the MessagePack file, which belongs to the JSON file.
+     * 
+     * @param[in] fileName  Name of the JSON file.
+     * 
+     * @return Name of the MessagePack file
+     */
+    static String getMsgPackFileName(const String& fileName);
+
+    /**
+     * Get the name of the JSON file, which a configuration file belongs to.
+     * It is the name, which the configuration is addressed by, independent
+     * of how it is stored.
+     * 
+     * @param[in] fileName  Name of a JSON or MessagePack file.
+     * 
+     * @return Name of the JSON file
+     */
+    static String getJsonFileName(const String& fileName);
+
+    /**
+     * File extension of JSON files.
+     */
+    static const char*  JSON_FILE_EXTENSION;
+
+    /**
+     * File extension of MessagePack files.
+     */
+    static const char*  MSGPACK_FILE_EXTENSION;
+
 protected:
 
 private:
@@ -119,10 +187,53 @@ private:
      */
     static const size_t CHUNK_SIZE  = 64U;
 
-    FS  m_fs;   /**< Filesystem */
+    /**
+     * Suffix of the temporary file, which is written first and replaces the
+     * JSON file afterwards.
+     */
+    static const char*  TMP_FILE_SUFFIX;
+
+    FS      m_fs;       /**< Filesystem */
+    Storage m_storage;  /**< How the file is stored */
 
     JsonFile();
     JsonFile& operator=(const JsonFile& jsonFile);
+
+    /**
+     * Load configuration file from the filesystem. A JSON file takes
+     * precedence, because it may be uploaded by the user. If configured,
+     * it will be converted to MessagePack.
+     * 
+     * @param[in] fileName  Name of the JSON file.
+     * @param[in] doc       JSON document, which shall contain the loaded content.
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool loadConfig(const String& fileName, JsonDocument& doc);
+
+    /**
+     * Read file, which contains JSON or MessagePack.
+     * 
+     * @param[in] fileName  Name of the file.
+     * @param[in] doc       JSON document, which shall contain the loaded content.
+     * @param[in] isMsgPack If true, the file contains MessagePack otherwise JSON.
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readFile(const String& fileName, JsonDocument& doc, bool isMsgPack);
+
+    /**
+     * Write file as pretty printed JSON or MessagePack. The file is written
+     * to a temporary file first, which replaces the file afterwards. This way
+     * a power loss during writing doesn't destroy the old file.
+     * 
+     * @param[in] fileName  Name of the file.
+     * @param[in] doc       JSON document, which contain the content to save.
+     * @param[in] isMsgPack If true, the file will contain MessagePack otherwise JSON.
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeFile(const String& fileName, const JsonDocument& doc, bool isMsgPack);
 };
 
 /******************************************************************************
@@ -0,0 +1,608 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Incremental JSON stream filter
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JsonStreamFilter.h"
+
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+JsonStreamFilter::JsonStreamFilter(size_t bufferSize, size_t filterSize) :
+    m_buffer(new(std::nothrow) char[bufferSize]),
+    m_bufferSize(0U),
+    m_wrIndex(0U),
+    m_filterDoc(filterSize),
+    m_filter(),
+    m_state(STATE_VALUE),
+    m_levels(),
+    m_depth(0U),
+    m_key(),
+    m_keyLength(0U),
+    m_isKeyTruncated(false),
+    m_isOverflow(false),
+    m_isCopy(false),
+    m_isEscaped(false),
+    m_isInString(false),
+    m_containerDepth(0U)
+{
+    if (nullptr != m_buffer)
+    {
+        m_bufferSize = bufferSize;
+    }
+}
+
+JsonStreamFilter::~JsonStreamFilter()
+{
+    if (nullptr != m_buffer)
+    {
+        delete[] m_buffer;
+        m_buffer = nullptr;
+    }
+}
+
+bool JsonStreamFilter::begin(JsonVariantConst filter)
+{
+    bool isSuccessful = m_filterDoc.set(filter);
+
+    m_filter            = m_filterDoc.as<JsonVariantConst>();
+    m_state             = (true == isSuccessful) ? STATE_VALUE : STATE_ERROR;
+    m_wrIndex           = 0U;
+    m_depth             = 0U;
+    m_key[0]            = '\0';
+    m_keyLength         = 0U;
+    m_isKeyTruncated    = false;
+    m_isOverflow        = false;
+    m_isCopy            = false;
+    m_isEscaped         = false;
+    m_isInString        = false;
+    m_containerDepth    = 0U;
+
+    return isSuccessful;
+}
+
+bool JsonStreamFilter::write(const uint8_t* data, size_t size)
+{
+    size_t index = 0U;
+
+    if (nullptr == data)
+    {
+        size = 0U;
+    }
+
+    while((size > index) && (STATE_ERROR != m_state))
+    {
+        process(static_cast<char>(data[index]));
+
+        if (true == m_isOverflow)
+        {
+            m_state = STATE_ERROR;
+        }
+
+        ++index;
+    }
+
+    return (STATE_ERROR != m_state);
+}
+
+DeserializationError JsonStreamFilter::deserialize(JsonDocument& doc) const
+{
+    DeserializationError error = DeserializationError::IncompleteInput;
+
+    if (true == m_isOverflow)
+    {
+        error = DeserializationError::NoMemory;
+    }
+    else if (STATE_ERROR == m_state)
+    {
+        error = DeserializationError::InvalidInput;
+    }
+    else if (STATE_DONE == m_state)
+    {
+        error = deserializeJson(doc, m_buffer, m_wrIndex);
+    }
+    else
+    {
+        ;
+    }
+
+    return error;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void JsonStreamFilter::process(char c)
+{
+    switch(m_state)
+    {
+    case STATE_VALUE:
+        if (true == isWhitespace(c))
+        {
+            ;
+        }
+        /* Empty array? */
+        else if ((']' == c) &&
+                 (0U < m_depth) &&
+                 (false == m_levels[m_depth - 1U].isObject))
+        {
+            handleNext(c);
+        }
+        else
+        {
+            beginValue(c);
+        }
+        break;
+
+    case STATE_STRING:
+        if (true == m_isCopy)
+        {
+            writeChar(c);
+        }
+
+        if (true == m_isEscaped)
+        {
+            m_isEscaped = false;
+        }
+        else if ('\\' == c)
+        {
+            m_isEscaped = true;
+        }
+        else if ('"' == c)
+        {
+            endValue();
+        }
+        else
+        {
+            ;
+        }
+        break;
+
+    case STATE_LITERAL:
+        if ((true == isWhitespace(c)) ||
+            (',' == c) ||
+            ('}' == c) ||
+            (']' == c))
+        {
+            endValue();
+
+            /* The character belongs already to the next part. */
+            process(c);
+        }
+        else if (true == m_isCopy)
+        {
+            writeChar(c);
+        }
+        else
+        {
+            ;
+        }
+        break;
+
+    case STATE_CONTAINER:
+        if (true == m_isInString)
+        {
+            if (true == m_isEscaped)
+            {
+                m_isEscaped = false;
+            }
+            else if ('\\' == c)
+            {
+                m_isEscaped = true;
+            }
+            else if ('"' == c)
+            {
+                m_isInString = false;
+            }
+            else
+            {
+                ;
+            }
+        }
+        /* Whitespace outside of strings is never copied. */
+        else if (true == isWhitespace(c))
+        {
+            break;
+        }
+        else if ('"' == c)
+        {
+            m_isInString = true;
+        }
+        else if (('{' == c) || ('[' == c))
+        {
+            ++m_containerDepth;
+        }
+        else if (('}' == c) || (']' == c))
+        {
+            --m_containerDepth;
+        }
+        else
+        {
+            ;
+        }
+
+        if (true == m_isCopy)
+        {
+            writeChar(c);
+        }
+
+        if (0U == m_containerDepth)
+        {
+            endValue();
+        }
+        break;
+
+    case STATE_KEY_OR_END:
+        if (true == isWhitespace(c))
+        {
+            ;
+        }
+        else if ('"' == c)
+        {
+            m_key[0]            = '\0';
+            m_keyLength         = 0U;
+            m_isKeyTruncated    = false;
+            m_isEscaped         = false;
+            m_state             = STATE_KEY;
+        }
+        else if ('}' == c)
+        {
+            handleNext(c);
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_KEY:
+        if ((false == m_isEscaped) &&
+            ('"' == c))
+        {
+            m_state = STATE_COLON;
+        }
+        else
+        {
+            if (true == m_isEscaped)
+            {
+                m_isEscaped = false;
+            }
+            else if ('\\' == c)
+            {
+                m_isEscaped = true;
+            }
+            else
+            {
+                ;
+            }
+
+            if ((MAX_KEY_SIZE - 1U) > m_keyLength)
+            {
+                m_key[m_keyLength] = c;
+                ++m_keyLength;
+                m_key[m_keyLength] = '\0';
+            }
+            else
+            {
+                m_isKeyTruncated = true;
+            }
+        }
+        break;
+
+    case STATE_COLON:
+        if (true == isWhitespace(c))
+        {
+            ;
+        }
+        else if (':' == c)
+        {
+            m_state = STATE_VALUE;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_NEXT:
+        if (false == isWhitespace(c))
+        {
+            handleNext(c);
+        }
+        break;
+
+    case STATE_DONE:
+        /* Anything behind the top level value is ignored. */
+        break;
+
+    case STATE_ERROR:
+        /* Nothing to do anymore. */
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+}
+
+void JsonStreamFilter::beginValue(char c)
+{
+    JsonVariantConst    filter      = getValueFilter();
+    bool                isSelectAll = JsonStreamFilter::isSelectAll(filter);
+
+    if (('{' == c) || ('[' == c))
+    {
+        bool isObject = ('{' == c);
+
+        if (true == isSelectAll)
+        {
+            writeValuePrefix();
+            writeChar(c);
+
+            m_isCopy            = true;
+            m_isInString        = false;
+            m_isEscaped         = false;
+            m_containerDepth    = 1U;
+            m_state             = STATE_CONTAINER;
+        }
+        else if (((true == isObject) && (true == filter.is<JsonObjectConst>())) ||
+                 ((false == isObject) && (true == filter.is<JsonArrayConst>())))
+        {
+            if (MAX_DEPTH <= m_depth)
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                writeValuePrefix();
+                writeChar(c);
+
+                m_levels[m_depth].isObject  = isObject;
+                m_levels[m_depth].hasValues = false;
+                m_levels[m_depth].filter    = filter;
+                ++m_depth;
+
+                m_state = (true == isObject) ? STATE_KEY_OR_END : STATE_VALUE;
+            }
+        }
+        else
+        {
+            m_isCopy            = false;
+            m_isInString        = false;
+            m_isEscaped         = false;
+            m_containerDepth    = 1U;
+            m_state             = STATE_CONTAINER;
+        }
+    }
+    /* Top level value must be a object or array. */
+    else if (0U == m_depth)
+    {
+        m_state = STATE_ERROR;
+    }
+    else if ('"' == c)
+    {
+        m_isCopy    = isSelectAll;
+        m_isEscaped = false;
+
+        if (true == m_isCopy)
+        {
+            writeValuePrefix();
+            writeChar(c);
+        }
+
+        m_state = STATE_STRING;
+    }
+    else if (('-' == c) ||
+             (('0' <= c) && ('9' >= c)) ||
+             ('t' == c) ||
+             ('f' == c) ||
+             ('n' == c))
+    {
+        m_isCopy = isSelectAll;
+
+        if (true == m_isCopy)
+        {
+            writeValuePrefix();
+            writeChar(c);
+        }
+
+        m_state = STATE_LITERAL;
+    }
+    else
+    {
+        m_state = STATE_ERROR;
+    }
+}
+
+void JsonStreamFilter::endValue()
+{
+    m_isCopy = false;
+
+    if (0U == m_depth)
+    {
+        m_state = STATE_DONE;
+    }
+    else
+    {
+        m_state = STATE_NEXT;
+    }
+}
+
+void JsonStreamFilter::handleNext(char c)
+{
+    if (0U == m_depth)
+    {
+        m_state = STATE_ERROR;
+    }
+    else
+    {
+        const Level& level = m_levels[m_depth - 1U];
+
+        if (',' == c)
+        {
+            m_state = (true == level.isObject) ? STATE_KEY_OR_END : STATE_VALUE;
+        }
+        else if ((('}' == c) && (true == level.isObject)) ||
+                 ((']' == c) && (false == level.isObject)))
+        {
+            writeChar(c);
+            --m_depth;
+
+            endValue();
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+    }
+}
+
+JsonVariantConst JsonStreamFilter::getValueFilter() const
+{
+    JsonVariantConst filter;
+
+    if (0U == m_depth)
+    {
+        filter = m_filter;
+    }
+    else
+    {
+        const Level& level = m_levels[m_depth - 1U];
+
+        if (true == isSelectAll(level.filter))
+        {
+            filter = level.filter;
+        }
+        else if (false == level.isObject)
+        {
+            filter = level.filter[static_cast<size_t>(0U)];
+        }
+        /* A truncated key can not be matched and even if selected by
+         * wildcard, it couldn't be copied correctly.
+         */
+        else if (true == m_isKeyTruncated)
+        {
+            ;
+        }
+        else
+        {
+            filter = level.filter[static_cast<const char*>(m_key)];
+
+            if (true == filter.isNull())
+            {
+                filter = level.filter["*"];
+            }
+        }
+    }
+
+    return filter;
+}
+
+void JsonStreamFilter::writeValuePrefix()
+{
+    if (0U < m_depth)
+    {
+        Level& level = m_levels[m_depth - 1U];
+
+        if (true == level.hasValues)
+        {
+            writeChar(',');
+        }
+
+        level.hasValues = true;
+
+        if (true == level.isObject)
+        {
+            size_t index = 0U;
+
+            writeChar('"');
+
+            while(m_keyLength > index)
+            {
+                writeChar(m_key[index]);
+                ++index;
+            }
+
+            writeChar('"');
+            writeChar(':');
+        }
+    }
+}
+
+void JsonStreamFilter::writeChar(char c)
+{
+    if (m_bufferSize > m_wrIndex)
+    {
+        m_buffer[m_wrIndex] = c;
+        ++m_wrIndex;
+    }
+    else
+    {
+        m_isOverflow = true;
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,298 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Incremental JSON stream filter
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef JSON_STREAM_FILTER_H
+#define JSON_STREAM_FILTER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <ArduinoJson.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Incremental JSON stream filter.
+ *
+ * The JSON text is pushed chunk by chunk, e.g. as it arrives from the network.
+ * Only the parts which are selected by the filter are copied into a small
+ * fixed size output buffer, which contains the reduced JSON text afterwards.
+ * Therefore the complete JSON text never needs to be in memory at once.
+ *
+ * The filter follows the ArduinoJson filter rules: A true selects the whole
+ * value, a object selects the listed members ("*" selects every member) and
+ * a array uses its first element as filter for every array element.
+ *
+ * Top level values must be a object or array.
+ *
+ * The filter is copied on begin(), so the caller may change or destroy its
+ * filter while a JSON text is processed.
+ *
+ * The stream filter itself is not thread-safe. If the JSON text is pushed by
+ * a different task, the caller must protect all calls.
+ */
+class JsonStreamFilter
+{
+public:
+
+    /**
+     * Constructs the JSON stream filter.
+     *
+     * @param[in] bufferSize    Size of the output buffer in byte.
+     * @param[in] filterSize    Size of the JSON document in byte, which keeps the copy of the filter.
+     */
+    JsonStreamFilter(size_t bufferSize, size_t filterSize);
+
+    /**
+     * Destroys the JSON stream filter.
+     */
+    ~JsonStreamFilter();
+
+    /**
+     * Start a new JSON text with the given filter.
+     * The filter is copied, therefore it doesn't need to be kept alive.
+     *
+     * @param[in] filter    Filter
+     *
+     * @return If the filter is copied successful, it will return true otherwise false.
+     */
+    bool begin(JsonVariantConst filter);
+
+    /**
+     * Push the next part of the JSON text.
+     *
+     * @param[in] data  JSON text part
+     * @param[in] size  JSON text part size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool write(const uint8_t* data, size_t size);
+
+    /**
+     * Is the JSON text complete?
+     *
+     * @return If complete, it will return true otherwise false.
+     */
+    bool isComplete() const
+    {
+        return (STATE_DONE == m_state);
+    }
+
+    /**
+     * Is the filter in error state, e.g. because of a syntax error or
+     * because the output buffer is too small?
+     *
+     * @return If an error happened, it will return true otherwise false.
+     */
+    bool isError() const
+    {
+        return (STATE_ERROR == m_state);
+    }
+
+    /**
+     * Get the filtered JSON text.
+     *
+     * @param[out] size Size of the filtered JSON text in byte.
+     *
+     * @return Filtered JSON text, not null terminated.
+     */
+    const char* getOutput(size_t& size) const
+    {
+        size = m_wrIndex;
+
+        return m_buffer;
+    }
+
+    /**
+     * Deserialize the filtered JSON text into a JSON document.
+     *
+     * @param[out] doc  JSON document
+     *
+     * @return Deserialization result
+     */
+    DeserializationError deserialize(JsonDocument& doc) const;
+
+private:
+
+    /**
+     * Max. nesting depth of the selected JSON containers.
+     * Not selected containers are skipped without any nesting limit.
+     */
+    static const size_t MAX_DEPTH       = 8U;
+
+    /**
+     * Max. length of a object member key, incl. string termination.
+     */
+    static const size_t MAX_KEY_SIZE    = 32U;
+
+    /**
+     * Parser states.
+     */
+    enum State
+    {
+        STATE_VALUE = 0,    /**< Expecting a value. */
+        STATE_STRING,       /**< Inside a string value. */
+        STATE_LITERAL,      /**< Inside a number or true, false, null literal. */
+        STATE_CONTAINER,    /**< Inside a completely copied or completely skipped object/array. */
+        STATE_KEY_OR_END,   /**< Expecting a object member key or the object end. */
+        STATE_KEY,          /**< Inside a object member key. */
+        STATE_COLON,        /**< Expecting the name separator. */
+        STATE_NEXT,         /**< Expecting value separator or container end. */
+        STATE_DONE,         /**< JSON text complete. */
+        STATE_ERROR         /**< Syntax error or output buffer too small. */
+    };
+
+    /**
+     * A selected object or array, which is only partly copied.
+     */
+    struct Level
+    {
+        bool                isObject;   /**< Object (true) or array (false) */
+        bool                hasValues;  /**< Is at least one value already copied? */
+        JsonVariantConst    filter;     /**< Filter of the container */
+    };
+
+    char*               m_buffer;               /**< Output buffer */
+    size_t              m_bufferSize;           /**< Output buffer size in byte */
+    size_t              m_wrIndex;              /**< Output buffer write index */
+    DynamicJsonDocument m_filterDoc;            /**< Copy of the filter */
+    JsonVariantConst    m_filter;               /**< Root filter */
+    State               m_state;                /**< Current parser state */
+    Level               m_levels[MAX_DEPTH];    /**< Selected containers */
+    size_t              m_depth;                /**< Number of selected containers */
+    char                m_key[MAX_KEY_SIZE];    /**< Current object member key */
+    size_t              m_keyLength;            /**< Current object member key length */
+    bool                m_isKeyTruncated;       /**< Is key longer than the key buffer? */
+    bool                m_isOverflow;           /**< Output buffer too small? */
+    bool                m_isCopy;               /**< Is the current value copied (true) or skipped (false)? */
+    bool                m_isEscaped;            /**< Last string character was a escape character. */
+    bool                m_isInString;           /**< Inside a string of a copied/skipped container? */
+    size_t              m_containerDepth;       /**< Nesting depth of a copied/skipped container */
+
+    JsonStreamFilter();
+    JsonStreamFilter(const JsonStreamFilter& filter);
+    JsonStreamFilter& operator=(const JsonStreamFilter& filter);
+
+    /**
+     * Process a single character.
+     *
+     * @param[in] c Character
+     */
+    void process(char c);
+
+    /**
+     * Begin a new value, which starts with the given character.
+     *
+     * @param[in] c First character of the value
+     */
+    void beginValue(char c);
+
+    /**
+     * Finish the current value.
+     */
+    void endValue();
+
+    /**
+     * Handle the value separator or the end of a selected container.
+     *
+     * @param[in] c Character
+     */
+    void handleNext(char c);
+
+    /**
+     * Get the filter for the next value, considering the current container
+     * and member key.
+     *
+     * @return Filter
+     */
+    JsonVariantConst getValueFilter() const;
+
+    /**
+     * Write the separator and member key for the next value in the current
+     * selected container.
+     */
+    void writeValuePrefix();
+
+    /**
+     * Write a single character to the output buffer.
+     *
+     * @param[in] c Character
+     */
+    void writeChar(char c);
+
+    /**
+     * Is the character a JSON whitespace?
+     *
+     * @param[in] c Character
+     *
+     * @return If whitespace, it will return true otherwise false.
+     */
+    static bool isWhitespace(char c)
+    {
+        return ((' ' == c) || ('\t' == c) || ('\r' == c) || ('\n' == c));
+    }
+
+    /**
+     * Does the filter select the whole value?
+     *
+     * @param[in] filter    Filter
+     *
+     * @return If whole value is selected, it will return true otherwise false.
+     */
+    static bool isSelectAll(JsonVariantConst filter)
+    {
+        return ((true == filter.is<bool>()) && (true == filter.as<bool>()));
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* JSON_STREAM_FILTER_H */
+
+/** @} */
@@ -0,0 +1,123 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary log argument encoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LogArgEncoder.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void LogArgEncoder::add(const char* value)
+{
+    const char* str = (nullptr == value) ? "(null)" : value;
+    size_t      len = strlen(str);
+
+    if (m_size <= m_pos)
+    {
+        m_isOverflow = true;
+    }
+    else
+    {
+        /* Cut the string, if necessary. */
+        if ((m_size - m_pos - 1U) < len)
+        {
+            len = m_size - m_pos - 1U;
+        }
+
+        if (UINT8_MAX < len)
+        {
+            len = UINT8_MAX;
+        }
+
+        m_buffer[m_pos] = static_cast<uint8_t>(len);
+        ++m_pos;
+
+        memcpy(&m_buffer[m_pos], str, len);
+        m_pos += len;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void LogArgEncoder::addInteger(uint64_t value, size_t size)
+{
+    if ((m_size - m_pos) < size)
+    {
+        m_isOverflow = true;
+    }
+    else
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < size; ++idx)
+        {
+            m_buffer[m_pos] = static_cast<uint8_t>((value >> (idx * 8U)) & 0xffU);
+            ++m_pos;
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,324 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary log argument encoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef LOG_ARG_ENCODER_H
+#define LOG_ARG_ENCODER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Encodes the raw arguments of a log message for the binary log mode.
+ * The arguments are formatted later by the host decoder, which derives
+ * the argument types from the format string:
+ * - Integers and pointers up to 32 bit: 4 byte, little endian.
+ * - 64 bit integers: 8 byte, little endian.
+ * - Floating point numbers: 8 byte (double), little endian.
+ * - Strings: 1 byte length, followed by the characters without termination.
+ *
+ * If the buffer is full, further arguments are skipped and the
+ * overflow is flagged.
+ */
+class LogArgEncoder
+{
+public:
+
+    /**
+     * Constructs the encoder.
+     *
+     * @param[in] buffer    Buffer for the encoded arguments
+     * @param[in] size      Buffer size in byte
+     */
+    LogArgEncoder(uint8_t* buffer, size_t size) :
+        m_buffer(buffer),
+        m_size(size),
+        m_pos(0U),
+        m_isOverflow(false)
+    {
+    }
+
+    /**
+     * Destroys the encoder.
+     */
+    ~LogArgEncoder()
+    {
+    }
+
+    /**
+     * Add a character argument.
+     *
+     * @param[in] value Value
+     */
+    void add(char value)
+    {
+        addInteger(static_cast<uint32_t>(static_cast<uint8_t>(value)), 4U);
+    }
+
+    /**
+     * Add a signed character argument.
+     *
+     * @param[in] value Value
+     */
+    void add(signed char value)
+    {
+        addInteger(static_cast<uint32_t>(static_cast<int32_t>(value)), 4U);
+    }
+
+    /**
+     * Add an unsigned character argument.
+     *
+     * @param[in] value Value
+     */
+    void add(unsigned char value)
+    {
+        addInteger(value, 4U);
+    }
+
+    /**
+     * Add a boolean argument.
+     *
+     * @param[in] value Value
+     */
+    void add(bool value)
+    {
+        addInteger((true == value) ? 1U : 0U, 4U);
+    }
+
+    /**
+     * Add a short argument.
+     *
+     * @param[in] value Value
+     */
+    void add(short value)
+    {
+        addInteger(static_cast<uint32_t>(static_cast<int32_t>(value)), 4U);
+    }
+
+    /**
+     * Add an unsigned short argument.
+     *
+     * @param[in] value Value
+     */
+    void add(unsigned short value)
+    {
+        addInteger(value, 4U);
+    }
+
+    /**
+     * Add an integer argument.
+     *
+     * @param[in] value Value
+     */
+    void add(int value)
+    {
+        addInteger(static_cast<uint64_t>(static_cast<int64_t>(value)), sizeof(value));
+    }
+
+    /**
+     * Add an unsigned integer argument.
+     *
+     * @param[in] value Value
+     */
+    void add(unsigned int value)
+    {
+        addInteger(value, sizeof(value));
+    }
+
+    /**
+     * Add a long argument.
+     *
+     * @param[in] value Value
+     */
+    void add(long value)
+    {
+        addInteger(static_cast<uint64_t>(static_cast<int64_t>(value)), sizeof(value));
+    }
+
+    /**
+     * Add an unsigned long argument.
+     *
+     * @param[in] value Value
+     */
+    void add(unsigned long value)
+    {
+        addInteger(value, sizeof(value));
+    }
+
+    /**
+     * Add a long long argument.
+     *
+     * @param[in] value Value
+     */
+    void add(long long value)
+    {
+        addInteger(static_cast<uint64_t>(value), sizeof(value));
+    }
+
+    /**
+     * Add an unsigned long long argument.
+     *
+     * @param[in] value Value
+     */
+    void add(unsigned long long value)
+    {
+        addInteger(value, sizeof(value));
+    }
+
+    /**
+     * Add a floating point argument.
+     *
+     * @param[in] value Value
+     */
+    void add(double value)
+    {
+        uint64_t raw = 0U;
+
+        memcpy(&raw, &value, sizeof(raw));
+        addInteger(raw, sizeof(raw));
+    }
+
+    /**
+     * Add a string argument.
+     *
+     * @param[in] value Value
+     */
+    void add(const char* value);
+
+    /**
+     * Add a string argument.
+     *
+     * @param[in] value Value
+     */
+    void add(const String& value)
+    {
+        add(value.c_str());
+    }
+
+    /**
+     * Add a pointer argument.
+     *
+     * @param[in] value Value
+     */
+    void add(const void* value)
+    {
+        addInteger(reinterpret_cast<uintptr_t>(value), 4U);
+    }
+
+    /**
+     * Add all arguments.
+     */
+    void addAll()
+    {
+        /* Nothing to do. */
+    }
+
+    /**
+     * Add all arguments.
+     *
+     * @tparam T        Type of the first argument
+     * @tparam Args     Types of the further arguments
+     * @param[in] arg   First argument
+     * @param[in] args  Further arguments
+     */
+    template < typename T, typename... Args >
+    void addAll(const T& arg, const Args&... args)
+    {
+        add(arg);
+        addAll(args...);
+    }
+
+    /**
+     * Get number of encoded bytes.
+     *
+     * @return Number of encoded bytes.
+     */
+    size_t getSize() const
+    {
+        return m_pos;
+    }
+
+    /**
+     * Is any argument skipped, because the buffer is full?
+     *
+     * @return If overflow happened, it will return true otherwise false.
+     */
+    bool isOverflow() const
+    {
+        return m_isOverflow;
+    }
+
+private:
+
+    uint8_t*    m_buffer;       /**< Buffer for the encoded arguments */
+    size_t      m_size;         /**< Buffer size in byte */
+    size_t      m_pos;          /**< Current write position */
+    bool        m_isOverflow;   /**< Buffer overflow flag */
+
+    /**
+     * Add an integer value in little endian order.
+     *
+     * @param[in] value Value
+     * @param[in] size  Size in byte (4 or 8)
+     */
+    void addInteger(uint64_t value, size_t size);
+
+    LogArgEncoder();
+    LogArgEncoder(const LogArgEncoder& encoder);
+    LogArgEncoder& operator=(const LogArgEncoder& encoder);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* LOG_ARG_ENCODER_H */
+
+/** @} */
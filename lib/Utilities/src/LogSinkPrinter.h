@@ -136,6 +136,24 @@ public:
      */
     void send(const Logging::Msg& msg) final;
 
+    /**
+     * Send a binary log message frame to this sink.
+     *
+     * @param[in] data  Frame data
+     * @param[in] size  Frame size in byte
+     *
+     * @return Binary log messages are supported, therefore it will always return true.
+     */
+    bool sendBinary(const uint8_t* data, size_t size) final
+    {
+        if (nullptr != m_output)
+        {
+            (void)m_output->write(data, size);
+        }
+
+        return true;
+    }
+
     /** Maximum timestamp string length. */
     static const uint32_t   TIMESTAMP_LEN   = 10U;
 
@@ -33,6 +33,11 @@
  * Includes
  *****************************************************************************/
 #include "Logging.h"
+#include "Util.h"
+
+#ifndef NATIVE
+#include <soc/soc_memory_layout.h>
+#endif  /* NATIVE */
 
 /******************************************************************************
  * Compiler Switches
@@ -145,18 +150,20 @@ Logging::LogLevel Logging::getLogLevel() const
 
 void Logging::processLogMessage(const char* file, int line, const Logging::LogLevel messageLogLevel, const char* format, ...)
 {
+    const char* basename = getBaseNameFromPath(file);
+
     if ((true == isSeverityEnabled(messageLogLevel)) &&
-        (nullptr != m_selectedSink))
+        (nullptr != m_selectedSink) &&
+        (false == isRateLimited(basename, messageLogLevel)))
     {
-        char            buffer[MESSAGE_BUFFER_SIZE];
         int             written             = 0;
         const char*     STR_CUT_OFF_SEQ     = "...";
         const uint16_t  STR_CUT_OFF_SEQ_LEN = strlen(STR_CUT_OFF_SEQ);
         va_list         args;
-        Msg             msg;
+        Record          record;
 
         va_start(args, format);
-        written = vsnprintf(buffer, MESSAGE_BUFFER_SIZE - STR_CUT_OFF_SEQ_LEN, format, args); /* NOLINT(clang-analyzer-valist.Uninitialized) */
+        written = vsnprintf(record.str, MESSAGE_BUFFER_SIZE - STR_CUT_OFF_SEQ_LEN, format, args); /* NOLINT(clang-analyzer-valist.Uninitialized) */
         va_end(args);
 
         /* If buffer was too small or any other error happended, it shall be shown in the
@@ -165,16 +172,15 @@ void Logging::processLogMessage(const char* file, int line, const Logging::LogLe
         if ((0 > written) ||
             ((MESSAGE_BUFFER_SIZE - STR_CUT_OFF_SEQ_LEN) <= written))
         {
-            strncat(buffer, STR_CUT_OFF_SEQ, MESSAGE_BUFFER_SIZE - strlen(buffer) - 1U);
+            strncat(record.str, STR_CUT_OFF_SEQ, MESSAGE_BUFFER_SIZE - strlen(record.str) - 1U);
         }
 
-        msg.timestamp   = esp_log_timestamp();
-        msg.level       = messageLogLevel;
-        msg.filename    = getBaseNameFromPath(file);
-        msg.line        = line;
-        msg.str         = buffer;
+        record.timestamp    = esp_log_timestamp();
+        record.level        = messageLogLevel;
+        record.line         = line;
+        (void)strncpy(record.filename, (nullptr != basename) ? basename : "", FILENAME_BUFFER_SIZE - 1U);
 
-        m_selectedSink->send(msg);
+        dispatch(record);
     }
     else
     {
@@ -184,18 +190,21 @@ void Logging::processLogMessage(const char* file, int line, const Logging::LogLe
 
 void Logging::processLogMessage(const char* file, int line, const Logging::LogLevel messageLogLevel, const String& message)
 {
+    const char* basename = getBaseNameFromPath(file);
+
     if ((true == isSeverityEnabled(messageLogLevel)) &&
-        (nullptr != m_selectedSink))
+        (nullptr != m_selectedSink) &&
+        (false == isRateLimited(basename, messageLogLevel)))
     {
-        Msg msg;
+        Record record;
 
-        msg.timestamp   = esp_log_timestamp();
-        msg.level       = messageLogLevel;
-        msg.filename    = getBaseNameFromPath(file);
-        msg.line        = line;
-        msg.str         = message.c_str();
+        record.timestamp    = esp_log_timestamp();
+        record.level        = messageLogLevel;
+        record.line         = line;
+        (void)strncpy(record.filename, (nullptr != basename) ? basename : "", FILENAME_BUFFER_SIZE - 1U);
+        (void)strncpy(record.str, message.c_str(), MESSAGE_BUFFER_SIZE - 1U);
 
-        m_selectedSink->send(msg);
+        dispatch(record);
     }
     else
     {
@@ -206,17 +215,18 @@ void Logging::processLogMessage(const char* file, int line, const Logging::LogLe
 void Logging::processLogMessage(uint32_t timestamp, const String& logger, const LogLevel messageLogLevel, const String& message)
 {
     if ((true == isSeverityEnabled(messageLogLevel)) &&
-        (nullptr != m_selectedSink))
+        (nullptr != m_selectedSink) &&
+        (false == isRateLimited(logger.c_str(), messageLogLevel)))
     {
-        Msg msg;
+        Record record;
 
-        msg.timestamp   = timestamp;
-        msg.level       = messageLogLevel;
-        msg.filename    = logger.c_str();
-        msg.line        = 0;
-        msg.str         = message.c_str();
+        record.timestamp    = timestamp;
+        record.level        = messageLogLevel;
+        record.line         = 0;
+        (void)strncpy(record.filename, logger.c_str(), FILENAME_BUFFER_SIZE - 1U);
+        (void)strncpy(record.str, message.c_str(), MESSAGE_BUFFER_SIZE - 1U);
 
-        m_selectedSink->send(msg);
+        dispatch(record);
     }
     else
     {
@@ -224,6 +234,66 @@ void Logging::processLogMessage(uint32_t timestamp, const String& logger, const
     }
 }
 
+bool Logging::startAsync()
+{
+    bool isSuccessful = false;
+
+#ifndef NATIVE
+
+    if (nullptr == m_drainTaskHandle)
+    {
+        BaseType_t osRet = pdFAIL;
+
+        m_drainTaskExit = false;
+
+        /* Lowest application priority, so it never disturbs the timing of other tasks. */
+        osRet = xTaskCreateUniversal(   drainTask,
+                                        "logDrainTask",
+                                        DRAIN_TASK_STACK_SIZE,
+                                        this,
+                                        tskIDLE_PRIORITY + 1U,
+                                        &m_drainTaskHandle,
+                                        tskNO_AFFINITY);
+
+        if (pdPASS == osRet)
+        {
+            m_isAsync       = true;
+            isSuccessful    = true;
+        }
+        else
+        {
+            m_drainTaskHandle = nullptr;
+        }
+    }
+
+#endif  /* NATIVE */
+
+    return isSuccessful;
+}
+
+void Logging::stopAsync()
+{
+#ifndef NATIVE
+
+    if (nullptr != m_drainTaskHandle)
+    {
+        m_isAsync       = false;
+        m_drainTaskExit = true;
+        xTaskNotifyGive(m_drainTaskHandle);
+
+        /* Wait until the drain task exited. */
+        while(nullptr != m_drainTaskHandle)
+        {
+            vTaskDelay(pdMS_TO_TICKS(1U));
+        }
+
+        /* Log messages, which were queued while stopping. */
+        drain();
+    }
+
+#endif  /* NATIVE */
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -237,6 +307,241 @@ bool Logging::isSeverityEnabled(Logging::LogLevel logLevel) const
     return (logLevel <= m_currentLogLevel);
 }
 
+bool Logging::isRateLimited(const char* module, LogLevel logLevel)
+{
+    bool isLimited = false;
+
+    /* Errors are never suppressed. */
+    if ((0U < CONFIG_LOG_RATE_LIMIT) &&
+        (nullptr != module) &&
+        (LOG_LEVEL_ERROR < logLevel))
+    {
+        /* FNV-1a hash of the module name */
+        uint32_t        hash        = 2166136261U;
+        const char*     ch          = module;
+
+        while('\0' != *ch)
+        {
+            hash ^= static_cast<uint8_t>(*ch);
+            hash *= 16777619U;
+            ++ch;
+        }
+
+        isLimited = isRateLimited(hash, logLevel);
+    }
+
+    return isLimited;
+}
+
+bool Logging::isRateLimited(uint32_t key, LogLevel logLevel)
+{
+    bool isLimited = false;
+
+    /* Errors are never suppressed. */
+    if ((0U < CONFIG_LOG_RATE_LIMIT) &&
+        (LOG_LEVEL_ERROR < logLevel))
+    {
+        uint32_t        timestamp   = millis();
+        RateLimitSlot*  slot        = &m_rateLimitSlots[key % CONFIG_LOG_RATE_LIMIT_SLOTS];
+        uint32_t        windowStart = slot->windowStart.load();
+
+        /* New window? Only the task, which wins the exchange, resets the counter. */
+        if (RATE_LIMIT_WINDOW <= (timestamp - windowStart))
+        {
+            if (true == slot->windowStart.compare_exchange_strong(windowStart, timestamp))
+            {
+                slot->count = 0U;
+            }
+        }
+
+        if (CONFIG_LOG_RATE_LIMIT <= slot->count.fetch_add(1U))
+        {
+            ++m_rateLimitedCount;
+            isLimited = true;
+        }
+    }
+
+    return isLimited;
+}
+
+void Logging::dispatch(const Record& record)
+{
+    if (true == m_isAsync)
+    {
+        if (false == m_ringBuffer.push(record))
+        {
+            ++m_overflowCount;
+        }
+#ifndef NATIVE
+        else if (nullptr != m_drainTaskHandle)
+        {
+            xTaskNotifyGive(m_drainTaskHandle);
+        }
+#endif  /* NATIVE */
+        else
+        {
+            ;
+        }
+    }
+    else
+    {
+        send(record);
+    }
+}
+
+bool Logging::isFirmwareString(const char* str)
+{
+#ifndef NATIVE
+    return esp_ptr_in_drom(str);
+#else   /* NATIVE */
+    (void)str;
+
+    return false;
+#endif  /* NATIVE */
+}
+
+void Logging::sendBinary(LogSink* sink, const Record& record)
+{
+    uint8_t     frame[BINARY_FRAME_HEADER_SIZE + MESSAGE_BUFFER_SIZE];
+    size_t      frameSize   = BINARY_FRAME_HEADER_SIZE + record.size;
+    uint32_t    values[3U]  =
+    {
+        record.timestamp,
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(record.site)),
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(record.format))
+    };
+    size_t      valueIdx    = 0U;
+    size_t      pos         = 2U;
+
+    frame[0U] = BINARY_FRAME_SYNC;
+    frame[1U] = static_cast<uint8_t>(frameSize - 2U);
+
+    for(valueIdx = 0U; valueIdx < UTIL_ARRAY_NUM(values); ++valueIdx)
+    {
+        frame[pos + 0U] = static_cast<uint8_t>(values[valueIdx] & 0xffU);
+        frame[pos + 1U] = static_cast<uint8_t>((values[valueIdx] >> 8U) & 0xffU);
+        frame[pos + 2U] = static_cast<uint8_t>((values[valueIdx] >> 16U) & 0xffU);
+        frame[pos + 3U] = static_cast<uint8_t>((values[valueIdx] >> 24U) & 0xffU);
+
+        pos += 4U;
+    }
+
+    memcpy(&frame[BINARY_FRAME_HEADER_SIZE], record.str, record.size);
+
+    /* Sink doesn't support binary data? Send the frame in hex, which the host decoder accepts too. */
+    if (false == sink->sendBinary(frame, frameSize))
+    {
+        const char  HEX_DIGITS[]    = "0123456789ABCDEF";
+        String      hex;
+        Msg         msg;
+        size_t      idx             = 0U;
+
+        for(idx = 0U; idx < frameSize; ++idx)
+        {
+            hex += HEX_DIGITS[(frame[idx] >> 4U) & 0x0fU];
+            hex += HEX_DIGITS[frame[idx] & 0x0fU];
+        }
+
+        msg.timestamp   = record.timestamp;
+        msg.level       = record.level;
+        msg.filename    = "BINLOG";
+        msg.line        = record.line;
+        msg.str         = hex.c_str();
+
+        sink->send(msg);
+    }
+}
+
+void Logging::send(const Record& record)
+{
+    LogSink* sink = m_selectedSink;
+
+    if (nullptr == sink)
+    {
+        ;
+    }
+    else if (nullptr != record.site)
+    {
+        sendBinary(sink, record);
+    }
+    else
+    {
+        Msg msg;
+
+        msg.timestamp   = record.timestamp;
+        msg.level       = record.level;
+        msg.filename    = record.filename;
+        msg.line        = record.line;
+        msg.str         = record.str;
+
+        sink->send(msg);
+    }
+}
+
+void Logging::drain()
+{
+    Record      record;
+    uint32_t    overflowCount       = m_overflowCount;
+    uint32_t    rateLimitedCount    = m_rateLimitedCount;
+
+    while(true == m_ringBuffer.pop(record))
+    {
+        send(record);
+    }
+
+    /* Report lost log messages, without queueing the report itself. */
+    if (m_reportedOverflowCount != overflowCount)
+    {
+        Record report;
+
+        report.timestamp    = esp_log_timestamp();
+        report.level        = LOG_LEVEL_WARNING;
+        (void)strncpy(report.filename, "Logging", FILENAME_BUFFER_SIZE - 1U);
+        (void)snprintf(report.str, MESSAGE_BUFFER_SIZE, "%u log messages dropped.", overflowCount - m_reportedOverflowCount);
+
+        send(report);
+
+        m_reportedOverflowCount = overflowCount;
+    }
+
+    if (m_reportedRateLimitedCount != rateLimitedCount)
+    {
+        Record report;
+
+        report.timestamp    = esp_log_timestamp();
+        report.level        = LOG_LEVEL_WARNING;
+        (void)strncpy(report.filename, "Logging", FILENAME_BUFFER_SIZE - 1U);
+        (void)snprintf(report.str, MESSAGE_BUFFER_SIZE, "%u log messages suppressed by rate limit.", rateLimitedCount - m_reportedRateLimitedCount);
+
+        send(report);
+
+        m_reportedRateLimitedCount = rateLimitedCount;
+    }
+}
+
+#ifndef NATIVE
+
+void Logging::drainTask(void* parameters)
+{
+    Logging* tthis = static_cast<Logging*>(parameters);
+
+    if (nullptr != tthis)
+    {
+        while(false == tthis->m_drainTaskExit)
+        {
+            (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DRAIN_TASK_PERIOD));
+
+            tthis->drain();
+        }
+
+        tthis->m_drainTaskHandle = nullptr;
+    }
+
+    vTaskDelete(nullptr);
+}
+
+#endif  /* NATIVE */
+
 const char* Logging::getBaseNameFromPath(const char* path) const
 {
     const char* basename = path;
@@ -64,17 +64,72 @@
 #define LOG_TRACE_ENABLE    (0)
 #endif  /* LOG_TRACE_ENABLE */
 
+/**
+ * Max. number of log messages, which are queued for the drain task.
+ * It must be a power of two.
+ */
+#ifndef CONFIG_LOG_QUEUE_SIZE
+#define CONFIG_LOG_QUEUE_SIZE       (32U)
+#endif  /* CONFIG_LOG_QUEUE_SIZE */
+
+/**
+ * Max. number of log messages per second and module (source file).
+ * Fatal errors and errors are never limited. Set it to 0 to disable the rate limit.
+ */
+#ifndef CONFIG_LOG_RATE_LIMIT
+#define CONFIG_LOG_RATE_LIMIT       (20U)
+#endif  /* CONFIG_LOG_RATE_LIMIT */
+
+/**
+ * Number of rate limit slots. The modules are mapped by their name hash to the slots.
+ */
+#ifndef CONFIG_LOG_RATE_LIMIT_SLOTS
+#define CONFIG_LOG_RATE_LIMIT_SLOTS (16U)
+#endif  /* CONFIG_LOG_RATE_LIMIT_SLOTS */
+
+/**
+ * Binary log mode: The log messages are not formatted on the target. Only the
+ * address of the call site, the address of the format string, the timestamp and
+ * the raw arguments are sent. The host decoder (scripts/decode_log.py) formats
+ * them with the strings from the firmware ELF file.
+ */
+#ifndef CONFIG_LOG_BINARY
+#define CONFIG_LOG_BINARY           (0)
+#endif  /* CONFIG_LOG_BINARY */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <atomic>
+
+#include "MpscRingBuffer.hpp"
+#include "LogArgEncoder.h"
+
+#ifndef NATIVE
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif  /* NATIVE */
 
 /******************************************************************************
  * Macros
  *****************************************************************************/
 
+#if (0 == CONFIG_LOG_BINARY)
+
+    /** Format the log message and send it. */
+    #define LOG_MESSAGE(level, ...)     Logging::getInstance().processLogMessage(__FILE__, __LINE__, level, __VA_ARGS__)
+
+#else/* (0 == CONFIG_LOG_BINARY) */
+
+    /** Send the log message in binary form. The call site is stored in flash and identified by its address. */
+    #define LOG_MESSAGE(level, ...)     static const Logging::Site LOG_SITE = { __FILE__, __LINE__, level }; \
+                                        Logging::getInstance().processBinaryLogMessage(&LOG_SITE, __VA_ARGS__)
+
+#endif  /* (0 == CONFIG_LOG_BINARY) */
+
 #if (0 == LOG_FATAL_ENABLE)
 
     #define LOG_FATAL(...)
@@ -82,7 +137,7 @@
 #else/* (0 == LOG_FATAL_ENABLE) */
 
     /** Log fatal error message. */
-    #define LOG_FATAL(...)      do{ Logging::getInstance().processLogMessage(__FILE__, __LINE__, Logging::LOG_LEVEL_FATAL, __VA_ARGS__); }while(0)
+    #define LOG_FATAL(...)      do{ LOG_MESSAGE(Logging::LOG_LEVEL_FATAL, __VA_ARGS__); }while(0)
 
 #endif  /* (0 == LOG_FATAL_ENABLE) */
 
@@ -93,7 +148,7 @@
 #else/* (0 == LOG_ERROR_ENABLE) */
 
     /** Log error message. */
-    #define LOG_ERROR(...)      do{ Logging::getInstance().processLogMessage(__FILE__, __LINE__, Logging::LOG_LEVEL_ERROR, __VA_ARGS__); }while(0)
+    #define LOG_ERROR(...)      do{ LOG_MESSAGE(Logging::LOG_LEVEL_ERROR, __VA_ARGS__); }while(0)
 
 #endif  /* (0 == LOG_ERROR_ENABLE) */
 
@@ -104,7 +159,7 @@
 #else/* (0 == LOG_WARNING_ENABLE) */
 
     /** Log warning message. */
-    #define LOG_WARNING(...)    do{ Logging::getInstance().processLogMessage(__FILE__, __LINE__, Logging::LOG_LEVEL_WARNING, __VA_ARGS__); }while(0)
+    #define LOG_WARNING(...)    do{ LOG_MESSAGE(Logging::LOG_LEVEL_WARNING, __VA_ARGS__); }while(0)
 
 #endif  /* (0 == LOG_WARNING_ENABLE) */
 
@@ -115,7 +170,7 @@
 #else/* (0 == LOG_INFO_ENABLE) */
 
     /** Log info error message. */
-    #define LOG_INFO(...)       do{ Logging::getInstance().processLogMessage(__FILE__, __LINE__, Logging::LOG_LEVEL_INFO, __VA_ARGS__); }while(0)
+    #define LOG_INFO(...)       do{ LOG_MESSAGE(Logging::LOG_LEVEL_INFO, __VA_ARGS__); }while(0)
 
 #endif  /* (0 == LOG_INFO_ENABLE) */
 
@@ -126,7 +181,7 @@
 #else  /* (0 == LOG_DEBUG_ENABLE) */
 
     /** Log debug message. */
-    #define LOG_DEBUG(...)      do{ Logging::getInstance().processLogMessage(__FILE__, __LINE__, Logging::LOG_LEVEL_DEBUG, __VA_ARGS__); }while(0)
+    #define LOG_DEBUG(...)      do{ LOG_MESSAGE(Logging::LOG_LEVEL_DEBUG, __VA_ARGS__); }while(0)
 
 #endif  /* (0 == LOG_DEBUG_ENABLE) */
 
@@ -137,7 +192,7 @@
 #else/* (0 == LOG_TRACE_ENABLE) */
 
     /** Log trace message. */
-    #define LOG_TRACE(...)      do{ Logging::getInstance().processLogMessage(__FILE__, __LINE__, Logging::LOG_LEVEL_TRACE, __VA_ARGS__); }while(0)
+    #define LOG_TRACE(...)      do{ LOG_MESSAGE(Logging::LOG_LEVEL_TRACE, __VA_ARGS__); }while(0)
 
 #endif  /* (0 == LOG_TRACE_ENABLE) */
 
@@ -150,6 +205,12 @@ class LogSink;
 
 /**
  * Logging class for log messages depending on the previously set log level.
+ *
+ * By default the log messages are sent synchronously to the selected sink.
+ * After the asynchronous mode is started, the log messages are copied into a
+ * lock-free ring buffer and a low priority drain task sends them to the
+ * selected sink. So the logging task is not slowed down by the sink.
+ * If the ring buffer is full, the log message is dropped and counted.
  */
 class Logging
 {
@@ -195,6 +256,29 @@ public:
     /** The maximum size of the logMessage buffer to get the variable arguments. */
     static const uint16_t MESSAGE_BUFFER_SIZE   = 80U;
 
+    /** The maximum size of the file name (or logger name) buffer. */
+    static const uint16_t FILENAME_BUFFER_SIZE  = 32U;
+
+    /**
+     * Call site of a log message for the binary log mode.
+     * The host decoder reads it from the firmware ELF file.
+     */
+    struct Site
+    {
+        const char* file;   /**< Full path of the file */
+        int         line;   /**< Line number in the file */
+        LogLevel    level;  /**< Log level */
+    };
+
+    /** Binary log frame synchronization byte. */
+    static const uint8_t BINARY_FRAME_SYNC      = 0xA5U;
+
+    /**
+     * Binary log frame header size in byte: Synchronization byte, length of
+     * the following data, timestamp, call site address and format string address.
+     */
+    static const uint8_t BINARY_FRAME_HEADER_SIZE = 14U;
+
     /**
      * Get the Logging instance.
      *
@@ -293,11 +377,166 @@ public:
      */
     void processLogMessage(uint32_t timestamp, const String& logger, const LogLevel messageLogLevel, const String& message);
 
+    /**
+     * Write a log message in binary form to the current output,
+     * if the severity is >= the current logLevel, otherwise the logMessage is discarded.
+     * The message is not formatted, only the raw arguments are stored.
+     *
+     * @tparam Args             Types of the variable arguments
+     * @param[in] site          Call site
+     * @param[in] format        The format of the variable arguments.
+     * @param[in] args          The variable arguments.
+     *
+     * @note The max. size of the encoded arguments is restricted by MESSAGE_BUFFER_SIZE.
+     */
+    template < typename... Args >
+    void processBinaryLogMessage(const Site* site, const char* format, const Args&... args)
+    {
+        if ((nullptr != site) &&
+            (true == isSeverityEnabled(site->level)) &&
+            (nullptr != m_selectedSink) &&
+            (false == isRateLimited(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(site->file)), site->level)))
+        {
+            Record          record;
+            const void*     vBuffer = record.str;
+            LogArgEncoder   encoder(static_cast<uint8_t*>(const_cast<void*>(vBuffer)), MESSAGE_BUFFER_SIZE);
+
+            record.timestamp    = esp_log_timestamp();
+            record.level        = site->level;
+            record.line         = site->line;
+            record.site         = site;
+
+            /* A format string, which is not part of the firmware, is sent inline. */
+            if (true == isFirmwareString(format))
+            {
+                record.format = format;
+            }
+            else
+            {
+                encoder.add(format);
+            }
+
+            encoder.addAll(args...);
+            record.size = static_cast<uint8_t>(encoder.getSize());
+
+            dispatch(record);
+        }
+    }
+
+    /**
+     * Write a log message in binary form to the current output,
+     * if the severity is >= the current logLevel, otherwise the logMessage is discarded.
+     * The message is sent inline.
+     *
+     * @param[in] site          Call site
+     * @param[in] message       The message as string.
+     *
+     * @note The max. size of a logMessage is restricted by MESSAGE_BUFFER_SIZE.
+     */
+    void processBinaryLogMessage(const Site* site, const String& message)
+    {
+        processBinaryLogMessage(site, message.c_str());
+    }
+
+    /**
+     * Start the asynchronous mode, which sends the log messages by a low
+     * priority drain task.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool startAsync();
+
+    /**
+     * Stop the asynchronous mode. All queued log messages are sent before.
+     */
+    void stopAsync();
+
+    /**
+     * Get the number of log messages, which were dropped because the
+     * ring buffer was full.
+     *
+     * @return Number of dropped log messages
+     */
+    uint32_t getOverflowCount() const
+    {
+        return m_overflowCount.load();
+    }
+
+    /**
+     * Get the number of log messages, which were suppressed by the rate limit.
+     *
+     * @return Number of suppressed log messages
+     */
+    uint32_t getRateLimitedCount() const
+    {
+        return m_rateLimitedCount.load();
+    }
+
     /** Number of supported log sinks. */
     static const uint8_t MAX_SINKS = 2U;
 
 private:
 
+    /**
+     * A queued log message. In contrast to Msg it contains copies of the strings.
+     */
+    struct Record
+    {
+        uint32_t    timestamp;                          /**< Timestamp in ms */
+        LogLevel    level;                              /**< Log level */
+        int         line;                               /**< Line number in the file */
+        const Site* site;                               /**< Binary: Call site, otherwise nullptr */
+        const char* format;                             /**< Binary: Format string, nullptr if inline */
+        uint8_t     size;                               /**< Binary: Size of the encoded arguments in byte */
+        char        filename[FILENAME_BUFFER_SIZE];     /**< Name of the file or logger */
+        char        str[MESSAGE_BUFFER_SIZE];           /**< Message text or binary: encoded arguments */
+
+        /**
+         * Initializes a empty record.
+         */
+        Record() :
+            timestamp(0U),
+            level(LOG_LEVEL_INFO),
+            line(0),
+            site(nullptr),
+            format(nullptr),
+            size(0U),
+            filename(),
+            str()
+        {
+        }
+    };
+
+    /**
+     * Rate limit of the modules, which are mapped to this slot.
+     */
+    struct RateLimitSlot
+    {
+        std::atomic<uint32_t>   windowStart;    /**< Start of the current 1 s window in ms */
+        std::atomic<uint32_t>   count;          /**< Number of log messages in the current window */
+
+        /**
+         * Initializes the slot.
+         */
+        RateLimitSlot() :
+            windowStart(0U),
+            count(0U)
+        {
+        }
+    };
+
+    /** Ring buffer for the asynchronous mode. */
+    typedef MpscRingBuffer<Record, CONFIG_LOG_QUEUE_SIZE> RecordRingBuffer;
+
+    /** Drain task stack size in bytes. */
+    static const uint32_t   DRAIN_TASK_STACK_SIZE   = 4096U;
+
+    /** Drain task period in ms, if it is not notified. */
+    static const uint32_t   DRAIN_TASK_PERIOD       = 100U;
+
+    /** Rate limit window in ms. */
+    static const uint32_t   RATE_LIMIT_WINDOW       = 1000U;
+
     /** The current log level. */
     LogLevel    m_currentLogLevel;
 
@@ -307,6 +546,37 @@ private:
     /** Active sink */
     LogSink*    m_selectedSink;
 
+    /** Queued log messages for the drain task */
+    RecordRingBuffer        m_ringBuffer;
+
+    /** Is the asynchronous mode active? */
+    std::atomic<bool>       m_isAsync;
+
+    /** Number of dropped log messages, because of a full ring buffer. */
+    std::atomic<uint32_t>   m_overflowCount;
+
+    /** Number of suppressed log messages by the rate limit. */
+    std::atomic<uint32_t>   m_rateLimitedCount;
+
+    /** Number of reported dropped log messages. */
+    uint32_t                m_reportedOverflowCount;
+
+    /** Number of reported suppressed log messages. */
+    uint32_t                m_reportedRateLimitedCount;
+
+    /** Rate limit slots */
+    RateLimitSlot           m_rateLimitSlots[CONFIG_LOG_RATE_LIMIT_SLOTS];
+
+#ifndef NATIVE
+
+    /** Drain task handle */
+    TaskHandle_t            m_drainTaskHandle;
+
+    /** Request the drain task to exit. */
+    std::atomic<bool>       m_drainTaskExit;
+
+#endif  /* NATIVE */
+
     /**
      * Checks wether the given severity of a logMessage is enabled to be printed.
      *
@@ -325,13 +595,95 @@ private:
     */
     const char* getBaseNameFromPath(const char* path) const;
 
+    /**
+     * Checks whether the log message of the module exceeds the rate limit.
+     *
+     * @param[in] module    Module name (file name or logger name)
+     * @param[in] logLevel  The logLevel of the message.
+     *
+     * @return If the log message shall be suppressed, it will return true otherwise false.
+     */
+    bool isRateLimited(const char* module, LogLevel logLevel);
+
+    /**
+     * Checks whether the log message of the module exceeds the rate limit.
+     *
+     * @param[in] key       Key of the module, e.g. a hash of its name.
+     * @param[in] logLevel  The logLevel of the message.
+     *
+     * @return If the log message shall be suppressed, it will return true otherwise false.
+     */
+    bool isRateLimited(uint32_t key, LogLevel logLevel);
+
+    /**
+     * Checks whether the string is part of the firmware (flash), which
+     * is required to let the host decoder find it in the ELF file.
+     *
+     * @param[in] str   String
+     *
+     * @return If the string is part of the firmware, it will return true otherwise false.
+     */
+    static bool isFirmwareString(const char* str);
+
+    /**
+     * Send the binary log message to the selected sink. If the sink doesn't
+     * support binary data, the log message frame is sent in hex.
+     *
+     * @param[in] sink      Log sink
+     * @param[in] record    Binary log message
+     */
+    void sendBinary(LogSink* sink, const Record& record);
+
+    /**
+     * Send the log message synchronously or queue it for the drain task.
+     *
+     * @param[in] record    Log message
+     */
+    void dispatch(const Record& record);
+
+    /**
+     * Send the log message to the selected sink.
+     *
+     * @param[in] record    Log message
+     */
+    void send(const Record& record);
+
+    /**
+     * Send all queued log messages to the selected sink and report
+     * dropped or suppressed log messages.
+     */
+    void drain();
+
+#ifndef NATIVE
+
+    /**
+     * Drain task, which sends the queued log messages.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void drainTask(void* parameters);
+
+#endif  /* NATIVE */
+
     /**
      * Construct Logging.
      */
     Logging() :
         m_currentLogLevel(LOG_LEVEL_INFO),
         m_sinks(),
-        m_selectedSink(nullptr)
+        m_selectedSink(nullptr),
+        m_ringBuffer(),
+        m_isAsync(false),
+        m_overflowCount(0U),
+        m_rateLimitedCount(0U),
+        m_reportedOverflowCount(0U),
+        m_reportedRateLimitedCount(0U),
+        m_rateLimitSlots()
+#ifndef NATIVE
+        ,
+        m_drainTaskHandle(nullptr),
+        m_drainTaskExit(false)
+#endif  /* NATIVE */
     {
         uint8_t index = 0U;
 
@@ -389,6 +741,22 @@ public:
      */
     virtual void send(const Logging::Msg& msg) = 0;
 
+    /**
+     * Send a binary log message frame to this sink.
+     *
+     * @param[in] data  Frame data
+     * @param[in] size  Frame size in byte
+     *
+     * @return If the sink supports binary log messages, it will return true otherwise false.
+     */
+    virtual bool sendBinary(const uint8_t* data, size_t size)
+    {
+        (void)data;
+        (void)size;
+
+        return false;
+    }
+
 private:
 };
 
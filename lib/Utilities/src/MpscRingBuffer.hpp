@@ -0,0 +1,244 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free multi-producer single-consumer ring buffer
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef MPSC_RING_BUFFER_HPP
+#define MPSC_RING_BUFFER_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Bounded ring buffer, which can be written by several tasks concurrently
+ * without any lock and is read by a single task.
+ * 
+ * Every element has a sequence number. A writer claims the next write position
+ * by an atomic compare and exchange, copies the value and publishes it by
+ * updating the sequence number. The reader takes only published values.
+ * If the ring buffer is full, the value is rejected instead of waiting.
+ * 
+ * @tparam T    Data type of the values
+ * @tparam size Max. number of values, must be a power of two.
+ */
+template < typename T, size_t size >
+class MpscRingBuffer
+{
+public:
+
+    /**
+     * Constructs an empty ring buffer.
+     */
+    MpscRingBuffer() :
+        m_cells(),
+        m_writePos(0U),
+        m_readPos(0U)
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < size; ++idx)
+        {
+            m_cells[idx].seq.store(idx, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Destroys the ring buffer.
+     */
+    ~MpscRingBuffer()
+    {
+    }
+
+    /**
+     * Write a value to the ring buffer. It can be called by several tasks
+     * concurrently.
+     * 
+     * @param[in] value Value
+     * 
+     * @return If successful written, it will return true otherwise false (full).
+     */
+    bool push(const T& value)
+    {
+        bool    isSuccessful    = false;
+        bool    isFinished      = false;
+        size_t  pos             = m_writePos.load(std::memory_order_relaxed);
+        Cell*   cell            = nullptr;
+
+        while(false == isFinished)
+        {
+            size_t      seq     = 0U;
+            intptr_t    diff    = 0;
+
+            cell    = &m_cells[pos & MASK];
+            seq     = cell->seq.load(std::memory_order_acquire);
+            diff    = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            /* Cell is free, try to claim it. */
+            if (0 == diff)
+            {
+                if (true == m_writePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+                {
+                    isSuccessful    = true;
+                    isFinished      = true;
+                }
+            }
+            /* Cell is not read yet, ring buffer is full. */
+            else if (0 > diff)
+            {
+                isFinished = true;
+            }
+            /* Another writer was faster, try again with the next position. */
+            else
+            {
+                pos = m_writePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (true == isSuccessful)
+        {
+            cell->value = value;
+            cell->seq.store(pos + 1U, std::memory_order_release);
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Read a value from the ring buffer. Only a single task shall read.
+     * 
+     * @param[out] value    Value
+     * 
+     * @return If a value is available, it will return true otherwise false.
+     */
+    bool pop(T& value)
+    {
+        bool    isSuccessful    = false;
+        size_t  pos             = m_readPos.load(std::memory_order_relaxed);
+        Cell*   cell            = &m_cells[pos & MASK];
+        size_t  seq             = cell->seq.load(std::memory_order_acquire);
+
+        /* Value published by the writer? */
+        if (seq == (pos + 1U))
+        {
+            value = cell->value;
+
+            /* Release the cell for the writers of the next round. */
+            cell->seq.store(pos + size, std::memory_order_release);
+            m_readPos.store(pos + 1U, std::memory_order_relaxed);
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Is the ring buffer empty?
+     * 
+     * @return If empty, it will return true otherwise false.
+     */
+    bool isEmpty() const
+    {
+        size_t      pos     = m_readPos.load(std::memory_order_relaxed);
+        const Cell& cell    = m_cells[pos & MASK];
+
+        return (cell.seq.load(std::memory_order_acquire) != (pos + 1U));
+    }
+
+    /**
+     * Get the max. number of values.
+     * 
+     * @return Capacity
+     */
+    size_t getCapacity() const
+    {
+        return size;
+    }
+
+private:
+
+    /* The position is mapped to the cell index by masking. */
+    static_assert((0U < size) && (0U == (size & (size - 1U))), "The size must be a power of two.");
+
+    /** Mask to get the cell index from a position. */
+    static const size_t MASK = size - 1U;
+
+    /**
+     * A single cell of the ring buffer.
+     */
+    struct Cell
+    {
+        std::atomic<size_t> seq;    /**< Sequence number, which synchronizes writer and reader. */
+        T                   value;  /**< Value */
+
+        /**
+         * Constructs a cell.
+         */
+        Cell() :
+            seq(0U),
+            value()
+        {
+        }
+    };
+
+    Cell                m_cells[size];  /**< Cells */
+    std::atomic<size_t> m_writePos;     /**< Next position to write */
+    std::atomic<size_t> m_readPos;      /**< Next position to read */
+
+    MpscRingBuffer(const MpscRingBuffer& buffer);
+    MpscRingBuffer& operator=(const MpscRingBuffer& buffer);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* MPSC_RING_BUFFER_HPP */
+
+/** @} */
@@ -192,6 +192,30 @@ public:
         return isTimeout;
     }
 
+    /**
+     * Get the remaining time until timeout.
+     * If timer is not running or timeout, it will always return 0.
+     *
+     * @return Remaining time in ms
+     */
+    uint32_t getRemaining() const
+    {
+        uint32_t remaining = 0U;
+
+        if ((true == m_isRunning) &&
+            (false == m_isTimeout))
+        {
+            uint32_t delta = millis() - m_start;
+
+            if (m_duration > delta)
+            {
+                remaining = m_duration - delta;
+            }
+        }
+
+        return remaining;
+    }
+
 private:
 
     bool        m_isRunning;    /**< Timer is running or not. */
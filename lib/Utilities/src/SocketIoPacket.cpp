@@ -0,0 +1,267 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Socket.IO packet decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SocketIoPacket.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SocketIoPacket::SocketIoPacket() :
+    m_type(TYPE_INVALID),
+    m_namespace("/"),
+    m_eventName(),
+    m_data(nullptr),
+    m_dataSize(0U)
+{
+}
+
+SocketIoPacket::~SocketIoPacket()
+{
+}
+
+bool SocketIoPacket::decode(const char* text, size_t size)
+{
+    bool isSuccessful = true;
+
+    clear();
+
+    if ((nullptr == text) ||
+        (0U == size))
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        /* Engine.IO packet type */
+        switch(text[0])
+        {
+        case '0':
+            m_type      = TYPE_OPEN;
+            m_data      = &text[1];
+            m_dataSize  = size - 1U;
+            break;
+
+        case '1':
+            m_type = TYPE_CLOSE;
+            break;
+
+        case '2':
+            m_type = TYPE_PING;
+            break;
+
+        case '3':
+            m_type = TYPE_PONG;
+            break;
+
+        case '4':
+            isSuccessful = decodeSocketIo(&text[1], size - 1U);
+            break;
+
+        case '5':
+            /* fallthrough */
+        case '6':
+            /* Upgrade and noop are not supported. */
+            m_type = TYPE_OTHER;
+            break;
+
+        default:
+            isSuccessful = false;
+            break;
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        clear();
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SocketIoPacket::clear()
+{
+    m_type      = TYPE_INVALID;
+    m_namespace = "/";
+    m_eventName.clear();
+    m_data      = nullptr;
+    m_dataSize  = 0U;
+}
+
+bool SocketIoPacket::decodeSocketIo(const char* text, size_t size)
+{
+    bool    isSuccessful    = true;
+    size_t  index           = 1U;
+    char    type            = (0U < size) ? text[0] : '\0';
+
+    /* Optional namespace, which is terminated by a comma. */
+    if ((size > index) &&
+        ('/' == text[index]))
+    {
+        m_namespace.clear();
+
+        while((size > index) && (',' != text[index]))
+        {
+            m_namespace += text[index];
+            ++index;
+        }
+
+        /* Skip comma */
+        if (size > index)
+        {
+            ++index;
+        }
+    }
+
+    /* Optional acknowledge id */
+    while((size > index) && ('0' <= text[index]) && ('9' >= text[index]))
+    {
+        ++index;
+    }
+
+    /* Socket.IO packet type */
+    switch(type)
+    {
+    case '0':
+        m_type = TYPE_CONNECT;
+        break;
+
+    case '1':
+        m_type = TYPE_DISCONNECT;
+        break;
+
+    case '2':
+        isSuccessful = decodeEvent(&text[index], size - index);
+        break;
+
+    case '3':
+        /* fallthrough */
+    case '4':
+        /* fallthrough */
+    case '5':
+        /* fallthrough */
+    case '6':
+        /* Acknowledge, error and binary packets are not supported. */
+        m_type = TYPE_OTHER;
+        break;
+
+    default:
+        isSuccessful = false;
+        break;
+    }
+
+    return isSuccessful;
+}
+
+bool SocketIoPacket::decodeEvent(const char* text, size_t size)
+{
+    bool    isSuccessful    = false;
+    size_t  index           = 2U;
+
+    /* The event data is an array, which starts with the event name. */
+    if ((4U <= size) &&
+        ('[' == text[0]) &&
+        ('"' == text[1]) &&
+        (']' == text[size - 1U]))
+    {
+        while((size > index) && ('"' != text[index]))
+        {
+            m_eventName += text[index];
+            ++index;
+        }
+
+        if (size > index)
+        {
+            ++index;
+
+            /* Event without arguments? */
+            if ((size - 1U) == index)
+            {
+                m_type          = TYPE_EVENT;
+                isSuccessful    = true;
+            }
+            else if (',' == text[index])
+            {
+                ++index;
+
+                m_type          = TYPE_EVENT;
+                m_data          = &text[index];
+                m_dataSize      = (size - 1U) - index;
+                isSuccessful    = true;
+            }
+            else
+            {
+                ;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,201 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Socket.IO packet decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef SOCKET_IO_PACKET_H
+#define SOCKET_IO_PACKET_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <WString.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decoder of a Socket.IO packet, which is received as Engine.IO packet in a
+ * websocket text message.
+ *
+ * Engine.IO packet: <packet type>[<data>]
+ * Socket.IO packet: 4<packet type>[<namespace>,][<ack id>][<data>]
+ * Socket.IO event data: ["<event name>"[,<argument>]]
+ *
+ * The data of an event are its arguments without the enclosing array
+ * brackets. Binary packets are not supported.
+ *
+ * Used protocols:
+ * - https://github.com/socketio/engine.io-protocol (v3 and v4)
+ * - https://github.com/socketio/socket.io-protocol
+ */
+class SocketIoPacket
+{
+public:
+
+    /**
+     * Packet types.
+     */
+    enum Type
+    {
+        TYPE_INVALID = 0,   /**< Invalid or not supported packet */
+        TYPE_OPEN,          /**< Engine.IO open, the data contains the handshake in JSON format. */
+        TYPE_CLOSE,         /**< Engine.IO close */
+        TYPE_PING,          /**< Engine.IO ping */
+        TYPE_PONG,          /**< Engine.IO pong */
+        TYPE_CONNECT,       /**< Socket.IO connect to a namespace */
+        TYPE_DISCONNECT,    /**< Socket.IO disconnect from a namespace */
+        TYPE_EVENT,         /**< Socket.IO event, the data contains the arguments. */
+        TYPE_OTHER          /**< Any other valid packet, which is not supported. */
+    };
+
+    /**
+     * Constructs a invalid packet.
+     */
+    SocketIoPacket();
+
+    /**
+     * Destroys the packet.
+     */
+    ~SocketIoPacket();
+
+    /**
+     * Decode the packet from a websocket text message. The message must be
+     * valid as long as the data of the packet is used.
+     *
+     * @param[in] text  Text message
+     * @param[in] size  Text message size in byte
+     *
+     * @return If successful decoded, it will return true otherwise false.
+     */
+    bool decode(const char* text, size_t size);
+
+    /**
+     * Get packet type.
+     *
+     * @return Packet type
+     */
+    Type getType() const
+    {
+        return m_type;
+    }
+
+    /**
+     * Get the namespace. The default namespace is "/".
+     *
+     * @return Namespace
+     */
+    const String& getNamespace() const
+    {
+        return m_namespace;
+    }
+
+    /**
+     * Get the event name. Only valid for TYPE_EVENT.
+     *
+     * @return Event name
+     */
+    const String& getEventName() const
+    {
+        return m_eventName;
+    }
+
+    /**
+     * Get the packet data. It points into the decoded text message.
+     *
+     * @param[out] size Data size in byte
+     *
+     * @return Data. If there is no data, it will return nullptr.
+     */
+    const char* getData(size_t& size) const
+    {
+        size = m_dataSize;
+
+        return m_data;
+    }
+
+private:
+
+    Type        m_type;         /**< Packet type */
+    String      m_namespace;    /**< Namespace */
+    String      m_eventName;    /**< Event name */
+    const char* m_data;         /**< Packet data */
+    size_t      m_dataSize;     /**< Packet data size in byte */
+
+    SocketIoPacket(const SocketIoPacket& packet);
+    SocketIoPacket& operator=(const SocketIoPacket& packet);
+
+    /**
+     * Clear the packet.
+     */
+    void clear();
+
+    /**
+     * Decode the Socket.IO packet.
+     *
+     * @param[in] text  Socket.IO packet
+     * @param[in] size  Socket.IO packet size in byte
+     *
+     * @return If successful decoded, it will return true otherwise false.
+     */
+    bool decodeSocketIo(const char* text, size_t size);
+
+    /**
+     * Decode the Socket.IO event data.
+     *
+     * @param[in] text  Event data
+     * @param[in] size  Event data size in byte
+     *
+     * @return If successful decoded, it will return true otherwise false.
+     */
+    bool decodeEvent(const char* text, size_t size);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* SOCKET_IO_PACKET_H */
+
+/** @} */
@@ -0,0 +1,657 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Topic trie with MQTT wildcard support
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef TOPIC_TRIE_HPP
+#define TOPIC_TRIE_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <WString.h>
+#include <vector>
+#include <new>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A trie, which stores values by topic filters. A topic consists of levels,
+ * separated by '/'. A topic filter may contain the MQTT wildcards:
+ * - '+' matches exactly one level.
+ * - '#' matches any number of levels, including the parent level. It must be
+ *   the last level of the filter.
+ *
+ * Topics which start with a '$' are not matched by a wildcard in the first level.
+ *
+ * Matching a topic costs one lookup per topic level and wildcard, independent
+ * of the number of stored topic filters.
+ *
+ * @tparam TValue   Type of the value, which is stored per topic filter.
+ */
+template < typename TValue >
+class TopicTrie
+{
+public:
+
+    /**
+     * Constructs an empty topic trie.
+     */
+    TopicTrie() :
+        m_root(),
+        m_size(0U)
+    {
+    }
+
+    /**
+     * Destroys the topic trie.
+     */
+    ~TopicTrie()
+    {
+        clear();
+    }
+
+    /**
+     * Get number of stored topic filters.
+     *
+     * @return Number of topic filters
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Is the topic filter valid?
+     *
+     * @param[in] filter    Topic filter
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    static bool isFilterValid(const char* filter)
+    {
+        bool isValid = false;
+
+        if ((nullptr != filter) &&
+            ('\0' != filter[0]))
+        {
+            const char* levelStart = filter;
+
+            isValid = true;
+
+            while((true == isValid) && (nullptr != levelStart))
+            {
+                const char* levelEnd    = strchr(levelStart, '/');
+                size_t      levelLength = (nullptr == levelEnd) ? strlen(levelStart) : static_cast<size_t>(levelEnd - levelStart);
+
+                /* A wildcard must occupy a whole level. */
+                if (((nullptr != memchr(levelStart, '+', levelLength)) || (nullptr != memchr(levelStart, '#', levelLength))) &&
+                    (1U != levelLength))
+                {
+                    isValid = false;
+                }
+                /* The multi-level wildcard must be the last level. */
+                else if (('#' == levelStart[0]) &&
+                         (nullptr != levelEnd))
+                {
+                    isValid = false;
+                }
+                else
+                {
+                    levelStart = (nullptr == levelEnd) ? nullptr : (levelEnd + 1);
+                }
+            }
+        }
+
+        return isValid;
+    }
+
+    /**
+     * Insert a value for a topic filter.
+     * If the topic filter already exists, its value will be replaced.
+     *
+     * @param[in] filter    Topic filter
+     * @param[in] value     Value
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool insert(const char* filter, const TValue& value)
+    {
+        bool isSuccessful = false;
+
+        if (true == isFilterValid(filter))
+        {
+            Node*       node        = &m_root;
+            const char* levelStart  = filter;
+
+            while((nullptr != node) && (nullptr != levelStart))
+            {
+                const char* levelEnd    = strchr(levelStart, '/');
+                size_t      levelLength = (nullptr == levelEnd) ? strlen(levelStart) : static_cast<size_t>(levelEnd - levelStart);
+
+                node        = getOrCreateChild(*node, levelStart, levelLength);
+                levelStart  = (nullptr == levelEnd) ? nullptr : (levelEnd + 1);
+            }
+
+            if (nullptr != node)
+            {
+                if (false == node->hasValue)
+                {
+                    node->hasValue = true;
+                    ++m_size;
+                }
+
+                node->value     = value;
+                isSuccessful    = true;
+            }
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Remove a topic filter and its value.
+     *
+     * @param[in] filter    Topic filter
+     *
+     * @return If the topic filter was found and removed, it will return true otherwise false.
+     */
+    bool remove(const char* filter)
+    {
+        bool isRemoved = false;
+
+        if ((nullptr != filter) &&
+            ('\0' != filter[0]))
+        {
+            isRemoved = removeFromNode(m_root, filter);
+        }
+
+        return isRemoved;
+    }
+
+    /**
+     * Find the value of a topic filter. Wildcards are not resolved, the
+     * filter must match exactly.
+     *
+     * @param[in] filter    Topic filter
+     *
+     * @return If found, it will return the value otherwise nullptr.
+     */
+    TValue* find(const char* filter)
+    {
+        Node*   node    = findNode(filter);
+        TValue* value   = nullptr;
+
+        if ((nullptr != node) &&
+            (true == node->hasValue))
+        {
+            value = &node->value;
+        }
+
+        return value;
+    }
+
+    /**
+     * Call the function for every topic filter, which matches the topic.
+     * The function must not modify the trie.
+     *
+     * @tparam TFunc    Function type, compatible to void(TValue& value).
+     *
+     * @param[in] topic Topic without wildcards
+     * @param[in] func  Function which to call for every matching value.
+     *
+     * @return Number of matches
+     */
+    template < typename TFunc >
+    size_t match(const char* topic, TFunc func)
+    {
+        size_t matches = 0U;
+
+        if ((nullptr != topic) &&
+            ('\0' != topic[0]))
+        {
+            matches = matchNode(m_root, topic, '$' == topic[0], func);
+        }
+
+        return matches;
+    }
+
+    /**
+     * Call the function for every stored topic filter.
+     * The function must not modify the trie.
+     *
+     * @tparam TFunc    Function type, compatible to void(const String& filter, TValue& value).
+     *
+     * @param[in] func  Function which to call for every topic filter.
+     */
+    template < typename TFunc >
+    void forEachTopic(TFunc func)
+    {
+        forEachNode(m_root, String(), true, func);
+    }
+
+    /**
+     * Remove all topic filters.
+     */
+    void clear()
+    {
+        clearNode(m_root);
+        m_size = 0U;
+    }
+
+private:
+
+    /**
+     * A node represents a single topic level.
+     */
+    struct Node
+    {
+        String              level;      /**< Topic level name */
+        bool                hasValue;   /**< Does the node contain a value? */
+        TValue              value;      /**< Value, only valid if hasValue is true. */
+        std::vector<Node*>  children;   /**< Child nodes, sorted by their level name. */
+
+        /**
+         * Constructs a node.
+         */
+        Node() :
+            level(),
+            hasValue(false),
+            value(),
+            children()
+        {
+        }
+    };
+
+    Node    m_root; /**< Root node, without a level name. */
+    size_t  m_size; /**< Number of stored topic filters */
+
+    TopicTrie(const TopicTrie& trie);
+    TopicTrie& operator=(const TopicTrie& trie);
+
+    /**
+     * Compare a level name with a not zero-terminated level.
+     *
+     * @param[in] level         Level name
+     * @param[in] levelStart    Start of the level to compare with
+     * @param[in] levelLength   Length of the level to compare with
+     *
+     * @return Less than 0, 0 or greater than 0, like strcmp().
+     */
+    static int32_t compareLevel(const String& level, const char* levelStart, size_t levelLength)
+    {
+        int32_t result = strncmp(level.c_str(), levelStart, levelLength);
+
+        if ((0 == result) &&
+            (level.length() > levelLength))
+        {
+            result = 1;
+        }
+
+        return result;
+    }
+
+    /**
+     * Search the child node of a level by binary search.
+     *
+     * @param[in]   node        Parent node
+     * @param[in]   levelStart  Start of the level name
+     * @param[in]   levelLength Length of the level name
+     * @param[out]  index       Index of the child or where it shall be inserted.
+     *
+     * @return If found, it will return the child node otherwise nullptr.
+     */
+    static Node* findChild(const Node& node, const char* levelStart, size_t levelLength, size_t& index)
+    {
+        Node*   child   = nullptr;
+        size_t  left    = 0U;
+        size_t  right   = node.children.size();
+
+        while((nullptr == child) && (left < right))
+        {
+            size_t  middle  = left + ((right - left) / 2U);
+            int32_t result  = compareLevel(node.children[middle]->level, levelStart, levelLength);
+
+            if (0 == result)
+            {
+                child   = node.children[middle];
+                left    = middle;
+            }
+            else if (0 > result)
+            {
+                left = middle + 1U;
+            }
+            else
+            {
+                right = middle;
+            }
+        }
+
+        index = left;
+
+        return child;
+    }
+
+    /**
+     * Search the child node of a level.
+     *
+     * @param[in] node          Parent node
+     * @param[in] levelStart    Start of the level name
+     * @param[in] levelLength   Length of the level name
+     *
+     * @return If found, it will return the child node otherwise nullptr.
+     */
+    static Node* findChild(const Node& node, const char* levelStart, size_t levelLength)
+    {
+        size_t index = 0U;
+
+        return findChild(node, levelStart, levelLength, index);
+    }
+
+    /**
+     * Get the child node of a level. If it doesn't exist, it will be created.
+     *
+     * @param[in] node          Parent node
+     * @param[in] levelStart    Start of the level name
+     * @param[in] levelLength   Length of the level name
+     *
+     * @return Child node or nullptr if out of memory.
+     */
+    static Node* getOrCreateChild(Node& node, const char* levelStart, size_t levelLength)
+    {
+        size_t  index   = 0U;
+        Node*   child   = findChild(node, levelStart, levelLength, index);
+
+        if (nullptr == child)
+        {
+            child = new(std::nothrow) Node();
+
+            if (nullptr != child)
+            {
+                size_t idx = 0U;
+
+                for(idx = 0U; idx < levelLength; ++idx)
+                {
+                    child->level += levelStart[idx];
+                }
+
+                (void)node.children.insert(node.children.begin() + index, child);
+            }
+        }
+
+        return child;
+    }
+
+    /**
+     * Find the node of a topic filter.
+     *
+     * @param[in] filter    Topic filter
+     *
+     * @return If found, it will return the node otherwise nullptr.
+     */
+    Node* findNode(const char* filter)
+    {
+        Node*       node        = nullptr;
+        const char* levelStart  = filter;
+
+        if ((nullptr != filter) &&
+            ('\0' != filter[0]))
+        {
+            node = &m_root;
+        }
+
+        while((nullptr != node) && (nullptr != levelStart))
+        {
+            const char* levelEnd    = strchr(levelStart, '/');
+            size_t      levelLength = (nullptr == levelEnd) ? strlen(levelStart) : static_cast<size_t>(levelEnd - levelStart);
+
+            node        = findChild(*node, levelStart, levelLength);
+            levelStart  = (nullptr == levelEnd) ? nullptr : (levelEnd + 1);
+        }
+
+        return node;
+    }
+
+    /**
+     * Remove the topic filter below the node. Child nodes without value
+     * and without children are destroyed.
+     *
+     * @param[in] node          Node
+     * @param[in] levelStart    Start of the remaining topic filter
+     *
+     * @return If the topic filter was found and removed, it will return true otherwise false.
+     */
+    bool removeFromNode(Node& node, const char* levelStart)
+    {
+        bool        isRemoved   = false;
+        const char* levelEnd    = strchr(levelStart, '/');
+        size_t      levelLength = (nullptr == levelEnd) ? strlen(levelStart) : static_cast<size_t>(levelEnd - levelStart);
+        size_t      index       = 0U;
+        Node*       child       = findChild(node, levelStart, levelLength, index);
+
+        if (nullptr != child)
+        {
+            if (nullptr == levelEnd)
+            {
+                if (true == child->hasValue)
+                {
+                    child->hasValue = false;
+                    child->value    = TValue();
+                    --m_size;
+
+                    isRemoved = true;
+                }
+            }
+            else
+            {
+                isRemoved = removeFromNode(*child, levelEnd + 1);
+            }
+
+            /* Destroy a node which became useless. */
+            if ((true == isRemoved) &&
+                (false == child->hasValue) &&
+                (true == child->children.empty()))
+            {
+                (void)node.children.erase(node.children.begin() + index);
+                delete child;
+            }
+        }
+
+        return isRemoved;
+    }
+
+    /**
+     * Call the function for the value of the node, if available.
+     *
+     * @tparam TFunc    Function type, compatible to void(TValue& value).
+     *
+     * @param[in] node  Node
+     * @param[in] func  Function which to call.
+     *
+     * @return Number of matches
+     */
+    template < typename TFunc >
+    static size_t matchValue(Node& node, TFunc& func)
+    {
+        size_t matches = 0U;
+
+        if (true == node.hasValue)
+        {
+            func(node.value);
+            matches = 1U;
+        }
+
+        return matches;
+    }
+
+    /**
+     * Call the function for every topic filter below the node, which matches
+     * the remaining topic.
+     *
+     * @tparam TFunc    Function type, compatible to void(TValue& value).
+     *
+     * @param[in] node              Node
+     * @param[in] levelStart        Start of the remaining topic
+     * @param[in] isWildcardSkipped Skip the wildcards in this level?
+     * @param[in] func              Function which to call for every matching value.
+     *
+     * @return Number of matches
+     */
+    template < typename TFunc >
+    static size_t matchNode(Node& node, const char* levelStart, bool isWildcardSkipped, TFunc& func)
+    {
+        size_t      matches     = 0U;
+        const char* levelEnd    = strchr(levelStart, '/');
+        size_t      levelLength = (nullptr == levelEnd) ? strlen(levelStart) : static_cast<size_t>(levelEnd - levelStart);
+        Node*       children[2] = { findChild(node, levelStart, levelLength), nullptr };
+        size_t      idx         = 0U;
+
+        if (false == isWildcardSkipped)
+        {
+            Node* multiLevel = findChild(node, "#", 1U);
+
+            /* The multi-level wildcard matches all remaining levels. */
+            if (nullptr != multiLevel)
+            {
+                matches += matchValue(*multiLevel, func);
+            }
+
+            children[1] = findChild(node, "+", 1U);
+        }
+
+        for(idx = 0U; idx < (sizeof(children) / sizeof(children[0])); ++idx)
+        {
+            Node* child = children[idx];
+
+            if (nullptr != child)
+            {
+                if (nullptr == levelEnd)
+                {
+                    Node* multiLevel = findChild(*child, "#", 1U);
+
+                    matches += matchValue(*child, func);
+
+                    /* The multi-level wildcard matches the parent level too. */
+                    if (nullptr != multiLevel)
+                    {
+                        matches += matchValue(*multiLevel, func);
+                    }
+                }
+                else
+                {
+                    matches += matchNode(*child, levelEnd + 1, false, func);
+                }
+            }
+        }
+
+        return matches;
+    }
+
+    /**
+     * Call the function for every topic filter below the node.
+     *
+     * @tparam TFunc    Function type, compatible to void(const String& filter, TValue& value).
+     *
+     * @param[in] node      Node
+     * @param[in] prefix    Topic filter of the node
+     * @param[in] isRoot    Is the node the root node?
+     * @param[in] func      Function which to call for every topic filter.
+     */
+    template < typename TFunc >
+    static void forEachNode(Node& node, const String& prefix, bool isRoot, TFunc& func)
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < node.children.size(); ++idx)
+        {
+            Node*   child   = node.children[idx];
+            String  filter  = prefix;
+
+            if (false == isRoot)
+            {
+                filter += "/";
+            }
+
+            filter += child->level;
+
+            if (true == child->hasValue)
+            {
+                func(filter, child->value);
+            }
+
+            forEachNode(*child, filter, false, func);
+        }
+    }
+
+    /**
+     * Destroy all child nodes of the node.
+     *
+     * @param[in] node  Node
+     */
+    static void clearNode(Node& node)
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < node.children.size(); ++idx)
+        {
+            Node* child = node.children[idx];
+
+            clearNode(*child);
+            delete child;
+        }
+
+        node.children.clear();
+        node.hasValue   = false;
+        node.value      = TValue();
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* TOPIC_TRIE_HPP */
+
+/** @} */
@@ -0,0 +1,172 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hot path event tracer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Tracer.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t Tracer::getEvents(Event* events, size_t maxEvents)
+{
+    size_t  count       = 0U;
+    uint8_t core        = 0U;
+    bool    isEnabled   = m_isEnabled.exchange(false);
+
+    if (nullptr != events)
+    {
+        uint32_t cyclesPerUs = getCyclesPerUs();
+
+        for(core = 0U; core < NUM_CORES; ++core)
+        {
+            const CoreBuffer&   buffer      = m_buffers[core];
+            uint32_t            writeIdx    = buffer.writeIdx.load();
+            uint32_t            num         = (CONFIG_TRACE_BUFFER_SIZE < writeIdx) ? CONFIG_TRACE_BUFFER_SIZE : writeIdx;
+
+            if ((maxEvents - count) < num)
+            {
+                num = maxEvents - count;
+            }
+
+            if ((0U < num) &&
+                (true == buffer.isAnchored))
+            {
+                uint32_t    idx         = 0U;
+                uint32_t    prevCycles  = buffer.anchorCycles;
+                int64_t     relCycles   = 0;
+
+                /* Only the newest events are related to the anchor without
+                 * ambiguity. Therefore walk from the newest to the oldest event
+                 * and accumulate the differences between them.
+                 */
+                for(idx = 0U; idx < num; ++idx)
+                {
+                    const Entry&    entry   = buffer.entries[(writeIdx - 1U - idx) & (CONFIG_TRACE_BUFFER_SIZE - 1U)];
+                    Event&          event   = events[count + num - 1U - idx];
+
+                    relCycles   += static_cast<int32_t>(entry.cycles - prevCycles);
+                    prevCycles   = entry.cycles;
+
+                    event.name      = entry.name;
+                    event.timestamp = buffer.anchorTime + (relCycles / static_cast<int64_t>(cyclesPerUs));
+                    event.taskId    = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(entry.task));
+                    event.id        = entry.id;
+                    event.core      = core;
+                    event.type      = static_cast<EventType>(entry.type);
+                }
+
+                count += num;
+            }
+        }
+    }
+
+    m_isEnabled.store(isEnabled);
+
+    return count;
+}
+
+void Tracer::clear()
+{
+    uint8_t core        = 0U;
+    bool    isEnabled   = m_isEnabled.exchange(false);
+
+    for(core = 0U; core < NUM_CORES; ++core)
+    {
+        m_buffers[core].writeIdx.store(0U);
+        m_buffers[core].isAnchored = false;
+    }
+
+    m_isEnabled.store(isEnabled);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+Tracer::Tracer() :
+    m_isEnabled(true),
+    m_buffers()
+{
+    uint8_t core = 0U;
+
+    for(core = 0U; core < NUM_CORES; ++core)
+    {
+        m_buffers[core].writeIdx.store(0U);
+        m_buffers[core].isAnchored      = false;
+        m_buffers[core].anchorCycles    = 0U;
+        m_buffers[core].anchorTime      = 0;
+    }
+}
+
+void Tracer::updateAnchor(CoreBuffer& buffer, uint32_t cycles)
+{
+    /* Only tasks on the same core write the anchor. A preemption between
+     * both writes results in a neglectable error of a few us.
+     */
+    buffer.anchorCycles = cycles;
+    buffer.anchorTime   = getTime();
+    buffer.isAnchored   = true;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
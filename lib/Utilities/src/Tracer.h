@@ -0,0 +1,413 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Hot path event tracer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Enable the event tracing. If disabled, the TRACE_* macros are compiled out.
+ */
+#ifndef CONFIG_TRACE
+#define CONFIG_TRACE                (0)
+#endif  /* CONFIG_TRACE */
+
+/**
+ * Number of trace events per core, which are kept in the ring buffer.
+ * It must be a power of two.
+ */
+#ifndef CONFIG_TRACE_BUFFER_SIZE
+#define CONFIG_TRACE_BUFFER_SIZE    (256U)
+#endif  /* CONFIG_TRACE_BUFFER_SIZE */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <stdint.h>
+#include <atomic>
+
+#ifndef NATIVE
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#if (0 == CONFIG_TRACE)
+
+    #define TRACE_BEGIN(name)
+    #define TRACE_END(name)
+    #define TRACE_INSTANT(name)
+    #define TRACE_SCOPE(name)
+    #define TRACE_SCOPE_ID(name, id)
+
+#else   /* (0 == CONFIG_TRACE) */
+
+    /** Trace the begin of a duration. The name must be a string literal. */
+    #define TRACE_BEGIN(name)           do{ Tracer::getInstance().record(Tracer::EVENT_TYPE_BEGIN, (name), 0U); }while(0)
+
+    /** Trace the end of a duration. The name must be a string literal. */
+    #define TRACE_END(name)             do{ Tracer::getInstance().record(Tracer::EVENT_TYPE_END, (name), 0U); }while(0)
+
+    /** Trace a single point in time. The name must be a string literal. */
+    #define TRACE_INSTANT(name)         do{ Tracer::getInstance().record(Tracer::EVENT_TYPE_INSTANT, (name), 0U); }while(0)
+
+    /** Trace the duration of the current scope. Only one per scope is possible. */
+    #define TRACE_SCOPE(name)           TraceScope traceScope((name), 0U)
+
+    /** Trace the duration of the current scope with an additional id, e.g. a plugin UID. */
+    #define TRACE_SCOPE_ID(name, id)    TraceScope traceScope((name), (id))
+
+#endif  /* (0 == CONFIG_TRACE) */
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Lightweight tracer for hot paths. The begin, end and instant events are
+ * written to a ring buffer per core with the cycle counter as timestamp.
+ * Writing an event is lock-free and doesn't allocate memory. The oldest
+ * events are overwritten.
+ *
+ * The event names are not copied, therefore they must be string literals.
+ *
+ * The cycle counters of the cores are not synchronized. Therefore every core
+ * buffer keeps an anchor, which relates its cycle counter to the system time.
+ * The events are converted to system time, when they are read.
+ */
+class Tracer
+{
+public:
+
+    /**
+     * Event types.
+     */
+    enum EventType
+    {
+        EVENT_TYPE_BEGIN = 0,   /**< Begin of a duration */
+        EVENT_TYPE_END,         /**< End of a duration */
+        EVENT_TYPE_INSTANT      /**< Single point in time */
+    };
+
+    /**
+     * A trace event, converted to system time.
+     */
+    struct Event
+    {
+        const char* name;       /**< Event name */
+        int64_t     timestamp;  /**< Timestamp in us since system start */
+        uint32_t    taskId;     /**< Id of the task, which recorded the event. */
+        uint32_t    id;         /**< User defined id, 0 if not used. */
+        uint8_t     core;       /**< Core, where the event was recorded. */
+        EventType   type;       /**< Event type */
+    };
+
+#ifndef NATIVE
+    /** Number of cores, which have a own ring buffer. */
+    static const uint8_t    NUM_CORES   = portNUM_PROCESSORS;
+#else   /* NATIVE */
+    /** Number of cores, which have a own ring buffer. */
+    static const uint8_t    NUM_CORES   = 1U;
+#endif  /* NATIVE */
+
+    /** Max. number of events, which can be read. */
+    static const size_t     MAX_EVENTS  = NUM_CORES * CONFIG_TRACE_BUFFER_SIZE;
+
+    /**
+     * Get the tracer instance.
+     *
+     * @return Tracer instance
+     */
+    static Tracer& getInstance()
+    {
+        static Tracer instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Enable or disable recording of events.
+     *
+     * @param[in] isEnabled Enable (true) or disable (false)
+     */
+    void setEnabled(bool isEnabled)
+    {
+        m_isEnabled.store(isEnabled);
+    }
+
+    /**
+     * Is recording of events enabled?
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isEnabled() const
+    {
+        return m_isEnabled.load();
+    }
+
+    /**
+     * Record a event.
+     *
+     * @param[in] type  Event type
+     * @param[in] name  Event name, must be a string literal.
+     * @param[in] id    User defined id, 0 if not used.
+     */
+    void record(EventType type, const char* name, uint32_t id)
+    {
+        if (true == m_isEnabled.load(std::memory_order_relaxed))
+        {
+            uint32_t        cycles  = getCycleCount();
+            CoreBuffer&     buffer  = m_buffers[getCoreId()];
+            uint32_t        idx     = buffer.writeIdx.fetch_add(1U, std::memory_order_relaxed);
+            Entry&          entry   = buffer.entries[idx & (CONFIG_TRACE_BUFFER_SIZE - 1U)];
+
+            /* Keep the anchor near the newest events. */
+            if ((false == buffer.isAnchored) ||
+                (ANCHOR_PERIOD <= (cycles - buffer.anchorCycles)))
+            {
+                updateAnchor(buffer, cycles);
+            }
+
+            entry.name      = name;
+            entry.cycles    = cycles;
+            entry.task      = getTaskHandle();
+            entry.id        = id;
+            entry.type      = static_cast<uint8_t>(type);
+        }
+    }
+
+    /**
+     * Read all recorded events, core by core from the oldest to the newest.
+     * The recording is paused during reading.
+     *
+     * @param[out]  events      Event buffer
+     * @param[in]   maxEvents   Max. number of events, which fit into the event buffer.
+     *
+     * @return Number of read events
+     */
+    size_t getEvents(Event* events, size_t maxEvents);
+
+    /**
+     * Remove all recorded events.
+     */
+    void clear();
+
+private:
+
+    /**
+     * A recorded event, as it is stored in the ring buffer.
+     */
+    struct Entry
+    {
+        const char* name;   /**< Event name */
+        uint32_t    cycles; /**< Cycle counter */
+        void*       task;   /**< Task handle */
+        uint32_t    id;     /**< User defined id */
+        uint8_t     type;   /**< Event type */
+    };
+
+    /**
+     * The ring buffer of a single core.
+     */
+    struct CoreBuffer
+    {
+        Entry                   entries[CONFIG_TRACE_BUFFER_SIZE];  /**< Recorded events */
+        std::atomic<uint32_t>   writeIdx;                           /**< Write index, which increases continuously. */
+        bool                    isAnchored;                         /**< Is the anchor valid? */
+        uint32_t                anchorCycles;                       /**< Anchor cycle counter */
+        int64_t                 anchorTime;                         /**< Anchor system time in us */
+    };
+
+    /**
+     * Period in cycles, after which the anchor is renewed. Half of the cycle
+     * counter range, so the newest events are always related without ambiguity.
+     */
+    static const uint32_t   ANCHOR_PERIOD   = 0x80000000U;
+
+    std::atomic<bool>   m_isEnabled;            /**< Is recording enabled? */
+    CoreBuffer          m_buffers[NUM_CORES];   /**< Ring buffer per core */
+
+    /* Ensure that the ring buffer index can simply be masked. */
+    static_assert(0U == (CONFIG_TRACE_BUFFER_SIZE & (CONFIG_TRACE_BUFFER_SIZE - 1U)), "CONFIG_TRACE_BUFFER_SIZE must be a power of two.");
+
+    /**
+     * Constructs the tracer. Recording is enabled by default.
+     */
+    Tracer();
+
+    /**
+     * Destroys the tracer.
+     */
+    ~Tracer()
+    {
+        /* Will never be called. */
+    }
+
+    Tracer(const Tracer& tracer);
+    Tracer& operator=(const Tracer& tracer);
+
+    /**
+     * Relate the cycle counter of the core to the system time.
+     *
+     * @param[in] buffer    Core buffer
+     * @param[in] cycles    Current cycle counter
+     */
+    void updateAnchor(CoreBuffer& buffer, uint32_t cycles);
+
+    /**
+     * Get the cycle counter of the current core.
+     *
+     * @return Cycle counter
+     */
+    static uint32_t getCycleCount()
+    {
+#ifndef NATIVE
+        return ESP.getCycleCount();
+#else   /* NATIVE */
+        return millis() * 1000U;
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Get the current core id.
+     *
+     * @return Core id
+     */
+    static uint8_t getCoreId()
+    {
+#ifndef NATIVE
+        return static_cast<uint8_t>(xPortGetCoreID());
+#else   /* NATIVE */
+        return 0U;
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Get the handle of the current task.
+     *
+     * @return Task handle
+     */
+    static void* getTaskHandle()
+    {
+#ifndef NATIVE
+        return xTaskGetCurrentTaskHandle();
+#else   /* NATIVE */
+        return nullptr;
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Get the system time in us.
+     *
+     * @return System time in us
+     */
+    static int64_t getTime()
+    {
+#ifndef NATIVE
+        return esp_timer_get_time();
+#else   /* NATIVE */
+        return static_cast<int64_t>(millis()) * 1000;
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Get the number of cycles per us.
+     *
+     * @return Cycles per us
+     */
+    static uint32_t getCyclesPerUs()
+    {
+#ifndef NATIVE
+        return ESP.getCpuFreqMHz();
+#else   /* NATIVE */
+        return 1U;
+#endif  /* NATIVE */
+    }
+};
+
+/**
+ * Traces the duration of a scope by a begin event on construction and
+ * a end event on destruction.
+ */
+class TraceScope
+{
+public:
+
+    /**
+     * Records the begin event.
+     *
+     * @param[in] name  Event name, must be a string literal.
+     * @param[in] id    User defined id, 0 if not used.
+     */
+    TraceScope(const char* name, uint32_t id) :
+        m_name(name),
+        m_id(id)
+    {
+        Tracer::getInstance().record(Tracer::EVENT_TYPE_BEGIN, m_name, m_id);
+    }
+
+    /**
+     * Records the end event.
+     */
+    ~TraceScope()
+    {
+        Tracer::getInstance().record(Tracer::EVENT_TYPE_END, m_name, m_id);
+    }
+
+private:
+
+    const char* m_name; /**< Event name */
+    uint32_t    m_id;   /**< User defined id */
+
+    TraceScope();
+    TraceScope(const TraceScope& scope);
+    TraceScope& operator=(const TraceScope& scope);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* TRACER_H */
+
+/** @} */
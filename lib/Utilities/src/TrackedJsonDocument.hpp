@@ -0,0 +1,168 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  JSON document with heap accounting
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef TRACKED_JSON_DOCUMENT_HPP
+#define TRACKED_JSON_DOCUMENT_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <ArduinoJson.h>
+#include "HeapAccounting.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * JSON document memory allocator, which reports the memory pool of the
+ * document to the heap accounting. Because the release doesn't provide the
+ * size, it is stored in front of the memory pool.
+ */
+struct TrackedJsonAllocator
+{
+    /**
+     * Header in front of the memory pool. The union keeps the memory pool
+     * aligned like a regular heap allocation.
+     */
+    union Header
+    {
+        size_t      size;       /**< Size of the memory pool in byte */
+        uint64_t    alignment;  /**< Not used, only for alignment. */
+        double      alignmentF; /**< Not used, only for alignment. */
+    };
+
+    /**
+     * Allocate memory pool.
+     *
+     * @param[in] size  Size in byte
+     *
+     * @return If successful, it will return the memory pool otherwise nullptr.
+     */
+    void* allocate(size_t size)
+    {
+        void*   ptr     = nullptr;
+        Header* header  = static_cast<Header*>(malloc(sizeof(Header) + size));
+
+        HeapAccounting::getInstance().track(HeapAccounting::TAG_JSON, header, size);
+
+        if (nullptr != header)
+        {
+            header->size = size;
+            ptr = &header[1];
+        }
+
+        return ptr;
+    }
+
+    /**
+     * Release memory pool.
+     *
+     * @param[in] ptr   Memory pool
+     */
+    void deallocate(void* ptr)
+    {
+        if (nullptr != ptr)
+        {
+            Header* header = &static_cast<Header*>(ptr)[-1];
+
+            HeapAccounting::getInstance().released(HeapAccounting::TAG_JSON, header->size);
+            free(header);
+        }
+    }
+
+    /**
+     * Resize memory pool.
+     *
+     * @param[in] ptr       Memory pool
+     * @param[in] newSize   New size in byte
+     *
+     * @return If successful, it will return the resized memory pool otherwise nullptr.
+     */
+    void* reallocate(void* ptr, size_t newSize)
+    {
+        void* newPtr = nullptr;
+
+        if (nullptr == ptr)
+        {
+            newPtr = allocate(newSize);
+        }
+        else
+        {
+            Header* header      = &static_cast<Header*>(ptr)[-1];
+            size_t  oldSize     = header->size;
+            Header* newHeader   = static_cast<Header*>(realloc(header, sizeof(Header) + newSize));
+
+            if (nullptr == newHeader)
+            {
+                HeapAccounting::getInstance().failed(HeapAccounting::TAG_JSON, newSize);
+            }
+            else
+            {
+                HeapAccounting::getInstance().released(HeapAccounting::TAG_JSON, oldSize);
+                HeapAccounting::getInstance().allocated(HeapAccounting::TAG_JSON, newSize);
+
+                newHeader->size = newSize;
+                newPtr = &newHeader[1];
+            }
+        }
+
+        return newPtr;
+    }
+};
+
+/**
+ * Dynamic JSON document, whose memory pool is accounted with the JSON tag.
+ * It can be used everywhere a DynamicJsonDocument is used.
+ */
+typedef BasicJsonDocument<TrackedJsonAllocator> TrackedJsonDocument;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* TRACKED_JSON_DOCUMENT_HPP */
+
+/** @} */
@@ -0,0 +1,435 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket frame parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WebSocketFrameParser.h"
+
+#include <string.h>
+#include <new>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+WebSocketFrameParser::WebSocketFrameParser() :
+    m_frameHeader(),
+    m_frameHeaderIndex(0U),
+    m_frameHeaderSize(2U),
+    m_opcode(OPCODE_CONTINUATION),
+    m_isFin(false),
+    m_payloadSize(0U),
+    m_payloadIndex(0U),
+    m_ctrlPayload(),
+    m_ctrlPayloadSize(0U),
+    m_msg(nullptr),
+    m_msgSize(0U),
+    m_isMsgPending(false),
+    m_isMsgText(false),
+    m_isMsgDiscarded(false),
+    m_isMsgComplete(false),
+    m_isError(false)
+{
+}
+
+WebSocketFrameParser::~WebSocketFrameParser()
+{
+    releaseMsg();
+}
+
+void WebSocketFrameParser::reset()
+{
+    m_frameHeaderIndex  = 0U;
+    m_frameHeaderSize   = 2U;
+    m_payloadSize       = 0U;
+    m_payloadIndex      = 0U;
+    m_ctrlPayloadSize   = 0U;
+    m_isMsgPending      = false;
+    m_isMsgDiscarded    = false;
+    m_isError           = false;
+
+    releaseMsg();
+}
+
+WebSocketFrameParser::Event WebSocketFrameParser::parse(const uint8_t* data, size_t len, size_t& index)
+{
+    Event evt = (true == m_isError) ? EVENT_ERROR : EVENT_NONE;
+
+    while((len > index) && (EVENT_NONE == evt))
+    {
+        bool isValid = true;
+
+        /* Frame header */
+        if (m_frameHeaderSize > m_frameHeaderIndex)
+        {
+            m_frameHeader[m_frameHeaderIndex] = data[index];
+            ++m_frameHeaderIndex;
+            ++index;
+
+            /* The first two bytes contain the payload length size. */
+            if (2U == m_frameHeaderIndex)
+            {
+                const uint8_t   MASK_FLAG   = 0x80U;
+                uint8_t         payloadLen  = m_frameHeader[1] & 0x7FU;
+
+                /* A server shall not mask frames, see RFC6455 chapter 5.1. */
+                if (0U != (m_frameHeader[1] & MASK_FLAG))
+                {
+                    isValid = false;
+                }
+                else if (126U == payloadLen)
+                {
+                    m_frameHeaderSize += 2U;
+                }
+                else if (127U == payloadLen)
+                {
+                    m_frameHeaderSize += 8U;
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            if ((true == isValid) &&
+                (m_frameHeaderSize == m_frameHeaderIndex))
+            {
+                isValid = handleFrameHeader();
+
+                if ((true == isValid) &&
+                    (0U == m_payloadSize))
+                {
+                    evt = handleFrameComplete();
+                }
+            }
+        }
+        /* Frame payload */
+        else
+        {
+            size_t  available   = len - index;
+            size_t  remaining   = m_payloadSize - m_payloadIndex;
+            size_t  size        = (remaining < available) ? remaining : available;
+
+            if (OPCODE_CLOSE <= m_opcode)
+            {
+                memcpy(&m_ctrlPayload[m_payloadIndex], &data[index], size);
+            }
+            else if (false == m_isMsgDiscarded)
+            {
+                memcpy(&m_msg[m_msgSize], &data[index], size);
+                m_msgSize += size;
+            }
+            else
+            {
+                ;
+            }
+
+            m_payloadIndex  += size;
+            index           += size;
+
+            if (m_payloadSize == m_payloadIndex)
+            {
+                evt = handleFrameComplete();
+            }
+        }
+
+        if (false == isValid)
+        {
+            LOG_WARNING("Websocket protocol error.");
+
+            m_isError   = true;
+            evt         = EVENT_ERROR;
+        }
+    }
+
+    return evt;
+}
+
+char* WebSocketFrameParser::takeText(size_t& size)
+{
+    char* text = nullptr;
+
+    if ((true == m_isMsgComplete) &&
+        (nullptr != m_msg))
+    {
+        void* vMsg = m_msg;
+
+        text            = static_cast<char*>(vMsg);
+        size            = m_msgSize;
+        m_msg           = nullptr;
+        m_msgSize       = 0U;
+        m_isMsgComplete = false;
+    }
+    else
+    {
+        size = 0U;
+    }
+
+    return text;
+}
+
+const uint8_t* WebSocketFrameParser::getCtrlPayload(size_t& size) const
+{
+    size = m_ctrlPayloadSize;
+
+    return m_ctrlPayload;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool WebSocketFrameParser::handleFrameHeader()
+{
+    const uint8_t   FIN_FLAG    = 0x80U;
+    const uint8_t   RSV_FLAGS   = 0x70U;
+    bool            isValid     = true;
+    uint8_t         payloadLen  = m_frameHeader[1] & 0x7FU;
+    uint64_t        payloadSize = payloadLen;
+    size_t          index       = 0U;
+
+    m_isFin     = (0U != (m_frameHeader[0] & FIN_FLAG));
+    m_opcode    = m_frameHeader[0] & 0x0FU;
+
+    /* The extended payload length is in network byte order. */
+    if (126U <= payloadLen)
+    {
+        payloadSize = 0U;
+
+        for(index = 2U; index < m_frameHeaderSize; ++index)
+        {
+            payloadSize <<= 8U;
+            payloadSize  |= m_frameHeader[index];
+        }
+    }
+
+    m_payloadIndex = 0U;
+
+    /* No extension is negotiated. */
+    if (0U != (m_frameHeader[0] & RSV_FLAGS))
+    {
+        isValid = false;
+    }
+    /* Control frames shall not be fragmented and their payload is limited. */
+    else if (OPCODE_CLOSE <= m_opcode)
+    {
+        if ((OPCODE_PONG < m_opcode) ||
+            (false == m_isFin) ||
+            (CTRL_PAYLOAD_MAX_SIZE < payloadSize))
+        {
+            isValid = false;
+        }
+        else
+        {
+            m_payloadSize = static_cast<size_t>(payloadSize);
+        }
+    }
+    /* Data frames */
+    else if (UINT32_MAX < payloadSize)
+    {
+        isValid = false;
+    }
+    else
+    {
+        m_payloadSize = static_cast<size_t>(payloadSize);
+
+        if (OPCODE_CONTINUATION == m_opcode)
+        {
+            if (false == m_isMsgPending)
+            {
+                isValid = false;
+            }
+        }
+        else if ((OPCODE_TEXT == m_opcode) ||
+                 (OPCODE_BINARY == m_opcode))
+        {
+            if (true == m_isMsgPending)
+            {
+                isValid = false;
+            }
+            else
+            {
+                /* A not taken text message is replaced. */
+                releaseMsg();
+
+                m_isMsgPending      = true;
+                m_isMsgText         = (OPCODE_TEXT == m_opcode);
+                m_isMsgDiscarded    = (false == m_isMsgText);
+            }
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (true == isValid)
+        {
+            prepareMsg();
+        }
+    }
+
+    return isValid;
+}
+
+WebSocketFrameParser::Event WebSocketFrameParser::handleFrameComplete()
+{
+    Event evt = EVENT_NONE;
+
+    /* Prepare for the next frame. */
+    m_frameHeaderIndex  = 0U;
+    m_frameHeaderSize   = 2U;
+
+    switch(m_opcode)
+    {
+    case OPCODE_PING:
+        m_ctrlPayloadSize   = m_payloadSize;
+        evt                 = EVENT_PING;
+        break;
+
+    case OPCODE_PONG:
+        /* Nothing to do. */
+        break;
+
+    case OPCODE_CLOSE:
+        m_ctrlPayloadSize   = m_payloadSize;
+        evt                 = EVENT_CLOSE;
+        break;
+
+    default:
+        if (true == m_isFin)
+        {
+            if ((false == m_isMsgDiscarded) &&
+                (nullptr != m_msg))
+            {
+                m_msg[m_msgSize]    = '\0';
+                m_isMsgComplete     = true;
+                evt                 = EVENT_TEXT;
+            }
+            else
+            {
+                releaseMsg();
+            }
+
+            m_isMsgPending = false;
+        }
+        break;
+    }
+
+    return evt;
+}
+
+void WebSocketFrameParser::prepareMsg()
+{
+    if (false == m_isMsgDiscarded)
+    {
+        /* The payload size may be near the max. of size_t, therefore it
+         * is checked first to avoid an overflow.
+         */
+        if ((MAX_MESSAGE_SIZE < m_payloadSize) ||
+            ((MAX_MESSAGE_SIZE - m_payloadSize) < m_msgSize))
+        {
+            LOG_WARNING("Websocket message too long, discarded.");
+
+            releaseMsg();
+            m_isMsgDiscarded = true;
+        }
+        else
+        {
+            /* Consider the string termination. */
+            size_t      newSize = m_msgSize + m_payloadSize + 1U;
+            uint8_t*    msg     = new(std::nothrow) uint8_t[newSize];
+
+            if (nullptr == msg)
+            {
+                LOG_ERROR("Couldn't allocate %u memory.", newSize);
+
+                releaseMsg();
+                m_isMsgDiscarded = true;
+            }
+            else
+            {
+                if (nullptr != m_msg)
+                {
+                    memcpy(msg, m_msg, m_msgSize);
+                    delete[] m_msg;
+                }
+
+                m_msg = msg;
+            }
+        }
+    }
+}
+
+void WebSocketFrameParser::releaseMsg()
+{
+    if (nullptr != m_msg)
+    {
+        delete[] m_msg;
+        m_msg = nullptr;
+    }
+
+    m_msgSize       = 0U;
+    m_isMsgComplete = false;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,206 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket frame parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef WEBSOCKET_FRAME_PARSER_H
+#define WEBSOCKET_FRAME_PARSER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Parser of the websocket frames, which a client receives from the server,
+ * see RFC6455 chapter 5. Fragmented text messages are reassembled.
+ *
+ * Limitations:
+ * - Binary messages are discarded.
+ * - Messages greater than MAX_MESSAGE_SIZE are discarded.
+ *
+ * The parser is not protected against concurrent access, this is up to the
+ * user.
+ */
+class WebSocketFrameParser
+{
+public:
+
+    /**
+     * Websocket frame opcodes.
+     */
+    enum Opcode
+    {
+        OPCODE_CONTINUATION = 0x0,  /**< Continuation frame */
+        OPCODE_TEXT         = 0x1,  /**< Text frame */
+        OPCODE_BINARY       = 0x2,  /**< Binary frame */
+        OPCODE_CLOSE        = 0x8,  /**< Connection close */
+        OPCODE_PING         = 0x9,  /**< Ping */
+        OPCODE_PONG         = 0xA   /**< Pong */
+    };
+
+    /**
+     * Parse events.
+     */
+    enum Event
+    {
+        EVENT_NONE = 0, /**< All data is parsed, without any event. */
+        EVENT_TEXT,     /**< A text message is complete, see takeText(). */
+        EVENT_PING,     /**< A ping is received, see getCtrlPayload(). */
+        EVENT_CLOSE,    /**< A close is received, see getCtrlPayload(). */
+        EVENT_ERROR     /**< Protocol error, the parser shall be reset. */
+    };
+
+    /**
+     * Constructs a frame parser.
+     */
+    WebSocketFrameParser();
+
+    /**
+     * Destroys the frame parser.
+     */
+    ~WebSocketFrameParser();
+
+    /**
+     * Reset the parser, e.g. for a new connection. A not taken text message
+     * is released.
+     */
+    void reset();
+
+    /**
+     * Parse received data. The parsing stops after every event, therefore it
+     * shall be called again until all data is parsed.
+     *
+     * @param[in]       data    Data
+     * @param[in]       len     Data length in byte
+     * @param[in,out]   index   Index of the next byte, which to parse.
+     *
+     * @return Parse event
+     */
+    Event parse(const uint8_t* data, size_t len, size_t& index);
+
+    /**
+     * Take the complete text message over. The text is always terminated.
+     * The caller is responsible to release it with delete[].
+     *
+     * @param[out] size Text size in byte, without termination.
+     *
+     * @return Text message. If none is available, it will return nullptr.
+     */
+    char* takeText(size_t& size);
+
+    /**
+     * Get the payload of the last received ping or close.
+     *
+     * @param[out] size Payload size in byte
+     *
+     * @return Payload
+     */
+    const uint8_t* getCtrlPayload(size_t& size) const;
+
+    /** Max. size in byte of a received message. */
+    static const size_t     MAX_MESSAGE_SIZE        = 4096U;
+
+    /** Max. payload size in byte of a control frame. */
+    static const size_t     CTRL_PAYLOAD_MAX_SIZE   = 125U;
+
+private:
+
+    /** Max. size in byte of a frame header. */
+    static const size_t     FRAME_HEADER_MAX_SIZE   = 14U;
+
+    uint8_t     m_frameHeader[FRAME_HEADER_MAX_SIZE];   /**< Received frame header */
+    size_t      m_frameHeaderIndex;                     /**< Number of received frame header bytes */
+    size_t      m_frameHeaderSize;                      /**< Expected frame header size in byte */
+    uint8_t     m_opcode;                               /**< Opcode of the current frame */
+    bool        m_isFin;                                /**< Is the current frame the final fragment? */
+    size_t      m_payloadSize;                          /**< Payload size in byte of the current frame */
+    size_t      m_payloadIndex;                         /**< Number of received payload bytes of the current frame */
+    uint8_t     m_ctrlPayload[CTRL_PAYLOAD_MAX_SIZE];   /**< Payload of the current control frame */
+    size_t      m_ctrlPayloadSize;                      /**< Payload size in byte of the last control frame */
+    uint8_t*    m_msg;                                  /**< Received message, which may be fragmented. */
+    size_t      m_msgSize;                              /**< Received message size in byte */
+    bool        m_isMsgPending;                         /**< Is a fragmented message pending? */
+    bool        m_isMsgText;                            /**< Is the current message a text message? */
+    bool        m_isMsgDiscarded;                       /**< Is the current message discarded? */
+    bool        m_isMsgComplete;                        /**< Is the text message complete and not taken yet? */
+    bool        m_isError;                              /**< Did a protocol error happen? */
+
+    WebSocketFrameParser(const WebSocketFrameParser& parser);
+    WebSocketFrameParser& operator=(const WebSocketFrameParser& parser);
+
+    /**
+     * Handle the complete received frame header.
+     *
+     * @return If the frame is valid, it will return true otherwise false.
+     */
+    bool handleFrameHeader();
+
+    /**
+     * Handle the complete received frame.
+     *
+     * @return Parse event
+     */
+    Event handleFrameComplete();
+
+    /**
+     * Prepare the message buffer for the payload of the current frame.
+     */
+    void prepareMsg();
+
+    /**
+     * Release the message buffer.
+     */
+    void releaseMsg();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* WEBSOCKET_FRAME_PARSER_H */
+
+/** @} */
@@ -0,0 +1,248 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket opening handshake
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WebSocketHandshake.h"
+
+#include <Logging.h>
+#include <base64.h>
+#include <mbedtls/sha1.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize handshake GUID, see RFC6455 chapter 1.3. */
+const char* WebSocketHandshake::GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+WebSocketHandshake::WebSocketHandshake() :
+    m_key(),
+    m_rspLine(),
+    m_isStatusLine(true),
+    m_isUpgraded(false),
+    m_isAccepted(false),
+    m_result(RESULT_PENDING)
+{
+}
+
+WebSocketHandshake::~WebSocketHandshake()
+{
+}
+
+void WebSocketHandshake::begin(const String& key)
+{
+    m_key           = key;
+    m_rspLine.clear();
+    m_isStatusLine  = true;
+    m_isUpgraded    = false;
+    m_isAccepted    = false;
+    m_result        = RESULT_PENDING;
+}
+
+String WebSocketHandshake::getRequest(const String& hostname, uint16_t port, const String& uri) const
+{
+    String request;
+
+    request  = "GET ";
+    request += uri;
+    request += " HTTP/1.1\r\n";
+    request += "Host: ";
+    request += hostname;
+    request += ":";
+    request += port;
+    request += "\r\n";
+    request += "Upgrade: websocket\r\n";
+    request += "Connection: Upgrade\r\n";
+    request += "Sec-WebSocket-Key: ";
+    request += m_key;
+    request += "\r\n";
+    request += "Sec-WebSocket-Version: 13\r\n";
+    request += "\r\n";
+
+    return request;
+}
+
+WebSocketHandshake::Result WebSocketHandshake::parse(const uint8_t* data, size_t len, size_t& index)
+{
+    while((len > index) && (RESULT_PENDING == m_result))
+    {
+        char character = static_cast<char>(data[index]);
+
+        ++index;
+
+        if ('\n' == character)
+        {
+            /* Line end is CRLF, but a single LF shall be tolerated. */
+            if (true == m_rspLine.endsWith("\r"))
+            {
+                m_rspLine.remove(m_rspLine.length() - 1U);
+            }
+
+            /* End of response header? */
+            if (true == m_rspLine.isEmpty())
+            {
+                if ((true == m_isUpgraded) &&
+                    (true == m_isAccepted))
+                {
+                    m_result = RESULT_ACCEPTED;
+                }
+                else
+                {
+                    LOG_WARNING("Websocket handshake rejected.");
+                    m_result = RESULT_REJECTED;
+                }
+            }
+            else if (false == handleLine(m_rspLine))
+            {
+                LOG_WARNING("Invalid websocket handshake response: %s", m_rspLine.c_str());
+                m_result = RESULT_REJECTED;
+            }
+            else
+            {
+                ;
+            }
+
+            m_rspLine.clear();
+        }
+        else if (MAX_LINE_LENGTH <= m_rspLine.length())
+        {
+            LOG_WARNING("Websocket handshake response line too long.");
+            m_result = RESULT_REJECTED;
+        }
+        else
+        {
+            m_rspLine += character;
+        }
+    }
+
+    return m_result;
+}
+
+String WebSocketHandshake::getAcceptValue(const String& key)
+{
+    const size_t    SHA1_SIZE           = 20U;
+    uint8_t         digest[SHA1_SIZE];
+    String          input               = key + GUID;
+    const void*     vInput              = input.c_str();
+    String          acceptValue;
+
+    if (0 == mbedtls_sha1_ret(static_cast<const unsigned char*>(vInput), input.length(), digest))
+    {
+        acceptValue = base64::encode(digest, SHA1_SIZE);
+    }
+
+    return acceptValue;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool WebSocketHandshake::handleLine(const String& line)
+{
+    bool isValid = true;
+
+    /* The server shall switch the protocol, see RFC6455 chapter 4.2.2. */
+    if (true == m_isStatusLine)
+    {
+        m_isStatusLine = false;
+
+        if (false == line.startsWith("HTTP/1.1 101"))
+        {
+            isValid = false;
+        }
+    }
+    else
+    {
+        int index = line.indexOf(':');
+
+        if (0 > index)
+        {
+            isValid = false;
+        }
+        else
+        {
+            String  name    = line.substring(0, index);
+            String  value   = line.substring(index + 1);
+
+            value.trim();
+
+            if (0U != name.equalsIgnoreCase("Upgrade"))
+            {
+                m_isUpgraded = (0U != value.equalsIgnoreCase("websocket"));
+            }
+            else if (0U != name.equalsIgnoreCase("Sec-WebSocket-Accept"))
+            {
+                m_isAccepted = (value == getAcceptValue(m_key));
+            }
+            else
+            {
+                ;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,168 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket opening handshake
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef WEBSOCKET_HANDSHAKE_H
+#define WEBSOCKET_HANDSHAKE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <WString.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The client side of the websocket opening handshake, see RFC6455 chapter 4.
+ * It provides the handshake request and verifies the response of the server:
+ * - The server shall switch the protocol (status code 101).
+ * - The server shall upgrade to the websocket protocol.
+ * - The server shall accept the key of the request.
+ *
+ * The handshake is not protected against concurrent access, this is up to
+ * the user.
+ */
+class WebSocketHandshake
+{
+public:
+
+    /**
+     * Handshake result.
+     */
+    enum Result
+    {
+        RESULT_PENDING = 0, /**< The response is not complete yet. */
+        RESULT_ACCEPTED,    /**< The server accepted the handshake. */
+        RESULT_REJECTED     /**< The server rejected the handshake or the response is invalid. */
+    };
+
+    /**
+     * Constructs a handshake.
+     */
+    WebSocketHandshake();
+
+    /**
+     * Destroys the handshake.
+     */
+    ~WebSocketHandshake();
+
+    /**
+     * Start a new handshake.
+     *
+     * @param[in] key   Base64 encoded random key of KEY_SIZE byte
+     */
+    void begin(const String& key);
+
+    /**
+     * Get the handshake request.
+     *
+     * @param[in] hostname  Server hostname
+     * @param[in] port      Server port
+     * @param[in] uri       Request URI incl. query
+     *
+     * @return Handshake request
+     */
+    String getRequest(const String& hostname, uint16_t port, const String& uri) const;
+
+    /**
+     * Parse the handshake response. The parsing stops after the response
+     * header, any further data belongs to the websocket frames.
+     *
+     * @param[in]       data    Data
+     * @param[in]       len     Data length in byte
+     * @param[in,out]   index   Index of the next byte, which to parse.
+     *
+     * @return Handshake result
+     */
+    Result parse(const uint8_t* data, size_t len, size_t& index);
+
+    /**
+     * Calculate the accept value, which the server shall respond for the key.
+     *
+     * @param[in] key   Base64 encoded handshake key
+     *
+     * @return Base64 encoded accept value
+     */
+    static String getAcceptValue(const String& key);
+
+    /** Handshake key size in byte (before base64 encoding). */
+    static const size_t     KEY_SIZE        = 16U;
+
+    /** Max. length of a response line. */
+    static const size_t     MAX_LINE_LENGTH = 512U;
+
+private:
+
+    /** Magic string, which the server appends to the key for the accept value. */
+    static const char*      GUID;
+
+    String  m_key;          /**< Base64 encoded handshake key */
+    String  m_rspLine;      /**< Current response line */
+    bool    m_isStatusLine; /**< Is the next response line the status line? */
+    bool    m_isUpgraded;   /**< Did the server confirm the protocol upgrade? */
+    bool    m_isAccepted;   /**< Did the server accept the handshake key? */
+    Result  m_result;       /**< Handshake result */
+
+    WebSocketHandshake(const WebSocketHandshake& handshake);
+    WebSocketHandshake& operator=(const WebSocketHandshake& handshake);
+
+    /**
+     * Handle a single response line.
+     *
+     * @param[in] line  Response line without line end
+     *
+     * @return If the line is valid, it will return true otherwise false.
+     */
+    bool handleLine(const String& line);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* WEBSOCKET_HANDSHAKE_H */
+
+/** @} */
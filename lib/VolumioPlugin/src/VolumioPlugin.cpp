@@ -37,6 +37,7 @@
 #include <Logging.h>
 #include <ArduinoJson.h>
 #include <HttpStatus.h>
+#include <SocketIoPacket.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -73,6 +74,9 @@ const char* VolumioPlugin::IMAGE_PATH_PAUSE_ICON    = "/plugins/VolumioPlugin/vo
 /* Initialize plugin topic. */
 const char* VolumioPlugin::TOPIC_CONFIG             = "/host";
 
+/* Initialize URI of the socket.io interface. */
+const char* VolumioPlugin::PUSH_URI                 = "/socket.io/?EIO=3&transport=websocket";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -139,19 +143,6 @@ bool VolumioPlugin::setTopic(const String& topic, const JsonObjectConst& value)
     return isSuccessful;
 }
 
-bool VolumioPlugin::hasTopicChanged(const String& topic)
-{
-    MutexGuard<MutexRecursive>  guard(m_mutex);
-    bool                        hasTopicChanged = m_hasTopicChanged;
-
-    /* Only a single topic, therefore its not necessary to check. */
-    PLUGIN_NOT_USED(topic);
-
-    m_hasTopicChanged = false;
-
-    return hasTopicChanged;
-}
-
 void VolumioPlugin::start(uint16_t width, uint16_t height)
 {
     uint16_t                    tcHeight        = 0U;
@@ -205,17 +196,14 @@ void VolumioPlugin::start(uint16_t width, uint16_t height)
             LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
         }
     }
-    else
-    {
-        /* Remember current timestamp to detect updates of the configuration in the
-         * filesystem without using the plugin API.
-         */
-        updateTimestampLastUpdate();
-    }
 
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
+    /* The player state is requested in the background too, because the
+     * plugin enables itself as soon as VOLUMIO is online.
+     */
+    (void)PollingService::getInstance().registerPoll(getUID(), UPDATE_PERIOD, UPDATE_PERIOD_IDLE);
 
     initHttpClient();
+    initWebSocketClient();
 
     m_offlineTimer.start(OFFLINE_PERIOD);
 }
@@ -225,11 +213,15 @@ void VolumioPlugin::stop()
     String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
-    m_cfgReloadTimer.stop();
     m_offlineTimer.stop();
-    m_requestTimer.stop();
-
-    if (false != FILESYSTEM.remove(configurationFilename))
+    m_pushPingTimer.stop();
+    m_pushAliveTimer.stop();
+    m_pushRetryTimer.stop();
+    m_wsClient.disconnect();
+    m_isPushConnected = false;
+    PollingService::getInstance().unregisterPoll(getUID());
+
+    if (false != removeConfiguration())
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
@@ -241,34 +233,23 @@ void VolumioPlugin::process(bool isConnected)
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     /* Configuration in persistent memory updated? */
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    if (true == isConfigurationUpdated())
     {
-        if (true == isConfigurationUpdated())
-        {
-            m_reloadConfigReq = true;
-        }
-
-        m_cfgReloadTimer.restart();
+        m_reloadConfigReq = true;
     }
 
-    if (true == m_storeConfigReq)
+    if (true == isSaveConfigurationDue())
     {
         if (false == saveConfiguration())
         {
             LOG_WARNING("Failed to save configuration: %s", getFullPathToConfiguration().c_str());
         }
-
-        m_storeConfigReq = false;
     }
     else if (true == m_reloadConfigReq)
     {
         LOG_INFO("Reload configuration: %s", getFullPathToConfiguration().c_str());
 
-        if (true == loadConfiguration())
-        {
-            updateTimestampLastUpdate();
-        }
+        (void)loadConfiguration();
 
         m_reloadConfigReq = false;
     }
@@ -277,40 +258,33 @@ void VolumioPlugin::process(bool isConnected)
         ;
     }
     
-    /* Only if a network connection is established the required information
-     * shall be periodically requested via REST API.
-     */
-    if (false == m_requestTimer.isTimerRunning())
+    if (false == isConnected)
     {
-        if (true == isConnected)
+        if (false == m_wsClient.isClosed())
         {
-            if (false == startHttpRequest())
-            {
-                /* If a request fails, show standard icon and a '?' */
-                changeState(STATE_UNKNOWN);
-                m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
-            }
+            m_wsClient.disconnect();
         }
     }
+    /* The state is preferred pushed by VOLUMIO. */
+    else if (true == m_isPushConnected)
+    {
+        processPushConnection();
+    }
     else
     {
-        /* If the connection is lost, stop periodically requesting information
-         * via REST API.
-         */
-        if (false == isConnected)
+        /* Retry to establish the push connection. */
+        if ((true == m_wsClient.isClosed()) &&
+            ((false == m_pushRetryTimer.isTimerRunning()) ||
+             (true == m_pushRetryTimer.isTimeout())))
         {
-            m_requestTimer.stop();
+            (void)startPushConnection();
+            m_pushRetryTimer.start(PUSH_RETRY_PERIOD);
         }
-        /* Network connection is available and next request may be necessary for
-         * information update.
+
+        /* Meanwhile the required information shall be requested via REST API.
+         * When is decided by the polling service, depended on the slot schedule.
          */
-        else if (true == m_requestTimer.isTimeout())
+        if (true == PollingService::getInstance().isPollDue(getUID()))
         {
             if (false == startHttpRequest())
             {
@@ -318,11 +292,7 @@ void VolumioPlugin::process(bool isConnected)
                 changeState(STATE_UNKNOWN);
                 m_textWidget.setFormatStr("\\calign?");
 
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
-            }
-            else
-            {
-                m_requestTimer.start(UPDATE_PERIOD);
+                PollingService::getInstance().reportResult(getUID(), false);
             }
         }
     }
@@ -338,10 +308,12 @@ void VolumioPlugin::process(bool isConnected)
         case MSG_TYPE_RSP:
             if (nullptr != msg.rsp)
             {
-                handleWebResponse(*msg.rsp);
+                handleWebResponse(*msg.rsp, false);
                 delete msg.rsp;
                 msg.rsp = nullptr;
             }
+
+            PollingService::getInstance().reportResult(getUID(), true);
             break;
 
         case MSG_TYPE_CONN_CLOSED:
@@ -352,10 +324,11 @@ void VolumioPlugin::process(bool isConnected)
                 /* If a request fails, show standard icon and a '?' */
                 changeState(STATE_UNKNOWN);
                 m_textWidget.setFormatStr("\\calign?");
-
-                m_requestTimer.start(UPDATE_PERIOD_SHORT);
             }
             m_isConnectionError = false;
+
+            /* Closed without a valid response before? */
+            PollingService::getInstance().reportResult(getUID(), false);
             break;
 
         case MSG_TYPE_CONN_ERROR:
@@ -363,6 +336,45 @@ void VolumioPlugin::process(bool isConnected)
             m_isConnectionError = true;
             break;
 
+        case MSG_TYPE_PUSH_OPEN:
+            LOG_INFO("Push connection established.");
+            m_isPushConnected = true;
+            m_pushPingTimer.start(msg.pingInterval);
+            m_pushAliveTimer.start(msg.pingInterval + PUSH_PING_TIMEOUT);
+            break;
+
+        case MSG_TYPE_PUSH_STATE:
+            if (nullptr != msg.rsp)
+            {
+                handleWebResponse(*msg.rsp, true);
+                delete msg.rsp;
+                msg.rsp = nullptr;
+            }
+
+            m_pushAliveTimer.restart();
+            break;
+
+        case MSG_TYPE_PUSH_ALIVE:
+            m_pushAliveTimer.restart();
+
+            /* VOLUMIO is still online, even if the state doesn't change. */
+            m_offlineTimer.restart();
+            break;
+
+        case MSG_TYPE_PUSH_CLOSED:
+            LOG_INFO("Push connection closed.");
+
+            /* Bridge the gap until the push connection is established again. */
+            if (true == m_isPushConnected)
+            {
+                PollingService::getInstance().triggerPoll(getUID());
+            }
+
+            m_isPushConnected = false;
+            m_pushPingTimer.stop();
+            m_pushAliveTimer.stop();
+            break;
+
         default:
             /* Should never happen. */
             break;
@@ -408,9 +420,7 @@ void VolumioPlugin::update(YAGfx& gfx)
 
 void VolumioPlugin::requestStoreToPersistentMemory()
 {
-    MutexGuard<MutexRecursive> guard(m_mutex);
-
-    m_storeConfigReq = true;
+    requestSaveConfiguration();
 }
 
 void VolumioPlugin::getConfiguration(JsonObject& jsonCfg) const
@@ -436,9 +446,13 @@ bool VolumioPlugin::setConfiguration(JsonObjectConst& jsonCfg)
         m_volumioHost = jsonHost.as<String>();
 
         /* Force update on display */
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        PollingService::getInstance().triggerPoll(getUID());
 
-        m_hasTopicChanged = true;
+        /* Push connection to the new host shall be established immediately. */
+        m_wsClient.disconnect();
+        m_pushRetryTimer.stop();
+
+        notifyTopicChanged(TOPIC_CONFIG);
 
         status = true;
     }
@@ -557,50 +571,141 @@ void VolumioPlugin::initHttpClient()
     );
 }
 
-void VolumioPlugin::handleAsyncWebResponse(const HttpResponse& rsp)
+bool VolumioPlugin::startPushConnection()
 {
-    if (HttpStatus::STATUS_CODE_OK == rsp.getStatusCode())
+    bool status = false;
+
+    if (false == m_volumioHost.isEmpty())
     {
-        const size_t            JSON_DOC_SIZE   = 512U;
-        DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+        String url = String("ws://") + m_volumioHost + PUSH_URI;
 
-        if (nullptr != jsonDoc)
+        status = m_wsClient.connect(url);
+    }
+
+    return status;
+}
+
+void VolumioPlugin::initWebSocketClient()
+{
+    /* Note: All registered callbacks are running in a different task context!
+     *       Therefore it is not allowed to access a member here directly.
+     *       The processing must be deferred via task proxy.
+     */
+    m_wsClient.regOnText(
+        [this](const char* text, size_t size)
         {
-            size_t                          payloadSize = 0U;
-            const void*                     vPayload    = rsp.getPayload(payloadSize);
-            const char*                     payload     = static_cast<const char*>(vPayload);
-            const size_t                    FILTER_SIZE = 128U;
-            StaticJsonDocument<FILTER_SIZE> filter;
-
-            filter["artist"]    = true;
-            filter["duration"]  = true;
-            filter["seek"]      = true;
-            filter["service"]   = true;
-            filter["status"]    = true;
-            filter["title"]     = true;
-            
-            if (true == filter.overflowed())
-            {
-                LOG_ERROR("Less memory for filter available.");
-            }
-            else if ((nullptr == payload) ||
-                     (0U == payloadSize))
-            {
-                LOG_ERROR("No payload.");
-            }
-            else
+            handleAsyncPushMessage(text, size);
+        }
+    );
+
+    m_wsClient.regOnClosed(
+        [this]()
+        {
+            Msg msg;
+
+            msg.type = MSG_TYPE_PUSH_CLOSED;
+
+            (void)this->m_taskProxy.send(msg);
+        }
+    );
+}
+
+void VolumioPlugin::processPushConnection()
+{
+    /* The client shall send the heartbeat (Engine.IO protocol v3). */
+    if ((true == m_pushPingTimer.isTimerRunning()) &&
+        (true == m_pushPingTimer.isTimeout()))
+    {
+        const char* EIO_PING = "2";
+
+        (void)m_wsClient.sendText(EIO_PING);
+        m_pushPingTimer.restart();
+    }
+
+    /* No response from VOLUMIO, the connection is dead. */
+    if ((true == m_pushAliveTimer.isTimerRunning()) &&
+        (true == m_pushAliveTimer.isTimeout()))
+    {
+        LOG_WARNING("Push connection timeout.");
+
+        m_wsClient.disconnect();
+        m_pushAliveTimer.stop();
+    }
+
+    updatePosition();
+}
+
+void VolumioPlugin::handleAsyncPushMessage(const char* text, size_t size)
+{
+    SocketIoPacket  packet;
+    const char*     data        = nullptr;
+    size_t          dataSize    = 0U;
+    Msg             msg;
+
+    if (false == packet.decode(text, size))
+    {
+        LOG_WARNING("Invalid push message.");
+    }
+    else
+    {
+        data = packet.getData(dataSize);
+
+        switch(packet.getType())
+        {
+        case SocketIoPacket::TYPE_OPEN:
             {
-                DeserializationError error = deserializeJson(*jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+                const size_t                        JSON_DOC_SIZE   = 128U;
+                StaticJsonDocument<JSON_DOC_SIZE>   jsonDoc;
+                StaticJsonDocument<JSON_DOC_SIZE>   filter;
+                DeserializationError                error;
+
+                filter["pingInterval"] = true;
 
-                if (DeserializationError::Ok != error.code())
+                error = deserializeJson(jsonDoc, data, dataSize, DeserializationOption::Filter(filter));
+
+                msg.type            = MSG_TYPE_PUSH_OPEN;
+                msg.pingInterval    = PUSH_PING_INTERVAL;
+
+                if ((DeserializationError::Ok == error.code()) &&
+                    (true == jsonDoc["pingInterval"].is<uint32_t>()))
                 {
-                    LOG_WARNING("JSON parse error: %s", error.c_str());
+                    msg.pingInterval = jsonDoc["pingInterval"].as<uint32_t>();
                 }
-                else
-                {
-                    Msg msg;
 
-                    msg.type    = MSG_TYPE_RSP;
+                (void)this->m_taskProxy.send(msg);
+            }
+            break;
+
+        case SocketIoPacket::TYPE_CLOSE:
+            m_wsClient.disconnect();
+            break;
+
+        /* Heartbeat of the server (Engine.IO protocol v4) */
+        case SocketIoPacket::TYPE_PING:
+            (void)m_wsClient.sendText("3");
+
+            msg.type = MSG_TYPE_PUSH_ALIVE;
+            (void)this->m_taskProxy.send(msg);
+            break;
+
+        case SocketIoPacket::TYPE_PONG:
+            msg.type = MSG_TYPE_PUSH_ALIVE;
+            (void)this->m_taskProxy.send(msg);
+            break;
+
+        /* Request the current state once, afterwards every change is pushed. */
+        case SocketIoPacket::TYPE_CONNECT:
+            (void)m_wsClient.sendText("42[\"getState\"]");
+            break;
+
+        case SocketIoPacket::TYPE_EVENT:
+            if (0U != packet.getEventName().equals("pushState"))
+            {
+                DynamicJsonDocument* jsonDoc = parseState(data, dataSize);
+
+                if (nullptr != jsonDoc)
+                {
+                    msg.type    = MSG_TYPE_PUSH_STATE;
                     msg.rsp     = jsonDoc;
 
                     if (false == this->m_taskProxy.send(msg))
@@ -610,11 +715,92 @@ void VolumioPlugin::handleAsyncWebResponse(const HttpResponse& rsp)
                     }
                 }
             }
+            break;
+
+        default:
+            /* Not supported */
+            break;
         }
     }
 }
 
-void VolumioPlugin::handleWebResponse(DynamicJsonDocument& jsonDoc)
+DynamicJsonDocument* VolumioPlugin::parseState(const char* payload, size_t size)
+{
+    const size_t            JSON_DOC_SIZE   = 512U;
+    DynamicJsonDocument*    jsonDoc         = new(std::nothrow) DynamicJsonDocument(JSON_DOC_SIZE);
+
+    if (nullptr != jsonDoc)
+    {
+        const size_t                    FILTER_SIZE = 128U;
+        StaticJsonDocument<FILTER_SIZE> filter;
+        bool                            isValid     = false;
+
+        filter["artist"]    = true;
+        filter["duration"]  = true;
+        filter["seek"]      = true;
+        filter["service"]   = true;
+        filter["status"]    = true;
+        filter["title"]     = true;
+        
+        if (true == filter.overflowed())
+        {
+            LOG_ERROR("Less memory for filter available.");
+        }
+        else if ((nullptr == payload) ||
+                 (0U == size))
+        {
+            LOG_ERROR("No payload.");
+        }
+        else
+        {
+            DeserializationError error = deserializeJson(*jsonDoc, payload, size, DeserializationOption::Filter(filter));
+
+            if (DeserializationError::Ok != error.code())
+            {
+                LOG_WARNING("JSON parse error: %s", error.c_str());
+            }
+            else
+            {
+                isValid = true;
+            }
+        }
+
+        if (false == isValid)
+        {
+            delete jsonDoc;
+            jsonDoc = nullptr;
+        }
+    }
+
+    return jsonDoc;
+}
+
+void VolumioPlugin::handleAsyncWebResponse(const HttpResponse& rsp)
+{
+    if (HttpStatus::STATUS_CODE_OK == rsp.getStatusCode())
+    {
+        size_t                  payloadSize = 0U;
+        const void*             vPayload    = rsp.getPayload(payloadSize);
+        const char*             payload     = static_cast<const char*>(vPayload);
+        DynamicJsonDocument*    jsonDoc     = parseState(payload, payloadSize);
+
+        if (nullptr != jsonDoc)
+        {
+            Msg msg;
+
+            msg.type    = MSG_TYPE_RSP;
+            msg.rsp     = jsonDoc;
+
+            if (false == this->m_taskProxy.send(msg))
+            {
+                delete jsonDoc;
+                jsonDoc = nullptr;
+            }
+        }
+    }
+}
+
+void VolumioPlugin::handleWebResponse(DynamicJsonDocument& jsonDoc, bool isPushed)
 {
     JsonVariantConst    jsonStatus  = jsonDoc["status"];
     JsonVariantConst    jsonTitle   = jsonDoc["title"];
@@ -706,14 +892,21 @@ void VolumioPlugin::handleWebResponse(DynamicJsonDocument& jsonDoc)
                     pos = 100U;
                 }
             }
+
+            m_duration = duration;
         }
         else
         {
             pos = 0U;
+            m_duration = 0U;
         }
 
-        /* Workaround for a VOLUMIO bug, which provides a wrong status. */
-        if (status == "stop")
+        /* Workaround for a VOLUMIO bug, which provides a wrong status.
+         * A pushed state contains only the seek value at the time of the
+         * change, therefore its not applicable there.
+         */
+        if ((false == isPushed) &&
+            (status == "stop"))
         {
             if (m_lastSeekValue != seekValue)
             {
@@ -721,6 +914,7 @@ void VolumioPlugin::handleWebResponse(DynamicJsonDocument& jsonDoc)
             }
         }
         m_lastSeekValue = seekValue;
+        m_seekTimestamp = millis();
 
         if (status == "stop")
         {
@@ -756,13 +950,33 @@ void VolumioPlugin::handleWebResponse(DynamicJsonDocument& jsonDoc)
     }
 }
 
+void VolumioPlugin::updatePosition()
+{
+    if ((STATE_PLAY == m_state) &&
+        (0U < m_duration))
+    {
+        uint32_t seekValue  = m_lastSeekValue + (millis() - m_seekTimestamp);
+        uint32_t pos        = seekValue / m_duration;
+
+        pos /= 10U;
+
+        if (100U < pos)
+        {
+            pos = 100U;
+        }
+
+        m_pos = static_cast<uint8_t>(pos);
+    }
+}
+
 void VolumioPlugin::clearQueue()
 {
     Msg msg;
 
     while(true == m_taskProxy.receive(msg))
     {
-        if (MSG_TYPE_RSP == msg.type)
+        if ((MSG_TYPE_RSP == msg.type) ||
+            (MSG_TYPE_PUSH_STATE == msg.type))
         {
             delete msg.rsp;
             msg.rsp = nullptr;
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include "Plugin.hpp"
 #include "AsyncHttpClient.h"
+#include "AsyncWebSocketClient.h"
 
 #include <WidgetGroup.h>
 #include <BitmapWidget.h>
@@ -53,6 +54,7 @@
 #include <TaskProxy.hpp>
 #include <Mutex.hpp>
 #include <FileSystem.h>
+#include <PollingService.h>
 
 /******************************************************************************
  * Macros
@@ -66,6 +68,10 @@
  * Shows the current state of VOLUMIO and the artist/title of the played music.
  * If the VOLUMIO server is offline, the plugin gets automatically disabled,
  * otherwise enabled.
+ *
+ * The state is pushed by VOLUMIO via its socket.io interface over a persistent
+ * websocket connection. As long as this connection is not available, the state
+ * is polled via REST API.
  */
 class VolumioPlugin : public Plugin, private PluginConfigFsHandler
 {
@@ -91,17 +97,20 @@ public:
         m_urlIcon(),
         m_urlText(),
         m_client(),
-        m_requestTimer(),
+        m_wsClient(),
+        m_isPushConnected(false),
+        m_pushPingTimer(),
+        m_pushAliveTimer(),
+        m_pushRetryTimer(),
         m_offlineTimer(),
         m_mutex(),
         m_isConnectionError(false),
         m_lastSeekValue(0U),
+        m_seekTimestamp(0U),
+        m_duration(0U),
         m_pos(0U),
         m_state(STATE_UNKNOWN),
-        m_cfgReloadTimer(),
-        m_storeConfigReq(false),
         m_reloadConfigReq(false),
-        m_hasTopicChanged(false),
         m_taskProxy()
     {
         (void)m_mutex.create();
@@ -116,10 +125,16 @@ public:
         m_client.regOnClosed(nullptr);
         m_client.regOnError(nullptr);
 
+        m_wsClient.regOnOpen(nullptr);
+        m_wsClient.regOnText(nullptr);
+        m_wsClient.regOnClosed(nullptr);
+        m_wsClient.regOnError(nullptr);
+
         /* Abort any pending TCP request to avoid getting a callback after the
          * object is destroyed.
          */
         m_client.end();
+        m_wsClient.disconnect();
         
         clearQueue();
 
@@ -191,17 +206,6 @@ public:
      */
     bool setTopic(const String& topic, const JsonObjectConst& value) final;
 
-    /**
-     * Is the topic content changed since last time?
-     * Every readable volatile topic shall support this. Otherwise the topic
-     * handlers might not be able to provide updated information.
-     * 
-     * @param[in] topic The topic which to check.
-     * 
-     * @return If the topic content changed since last time, it will return true otherwise false.
-     */
-    bool hasTopicChanged(const String& topic) final;
-    
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -292,31 +296,47 @@ private:
     static const char*      TOPIC_CONFIG;
 
     /**
-     * Period in ms for requesting data from server.
-     * This is used in case the last request to the server was successful.
-     * The period is shorter than the UPDATE_PERIOD_SHORT, because if the music
+     * Period in ms for requesting data from server, while the slot is shown.
+     * The period is shorter than the UPDATE_PERIOD_IDLE, because if the music
      * changes, the display shall be updated more or less immediately.
      */
     static const uint32_t   UPDATE_PERIOD       = SIMPLE_TIMER_SECONDS(2U);
 
     /**
-     * Short period in ms for requesting data from server.
-     * This is used in case the request to the server failed.
+     * Period in ms for requesting data from server, while the slot is not
+     * shown or disabled. This is necessary to detect whether VOLUMIO is online.
      */
-    static const uint32_t   UPDATE_PERIOD_SHORT = SIMPLE_TIMER_SECONDS(10U);
+    static const uint32_t   UPDATE_PERIOD_IDLE  = SIMPLE_TIMER_SECONDS(10U);
 
     /**
-     * Period in ms after which the plugin gets automatically disabled if no new
-     * data is available.
+     * URI of the VOLUMIO socket.io interface (Engine.IO protocol v3), which
+     * pushes the player state.
      */
-    static const uint32_t   OFFLINE_PERIOD      = SIMPLE_TIMER_SECONDS(60U);
+    static const char*      PUSH_URI;
+
+    /**
+     * Period in ms for retrying to establish the push connection. Meanwhile
+     * the state is polled.
+     */
+    static const uint32_t   PUSH_RETRY_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
+
+    /**
+     * Default ping interval in ms of the push connection, if VOLUMIO doesn't
+     * provide it.
+     */
+    static const uint32_t   PUSH_PING_INTERVAL  = SIMPLE_TIMER_SECONDS(25U);
 
     /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
+     * Period in ms after the ping interval, in which VOLUMIO shall respond.
+     * Otherwise the push connection is considered as dead.
      */
-    static const uint32_t   CFG_RELOAD_PERIOD   = SIMPLE_TIMER_SECONDS(30U);
+    static const uint32_t   PUSH_PING_TIMEOUT   = SIMPLE_TIMER_SECONDS(20U);
+
+    /**
+     * Period in ms after which the plugin gets automatically disabled if no new
+     * data is available.
+     */
+    static const uint32_t   OFFLINE_PERIOD      = SIMPLE_TIMER_SECONDS(60U);
 
     WidgetGroup             m_textCanvas;           /**< Canvas used for the text widget. */
     WidgetGroup             m_iconCanvas;           /**< Canvas used for the bitmap widget. */
@@ -329,17 +349,20 @@ private:
     String                  m_urlIcon;              /**< REST API URL for updating the icon */
     String                  m_urlText;              /**< REST API URL for updating the text */
     AsyncHttpClient         m_client;               /**< Asynchronous HTTP client. */
-    SimpleTimer             m_requestTimer;         /**< Timer used for cyclic request of new data. */
+    AsyncWebSocketClient    m_wsClient;             /**< Asynchronous websocket client, used for the push connection. */
+    bool                    m_isPushConnected;      /**< Is the push connection established? */
+    SimpleTimer             m_pushPingTimer;        /**< Timer used to send a ping via push connection. */
+    SimpleTimer             m_pushAliveTimer;       /**< Timer used to detect a dead push connection. */
+    SimpleTimer             m_pushRetryTimer;       /**< Timer used to retry establishing the push connection. */
     SimpleTimer             m_offlineTimer;         /**< Timer used for offline detection. */
     mutable MutexRecursive  m_mutex;                /**< Mutex to protect against concurrent access. */
     bool                    m_isConnectionError;    /**< Is connection error happened? */
     uint32_t                m_lastSeekValue;        /**< Last seek value, retrieved from VOLUMIO. Used to cross-check the provided status. */
+    uint32_t                m_seekTimestamp;        /**< Timestamp in ms, when the last seek value was retrieved. */
+    uint32_t                m_duration;             /**< Duration in s of the current music, 0 if unknown. */
     uint8_t                 m_pos;                  /**< Current music position in percent. */
     VolumioState            m_state;                /**< Volumio player state */
-    SimpleTimer             m_cfgReloadTimer;       /**< Timer is used to cyclic reload the configuration from persistent memory. */
-    bool                    m_storeConfigReq;       /**< Is requested to store the configuration in persistent memory? */
     bool                    m_reloadConfigReq;      /**< Is requested to reload the configuration from persistent memory? */
-    bool                    m_hasTopicChanged;      /**< Has the topic content changed? */
 
     /**
      * Defines the message types, which are necessary for HTTP client/server handling.
@@ -349,7 +372,11 @@ private:
         MSG_TYPE_INVALID = 0,   /**< Invalid message type. */
         MSG_TYPE_RSP,           /**< A response, caused by a previous request. */
         MSG_TYPE_CONN_CLOSED,   /**< The connection is closed. */
-        MSG_TYPE_CONN_ERROR     /**< A connection error happened. */
+        MSG_TYPE_CONN_ERROR,    /**< A connection error happened. */
+        MSG_TYPE_PUSH_OPEN,     /**< The push connection is established. */
+        MSG_TYPE_PUSH_STATE,    /**< A state, pushed by VOLUMIO. */
+        MSG_TYPE_PUSH_ALIVE,    /**< VOLUMIO responded to the heartbeat. */
+        MSG_TYPE_PUSH_CLOSED    /**< The push connection is closed. */
     };
 
     /**
@@ -357,15 +384,17 @@ private:
      */
     struct Msg
     {
-        MsgType                 type;   /**< Message type */
-        DynamicJsonDocument*    rsp;    /**< Response, only valid if message type is a response. */
+        MsgType                 type;           /**< Message type */
+        DynamicJsonDocument*    rsp;            /**< Response, only valid if message type is a response or pushed state. */
+        uint32_t                pingInterval;   /**< Ping interval in ms, only valid if the push connection is established. */
 
         /**
          * Constructs a message.
          */
         Msg() :
             type(MSG_TYPE_INVALID),
-            rsp(nullptr)
+            rsp(nullptr),
+            pingInterval(0U)
         {
         }
     }; 
@@ -373,7 +402,7 @@ private:
     /**
      * Task proxy used to decouple server responses, which happen in a different task context.
      */
-    TaskProxy<Msg, 2U, 0U> m_taskProxy;
+    TaskProxy<Msg, 4U, 0U> m_taskProxy;
 
     /**
      * Request to store configuration to persistent memory.
@@ -416,6 +445,43 @@ private:
      */
     void initHttpClient(void);
 
+    /**
+     * Establish the push connection to VOLUMIO.
+     *
+     * @return If the connection establishment is pending, it will return true otherwise false.
+     */
+    bool startPushConnection(void);
+
+    /**
+     * Register callback functions of the push connection.
+     */
+    void initWebSocketClient(void);
+
+    /**
+     * Handle the push connection: Heartbeat and dead connection detection.
+     */
+    void processPushConnection(void);
+
+    /**
+     * Handle asynchronous message of the push connection.
+     * This will be called in LwIP context! Don't modify any member here directly!
+     * The message is decoded as Engine.IO/Socket.IO packet.
+     *
+     * @param[in] text  Socket.io message
+     * @param[in] size  Message size in byte
+     */
+    void handleAsyncPushMessage(const char* text, size_t size);
+
+    /**
+     * Parse the VOLUMIO player state.
+     *
+     * @param[in] payload   Player state in JSON format
+     * @param[in] size      Payload size in byte
+     *
+     * @return If successful, it will return the JSON document otherwise nullptr.
+     */
+    DynamicJsonDocument* parseState(const char* payload, size_t size);
+
     /**
      * Handle asynchronous web response from the server.
      * This will be called in LwIP context! Don't modify any member here directly!
@@ -425,11 +491,18 @@ private:
     void handleAsyncWebResponse(const HttpResponse& rsp);
 
     /**
-     * Handle a web response from the server.
+     * Handle a web response or pushed state from the server.
      * 
      * @param[in] jsonDoc   Web response as JSON document
+     * @param[in] isPushed  Is the state pushed by the server?
+     */
+    void handleWebResponse(DynamicJsonDocument& jsonDoc, bool isPushed);
+
+    /**
+     * Update the music position, while playing. This is necessary, because
+     * the pushed state contains only the position at the time of the push.
      */
-    void handleWebResponse(DynamicJsonDocument& jsonDoc);
+    void updatePosition();
 
     /**
      * Clear the task proxy queue.
@@ -37,6 +37,7 @@
 #include <YAColor.h>
 #include <Logging.h>
 #include <BmpImgLoader.h>
+#include <NativeImg.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -72,7 +73,9 @@ BitmapWidget& BitmapWidget::operator=(const BitmapWidget& widget)
         Widget::operator=(widget);
         
         m_bitmap        = widget.m_bitmap;
+        m_cachedBitmap  = widget.m_cachedBitmap;
         m_spriteSheet   = widget.m_spriteSheet;
+        m_gifPlayer     = widget.m_gifPlayer;
         m_timer         = widget.m_timer;
         m_duration      = widget.m_duration;
     }
@@ -82,8 +85,28 @@ BitmapWidget& BitmapWidget::operator=(const BitmapWidget& widget)
 
 void BitmapWidget::clear(const Color& color)
 {
-    if (true == m_spriteSheet.isEmpty())
+    if (true == m_gifPlayer.isOpen())
     {
+        m_gifPlayer.close();
+        m_timer.stop();
+    }
+    else if (true == m_spriteSheet.isEmpty())
+    {
+        /* A cached bitmap is shared and must not be modified. Copy it before. */
+        if (false == m_cachedBitmap.isEmpty())
+        {
+            const YAGfxDynamicBitmap& cachedBitmap = m_cachedBitmap.get();
+
+            m_bitmap.release();
+
+            if (true == m_bitmap.create(cachedBitmap.getWidth(), cachedBitmap.getHeight()))
+            {
+                m_bitmap.copy(cachedBitmap);
+            }
+
+            m_cachedBitmap.release();
+        }
+
         m_bitmap.fillScreen(color);
     }
     else
@@ -95,51 +118,66 @@ void BitmapWidget::clear(const Color& color)
 
 bool BitmapWidget::load(FS& fs, const String& filename)
 {
-    bool isSuccessful = false;
+    bool                isSuccessful    = false;
+    BmpImgLoader::Ret   ret             = BmpImgLoader::RET_OK;
+
+    /* The existence of the file is not checked before, because a cached
+     * image shall be loaded without any filesystem access.
+     */
+    ret = ImageCache::getInstance().load(fs, filename, m_cachedBitmap);
 
-    if (false == fs.exists(filename))
+    /* A GIF image is not cached, it is played directly from the filesystem. */
+    if (BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED == ret)
+    {
+        if (true == m_gifPlayer.open(fs, filename))
+        {
+            m_cachedBitmap.release();
+            ret = BmpImgLoader::RET_OK;
+        }
+    }
+    else if (BmpImgLoader::RET_OK == ret)
     {
-        LOG_WARNING("File %s doesn't exists.", filename.c_str());
+        m_gifPlayer.close();
     }
     else
     {
-        BmpImgLoader        loader;
-        BmpImgLoader::Ret   ret = loader.load(fs, filename, m_bitmap);
+        ;
+    }
 
-        if (BmpImgLoader::RET_OK != ret)
+    if (BmpImgLoader::RET_OK != ret)
+    {
+        if (BmpImgLoader::RET_FILE_NOT_FOUND == ret)
         {
-            if (BmpImgLoader::RET_FILE_NOT_FOUND == ret)
-            {
-                LOG_ERROR("Failed to open file %s.", filename.c_str());
-            }
-            else if (BmpImgLoader::RET_FILE_FORMAT_INVALID == ret)
-            {
-                LOG_ERROR("File %s has invalid format.", filename.c_str());
-            }
-            else if (BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED == ret)
-            {
-                LOG_ERROR("File %s has unsupported format.", filename.c_str());
-            }
-            else if (BmpImgLoader::RET_IMG_TOO_BIG == ret)
-            {
-                LOG_ERROR("File %s is too big.", filename.c_str());
-            }
-            else
-            {
-                LOG_ERROR("Failed to load %s because of internal error.", filename.c_str());
-            }
+            LOG_WARNING("File %s doesn't exists.", filename.c_str());
+        }
+        else if (BmpImgLoader::RET_FILE_FORMAT_INVALID == ret)
+        {
+            LOG_ERROR("File %s has invalid format.", filename.c_str());
+        }
+        else if (BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED == ret)
+        {
+            LOG_ERROR("File %s has unsupported format.", filename.c_str());
+        }
+        else if (BmpImgLoader::RET_IMG_TOO_BIG == ret)
+        {
+            LOG_ERROR("File %s is too big.", filename.c_str());
         }
         else
         {
-            /* Avoid wasting memory. Additional this is important to detect whether the sprite sheet
-             * shall be shown or the single bitmap image.
-             */
-            m_spriteSheet.release();
-            m_timer.stop();
-
-            isSuccessful = true;
+            LOG_ERROR("Failed to load %s because of internal error.", filename.c_str());
         }
     }
+    else
+    {
+        /* Avoid wasting memory. Additional this is important to detect whether the sprite sheet
+         * shall be shown or the single bitmap image.
+         */
+        m_bitmap.release();
+        m_spriteSheet.release();
+        m_timer.stop();
+
+        isSuccessful = true;
+    }
 
     return isSuccessful;
 }
@@ -148,11 +186,10 @@ bool BitmapWidget::loadSpriteSheet(FS& fs, const String& spriteSheetFileName, co
 {
     bool isSuccessful = false;
 
-    if (false == fs.exists(spriteSheetFileName))
-    {
-        LOG_WARNING("File %s doesn't exists.", spriteSheetFileName.c_str());
-    }
-    else if (false == fs.exists(textureFileName))
+    /* The sprite sheet file is optional, because a native texture image
+     * may contain the sprite sheet information.
+     */
+    if (false == NativeImg::exists(fs, textureFileName))
     {
         LOG_WARNING("File %s doesn't exists.", textureFileName.c_str());
     }
@@ -164,7 +201,9 @@ bool BitmapWidget::loadSpriteSheet(FS& fs, const String& spriteSheetFileName, co
         /* Avoid wasting memory. Additional this is important to detect whether the sprite sheet
          * shall be shown or the single bitmap image.
          */
-        m_bitmap.release();        
+        m_bitmap.release();
+        m_cachedBitmap.release();
+        m_gifPlayer.close();
 
         isSuccessful = true;
     }
@@ -200,6 +239,37 @@ void BitmapWidget::setSpriteSheetRepeatInfinite(bool repeat)
  * Private Methods
  *****************************************************************************/
 
+void BitmapWidget::paintGif(YAGfx& gfx)
+{
+    gfx.drawBitmap(m_posX, m_posY, m_gifPlayer.getFrame());
+
+    /* If timer is not running, start it with the delay of the current frame. */
+    if (false == m_timer.isTimerRunning())
+    {
+        m_timer.start(m_gifPlayer.getDelay());
+    }
+    /* If the timer has a timeout, decode the next frame and restart timer. */
+    else if (true == m_timer.isTimeout())
+    {
+        if (false == m_gifPlayer.next())
+        {
+            LOG_WARNING("Failed to decode GIF image frame.");
+
+            m_gifPlayer.close();
+            m_timer.stop();
+        }
+        else
+        {
+            m_timer.start(m_gifPlayer.getDelay());
+        }
+    }
+    else
+    {
+        /* Nothing to do. */
+        ;
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
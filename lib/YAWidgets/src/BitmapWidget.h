@@ -49,6 +49,8 @@
 
 #include "Widget.hpp"
 #include "SpriteSheet.h"
+#include "ImageCache.h"
+#include "GifImgPlayer.h"
 
 /******************************************************************************
  * Macros
@@ -71,7 +73,9 @@ public:
     BitmapWidget() :
         Widget(WIDGET_TYPE),
         m_bitmap(),
+        m_cachedBitmap(),
         m_spriteSheet(),
+        m_gifPlayer(),
         m_timer(),
         m_duration(0U)
     {
@@ -85,7 +89,9 @@ public:
     BitmapWidget(const BitmapWidget& widget) :
         Widget(WIDGET_TYPE),
         m_bitmap(widget.m_bitmap),
+        m_cachedBitmap(widget.m_cachedBitmap),
         m_spriteSheet(widget.m_spriteSheet),
+        m_gifPlayer(widget.m_gifPlayer),
         m_timer(widget.m_timer),
         m_duration(widget.m_duration)
     {
@@ -112,15 +118,18 @@ public:
      */
     void set(const YAGfxBitmap& bitmap)
     {
+        m_cachedBitmap.release();
+
         if (true == m_bitmap.create(bitmap.getWidth(), bitmap.getHeight()))
         {
             m_bitmap.copy(bitmap);
         }
 
-        /* Release sprite sheet to avoid wasting memory. The widget can
-         * only show one of them.
+        /* Release sprite sheet and GIF image to avoid wasting memory. The
+         * widget can only show one of them.
          */
         m_spriteSheet.release();
+        m_gifPlayer.close();
         m_timer.stop();
     }
 
@@ -131,7 +140,22 @@ public:
      */
     const YAGfxBitmap& get() const
     {
-        return m_bitmap;
+        const YAGfxBitmap* bitmap = &m_bitmap;
+
+        if (true == m_gifPlayer.isOpen())
+        {
+            bitmap = &m_gifPlayer.getFrame();
+        }
+        else if (false == m_cachedBitmap.isEmpty())
+        {
+            bitmap = &m_cachedBitmap.get();
+        }
+        else
+        {
+            ;
+        }
+
+        return *bitmap;
     }
 
     /**
@@ -145,6 +169,12 @@ public:
      * Load bitmap image from filesystem.
      * If a sprite sheet is active, it will be disabled.
      *
+     * The decoded image is shared via the image cache, therefore loading a
+     * already cached image doesn't access the filesystem.
+     *
+     * A GIF image is played frame by frame directly from the filesystem,
+     * therefore the memory doesn't depend on the number of frames.
+     *
      * @param[in] fs        Filesystem
      * @param[in] filename  Filename with full path
      *
@@ -154,6 +184,8 @@ public:
 
     /**
      * Load sprite sheet file (.sprite) from filesystem.
+     * If the sprite sheet file is not available, the sprite sheet information
+     * stored together with a native texture image is used.
      *
      * @param[in] fs                    Filesystem
      * @param[in] spriteSheetFileName   Name of the sprite sheet file in the filesystem
@@ -197,8 +229,10 @@ public:
 private:
 
     YAGfxDynamicBitmap  m_bitmap;       /**< Bitmap image which is shown if no sprite sheet is loaded. */
+    ImageCache::Handle  m_cachedBitmap; /**< Cached bitmap image which is shown instead of the bitmap image, if available. */
     SpriteSheet         m_spriteSheet;  /**< Sprite sheet for animation with texture. */
-    SimpleTimer         m_timer;        /**< Timer used for sprite sheet. */
+    GifImgPlayer        m_gifPlayer;    /**< Player for animated GIF images. */
+    SimpleTimer         m_timer;        /**< Timer used for sprite sheet and GIF image. */
     uint32_t            m_duration;     /**< Duration of one frame in ms. */
 
     /**
@@ -208,9 +242,13 @@ private:
      */
     void paint(YAGfx& gfx) override
     {
-        if (true == m_spriteSheet.isEmpty())
+        if (true == m_gifPlayer.isOpen())
         {
-            gfx.drawBitmap(m_posX, m_posY, m_bitmap);
+            paintGif(gfx);
+        }
+        else if (true == m_spriteSheet.isEmpty())
+        {
+            gfx.drawBitmap(m_posX, m_posY, get());
         }
         else
         {
@@ -234,6 +272,14 @@ private:
             }
         }
     }
+
+    /**
+     * Paint the current GIF image frame and decode the next one, after the
+     * frame delay elapsed.
+     * 
+     * @param[in] gfx   Graphics interface
+     */
+    void paintGif(YAGfx& gfx);
     
 };
 
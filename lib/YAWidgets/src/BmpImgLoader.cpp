@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "BmpImgLoader.h"
 
+#include <new>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -123,6 +125,8 @@ typedef enum
  * Prototypes
  *****************************************************************************/
 
+static bool isFormatSupported(uint32_t compression, uint16_t bpp);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -159,17 +163,21 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
             ret = RET_FILE_FORMAT_UNSUPPORTED;
         }
         /* Planes must be 1.
-         * Compression is not supported.
-         * Palette colors are not supported.
-         * 24 and 32 bits per pixel are supported.
+         * Without compression 1, 4, 8, 24 and 32 bits per pixel are supported.
+         * RLE8 compression requires 8 bits per pixel.
+         * RLE4 compression requires 4 bits per pixel.
          */
         else if ((1U != dibHeader.infoHeader.planes) ||
-                 (COMPRESSION_METHOD_RGB != dibHeader.infoHeader.compression) ||
-                 (0U < dibHeader.infoHeader.paletteColors) ||
-                 ((24U != dibHeader.infoHeader.bpp) && (32U != dibHeader.infoHeader.bpp)))
+                 (false == isFormatSupported(dibHeader.infoHeader.compression, dibHeader.infoHeader.bpp)))
         {
             ret = RET_FILE_FORMAT_UNSUPPORTED;
         }
+        /* RLE compressed images are always stored bottom-up. */
+        else if ((COMPRESSION_METHOD_RGB != dibHeader.infoHeader.compression) &&
+                 (0 > dibHeader.infoHeader.imageHeight))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
         /* Supported image size is limited. */
         else if ((UINT16_MAX < dibHeader.infoHeader.imageWidth) ||
                  (UINT16_MAX < dibHeader.infoHeader.imageHeight))
@@ -182,69 +190,37 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
             uint16_t height = abs(dibHeader.infoHeader.imageHeight);
 
             bitmap.release();
+            releaseBuffers();
+
+            m_block = new(std::nothrow) uint8_t[BLOCK_SIZE];
 
-            if (false == bitmap.create(width, height))
+            if ((nullptr == m_block) ||
+                (false == bitmap.create(width, height)))
             {
                 ret = RET_IMG_TOO_BIG;
             }
-            else
+            else if ((8U >= dibHeader.infoHeader.bpp) &&
+                     (false == loadPalette(fd, dibHeader)))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else if (false == fd.seek(bmpFileHeader.offset, SeekSet))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else if (COMPRESSION_METHOD_RGB == dibHeader.infoHeader.compression)
             {
-                uint32_t    pos             = 0;
-                uint32_t    rowSize         = 0;
-                int16_t     y               = 0;
-                bool        isTopToBottom   = false;
-                uint16_t    bytePerPixel    = dibHeader.infoHeader.bpp / 8;
-
-                /* The bits representing the bitmap pixels are packed in rows.
-                 * The size of each row is rounded up to a multiple of 4 bytes
-                 * (a 32-bit DWORD) by padding.
-                 */
-                rowSize =  (dibHeader.infoHeader.bpp * bitmap.getWidth() + 31) / 32 * 4;
-
                 /* ImageHeight is expressed as a negative number for top-down images. */
-                if (0 > dibHeader.infoHeader.imageHeight)
-                {
-                    isTopToBottom = true;
-                }
-
-                while((bitmap.getHeight() > y) && (RET_OK == ret))
-                {
-                    int16_t x = 0;
+                bool isTopToBottom = (0 > dibHeader.infoHeader.imageHeight);
 
-                    while((bitmap.getWidth() > x) && (RET_OK == ret))
-                    {
-                        uint8_t lineBuffer[bytePerPixel];
-
-                        if (false == isTopToBottom)
-                        {
-                            pos = x * bytePerPixel + (bitmap.getHeight() - y - 1) * rowSize;
-                        }
-                        else
-                        {
-                            pos = x * bytePerPixel + y * rowSize;
-                        }
-
-                        if (false == fd.seek(bmpFileHeader.offset + pos, SeekSet))
-                        {
-                            ret = RET_FILE_FORMAT_INVALID;
-                        }
-                        else if (sizeof(lineBuffer) != fd.read(lineBuffer, sizeof(lineBuffer)))
-                        {
-                            ret = RET_FILE_FORMAT_INVALID;
-                        }
-                        else
-                        {
-                            Color color(lineBuffer[2], lineBuffer[1], lineBuffer[0]);
-
-                            bitmap.drawPixel(x, y, color);
-                        }
-
-                        ++x;
-                    }
-
-                    ++y;
-                }
+                ret = loadPixels(fd, dibHeader.infoHeader.bpp, isTopToBottom, bitmap);
             }
+            else
+            {
+                ret = loadRlePixels(fd, dibHeader.infoHeader.bpp, bitmap);
+            }
+
+            releaseBuffers();
         }
 
         fd.close();
@@ -326,6 +302,337 @@ bool BmpImgLoader::loadDibHeader(File& fd, BmpV5Header& header)
     return isSuccessful;
 }
 
+bool BmpImgLoader::loadPalette(File& fd, const BmpV5Header& header)
+{
+    bool        isSuccessful    = true;
+    uint32_t    paletteSize     = header.infoHeader.paletteColors;
+    uint32_t    maxPaletteSize  = 1U << header.infoHeader.bpp;
+
+    /* A palette size of 0 means 2^n colors. */
+    if ((0U == paletteSize) ||
+        (maxPaletteSize < paletteSize))
+    {
+        paletteSize = maxPaletteSize;
+    }
+
+    m_palette = new(std::nothrow) Color[paletteSize];
+
+    if (nullptr == m_palette)
+    {
+        isSuccessful = false;
+    }
+    /* The palette follows the bitmap file header and the DIB header. */
+    else if (false == fd.seek(sizeof(BmpFileHeader) + header.infoHeader.headerSize, SeekSet))
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        m_blockLen  = 0U;
+        m_blockPos  = 0U;
+
+        /* Each palette entry is stored as blue, green, red and a reserved byte. */
+        while((paletteSize > m_paletteSize) && (true == isSuccessful))
+        {
+            uint8_t bgr0[4U];
+            uint8_t idx = 0U;
+
+            while((sizeof(bgr0) > idx) && (true == isSuccessful))
+            {
+                isSuccessful = readByte(fd, bgr0[idx]);
+                ++idx;
+            }
+
+            if (true == isSuccessful)
+            {
+                m_palette[m_paletteSize].set(bgr0[2], bgr0[1], bgr0[0]);
+                ++m_paletteSize;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+BmpImgLoader::Ret BmpImgLoader::loadPixels(File& fd, uint16_t bpp, bool isTopToBottom, YAGfxDynamicBitmap& bitmap)
+{
+    Ret         ret             = RET_OK;
+    uint16_t    width           = bitmap.getWidth();
+    uint16_t    height          = bitmap.getHeight();
+    uint16_t    row             = 0U;
+
+    /* The bits representing the bitmap pixels are packed in rows.
+     * The size of each row is rounded up to a multiple of 4 bytes
+     * (a 32-bit DWORD) by padding.
+     */
+    uint32_t    rowSize         = (bpp * width + 31U) / 32U * 4U;
+
+    m_blockLen = 0U;
+    m_blockPos = 0U;
+
+    while((height > row) && (RET_OK == ret))
+    {
+        uint16_t    y           = (true == isTopToBottom) ? row : (height - row - 1U);
+        Color*      pixels      = bitmap.getRow(y);
+        uint32_t    rowBytes    = 0U;
+        uint16_t    x           = 0U;
+        uint8_t     value       = 0U;
+        uint8_t     bitsLeft    = 0U;
+
+        while((width > x) && (RET_OK == ret))
+        {
+            if (8U < bpp)
+            {
+                uint8_t bgra[4U];
+                uint8_t bytePerPixel    = bpp / 8U;
+                uint8_t idx             = 0U;
+
+                while((bytePerPixel > idx) && (RET_OK == ret))
+                {
+                    if (false == readByte(fd, bgra[idx]))
+                    {
+                        ret = RET_FILE_FORMAT_INVALID;
+                    }
+
+                    ++idx;
+                }
+
+                if (RET_OK == ret)
+                {
+                    pixels[x].set(bgra[2], bgra[1], bgra[0]);
+                }
+
+                rowBytes += bytePerPixel;
+            }
+            else
+            {
+                /* The most significant bits contain the left most pixel. */
+                if (0U == bitsLeft)
+                {
+                    if (false == readByte(fd, value))
+                    {
+                        ret = RET_FILE_FORMAT_INVALID;
+                    }
+
+                    ++rowBytes;
+                    bitsLeft = 8U;
+                }
+
+                bitsLeft -= bpp;
+                pixels[x] = getPaletteColor((value >> bitsLeft) & ((1U << bpp) - 1U));
+            }
+
+            ++x;
+        }
+
+        /* Skip the row padding. */
+        while((rowSize > rowBytes) && (RET_OK == ret))
+        {
+            if (false == readByte(fd, value))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+
+            ++rowBytes;
+        }
+
+        ++row;
+    }
+
+    return ret;
+}
+
+BmpImgLoader::Ret BmpImgLoader::loadRlePixels(File& fd, uint16_t bpp, YAGfxDynamicBitmap& bitmap)
+{
+    Ret         ret         = RET_OK;
+    uint16_t    width       = bitmap.getWidth();
+    uint16_t    height      = bitmap.getHeight();
+    uint32_t    x           = 0U;
+    uint32_t    row         = 0U;
+    Color*      pixels      = bitmap.getRow(height - 1U);
+    bool        isFinished  = false;
+
+    m_blockLen = 0U;
+    m_blockPos = 0U;
+
+    /* The pixel data consists of 2 byte packets. If the first byte is not 0,
+     * it contains the number of pixels and the second byte the palette index
+     * (RLE8) or two alternating palette indices (RLE4).
+     * If the first byte is 0, the second byte is an escape code.
+     */
+    while((false == isFinished) && (RET_OK == ret))
+    {
+        uint8_t count   = 0U;
+        uint8_t value   = 0U;
+
+        if ((false == readByte(fd, count)) ||
+            (false == readByte(fd, value)))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+        /* Encoded mode */
+        else if (0U < count)
+        {
+            uint8_t idx = 0U;
+
+            while(count > idx)
+            {
+                uint8_t index = value;
+
+                if (4U == bpp)
+                {
+                    index = (0U == (idx % 2U)) ? (value >> 4U) : (value & 0x0fU);
+                }
+
+                if ((nullptr != pixels) &&
+                    (width > x))
+                {
+                    pixels[x] = getPaletteColor(index);
+                }
+
+                ++x;
+                ++idx;
+            }
+        }
+        /* End of line */
+        else if (0U == value)
+        {
+            x = 0U;
+            ++row;
+        }
+        /* End of bitmap */
+        else if (1U == value)
+        {
+            isFinished = true;
+        }
+        /* Delta: The following 2 bytes contain the horizontal and vertical offset. */
+        else if (2U == value)
+        {
+            uint8_t dx = 0U;
+            uint8_t dy = 0U;
+
+            if ((false == readByte(fd, dx)) ||
+                (false == readByte(fd, dy)))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else
+            {
+                x   += dx;
+                row += dy;
+            }
+        }
+        /* Absolute mode: The following bytes contain the palette indices
+         * of the given number of pixels, padded to a 16-bit boundary.
+         */
+        else
+        {
+            uint8_t     idx         = 0U;
+            uint8_t     data        = 0U;
+            uint16_t    dataBytes   = 0U;
+
+            while((value > idx) && (RET_OK == ret))
+            {
+                uint8_t index = data & 0x0fU;
+
+                if ((8U == bpp) ||
+                    (0U == (idx % 2U)))
+                {
+                    if (false == readByte(fd, data))
+                    {
+                        ret = RET_FILE_FORMAT_INVALID;
+                    }
+
+                    ++dataBytes;
+                    index = (8U == bpp) ? data : (data >> 4U);
+                }
+
+                if ((nullptr != pixels) &&
+                    (width > x))
+                {
+                    pixels[x] = getPaletteColor(index);
+                }
+
+                ++x;
+                ++idx;
+            }
+
+            if ((RET_OK == ret) &&
+                (0U != (dataBytes % 2U)) &&
+                (false == readByte(fd, data)))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+        }
+
+        /* Rows are stored bottom-up. Rows outside the bitmap are ignored. */
+        if (height > row)
+        {
+            pixels = bitmap.getRow(height - row - 1U);
+        }
+        else
+        {
+            pixels = nullptr;
+        }
+    }
+
+    return ret;
+}
+
+bool BmpImgLoader::readByte(File& fd, uint8_t& value)
+{
+    bool isSuccessful = true;
+
+    if (m_blockLen <= m_blockPos)
+    {
+        m_blockLen  = fd.read(m_block, BLOCK_SIZE);
+        m_blockPos  = 0U;
+    }
+
+    if (m_blockLen <= m_blockPos)
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        value = m_block[m_blockPos];
+        ++m_blockPos;
+    }
+
+    return isSuccessful;
+}
+
+Color BmpImgLoader::getPaletteColor(uint8_t index) const
+{
+    Color color;
+
+    if (m_paletteSize > index)
+    {
+        color = m_palette[index];
+    }
+
+    return color;
+}
+
+void BmpImgLoader::releaseBuffers()
+{
+    if (nullptr != m_block)
+    {
+        delete[] m_block;
+        m_block = nullptr;
+    }
+
+    if (nullptr != m_palette)
+    {
+        delete[] m_palette;
+        m_palette = nullptr;
+    }
+
+    m_blockLen      = 0U;
+    m_blockPos      = 0U;
+    m_paletteSize   = 0U;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -333,3 +640,43 @@ bool BmpImgLoader::loadDibHeader(File& fd, BmpV5Header& header)
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Check whether the combination of compression method and bits per pixel
+ * is supported by the loader.
+ *
+ * @param[in] compression   Compression method
+ * @param[in] bpp           Bits per pixel
+ *
+ * @return If supported, it will return true otherwise false.
+ */
+static bool isFormatSupported(uint32_t compression, uint16_t bpp)
+{
+    bool isSupported = false;
+
+    if (COMPRESSION_METHOD_RGB == compression)
+    {
+        if ((1U == bpp) ||
+            (4U == bpp) ||
+            (8U == bpp) ||
+            (24U == bpp) ||
+            (32U == bpp))
+        {
+            isSupported = true;
+        }
+    }
+    else if (COMPRESSION_METHOD_RLE8 == compression)
+    {
+        isSupported = (8U == bpp);
+    }
+    else if (COMPRESSION_METHOD_RLE4 == compression)
+    {
+        isSupported = (4U == bpp);
+    }
+    else
+    {
+        ;
+    }
+
+    return isSupported;
+}
@@ -61,10 +61,13 @@ typedef struct _BmpV5Header BmpV5Header;
 
 /**
  * Bitmap image loader, which supports images that have
- * - 24/32 bit per pixel
- * - No compression
- * - No palette colors
+ * - 1/4/8 bit per pixel with color palette
+ * - 24/32 bit per pixel without color palette
+ * - No compression or RLE4/RLE8 compression
  * - Resolution of max. 65535 x 65535 pixels
+ *
+ * The pixel data is read in blocks and decoded row by row directly into
+ * the bitmap buffer.
  */
 class BmpImgLoader
 {
@@ -73,7 +76,12 @@ public:
     /**
      * Construct a new bitmap loader object.
      */
-    BmpImgLoader()
+    BmpImgLoader() :
+        m_block(nullptr),
+        m_blockLen(0U),
+        m_blockPos(0U),
+        m_palette(nullptr),
+        m_paletteSize(0U)
     {
     }
 
@@ -82,6 +90,7 @@ public:
      */
     ~BmpImgLoader()
     {
+        releaseBuffers();
     }
 
     /**
@@ -109,6 +118,21 @@ public:
 
 private:
 
+    /** Size of a block in bytes, which is read at once from the file system. */
+    static const size_t     BLOCK_SIZE      = 512U;
+
+    /** Max. number of colors in the color palette. */
+    static const uint16_t   PALETTE_MAX     = 256U;
+
+    uint8_t*    m_block;        /**< Block buffer for reading the pixel data */
+    size_t      m_blockLen;     /**< Number of valid bytes in the block buffer */
+    size_t      m_blockPos;     /**< Read position in the block buffer */
+    Color*      m_palette;      /**< Color palette */
+    uint16_t    m_paletteSize;  /**< Number of colors in the color palette */
+
+    BmpImgLoader(const BmpImgLoader& loader);
+    BmpImgLoader& operator=(const BmpImgLoader& loader);
+
     /**
      * Load bitmap file header from file system.
      * 
@@ -128,6 +152,68 @@ private:
      * @return If successful, it will return true otherwise false.
      */
     bool loadDibHeader(File& fd, BmpV5Header& header);
+
+    /**
+     * Load color palette from file system.
+     * The color palette follows immediately the DIB header.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] header        DIB header
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool loadPalette(File& fd, const BmpV5Header& header);
+
+    /**
+     * Load uncompressed pixel data from file system into the bitmap.
+     * The file read position must be at the begin of the pixel data.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] bpp           Bits per pixel (1, 4, 8, 24 or 32)
+     * @param[in] isTopToBottom Is the first row in the file the top row?
+     * @param[out] bitmap       Bitmap buffer
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret loadPixels(File& fd, uint16_t bpp, bool isTopToBottom, YAGfxDynamicBitmap& bitmap);
+
+    /**
+     * Load RLE4 or RLE8 compressed pixel data from file system into the bitmap.
+     * The file read position must be at the begin of the pixel data.
+     * Pixels, which are skipped by delta escapes, are kept black.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] bpp           Bits per pixel (4 for RLE4, 8 for RLE8)
+     * @param[out] bitmap       Bitmap buffer
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret loadRlePixels(File& fd, uint16_t bpp, YAGfxDynamicBitmap& bitmap);
+
+    /**
+     * Read a single byte via block buffer. If the block buffer is empty,
+     * the next block is read from the file system.
+     *
+     * @param[in] fd            File descriptor
+     * @param[out] value        Read byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readByte(File& fd, uint8_t& value);
+
+    /**
+     * Get color from color palette.
+     *
+     * @param[in] index         Color palette index
+     *
+     * @return Color. If the index is out of range, black is returned.
+     */
+    Color getPaletteColor(uint8_t index) const;
+
+    /**
+     * Release block buffer and color palette.
+     */
+    void releaseBuffers();
 };
 
 /******************************************************************************
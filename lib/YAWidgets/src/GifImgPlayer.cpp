@@ -0,0 +1,762 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming GIF image player
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GifImgPlayer.h"
+
+#include <new>
+#include <YAColor.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Block introducer of a extension. */
+static const uint8_t    EXTENSION_INTRODUCER        = 0x21U;
+
+/** Block introducer of a image descriptor. */
+static const uint8_t    IMAGE_SEPARATOR             = 0x2CU;
+
+/** Label of the graphic control extension. */
+static const uint8_t    GRAPHIC_CONTROL_LABEL       = 0xF9U;
+
+/** Size in byte of the graphic control extension data. */
+static const uint8_t    GRAPHIC_CONTROL_SIZE        = 4U;
+
+/** Size in byte of the logical screen descriptor, including the signature. */
+static const size_t     HEADER_SIZE                 = 13U;
+
+/** Size in byte of the image descriptor, without the image separator. */
+static const size_t     IMAGE_DESCRIPTOR_SIZE       = 9U;
+
+/** Flag of a available color table in the logical screen descriptor and the image descriptor. */
+static const uint8_t    FLAG_COLOR_TABLE            = 0x80U;
+
+/** Flag of interlaced rows in the image descriptor. */
+static const uint8_t    FLAG_INTERLACED             = 0x40U;
+
+/** Flag of a valid transparent color index in the graphic control extension. */
+static const uint8_t    FLAG_TRANSPARENT            = 0x01U;
+
+/** Disposal method "restore to background" in the graphic control extension. */
+static const uint8_t    GRAPHIC_CONTROL_DISPOSAL_BG = 2U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GifImgPlayer::GifImgPlayer(const GifImgPlayer& player) :
+    m_fs(nullptr),
+    m_fileName(),
+    m_fd(nullptr),
+    m_decoder(nullptr),
+    m_frame(),
+    m_firstFrameOffset(0U),
+    m_isGlobalPaletteAvailable(false),
+    m_globalPaletteSize(0U),
+    m_delay(DEFAULT_DELAY),
+    m_disposal(DISPOSAL_NONE),
+    m_disposalX(0U),
+    m_disposalY(0U),
+    m_disposalWidth(0U),
+    m_disposalHeight(0U),
+    m_nextDelay(DEFAULT_DELAY),
+    m_nextDisposal(DISPOSAL_NONE),
+    m_transparentIndex(0U),
+    m_isTransparent(false)
+{
+    /* The file position is part of the state, therefore the copy uses its
+     * own file descriptor.
+     */
+    if ((true == player.isOpen()) &&
+        (nullptr != player.m_fs))
+    {
+        (void)open(*player.m_fs, player.m_fileName);
+    }
+}
+
+GifImgPlayer& GifImgPlayer::operator=(const GifImgPlayer& player)
+{
+    if (&player != this)
+    {
+        close();
+
+        if ((true == player.isOpen()) &&
+            (nullptr != player.m_fs))
+        {
+            (void)open(*player.m_fs, player.m_fileName);
+        }
+    }
+
+    return *this;
+}
+
+bool GifImgPlayer::open(FS& fs, const String& fileName)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    m_decoder = new(std::nothrow) Decoder;
+
+    if (nullptr != m_decoder)
+    {
+        m_fd = fs.open(fileName);
+
+        if (true == m_fd)
+        {
+            if (true == readHeader())
+            {
+                isSuccessful = next();
+            }
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        close();
+    }
+    else
+    {
+        m_fs        = &fs;
+        m_fileName  = fileName;
+    }
+
+    return isSuccessful;
+}
+
+void GifImgPlayer::close()
+{
+    if (true == m_fd)
+    {
+        m_fd.close();
+    }
+
+    if (nullptr != m_decoder)
+    {
+        delete m_decoder;
+        m_decoder = nullptr;
+    }
+
+    m_frame.release();
+
+    m_fs                        = nullptr;
+    m_fileName.clear();
+    m_firstFrameOffset          = 0U;
+    m_isGlobalPaletteAvailable  = false;
+    m_globalPaletteSize         = 0U;
+    m_delay                     = DEFAULT_DELAY;
+    m_disposal                  = DISPOSAL_NONE;
+    m_nextDelay                 = DEFAULT_DELAY;
+    m_nextDisposal              = DISPOSAL_NONE;
+    m_isTransparent             = false;
+}
+
+bool GifImgPlayer::next()
+{
+    bool isSuccessful   = false;
+    bool isAborted      = (false == isOpen());
+    bool isRestarted    = false;
+
+    while((false == isSuccessful) && (false == isAborted))
+    {
+        uint8_t introducer = 0U;
+
+        /* The end of the file is handled like the trailer. */
+        if (false == read(&introducer, sizeof(introducer)))
+        {
+            introducer = 0U;
+        }
+
+        if (EXTENSION_INTRODUCER == introducer)
+        {
+            uint8_t label = 0U;
+
+            if (false == read(&label, sizeof(label)))
+            {
+                isAborted = true;
+            }
+            else if (GRAPHIC_CONTROL_LABEL == label)
+            {
+                isAborted = (false == readGraphicControlExtension());
+            }
+            else
+            {
+                /* Other extensions, e.g. comments or the loop count, are not used. */
+                isAborted = (false == skipSubBlocks());
+            }
+        }
+        else if (IMAGE_SEPARATOR == introducer)
+        {
+            isSuccessful    = readFrame();
+            isAborted       = (false == isSuccessful);
+        }
+        /* Trailer reached, start from the first frame again. If there is no
+         * frame at all, it would loop endless.
+         */
+        else if (true == isRestarted)
+        {
+            isAborted = true;
+        }
+        else if (false == m_fd.seek(m_firstFrameOffset))
+        {
+            isAborted = true;
+        }
+        else
+        {
+            m_nextDelay     = DEFAULT_DELAY;
+            m_nextDisposal  = DISPOSAL_NONE;
+            m_isTransparent = false;
+            isRestarted     = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::isGifImg(const uint8_t* data, size_t size)
+{
+    bool isGif = false;
+
+    if ((nullptr != data) &&
+        (SIGNATURE_SIZE <= size))
+    {
+        if ((0 == memcmp(data, "GIF87a", SIGNATURE_SIZE)) ||
+            (0 == memcmp(data, "GIF89a", SIGNATURE_SIZE)))
+        {
+            isGif = true;
+        }
+    }
+
+    return isGif;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool GifImgPlayer::readHeader()
+{
+    bool    isSuccessful = false;
+    uint8_t header[HEADER_SIZE];
+
+    if ((true == read(header, sizeof(header))) &&
+        (true == isGifImg(header, sizeof(header))))
+    {
+        uint16_t    width   = getUInt16(&header[6U]);
+        uint16_t    height  = getUInt16(&header[8U]);
+        uint8_t     flags   = header[10U];
+
+        isSuccessful = true;
+
+        if (0U != (flags & FLAG_COLOR_TABLE))
+        {
+            m_isGlobalPaletteAvailable  = true;
+            m_globalPaletteSize         = 2U << (flags & 0x07U);
+
+            isSuccessful = read(m_decoder->globalPalette, 3U * m_globalPaletteSize);
+        }
+
+        if (true == isSuccessful)
+        {
+            if ((0U == width) ||
+                (0U == height) ||
+                (false == m_frame.create(width, height)))
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                m_frame.fillScreen(ColorDef::BLACK);
+                m_firstFrameOffset = m_fd.position();
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::readGraphicControlExtension()
+{
+    bool    isSuccessful = false;
+    uint8_t blockSize    = 0U;
+
+    if (true == read(&blockSize, sizeof(blockSize)))
+    {
+        if (GRAPHIC_CONTROL_SIZE != blockSize)
+        {
+            /* Unknown layout, skip it. */
+            isSuccessful = m_fd.seek(blockSize, SeekCur);
+        }
+        else
+        {
+            uint8_t data[GRAPHIC_CONTROL_SIZE];
+
+            if (true == read(data, sizeof(data)))
+            {
+                uint8_t     flags   = data[0U];
+                uint32_t    delay   = 10U * getUInt16(&data[1U]); /* Delay in 1/100 s */
+
+                if (MIN_DELAY > delay)
+                {
+                    delay = DEFAULT_DELAY;
+                }
+
+                m_nextDelay         = delay;
+                m_nextDisposal      = (GRAPHIC_CONTROL_DISPOSAL_BG == ((flags >> 2U) & 0x07U)) ? DISPOSAL_BACKGROUND : DISPOSAL_NONE;
+                m_isTransparent     = (0U != (flags & FLAG_TRANSPARENT));
+                m_transparentIndex  = data[3U];
+
+                isSuccessful = true;
+            }
+        }
+
+        if (true == isSuccessful)
+        {
+            isSuccessful = skipSubBlocks();
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::readFrame()
+{
+    bool            isSuccessful = false;
+    uint8_t         data[IMAGE_DESCRIPTOR_SIZE];
+    ImageDescriptor descriptor;
+
+    if (true == read(data, sizeof(data)))
+    {
+        uint8_t flags = data[8U];
+
+        descriptor.x            = getUInt16(&data[0U]);
+        descriptor.y            = getUInt16(&data[2U]);
+        descriptor.width        = getUInt16(&data[4U]);
+        descriptor.height       = getUInt16(&data[6U]);
+        descriptor.isInterlaced = (0U != (flags & FLAG_INTERLACED));
+        descriptor.palette      = nullptr;
+        descriptor.paletteSize  = 0U;
+
+        if (0U != (flags & FLAG_COLOR_TABLE))
+        {
+            descriptor.paletteSize = 2U << (flags & 0x07U);
+
+            if (true == read(m_decoder->localPalette, 3U * descriptor.paletteSize))
+            {
+                descriptor.palette = m_decoder->localPalette;
+            }
+        }
+        else if (true == m_isGlobalPaletteAvailable)
+        {
+            descriptor.palette      = m_decoder->globalPalette;
+            descriptor.paletteSize  = m_globalPaletteSize;
+        }
+        else
+        {
+            ;
+        }
+
+        /* A frame without any color table is not supported. */
+        if (nullptr != descriptor.palette)
+        {
+            dispose();
+
+            isSuccessful = decodeImageData(descriptor);
+
+            m_delay             = m_nextDelay;
+            m_disposal          = m_nextDisposal;
+            m_disposalX         = descriptor.x;
+            m_disposalY         = descriptor.y;
+            m_disposalWidth     = descriptor.width;
+            m_disposalHeight    = descriptor.height;
+        }
+    }
+
+    /* The graphic control extension is only valid for one frame. */
+    m_nextDelay     = DEFAULT_DELAY;
+    m_nextDisposal  = DISPOSAL_NONE;
+    m_isTransparent = false;
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::decodeImageData(const ImageDescriptor& descriptor)
+{
+    bool        isSuccessful    = true;
+    bool        isEnd           = false;
+    uint8_t     minCodeSize     = 0U;
+    uint16_t    clearCode       = 0U;
+    uint16_t    endCode         = 0U;
+    uint8_t     codeSize        = 0U;
+    uint16_t    nextCode        = 0U;
+    uint16_t    prevCode        = LZW_NO_CODE;
+    uint32_t    pixelIdx        = 0U;
+    uint16_t    code            = 0U;
+
+    m_decoder->blockSize    = 0U;
+    m_decoder->blockIndex   = 0U;
+    m_decoder->isDataEnd    = false;
+    m_decoder->bitBuffer    = 0U;
+    m_decoder->bitCnt       = 0U;
+
+    if ((false == read(&minCodeSize, sizeof(minCodeSize))) ||
+        (2U > minCodeSize) ||
+        (8U < minCodeSize))
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        clearCode   = 1U << minCodeSize;
+        endCode     = clearCode + 1U;
+        codeSize    = minCodeSize + 1U;
+        nextCode    = clearCode + 2U;
+
+        /* The root codes are the color indices itself. */
+        for(code = 0U; code < clearCode; ++code)
+        {
+            m_decoder->prefix[code] = LZW_NO_CODE;
+            m_decoder->suffix[code] = static_cast<uint8_t>(code);
+        }
+    }
+
+    while((true == isSuccessful) && (false == isEnd))
+    {
+        /* Some encoders end the image data without end of information code. */
+        if (false == readCode(codeSize, code))
+        {
+            isEnd = true;
+        }
+        else if (clearCode == code)
+        {
+            codeSize    = minCodeSize + 1U;
+            nextCode    = clearCode + 2U;
+            prevCode    = LZW_NO_CODE;
+        }
+        else if (endCode == code)
+        {
+            isEnd = true;
+        }
+        else if (LZW_NO_CODE == prevCode)
+        {
+            /* The first code after a clear code must be a root code. */
+            if (clearCode < code)
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                writePixel(descriptor, pixelIdx, static_cast<uint8_t>(code));
+                ++pixelIdx;
+                prevCode = code;
+            }
+        }
+        else
+        {
+            uint8_t     firstIndex  = 0U;
+            uint16_t    length      = 0U;
+
+            if (nextCode > code)
+            {
+                length = getCodeLength(code, firstIndex);
+                writeCode(descriptor, pixelIdx, code, length);
+            }
+            /* The code is not in the dictionary yet, it is the previous one
+             * extended by its own first color index.
+             */
+            else if (nextCode == code)
+            {
+                length = getCodeLength(prevCode, firstIndex);
+                writeCode(descriptor, pixelIdx, prevCode, length);
+                writePixel(descriptor, pixelIdx + length, firstIndex);
+                ++length;
+            }
+            else
+            {
+                isSuccessful = false;
+            }
+
+            if (true == isSuccessful)
+            {
+                pixelIdx += length;
+
+                /* If the dictionary is full, it is kept until the next clear code. */
+                if (LZW_CODES_MAX > nextCode)
+                {
+                    m_decoder->prefix[nextCode] = prevCode;
+                    m_decoder->suffix[nextCode] = firstIndex;
+                    ++nextCode;
+
+                    if (((1U << codeSize) == nextCode) &&
+                        (LZW_CODE_SIZE_MAX > codeSize))
+                    {
+                        ++codeSize;
+                    }
+                }
+
+                prevCode = code;
+            }
+        }
+    }
+
+    if ((true == isSuccessful) &&
+        (false == m_decoder->isDataEnd))
+    {
+        isSuccessful = skipSubBlocks();
+    }
+
+    return isSuccessful;
+}
+
+uint16_t GifImgPlayer::getCodeLength(uint16_t code, uint8_t& firstIndex) const
+{
+    uint16_t length = 0U;
+
+    /* The length is limited, which protects against corrupt chains. */
+    while((LZW_NO_CODE != code) && (LZW_CODES_MAX > length))
+    {
+        firstIndex  = m_decoder->suffix[code];
+        code        = m_decoder->prefix[code];
+        ++length;
+    }
+
+    return length;
+}
+
+void GifImgPlayer::writeCode(const ImageDescriptor& descriptor, uint32_t pixelIdx, uint16_t code, uint16_t length)
+{
+    uint16_t idx = length;
+
+    while((0U < idx) && (LZW_NO_CODE != code))
+    {
+        --idx;
+        writePixel(descriptor, pixelIdx + idx, m_decoder->suffix[code]);
+        code = m_decoder->prefix[code];
+    }
+}
+
+void GifImgPlayer::writePixel(const ImageDescriptor& descriptor, uint32_t pixelIdx, uint8_t colorIndex)
+{
+    const uint32_t PIXEL_CNT = static_cast<uint32_t>(descriptor.width) * descriptor.height;
+
+    if ((PIXEL_CNT > pixelIdx) &&
+        (descriptor.paletteSize > colorIndex) &&
+        ((false == m_isTransparent) || (m_transparentIndex != colorIndex)))
+    {
+        uint32_t column = pixelIdx % descriptor.width;
+        uint32_t row    = pixelIdx / descriptor.width;
+        uint32_t x      = 0U;
+        uint32_t y      = 0U;
+
+        /* Interlaced rows are stored in 4 passes: Every 8th row starting
+         * with row 0, every 8th row starting with row 4, every 4th row
+         * starting with row 2 and every 2nd row starting with row 1.
+         */
+        if (true == descriptor.isInterlaced)
+        {
+            const uint32_t PASS_1_ROWS = (descriptor.height + 7U) / 8U;
+            const uint32_t PASS_2_ROWS = (descriptor.height + 3U) / 8U;
+            const uint32_t PASS_3_ROWS = (descriptor.height + 1U) / 4U;
+
+            if (PASS_1_ROWS > row)
+            {
+                row = row * 8U;
+            }
+            else if ((PASS_1_ROWS + PASS_2_ROWS) > row)
+            {
+                row = 4U + (row - PASS_1_ROWS) * 8U;
+            }
+            else if ((PASS_1_ROWS + PASS_2_ROWS + PASS_3_ROWS) > row)
+            {
+                row = 2U + (row - PASS_1_ROWS - PASS_2_ROWS) * 4U;
+            }
+            else
+            {
+                row = 1U + (row - PASS_1_ROWS - PASS_2_ROWS - PASS_3_ROWS) * 2U;
+            }
+        }
+
+        x = descriptor.x + column;
+        y = descriptor.y + row;
+
+        /* The frame may exceed the logical screen. */
+        if ((m_frame.getWidth() > x) &&
+            (m_frame.getHeight() > y))
+        {
+            const uint8_t* rgb = &descriptor.palette[3U * colorIndex];
+
+            m_frame.drawPixel(x, y, Color(rgb[0U], rgb[1U], rgb[2U]));
+        }
+    }
+}
+
+bool GifImgPlayer::readCode(uint8_t codeSize, uint16_t& code)
+{
+    bool isSuccessful = true;
+
+    while((codeSize > m_decoder->bitCnt) && (true == isSuccessful))
+    {
+        uint8_t data = 0U;
+
+        if (false == readDataByte(data))
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            m_decoder->bitBuffer |= static_cast<uint32_t>(data) << m_decoder->bitCnt;
+            m_decoder->bitCnt += 8U;
+        }
+    }
+
+    if (true == isSuccessful)
+    {
+        code = static_cast<uint16_t>(m_decoder->bitBuffer & ((1U << codeSize) - 1U));
+
+        m_decoder->bitBuffer >>= codeSize;
+        m_decoder->bitCnt -= codeSize;
+    }
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::readDataByte(uint8_t& data)
+{
+    bool isSuccessful = false;
+
+    if (false == m_decoder->isDataEnd)
+    {
+        if (m_decoder->blockSize <= m_decoder->blockIndex)
+        {
+            uint8_t blockSize = 0U;
+
+            m_decoder->blockSize    = 0U;
+            m_decoder->blockIndex   = 0U;
+
+            /* A block size of 0 is the block terminator. */
+            if ((false == read(&blockSize, sizeof(blockSize))) ||
+                (0U == blockSize))
+            {
+                m_decoder->isDataEnd = true;
+            }
+            else if (true == read(m_decoder->block, blockSize))
+            {
+                m_decoder->blockSize = blockSize;
+            }
+            else
+            {
+                m_decoder->isDataEnd = true;
+            }
+        }
+
+        if (m_decoder->blockSize > m_decoder->blockIndex)
+        {
+            data = m_decoder->block[m_decoder->blockIndex];
+            ++m_decoder->blockIndex;
+
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::skipSubBlocks()
+{
+    bool isSuccessful   = true;
+    bool isTerminated   = false;
+
+    while((true == isSuccessful) && (false == isTerminated))
+    {
+        uint8_t blockSize = 0U;
+
+        if (false == read(&blockSize, sizeof(blockSize)))
+        {
+            isSuccessful = false;
+        }
+        else if (0U == blockSize)
+        {
+            isTerminated = true;
+        }
+        else
+        {
+            isSuccessful = m_fd.seek(blockSize, SeekCur);
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool GifImgPlayer::read(uint8_t* data, size_t size)
+{
+    return (size == m_fd.read(data, size));
+}
+
+void GifImgPlayer::dispose()
+{
+    if (DISPOSAL_BACKGROUND == m_disposal)
+    {
+        m_frame.fillRect(m_disposalX, m_disposalY, m_disposalWidth, m_disposalHeight, ColorDef::BLACK);
+    }
+
+    m_disposal = DISPOSAL_NONE;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,397 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming GIF image player
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef GIF_IMG_PLAYER_H
+#define GIF_IMG_PLAYER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Plays a (animated) GIF image frame by frame directly from the filesystem.
+ *
+ * The file stays open while playing. Only the current frame (with the size
+ * of the logical screen), the color tables and the LZW dictionary are kept
+ * in memory, independent of the number of frames. After the last frame, the
+ * player seeks back to the first frame and the animation starts again.
+ *
+ * Transparency and the disposal methods "do not dispose" and "restore to
+ * background" are supported. Restoring to background clears to black,
+ * because the display has no transparency. The disposal method "restore to
+ * previous" is handled like "do not dispose", because it would require a
+ * second frame buffer.
+ */
+class GifImgPlayer
+{
+public:
+
+    /**
+     * Constructs a GIF image player.
+     */
+    GifImgPlayer() :
+        m_fs(nullptr),
+        m_fileName(),
+        m_fd(nullptr),
+        m_decoder(nullptr),
+        m_frame(),
+        m_firstFrameOffset(0U),
+        m_isGlobalPaletteAvailable(false),
+        m_globalPaletteSize(0U),
+        m_delay(DEFAULT_DELAY),
+        m_disposal(DISPOSAL_NONE),
+        m_disposalX(0U),
+        m_disposalY(0U),
+        m_disposalWidth(0U),
+        m_disposalHeight(0U),
+        m_nextDelay(DEFAULT_DELAY),
+        m_nextDisposal(DISPOSAL_NONE),
+        m_transparentIndex(0U),
+        m_isTransparent(false)
+    {
+    }
+
+    /**
+     * Constructs a GIF image player by copying another one.
+     * The copy opens the same file and starts with the first frame.
+     *
+     * @param[in] player    GIF image player, which to copy
+     */
+    GifImgPlayer(const GifImgPlayer& player);
+
+    /**
+     * Destroys the GIF image player.
+     */
+    ~GifImgPlayer()
+    {
+        close();
+    }
+
+    /**
+     * Assigns a GIF image player.
+     * The player opens the same file and starts with the first frame.
+     *
+     * @param[in] player    GIF image player, which to assign
+     *
+     * @return GIF image player
+     */
+    GifImgPlayer& operator=(const GifImgPlayer& player);
+
+    /**
+     * Open a GIF image and decode the first frame.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] fileName  Name of the GIF image file in the filesystem
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool open(FS& fs, const String& fileName);
+
+    /**
+     * Close the GIF image and release all memory.
+     */
+    void close();
+
+    /**
+     * Is a GIF image opened?
+     *
+     * @return If opened, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return (nullptr != m_decoder);
+    }
+
+    /**
+     * Decode the next frame. After the last frame, the first frame follows.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool next();
+
+    /**
+     * Get the current frame.
+     *
+     * @return Current frame
+     */
+    const YAGfxBitmap& getFrame() const
+    {
+        return m_frame;
+    }
+
+    /**
+     * Get the delay of the current frame in ms, until the next frame shall
+     * be shown.
+     *
+     * @return Delay in ms
+     */
+    uint32_t getDelay() const
+    {
+        return m_delay;
+    }
+
+    /**
+     * Is the data the begin of a GIF image?
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If it is a GIF image, it will return true otherwise false.
+     */
+    static bool isGifImg(const uint8_t* data, size_t size);
+
+    /** Size in byte of the signature at the begin of the file. */
+    static const size_t     SIGNATURE_SIZE  = 6U;
+
+    /** Delay in ms, used if the frame has no or a too short delay. */
+    static const uint32_t   DEFAULT_DELAY   = 100U;
+
+    /** Min. frame delay in ms. Shorter delays are replaced by the default delay, like browsers do. */
+    static const uint32_t   MIN_DELAY       = 20U;
+
+private:
+
+    /**
+     * Frame disposal methods.
+     */
+    enum Disposal
+    {
+        DISPOSAL_NONE = 0,  /**< Leave the frame in place. */
+        DISPOSAL_BACKGROUND /**< Restore the frame area to background. */
+    };
+
+    /** Max. number of LZW codes. */
+    static const uint16_t   LZW_CODES_MAX       = 4096U;
+
+    /** Marks the end of a prefix chain in the LZW dictionary. */
+    static const uint16_t   LZW_NO_CODE         = LZW_CODES_MAX;
+
+    /** Max. LZW code size in bit. */
+    static const uint8_t    LZW_CODE_SIZE_MAX   = 12U;
+
+    /** Max. number of colors in a color table. */
+    static const uint16_t   PALETTE_MAX         = 256U;
+
+    /** Max. size of a data sub-block in byte. */
+    static const uint8_t    SUB_BLOCK_SIZE_MAX  = 255U;
+
+    /**
+     * Decoder state, which is only allocated while a GIF image is opened.
+     */
+    struct Decoder
+    {
+        uint16_t    prefix[LZW_CODES_MAX];              /**< LZW dictionary: Prefix code of every code */
+        uint8_t     suffix[LZW_CODES_MAX];              /**< LZW dictionary: Last color index of every code */
+        uint8_t     globalPalette[3U * PALETTE_MAX];    /**< Global color table (RGB) */
+        uint8_t     localPalette[3U * PALETTE_MAX];     /**< Local color table (RGB) */
+        uint8_t     block[SUB_BLOCK_SIZE_MAX];          /**< Current data sub-block */
+        uint8_t     blockSize;                          /**< Size of the current data sub-block in byte */
+        uint8_t     blockIndex;                         /**< Index of the next byte in the current data sub-block */
+        bool        isDataEnd;                          /**< Is the block terminator of the image data read? */
+        uint32_t    bitBuffer;                          /**< Bits, which are read but not decoded yet */
+        uint8_t     bitCnt;                             /**< Number of bits in the bit buffer */
+    };
+
+    /**
+     * Image descriptor of the frame, which is decoded.
+     */
+    struct ImageDescriptor
+    {
+        uint16_t        x;              /**< Left position on the logical screen */
+        uint16_t        y;              /**< Top position on the logical screen */
+        uint16_t        width;          /**< Frame width in pixels */
+        uint16_t        height;         /**< Frame height in pixels */
+        bool            isInterlaced;   /**< Are the rows interlaced? */
+        const uint8_t*  palette;        /**< Color table of the frame (RGB) */
+        uint16_t        paletteSize;    /**< Number of colors in the color table */
+    };
+
+    FS*                 m_fs;                       /**< Filesystem of the opened file */
+    String              m_fileName;                 /**< Name of the opened file */
+    File                m_fd;                       /**< File descriptor of the opened file */
+    Decoder*            m_decoder;                  /**< Decoder state */
+    YAGfxDynamicBitmap  m_frame;                    /**< Current frame with the size of the logical screen */
+    uint32_t            m_firstFrameOffset;         /**< File offset of the first block after the header */
+    bool                m_isGlobalPaletteAvailable; /**< Is a global color table available? */
+    uint16_t            m_globalPaletteSize;        /**< Number of colors in the global color table */
+    uint32_t            m_delay;                    /**< Delay of the current frame in ms */
+    Disposal            m_disposal;                 /**< Disposal method of the current frame */
+    uint16_t            m_disposalX;                /**< Left position of the area, which to dispose. */
+    uint16_t            m_disposalY;                /**< Top position of the area, which to dispose. */
+    uint16_t            m_disposalWidth;            /**< Width of the area, which to dispose. */
+    uint16_t            m_disposalHeight;           /**< Height of the area, which to dispose. */
+    uint32_t            m_nextDelay;                /**< Delay of the next frame in ms, given by the graphic control extension. */
+    Disposal            m_nextDisposal;             /**< Disposal method of the next frame, given by the graphic control extension. */
+    uint8_t             m_transparentIndex;         /**< Transparent color index of the next frame */
+    bool                m_isTransparent;            /**< Is the transparent color index of the next frame valid? */
+
+    /**
+     * Read the logical screen descriptor and the global color table.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readHeader();
+
+    /**
+     * Read a graphic control extension.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readGraphicControlExtension();
+
+    /**
+     * Read the image descriptor and decode the frame.
+     * The area of the previous frame is disposed before.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readFrame();
+
+    /**
+     * Decode the LZW compressed image data of the frame.
+     *
+     * @param[in] descriptor    Image descriptor of the frame
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool decodeImageData(const ImageDescriptor& descriptor);
+
+    /**
+     * Get the number of color indices of a LZW code by following its
+     * prefix chain.
+     *
+     * @param[in]   code        LZW code
+     * @param[out]  firstIndex  First color index of the code
+     *
+     * @return Number of color indices
+     */
+    uint16_t getCodeLength(uint16_t code, uint8_t& firstIndex) const;
+
+    /**
+     * Write the color indices of a LZW code to the frame. The string of a
+     * code is written backwards, by following the prefix chain.
+     *
+     * @param[in] descriptor    Image descriptor of the frame
+     * @param[in] pixelIdx      Index of the first pixel in the frame
+     * @param[in] code          LZW code
+     * @param[in] length        Number of color indices of the code
+     */
+    void writeCode(const ImageDescriptor& descriptor, uint32_t pixelIdx, uint16_t code, uint16_t length);
+
+    /**
+     * Write a single color index to the frame.
+     *
+     * @param[in] descriptor    Image descriptor of the frame
+     * @param[in] pixelIdx      Index of the pixel in the frame
+     * @param[in] colorIndex    Color index
+     */
+    void writePixel(const ImageDescriptor& descriptor, uint32_t pixelIdx, uint8_t colorIndex);
+
+    /**
+     * Read a LZW code from the image data.
+     *
+     * @param[in]   codeSize    Code size in bit
+     * @param[out]  code        LZW code
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readCode(uint8_t codeSize, uint16_t& code);
+
+    /**
+     * Read the next byte from the image data sub-blocks.
+     *
+     * @param[out] data Data byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readDataByte(uint8_t& data);
+
+    /**
+     * Skip data sub-blocks until the block terminator.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool skipSubBlocks();
+
+    /**
+     * Read data from the file.
+     *
+     * @param[out]  data    Data buffer
+     * @param[in]   size    Number of bytes to read
+     *
+     * @return If all bytes are read, it will return true otherwise false.
+     */
+    bool read(uint8_t* data, size_t size);
+
+    /**
+     * Get a little endian 16-bit value.
+     *
+     * @param[in] data  Data
+     *
+     * @return Value
+     */
+    static uint16_t getUInt16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0U]) | (static_cast<uint16_t>(data[1U]) << 8U);
+    }
+
+    /**
+     * Dispose the area of the current frame, before the next frame is decoded.
+     */
+    void dispose();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* GIF_IMG_PLAYER_H */
+
+/** @} */
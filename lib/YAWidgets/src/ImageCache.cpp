@@ -0,0 +1,460 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Decoded image cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ImageCache.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Protect the cache against concurrent access for the rest of the scope. */
+#define IMAGE_CACHE_LOCK()  MutexGuard<MutexRecursive> guard(m_mutex)
+
+#else   /* NATIVE */
+
+/** The native test environment runs single threaded. */
+#define IMAGE_CACHE_LOCK()
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Returned by a empty handle. */
+static const YAGfxDynamicBitmap gEmptyBitmap;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ImageCache::Handle::Handle(const Handle& handle) :
+    m_entry(handle.m_entry)
+{
+    if (nullptr != m_entry)
+    {
+        ImageCache::getInstance().acquire(m_entry);
+    }
+}
+
+ImageCache::Handle& ImageCache::Handle::operator=(const Handle& handle)
+{
+    if (&handle != this)
+    {
+        /* Acquire first, because both may reference the same entry. */
+        if (nullptr != handle.m_entry)
+        {
+            ImageCache::getInstance().acquire(handle.m_entry);
+        }
+
+        release();
+        m_entry = handle.m_entry;
+    }
+
+    return *this;
+}
+
+void ImageCache::Handle::release()
+{
+    if (nullptr != m_entry)
+    {
+        ImageCache::getInstance().release(m_entry);
+        m_entry = nullptr;
+    }
+}
+
+const YAGfxDynamicBitmap& ImageCache::Handle::get() const
+{
+    const YAGfxDynamicBitmap* bitmap = &gEmptyBitmap;
+
+    if (nullptr != m_entry)
+    {
+        bitmap = &m_entry->bitmap;
+    }
+
+    return *bitmap;
+}
+
+bool ImageCache::Handle::getSpriteInfo(NativeImg::SpriteInfo& spriteInfo) const
+{
+    bool isAvailable = false;
+
+    if ((nullptr != m_entry) &&
+        (0U < m_entry->spriteInfo.frameWidth) &&
+        (0U < m_entry->spriteInfo.frameHeight))
+    {
+        spriteInfo  = m_entry->spriteInfo;
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+BmpImgLoader::Ret ImageCache::load(FS& fs, const String& fileName, Handle& handle)
+{
+    IMAGE_CACHE_LOCK();
+    BmpImgLoader::Ret   ret = BmpImgLoader::RET_OK;
+    uint32_t            now = millis();
+    EntryList::iterator it  = find(fileName);
+
+    if ((m_entries.end() != it) &&
+        (false == isValid(fs, **it, now)))
+    {
+        LOG_DEBUG("Image %s changed.", fileName.c_str());
+        (void)remove(it);
+        it = m_entries.end();
+    }
+
+    if (m_entries.end() != it)
+    {
+        Entry* entry = *it;
+
+        entry->lastUsed = now;
+        acquire(entry);
+        handle = Handle(entry);
+    }
+    else
+    {
+        String  filePath        = fileName;
+        String  nativeFileName  = NativeImg::getFileName(fileName);
+
+        /* Prefer the native image, which belongs to the requested image. */
+        if ((nativeFileName != fileName) &&
+            (true == fs.exists(nativeFileName)))
+        {
+            filePath = nativeFileName;
+        }
+
+        File fd = fs.open(filePath);
+
+        if (false == fd)
+        {
+            ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+        }
+        else
+        {
+            Entry* entry = new(std::nothrow) Entry();
+
+            if (nullptr == entry)
+            {
+                fd.close();
+                ret = BmpImgLoader::RET_IMG_TOO_BIG;
+            }
+            else
+            {
+                uint8_t signature[NativeImg::SIGNATURE_SIZE];
+                size_t  signatureSize   = fd.read(signature, sizeof(signature));
+
+                entry->fileName         = fileName;
+                entry->filePath         = filePath;
+                entry->lastWrite        = fd.getLastWrite();
+                entry->fileSize         = fd.size();
+                entry->refCnt           = 0U;
+                entry->lastUsed         = now;
+                entry->lastValidation   = now;
+                entry->isOrphan         = false;
+
+                entry->spriteInfo.frameWidth    = 0U;
+                entry->spriteInfo.frameHeight   = 0U;
+                entry->spriteInfo.frameCnt      = 0U;
+                entry->spriteInfo.fps           = 0U;
+                entry->spriteInfo.isRepeated    = true;
+
+                fd.close();
+
+                /* Detect the file format by its content, not by its filename. */
+                if (true == NativeImg::isNativeImg(signature, signatureSize))
+                {
+                    NativeImg nativeImg;
+
+                    ret = nativeImg.load(fs, filePath, entry->bitmap, &entry->spriteInfo);
+                }
+                else
+                {
+                    BmpImgLoader loader;
+
+                    ret = loader.load(fs, filePath, entry->bitmap);
+                }
+
+                if (BmpImgLoader::RET_OK != ret)
+                {
+                    delete entry;
+                    entry = nullptr;
+                }
+                else
+                {
+                    m_memoryUsed += getBitmapSize(entry->bitmap);
+                    m_entries.push_back(entry);
+
+                    acquire(entry);
+                    handle = Handle(entry);
+
+                    /* The new image is referenced and will not be evicted. */
+                    evict();
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+void ImageCache::invalidate(const String& fileName)
+{
+    IMAGE_CACHE_LOCK();
+    EntryList::iterator it = m_entries.begin();
+
+    /* The file may be the native image, which was loaded instead of the
+     * requested image.
+     */
+    while(m_entries.end() != it)
+    {
+        if ((fileName == (*it)->fileName) ||
+            (fileName == (*it)->filePath))
+        {
+            it = remove(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ImageCache::clear()
+{
+    IMAGE_CACHE_LOCK();
+    EntryList::iterator it = m_entries.begin();
+
+    while(m_entries.end() != it)
+    {
+        if (0U == (*it)->refCnt)
+        {
+            it = remove(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+size_t ImageCache::getMemoryUsed() const
+{
+    IMAGE_CACHE_LOCK();
+
+    return m_memoryUsed;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ImageCache::ImageCache() :
+#ifndef NATIVE
+    m_mutex(),
+#endif  /* NATIVE */
+    m_entries(),
+    m_memoryUsed(0U)
+{
+#ifndef NATIVE
+    (void)m_mutex.create();
+#endif  /* NATIVE */
+}
+
+ImageCache::~ImageCache()
+{
+    /* Never called. */
+}
+
+void ImageCache::acquire(Entry* entry)
+{
+    IMAGE_CACHE_LOCK();
+
+    ++entry->refCnt;
+}
+
+void ImageCache::release(Entry* entry)
+{
+    IMAGE_CACHE_LOCK();
+
+    if (0U < entry->refCnt)
+    {
+        --entry->refCnt;
+    }
+
+    if (0U == entry->refCnt)
+    {
+        if (true == entry->isOrphan)
+        {
+            m_memoryUsed -= getBitmapSize(entry->bitmap);
+            delete entry;
+        }
+        else
+        {
+            /* Unreferenced images may be evicted now. */
+            evict();
+        }
+    }
+}
+
+ImageCache::EntryList::iterator ImageCache::find(const String& fileName)
+{
+    EntryList::iterator it      = m_entries.begin();
+    bool                isFound = false;
+
+    while((m_entries.end() != it) && (false == isFound))
+    {
+        if (fileName == (*it)->fileName)
+        {
+            isFound = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return it;
+}
+
+bool ImageCache::isValid(FS& fs, Entry& entry, uint32_t now)
+{
+    bool isValid = true;
+
+    if (VALIDATION_PERIOD <= (now - entry.lastValidation))
+    {
+        File fd = fs.open(entry.filePath);
+
+        if (false == fd)
+        {
+            isValid = false;
+        }
+        else
+        {
+            if ((entry.lastWrite != fd.getLastWrite()) ||
+                (entry.fileSize != fd.size()))
+            {
+                isValid = false;
+            }
+
+            fd.close();
+        }
+
+        entry.lastValidation = now;
+    }
+
+    return isValid;
+}
+
+ImageCache::EntryList::iterator ImageCache::remove(EntryList::iterator it)
+{
+    Entry* entry = *it;
+
+    if (0U == entry->refCnt)
+    {
+        m_memoryUsed -= getBitmapSize(entry->bitmap);
+        delete entry;
+    }
+    else
+    {
+        /* Destroyed by the last release. The memory is still used until then. */
+        entry->isOrphan = true;
+    }
+
+    return m_entries.erase(it);
+}
+
+void ImageCache::evict()
+{
+    bool isEvictable = true;
+
+    while((MEMORY_LIMIT < m_memoryUsed) && (true == isEvictable))
+    {
+        EntryList::iterator it      = m_entries.begin();
+        EntryList::iterator lruIt   = m_entries.end();
+
+        while(m_entries.end() != it)
+        {
+            if ((0U == (*it)->refCnt) &&
+                ((m_entries.end() == lruIt) ||
+                 (static_cast<int32_t>((*it)->lastUsed - (*lruIt)->lastUsed) < 0)))
+            {
+                lruIt = it;
+            }
+
+            ++it;
+        }
+
+        if (m_entries.end() == lruIt)
+        {
+            /* All remaining images are in use. */
+            isEvictable = false;
+        }
+        else
+        {
+            LOG_DEBUG("Image %s evicted.", (*lruIt)->fileName.c_str());
+            (void)remove(lruIt);
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,359 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Decoded image cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef CONFIG_IMAGE_CACHE_MEMORY_LIMIT
+
+/**
+ * Max. memory in byte, which is used by the decoded images. On targets with
+ * PSRAM, big pixel buffers are allocated there, therefore the limit can be
+ * increased accordingly.
+ */
+#define CONFIG_IMAGE_CACHE_MEMORY_LIMIT (32768U)
+
+#endif  /* CONFIG_IMAGE_CACHE_MEMORY_LIMIT */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+#include <FS.h>
+#include <YAGfxBitmap.h>
+
+#include "BmpImgLoader.h"
+#include "NativeImg.h"
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The image cache holds decoded images, keyed by their full path in the
+ * filesystem. Widgets which show the same image share one pixel buffer and
+ * switching between already decoded images doesn't access the filesystem.
+ *
+ * A cached image is immutable. It is referenced by a handle and only images
+ * which are not referenced anymore, are evicted (least recently used first),
+ * if the memory limit is exceeded.
+ *
+ * Bitmap images (.bmp) and native images are supported. The file format is
+ * detected by the file content, not by the filename. If a native image
+ * (.pxim) with the same name exists next to the requested image, it is
+ * loaded instead, because it is decoded faster.
+ *
+ * A cached image is revalidated against the file modification time and size
+ * at most once per validation period. Whoever writes an image file, shall
+ * call invalidate() to get it reloaded immediately.
+ */
+class ImageCache
+{
+private:
+
+    /* Forward declaration */
+    struct Entry;
+
+public:
+
+    /**
+     * Handle of a cached image. Copying the handle shares the image.
+     */
+    class Handle
+    {
+    public:
+
+        /**
+         * Constructs a empty handle.
+         */
+        Handle() :
+            m_entry(nullptr)
+        {
+        }
+
+        /**
+         * Constructs a handle by copying another one.
+         *
+         * @param[in] handle    Handle, which to copy
+         */
+        Handle(const Handle& handle);
+
+        /**
+         * Destroys the handle and releases the referenced image.
+         */
+        ~Handle()
+        {
+            release();
+        }
+
+        /**
+         * Assigns a handle.
+         *
+         * @param[in] handle    Handle, which to assign
+         *
+         * @return Handle
+         */
+        Handle& operator=(const Handle& handle);
+
+        /**
+         * Release the referenced image.
+         */
+        void release();
+
+        /**
+         * Is no image referenced?
+         *
+         * @return If empty, it will return true otherwise false.
+         */
+        bool isEmpty() const
+        {
+            return (nullptr == m_entry);
+        }
+
+        /**
+         * Get the referenced image. If the handle is empty, a empty bitmap
+         * is returned.
+         *
+         * @return Bitmap
+         */
+        const YAGfxDynamicBitmap& get() const;
+
+        /**
+         * Get the sprite sheet information, which is stored together with
+         * a native image.
+         *
+         * @param[out] spriteInfo   Sprite sheet information
+         *
+         * @return If available, it will return true otherwise false.
+         */
+        bool getSpriteInfo(NativeImg::SpriteInfo& spriteInfo) const;
+
+    private:
+
+        friend class ImageCache;
+
+        Entry*  m_entry;    /**< Referenced cache entry */
+
+        /**
+         * Constructs a handle, which references a cache entry.
+         * The reference counter must already be incremented.
+         *
+         * @param[in] entry Cache entry
+         */
+        explicit Handle(Entry* entry) :
+            m_entry(entry)
+        {
+        }
+    };
+
+    /**
+     * Get the image cache instance.
+     *
+     * @return Image cache instance
+     */
+    static ImageCache& getInstance()
+    {
+        static ImageCache instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Load a bitmap image (.bmp) or a native image from the filesystem.
+     * If the image is already cached, it is shared without accessing the
+     * filesystem.
+     *
+     * @param[in]   fs          Filesystem
+     * @param[in]   fileName    Filename with full path
+     * @param[out]  handle      Handle of the cached image
+     *
+     * @return Result of the bitmap image loader.
+     */
+    BmpImgLoader::Ret load(FS& fs, const String& fileName, Handle& handle);
+
+    /**
+     * Invalidate the cached image of the file, e.g. after it was written or
+     * removed. Images which are still referenced, are kept until they are
+     * released, but they are not shared anymore.
+     *
+     * @param[in] fileName  Filename with full path
+     */
+    void invalidate(const String& fileName);
+
+    /**
+     * Remove all images, which are not referenced.
+     */
+    void clear();
+
+    /**
+     * Get the memory in byte, which is used by the cached images.
+     *
+     * @return Used memory in byte
+     */
+    size_t getMemoryUsed() const;
+
+    /** Max. memory in byte, which is used by the decoded images. */
+    static const size_t     MEMORY_LIMIT        = CONFIG_IMAGE_CACHE_MEMORY_LIMIT;
+
+    /** A cached image is revalidated against its file after this period in ms. */
+    static const uint32_t   VALIDATION_PERIOD   = 10000U;
+
+private:
+
+    /**
+     * A cached image.
+     */
+    struct Entry
+    {
+        String                  fileName;       /**< Filename with full path */
+        String                  filePath;       /**< Full path of the loaded file, which may be the native image of the requested one. */
+        time_t                  lastWrite;      /**< File modification time */
+        size_t                  fileSize;       /**< File size in byte */
+        YAGfxDynamicBitmap      bitmap;         /**< Decoded image */
+        NativeImg::SpriteInfo   spriteInfo;     /**< Sprite sheet information of a native image, frame size is 0 if not available. */
+        uint32_t                refCnt;         /**< Number of handles, which reference the image. */
+        uint32_t                lastUsed;       /**< Timestamp in ms, when the image was used the last time. */
+        uint32_t                lastValidation; /**< Timestamp in ms, when the image was validated the last time. */
+        bool                    isOrphan;       /**< Is the image invalidated, but still referenced? */
+    };
+
+    /** List of cached images */
+    typedef std::vector<Entry*> EntryList;
+
+#ifndef NATIVE
+    mutable MutexRecursive  m_mutex;        /**< Used to protect against concurrent access. */
+#endif  /* NATIVE */
+    EntryList               m_entries;      /**< Cached images */
+    size_t                  m_memoryUsed;   /**< Memory in byte, used by the cached images. */
+
+    /**
+     * Constructs the image cache.
+     */
+    ImageCache();
+
+    /**
+     * Destroys the image cache.
+     */
+    ~ImageCache();
+
+    ImageCache(const ImageCache& cache);
+    ImageCache& operator=(const ImageCache& cache);
+
+    /**
+     * Increment the reference counter of the entry.
+     *
+     * @param[in] entry Cache entry
+     */
+    void acquire(Entry* entry);
+
+    /**
+     * Decrement the reference counter of the entry. A orphan entry is
+     * destroyed, if it is not referenced anymore.
+     *
+     * @param[in] entry Cache entry
+     */
+    void release(Entry* entry);
+
+    /**
+     * Find the cached image of the file.
+     *
+     * @param[in] fileName  Filename with full path
+     *
+     * @return Iterator to the entry. If not found, it will return the end.
+     */
+    EntryList::iterator find(const String& fileName);
+
+    /**
+     * Is the cached image still up to date?
+     * The filesystem is only accessed, if the validation period elapsed.
+     *
+     * @param[in] fs    Filesystem
+     * @param[in] entry Cache entry
+     * @param[in] now   Current timestamp in ms
+     *
+     * @return If up to date, it will return true otherwise false.
+     */
+    bool isValid(FS& fs, Entry& entry, uint32_t now);
+
+    /**
+     * Remove the entry from the cache. If it is still referenced, it becomes
+     * a orphan and is destroyed by the last release.
+     *
+     * @param[in] it    Iterator to the entry
+     *
+     * @return Iterator to the next entry
+     */
+    EntryList::iterator remove(EntryList::iterator it);
+
+    /**
+     * Evict least recently used images, which are not referenced, until the
+     * memory limit is met.
+     */
+    void evict();
+
+    /**
+     * Get the memory in byte, which the bitmap uses.
+     *
+     * @param[in] bitmap    Bitmap
+     *
+     * @return Memory in byte
+     */
+    static size_t getBitmapSize(const YAGfxDynamicBitmap& bitmap)
+    {
+        return static_cast<size_t>(bitmap.getWidth()) * bitmap.getHeight() * sizeof(Color);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* IMAGE_CACHE_H */
+
+/** @} */
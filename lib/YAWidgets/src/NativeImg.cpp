@@ -0,0 +1,781 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Native image format
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NativeImg.h"
+
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Native image header.
+ */
+typedef struct _NativeImgHeader
+{
+    uint8_t     signature[NativeImg::SIGNATURE_SIZE];   /**< Signature for file format identification. */
+    uint8_t     version;                                /**< Format version */
+    uint8_t     encoding;                               /**< Pixel data encoding */
+    uint8_t     flags;                                  /**< Flags */
+    uint8_t     reserved1;                              /**< Reserved */
+    uint16_t    width;                                  /**< Image width in pixels */
+    uint16_t    height;                                 /**< Image height in pixels */
+    uint16_t    paletteSize;                            /**< Number of palette colors, 0 if not palette encoded. */
+    uint16_t    reserved2;                              /**< Reserved */
+
+} __attribute__ ((packed)) NativeImgHeader;
+
+/**
+ * Native image sprite sheet information.
+ */
+typedef struct _NativeImgSpriteInfo
+{
+    uint16_t    frameWidth;     /**< Frame width in pixels */
+    uint16_t    frameHeight;    /**< Frame height in pixels */
+    uint8_t     frameCnt;       /**< Number of frames, 0 if the texture is filled completely. */
+    uint8_t     fps;            /**< Frames per second */
+    uint8_t     repeat;         /**< Animation is repeated infinite (1) or not (0). */
+    uint8_t     reserved;       /**< Reserved */
+
+} __attribute__ ((packed)) NativeImgSpriteInfo;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize native image file extension. */
+const char* NativeImg::FILE_EXTENSION = ".pxim";
+
+/* Initialize signature "PXIM". */
+const uint8_t NativeImg::SIGNATURE[NativeImg::SIGNATURE_SIZE] = { 'P', 'X', 'I', 'M' };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+NativeImg::Ret NativeImg::load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap, SpriteInfo* spriteInfo)
+{
+    Ret     ret = BmpImgLoader::RET_OK;
+    File    fd  = fs.open(fileName);
+
+    m_bufferSize    = 0U;
+    m_bufferIndex   = 0U;
+
+    if (nullptr != spriteInfo)
+    {
+        spriteInfo->frameWidth  = 0U;
+        spriteInfo->frameHeight = 0U;
+        spriteInfo->frameCnt    = 0U;
+        spriteInfo->fps         = 0U;
+        spriteInfo->isRepeated  = true;
+    }
+
+    if (false == fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        NativeImgHeader header;
+        void*           vHeader     = &header;
+        uint8_t*        u8Header    = static_cast<uint8_t*>(vHeader);
+
+        if (false == read(fd, u8Header, sizeof(header)))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else if ((false == isNativeImg(header.signature, sizeof(header.signature))) ||
+                 (VERSION != header.version) ||
+                 (ENCODING_MAX <= header.encoding))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED;
+        }
+        else if (PALETTE_MAX < header.paletteSize)
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else
+        {
+            uint32_t*   palette     = nullptr;
+            Encoding    encoding    = static_cast<Encoding>(header.encoding);
+
+            if (0U != (header.flags & FLAG_SPRITE_INFO))
+            {
+                NativeImgSpriteInfo nativeSpriteInfo;
+                void*               vSpriteInfo     = &nativeSpriteInfo;
+                uint8_t*            u8SpriteInfo    = static_cast<uint8_t*>(vSpriteInfo);
+
+                if (false == read(fd, u8SpriteInfo, sizeof(nativeSpriteInfo)))
+                {
+                    ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                }
+                else if (nullptr != spriteInfo)
+                {
+                    spriteInfo->frameWidth  = nativeSpriteInfo.frameWidth;
+                    spriteInfo->frameHeight = nativeSpriteInfo.frameHeight;
+                    spriteInfo->frameCnt    = nativeSpriteInfo.frameCnt;
+                    spriteInfo->fps         = nativeSpriteInfo.fps;
+                    spriteInfo->isRepeated  = (0U != nativeSpriteInfo.repeat);
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            if ((BmpImgLoader::RET_OK == ret) &&
+                (0U < header.paletteSize))
+            {
+                palette = new(std::nothrow) uint32_t[header.paletteSize];
+
+                if (nullptr == palette)
+                {
+                    ret = BmpImgLoader::RET_IMG_TOO_BIG;
+                }
+                else
+                {
+                    uint16_t idx = 0U;
+
+                    while((header.paletteSize > idx) && (BmpImgLoader::RET_OK == ret))
+                    {
+                        uint8_t rgb[3U];
+
+                        if (false == read(fd, rgb, sizeof(rgb)))
+                        {
+                            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                        }
+                        else
+                        {
+                            palette[idx] = (static_cast<uint32_t>(rgb[0U]) << 16U) |
+                                           (static_cast<uint32_t>(rgb[1U]) << 8U) |
+                                           static_cast<uint32_t>(rgb[2U]);
+                        }
+
+                        ++idx;
+                    }
+                }
+            }
+
+            if (BmpImgLoader::RET_OK == ret)
+            {
+                bitmap.release();
+
+                if (false == bitmap.create(header.width, header.height))
+                {
+                    ret = BmpImgLoader::RET_IMG_TOO_BIG;
+                }
+                else if (false == decode(fd, encoding, palette, header.paletteSize, bitmap))
+                {
+                    ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            if (nullptr != palette)
+            {
+                delete[] palette;
+                palette = nullptr;
+            }
+        }
+
+        fd.close();
+    }
+
+    if (BmpImgLoader::RET_OK != ret)
+    {
+        bitmap.release();
+    }
+
+    return ret;
+}
+
+bool NativeImg::save(FS& fs, const String& fileName, const YAGfxBitmap& bitmap, const SpriteInfo* spriteInfo)
+{
+    bool        isSuccessful    = false;
+    uint32_t*   palette         = new(std::nothrow) uint32_t[PALETTE_MAX];
+    size_t      paletteSize     = 0U;
+
+    if (nullptr != palette)
+    {
+        const size_t    PIXEL_CNT       = static_cast<size_t>(bitmap.getWidth()) * bitmap.getHeight();
+        size_t          packetCnt       = 0U;
+        size_t          valueCnt        = 0U;
+        size_t          sizes[ENCODING_MAX];
+        Encoding        encoding        = ENCODING_RGB;
+        uint8_t         idx             = 0U;
+
+        /* Determine the size of the pixel data for every encoding. The RLE
+         * packets are the same for RGB and palette indices, because equal
+         * colors have equal indices.
+         */
+        (void)encodeRle(bitmap, nullptr, 0U, nullptr, packetCnt, valueCnt);
+
+        sizes[ENCODING_RGB]         = 3U * PIXEL_CNT;
+        sizes[ENCODING_RLE_RGB]     = packetCnt + 3U * valueCnt;
+
+        if (false == getPalette(bitmap, palette, paletteSize))
+        {
+            sizes[ENCODING_PALETTE]     = SIZE_MAX;
+            sizes[ENCODING_RLE_PALETTE] = SIZE_MAX;
+        }
+        else
+        {
+            sizes[ENCODING_PALETTE]     = 3U * paletteSize + PIXEL_CNT;
+            sizes[ENCODING_RLE_PALETTE] = 3U * paletteSize + packetCnt + valueCnt;
+        }
+
+        for(idx = 0U; idx < ENCODING_MAX; ++idx)
+        {
+            if (sizes[encoding] > sizes[idx])
+            {
+                encoding = static_cast<Encoding>(idx);
+            }
+        }
+
+        if ((ENCODING_RGB == encoding) ||
+            (ENCODING_RLE_RGB == encoding))
+        {
+            paletteSize = 0U;
+        }
+
+        File fd = fs.open(fileName, "w");
+
+        if (true == fd)
+        {
+            NativeImgHeader header;
+            const void*     vHeader     = &header;
+            const uint8_t*  u8Header    = static_cast<const uint8_t*>(vHeader);
+
+            memcpy(header.signature, SIGNATURE, sizeof(header.signature));
+            header.version      = VERSION;
+            header.encoding     = encoding;
+            header.flags        = (nullptr != spriteInfo) ? FLAG_SPRITE_INFO : 0U;
+            header.reserved1    = 0U;
+            header.width        = bitmap.getWidth();
+            header.height       = bitmap.getHeight();
+            header.paletteSize  = paletteSize;
+            header.reserved2    = 0U;
+
+            isSuccessful = (sizeof(header) == fd.write(u8Header, sizeof(header)));
+
+            if ((true == isSuccessful) &&
+                (nullptr != spriteInfo))
+            {
+                NativeImgSpriteInfo nativeSpriteInfo;
+                const void*         vSpriteInfo     = &nativeSpriteInfo;
+                const uint8_t*      u8SpriteInfo    = static_cast<const uint8_t*>(vSpriteInfo);
+
+                nativeSpriteInfo.frameWidth     = spriteInfo->frameWidth;
+                nativeSpriteInfo.frameHeight    = spriteInfo->frameHeight;
+                nativeSpriteInfo.frameCnt       = spriteInfo->frameCnt;
+                nativeSpriteInfo.fps            = spriteInfo->fps;
+                nativeSpriteInfo.repeat         = (true == spriteInfo->isRepeated) ? 1U : 0U;
+                nativeSpriteInfo.reserved       = 0U;
+
+                isSuccessful = (sizeof(nativeSpriteInfo) == fd.write(u8SpriteInfo, sizeof(nativeSpriteInfo)));
+            }
+
+            if (true == isSuccessful)
+            {
+                size_t paletteIdx = 0U;
+
+                while((paletteSize > paletteIdx) && (true == isSuccessful))
+                {
+                    isSuccessful = writeValue(fd, palette[paletteIdx], nullptr, 0U);
+                    ++paletteIdx;
+                }
+            }
+
+            if (true == isSuccessful)
+            {
+                const uint32_t* usedPalette = (0U < paletteSize) ? palette : nullptr;
+
+                if ((ENCODING_RLE_RGB == encoding) ||
+                    (ENCODING_RLE_PALETTE == encoding))
+                {
+                    isSuccessful = encodeRle(bitmap, usedPalette, paletteSize, &fd, packetCnt, valueCnt);
+                }
+                else
+                {
+                    size_t pixelIdx = 0U;
+
+                    while((PIXEL_CNT > pixelIdx) && (true == isSuccessful))
+                    {
+                        isSuccessful = writeValue(fd, getRgb24(bitmap, pixelIdx), usedPalette, paletteSize);
+                        ++pixelIdx;
+                    }
+                }
+            }
+
+            fd.close();
+
+            if (false == isSuccessful)
+            {
+                (void)fs.remove(fileName);
+            }
+        }
+
+        delete[] palette;
+        palette = nullptr;
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::convert(FS& fs, const String& fileName)
+{
+    bool                isSuccessful    = false;
+    String              nativeFileName  = getFileName(fileName);
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  bitmap;
+
+    if ((nativeFileName != fileName) &&
+        (BmpImgLoader::RET_OK == loader.load(fs, fileName, bitmap)))
+    {
+        String tmpFileName = nativeFileName + ".tmp";
+
+        /* Write to a temporary file first, to keep the original file in
+         * case of an error.
+         */
+        if (true == save(fs, tmpFileName, bitmap))
+        {
+            (void)fs.remove(nativeFileName);
+
+            if (true == fs.rename(tmpFileName, nativeFileName))
+            {
+                (void)fs.remove(fileName);
+                isSuccessful = true;
+            }
+            else
+            {
+                (void)fs.remove(tmpFileName);
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+String NativeImg::getFileName(const String& fileName)
+{
+    int     extIdx      = fileName.lastIndexOf('.');
+    int     dirIdx      = fileName.lastIndexOf('/');
+    String  nativeName  = fileName;
+
+    /* A dot in a directory name is not the begin of the file extension. */
+    if (dirIdx < extIdx)
+    {
+        nativeName = fileName.substring(0, extIdx);
+    }
+
+    nativeName += FILE_EXTENSION;
+
+    return nativeName;
+}
+
+void NativeImg::removeFileOf(FS& fs, const String& fileName)
+{
+    String nativeFileName = getFileName(fileName);
+
+    if ((nativeFileName != fileName) &&
+        (true == fs.exists(nativeFileName)))
+    {
+        (void)fs.remove(nativeFileName);
+    }
+}
+
+bool NativeImg::exists(FS& fs, const String& fileName)
+{
+    String nativeFileName = getFileName(fileName);
+
+    return ((true == fs.exists(fileName)) ||
+            ((nativeFileName != fileName) && (true == fs.exists(nativeFileName))));
+}
+
+bool NativeImg::remove(FS& fs, const String& fileName)
+{
+    String  nativeFileName  = getFileName(fileName);
+    bool    isRemoved       = fs.remove(fileName);
+
+    if ((nativeFileName != fileName) &&
+        (true == fs.remove(nativeFileName)))
+    {
+        isRemoved = true;
+    }
+
+    return isRemoved;
+}
+
+bool NativeImg::isNativeImg(const uint8_t* data, size_t size)
+{
+    bool isNative = false;
+
+    if ((nullptr != data) &&
+        (SIGNATURE_SIZE <= size))
+    {
+        isNative = (0 == memcmp(data, SIGNATURE, SIGNATURE_SIZE));
+    }
+
+    return isNative;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool NativeImg::read(File& fd, uint8_t* data, size_t size)
+{
+    size_t idx = 0U;
+
+    while(size > idx)
+    {
+        if (m_bufferSize <= m_bufferIndex)
+        {
+            m_bufferSize    = fd.read(m_buffer, sizeof(m_buffer));
+            m_bufferIndex   = 0U;
+
+            if (0U == m_bufferSize)
+            {
+                /* End of file reached. */
+                size = idx;
+            }
+        }
+
+        if (m_bufferSize > m_bufferIndex)
+        {
+            data[idx] = m_buffer[m_bufferIndex];
+            ++m_bufferIndex;
+            ++idx;
+        }
+    }
+
+    return (0U < size);
+}
+
+bool NativeImg::decode(File& fd, Encoding encoding, const uint32_t* palette, size_t paletteSize, YAGfxDynamicBitmap& bitmap)
+{
+    bool            isSuccessful    = true;
+    const uint16_t  WIDTH           = bitmap.getWidth();
+    const size_t    PIXEL_CNT       = static_cast<size_t>(WIDTH) * bitmap.getHeight();
+    size_t          pixelIdx        = 0U;
+    const uint32_t* usedPalette     = nullptr;
+
+    if ((ENCODING_PALETTE == encoding) ||
+        (ENCODING_RLE_PALETTE == encoding))
+    {
+        usedPalette = palette;
+
+        if (nullptr == usedPalette)
+        {
+            isSuccessful = false;
+        }
+    }
+
+    if ((ENCODING_RGB == encoding) ||
+        (ENCODING_PALETTE == encoding))
+    {
+        while((PIXEL_CNT > pixelIdx) && (true == isSuccessful))
+        {
+            Color color;
+
+            if (false == readValue(fd, usedPalette, paletteSize, color))
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                bitmap.drawPixel(pixelIdx % WIDTH, pixelIdx / WIDTH, color);
+                ++pixelIdx;
+            }
+        }
+    }
+    else
+    {
+        while((PIXEL_CNT > pixelIdx) && (true == isSuccessful))
+        {
+            uint8_t ctrl = 0U;
+
+            if (false == read(fd, &ctrl, sizeof(ctrl)))
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                bool    isRun       = (0U != (ctrl & RLE_RUN_FLAG));
+                size_t  valueCnt    = static_cast<size_t>(ctrl & ~RLE_RUN_FLAG) + 1U;
+                Color   color;
+
+                /* A packet must not exceed the image. */
+                if ((PIXEL_CNT - pixelIdx) < valueCnt)
+                {
+                    isSuccessful = false;
+                }
+                else if ((true == isRun) &&
+                         (false == readValue(fd, usedPalette, paletteSize, color)))
+                {
+                    isSuccessful = false;
+                }
+                else
+                {
+                    while((0U < valueCnt) && (true == isSuccessful))
+                    {
+                        if ((false == isRun) &&
+                            (false == readValue(fd, usedPalette, paletteSize, color)))
+                        {
+                            isSuccessful = false;
+                        }
+                        else
+                        {
+                            bitmap.drawPixel(pixelIdx % WIDTH, pixelIdx / WIDTH, color);
+                            ++pixelIdx;
+                            --valueCnt;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::readValue(File& fd, const uint32_t* palette, size_t paletteSize, Color& color)
+{
+    bool isSuccessful = false;
+
+    if (nullptr == palette)
+    {
+        uint8_t rgb[3U];
+
+        if (true == read(fd, rgb, sizeof(rgb)))
+        {
+            color.set(rgb[0U], rgb[1U], rgb[2U]);
+            isSuccessful = true;
+        }
+    }
+    else
+    {
+        uint8_t paletteIdx = 0U;
+
+        if ((true == read(fd, &paletteIdx, sizeof(paletteIdx))) &&
+            (paletteSize > paletteIdx))
+        {
+            color.set(palette[paletteIdx]);
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::getPalette(const YAGfxBitmap& bitmap, uint32_t* palette, size_t& paletteSize)
+{
+    bool            isSuccessful    = true;
+    const size_t    PIXEL_CNT       = static_cast<size_t>(bitmap.getWidth()) * bitmap.getHeight();
+    size_t          pixelIdx        = 0U;
+
+    paletteSize = 0U;
+
+    while((PIXEL_CNT > pixelIdx) && (true == isSuccessful))
+    {
+        uint32_t    rgb24       = getRgb24(bitmap, pixelIdx);
+        size_t      paletteIdx  = 0U;
+
+        while((paletteSize > paletteIdx) && (rgb24 != palette[paletteIdx]))
+        {
+            ++paletteIdx;
+        }
+
+        if (paletteSize == paletteIdx)
+        {
+            if (PALETTE_MAX <= paletteSize)
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                palette[paletteSize] = rgb24;
+                ++paletteSize;
+            }
+        }
+
+        ++pixelIdx;
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::encodeRle(const YAGfxBitmap& bitmap, const uint32_t* palette, size_t paletteSize, File* fd, size_t& packetCnt, size_t& valueCnt)
+{
+    bool            isSuccessful    = true;
+    const size_t    PIXEL_CNT       = static_cast<size_t>(bitmap.getWidth()) * bitmap.getHeight();
+    size_t          pixelIdx        = 0U;
+
+    packetCnt   = 0U;
+    valueCnt    = 0U;
+
+    while((PIXEL_CNT > pixelIdx) && (true == isSuccessful))
+    {
+        uint32_t    rgb24   = getRgb24(bitmap, pixelIdx);
+        size_t      runLen  = 1U;
+
+        while(((pixelIdx + runLen) < PIXEL_CNT) &&
+              (RLE_PACKET_MAX_VALUES > runLen) &&
+              (rgb24 == getRgb24(bitmap, pixelIdx + runLen)))
+        {
+            ++runLen;
+        }
+
+        if (1U < runLen)
+        {
+            if (nullptr != fd)
+            {
+                uint8_t ctrl = RLE_RUN_FLAG | static_cast<uint8_t>(runLen - 1U);
+
+                isSuccessful = (sizeof(ctrl) == fd->write(&ctrl, sizeof(ctrl))) &&
+                               (true == writeValue(*fd, rgb24, palette, paletteSize));
+            }
+
+            ++packetCnt;
+            ++valueCnt;
+            pixelIdx += runLen;
+        }
+        else
+        {
+            /* Collect literal values until the next run starts. */
+            size_t literalLen = 1U;
+
+            while(((pixelIdx + literalLen) < PIXEL_CNT) &&
+                  (RLE_PACKET_MAX_VALUES > literalLen) &&
+                  (((pixelIdx + literalLen + 1U) >= PIXEL_CNT) ||
+                   (getRgb24(bitmap, pixelIdx + literalLen) != getRgb24(bitmap, pixelIdx + literalLen + 1U))))
+            {
+                ++literalLen;
+            }
+
+            if (nullptr != fd)
+            {
+                uint8_t ctrl        = static_cast<uint8_t>(literalLen - 1U);
+                size_t  literalIdx  = 0U;
+
+                isSuccessful = (sizeof(ctrl) == fd->write(&ctrl, sizeof(ctrl)));
+
+                while((literalLen > literalIdx) && (true == isSuccessful))
+                {
+                    isSuccessful = writeValue(*fd, getRgb24(bitmap, pixelIdx + literalIdx), palette, paletteSize);
+                    ++literalIdx;
+                }
+            }
+
+            ++packetCnt;
+            valueCnt += literalLen;
+            pixelIdx += literalLen;
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::writeValue(File& fd, uint32_t rgb24, const uint32_t* palette, size_t paletteSize)
+{
+    bool isSuccessful = false;
+
+    if (nullptr == palette)
+    {
+        uint8_t rgb[3U] =
+        {
+            static_cast<uint8_t>((rgb24 >> 16U) & 0xFFU),
+            static_cast<uint8_t>((rgb24 >> 8U) & 0xFFU),
+            static_cast<uint8_t>(rgb24 & 0xFFU)
+        };
+
+        isSuccessful = (sizeof(rgb) == fd.write(rgb, sizeof(rgb)));
+    }
+    else
+    {
+        size_t paletteIdx = 0U;
+
+        while((paletteSize > paletteIdx) && (rgb24 != palette[paletteIdx]))
+        {
+            ++paletteIdx;
+        }
+
+        if (paletteSize > paletteIdx)
+        {
+            uint8_t u8PaletteIdx = static_cast<uint8_t>(paletteIdx);
+
+            isSuccessful = (sizeof(u8PaletteIdx) == fd.write(&u8PaletteIdx, sizeof(u8PaletteIdx)));
+        }
+    }
+
+    return isSuccessful;
+}
+
+uint32_t NativeImg::getRgb24(const YAGfxBitmap& bitmap, size_t index)
+{
+    const uint16_t  WIDTH   = bitmap.getWidth();
+    const Color&    color   = bitmap.getColor(index % WIDTH, index / WIDTH);
+
+    return (static_cast<uint32_t>(color.getRed()) << 16U) |
+           (static_cast<uint32_t>(color.getGreen()) << 8U) |
+           static_cast<uint32_t>(color.getBlue());
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
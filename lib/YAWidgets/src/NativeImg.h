@@ -0,0 +1,352 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Native image format
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef NATIVE_IMG_H
+#define NATIVE_IMG_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+#include "BmpImgLoader.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Loads and saves images in the native image format. The pixels are stored
+ * in the same order as in the framebuffer (row by row, top to bottom), which
+ * allows to decode them while streaming from the filesystem.
+ *
+ * File layout (little endian):
+ * - Header (16 byte): Signature "PXIM", version, encoding, flags, reserved,
+ *   width, height, number of palette colors, reserved.
+ * - Sprite sheet info (8 byte), only if flagged: frame width, frame height,
+ *   number of frames, fps, repeat, reserved.
+ * - Palette (3 byte per color, RGB), only if palette encoded.
+ * - Pixel data: RGB (3 byte) or palette index (1 byte) per pixel. If RLE is
+ *   used, the data is split into packets, which start with a control byte.
+ *   Bit 7 set: The next value is repeated (bit 0-6) + 1 times.
+ *   Bit 7 cleared: (bit 0-6) + 1 literal values follow.
+ *
+ * The encoding is chosen by the smallest resulting file size.
+ *
+ * A native image replaces the bitmap image it is converted from. It has the
+ * same name, but its own file extension (.pxim). The image is still
+ * addressed by the bitmap image name and the image cache prefers the native
+ * image, if available.
+ */
+class NativeImg
+{
+public:
+
+    /**
+     * The results are the same as of the bitmap image loader.
+     */
+    typedef BmpImgLoader::Ret Ret;
+
+    /**
+     * Sprite sheet information, which can be stored together with the
+     * texture image.
+     */
+    struct SpriteInfo
+    {
+        uint16_t    frameWidth;     /**< Frame width in pixels */
+        uint16_t    frameHeight;    /**< Frame height in pixels */
+        uint8_t     frameCnt;       /**< Number of frames, 0 if the texture is filled completely. */
+        uint8_t     fps;            /**< Frames per second */
+        bool        isRepeated;     /**< Is the animation repeated infinite? */
+    };
+
+    /**
+     * Constructs the native image loader.
+     */
+    NativeImg() :
+        m_buffer(),
+        m_bufferSize(0U),
+        m_bufferIndex(0U)
+    {
+    }
+
+    /**
+     * Destroys the native image loader.
+     */
+    ~NativeImg()
+    {
+    }
+
+    /**
+     * Load native image from file system to bitmap buffer.
+     *
+     * If the image contains no sprite sheet information, the frame size
+     * will be 0.
+     *
+     * @param[in]   fs          File system
+     * @param[in]   fileName    Name of the image file in the filesystem
+     * @param[out]  bitmap      Bitmap buffer
+     * @param[out]  spriteInfo  Sprite sheet information. May be nullptr.
+     *
+     * @return Result
+     */
+    Ret load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap, SpriteInfo* spriteInfo = nullptr);
+
+    /**
+     * Save bitmap as native image to the file system.
+     * A existing file is overwritten.
+     *
+     * @param[in] fs            File system
+     * @param[in] fileName      Name of the image file in the filesystem
+     * @param[in] bitmap        Bitmap
+     * @param[in] spriteInfo    Sprite sheet information, which to store. May be nullptr.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool save(FS& fs, const String& fileName, const YAGfxBitmap& bitmap, const SpriteInfo* spriteInfo = nullptr);
+
+    /**
+     * Convert a bitmap image file to a native image file. On success the
+     * bitmap image file is replaced by the native image file, otherwise
+     * it is kept as it is.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the bitmap image file in the filesystem
+     *
+     * @return If successful converted, it will return true otherwise false.
+     */
+    bool convert(FS& fs, const String& fileName);
+
+    /**
+     * Get the name of the native image file, which belongs to a image file.
+     * It has the same name, but the native image file extension.
+     *
+     * @param[in] fileName  Name of the image file, e.g. a bitmap image (.bmp)
+     *
+     * @return Name of the native image file
+     */
+    static String getFileName(const String& fileName);
+
+    /**
+     * Remove the native image file, which belongs to a image file. This
+     * shall be called whenever the image file is written or removed,
+     * otherwise the outdated native image would be shown instead.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the image file, e.g. a bitmap image (.bmp)
+     */
+    static void removeFileOf(FS& fs, const String& fileName);
+
+    /**
+     * Does the image file or the native image file, which belongs to it,
+     * exist?
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the image file, e.g. a bitmap image (.bmp)
+     *
+     * @return If one of them exists, it will return true otherwise false.
+     */
+    static bool exists(FS& fs, const String& fileName);
+
+    /**
+     * Remove the image file and the native image file, which belongs to it.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the image file, e.g. a bitmap image (.bmp)
+     *
+     * @return If one of them is removed, it will return true otherwise false.
+     */
+    static bool remove(FS& fs, const String& fileName);
+
+    /**
+     * Is the data the begin of a native image?
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If it is a native image, it will return true otherwise false.
+     */
+    static bool isNativeImg(const uint8_t* data, size_t size);
+
+    /** File extension of native image files. */
+    static const char*  FILE_EXTENSION;
+
+    /** Size in byte of the signature at the begin of the file. */
+    static const size_t SIGNATURE_SIZE  = 4U;
+
+    /** Max. number of palette colors. */
+    static const size_t PALETTE_MAX     = 256U;
+
+private:
+
+    /**
+     * Pixel data encodings.
+     */
+    enum Encoding
+    {
+        ENCODING_RGB = 0,       /**< 3 byte RGB per pixel */
+        ENCODING_PALETTE,       /**< 1 byte palette index per pixel */
+        ENCODING_RLE_RGB,       /**< RLE packets with RGB values */
+        ENCODING_RLE_PALETTE,   /**< RLE packets with palette indices */
+        ENCODING_MAX            /**< Number of encodings */
+    };
+
+    /** Current format version. */
+    static const uint8_t    VERSION                 = 1U;
+
+    /** Header flag: Sprite sheet information follows the header. */
+    static const uint8_t    FLAG_SPRITE_INFO        = 0x01U;
+
+    /** RLE control byte flag: The next value is repeated. */
+    static const uint8_t    RLE_RUN_FLAG            = 0x80U;
+
+    /** Max. number of values in a single RLE packet. */
+    static const size_t     RLE_PACKET_MAX_VALUES   = 128U;
+
+    /** Size in byte of the read buffer. */
+    static const size_t     BUFFER_SIZE             = 64U;
+
+    /** Signature at the begin of the file. */
+    static const uint8_t    SIGNATURE[SIGNATURE_SIZE];
+
+    uint8_t m_buffer[BUFFER_SIZE];  /**< Read buffer */
+    size_t  m_bufferSize;           /**< Number of bytes in the read buffer */
+    size_t  m_bufferIndex;          /**< Index of the next byte to read from the buffer */
+
+    NativeImg(const NativeImg& img);
+    NativeImg& operator=(const NativeImg& img);
+
+    /**
+     * Read data buffered from the file.
+     *
+     * @param[in]   fd      File descriptor
+     * @param[out]  data    Data buffer
+     * @param[in]   size    Number of bytes to read
+     *
+     * @return If all bytes are read, it will return true otherwise false.
+     */
+    bool read(File& fd, uint8_t* data, size_t size);
+
+    /**
+     * Decode the pixel data.
+     *
+     * @param[in]       fd          File descriptor
+     * @param[in]       encoding    Pixel data encoding
+     * @param[in]       palette     Palette as RGB24 values, may be nullptr if not palette encoded.
+     * @param[in]       paletteSize Number of palette colors
+     * @param[in,out]   bitmap      Bitmap buffer with the image size.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool decode(File& fd, Encoding encoding, const uint32_t* palette, size_t paletteSize, YAGfxDynamicBitmap& bitmap);
+
+    /**
+     * Read a single pixel value and convert it to a color.
+     *
+     * @param[in]   fd          File descriptor
+     * @param[in]   palette     Palette as RGB24 values, may be nullptr if not palette encoded.
+     * @param[in]   paletteSize Number of palette colors
+     * @param[out]  color       Color
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readValue(File& fd, const uint32_t* palette, size_t paletteSize, Color& color);
+
+    /**
+     * Determine the palette of the bitmap.
+     *
+     * @param[in]   bitmap      Bitmap
+     * @param[out]  palette     Palette as RGB24 values with PALETTE_MAX elements.
+     * @param[out]  paletteSize Number of palette colors
+     *
+     * @return If the bitmap has not more colors than PALETTE_MAX, it will return true otherwise false.
+     */
+    static bool getPalette(const YAGfxBitmap& bitmap, uint32_t* palette, size_t& paletteSize);
+
+    /**
+     * Encode the pixel data with RLE. If no file descriptor is given, only
+     * the number of packets and values are determined.
+     *
+     * @param[in]   bitmap      Bitmap
+     * @param[in]   palette     Palette as RGB24 values, nullptr if RGB values shall be written.
+     * @param[in]   paletteSize Number of palette colors
+     * @param[in]   fd          File descriptor, may be nullptr.
+     * @param[out]  packetCnt   Number of packets
+     * @param[out]  valueCnt    Number of values in all packets
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool encodeRle(const YAGfxBitmap& bitmap, const uint32_t* palette, size_t paletteSize, File* fd, size_t& packetCnt, size_t& valueCnt);
+
+    /**
+     * Write a single pixel value.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] rgb24         Pixel color as RGB24 value
+     * @param[in] palette       Palette as RGB24 values, nullptr if RGB values shall be written.
+     * @param[in] paletteSize   Number of palette colors
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool writeValue(File& fd, uint32_t rgb24, const uint32_t* palette, size_t paletteSize);
+
+    /**
+     * Get the RGB24 value of the pixel.
+     *
+     * @param[in] bitmap    Bitmap
+     * @param[in] index     Pixel index in framebuffer order
+     *
+     * @return RGB24 value
+     */
+    static uint32_t getRgb24(const YAGfxBitmap& bitmap, size_t index);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* NATIVE_IMG_H */
+
+/** @} */
@@ -35,7 +35,6 @@
 #include "SpriteSheet.h"
 
 #include <ArduinoJson.h>
-#include <BmpImgLoader.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -91,16 +90,16 @@ bool SpriteSheet::loadTexture(FS& fs, const String& fileName, uint16_t frameWidt
     if ((0U < frameWidth) &&
         (0U < frameHeight))
     {
-        BmpImgLoader loader;
-
-        if (BmpImgLoader::RET_OK == loader.load(fs, fileName, m_texture))
+        if (BmpImgLoader::RET_OK == ImageCache::getInstance().load(fs, fileName, m_texture))
         {
+            const YAGfxDynamicBitmap& texture = m_texture.get();
+
             /* The frame size must be lower or equal to the texture size. */
-            if ((m_texture.getWidth() >= frameWidth) &&
-                (m_texture.getHeight() >= frameHeight))
+            if ((texture.getWidth() >= frameWidth) &&
+                (texture.getHeight() >= frameHeight))
             {
-                m_framesX   = m_texture.getWidth() / frameWidth;
-                m_framesY   = m_texture.getHeight() / frameHeight;
+                m_framesX   = texture.getWidth() / frameWidth;
+                m_framesY   = texture.getHeight() / frameHeight;
 
                 /* A 0 number of frames requests the automatic frame count calculation.
                  * This assumes that there will be no frame gaps in the texture image.
@@ -114,6 +113,10 @@ bool SpriteSheet::loadTexture(FS& fs, const String& fileName, uint16_t frameWidt
                     m_frameCnt = frameCnt;
                 }
 
+                /* The texture is shared and only read via the map, although
+                 * the map requires a modifiable canvas.
+                 */
+                m_textureMap.setGfx(const_cast<YAGfxDynamicBitmap&>(texture));
                 m_textureMap.setOffsetX(0);
                 m_textureMap.setOffsetY(0);
                 m_textureMap.setWidth(frameWidth);
@@ -191,6 +194,27 @@ bool SpriteSheet::load(FS& fs, const String& spriteSheetFileName, const String&
             }
         }
     }
+    else
+    {
+        /* A native texture image may contain the sprite sheet information. */
+        ImageCache::Handle      texture;
+        NativeImg::SpriteInfo   spriteInfo;
+
+        if ((BmpImgLoader::RET_OK == ImageCache::getInstance().load(fs, textureFileName, texture)) &&
+            (true == texture.getSpriteInfo(spriteInfo)) &&
+            (0U < spriteInfo.fps))
+        {
+            m_repeat    = spriteInfo.isRepeated;
+            m_isForward = true;
+
+            isSuccessful = loadTexture( fs,
+                                        textureFileName,
+                                        spriteInfo.frameWidth,
+                                        spriteInfo.frameHeight,
+                                        spriteInfo.frameCnt,
+                                        spriteInfo.fps);
+        }
+    }
 
     return isSuccessful;
 }
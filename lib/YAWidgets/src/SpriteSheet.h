@@ -48,6 +48,8 @@
 #include <YAGfxBitmap.h>
 #include <FS.h>
 
+#include "ImageCache.h"
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -65,6 +67,9 @@
  * 
  * The order of the sprites shall follow in x-direction from 0 to N and
  * continue in the next y row and so on.
+ *
+ * The texture image is shared via the image cache. Copies of a sprite sheet
+ * share the texture too.
  */
 class SpriteSheet
 {
@@ -75,7 +80,7 @@ public:
      */
     SpriteSheet() :
         m_texture(),
-        m_textureMap(m_texture),
+        m_textureMap(),
         m_frame(m_textureMap),
         m_frameCnt(0U),
         m_fps(DEFAULT_FPS),
@@ -96,7 +101,7 @@ public:
     SpriteSheet(const SpriteSheet& spriteSheet) :
         m_texture(spriteSheet.m_texture),
         m_textureMap(spriteSheet.m_textureMap),
-        m_frame(spriteSheet.m_frame),
+        m_frame(m_textureMap),
         m_frameCnt(spriteSheet.m_frameCnt),
         m_fps(spriteSheet.m_fps),
         m_repeat(spriteSheet.m_repeat),
@@ -117,8 +122,6 @@ public:
 
     /**
      * Assgins a sprite sheet.
-     * Note, the referenced bitmap image won't be assigned! You have to do this
-     * separately.
      * 
      * @param[in] spriteSheet   The sprite sheet, which to copy from.
      * 
@@ -241,6 +244,9 @@ public:
      * 
      * The animation direction will be reset to forward.
      * 
+     * If the sprite sheet file is not available, the sprite sheet information
+     * stored together with a native texture image is used.
+     * 
      * @param[in] fs                    The filesystem
      * @param[in] spriteSheetFileName   Name of the sprite sheet file in the filesystem
      * @param[in] textureFileName       Name of the texture image file in the filesystem
@@ -263,7 +269,7 @@ public:
     void reset();
 
     /**
-     * Release the internal pixel buffer with texture.
+     * Release the texture.
      */
     void release()
     {
@@ -277,7 +283,7 @@ public:
      */
     bool isEmpty() const
     {
-        return !m_texture.isAllocated();
+        return m_texture.isEmpty();
     }
 
 private:
@@ -287,7 +293,7 @@ private:
      */
     static const uint8_t    DEFAULT_FPS = 12U;
 
-    YAGfxDynamicBitmap  m_texture;          /**< Texture image. */
+    ImageCache::Handle  m_texture;          /**< Texture image, shared via the image cache. */
     YAGfxMap            m_textureMap;       /**< Map canvas over the texture image. */
     YAGfxOverlayBitmap  m_frame;            /**< The current frame. */
     uint8_t             m_frameCnt;         /**< Number of frames in the texture. */
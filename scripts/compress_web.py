@@ -0,0 +1,174 @@
+"""Compresses the static web files (.html, .js, .css) with gzip, used during build process.
+
+The web server delivers a compressed file (e.g. "/js/menu.js.gz") with the
+gzip content encoding, if the requested file itself is not available. HTML pages
+with template keywords (~KEYWORD~) are not compressed, because the keywords are
+replaced on the target, while the page is sent.
+
+Used as PlatformIO extra script, the files of the filesystem image are
+compressed in a staging directory, before the filesystem image is built. The
+files in the data directory are not modified.
+
+Used standalone:
+    python compress_web.py <directory>
+"""
+
+# MIT License
+#
+# Copyright (c) 2019 - 2023 Andreas Merkle (web@blue-andi.de)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+################################################################################
+# Imports
+################################################################################
+import argparse
+import gzip
+import os
+import re
+import shutil
+import sys
+
+################################################################################
+# Variables
+################################################################################
+
+# File extensions of the files, which shall be compressed.
+EXTENSIONS = [".html", ".js", ".css"]
+
+# Directories (relative to the data directory), which are skipped.
+# The captive portal page is delivered with template processing and the
+# configuration files are read by the firmware.
+SKIPPED_DIRS = ["cp", "configuration"]
+
+# Template keyword, which is replaced on the target.
+KEYWORD_PATTERN = re.compile(rb"~[A-Za-z0-9_]{1,32}~")
+
+# Filesystem image targets, which require the compression.
+FS_TARGETS = ["buildfs", "uploadfs", "uploadfsota"]
+
+################################################################################
+# Classes
+################################################################################
+
+################################################################################
+# Functions
+################################################################################
+
+def is_compressible(file_name):
+    """Checks whether a file shall be compressed.
+
+    Args:
+        file_name (str): Name of the file
+
+    Returns:
+        bool: If the file shall be compressed, it will return True otherwise False.
+    """
+    is_compressible_file = False
+
+    if os.path.splitext(file_name)[1].lower() in EXTENSIONS:
+        is_compressible_file = True
+
+        if file_name.lower().endswith(".html"):
+            with open(file_name, "rb") as input_file:
+                if KEYWORD_PATTERN.search(input_file.read()) is not None:
+                    is_compressible_file = False
+
+    return is_compressible_file
+
+def compress(file_name):
+    """Compress a file with gzip and remove the original file.
+
+    Args:
+        file_name (str): Name of the file
+
+    Returns:
+        int: Number of saved bytes
+    """
+    original_size = os.path.getsize(file_name)
+
+    with open(file_name, "rb") as input_file:
+        # The modification timestamp is fixed to get reproducible filesystem images.
+        with gzip.GzipFile(file_name + ".gz", "wb", 9, None, 0) as output_file:
+            shutil.copyfileobj(input_file, output_file)
+
+    os.remove(file_name)
+
+    return original_size - os.path.getsize(file_name + ".gz")
+
+def compress_dir(data_dir):
+    """Compress all static web files in the directory.
+
+    Args:
+        data_dir (str): Directory
+
+    Returns:
+        int: Number of saved bytes
+    """
+    saved = 0
+
+    for root, dirs, files in os.walk(data_dir):
+        if os.path.samefile(root, data_dir):
+            dirs[:] = [dir_name for dir_name in dirs if dir_name not in SKIPPED_DIRS]
+
+        for file_name in files:
+            full_path = os.path.join(root, file_name)
+
+            if is_compressible(full_path) is True:
+                saved += compress(full_path)
+
+    return saved
+
+def main():
+    """Main entry point for standalone usage.
+
+    Returns:
+        int: Exit code
+    """
+    parser = argparse.ArgumentParser(description="Compress the static web files in a directory with gzip.")
+    parser.add_argument("directory", help="Directory, e.g. a copy of the data directory")
+    args = parser.parse_args()
+
+    print("Saved bytes: " + str(compress_dir(args.directory)))
+
+    return 0
+
+################################################################################
+# Main
+################################################################################
+
+if __name__ == "__main__":
+    sys.exit(main())
+else:
+    # pylint: disable=undefined-variable
+    Import("env") # type: ignore
+
+    if any(target in FS_TARGETS for target in COMMAND_LINE_TARGETS): # type: ignore
+        DATA_DIR = env.subst("$PROJECT_DATA_DIR") # type: ignore
+        STAGING_DIR = os.path.join(env.subst("$BUILD_DIR"), "data") # type: ignore
+
+        # The data directory may already be staged by a previous script.
+        if os.path.normpath(DATA_DIR) != os.path.normpath(STAGING_DIR):
+            if os.path.isdir(STAGING_DIR):
+                shutil.rmtree(STAGING_DIR)
+
+            shutil.copytree(DATA_DIR, STAGING_DIR)
+            env.Replace(PROJECT_DATA_DIR=STAGING_DIR) # type: ignore
+
+        print("Web files compressed in: " + STAGING_DIR + " (" + str(compress_dir(STAGING_DIR)) + " bytes saved)")
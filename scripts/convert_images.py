@@ -0,0 +1,496 @@
+"""Converts bitmap images (.bmp) to the native image format, used during build process.
+
+The native image format is described in lib/YAWidgets/src/NativeImg.h.
+If a sprite sheet file (.sprite) with the same name exists, its information is
+stored together with the texture image.
+
+Used as PlatformIO extra script, the images of the filesystem image are
+converted in a staging directory, before the filesystem image is built. The
+native image replaces its bitmap image and has the file extension .pxim. The
+firmware still addresses the image by its bitmap image name and prefers the
+native image. The files in the data directory are not modified.
+
+Used standalone:
+    python convert_images.py <input.bmp> <output> [--sprite <input.sprite>]
+"""
+
+# MIT License
+#
+# Copyright (c) 2019 - 2023 Andreas Merkle (web@blue-andi.de)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+################################################################################
+# Imports
+################################################################################
+import argparse
+import json
+import os
+import shutil
+import struct
+import sys
+
+################################################################################
+# Variables
+################################################################################
+
+SIGNATURE = b"PXIM"
+FILE_EXTENSION = ".pxim"
+VERSION = 1
+FLAG_SPRITE_INFO = 0x01
+RLE_RUN_FLAG = 0x80
+RLE_PACKET_MAX_VALUES = 128
+PALETTE_MAX = 256
+
+ENCODING_RGB = 0
+ENCODING_PALETTE = 1
+ENCODING_RLE_RGB = 2
+ENCODING_RLE_PALETTE = 3
+
+# Filesystem image targets, which require the conversion.
+FS_TARGETS = ["buildfs", "uploadfs", "uploadfsota"]
+
+################################################################################
+# Classes
+################################################################################
+
+################################################################################
+# Functions
+################################################################################
+
+def load_palette(data, bpp):
+    """Load the color palette of a bitmap image, which follows the DIB header.
+
+    Args:
+        data (bytes): Bitmap image file content
+        bpp (int): Bits per pixel
+
+    Returns:
+        list: Palette as RGB24 values
+    """
+    header_size, = struct.unpack_from("<I", data, 14)
+    palette_size, = struct.unpack_from("<I", data, 46)
+
+    if (palette_size == 0) or (palette_size > (1 << bpp)):
+        palette_size = 1 << bpp
+
+    palette = []
+
+    for idx in range(palette_size):
+        offset = 14 + header_size + idx * 4
+
+        if (offset + 3) <= len(data):
+            blue, green, red = data[offset], data[offset + 1], data[offset + 2]
+            palette.append((red << 16) | (green << 8) | blue)
+
+    return palette
+
+def decode_rle(data, offset, width, height, bpp):
+    """Decode RLE4 or RLE8 compressed pixel data to palette indices.
+    Pixels skipped by delta escapes have no palette index (None).
+
+    Args:
+        data (bytes): Bitmap image file content
+        offset (int): Offset of the pixel data
+        width (int): Image width in pixels
+        height (int): Image height in pixels
+        bpp (int): Bits per pixel, 4 for RLE4 and 8 for RLE8
+
+    Returns:
+        list: Palette indices per row, bottom row first
+    """
+    rows = [[None] * width for _ in range(height)]
+    x = 0
+    row = 0
+
+    def set_index(x, row, index):
+        if (x < width) and (row < height):
+            rows[row][x] = index
+
+    while (offset + 1) < len(data):
+        count, value = data[offset], data[offset + 1]
+        offset += 2
+
+        if count > 0:
+            for idx in range(count):
+                index = value
+
+                if bpp == 4:
+                    index = (value >> 4) if (idx % 2) == 0 else (value & 0x0F)
+
+                set_index(x, row, index)
+                x += 1
+        elif value == 0:
+            x = 0
+            row += 1
+        elif value == 1:
+            break
+        elif value == 2:
+            x += data[offset]
+            row += data[offset + 1]
+            offset += 2
+        else:
+            data_bytes = value if bpp == 8 else ((value + 1) // 2)
+
+            for idx in range(value):
+                if bpp == 8:
+                    index = data[offset + idx]
+                else:
+                    byte = data[offset + idx // 2]
+                    index = (byte >> 4) if (idx % 2) == 0 else (byte & 0x0F)
+
+                set_index(x, row, index)
+                x += 1
+
+            # Absolute mode is padded to a 16-bit boundary.
+            offset += data_bytes + (data_bytes % 2)
+
+    return rows
+
+def load_bmp(file_name):
+    """Load a bitmap image, which is one of
+    - uncompressed 1, 4 or 8 bpp with color palette,
+    - RLE4 or RLE8 compressed with color palette,
+    - uncompressed 24 bpp or 32 bpp (BGRA).
+
+    Args:
+        file_name (str): Name of the bitmap image file
+
+    Returns:
+        tuple: Width, height and list of RGB24 values in framebuffer order.
+            If the file is not supported, None is returned.
+    """
+    result = None
+
+    with open(file_name, "rb") as bmp_file:
+        data = bmp_file.read()
+
+    if (len(data) >= 54) and (data[0:2] == b"BM"):
+        pixel_offset = struct.unpack_from("<I", data, 10)[0]
+        width, height, _, bpp, compression = struct.unpack_from("<iiHHI", data, 18)
+        is_supported = ((compression == 0) and (bpp in [1, 4, 8, 24, 32])) or \
+                       ((compression == 1) and (bpp == 8) and (height > 0)) or \
+                       ((compression == 2) and (bpp == 4) and (height > 0))
+
+        if (width > 0) and (height != 0) and (is_supported is True):
+            is_bottom_up = height > 0
+            height = abs(height)
+            palette = load_palette(data, bpp) if bpp <= 8 else []
+            pixels = []
+
+            if compression != 0:
+                rows = decode_rle(data, pixel_offset, width, height, bpp)
+            else:
+                row_size = ((width * bpp + 31) // 32) * 4
+                rows = []
+
+                for row in range(height):
+                    row_data = data[pixel_offset + row * row_size:pixel_offset + (row + 1) * row_size]
+
+                    if bpp <= 8:
+                        # The most significant bits contain the left most pixel.
+                        mask = (1 << bpp) - 1
+                        rows.append([(row_data[(x * bpp) // 8] >> (8 - bpp - ((x * bpp) % 8))) & mask
+                                     for x in range(width)])
+                    else:
+                        bytes_per_pixel = bpp // 8
+                        rows.append([(row_data[x * bytes_per_pixel + 2] << 16) |
+                                     (row_data[x * bytes_per_pixel + 1] << 8) |
+                                     row_data[x * bytes_per_pixel]
+                                     for x in range(width)])
+
+            if is_bottom_up is True:
+                rows.reverse()
+
+            for row in rows:
+                for value in row:
+                    if bpp > 8:
+                        pixels.append(value)
+                    elif (value is not None) and (value < len(palette)):
+                        pixels.append(palette[value])
+                    else:
+                        # Skipped or invalid pixels are black, like the firmware does.
+                        pixels.append(0)
+
+            result = (width, height, pixels)
+
+    return result
+
+def load_sprite_info(file_name):
+    """Load the sprite sheet information from a sprite sheet file.
+
+    Args:
+        file_name (str): Name of the sprite sheet file
+
+    Returns:
+        tuple: Frame width, frame height, number of frames, fps and repeat flag.
+            If the file is invalid, None is returned.
+    """
+    result = None
+
+    try:
+        with open(file_name, encoding="utf-8") as json_file:
+            texture = json.load(json_file)["texture"]
+
+        result = (int(texture["frame"]["width"]),
+                  int(texture["frame"]["height"]),
+                  int(texture.get("frames", 0)),
+                  int(texture["fps"]),
+                  bool(texture.get("repeat", True)))
+    except (ValueError, KeyError, TypeError):
+        pass
+
+    return result
+
+def get_palette(pixels):
+    """Determine the palette of the pixels.
+
+    Args:
+        pixels (list): RGB24 values
+
+    Returns:
+        list: Palette as RGB24 values or None, if there are more than PALETTE_MAX colors.
+    """
+    palette = []
+    palette_index = {}
+
+    for rgb24 in pixels:
+        if rgb24 not in palette_index:
+            if len(palette) >= PALETTE_MAX:
+                return None
+
+            palette_index[rgb24] = len(palette)
+            palette.append(rgb24)
+
+    return palette
+
+def get_rle_packets(pixels):
+    """Split the pixels into RLE packets.
+
+    Args:
+        pixels (list): RGB24 values
+
+    Returns:
+        list: Packets as tuple of run flag and values.
+    """
+    packets = []
+    pixel_cnt = len(pixels)
+    idx = 0
+
+    while idx < pixel_cnt:
+        run_len = 1
+
+        while ((idx + run_len) < pixel_cnt) and \
+              (run_len < RLE_PACKET_MAX_VALUES) and \
+              (pixels[idx + run_len] == pixels[idx]):
+            run_len += 1
+
+        if run_len > 1:
+            packets.append((True, [pixels[idx]] * run_len))
+            idx += run_len
+        else:
+            # Collect literal values until the next run starts.
+            literal_len = 1
+
+            while ((idx + literal_len) < pixel_cnt) and \
+                  (literal_len < RLE_PACKET_MAX_VALUES) and \
+                  (((idx + literal_len + 1) >= pixel_cnt) or \
+                   (pixels[idx + literal_len] != pixels[idx + literal_len + 1])):
+                literal_len += 1
+
+            packets.append((False, pixels[idx:idx + literal_len]))
+            idx += literal_len
+
+    return packets
+
+def encode_value(rgb24, palette_index):
+    """Encode a single pixel value.
+
+    Args:
+        rgb24 (int): RGB24 value
+        palette_index (dict): Palette index by RGB24 value or None for RGB values.
+
+    Returns:
+        bytes: Encoded value
+    """
+    if palette_index is None:
+        value = bytes([(rgb24 >> 16) & 0xFF, (rgb24 >> 8) & 0xFF, rgb24 & 0xFF])
+    else:
+        value = bytes([palette_index[rgb24]])
+
+    return value
+
+def encode(width, height, pixels, sprite_info):
+    """Encode the image in the native image format with the smallest encoding.
+
+    Args:
+        width (int): Image width in pixels
+        height (int): Image height in pixels
+        pixels (list): RGB24 values in framebuffer order
+        sprite_info (tuple): Sprite sheet information or None
+
+    Returns:
+        bytes: Native image
+    """
+    palette = get_palette(pixels)
+    packets = get_rle_packets(pixels)
+    packet_cnt = len(packets)
+    value_cnt = sum(1 if is_run else len(values) for is_run, values in packets)
+    sizes = [3 * len(pixels), None, packet_cnt + 3 * value_cnt, None]
+
+    if palette is not None:
+        sizes[ENCODING_PALETTE] = 3 * len(palette) + len(pixels)
+        sizes[ENCODING_RLE_PALETTE] = 3 * len(palette) + packet_cnt + value_cnt
+
+    # The first smallest encoding is chosen, like the firmware does.
+    encoding = ENCODING_RGB
+
+    for idx, size in enumerate(sizes):
+        if (size is not None) and (size < sizes[encoding]):
+            encoding = idx
+
+    if encoding in [ENCODING_RGB, ENCODING_RLE_RGB]:
+        palette = []
+        palette_index = None
+    else:
+        palette_index = {rgb24: idx for idx, rgb24 in enumerate(palette)}
+
+    flags = FLAG_SPRITE_INFO if sprite_info is not None else 0
+    output = bytearray(struct.pack("<4sBBBBHHHH", SIGNATURE, VERSION, encoding, flags, 0,
+                                   width, height, len(palette), 0))
+
+    if sprite_info is not None:
+        frame_width, frame_height, frame_cnt, fps, repeat = sprite_info
+        output += struct.pack("<HHBBBB", frame_width, frame_height, frame_cnt, fps,
+                              1 if repeat else 0, 0)
+
+    for rgb24 in palette:
+        output += encode_value(rgb24, None)
+
+    if encoding in [ENCODING_RLE_RGB, ENCODING_RLE_PALETTE]:
+        for is_run, values in packets:
+            if is_run is True:
+                output.append(RLE_RUN_FLAG | (len(values) - 1))
+                output += encode_value(values[0], palette_index)
+            else:
+                output.append(len(values) - 1)
+
+                for rgb24 in values:
+                    output += encode_value(rgb24, palette_index)
+    else:
+        for rgb24 in pixels:
+            output += encode_value(rgb24, palette_index)
+
+    return bytes(output)
+
+def convert(bmp_file_name, output_file_name, sprite_file_name=None):
+    """Convert a bitmap image to the native image format.
+
+    Args:
+        bmp_file_name (str): Name of the bitmap image file
+        output_file_name (str): Name of the native image file
+        sprite_file_name (str): Name of the sprite sheet file or None
+
+    Returns:
+        bool: If successful, it will return True otherwise False.
+    """
+    is_successful = False
+    image = load_bmp(bmp_file_name)
+    sprite_info = None
+
+    if sprite_file_name is not None:
+        sprite_info = load_sprite_info(sprite_file_name)
+
+    if image is not None:
+        width, height, pixels = image
+
+        with open(output_file_name, "wb") as output_file:
+            output_file.write(encode(width, height, pixels, sprite_info))
+
+        is_successful = True
+
+    return is_successful
+
+def stage_data_dir(data_dir, staging_dir):
+    """Copy the data directory to the staging directory and replace every
+    bitmap image there by its native image. A bitmap image, which can not be
+    converted, is kept.
+
+    Args:
+        data_dir (str): Data directory
+        staging_dir (str): Staging directory
+    """
+    if os.path.isdir(staging_dir):
+        shutil.rmtree(staging_dir)
+
+    shutil.copytree(data_dir, staging_dir)
+
+    for root, _, files in os.walk(staging_dir):
+        for file_name in files:
+            if file_name.lower().endswith(".bmp"):
+                bmp_file_name = os.path.join(root, file_name)
+                sprite_file_name = os.path.splitext(bmp_file_name)[0] + ".sprite"
+
+                if os.path.isfile(sprite_file_name) is False:
+                    sprite_file_name = None
+
+                native_file_name = os.path.splitext(bmp_file_name)[0] + FILE_EXTENSION
+
+                if convert(bmp_file_name, native_file_name, sprite_file_name) is True:
+                    os.remove(bmp_file_name)
+                else:
+                    print("Image not converted: " + bmp_file_name)
+
+def main():
+    """Main entry point for standalone usage.
+
+    Returns:
+        int: Exit code
+    """
+    parser = argparse.ArgumentParser(description="Convert a bitmap image to the native image format.")
+    parser.add_argument("input", help="Bitmap image file (.bmp)")
+    parser.add_argument("output", help="Native image file")
+    parser.add_argument("--sprite", default=None, help="Sprite sheet file (.sprite)")
+    args = parser.parse_args()
+    exit_code = 0
+
+    if convert(args.input, args.output, args.sprite) is False:
+        print("Unsupported bitmap image: " + args.input)
+        exit_code = 1
+
+    return exit_code
+
+################################################################################
+# Main
+################################################################################
+
+if __name__ == "__main__":
+    sys.exit(main())
+else:
+    # pylint: disable=undefined-variable
+    Import("env") # type: ignore
+
+    if any(target in FS_TARGETS for target in COMMAND_LINE_TARGETS): # type: ignore
+        DATA_DIR = env.subst("$PROJECT_DATA_DIR") # type: ignore
+        STAGING_DIR = os.path.join(env.subst("$BUILD_DIR"), "data") # type: ignore
+
+        stage_data_dir(DATA_DIR, STAGING_DIR)
+        env.Replace(PROJECT_DATA_DIR=STAGING_DIR) # type: ignore
+
+        print("Images converted to    : " + STAGING_DIR)
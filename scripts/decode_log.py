@@ -0,0 +1,366 @@
+"""Decodes binary log messages, which are sent by the firmware in binary log mode.
+
+In binary log mode (CONFIG_LOG_BINARY=1) the firmware doesn't format the log
+messages. It sends only the address of the call site, the address of the
+format string and the raw arguments. This script resolves the addresses with
+the firmware ELF file and formats the log messages on the host.
+
+Frame layout (little endian):
+    sync (0xA5), length of the following data (u8),
+    timestamp (u32), call site address (u32), format string address (u32),
+    arguments.
+
+If the format string address is 0, the format string is sent inline as first
+argument. A string argument is sent as length (u8) followed by its characters.
+The call site is a struct with the filename address, the line number and the
+log level, see lib/Utilities/src/Logging.h.
+
+Log sinks, which don't support binary data, send the frame in hex as message
+of a text log line with the filename "BINLOG". Such lines are decoded too,
+all other lines are printed unchanged.
+
+Used standalone:
+    python decode_log.py <firmware.elf> <log file> [--hex]
+    python decode_log.py <firmware.elf> - --hex < serial.log
+"""
+
+# MIT License
+#
+# Copyright (c) 2019 - 2023 Andreas Merkle (web@blue-andi.de)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+################################################################################
+# Imports
+################################################################################
+import argparse
+import os
+import re
+import struct
+import sys
+
+################################################################################
+# Variables
+################################################################################
+
+FRAME_SYNC = 0xA5
+FRAME_HEADER_SIZE = 14
+SITE_SIZE = 12
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+LOG_LEVELS = ["FATAL", "ERROR", "WARNING", "INFO", "DEBUG", "TRACE"]
+
+FORMAT_SPEC_PATTERN = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaAp%])")
+HEX_LINE_PATTERN = re.compile(r"BINLOG:\s*\d+\s+([0-9A-F]+)\s*$")
+
+################################################################################
+# Classes
+################################################################################
+
+class ElfImage:
+    """Provides read access to the allocated sections of a 32-bit ELF file.
+    """
+
+    def __init__(self, file_name):
+        """Loads all allocated sections with content of the ELF file.
+
+        Args:
+            file_name (str): ELF file name
+        """
+        self._sections = []
+
+        with open(file_name, "rb") as fd:
+            data = fd.read()
+
+        if (data[0:4] != b"\x7fELF") or (data[4] != 1):
+            raise ValueError(f"{file_name} is not a 32-bit ELF file.")
+
+        sh_off, = struct.unpack_from("<I", data, 0x20)
+        sh_ent_size, sh_num = struct.unpack_from("<HH", data, 0x2E)
+
+        for idx in range(sh_num):
+            _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = \
+                struct.unpack_from("<IIIIII", data, sh_off + idx * sh_ent_size)
+
+            if (sh_type == SHT_PROGBITS) and ((sh_flags & SHF_ALLOC) != 0) and (sh_addr != 0):
+                self._sections.append((sh_addr, data[sh_offset:sh_offset + sh_size]))
+
+    def read(self, address, size):
+        """Reads data from the image.
+
+        Args:
+            address (int): Address
+            size (int): Number of bytes
+
+        Returns:
+            bytes: Data or None if the address is not part of the image.
+        """
+        result = None
+
+        for section_addr, section_data in self._sections:
+            if (section_addr <= address) and ((address + size) <= (section_addr + len(section_data))):
+                offset = address - section_addr
+                result = section_data[offset:offset + size]
+
+        return result
+
+    def read_string(self, address):
+        """Reads a null terminated string from the image.
+
+        Args:
+            address (int): Address
+
+        Returns:
+            str: String or None if the address is not part of the image.
+        """
+        result = None
+
+        for section_addr, section_data in self._sections:
+            if section_addr <= address < (section_addr + len(section_data)):
+                offset = address - section_addr
+                end = section_data.find(b"\x00", offset)
+
+                if end < 0:
+                    end = len(section_data)
+
+                result = section_data[offset:end].decode("utf-8", errors="replace")
+
+        return result
+
+class ArgReader:
+    """Reads the encoded arguments of a binary log message.
+    """
+
+    def __init__(self, data):
+        """Initializes the reader.
+
+        Args:
+            data (bytes): Encoded arguments
+        """
+        self._data = data
+        self._pos = 0
+
+    def read_int(self, size, signed):
+        """Reads an integer argument.
+
+        Args:
+            size (int): Size in bytes (4 or 8)
+            signed (bool): True for signed integers
+
+        Returns:
+            int: Value
+        """
+        value = int.from_bytes(self._read(size), "little", signed=signed)
+        return value
+
+    def read_double(self):
+        """Reads a floating point argument.
+
+        Returns:
+            float: Value
+        """
+        value, = struct.unpack("<d", self._read(8))
+        return value
+
+    def read_string(self):
+        """Reads a string argument.
+
+        Returns:
+            str: Value
+        """
+        length = self._read(1)[0]
+        return self._read(length).decode("utf-8", errors="replace")
+
+    def _read(self, size):
+        if len(self._data) < (self._pos + size):
+            raise ValueError("Argument data too short.")
+
+        data = self._data[self._pos:self._pos + size]
+        self._pos += size
+
+        return data
+
+################################################################################
+# Functions
+################################################################################
+
+def format_message(fmt, reader):
+    """Formats a log message with the printf like format string.
+
+    Args:
+        fmt (str): Format string
+        reader (ArgReader): Encoded arguments
+
+    Returns:
+        str: Log message
+    """
+    def replace(match):
+        flags, width, precision, length, conversion = match.groups()
+        spec = "%" + flags
+        result = ""
+
+        if conversion == "%":
+            result = "%"
+        else:
+            if width == "*":
+                width = str(reader.read_int(4, True))
+            if precision == "*":
+                precision = str(reader.read_int(4, True))
+
+            spec += width if width is not None else ""
+            spec += ("." + precision) if precision is not None else ""
+
+            int_size = 8 if length in ("ll", "j") else 4
+
+            if conversion in "di":
+                result = (spec + "d") % reader.read_int(int_size, True)
+            elif conversion in "ouxX":
+                result = (spec + conversion.replace("u", "d")) % reader.read_int(int_size, False)
+            elif conversion == "c":
+                result = (spec + "c") % chr(reader.read_int(4, False) & 0xFF)
+            elif conversion == "s":
+                result = (spec + "s") % reader.read_string()
+            elif conversion == "p":
+                result = (spec + "s") % f"0x{reader.read_int(4, False):x}"
+            elif conversion in "aA":
+                result = reader.read_double().hex()
+            else:
+                result = (spec + conversion) % reader.read_double()
+
+        return result
+
+    return FORMAT_SPEC_PATTERN.sub(replace, fmt)
+
+def decode_frame(elf, frame):
+    """Decodes a single binary log message frame.
+
+    Args:
+        elf (ElfImage): Firmware image
+        frame (bytes): Frame, starting with the sync byte
+
+    Returns:
+        str: Formatted log line
+    """
+    timestamp, site_addr, format_addr = struct.unpack_from("<III", frame, 2)
+    reader = ArgReader(frame[FRAME_HEADER_SIZE:])
+    site = elf.read(site_addr, SITE_SIZE)
+    file_name = "?"
+    line = 0
+    level = "?"
+
+    if site is not None:
+        file_addr, line, level_idx = struct.unpack("<Iii", site)
+        file_name = os.path.basename(elf.read_string(file_addr) or "?")
+        level = LOG_LEVELS[level_idx] if 0 <= level_idx < len(LOG_LEVELS) else "?"
+
+    if format_addr == 0:
+        fmt = reader.read_string()
+    else:
+        fmt = elf.read_string(format_addr)
+
+    if fmt is None:
+        message = f"<unknown format string 0x{format_addr:08x}>"
+    else:
+        try:
+            message = format_message(fmt, reader)
+        except (ValueError, TypeError) as exc:
+            message = f"{fmt} <{exc}>"
+
+    return f"{timestamp:>7} {level:<7} {file_name}:{line} {message}"
+
+def decode_binary(elf, data, out):
+    """Decodes a binary log stream.
+
+    Args:
+        elf (ElfImage): Firmware image
+        data (bytes): Binary log stream
+        out (file): Output
+    """
+    pos = 0
+
+    while (pos + FRAME_HEADER_SIZE) <= len(data):
+        frame_end = pos + 2 + data[pos + 1]
+
+        if (data[pos] != FRAME_SYNC) or (len(data) < frame_end) or (frame_end < (pos + FRAME_HEADER_SIZE)):
+            # Resynchronize
+            pos += 1
+        else:
+            out.write(decode_frame(elf, data[pos:frame_end]) + "\n")
+            pos = frame_end
+
+def decode_hex(elf, lines, out):
+    """Decodes text log lines, which contain frames in hex.
+
+    Args:
+        elf (ElfImage): Firmware image
+        lines (iterable): Log lines
+        out (file): Output
+    """
+    for line in lines:
+        match = HEX_LINE_PATTERN.search(line)
+
+        if match is None:
+            out.write(line if line.endswith("\n") else line + "\n")
+        else:
+            frame = bytes.fromhex(match.group(1))
+
+            if (FRAME_HEADER_SIZE <= len(frame)) and (frame[0] == FRAME_SYNC):
+                out.write(decode_frame(elf, frame) + "\n")
+            else:
+                out.write(line if line.endswith("\n") else line + "\n")
+
+def main():
+    """Main function.
+
+    Returns:
+        int: Program exit code
+    """
+    parser = argparse.ArgumentParser(description="Decodes binary log messages.")
+    parser.add_argument("elf", help="Firmware ELF file, which sent the log messages.")
+    parser.add_argument("log", help="Log file or - for stdin.")
+    parser.add_argument("--hex", action="store_true", help="Log is text, with frames in hex (BINLOG lines).")
+    args = parser.parse_args()
+
+    elf = ElfImage(args.elf)
+
+    if args.hex is True:
+        if args.log == "-":
+            decode_hex(elf, sys.stdin, sys.stdout)
+        else:
+            with open(args.log, "r", encoding="utf-8", errors="replace") as fd:
+                decode_hex(elf, fd, sys.stdout)
+    else:
+        if args.log == "-":
+            data = sys.stdin.buffer.read()
+        else:
+            with open(args.log, "rb") as fd:
+                data = fd.read()
+
+        decode_binary(elf, data, sys.stdout)
+
+    return 0
+
+################################################################################
+# Main
+################################################################################
+
+if __name__ == "__main__":
+    sys.exit(main())
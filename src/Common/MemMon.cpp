@@ -35,6 +35,8 @@
 #include "MemMon.h"
 
 #include <Logging.h>
+#include <Util.h>
+#include <esp_heap_caps.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -96,6 +98,13 @@ void MemMon::process()
             LOG_WARNING("Largest heap block which can be allocated: %u byte.", largestHeapBlock);
         }
 
+        if ((false == m_historyTimer.isTimerRunning()) ||
+            (true == m_historyTimer.isTimeout()))
+        {
+            addSample(availableHeap, largestHeapBlock);
+            m_historyTimer.start(HISTORY_PERIOD);
+        }
+
         /* Any heap corrupt? */
         if (false == heap_caps_check_integrity_all(true))
         {
@@ -104,6 +113,30 @@ void MemMon::process()
     }
 }
 
+void MemMon::getSampleRange(uint32_t& first, uint32_t& count)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    count = (HISTORY_SIZE < m_sampleSeq) ? HISTORY_SIZE : m_sampleSeq;
+    first = m_sampleSeq - count;
+}
+
+bool MemMon::getSample(uint32_t seq, Sample& sample)
+{
+    bool                        isAvailable = false;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Only samples, which are not overwritten yet. */
+    if ((seq < m_sampleSeq) &&
+        ((m_sampleSeq - seq) <= HISTORY_SIZE))
+    {
+        sample      = m_history[seq % HISTORY_SIZE];
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -112,6 +145,46 @@ void MemMon::process()
  * Private Methods
  *****************************************************************************/
 
+MemMon::MemMon() :
+    m_mutex(),
+    m_timer(),
+    m_historyTimer(),
+    m_history(),
+    m_sampleSeq(0U),
+    m_failedAllocCount(0U),
+    m_lastFailedAllocSize(0U)
+{
+    (void)m_mutex.create();
+
+    if (ESP_OK != heap_caps_register_failed_alloc_callback(onAllocFailed))
+    {
+        LOG_WARNING("Failed heap allocations are not monitored.");
+    }
+}
+
+void MemMon::addSample(uint32_t availableHeap, uint32_t largestHeapBlock)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    Sample&                     current = m_history[m_sampleSeq % HISTORY_SIZE];
+
+    current.uptime          = millis() / 1000U;
+    current.freeHeap        = availableHeap;
+    current.largestBlock    = largestHeapBlock;
+
+    ++m_sampleSeq;
+}
+
+void MemMon::onAllocFailed(size_t size, uint32_t caps, const char* functionName)
+{
+    MemMon& memMon = getInstance();
+
+    UTIL_NOT_USED(caps);
+    UTIL_NOT_USED(functionName);
+
+    memMon.m_failedAllocCount.fetch_add(1U);
+    memMon.m_lastFailedAllocSize.store(size);
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
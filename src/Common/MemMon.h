@@ -40,12 +40,22 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Number of heap samples, which are kept in the history.
+ * With the history period of 1 h, the default keeps the last week.
+ */
+#ifndef CONFIG_MEM_MON_HISTORY_SIZE
+#define CONFIG_MEM_MON_HISTORY_SIZE (168U)
+#endif  /* CONFIG_MEM_MON_HISTORY_SIZE */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <SysMsgPlugin.h>
 #include <WString.h>
+#include <Mutex.hpp>
+#include <atomic>
 
 /******************************************************************************
  * Macros
@@ -74,14 +84,91 @@ public:
         return instance;
     }
 
+    /**
+     * A single heap sample.
+     */
+    struct Sample
+    {
+        uint32_t    uptime;         /**< Uptime in s */
+        uint32_t    freeHeap;       /**< Available heap in byte */
+        uint32_t    largestBlock;   /**< Largest block of heap, which can be allocated at once in byte */
+    };
+
     /**
      * Process memory monitor.
      */
     void process();
 
+    /**
+     * Get the range of the available samples. Every sample has a sequence
+     * number, which increases continuously.
+     *
+     * @param[out]  first   Sequence number of the oldest available sample
+     * @param[out]  count   Number of available samples
+     */
+    void getSampleRange(uint32_t& first, uint32_t& count);
+
+    /**
+     * Get a sample from the history.
+     *
+     * @param[in]   seq     Sequence number of the sample
+     * @param[out]  sample  Sample
+     *
+     * @return If the sample is available, it will return true otherwise false.
+     */
+    bool getSample(uint32_t seq, Sample& sample);
+
+    /**
+     * Get number of failed heap allocations since boot.
+     *
+     * @return Number of failed heap allocations
+     */
+    uint32_t getFailedAllocCount() const
+    {
+        return m_failedAllocCount.load();
+    }
+
+    /**
+     * Get the requested size of the last failed heap allocation.
+     *
+     * @return Size in byte
+     */
+    size_t getLastFailedAllocSize() const
+    {
+        return m_lastFailedAllocSize.load();
+    }
+
+    /**
+     * Calculate the heap fragmentation. A fragmentation of 0% means that
+     * the whole available heap can be allocated at once.
+     *
+     * @param[in] freeHeap      Available heap in byte
+     * @param[in] largestBlock  Largest block of heap, which can be allocated at once in byte
+     *
+     * @return Fragmentation in percent
+     */
+    static uint8_t calcFragmentation(uint32_t freeHeap, uint32_t largestBlock)
+    {
+        uint8_t fragmentation = 0U;
+
+        if ((0U < freeHeap) &&
+            (largestBlock < freeHeap))
+        {
+            fragmentation = static_cast<uint8_t>(100U - ((static_cast<uint64_t>(largestBlock) * 100U) / freeHeap));
+        }
+
+        return fragmentation;
+    }
+
     /** Processing cycle in ms. */
     static const uint32_t   PROCESSING_CYCLE            = 60U * 1000U;
 
+    /** Heap history period in ms. */
+    static const uint32_t   HISTORY_PERIOD              = 60U * 60U * 1000U;
+
+    /** Number of heap samples in the history. */
+    static const uint32_t   HISTORY_SIZE                = CONFIG_MEM_MON_HISTORY_SIZE;
+
     /**
      * Minimum size of current heap memory in bytes, the monitor starts to warn.
      * See https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/protocols/mbedtls.html#performance-and-memory-tweaks
@@ -101,14 +188,18 @@ public:
 
 private:
 
-    SimpleTimer m_timer;    /**< Timer used for cyclic processing. */
+    MutexRecursive          m_mutex;                 /**< Protects the history against concurrent access. */
+    SimpleTimer             m_timer;                 /**< Timer used for cyclic processing. */
+    SimpleTimer             m_historyTimer;          /**< Timer used for the heap history. */
+    Sample                  m_history[HISTORY_SIZE]; /**< Heap history */
+    uint32_t                m_sampleSeq;             /**< Sequence number of the next sample */
+    std::atomic<uint32_t>   m_failedAllocCount;      /**< Number of failed heap allocations */
+    std::atomic<size_t>     m_lastFailedAllocSize;   /**< Requested size of the last failed heap allocation in byte */
 
     /**
      * Constructs the memory monitor.
      */
-    MemMon()
-    {
-    }
+    MemMon();
 
     /**
      * Destroys the memory monitor.
@@ -120,6 +211,24 @@ private:
 
     MemMon(const MemMon& taskMon);
     MemMon& operator=(const MemMon& taskMon);
+
+    /**
+     * Add a heap sample to the history.
+     *
+     * @param[in] availableHeap     Available heap in byte
+     * @param[in] largestHeapBlock  Largest block of heap, which can be allocated at once in byte
+     */
+    void addSample(uint32_t availableHeap, uint32_t largestHeapBlock);
+
+    /**
+     * Called by the heap allocator in case an allocation failed.
+     * It may be called from any task, therefore no logging here.
+     *
+     * @param[in] size          Requested size in byte
+     * @param[in] caps          Requested memory capabilities
+     * @param[in] functionName  Name of the allocation function
+     */
+    static void onAllocFailed(size_t size, uint32_t caps, const char* functionName);
 };
 
 /******************************************************************************
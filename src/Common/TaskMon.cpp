@@ -35,6 +35,7 @@
 #include "TaskMon.h"
 
 #include <Logging.h>
+#include <Util.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -62,6 +63,23 @@
 
 void TaskMon::process()
 {
+#if (0 != TASK_MON_LOAD_SAMPLING)
+    if (false == m_sampleTimer.isTimerRunning())
+    {
+        m_sampleTimer.start(SAMPLE_PERIOD);
+        sample();
+    }
+    else if (true == m_sampleTimer.isTimeout())
+    {
+        m_sampleTimer.restart();
+        sample();
+    }
+    else
+    {
+        ;
+    }
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+
 #if configUSE_TRACE_FACILITY
     bool isProcessingTime = false;
 
@@ -94,7 +112,7 @@ void TaskMon::process()
             for(index = 0U; index < numOfTasks; ++index)
             {
                 size_t taskNameLen  = strlen(taskStatus[index].pcTaskName);
-                size_t taskStateLen = taskState2Str(taskStatus[index].eCurrentState).length();
+                size_t taskStateLen = strlen(taskState2Str(taskStatus[index].eCurrentState));
 
                 if (taskNameMaxLen < taskNameLen)
                 {
@@ -125,14 +143,14 @@ void TaskMon::process()
                     fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
                     taskStatus[index].xCoreID,
                     taskStatus[index].uxCurrentPriority,
-                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
+                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState), taskStateMaxLen).c_str(),
                     statsAsPercentage,
                     taskStatus[index].usStackHighWaterMark);
     #else
                 LOG_DEBUG("Task \"%s\": p %2u, %s, %3u%%, stack high water mark: %u",
                     fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
                     taskStatus[index].uxCurrentPriority,
-                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
+                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState), taskStateMaxLen).c_str(),
                     statsAsPercentage,
                     taskStatus[index].usStackHighWaterMark);
 #endif
@@ -144,6 +162,264 @@ void TaskMon::process()
 #endif  /* configUSE_TRACE_FACILITY */
 }
 
+bool TaskMon::getTaskInfo(uint8_t slot, TaskInfo& info)
+{
+    bool isAvailable = false;
+
+#if (0 != TASK_MON_LOAD_SAMPLING)
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if ((MAX_TASKS > slot) &&
+        (true == m_slots[slot].isUsed))
+    {
+        const TaskSlot& taskSlot = m_slots[slot];
+
+        info.name               = taskSlot.name;
+        info.coreId             = taskSlot.coreId;
+        info.priority           = taskSlot.priority;
+        info.state              = taskState2Str(taskSlot.state);
+        info.stackHighWaterMark = taskSlot.stackHighWaterMark;
+        info.load               = 0U;
+
+        if (0U < m_sampleSeq)
+        {
+            info.load = m_history[(m_sampleSeq - 1U) % HISTORY_SIZE].taskLoad[slot];
+        }
+
+        isAvailable = true;
+    }
+#else   /* (0 != TASK_MON_LOAD_SAMPLING) */
+    UTIL_NOT_USED(slot);
+    UTIL_NOT_USED(info);
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+
+    return isAvailable;
+}
+
+void TaskMon::getSampleRange(uint32_t& first, uint32_t& count)
+{
+#if (0 != TASK_MON_LOAD_SAMPLING)
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    count = (HISTORY_SIZE < m_sampleSeq) ? HISTORY_SIZE : m_sampleSeq;
+    first = m_sampleSeq - count;
+#else   /* (0 != TASK_MON_LOAD_SAMPLING) */
+    first = 0U;
+    count = 0U;
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+}
+
+bool TaskMon::getSample(uint32_t seq, Sample& sample)
+{
+    bool isAvailable = false;
+
+#if (0 != TASK_MON_LOAD_SAMPLING)
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* Only samples, which are not overwritten yet. */
+    if ((seq < m_sampleSeq) &&
+        ((m_sampleSeq - seq) <= HISTORY_SIZE))
+    {
+        sample      = m_history[seq % HISTORY_SIZE];
+        isAvailable = true;
+    }
+#else   /* (0 != TASK_MON_LOAD_SAMPLING) */
+    UTIL_NOT_USED(seq);
+    UTIL_NOT_USED(sample);
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+
+    return isAvailable;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+TaskMon::TaskMon() :
+#if (0 != TASK_MON_LOAD_SAMPLING)
+    m_mutex(),
+    m_sampleTimer(),
+    m_slots(),
+    m_history(),
+    m_sampleSeq(0U),
+    m_lastTotalRunTime(0U),
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+    m_timer()
+{
+#if (0 != TASK_MON_LOAD_SAMPLING)
+    (void)m_mutex.create();
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+}
+
+#if (0 != TASK_MON_LOAD_SAMPLING)
+
+void TaskMon::sample()
+{
+    UBaseType_t     numOfTasks  = uxTaskGetNumberOfTasks();
+    TaskStatus_t*   taskStatus  = new(std::nothrow) TaskStatus_t[numOfTasks];
+
+    if (nullptr != taskStatus)
+    {
+        uint32_t                    totalRunTime    = 0U;
+        uint32_t                    deltaRunTime    = 0U;
+        UBaseType_t                 index           = 0U;
+        uint8_t                     slot            = 0U;
+        uint8_t                     core            = 0U;
+        uint8_t                     idleLoad[NUM_CORES];
+        TaskHandle_t                idleTasks[NUM_CORES];
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        Sample&                     current         = m_history[m_sampleSeq % HISTORY_SIZE];
+
+        numOfTasks      = uxTaskGetSystemState(taskStatus, numOfTasks, &totalRunTime);
+        deltaRunTime    = totalRunTime - m_lastTotalRunTime;
+
+        for(core = 0U; core < NUM_CORES; ++core)
+        {
+            idleLoad[core]  = 100U;
+            idleTasks[core] = xTaskGetIdleTaskHandleForCPU(core);
+        }
+
+        for(slot = 0U; slot < MAX_TASKS; ++slot)
+        {
+            m_slots[slot].isSeen    = false;
+            current.taskLoad[slot]  = 0U;
+        }
+
+        for(index = 0U; index < numOfTasks; ++index)
+        {
+            const TaskStatus_t& status      = taskStatus[index];
+            bool                isNewSlot   = false;
+
+            slot = getTaskSlot(status);
+
+            if (MAX_TASKS > slot)
+            {
+                TaskSlot&   taskSlot    = m_slots[slot];
+                uint32_t    load        = 0U;
+
+                /* The first sample of a task has no reference run time yet. */
+                isNewSlot = (false == taskSlot.isUsed);
+
+                if ((false == isNewSlot) &&
+                    (0U < deltaRunTime))
+                {
+                    uint64_t deltaTaskRunTime = status.ulRunTimeCounter - taskSlot.runTimeCounter;
+
+                    load = static_cast<uint32_t>((deltaTaskRunTime * 100U) / deltaRunTime);
+
+                    if (100U < load)
+                    {
+                        load = 100U;
+                    }
+                }
+
+                taskSlot.isUsed             = true;
+                taskSlot.isSeen             = true;
+                taskSlot.runTimeCounter     = status.ulRunTimeCounter;
+                taskSlot.priority           = status.uxCurrentPriority;
+                taskSlot.state              = status.eCurrentState;
+                taskSlot.stackHighWaterMark = status.usStackHighWaterMark;
+#if configTASKLIST_INCLUDE_COREID
+                taskSlot.coreId             = (NUM_CORES > status.xCoreID) ? status.xCoreID : -1;
+#else   /* configTASKLIST_INCLUDE_COREID */
+                taskSlot.coreId             = -1;
+#endif  /* configTASKLIST_INCLUDE_COREID */
+
+                current.taskLoad[slot] = static_cast<uint8_t>(load);
+
+                /* The core load is derived from its idle task. */
+                for(core = 0U; core < NUM_CORES; ++core)
+                {
+                    if ((false == isNewSlot) &&
+                        (idleTasks[core] == status.xHandle))
+                    {
+                        idleLoad[core] = static_cast<uint8_t>(load);
+                    }
+                }
+            }
+        }
+
+        /* Release the slots of deleted tasks. */
+        for(slot = 0U; slot < MAX_TASKS; ++slot)
+        {
+            if (false == m_slots[slot].isSeen)
+            {
+                m_slots[slot].isUsed = false;
+            }
+        }
+
+        for(core = 0U; core < NUM_CORES; ++core)
+        {
+            current.coreLoad[core] = 100U - idleLoad[core];
+        }
+
+        m_lastTotalRunTime = totalRunTime;
+        ++m_sampleSeq;
+
+        delete[] taskStatus;
+    }
+}
+
+uint8_t TaskMon::getTaskSlot(const TaskStatus_t& status)
+{
+    uint8_t slot        = 0U;
+    uint8_t freeSlot    = MAX_TASKS;
+    bool    isFound     = false;
+
+    while((MAX_TASKS > slot) && (false == isFound))
+    {
+        const TaskSlot& taskSlot = m_slots[slot];
+
+        /* A task handle may be reused by a new task, therefore the name is compared too. */
+        if ((true == taskSlot.isUsed) &&
+            (status.xHandle == taskSlot.handle) &&
+            (0 == strncmp(status.pcTaskName, taskSlot.name, sizeof(taskSlot.name))))
+        {
+            isFound = true;
+        }
+        else
+        {
+            if ((MAX_TASKS == freeSlot) &&
+                (false == taskSlot.isUsed) &&
+                (false == taskSlot.isSeen))
+            {
+                freeSlot = slot;
+            }
+
+            ++slot;
+        }
+    }
+
+    if (false == isFound)
+    {
+        slot = freeSlot;
+
+        if (MAX_TASKS > slot)
+        {
+            TaskSlot&   taskSlot    = m_slots[slot];
+            uint32_t    idx         = 0U;
+
+            taskSlot.handle = status.xHandle;
+            (void)strncpy(taskSlot.name, status.pcTaskName, sizeof(taskSlot.name) - 1U);
+            taskSlot.name[sizeof(taskSlot.name) - 1U] = '\0';
+
+            /* The history of a previous task in this slot is not valid anymore. */
+            for(idx = 0U; idx < HISTORY_SIZE; ++idx)
+            {
+                m_history[idx].taskLoad[slot] = 0U;
+            }
+        }
+    }
+
+    return slot;
+}
+
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+
 #if configUSE_TRACE_FACILITY
 
 const char* TaskMon::taskState2Str(eTaskState state)
@@ -204,14 +480,6 @@ String TaskMon::fillUpSpaces(const char* str, size_t len)
 
 #endif  /* configUSE_TRACE_FACILITY */
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
-
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
-
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -40,17 +40,43 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Number of CPU load samples, which are kept in the history.
+ * With the sample period of 1 s, the default keeps the last 10 minutes.
+ */
+#ifndef CONFIG_TASK_MON_HISTORY_SIZE
+#define CONFIG_TASK_MON_HISTORY_SIZE    (600U)
+#endif  /* CONFIG_TASK_MON_HISTORY_SIZE */
+
+/**
+ * Max. number of tasks, which CPU load is sampled.
+ */
+#ifndef CONFIG_TASK_MON_MAX_TASKS
+#define CONFIG_TASK_MON_MAX_TASKS       (24U)
+#endif  /* CONFIG_TASK_MON_MAX_TASKS */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <SysMsgPlugin.h>
 #include <WString.h>
+#include <Mutex.hpp>
 
 /******************************************************************************
  * Macros
  *****************************************************************************/
 
+/**
+ * The CPU load sampling requires the FreeRTOS trace facility and the run time
+ * statistics, see doc/CUSTOM-IDF-LIBRARIES.md.
+ */
+#if (configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS)
+#define TASK_MON_LOAD_SAMPLING          (1)
+#else
+#define TASK_MON_LOAD_SAMPLING          (0)
+#endif
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
@@ -74,24 +100,129 @@ public:
         return instance;
     }
 
+    /**
+     * Number of cores.
+     */
+    static const uint8_t    NUM_CORES           = portNUM_PROCESSORS;
+
+    /**
+     * Max. number of tasks, which CPU load is sampled.
+     */
+    static const uint8_t    MAX_TASKS           = CONFIG_TASK_MON_MAX_TASKS;
+
+    /**
+     * Number of CPU load samples in the history.
+     */
+    static const uint32_t   HISTORY_SIZE        = CONFIG_TASK_MON_HISTORY_SIZE;
+
+    /**
+     * A single CPU load sample. The load is relative to one core in percent.
+     */
+    struct Sample
+    {
+        uint8_t coreLoad[NUM_CORES];    /**< Load per core */
+        uint8_t taskLoad[MAX_TASKS];    /**< Load per task slot */
+    };
+
+    /**
+     * Information about a sampled task.
+     */
+    struct TaskInfo
+    {
+        String      name;               /**< Task name */
+        int32_t     coreId;             /**< Core affinity, -1 if the task may run on any core. */
+        uint32_t    priority;           /**< Current task priority */
+        const char* state;              /**< Task state as user friendly string */
+        uint32_t    stackHighWaterMark; /**< Min. amount of remaining stack space in byte */
+        uint8_t     load;               /**< Load of the latest sample in percent */
+    };
+
     /**
      * Get current number of tasks and their properties.
+     * The CPU load is sampled every sample period.
      */
     void process();
 
+    /**
+     * Is the CPU load sampling available? It depends on the FreeRTOS configuration.
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    bool isLoadAvailable() const
+    {
+        return (0 != TASK_MON_LOAD_SAMPLING);
+    }
+
+    /**
+     * Get information about the task in the given task slot.
+     *
+     * @param[in]   slot    Task slot [0; MAX_TASKS[
+     * @param[out]  info    Task information
+     *
+     * @return If a task is sampled in the slot, it will return true otherwise false.
+     */
+    bool getTaskInfo(uint8_t slot, TaskInfo& info);
+
+    /**
+     * Get the range of the available samples. Every sample has a sequence
+     * number, which increases continuously.
+     *
+     * @param[out]  first   Sequence number of the oldest available sample
+     * @param[out]  count   Number of available samples
+     */
+    void getSampleRange(uint32_t& first, uint32_t& count);
+
+    /**
+     * Get a sample from the history.
+     *
+     * @param[in]   seq     Sequence number of the sample
+     * @param[out]  sample  Sample
+     *
+     * @return If the sample is available, it will return true otherwise false.
+     */
+    bool getSample(uint32_t seq, Sample& sample);
+
     /** Processing cycle in ms. */
     static const uint32_t PROCESSING_CYCLE  = 60U * 1000U;
 
+    /** CPU load sample period in ms. */
+    static const uint32_t SAMPLE_PERIOD     = 1000U;
+
 private:
 
-    SimpleTimer m_timer;    /**< Timer used for cyclic processing. */
+#if (0 != TASK_MON_LOAD_SAMPLING)
 
     /**
-     * Constructs the task monitor.
+     * A task slot keeps the state of a sampled task.
      */
-    TaskMon()
+    struct TaskSlot
     {
-    }
+        TaskHandle_t    handle;                         /**< Task handle */
+        char            name[configMAX_TASK_NAME_LEN];  /**< Task name */
+        uint32_t        runTimeCounter;                 /**< Run time counter of the last sample */
+        int32_t         coreId;                         /**< Core affinity, -1 if any core. */
+        uint32_t        priority;                       /**< Current task priority */
+        eTaskState      state;                          /**< Task state */
+        uint32_t        stackHighWaterMark;             /**< Stack high water mark */
+        bool            isUsed;                         /**< Is the slot used? */
+        bool            isSeen;                         /**< Is the task seen in the current sample? */
+    };
+
+    MutexRecursive  m_mutex;                        /**< Protects the samples against concurrent access. */
+    SimpleTimer     m_sampleTimer;                  /**< Timer used for sampling. */
+    TaskSlot        m_slots[MAX_TASKS];             /**< Task slots */
+    Sample          m_history[HISTORY_SIZE];        /**< Sample history */
+    uint32_t        m_sampleSeq;                    /**< Sequence number of the next sample */
+    uint32_t        m_lastTotalRunTime;             /**< Total run time of the last sample */
+
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+
+    SimpleTimer     m_timer;                        /**< Timer used for cyclic processing. */
+
+    /**
+     * Constructs the task monitor.
+     */
+    TaskMon();
 
     /**
      * Destroys the task monitor.
@@ -104,6 +235,25 @@ private:
     TaskMon(const TaskMon& taskMon);
     TaskMon& operator=(const TaskMon& taskMon);
 
+#if (0 != TASK_MON_LOAD_SAMPLING)
+
+    /**
+     * Take a CPU load sample of all tasks and cores.
+     */
+    void sample();
+
+    /**
+     * Get the task slot of the given task. If the task has no slot yet,
+     * a free slot is assigned and its load history is cleared.
+     *
+     * @param[in] status    Task status
+     *
+     * @return Task slot index. If no slot is available, MAX_TASKS is returned.
+     */
+    uint8_t getTaskSlot(const TaskStatus_t& status);
+
+#endif  /* (0 != TASK_MON_LOAD_SAMPLING) */
+
 #if configUSE_TRACE_FACILITY
 
     /**
@@ -41,6 +41,8 @@
 #include <ArduinoJson.h>
 #include <Util.h>
 #include <SettingsService.h>
+#include <PollingService.h>
+#include <Tracer.h>
 
 #if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
 #include <StatisticValue.hpp>
@@ -763,6 +765,7 @@ DisplayMgr::DisplayMgr() :
     m_selectedPlugin(nullptr),
     m_requestedPlugin(nullptr),
     m_slotTimer(),
+    m_pollingScheduleTimer(),
     m_displayFadeState(FADE_IN),
     m_selectedFrameBuffer(nullptr),
     m_framebuffers(),
@@ -887,6 +890,56 @@ uint8_t DisplayMgr::previousSlot(uint8_t slotId)
     return slotId;
 }
 
+void DisplayMgr::updatePollingSchedule()
+{
+    PollingService& pollingService = PollingService::getInstance();
+
+    /* During a slot change, keep the last schedule. */
+    if ((nullptr != m_selectedPlugin) &&
+        (true == m_slotList.isSlotIdValid(m_selectedSlotId)))
+    {
+        pollingService.clearSchedule();
+        pollingService.setSchedule(m_selectedPlugin->getUID(), 0U);
+
+        /* The other slots are only activated, if the duration of the
+         * selected slot is limited.
+         */
+        if (true == m_slotTimer.isTimerRunning())
+        {
+            uint32_t    timeUntilActive = m_slotTimer.getRemaining();
+            uint8_t     slotId          = nextSlot(m_selectedSlotId);
+            uint8_t     count           = 0U;
+            bool        isInfinite      = false;
+
+            while((m_selectedSlotId != slotId) &&
+                  (true == m_slotList.isSlotIdValid(slotId)) &&
+                  (m_slotList.getMaxSlots() > count) &&
+                  (false == isInfinite))
+            {
+                IPluginMaintenance* plugin      = m_slotList.getPlugin(slotId);
+                uint32_t            duration    = m_slotList.getDuration(slotId);
+
+                if (nullptr != plugin)
+                {
+                    pollingService.setSchedule(plugin->getUID(), timeUntilActive);
+                }
+
+                /* A slot with infinite duration stops the rotation. */
+                if (0U == duration)
+                {
+                    isInfinite = true;
+                }
+                else
+                {
+                    timeUntilActive += duration;
+                    slotId           = nextSlot(slotId);
+                    ++count;
+                }
+            }
+        }
+    }
+}
+
 void DisplayMgr::startFadeOut()
 {
     /* Select next framebuffer and keep old content, until
@@ -929,6 +982,8 @@ void DisplayMgr::fadeInOut(YAGfx& dst)
         /* Continuously update the current canvas with its framebuffer. */
         if (nullptr != m_selectedPlugin)
         {
+            TRACE_SCOPE_ID("plugin.update", m_selectedPlugin->getUID());
+
             m_selectedPlugin->update(*m_selectedFrameBuffer);
         }
 
@@ -964,6 +1019,8 @@ void DisplayMgr::fadeInOut(YAGfx& dst)
 
 void DisplayMgr::process()
 {
+    TRACE_SCOPE("display.process");
+
     IDisplay&                   display     = Display::getInstance();
     uint8_t                     index       = 0U;
     uint8_t                     stickySlot  = SlotList::SLOT_ID_INVALID;
@@ -1137,6 +1194,9 @@ void DisplayMgr::process()
             }
 
             LOG_INFO("Slot %u (%s) now active.", m_selectedSlotId, m_selectedPlugin->getName());
+
+            /* The schedule changed, update it immediately. */
+            m_pollingScheduleTimer.stop();
         }
         /* No plugin is active, clear the display. */
         else
@@ -1175,6 +1235,16 @@ void DisplayMgr::process()
         m_fadeEffectUpdate = false;
     }
 
+    /* Update polling schedule, before the plugins poll. */
+    if ((false == m_pollingScheduleTimer.isTimerRunning()) ||
+        (true == m_pollingScheduleTimer.isTimeout()))
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutexUpdate);
+
+        updatePollingSchedule();
+        m_pollingScheduleTimer.start(POLLING_SCHEDULE_PERIOD);
+    }
+
     /* Process all installed plugins. */
     for(index = 0U; index < m_slotList.getMaxSlots(); ++index)
     {
@@ -1183,13 +1253,20 @@ void DisplayMgr::process()
 
         if (nullptr != plugin)
         {
+            TRACE_SCOPE_ID("plugin.process", plugin->getUID());
+
             plugin->process(m_isNetworkConnected);
         }
     }
+
+    /* Write a requested slot configuration, as soon as it is due. */
+    PluginMgr::getInstance().process();
 }
 
 void DisplayMgr::update()
 {
+    TRACE_SCOPE("display.update");
+
     IDisplay&                   display = Display::getInstance();
     MutexGuard<MutexRecursive>  guard(m_mutexUpdate);
 
@@ -1201,6 +1278,8 @@ void DisplayMgr::update()
     /* Update display (main canvas not available) */
     else if (nullptr != m_selectedPlugin)
     {
+        TRACE_SCOPE_ID("plugin.update", m_selectedPlugin->getUID());
+
         m_selectedPlugin->update(display);
     }
     /* No plugin selected. */
@@ -1210,7 +1289,9 @@ void DisplayMgr::update()
         ;
     }
 
+    TRACE_BEGIN("display.show");
     display.show();
+    TRACE_END("display.show");
 }
 
 bool DisplayMgr::createProcessTask()
@@ -372,6 +372,9 @@ private:
     /** The update task priority shall be higher than the other application tasks. */
     static const UBaseType_t    UPDATE_TASK_PRIORITY    = 4U;
 
+    /** The slot activation times are provided to the polling service with this period in ms. */
+    static const uint32_t       POLLING_SCHEDULE_PERIOD = 1000U;
+
     /** Mutex to protect concurrent access through the public interface. */
     mutable MutexRecursive      m_mutexInterf;
 
@@ -411,6 +414,9 @@ private:
     /** Timer, used for changing the slot after a specific duration. */
     SimpleTimer                 m_slotTimer;
 
+    /** Timer, used to update the polling schedule periodically. */
+    SimpleTimer                 m_pollingScheduleTimer;
+
     /** Display fade state */
     enum FadeState
     {
@@ -474,6 +480,13 @@ private:
      */
     uint8_t previousSlot(uint8_t slotId);
 
+    /**
+     * Provide the activation times of all slots to the polling service,
+     * which polls only plugins, whose slot is active or will be activated
+     * soon. Slots after a slot with infinite duration are never activated.
+     */
+    void updatePollingSchedule();
+
     /**
      * Start fade effect.
      */
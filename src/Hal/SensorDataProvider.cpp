@@ -295,7 +295,7 @@ bool SensorDataProvider::find(
 bool SensorDataProvider::load()
 {
     bool                status                  = false;
-    JsonFile            jsonFile(FILESYSTEM);
+    JsonFile            jsonFile(FILESYSTEM, JsonFile::STORAGE_CONFIG);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
@@ -342,7 +342,7 @@ bool SensorDataProvider::load()
 
 bool SensorDataProvider::save()
 {
-    JsonFile            jsonFile(FILESYSTEM);
+    JsonFile            jsonFile(FILESYSTEM, JsonFile::STORAGE_CONFIG);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint8_t             sensorIdx               = 0U;
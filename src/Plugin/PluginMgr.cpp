@@ -40,9 +40,11 @@
 
 #include <Logging.h>
 #include <ArduinoJson.h>
+#include <TrackedJsonDocument.hpp>
 #include <Util.h>
 #include <SettingsService.h>
 #include <TopicHandlerService.h>
+#include <PersistenceService.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -164,17 +166,16 @@ void PluginMgr::unregisterAllPluginTopics()
 bool PluginMgr::load()
 {
     bool                isSuccessful            = true;
-    JsonFile            jsonFile(FILESYSTEM);
+    JsonFile            jsonFile(FILESYSTEM, JsonFile::STORAGE_CONFIG);
     const size_t        JSON_DOC_SIZE           = 4096U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              fullConfigFileName      = PluginConfigFsHandler::CONFIG_PATH;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    fullConfigFileName += "/";
-    fullConfigFileName += CONFIG_FILE_NAME;
+    /* The installation in RAM is replaced, a pending write is obsolete. */
+    PersistenceService::getInstance().cancelWrite(m_configFullPath);
 
-    if (false == jsonFile.load(fullConfigFileName, jsonDoc))
+    if (false == jsonFile.load(m_configFullPath, jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", fullConfigFileName.c_str());
+        LOG_WARNING("Failed to load file %s.", m_configFullPath.c_str());
         isSuccessful = false;
     }
     else
@@ -202,16 +203,42 @@ bool PluginMgr::load()
 
 void PluginMgr::save()
 {
-    String              installation;
+    PersistenceService::getInstance().requestWrite(m_configFullPath);
+}
+
+void PluginMgr::process()
+{
+    if (true == PersistenceService::getInstance().isWriteDue(m_configFullPath))
+    {
+        writeSlotConfiguration();
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+PluginMgr::PluginMgr() :
+    m_pluginFactory(),
+    m_deviceId(),
+    m_configFullPath(PluginConfigFsHandler::CONFIG_PATH)
+{
+    m_configFullPath += "/";
+    m_configFullPath += CONFIG_FILE_NAME;
+}
+
+void PluginMgr::writeSlotConfiguration()
+{
     uint8_t             slotId              = 0;
     const size_t        JSON_DOC_SIZE       = 4096U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
     JsonArray           jsonSlots           = jsonDoc.createNestedArray("slotConfiguration");
-    JsonFile            jsonFile(FILESYSTEM);
-    String              fullConfigFileName  = PluginConfigFsHandler::CONFIG_PATH;
-
-    fullConfigFileName += "/";
-    fullConfigFileName += CONFIG_FILE_NAME;
+    JsonFile            jsonFile(FILESYSTEM, JsonFile::STORAGE_CONFIG);
+    bool                isSuccessful        = true;
 
     for(slotId = 0; slotId < DisplayMgr::getInstance().getMaxSlots(); ++slotId)
     {
@@ -238,19 +265,14 @@ void PluginMgr::save()
 
     checkJsonDocOverflow(jsonDoc, __LINE__);
 
-    if (false == jsonFile.save(fullConfigFileName, jsonDoc))
+    if (false == jsonFile.save(m_configFullPath, jsonDoc))
     {
         LOG_ERROR("Couldn't save slot configuration.");
+        isSuccessful = false;
     }
-}
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
-
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+    PersistenceService::getInstance().reportWrite(m_configFullPath, isSuccessful);
+}
 
 /**
  * Check dynamic JSON document for overflow and log a corresponding message,
@@ -259,7 +281,7 @@ void PluginMgr::save()
  * @param[in] jsonDoc   Dynamic JSON document, which to check.
  * @param[in] line      Line number where the document is handled in the module.
  */
-void PluginMgr::checkJsonDocOverflow(const DynamicJsonDocument& jsonDoc, int line)
+void PluginMgr::checkJsonDocOverflow(const JsonDocument& jsonDoc, int line)
 {
     if (true == jsonDoc.overflowed())
     {
@@ -131,10 +131,18 @@ public:
     bool load();
 
     /**
-     * Save plugin installation to persistent memory.
+     * Request to save plugin installation to persistent memory.
+     * The write is deferred and coalesced with further requests, see process().
      */
     void save();
 
+    /**
+     * Process the plugin manager. It writes a requested plugin installation
+     * to persistent memory, as soon as the write is due.
+     * Call it periodically.
+     */
+    void process();
+
     /**
      * Filename of slot configuration.
      */
@@ -147,15 +155,12 @@ private:
 
     PluginFactory   m_pluginFactory;    /**< The plugin factory with the plugin type registry. */
     String          m_deviceId;         /**< Device id, used for topic registration. */
+    String          m_configFullPath;   /**< Full path to the slot configuration file. */
 
     /**
      * Constructs the plugin manager.
      */
-    PluginMgr() :
-        m_pluginFactory(),
-        m_deviceId()
-    {
-    }
+    PluginMgr();
 
     /**
      * Destroys the plugin manager.
@@ -175,7 +180,7 @@ private:
      * @param[in] jsonDoc   Dynamic JSON document, which to check.
      * @param[in] line      Line number where the document is handled in the module.
      */
-    void checkJsonDocOverflow(const DynamicJsonDocument& jsonDoc, int line);
+    void checkJsonDocOverflow(const JsonDocument& jsonDoc, int line);
 
     /**
      * If configuration directory doesn't exists, it will be created.
@@ -183,6 +188,11 @@ private:
      */
     void createPluginConfigDirectory();
 
+    /**
+     * Write plugin installation to persistent memory immediately.
+     */
+    void writeSlotConfiguration();
+
     /**
      * Prepares a slot according to the given configuration.
      * 
@@ -200,6 +200,9 @@ void ConnectedState::exit(StateMachine& sm)
 
 void ConnectedState::initHttpClient()
 {
+    /* Every notification shall reach the server. */
+    m_client.setCacheEnabled(false);
+
     m_client.regOnResponse([](const HttpResponse& rsp){
         uint16_t statusCode = rsp.getStatusCode();
 
@@ -42,6 +42,7 @@
 #include <Board.h>
 #include <Display.h>
 #include <Logging.h>
+#include <PersistenceService.h>
 #include <Util.h>
 #include <ESPmDNS.h>
 
@@ -86,8 +87,12 @@ void RestartState::process(StateMachine& sm)
 
     UpdateMgr::getInstance().process();
 
+    /* The filesystem must not be unmounted, before the pending writes are
+     * finished. The owners write them in their own context.
+     */
     if ((true == m_timer.isTimerRunning()) &&
-        (true == m_timer.isTimeout()))
+        (true == m_timer.isTimeout()) &&
+        (true == PersistenceService::getInstance().isFlushFinished()))
     {
         /* Stop all servers */
         MyWebServer::end();
@@ -111,6 +116,9 @@ void RestartState::process(StateMachine& sm)
             ;
         }
 
+        /* Send all pending log messages. */
+        Logging::getInstance().stopAsync();
+
         /* Reset */
         Board::reset();
     }
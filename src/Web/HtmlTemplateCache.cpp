@@ -0,0 +1,513 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTML template cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HtmlTemplateCache.h"
+#include "HttpStatus.h"
+
+#include <Logging.h>
+#include <Tracer.h>
+#include <memory>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Streams a page segment by segment, while the web server requests the
+ * next chunk of the response. Literal segments are read from the file,
+ * keywords are replaced by the template processor.
+ */
+class HtmlTemplateCache::TemplateStream
+{
+public:
+
+    /**
+     * Constructs the template stream.
+     *
+     * @param[in] fd        File descriptor of the page, which is taken over.
+     * @param[in] segments  Segments of the page
+     * @param[in] processor Template processor, which provides the value of a keyword.
+     */
+    TemplateStream(File& fd, const SegmentList& segments, AwsTemplateProcessor processor) :
+        m_fd(fd),
+        m_segments(segments),
+        m_processor(processor),
+        m_segmentIdx(0U),
+        m_pos(0U),
+        m_value()
+    {
+    }
+
+    /**
+     * Destroys the template stream and closes the file.
+     */
+    ~TemplateStream()
+    {
+        m_fd.close();
+    }
+
+    /**
+     * Fill the buffer with the next part of the page.
+     *
+     * @param[out]  buffer  Buffer
+     * @param[in]   maxLen  Buffer size in byte
+     *
+     * @return Number of written bytes. If the page is complete, it will return 0.
+     */
+    size_t fill(uint8_t* buffer, size_t maxLen)
+    {
+        size_t len = 0U;
+
+        while((maxLen > len) && (m_segments.size() > m_segmentIdx))
+        {
+            const Segment&  segment     = m_segments[m_segmentIdx];
+            bool            isComplete  = false;
+
+            /* Literal? */
+            if (true == segment.keyword.isEmpty())
+            {
+                size_t count    = 0U;
+                size_t toRead   = segment.length - m_pos;
+
+                if ((maxLen - len) < toRead)
+                {
+                    toRead = maxLen - len;
+                }
+
+                if ((0U == m_pos) &&
+                    (false == m_fd.seek(segment.offset)))
+                {
+                    count = 0U;
+                }
+                else
+                {
+                    count = m_fd.read(&buffer[len], toRead);
+                }
+
+                /* File read error? Abort the page. */
+                if (0U == count)
+                {
+                    LOG_WARNING("Couldn't read page.");
+                    m_segmentIdx = m_segments.size();
+                }
+                else
+                {
+                    len     += count;
+                    m_pos   += count;
+
+                    isComplete = (segment.length <= m_pos);
+                }
+            }
+            /* Keyword */
+            else
+            {
+                size_t count = 0U;
+
+                if (0U == m_pos)
+                {
+                    m_value = (nullptr != m_processor) ? m_processor(segment.keyword) : segment.keyword;
+                }
+
+                count = m_value.length() - m_pos;
+
+                if ((maxLen - len) < count)
+                {
+                    count = maxLen - len;
+                }
+
+                memcpy(&buffer[len], &m_value.c_str()[m_pos], count);
+
+                len     += count;
+                m_pos   += count;
+
+                isComplete = (m_value.length() <= m_pos);
+            }
+
+            if (true == isComplete)
+            {
+                ++m_segmentIdx;
+                m_pos = 0U;
+                m_value.clear();
+            }
+        }
+
+        return len;
+    }
+
+private:
+
+    File                    m_fd;           /**< File descriptor of the page */
+    SegmentList             m_segments;     /**< Segments of the page */
+    AwsTemplateProcessor    m_processor;    /**< Template processor */
+    size_t                  m_segmentIdx;   /**< Index of the current segment */
+    size_t                  m_pos;          /**< Position in the current segment */
+    String                  m_value;        /**< Value of the current keyword segment */
+
+    TemplateStream(const TemplateStream& stream);
+    TemplateStream& operator=(const TemplateStream& stream);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static String getETag(File& fd);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void HtmlTemplateCache::send(AsyncWebServerRequest* request, FS& fs, const String& path, AwsTemplateProcessor processor)
+{
+    TRACE_SCOPE("web.page");
+
+    if (nullptr != request)
+    {
+        File fd = fs.open(path, "r");
+
+        if (false == fd)
+        {
+            /* A page without placeholders may be stored gzip compressed.
+             * The file response will choose it automatically.
+             */
+            File gzFd = fs.open(path + ".gz", "r");
+
+            if (false == gzFd)
+            {
+                request->send(HttpStatus::STATUS_CODE_NOT_FOUND);
+            }
+            else
+            {
+                String eTag = getETag(gzFd);
+
+                gzFd.close();
+                sendStatic(request, fs, path, eTag);
+            }
+        }
+        else
+        {
+            const Entry* entry = getEntry(fd, path);
+
+            /* Not enough memory to cache it? Use the template processing of the web server. */
+            if (nullptr == entry)
+            {
+                fd.close();
+                request->send(fs, path, "text/html", false, processor);
+            }
+            /* Page without placeholders? */
+            else if ((1U >= entry->segments.size()) &&
+                     ((true == entry->segments.empty()) || (true == entry->segments[0].keyword.isEmpty())))
+            {
+                String eTag = getETag(fd);
+
+                fd.close();
+                sendStatic(request, fs, path, eTag);
+            }
+            else
+            {
+                std::shared_ptr<TemplateStream> stream(new(std::nothrow) TemplateStream(fd, entry->segments, processor));
+                AsyncWebServerResponse*         response = nullptr;
+
+                if (nullptr != stream)
+                {
+                    response = request->beginChunkedResponse("text/html",
+                        [stream](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+                        {
+                            (void)index;
+
+                            return stream->fill(buffer, maxLen);
+                        }
+                    );
+                }
+                else
+                {
+                    fd.close();
+                }
+
+                if (nullptr == response)
+                {
+                    request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+                }
+                else
+                {
+                    request->send(response);
+                }
+            }
+        }
+    }
+}
+
+void HtmlTemplateCache::clear()
+{
+    EntryList::iterator it = m_entries.begin();
+
+    while(m_entries.end() != it)
+    {
+        Entry* entry = *it;
+
+        it = m_entries.erase(it);
+
+        if (nullptr != entry)
+        {
+            delete entry;
+            entry = nullptr;
+        }
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+const HtmlTemplateCache::Entry* HtmlTemplateCache::getEntry(File& fd, const String& path)
+{
+    Entry*              entry       = nullptr;
+    size_t              size        = fd.size();
+    time_t              lastWrite   = fd.getLastWrite();
+    EntryList::iterator it          = m_entries.begin();
+
+    while((m_entries.end() != it) && (nullptr == entry))
+    {
+        if ((nullptr != (*it)) &&
+            (path == (*it)->path))
+        {
+            entry = *it;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (nullptr == entry)
+    {
+        entry = new(std::nothrow) Entry();
+
+        if (nullptr != entry)
+        {
+            entry->path = path;
+            m_entries.push_back(entry);
+        }
+    }
+    /* Cached page still up to date? */
+    else if ((size == entry->size) &&
+             (lastWrite == entry->lastWrite) &&
+             (false == entry->segments.empty()))
+    {
+        return entry;
+    }
+    else
+    {
+        ;
+    }
+
+    if (nullptr != entry)
+    {
+        entry->size         = size;
+        entry->lastWrite    = lastWrite;
+
+        scan(fd, entry->segments);
+
+        LOG_INFO("Page %s cached with %u segments.", path.c_str(), entry->segments.size());
+    }
+
+    return entry;
+}
+
+void HtmlTemplateCache::scan(File& fd, SegmentList& segments)
+{
+    uint8_t     buffer[READ_BUFFER_SIZE];
+    uint32_t    offset          = 0U;
+    uint32_t    literalStart    = 0U;
+    uint32_t    keywordStart    = 0U;
+    bool        isKeyword       = false;
+    String      keyword;
+    size_t      count           = 0U;
+
+    segments.clear();
+    (void)fd.seek(0U);
+
+    do
+    {
+        size_t idx = 0U;
+
+        count = fd.read(buffer, sizeof(buffer));
+
+        for(idx = 0U; idx < count; ++idx)
+        {
+            char value = static_cast<char>(buffer[idx]);
+
+            if (PLACEHOLDER == value)
+            {
+                /* End of a keyword? */
+                if ((true == isKeyword) &&
+                    (false == keyword.isEmpty()))
+                {
+                    Segment segment;
+
+                    addLiteral(segments, literalStart, keywordStart - literalStart);
+
+                    segment.keyword = keyword;
+                    segments.push_back(segment);
+
+                    literalStart    = offset + 1U;
+                    isKeyword       = false;
+                }
+                /* Possible begin of a keyword. */
+                else
+                {
+                    keywordStart    = offset;
+                    isKeyword       = true;
+                }
+
+                keyword.clear();
+            }
+            else if ((true == isKeyword) &&
+                     (KEYWORD_MAX_LENGTH > keyword.length()) &&
+                     (true == isKeywordChar(value)))
+            {
+                keyword += value;
+            }
+            else
+            {
+                /* No keyword, it belongs to the literal. */
+                isKeyword = false;
+            }
+
+            ++offset;
+        }
+    }
+    while(0U < count);
+
+    addLiteral(segments, literalStart, offset - literalStart);
+}
+
+void HtmlTemplateCache::addLiteral(SegmentList& segments, uint32_t offset, uint32_t length)
+{
+    if (0U < length)
+    {
+        /* Merge with the previous literal? */
+        if ((false == segments.empty()) &&
+            (true == segments.back().keyword.isEmpty()) &&
+            ((segments.back().offset + segments.back().length) == offset))
+        {
+            segments.back().length += length;
+        }
+        else
+        {
+            Segment segment;
+
+            segment.offset = offset;
+            segment.length = length;
+
+            segments.push_back(segment);
+        }
+    }
+}
+
+bool HtmlTemplateCache::isKeywordChar(char value)
+{
+    return ((('A' <= value) && ('Z' >= value)) ||
+            (('a' <= value) && ('z' >= value)) ||
+            (('0' <= value) && ('9' >= value)) ||
+            ('_' == value));
+}
+
+void HtmlTemplateCache::sendStatic(AsyncWebServerRequest* request, FS& fs, const String& path, const String& eTag)
+{
+    if ((true == request->hasHeader("If-None-Match")) &&
+        (eTag == request->header("If-None-Match")))
+    {
+        request->send(HttpStatus::STATUS_CODE_NOT_MODIFIED);
+    }
+    else
+    {
+        AsyncWebServerResponse* response = request->beginResponse(fs, path, "text/html");
+
+        if (nullptr == response)
+        {
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        }
+        else
+        {
+            /* The browser shall always revalidate the page via ETag. */
+            response->addHeader("Cache-Control", "no-cache");
+            response->addHeader("ETag", eTag);
+            request->send(response);
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the ETag of a file, derived from its size and last write timestamp.
+ *
+ * @param[in] fd    File descriptor
+ *
+ * @return ETag
+ */
+static String getETag(File& fd)
+{
+    String eTag = "\"";
+
+    eTag += fd.size();
+    eTag += "-";
+    eTag += static_cast<uint32_t>(fd.getLastWrite());
+    eTag += "\"";
+
+    return eTag;
+}
@@ -0,0 +1,249 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTML template cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef HTML_TEMPLATE_CACHE_H
+#define HTML_TEMPLATE_CACHE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+#include <FS.h>
+#include <ESPAsyncWebServer.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HTML template cache serves HTML pages from the filesystem. Every page
+ * is split at its template placeholders (~KEYWORD~) only once, at the first
+ * request. The resulting segments are cached and on every further request
+ * the page is streamed segment by segment, without scanning it again.
+ *
+ * A cached page is scanned again, if its file size or its last write
+ * timestamp changed, e.g. after an upload.
+ *
+ * Pages without placeholders are sent as they are, with ETag and Cache-Control
+ * header, so the browser revalidates them without downloading them again.
+ * Such a page may be stored gzip compressed (e.g. "/about.html.gz").
+ */
+class HtmlTemplateCache
+{
+public:
+
+    /**
+     * Get the HTML template cache instance.
+     *
+     * @return HTML template cache instance
+     */
+    static HtmlTemplateCache& getInstance()
+    {
+        static HtmlTemplateCache instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Send a HTML page from the filesystem.
+     *
+     * @param[in] request   HTTP request
+     * @param[in] fs        Filesystem
+     * @param[in] path      Full path of the HTML page in the filesystem.
+     * @param[in] processor Template processor, which provides the value of a keyword.
+     */
+    void send(AsyncWebServerRequest* request, FS& fs, const String& path, AwsTemplateProcessor processor);
+
+    /**
+     * Remove all cached pages.
+     */
+    void clear();
+
+    /**
+     * Max. length of a template keyword.
+     */
+    static const size_t KEYWORD_MAX_LENGTH  = 32U;
+
+    /**
+     * Template placeholder character, which encloses a keyword.
+     */
+    static const char   PLACEHOLDER         = '~';
+
+private:
+
+    /**
+     * A segment of a page is either a literal part of the file or a
+     * template keyword.
+     */
+    struct Segment
+    {
+        uint32_t    offset;     /**< Literal: File offset in byte */
+        uint32_t    length;     /**< Literal: Length in byte */
+        String      keyword;    /**< Keyword, empty for a literal. */
+
+        /**
+         * Constructs a segment.
+         */
+        Segment() :
+            offset(0U),
+            length(0U),
+            keyword()
+        {
+        }
+    };
+
+    /** List of segments */
+    typedef std::vector<Segment> SegmentList;
+
+    /**
+     * A cached page.
+     */
+    struct Entry
+    {
+        String      path;       /**< Full path of the page */
+        size_t      size;       /**< File size in byte */
+        time_t      lastWrite;  /**< Last write timestamp of the file */
+        SegmentList segments;   /**< Segments of the page */
+
+        /**
+         * Constructs a cache entry.
+         */
+        Entry() :
+            path(),
+            size(0U),
+            lastWrite(0),
+            segments()
+        {
+        }
+    };
+
+    /** List of cache entries */
+    typedef std::vector<Entry*> EntryList;
+
+    /** Streams a page segment by segment. */
+    class TemplateStream;
+
+    /**
+     * File read buffer size in byte, used for scanning a page.
+     */
+    static const size_t READ_BUFFER_SIZE    = 256U;
+
+    EntryList   m_entries;  /**< Cached pages */
+
+    /**
+     * Constructs the HTML template cache.
+     */
+    HtmlTemplateCache() :
+        m_entries()
+    {
+    }
+
+    /**
+     * Destroys the HTML template cache.
+     */
+    ~HtmlTemplateCache()
+    {
+        clear();
+    }
+
+    HtmlTemplateCache(const HtmlTemplateCache& cache);
+    HtmlTemplateCache& operator=(const HtmlTemplateCache& cache);
+
+    /**
+     * Get the up to date cache entry of the page. If the page is not cached
+     * or outdated, it will be scanned.
+     *
+     * @param[in] fd    File descriptor of the page
+     * @param[in] path  Full path of the page
+     *
+     * @return Cache entry. If not enough memory is available, it will return nullptr.
+     */
+    const Entry* getEntry(File& fd, const String& path);
+
+    /**
+     * Scan the page and split it into segments.
+     *
+     * @param[in]   fd          File descriptor of the page
+     * @param[out]  segments    Segments of the page
+     */
+    static void scan(File& fd, SegmentList& segments);
+
+    /**
+     * Add a literal segment. Consecutive literals are merged.
+     *
+     * @param[in,out]   segments    Segments of the page
+     * @param[in]       offset      File offset in byte
+     * @param[in]       length      Length in byte
+     */
+    static void addLiteral(SegmentList& segments, uint32_t offset, uint32_t length);
+
+    /**
+     * Is the character valid in a keyword?
+     *
+     * @param[in] value Character
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    static bool isKeywordChar(char value);
+
+    /**
+     * Send a page without placeholders. The response contains a ETag and
+     * answers a matching If-None-Match request with 304 (not modified).
+     *
+     * @param[in] request   HTTP request
+     * @param[in] fs        Filesystem
+     * @param[in] path      Full path of the page
+     * @param[in] eTag      ETag of the page
+     */
+    static void sendStatic(AsyncWebServerRequest* request, FS& fs, const String& path, const String& eTag);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* HTML_TEMPLATE_CACHE_H */
+
+/** @} */
@@ -41,6 +41,7 @@
 #include "RestApi.h"
 #include "PluginList.h"
 #include "FileSystem.h"
+#include "HtmlTemplateCache.h"
 
 #include <WiFi.h>
 #include <Esp.h>
@@ -254,11 +255,27 @@ void Pages::init(AsyncWebServer& srv)
 
                             if (0U != request->url().endsWith(".html"))
                             {
-                                request->send(FILESYSTEM, request->url(), "text/html", false, tmplPageProcessor);
+                                HtmlTemplateCache::getInstance().send(request, FILESYSTEM, request->url(), tmplPageProcessor);
+                            }
+                            else if ((false == FILESYSTEM.exists(request->url())) &&
+                                     (false == FILESYSTEM.exists(request->url() + ".gz")))
+                            {
+                                request->send(HttpStatus::STATUS_CODE_NOT_FOUND);
                             }
                             else
                             {
-                                request->send(FILESYSTEM, request->url());
+                                /* The file response uses the gzip compressed file, if available. */
+                                AsyncWebServerResponse* response = request->beginResponse(FILESYSTEM, request->url());
+
+                                if (nullptr == response)
+                                {
+                                    request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+                                }
+                                else
+                                {
+                                    response->addHeader("Cache-Control", "max-age=3600");
+                                    request->send(response);
+                                }
                             }
 
                         }).setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());;
@@ -276,7 +293,7 @@ void Pages::error(AsyncWebServerRequest* request)
 
     LOG_INFO("Invalid web request: %s", request->url().c_str());
 
-    request->send(FILESYSTEM, "/error.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/error.html", tmplPageProcessor);
 }
 
 /******************************************************************************
@@ -326,7 +343,7 @@ static void aboutPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/about.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/about.html", tmplPageProcessor);
 }
 
 /**
@@ -341,7 +358,7 @@ static void debugPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/debug.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/debug.html", tmplPageProcessor);
 }
 
 /**
@@ -356,7 +373,7 @@ static void displayPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/display.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/display.html", tmplPageProcessor);
 }
 
 /**
@@ -371,7 +388,7 @@ static void editPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/edit.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/edit.html", tmplPageProcessor);
 }
 
 /**
@@ -386,7 +403,7 @@ static void indexPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/index.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/index.html", tmplPageProcessor);
 }
 
 /**
@@ -401,7 +418,7 @@ static void infoPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/info.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/info.html", tmplPageProcessor);
 }
 
 /**
@@ -416,7 +433,7 @@ static void settingsPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/settings.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/settings.html", tmplPageProcessor);
 }
 
 /**
@@ -431,7 +448,7 @@ static void updatePage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/update.html", "text/html", false, tmplPageProcessor);
+    HtmlTemplateCache::getInstance().send(request, FILESYSTEM, "/update.html", tmplPageProcessor);
 }
 
 /**
@@ -43,6 +43,8 @@
 #include "RestUtil.h"
 #include "SlotList.h"
 #include "ButtonActions.h"
+#include "TaskMon.h"
+#include "MemMon.h"
 
 #include <Util.h>
 #include <WiFi.h>
@@ -51,6 +53,16 @@
 #include <Logging.h>
 #include <SensorDataProvider.h>
 #include <SettingsService.h>
+#include <ImageCache.h>
+#include <NativeImg.h>
+#include <ConfigChangeNotifier.h>
+#include <JsonFile.h>
+#include <PersistenceService.h>
+#include <Tracer.h>
+#include <HeapAccounting.hpp>
+#include <TrackedJsonDocument.hpp>
+#include <memory>
+#include <vector>
 
 /******************************************************************************
  * Compiler Switches
@@ -108,6 +120,165 @@ private:
 
 };
 
+#if (0 != CONFIG_TRACE)
+
+/**
+ * Snapshot of the recorded trace events and the names of the running tasks.
+ * It provides them element by element in the Chrome trace event format.
+ */
+class TraceDump
+{
+public:
+
+    /**
+     * Constructs an empty trace dump.
+     */
+    TraceDump() :
+        m_events(nullptr),
+        m_eventCount(0U),
+        m_taskIds(nullptr),
+        m_taskNames(nullptr),
+        m_taskCount(0U)
+    {
+    }
+
+    /**
+     * Destroys the trace dump.
+     */
+    ~TraceDump()
+    {
+        delete[] m_events;
+        delete[] m_taskIds;
+        delete[] m_taskNames;
+    }
+
+    /**
+     * Take the snapshot of the recorded trace events and the task names.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool create()
+    {
+        bool isSuccessful = false;
+
+        m_events = new(std::nothrow) Tracer::Event[Tracer::MAX_EVENTS];
+
+        if (nullptr != m_events)
+        {
+            m_eventCount    = Tracer::getInstance().getEvents(m_events, Tracer::MAX_EVENTS);
+            isSuccessful    = true;
+
+#if configUSE_TRACE_FACILITY
+            {
+                UBaseType_t     numOfTasks  = uxTaskGetNumberOfTasks();
+                TaskStatus_t*   taskStatus  = new(std::nothrow) TaskStatus_t[numOfTasks];
+
+                if (nullptr != taskStatus)
+                {
+                    numOfTasks  = uxTaskGetSystemState(taskStatus, numOfTasks, nullptr);
+                    m_taskIds   = new(std::nothrow) uint32_t[numOfTasks];
+                    m_taskNames = new(std::nothrow) String[numOfTasks];
+
+                    /* The task names are copied, because a task may be deleted until they are sent. */
+                    if ((nullptr != m_taskIds) &&
+                        (nullptr != m_taskNames))
+                    {
+                        for(m_taskCount = 0U; m_taskCount < numOfTasks; ++m_taskCount)
+                        {
+                            m_taskIds[m_taskCount]      = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(taskStatus[m_taskCount].xHandle));
+                            m_taskNames[m_taskCount]    = taskStatus[m_taskCount].pcTaskName;
+                        }
+                    }
+
+                    delete[] taskStatus;
+                }
+            }
+#endif  /* configUSE_TRACE_FACILITY */
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Get a single element of the trace event array. First the task names
+     * are provided as metadata, followed by the trace events.
+     *
+     * @param[in]   index   Element index
+     * @param[out]  element JSON document, which will contain the element.
+     *
+     * @return If the element exists, it will return true otherwise false.
+     */
+    bool getElement(uint32_t index, JsonDocument& element) const
+    {
+        /* All trace events belong to one process. */
+        const uint32_t  PID         = 1U;
+        bool            isAvailable = false;
+
+        if (m_taskCount > index)
+        {
+            element["name"]         = "thread_name";
+            element["ph"]           = "M";
+            element["pid"]          = PID;
+            element["tid"]          = m_taskIds[index];
+            element["args"]["name"] = m_taskNames[index];
+
+            isAvailable = true;
+        }
+        else if ((m_taskCount + m_eventCount) > index)
+        {
+            const Tracer::Event&    event   = m_events[index - m_taskCount];
+            const char*             phase   = "i";
+
+            if (Tracer::EVENT_TYPE_BEGIN == event.type)
+            {
+                phase = "B";
+            }
+            else if (Tracer::EVENT_TYPE_END == event.type)
+            {
+                phase = "E";
+            }
+            else
+            {
+                /* Instant events are shown in the task track. */
+                element["s"] = "t";
+            }
+
+            element["name"]         = event.name;
+            element["ph"]           = phase;
+            element["ts"]           = event.timestamp;
+            element["pid"]          = PID;
+            element["tid"]          = event.taskId;
+            element["args"]["core"] = event.core;
+
+            if (0U != event.id)
+            {
+                element["args"]["id"] = event.id;
+            }
+
+            isAvailable = true;
+        }
+        else
+        {
+            ;
+        }
+
+        return isAvailable;
+    }
+
+private:
+
+    Tracer::Event*  m_events;       /**< Recorded trace events */
+    size_t          m_eventCount;   /**< Number of recorded trace events */
+    uint32_t*       m_taskIds;      /**< Task ids */
+    String*         m_taskNames;    /**< Task names */
+    size_t          m_taskCount;    /**< Number of tasks */
+
+    TraceDump(const TraceDump& dump);
+    TraceDump& operator=(const TraceDump& dump);
+};
+
+#endif  /* (0 != CONFIG_TRACE) */
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -115,12 +286,16 @@ private:
 static void handleButton(AsyncWebServerRequest* request);
 static void handleFadeEffect(AsyncWebServerRequest* request);
 static void handleSlots(AsyncWebServerRequest* request);
+static bool getSlotElement(uint32_t index, JsonDocument& element);
 static void handleSlot(AsyncWebServerRequest* request);
 static void handlePluginInstall(AsyncWebServerRequest* request);
 static void handlePluginUninstall(AsyncWebServerRequest* request);
 static void handlePlugins(AsyncWebServerRequest* request);
+static bool getPluginElement(uint32_t index, JsonDocument& element);
 static void handleSensors(AsyncWebServerRequest* request);
+static bool getSensorElement(uint32_t index, JsonDocument& element);
 static void handleSettings(AsyncWebServerRequest* request);
+static bool getSettingElement(uint32_t index, JsonDocument& element);
 static void handleSetting(AsyncWebServerRequest* request);
 static bool storeSetting(KeyValue* parameter, const String& value, String& error);
 static void handleStatus(AsyncWebServerRequest* request);
@@ -132,6 +307,14 @@ static void handleFilePost(AsyncWebServerRequest* request);
 static void uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final);
 static void handleFileDelete(AsyncWebServerRequest* request);
 static bool isValidHostname(const String& hostname);
+static void handleTasks(AsyncWebServerRequest* request);
+static bool getTaskSampleElement(const std::vector<uint8_t>& slots, uint32_t seq, JsonDocument& element);
+static void handleHeap(AsyncWebServerRequest* request);
+static bool getHeapSampleElement(uint32_t seq, JsonDocument& element);
+
+#if (0 != CONFIG_TRACE)
+static void handleTrace(AsyncWebServerRequest* request);
+#endif  /* (0 != CONFIG_TRACE) */
 
 /******************************************************************************
  * Local Variables
@@ -183,10 +366,16 @@ void RestApi::init(AsyncWebServer& srv)
     (void)srv.on("/rest/api/v1/settings", handleSettings);
     (void)srv.on("/rest/api/v1/setting", handleSetting);
     (void)srv.on("/rest/api/v1/status", handleStatus);
+    (void)srv.on("/rest/api/v1/tasks", handleTasks);
+    (void)srv.on("/rest/api/v1/heap", handleHeap);
     (void)srv.on("/rest/api/v1/fs/file", HTTP_GET, handleFileGet);
     (void)srv.on("/rest/api/v1/fs/file", HTTP_POST, handleFilePost, uploadHandler);
     (void)srv.on("/rest/api/v1/fs/file", HTTP_DELETE, handleFileDelete);
     (void)srv.on("/rest/api/v1/fs", handleFilesystem);
+
+#if (0 != CONFIG_TRACE)
+    (void)srv.on("/rest/api/v1/trace", handleTrace);
+#endif  /* (0 != CONFIG_TRACE) */
 }
 
 /**
@@ -197,7 +386,7 @@ void RestApi::init(AsyncWebServer& srv)
 void RestApi::error(AsyncWebServerRequest* request)
 {
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_NOT_FOUND;
 
     if (nullptr == request)
@@ -222,9 +411,11 @@ void RestApi::error(AsyncWebServerRequest* request)
  */
 static void handleButton(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.button");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -283,9 +474,11 @@ static void handleButton(AsyncWebServerRequest* request)
  */
 static void handleFadeEffect(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.fadeEffect");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -329,9 +522,11 @@ static void handleFadeEffect(AsyncWebServerRequest* request)
  */
 static void handleSlots(AsyncWebServerRequest* request)
 {
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 4096U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TRACE_SCOPE("rest.slots");
+
+    const size_t        JSON_DOC_SIZE       = 256U;
+    const size_t        SLOT_JSON_DOC_SIZE  = 256U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -341,51 +536,63 @@ static void handleSlots(AsyncWebServerRequest* request)
     if (HTTP_GET != request->method())
     {
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
     else
     {
-        JsonVariant dataObj     = RestUtil::prepareRspSuccess(jsonDoc);
-        JsonArray   slotArray   = dataObj.createNestedArray("slots");
-        uint8_t     slotId      = 0U;
-        DisplayMgr& displayMgr  = DisplayMgr::getInstance();
-        uint8_t     stickySlot  = displayMgr.getStickySlot();
+        JsonVariant dataObj = RestUtil::prepareRspSuccess(jsonDoc);
 
         /* Add max. number of slots */
-        dataObj["maxSlots"] = displayMgr.getMaxSlots();
+        dataObj["maxSlots"] = DisplayMgr::getInstance().getMaxSlots();
 
-        /* Add which plugin's are installed. */
-        for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
-        {
-            IPluginMaintenance* plugin      = displayMgr.getPluginInSlot(slotId);
-            const char*         name        = (nullptr != plugin) ? plugin->getName() : "";
-            uint16_t            uid         = (nullptr != plugin) ? plugin->getUID() : 0U;
-            String              alias       = (nullptr != plugin) ? plugin->getAlias() : "";
-            bool                isLocked    = displayMgr.isSlotLocked(slotId);
-            uint32_t            duration    = displayMgr.getSlotDuration(slotId);
-            JsonObject          slot        = slotArray.createNestedObject();
-
-            slot["name"]        = name;
-            slot["uid"]         = uid;
-            slot["alias"]       = alias;
-
-            if (stickySlot != slotId)
-            {
-                slot["isSticky"] = false;
-            }
-            else
-            {
-                slot["isSticky"] = true;
-            }
+        /* Add which plugin's are installed, slot by slot. */
+        RestUtil::sendJsonArrayRsp(request, jsonDoc, "slots", SLOT_JSON_DOC_SIZE, getSlotElement);
+    }
+}
 
-            slot["isLocked"]    = isLocked;
-            slot["duration"]    = duration;
+/**
+ * Get the information about a single slot for the slots response.
+ *
+ * @param[in]   index   Slot id
+ * @param[out]  element JSON document, which will contain the slot information.
+ *
+ * @return If the slot exists, it will return true otherwise false.
+ */
+static bool getSlotElement(uint32_t index, JsonDocument& element)
+{
+    DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+    bool        isAvailable = false;
+
+    if (displayMgr.getMaxSlots() > index)
+    {
+        uint8_t             slotId      = static_cast<uint8_t>(index);
+        IPluginMaintenance* plugin      = displayMgr.getPluginInSlot(slotId);
+        const char*         name        = (nullptr != plugin) ? plugin->getName() : "";
+        uint16_t            uid         = (nullptr != plugin) ? plugin->getUID() : 0U;
+        String              alias       = (nullptr != plugin) ? plugin->getAlias() : "";
+        bool                isLocked    = displayMgr.isSlotLocked(slotId);
+        uint32_t            duration    = displayMgr.getSlotDuration(slotId);
+
+        element["name"]     = name;
+        element["uid"]      = uid;
+        element["alias"]    = alias;
+
+        if (displayMgr.getStickySlot() != slotId)
+        {
+            element["isSticky"] = false;
+        }
+        else
+        {
+            element["isSticky"] = true;
         }
 
-        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+        element["isLocked"] = isLocked;
+        element["duration"] = duration;
+
+        isAvailable = true;
     }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    return isAvailable;
 }
 
 /**
@@ -396,9 +603,11 @@ static void handleSlots(AsyncWebServerRequest* request)
  */
 static void handleSlot(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.slot");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -513,8 +722,10 @@ static void handleSlot(AsyncWebServerRequest* request)
  */
 static void handlePluginInstall(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.pluginInstall");
+
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -575,8 +786,10 @@ static void handlePluginInstall(AsyncWebServerRequest* request)
  */
 static void handlePluginUninstall(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.pluginUninstall");
+
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -661,9 +874,11 @@ static void handlePluginUninstall(AsyncWebServerRequest* request)
  */
 static void handlePlugins(AsyncWebServerRequest* request)
 {
-    const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    TRACE_SCOPE("rest.plugins");
+
+    const size_t        JSON_DOC_SIZE           = 128U;
+    const size_t        PLUGIN_JSON_DOC_SIZE    = 32U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -673,27 +888,37 @@ static void handlePlugins(AsyncWebServerRequest* request)
     if (HTTP_GET != request->method())
     {
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
     else
     {
-        JsonVariant                 dataObj                 = RestUtil::prepareRspSuccess(jsonDoc);
-        JsonArray                   pluginArray             = dataObj.createNestedArray("plugins");
-        uint8_t                     pluginTypeListLength    = 0U;
-        const PluginList::Element*  pluginTypeList          = PluginList::getList(pluginTypeListLength);
-        uint8_t                     idx                     = 0U;
+        (void)RestUtil::prepareRspSuccess(jsonDoc);
+        RestUtil::sendJsonArrayRsp(request, jsonDoc, "plugins", PLUGIN_JSON_DOC_SIZE, getPluginElement);
+    }
+}
 
-        while(pluginTypeListLength > idx)
-        {
-            pluginArray.add(pluginTypeList[idx].name);
-            
-            ++idx;
-        }
+/**
+ * Get the name of a single plugin type for the plugins response.
+ *
+ * @param[in]   index   Index in the plugin type list
+ * @param[out]  element JSON document, which will contain the plugin name.
+ *
+ * @return If the plugin type exists, it will return true otherwise false.
+ */
+static bool getPluginElement(uint32_t index, JsonDocument& element)
+{
+    uint8_t                     pluginTypeListLength    = 0U;
+    const PluginList::Element*  pluginTypeList          = PluginList::getList(pluginTypeListLength);
+    bool                        isAvailable             = false;
 
-        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+    if (pluginTypeListLength > index)
+    {
+        /* The plugin names are static, therefore they are not copied. */
+        (void)element.set(pluginTypeList[index].name);
+        isAvailable = true;
     }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    return isAvailable;
 }
 
 /**
@@ -704,9 +929,11 @@ static void handlePlugins(AsyncWebServerRequest* request)
  */
 static void handleSensors(AsyncWebServerRequest* request)
 {
-    const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    TRACE_SCOPE("rest.sensors");
+
+    const size_t        JSON_DOC_SIZE           = 128U;
+    const size_t        SENSOR_JSON_DOC_SIZE    = 512U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -716,54 +943,67 @@ static void handleSensors(AsyncWebServerRequest* request)
     if (HTTP_GET != request->method())
     {
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
     else
     {
-        JsonVariant         dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
-        JsonArray           sensorsArray    = dataObj.createNestedArray("sensors");
-        SensorDataProvider& sensorDataProv  = SensorDataProvider::getInstance();
-        uint8_t             numSensors      = sensorDataProv.getNumSensors();
-        uint8_t             sensorIdx       = 0U;
+        (void)RestUtil::prepareRspSuccess(jsonDoc);
+        RestUtil::sendJsonArrayRsp(request, jsonDoc, "sensors", SENSOR_JSON_DOC_SIZE, getSensorElement);
+    }
+}
 
-        for(sensorIdx = 0; sensorIdx < numSensors; ++sensorIdx)
+/**
+ * Get the information about a single sensor for the sensors response.
+ * A not available sensor driver results in an empty object.
+ *
+ * @param[in]   index   Sensor index
+ * @param[out]  element JSON document, which will contain the sensor information.
+ *
+ * @return If the sensor index is valid, it will return true otherwise false.
+ */
+static bool getSensorElement(uint32_t index, JsonDocument& element)
+{
+    SensorDataProvider& sensorDataProv  = SensorDataProvider::getInstance();
+    bool                isAvailable     = false;
+
+    if (sensorDataProv.getNumSensors() > index)
+    {
+        uint8_t     sensorIdx   = static_cast<uint8_t>(index);
+        ISensor*    sensor      = sensorDataProv.getSensor(sensorIdx);
+
+        (void)element.to<JsonObject>();
+
+        if (nullptr != sensor)
         {
-            ISensor*    sensor  = sensorDataProv.getSensor(sensorIdx);
+            uint8_t numChannels = sensor->getNumChannels();
 
-            if (nullptr != sensor)
-            {
-                uint8_t     numChannels     = sensor->getNumChannels();
-                JsonObject  sensorObj       = sensorsArray.createNestedObject();
+            element["index"]        = sensorIdx;
+            element["name"]         = sensor->getName();
+            element["isAvailable"]  = sensor->isAvailable();
 
-                sensorObj["index"]          = sensorIdx;
-                sensorObj["name"]           = sensor->getName();
-                sensorObj["isAvailable"]    = sensor->isAvailable();
+            /* Block is only used, to have the channels in the correct JSON order. */
+            {
+                uint8_t     channelIdx      = 0U;
+                JsonArray   channelsArray   = element.createNestedArray("channels");
 
-                /* Block is only used, to have the channels in the correct JSON order. */
+                for(channelIdx = 0U; channelIdx < numChannels; ++channelIdx)
                 {
-                    uint8_t     channelIdx      = 0U;
-                    JsonArray   channelsArray   = sensorObj.createNestedArray("channels");
+                    ISensorChannel* channel     = sensor->getChannel(channelIdx);
+                    JsonObject      channelObj  = channelsArray.createNestedObject();
 
-                    for(channelIdx = 0U; channelIdx < numChannels; ++channelIdx)
+                    if (nullptr != channel)
                     {
-                        ISensorChannel* channel     = sensor->getChannel(channelIdx);
-                        JsonObject      channelObj  = channelsArray.createNestedObject();
-
-                        if (nullptr != channel)
-                        {
-                            channelObj["index"]  = channelIdx;
-                            channelObj["name"]   = ISensorChannel::channelTypeToName(channel->getType());
-                        }
+                        channelObj["index"]  = channelIdx;
+                        channelObj["name"]   = ISensorChannel::channelTypeToName(channel->getType());
                     }
-
                 }
             }
         }
 
-        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+        isAvailable = true;
     }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    return isAvailable;
 }
 
 /**
@@ -774,9 +1014,11 @@ static void handleSensors(AsyncWebServerRequest* request)
  */
 static void handleSettings(AsyncWebServerRequest* request)
 {
-    const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    TRACE_SCOPE("rest.settings");
+
+    const size_t        JSON_DOC_SIZE           = 128U;
+    const size_t        SETTING_JSON_DOC_SIZE   = 32U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -786,30 +1028,43 @@ static void handleSettings(AsyncWebServerRequest* request)
     if (HTTP_GET != request->method())
     {
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
     else
     {
-        JsonVariant dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
-        JsonArray   settingsArray   = dataObj.createNestedArray("settings");
-        size_t      settingIdx      = 0U;
-        size_t      settingsCount   = 0U;
-        KeyValue**  settings        = SettingsService::getInstance().getList(settingsCount);
+        (void)RestUtil::prepareRspSuccess(jsonDoc);
+        RestUtil::sendJsonArrayRsp(request, jsonDoc, "settings", SETTING_JSON_DOC_SIZE, getSettingElement);
+    }
+}
 
-        for(settingIdx = 0; settingIdx < settingsCount; ++settingIdx)
-        {
-            KeyValue*   setting = settings[settingIdx];
+/**
+ * Get the key of a single setting for the settings response.
+ *
+ * @param[in]   index   Index in the settings list
+ * @param[out]  element JSON document, which will contain the setting key.
+ *
+ * @return If the setting exists, it will return true otherwise false.
+ */
+static bool getSettingElement(uint32_t index, JsonDocument& element)
+{
+    size_t      settingsCount   = 0U;
+    KeyValue**  settings        = SettingsService::getInstance().getList(settingsCount);
+    bool        isAvailable     = false;
 
-            if (nullptr != setting)
-            {
-                (void)settingsArray.add(setting->getKey());
-            }
+    if (settingsCount > index)
+    {
+        KeyValue* setting = settings[index];
+
+        /* The setting keys are static, therefore they are not copied. */
+        if (nullptr != setting)
+        {
+            (void)element.set(setting->getKey());
         }
 
-        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+        isAvailable = true;
     }
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    return isAvailable;
 }
 
 /**
@@ -821,8 +1076,10 @@ static void handleSettings(AsyncWebServerRequest* request)
  */
 static void handleSetting(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.setting");
+
     const size_t        JSON_DOC_SIZE   = 2048U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     SettingsService&    settings        = SettingsService::getInstance();
 
@@ -897,7 +1154,7 @@ static void handleSetting(AsyncWebServerRequest* request)
                 {
                     KeyValueJson*           kvJson      = static_cast<KeyValueJson*>(setting);
                     JsonObject              valueObj    = dataObj.createNestedObject("value");
-                    DynamicJsonDocument     jsonBuffer(JSON_DOC_SIZE);
+                    TrackedJsonDocument     jsonBuffer(JSON_DOC_SIZE);
                     DeserializationError    error       = deserializeJson(jsonBuffer, kvJson->getValue());
 
                     if (DeserializationError::Ok != error.code())
@@ -1232,9 +1489,11 @@ static bool storeSetting(KeyValue* parameter, const String& value, String& error
  */
 static void handleStatus(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.status");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    const size_t        JSON_DOC_SIZE   = 768U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1248,12 +1507,14 @@ static void handleStatus(AsyncWebServerRequest* request)
     }
     else
     {
+        PersistenceService::Statistics  persistenceStatistics;
         String              ssid;
         int8_t              rssi            = -100; // dbm
         JsonVariant         dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
         JsonObject          hwObj           = dataObj.createNestedObject("hardware");
         JsonObject          swObj           = dataObj.createNestedObject("software");
         JsonObject          internalRamObj  = swObj.createNestedObject("internalRam");
+        JsonObject          persistenceObj  = swObj.createNestedObject("persistence");
         JsonObject          wifiObj         = dataObj.createNestedObject("wifi");
         SettingsService&    settings        = SettingsService::getInstance();
 
@@ -1282,6 +1543,13 @@ static void handleStatus(AsyncWebServerRequest* request)
         internalRamObj["heapSize"]      = ESP.getHeapSize();
         internalRamObj["availableHeap"] = ESP.getFreeHeap();
 
+        PersistenceService::getInstance().getStatistics(persistenceStatistics);
+        persistenceObj["requests"]      = persistenceStatistics.requests;
+        persistenceObj["coalesced"]     = persistenceStatistics.coalesced;
+        persistenceObj["writes"]        = persistenceStatistics.writes;
+        persistenceObj["failed"]        = persistenceStatistics.failed;
+        persistenceObj["pending"]       = persistenceStatistics.pending;
+
         wifiObj["ssid"]         = ssid;
         wifiObj["rssi"]         = rssi;                             // dBm
         wifiObj["quality"]      = WiFiUtil::getSignalQuality(rssi); // percent
@@ -1373,10 +1641,12 @@ static void getFiles(File& dir, JsonArray& files, uint32_t& preCount, uint32_t&
  */
 static void handleFilesystem(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.filesystem");
+
     String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 2048U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1444,9 +1714,11 @@ static void handleFilesystem(AsyncWebServerRequest* request)
  */
 static void handleFileGet(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.fileGet");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1518,9 +1790,11 @@ static const char* getContentType(const String& filename)
  */
 static void handleFilePost(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.filePost");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1581,6 +1855,31 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
         LOG_INFO("File %s successful written.", filename.c_str());
 
         request->_tempFile.close();
+
+        /* A decoded image of the overwritten file and a native image,
+         * which belongs to it, are outdated. Bitmap images are converted
+         * on the fly to the native image format, which is decoded faster
+         * and needs less space.
+         */
+        NativeImg::removeFileOf(FILESYSTEM, filename);
+
+        if (true == filename.endsWith(".bmp"))
+        {
+            NativeImg nativeImg;
+
+            if (false == nativeImg.convert(FILESYSTEM, filename))
+            {
+                LOG_INFO("File %s kept in its image format.", filename.c_str());
+            }
+        }
+
+        ImageCache::getInstance().invalidate(filename);
+
+        /* A plugin reloads its configuration, if it was overwritten.
+         * A configuration is addressed by its JSON filename, even if it
+         * is stored as MessagePack.
+         */
+        ConfigChangeNotifier::getInstance().notify(JsonFile::getJsonFileName(filename));
     }
     else if (true == isError)
     {
@@ -1605,9 +1904,11 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
  */
 static void handleFileDelete(AsyncWebServerRequest* request)
 {
+    TRACE_SCOPE("rest.fileDelete");
+
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1625,13 +1926,17 @@ static void handleFileDelete(AsyncWebServerRequest* request)
 
         LOG_INFO("File \"%s\" removal requested.", path.c_str());
 
-        if (false == FILESYSTEM.remove(path))
+        /* An image may be stored as native image only. */
+        if (false == NativeImg::remove(FILESYSTEM, path))
         {
             RestUtil::prepareRspError(jsonDoc, "Failed to remove file.");
             httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
         }
         else
         {
+            ImageCache::getInstance().invalidate(path);
+            ConfigChangeNotifier::getInstance().notify(JsonFile::getJsonFileName(path));
+
             (void)RestUtil::prepareRspSuccess(jsonDoc);
             httpStatusCode = HttpStatus::STATUS_CODE_OK;
         }
@@ -1706,3 +2011,315 @@ static bool isValidHostname(const String& hostname)
 
     return isValid;
 }
+
+/**
+ * Get the CPU load history per core and per task. The samples are sorted
+ * from the oldest to the newest. The task loads of a sample are in the same
+ * order as the tasks.
+ * GET \c "/api/v1/tasks"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleTasks(AsyncWebServerRequest* request)
+{
+    TRACE_SCOPE("rest.tasks");
+
+    const size_t        JSON_DOC_SIZE           = 4096U;
+    const size_t        SAMPLE_JSON_DOC_SIZE    = 512U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
+    }
+    else
+    {
+        TaskMon&                taskMon     = TaskMon::getInstance();
+        JsonVariant             dataObj     = RestUtil::prepareRspSuccess(jsonDoc);
+        JsonArray               tasksArray  = dataObj.createNestedArray("tasks");
+        std::vector<uint8_t>    slots;
+        uint32_t                firstSeq    = 0U;
+        uint32_t                count       = 0U;
+        uint8_t                 slot        = 0U;
+
+        dataObj["isLoadAvailable"]  = taskMon.isLoadAvailable();
+        dataObj["samplePeriod"]     = TaskMon::SAMPLE_PERIOD;
+        dataObj["numCores"]         = TaskMon::NUM_CORES;
+
+        for(slot = 0U; slot < TaskMon::MAX_TASKS; ++slot)
+        {
+            TaskMon::TaskInfo info;
+
+            if (true == taskMon.getTaskInfo(slot, info))
+            {
+                JsonObject taskObj = tasksArray.createNestedObject();
+
+                taskObj["name"]                 = info.name;
+                taskObj["core"]                 = info.coreId;
+                taskObj["priority"]             = info.priority;
+                taskObj["state"]                = info.state;
+                taskObj["stackHighWaterMark"]   = info.stackHighWaterMark;
+                taskObj["load"]                 = info.load;
+
+                slots.push_back(slot);
+            }
+        }
+
+        /* The sample range is fixed now, because the samples continue while the response is sent. */
+        taskMon.getSampleRange(firstSeq, count);
+
+        RestUtil::sendJsonArrayRsp(request, jsonDoc, "samples", SAMPLE_JSON_DOC_SIZE,
+            [slots, firstSeq, count](uint32_t index, JsonDocument& element) -> bool
+            {
+                bool isAvailable = false;
+
+                if (count > index)
+                {
+                    isAvailable = getTaskSampleElement(slots, firstSeq + index, element);
+                }
+
+                return isAvailable;
+            }
+        );
+    }
+}
+
+/**
+ * Get a single CPU load sample for the tasks response.
+ * A sample, which was overwritten meanwhile, is provided without load values.
+ *
+ * @param[in]   slots   Task slots in the order of the response
+ * @param[in]   seq     Sample sequence number
+ * @param[out]  element JSON document, which will contain the sample.
+ *
+ * @return Always true, as the sample range is checked by the caller.
+ */
+static bool getTaskSampleElement(const std::vector<uint8_t>& slots, uint32_t seq, JsonDocument& element)
+{
+    TaskMon::Sample sample;
+    JsonArray       coresArray  = element.createNestedArray("cores");
+    JsonArray       tasksArray  = element.createNestedArray("tasks");
+
+    if (true == TaskMon::getInstance().getSample(seq, sample))
+    {
+        uint8_t core    = 0U;
+        size_t  idx     = 0U;
+
+        for(core = 0U; core < TaskMon::NUM_CORES; ++core)
+        {
+            (void)coresArray.add(sample.coreLoad[core]);
+        }
+
+        for(idx = 0U; idx < slots.size(); ++idx)
+        {
+            (void)tasksArray.add(sample.taskLoad[slots[idx]]);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the current heap status, the heap accounting per subsystem and the
+ * heap history. The samples are sorted from the oldest to the newest.
+ * GET \c "/api/v1/heap"
+ *
+ * Reset the high-water marks of the heap accounting.
+ * DELETE \c "/api/v1/heap"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleHeap(AsyncWebServerRequest* request)
+{
+    TRACE_SCOPE("rest.heap");
+
+    uint32_t            httpStatusCode          = HttpStatus::STATUS_CODE_OK;
+    bool                isRspSent               = false;
+    const size_t        JSON_DOC_SIZE           = 1024U;
+    const size_t        SAMPLE_JSON_DOC_SIZE    = 128U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET == request->method())
+    {
+        MemMon&         memMon          = MemMon::getInstance();
+        HeapAccounting& accounting      = HeapAccounting::getInstance();
+        JsonVariant     dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
+        JsonObject      heapObj         = dataObj.createNestedObject("heap");
+        JsonArray       tagsArray       = dataObj.createNestedArray("tags");
+        uint32_t        freeHeap        = ESP.getFreeHeap();
+        uint32_t        largestBlock    = ESP.getMaxAllocHeap();
+        uint32_t        firstSeq        = 0U;
+        uint32_t        count           = 0U;
+        uint8_t         tag             = 0U;
+
+        heapObj["free"]                 = freeHeap;
+        heapObj["minFree"]              = ESP.getMinFreeHeap();
+        heapObj["largestBlock"]         = largestBlock;
+        heapObj["fragmentation"]        = MemMon::calcFragmentation(freeHeap, largestBlock);
+        heapObj["failedAllocs"]         = memMon.getFailedAllocCount();
+        heapObj["lastFailedAllocSize"]  = memMon.getLastFailedAllocSize();
+
+        for(tag = 0U; tag < HeapAccounting::TAG_MAX; ++tag)
+        {
+            HeapAccounting::Stats stats;
+
+            if (true == accounting.getStats(static_cast<HeapAccounting::Tag>(tag), stats))
+            {
+                JsonObject tagObj = tagsArray.createNestedObject();
+
+                tagObj["name"]              = HeapAccounting::tagToStr(static_cast<HeapAccounting::Tag>(tag));
+                tagObj["current"]           = stats.current;
+                tagObj["peak"]              = stats.peak;
+                tagObj["allocations"]       = stats.allocations;
+                tagObj["failures"]          = stats.failures;
+                tagObj["lastFailedSize"]    = stats.lastFailedSize;
+            }
+        }
+
+        dataObj["historyPeriod"] = MemMon::HISTORY_PERIOD;
+
+        /* The sample range is fixed now, because the samples continue while the response is sent. */
+        memMon.getSampleRange(firstSeq, count);
+
+        RestUtil::sendJsonArrayRsp(request, jsonDoc, "history", SAMPLE_JSON_DOC_SIZE,
+            [firstSeq, count](uint32_t index, JsonDocument& element) -> bool
+            {
+                bool isAvailable = false;
+
+                if (count > index)
+                {
+                    isAvailable = getHeapSampleElement(firstSeq + index, element);
+                }
+
+                return isAvailable;
+            }
+        );
+
+        isRspSent = true;
+    }
+    else if (HTTP_DELETE == request->method())
+    {
+        HeapAccounting::getInstance().resetPeaks();
+
+        (void)RestUtil::prepareRspSuccess(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+    }
+    else
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+
+    if (false == isRspSent)
+    {
+        RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    }
+}
+
+/**
+ * Get a single heap sample for the heap response.
+ * A sample, which was overwritten meanwhile, is provided empty.
+ *
+ * @param[in]   seq     Sample sequence number
+ * @param[out]  element JSON document, which will contain the sample.
+ *
+ * @return Always true, as the sample range is checked by the caller.
+ */
+static bool getHeapSampleElement(uint32_t seq, JsonDocument& element)
+{
+    MemMon::Sample sample;
+
+    if (true == MemMon::getInstance().getSample(seq, sample))
+    {
+        element["uptime"]           = sample.uptime;
+        element["free"]             = sample.freeHeap;
+        element["largestBlock"]     = sample.largestBlock;
+        element["fragmentation"]    = MemMon::calcFragmentation(sample.freeHeap, sample.largestBlock);
+    }
+    else
+    {
+        (void)element.to<JsonObject>();
+    }
+
+    return true;
+}
+
+#if (0 != CONFIG_TRACE)
+
+/**
+ * Get the recorded trace events in the Chrome trace event format, which can be
+ * loaded into chrome://tracing or https://ui.perfetto.dev.
+ * GET \c "/api/v1/trace"
+ *
+ * Remove all recorded trace events.
+ * DELETE \c "/api/v1/trace"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleTrace(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    bool                isRspSent           = false;
+    const size_t        JSON_DOC_SIZE       = 256U;
+    const size_t        EVENT_JSON_DOC_SIZE = 256U;
+    TrackedJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET == request->method())
+    {
+        std::shared_ptr<TraceDump> dump(new(std::nothrow) TraceDump());
+
+        if ((nullptr == dump) ||
+            (false == dump->create()))
+        {
+            RestUtil::prepareRspError(jsonDoc, "Internal error.");
+            httpStatusCode = HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR;
+        }
+        else
+        {
+            /* The trace dump is kept until the response is completely sent. */
+            RestUtil::sendJsonArray(request, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", "]}", EVENT_JSON_DOC_SIZE,
+                [dump](uint32_t index, JsonDocument& element) -> bool
+                {
+                    return dump->getElement(index, element);
+                }
+            );
+
+            isRspSent = true;
+        }
+    }
+    else if (HTTP_DELETE == request->method())
+    {
+        Tracer::getInstance().clear();
+
+        (void)RestUtil::prepareRspSuccess(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+    }
+    else
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+
+    if (false == isRspSent)
+    {
+        RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+    }
+}
+
+#endif  /* (0 != CONFIG_TRACE) */
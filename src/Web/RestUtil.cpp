@@ -33,8 +33,11 @@
  * Includes
  *****************************************************************************/
 #include "RestUtil.h"
+#include "HttpStatus.h"
 
 #include <Logging.h>
+#include <TrackedJsonDocument.hpp>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -48,6 +51,130 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Creates a JSON response step by step. The response consists of a
+ * head, the array elements and a tail. Every part is serialized just in
+ * time, when the web server requests the next chunk.
+ */
+class JsonArrayRspGenerator
+{
+public:
+
+    /**
+     * Constructs the generator.
+     *
+     * @param[in] head              Serialized response until the first array element.
+     * @param[in] tail              Serialized response after the last array element.
+     * @param[in] elementDocSize    JSON document size in byte for a single element.
+     * @param[in] elementFunc       Function, which provides the array elements.
+     */
+    JsonArrayRspGenerator(const String& head, const char* tail, size_t elementDocSize, RestUtil::ArrayElementFunc elementFunc) :
+        m_tail(tail),
+        m_elementDoc(elementDocSize),
+        m_elementFunc(elementFunc),
+        m_part(head),
+        m_partPos(0U),
+        m_index(0U),
+        m_isArrayEnd(false),
+        m_isFinished(false)
+    {
+    }
+
+    /**
+     * Destroys the generator.
+     */
+    ~JsonArrayRspGenerator()
+    {
+    }
+
+    /**
+     * Fill the buffer with the next part of the response.
+     *
+     * @param[out]  buffer  Buffer
+     * @param[in]   maxLen  Buffer size in byte
+     *
+     * @return Number of written bytes. If the response is complete, it will return 0.
+     */
+    size_t fill(uint8_t* buffer, size_t maxLen)
+    {
+        size_t len = 0U;
+
+        while((maxLen > len) && (false == m_isFinished))
+        {
+            if (m_part.length() <= m_partPos)
+            {
+                next();
+            }
+            else
+            {
+                size_t available   = m_part.length() - m_partPos;
+                size_t count       = ((maxLen - len) < available) ? (maxLen - len) : available;
+
+                memcpy(&buffer[len], &m_part.c_str()[m_partPos], count);
+
+                len         += count;
+                m_partPos   += count;
+            }
+        }
+
+        return len;
+    }
+
+private:
+
+    const char*                 m_tail;         /**< Serialized response after the last array element */
+    TrackedJsonDocument         m_elementDoc;   /**< JSON document for a single element */
+    RestUtil::ArrayElementFunc  m_elementFunc;  /**< Function, which provides the array elements. */
+    String                      m_part;         /**< Current serialized part of the response */
+    size_t                      m_partPos;      /**< Position in the current part, of the next byte to send. */
+    uint32_t                    m_index;        /**< Index of the next array element */
+    bool                        m_isArrayEnd;   /**< Are all array elements serialized? */
+    bool                        m_isFinished;   /**< Is the whole response serialized? */
+
+    JsonArrayRspGenerator(const JsonArrayRspGenerator& gen);
+    JsonArrayRspGenerator& operator=(const JsonArrayRspGenerator& gen);
+
+    /**
+     * Serialize the next part of the response.
+     */
+    void next()
+    {
+        m_part.clear();
+        m_partPos = 0U;
+
+        if (true == m_isArrayEnd)
+        {
+            m_isFinished = true;
+        }
+        else
+        {
+            m_elementDoc.clear();
+
+            if ((nullptr != m_elementFunc) &&
+                (true == m_elementFunc(m_index, m_elementDoc)))
+            {
+                if (true == m_elementDoc.overflowed())
+                {
+                    LOG_ERROR("JSON element document has less memory available.");
+                }
+
+                if (0U < m_index)
+                {
+                    m_part = ",";
+                }
+
+                (void)serializeJson(m_elementDoc, m_part);
+                ++m_index;
+            }
+            else
+            {
+                m_part          = m_tail;
+                m_isArrayEnd    = true;
+            }
+        }
+    }
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -107,10 +234,83 @@ void RestUtil::sendJsonRsp(AsyncWebServerRequest* request, const JsonDocument& j
 
     if (nullptr != request)
     {
-        String content;
+        /* The buffer is sized to the content, to avoid reallocation during serialization. */
+        AsyncResponseStream* response = request->beginResponseStream("application/json", measureJsonPretty(jsonDoc));
+
+        if (nullptr == response)
+        {
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        }
+        else
+        {
+            (void)serializeJsonPretty(jsonDoc, *response);
+            response->setCode(httpStatusCode);
+            request->send(response);
+        }
+    }
+}
+
+void RestUtil::sendJsonArrayRsp(AsyncWebServerRequest* request, const JsonDocument& jsonDoc, const char* arrayName, size_t elementDocSize, ArrayElementFunc elementFunc)
+{
+    if ((nullptr != request) &&
+        (nullptr != arrayName))
+    {
+        String head = "{\"status\":\"ok\",\"data\":";
+
+        /* The data object is serialized without its closing brace, so the
+         * array can be appended.
+         */
+        (void)serializeJson(jsonDoc["data"], head);
+
+        if ((0U < head.length()) &&
+            ('}' == head[head.length() - 1U]))
+        {
+            head.remove(head.length() - 1U);
+        }
+        else
+        {
+            /* No data object prepared. */
+            head += "{";
+        }
+
+        if ('{' != head[head.length() - 1U])
+        {
+            head += ",";
+        }
+
+        head += "\"";
+        head += arrayName;
+        head += "\":[";
+
+        /* The tail closes the array, the data object and the response. */
+        sendJsonArray(request, head, "]}}", elementDocSize, elementFunc);
+    }
+}
+
+void RestUtil::sendJsonArray(AsyncWebServerRequest* request, const String& head, const char* tail, size_t elementDocSize, ArrayElementFunc elementFunc)
+{
+    if ((nullptr != request) &&
+        (nullptr != tail))
+    {
+        std::shared_ptr<JsonArrayRspGenerator>  generator   = std::make_shared<JsonArrayRspGenerator>(head, tail, elementDocSize, elementFunc);
+        AsyncWebServerResponse*                 response    = request->beginChunkedResponse("application/json",
+            [generator](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+            {
+                (void)index;
+
+                return generator->fill(buffer, maxLen);
+            }
+        );
 
-        (void)serializeJsonPretty(jsonDoc, content);
-        request->send(httpStatusCode, "application/json", content);
+        if (nullptr == response)
+        {
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        }
+        else
+        {
+            response->setCode(HttpStatus::STATUS_CODE_OK);
+            request->send(response);
+        }
     }
 }
 
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <ArduinoJson.h>
 #include <ESPAsyncWebServer.h>
+#include <functional>
 
 /** REST API Utilities */
 namespace RestUtil
@@ -59,6 +60,18 @@ namespace RestUtil
  * Types and Classes
  *****************************************************************************/
 
+/**
+ * Prototype of a function, which provides a single JSON array element for a
+ * streamed response.
+ * 
+ * @param[in]   index   Index of the element
+ * @param[out]  element JSON document, which shall contain the element.
+ * 
+ * @return If the element is available, it will return true. If there are no
+ *         more elements, it will return false.
+ */
+typedef std::function<bool(uint32_t index, JsonDocument& element)> ArrayElementFunc;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
@@ -89,6 +102,7 @@ void prepareRspErrorHttpMethodNotSupported(JsonDocument& jsonDoc);
 
 /**
  * Send a application/json response to the client back.
+ * The JSON document is serialized directly into the response buffer.
  * 
  * @param[in] request           Client request
  * @param[in] jsonDoc           JSON response document
@@ -96,6 +110,40 @@ void prepareRspErrorHttpMethodNotSupported(JsonDocument& jsonDoc);
  */
 void sendJsonRsp(AsyncWebServerRequest* request, const JsonDocument& jsonDoc, uint32_t httpStatusCode);
 
+/**
+ * Send a successful application/json response to the client back, which
+ * contains an array of elements in its data object. The response is sent
+ * chunked and the elements are requested one by one, while the client
+ * receives the response. Only a single element is kept in memory, independent
+ * of the number of elements.
+ * 
+ * Note, the element function is called from the web server context after
+ * this function returned. It shall not refer to any local variables of the
+ * caller.
+ * 
+ * @param[in] request           Client request
+ * @param[in] jsonDoc           JSON response document, prepared with prepareRspSuccess(). May contain additional data.
+ * @param[in] arrayName         Name of the array in the data object.
+ * @param[in] elementDocSize    JSON document size in byte for a single element.
+ * @param[in] elementFunc       Function, which provides the array elements.
+ */
+void sendJsonArrayRsp(AsyncWebServerRequest* request, const JsonDocument& jsonDoc, const char* arrayName, size_t elementDocSize, ArrayElementFunc elementFunc);
+
+/**
+ * Send a application/json response to the client back, which consists of
+ * a raw head, an array of elements and a raw tail. It is used for responses,
+ * which don't follow the REST response layout. The response is sent chunked
+ * like in sendJsonArrayRsp().
+ * 
+ * @param[in] request           Client request
+ * @param[in] head              Serialized response until the first array element, incl. the array opening bracket.
+ * @param[in] tail              Serialized response after the last array element, incl. the array closing bracket.
+ *                              It must be a string literal.
+ * @param[in] elementDocSize    JSON document size in byte for a single element.
+ * @param[in] elementFunc       Function, which provides the array elements.
+ */
+void sendJsonArray(AsyncWebServerRequest* request, const String& head, const char* tail, size_t elementDocSize, ArrayElementFunc elementFunc);
+
 }
 
 #endif  /* REST_UTIL_H */
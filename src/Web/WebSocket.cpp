@@ -52,6 +52,8 @@
 #include <Logging.h>
 #include <Util.h>
 #include <SettingsService.h>
+#include <Tracer.h>
+#include <HeapAccounting.hpp>
 
 /******************************************************************************
  * Compiler Switches
@@ -61,10 +63,23 @@
  * Macros
  *****************************************************************************/
 
+/** Lock the client queues. */
+#define WEBSOCKET_LOCK()    MutexGuard<MutexRecursive> guard(m_mutex)
+
 /******************************************************************************
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Websocket command with its binary protocol id.
+ */
+typedef struct
+{
+    uint8_t id;     /**< Binary protocol command id */
+    WsCmd*  cmd;    /**< Websocket command */
+
+} WsCmdEntry;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -119,27 +134,45 @@ static WsCmdEffect          gWsCmdEffect;
 /** Websocket get/set plugin alias name command */
 static WsCmdAlias           gWsCmdAlias;
 
-/** Websocket command list */
-static WsCmd*       gWsCommands[] =
+/**
+ * Websocket command list.
+ * The binary protocol command ids shall never be changed, only appended.
+ */
+static const WsCmdEntry gWsCommands[] =
 {
-    &gWsCmdGetDisp,
-    &gWsCmdSlots,
-    &gWsCmdPlugins,
-    &gWsCmdInstall,
-    &gWsCmdUninstall,
-    &gWsCmdReset,
-    &gWsCmdBrightness,
-    &gWsCmdLog,
-    &gWsCmdMove,
-    &gWsCmdSlotDuration,
+    {  1U, &gWsCmdGetDisp       },
+    {  2U, &gWsCmdSlots         },
+    {  3U, &gWsCmdPlugins       },
+    {  4U, &gWsCmdInstall       },
+    {  5U, &gWsCmdUninstall     },
+    {  6U, &gWsCmdReset         },
+    {  7U, &gWsCmdBrightness    },
+    {  8U, &gWsCmdLog           },
+    {  9U, &gWsCmdMove          },
+    { 10U, &gWsCmdSlotDuration  },
 #if CONFIG_FEATURE_IPERF == 1
-    &gWsCmdIperf,
+    { 11U, &gWsCmdIperf         },
 #endif /* CONFIG_FEATURE_IPERF == 1 */
-    &gWsCmdButton,
-    &gWsCmdEffect,
-    &gWsCmdAlias
+    { 12U, &gWsCmdButton        },
+    { 13U, &gWsCmdEffect        },
+    { 14U, &gWsCmdAlias         }
 };
 
+/** Text protocol delimiter */
+static const char   DELIMITER           = ';';
+
+/** Text protocol positive response prefix */
+static const char   ACK_PREFIX[]        = "ACK";
+
+/** Text protocol negative response prefix */
+static const char   NACK_PREFIX[]       = "NACK";
+
+/** Text protocol event prefix */
+static const char   EVT_PREFIX[]        = "EVT;";
+
+/** Response, which replaces a superseded message. */
+static const char   SUPERSEDED_RSP[]    = "\"Superseded.\"";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -173,6 +206,142 @@ void WebSocketSrv::init(AsyncWebServer& srv)
     srv.addHandler(&m_webSocket);
 }
 
+void WebSocketSrv::process()
+{
+    TRACE_SCOPE("ws.process");
+
+    std::vector<uint32_t>   clientIds;
+    size_t                  idx         = 0U;
+
+    {
+        WEBSOCKET_LOCK();
+
+        for(idx = 0U; idx < m_clientQueues.size(); ++idx)
+        {
+            if (false == m_clientQueues[idx]->msgs.empty())
+            {
+                clientIds.push_back(m_clientQueues[idx]->clientId);
+            }
+        }
+    }
+
+    for(idx = 0U; idx < clientIds.size(); ++idx)
+    {
+        bool isFinished = false;
+
+        while(false == isFinished)
+        {
+            /* The client is destroyed by the websocket in the context of the
+             * TCP task, right after the disconnect event. The disconnect
+             * event removes the client queue under the same lock, therefore
+             * the client is alive as long as its queue exists and the lock
+             * is held. The lock is recursive, so the websocket may call back
+             * into the websocket server during sending.
+             */
+            WEBSOCKET_LOCK();
+            ClientQueue*            queue   = getClientQueue(clientIds[idx]);
+            AsyncWebSocketClient*   client  = nullptr;
+
+            if (nullptr != queue)
+            {
+                client = m_webSocket.client(clientIds[idx]);
+            }
+
+            /* Backpressure: Leave it in the queue, until the client is able to take it. */
+            if ((nullptr == queue) ||
+                (true == queue->msgs.empty()) ||
+                (nullptr == client) ||
+                (WS_CONNECTED != client->status()) ||
+                (true == client->queueIsFull()))
+            {
+                isFinished = true;
+            }
+            else
+            {
+                Msg*        msg     = queue->msgs.front();
+                const void* vData   = msg->data.data();
+
+                queue->msgs.pop_front();
+                queue->size -= msg->data.size();
+
+                HeapAccounting::getInstance().released(HeapAccounting::TAG_WEBSOCKET, msg->data.size());
+
+                if (true == msg->isBinary)
+                {
+                    client->binary(static_cast<const char*>(vData), msg->data.size());
+                }
+                else
+                {
+                    client->text(static_cast<const char*>(vData), msg->data.size());
+                }
+
+                delete msg;
+            }
+        }
+    }
+}
+
+void WebSocketSrv::sendResponse(uint32_t clientId, const String& msg, CoalesceKey coalesceKey)
+{
+    Msg* queuedMsg = new(std::nothrow) Msg();
+
+    if (nullptr != queuedMsg)
+    {
+        const void*     vData   = msg.c_str();
+        const uint8_t*  data    = static_cast<const uint8_t*>(vData);
+
+        queuedMsg->coalesceKey = coalesceKey;
+
+        if (true == m_reqContext.isBinary)
+        {
+            FrameType   frameType   = FRAME_TYPE_ACK;
+            size_t      prefixLen   = 0U;
+
+            if (true == msg.startsWith(NACK_PREFIX))
+            {
+                frameType = FRAME_TYPE_NACK;
+                prefixLen = sizeof(NACK_PREFIX) - 1U;
+            }
+            else if (true == msg.startsWith(ACK_PREFIX))
+            {
+                prefixLen = sizeof(ACK_PREFIX) - 1U;
+            }
+            else
+            {
+                ;
+            }
+
+            /* The delimiter after the response code is not necessary in the binary protocol. */
+            if ((msg.length() > prefixLen) &&
+                (DELIMITER == msg[prefixLen]))
+            {
+                ++prefixLen;
+            }
+
+            createBinaryFrame(*queuedMsg, frameType, m_reqContext.cmdId, m_reqContext.reqId, &data[prefixLen], msg.length() - prefixLen);
+        }
+        else
+        {
+            queuedMsg->data.assign(data, data + msg.length());
+        }
+
+        enqueue(clientId, queuedMsg);
+    }
+}
+
+void WebSocketSrv::sendBinaryResponse(uint32_t clientId, const uint8_t* payload, size_t payloadSize, CoalesceKey coalesceKey)
+{
+    Msg* queuedMsg = new(std::nothrow) Msg();
+
+    if (nullptr != queuedMsg)
+    {
+        queuedMsg->coalesceKey = coalesceKey;
+
+        createBinaryFrame(*queuedMsg, FRAME_TYPE_ACK, m_reqContext.cmdId, m_reqContext.reqId, payload, payloadSize);
+        enqueue(clientId, queuedMsg);
+    }
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -183,6 +352,8 @@ void WebSocketSrv::init(AsyncWebServer& srv)
 
 void WebSocketSrv::onEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len)
 {
+    TRACE_SCOPE("ws.event");
+
     if ((nullptr == server) ||
         (nullptr == client))
     {
@@ -225,12 +396,59 @@ void WebSocketSrv::onConnect(AsyncWebSocket* server, AsyncWebSocketClient* clien
 {
     UTIL_NOT_USED(request);
 
+    {
+        WEBSOCKET_LOCK();
+
+        if (nullptr == getClientQueue(client->id()))
+        {
+            ClientQueue* queue = new(std::nothrow) ClientQueue(client->id());
+
+            if (nullptr != queue)
+            {
+                m_clientQueues.push_back(queue);
+            }
+        }
+    }
+
     LOG_INFO("ws[%s][%u] Client connected.", server->url(), client->id());
 }
 
 void WebSocketSrv::onDisconnect(AsyncWebSocket* server, AsyncWebSocketClient* client)
 {
-    LOG_INFO("ws[%s][%u] Client disconnected.", server->url(), client->id());
+    uint32_t dropped    = 0U;
+    uint32_t coalesced  = 0U;
+
+    {
+        WEBSOCKET_LOCK();
+        ClientQueueList::iterator it = m_clientQueues.begin();
+
+        while(m_clientQueues.end() != it)
+        {
+            ClientQueue* queue = *it;
+
+            if (client->id() == queue->clientId)
+            {
+                dropped     = queue->dropped;
+                coalesced   = queue->coalesced;
+
+                while(false == queue->msgs.empty())
+                {
+                    HeapAccounting::getInstance().released(HeapAccounting::TAG_WEBSOCKET, queue->msgs.front()->data.size());
+                    delete queue->msgs.front();
+                    queue->msgs.pop_front();
+                }
+
+                delete queue;
+                it = m_clientQueues.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    LOG_INFO("ws[%s][%u] Client disconnected (dropped: %u, superseded: %u).", server->url(), client->id(), dropped, coalesced);
 }
 
 void WebSocketSrv::onPong(AsyncWebSocket* server, AsyncWebSocketClient* client, uint8_t* data, size_t len)
@@ -267,8 +485,9 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
         LOG_ERROR("ws[%s][%u] Frame info is missing.", server->url(), client->id());
         server->close(client->id(), 0U, "Frame info is missing.");
     }
-    /* No text frame? */
-    else if (WS_TEXT != info->opcode)
+    /* No text or binary frame? */
+    else if ((WS_TEXT != info->opcode) &&
+             (WS_BINARY != info->opcode))
     {
         LOG_ERROR("ws[%s][%u] Not supported message type received: %u", server->url(), client->id(), info->opcode);
         server->close(client->id(), 0U, "Not supported message type.");
@@ -278,12 +497,17 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
              (0U == info->index) &&
              (len == info->len ))
     {
-        /* Empty text message? */
+        /* Empty message? */
         if ((nullptr == data) ||
             (0U == len))
         {
             LOG_WARNING("ws[%s][%u] Message: -", server->url(), client->id());
         }
+        /* Handle binary message */
+        else if (WS_BINARY == info->opcode)
+        {
+            handleBinaryMsg(server, client, data, len);
+        }
         /* Handle text message */
         else
         {
@@ -307,7 +531,6 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
     const char* cmd         = nullptr;
     size_t      cmdLength   = 0U;
     WsCmd*      wsCmd       = nullptr;
-    const char  DELIMITER   = ';';
 
     if ((nullptr == server) ||
         (nullptr == client) ||
@@ -334,24 +557,16 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
     /* Command string not empty? */
     if (0 < cmdLength)
     {
-        uint8_t index = 0U;
+        wsCmd = findCmd(cmd, cmdLength);
 
-        /* Find command object */
-        while((nullptr == wsCmd) && (index < UTIL_ARRAY_NUM(gWsCommands)))
-        {
-            /* Note, cmd is NOT terminated! */
-            if (0 == strncmp(gWsCommands[index]->getCmd(), cmd, cmdLength))
-            {
-                wsCmd = gWsCommands[index];
-            }
-
-            ++index;
-        }
+        m_reqContext.isBinary   = false;
+        m_reqContext.cmdId      = 0U;
+        m_reqContext.reqId      = 0U;
 
         /* Command not found? */
         if (nullptr == wsCmd)
         {
-            client->text("NACK;\"Command unknown.\"");
+            sendResponse(client->id(), "NACK;\"Command unknown.\"");
         }
         else
         {
@@ -359,42 +574,293 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
             if ((msgLen > msgIndex) &&
                 (DELIMITER == msg[msgIndex]))
             {
-                const char* par;
-                size_t      parLength;
-                String      parStr;
-
                 /* Overstep delimiter */
                 ++msgIndex;
 
-                par = &msg[msgIndex];
-                parLength = 0U;
-                while(msgLen > msgIndex)
-                {
-                    if (DELIMITER == msg[msgIndex])
-                    {
-                        parStr = String(par, parLength);
+                setPars(wsCmd, &msg[msgIndex], msgLen - msgIndex);
+            }
+
+            /* Execute command (attention, its called in callback context). */
+            wsCmd->execute(server, client);
+        }
+    }
+}
+
+void WebSocketSrv::handleBinaryMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen)
+{
+    if ((nullptr == server) ||
+        (nullptr == client) ||
+        (nullptr == msg))
+    {
+        return;
+    }
 
-                        wsCmd->setPar(parStr.c_str());
+    if ((FRAME_HEADER_SIZE > msgLen) ||
+        (FRAME_TYPE_REQ != msg[0U]))
+    {
+        LOG_WARNING("ws[%s][%u] Invalid binary frame.", server->url(), client->id());
+    }
+    else
+    {
+        WsCmd* wsCmd = findCmd(msg[1U]);
 
-                        par = &msg[msgIndex + 1U];
-                        parLength = 0U;
-                    }
-                    else
-                    {
-                        ++parLength;
-                    }
+        /* From now on the client gets all messages in binary frames. */
+        {
+            WEBSOCKET_LOCK();
+            ClientQueue* queue = getClientQueue(client->id());
 
-                    ++msgIndex;
-                }
+            if (nullptr != queue)
+            {
+                queue->isBinary = true;
+            }
+        }
+
+        m_reqContext.isBinary   = true;
+        m_reqContext.cmdId      = msg[1U];
+        m_reqContext.reqId      = static_cast<uint16_t>(msg[2U]) | (static_cast<uint16_t>(msg[3U]) << 8U);
+
+        /* Command not found? */
+        if (nullptr == wsCmd)
+        {
+            sendResponse(client->id(), "NACK;\"Command unknown.\"");
+        }
+        else
+        {
+            if (FRAME_HEADER_SIZE < msgLen)
+            {
+                const void* vData = &msg[FRAME_HEADER_SIZE];
 
-                parStr = String(par, parLength);
-                wsCmd->setPar(parStr.c_str());
+                setPars(wsCmd, static_cast<const char*>(vData), msgLen - FRAME_HEADER_SIZE);
             }
 
             /* Execute command (attention, its called in callback context). */
             wsCmd->execute(server, client);
         }
+
+        m_reqContext.isBinary   = false;
+        m_reqContext.cmdId      = 0U;
+        m_reqContext.reqId      = 0U;
+    }
+}
+
+WsCmd* WebSocketSrv::findCmd(const char* cmd, size_t cmdLength)
+{
+    WsCmd*  wsCmd = nullptr;
+    uint8_t index = 0U;
+
+    while((nullptr == wsCmd) && (index < UTIL_ARRAY_NUM(gWsCommands)))
+    {
+        /* Note, cmd is NOT terminated! */
+        if (0 == strncmp(gWsCommands[index].cmd->getCmd(), cmd, cmdLength))
+        {
+            wsCmd = gWsCommands[index].cmd;
+        }
+
+        ++index;
     }
+
+    return wsCmd;
+}
+
+WsCmd* WebSocketSrv::findCmd(uint8_t cmdId)
+{
+    WsCmd*  wsCmd = nullptr;
+    uint8_t index = 0U;
+
+    while((nullptr == wsCmd) && (index < UTIL_ARRAY_NUM(gWsCommands)))
+    {
+        if (cmdId == gWsCommands[index].id)
+        {
+            wsCmd = gWsCommands[index].cmd;
+        }
+
+        ++index;
+    }
+
+    return wsCmd;
+}
+
+void WebSocketSrv::setPars(WsCmd* wsCmd, const char* par, size_t parLength)
+{
+    size_t      index       = 0U;
+    size_t      parStart    = 0U;
+    String      parStr;
+
+    while(parLength > index)
+    {
+        if (DELIMITER == par[index])
+        {
+            parStr = String(&par[parStart], index - parStart);
+            wsCmd->setPar(parStr.c_str());
+
+            parStart = index + 1U;
+        }
+
+        ++index;
+    }
+
+    parStr = String(&par[parStart], parLength - parStart);
+    wsCmd->setPar(parStr.c_str());
+}
+
+WebSocketSrv::ClientQueue* WebSocketSrv::getClientQueue(uint32_t clientId)
+{
+    ClientQueue*    queue   = nullptr;
+    size_t          idx     = 0U;
+
+    while((nullptr == queue) && (m_clientQueues.size() > idx))
+    {
+        if (clientId == m_clientQueues[idx]->clientId)
+        {
+            queue = m_clientQueues[idx];
+        }
+
+        ++idx;
+    }
+
+    return queue;
+}
+
+void WebSocketSrv::createBinaryFrame(Msg& msg, FrameType frameType, uint8_t cmdId, uint16_t reqId, const uint8_t* payload, size_t payloadSize)
+{
+    msg.isBinary    = true;
+    msg.cmdId       = cmdId;
+    msg.reqId       = reqId;
+
+    msg.data.clear();
+    msg.data.reserve(FRAME_HEADER_SIZE + payloadSize);
+    msg.data.push_back(static_cast<uint8_t>(frameType));
+    msg.data.push_back(cmdId);
+    msg.data.push_back(static_cast<uint8_t>(reqId & 0xffU));
+    msg.data.push_back(static_cast<uint8_t>((reqId >> 8U) & 0xffU));
+
+    if ((nullptr != payload) &&
+        (0U < payloadSize))
+    {
+        msg.data.insert(msg.data.end(), payload, payload + payloadSize);
+    }
+}
+
+void WebSocketSrv::enqueue(uint32_t clientId, Msg* msg)
+{
+    WEBSOCKET_LOCK();
+    ClientQueue* queue = getClientQueue(clientId);
+
+    if (nullptr == queue)
+    {
+        delete msg;
+    }
+    else
+    {
+        enqueue(*queue, msg);
+    }
+}
+
+void WebSocketSrv::enqueue(ClientQueue& queue, Msg* msg)
+{
+    /* Supersede an already queued message of the same kind. It is replaced
+     * by a negative response, so a pipelining client still gets a response
+     * for every request.
+     */
+    if (COALESCE_KEY_NONE != msg->coalesceKey)
+    {
+        std::deque<Msg*>::iterator it = queue.msgs.begin();
+
+        while(queue.msgs.end() != it)
+        {
+            Msg* queuedMsg = *it;
+
+            if (msg->coalesceKey == queuedMsg->coalesceKey)
+            {
+                const void*     vRsp    = SUPERSEDED_RSP;
+                const uint8_t*  rsp     = static_cast<const uint8_t*>(vRsp);
+
+                queue.size -= queuedMsg->data.size();
+                HeapAccounting::getInstance().released(HeapAccounting::TAG_WEBSOCKET, queuedMsg->data.size());
+
+                if (true == queuedMsg->isBinary)
+                {
+                    createBinaryFrame(*queuedMsg, FRAME_TYPE_NACK, queuedMsg->cmdId, queuedMsg->reqId, rsp, sizeof(SUPERSEDED_RSP) - 1U);
+                }
+                else
+                {
+                    String nack = NACK_PREFIX;
+
+                    nack += DELIMITER;
+                    nack += SUPERSEDED_RSP;
+
+                    queuedMsg->data.assign(nack.c_str(), nack.c_str() + nack.length());
+                }
+
+                queuedMsg->coalesceKey  = COALESCE_KEY_NONE;
+                queue.size              += queuedMsg->data.size();
+                HeapAccounting::getInstance().allocated(HeapAccounting::TAG_WEBSOCKET, queuedMsg->data.size());
+
+                ++queue.coalesced;
+                ++m_coalescedMsgCount;
+            }
+
+            ++it;
+        }
+    }
+
+    /* A single message is always accepted, otherwise a large message would never be sent. */
+    if ((false == queue.msgs.empty()) &&
+        ((CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_MSGS <= queue.msgs.size()) ||
+         (CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_SIZE < (queue.size + msg->data.size()))))
+    {
+        /* Note, no logging here, because the log messages itself may be sent via websocket. */
+        ++queue.dropped;
+        ++m_droppedMsgCount;
+
+        delete msg;
+    }
+    else
+    {
+        queue.size += msg->data.size();
+        queue.msgs.push_back(msg);
+
+        HeapAccounting::getInstance().allocated(HeapAccounting::TAG_WEBSOCKET, msg->data.size());
+    }
+}
+
+size_t WebSocketSrv::write(const uint8_t* buffer, size_t size)
+{
+    WEBSOCKET_LOCK();
+    size_t idx = 0U;
+
+    for(idx = 0U; idx < m_clientQueues.size(); ++idx)
+    {
+        ClientQueue*    queue   = m_clientQueues[idx];
+        Msg*            msg     = new(std::nothrow) Msg();
+
+        if (nullptr == msg)
+        {
+            ++queue->dropped;
+            ++m_droppedMsgCount;
+        }
+        else
+        {
+            const size_t    EVT_PREFIX_LEN  = sizeof(EVT_PREFIX) - 1U;
+            const void*     vPrefix         = EVT_PREFIX;
+
+            /* Binary client gets the event without text prefix in a binary frame. */
+            if ((true == queue->isBinary) &&
+                (EVT_PREFIX_LEN <= size) &&
+                (0 == memcmp(buffer, vPrefix, EVT_PREFIX_LEN)))
+            {
+                createBinaryFrame(*msg, FRAME_TYPE_EVT, 0U, 0U, &buffer[EVT_PREFIX_LEN], size - EVT_PREFIX_LEN);
+            }
+            else
+            {
+                msg->data.assign(buffer, buffer + size);
+            }
+
+            enqueue(*queue, msg);
+        }
+    }
+
+    return size;
 }
 
 /******************************************************************************
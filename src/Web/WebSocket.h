@@ -40,12 +40,30 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Max. number of messages, which are queued per websocket client.
+ */
+#ifndef CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_MSGS
+#define CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_MSGS  (8U)
+#endif /* CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_MSGS */
+
+/**
+ * Max. number of bytes, which are queued per websocket client.
+ * A single message is always accepted in an empty queue, even if it is larger.
+ */
+#ifndef CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_SIZE
+#define CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_SIZE  (16384U)
+#endif /* CONFIG_WEBSOCKET_CLIENT_QUEUE_MAX_SIZE */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <ESPAsyncWebServer.h>
 #include <stdint.h>
 #include <Print.h>
+#include <Mutex.hpp>
+#include <deque>
+#include <vector>
 
 #include "WebConfig.h"
 
@@ -57,13 +75,53 @@
  * Types and Classes
  *****************************************************************************/
 
+class WsCmd;
+
 /**
  * Websocket server
+ *
+ * It supports two protocols, which are selected by the frame type the
+ * client sends:
+ * - Text: "<command>;<par>;<par>..." with response "ACK;..." or "NACK;...".
+ * - Binary: 4 byte header (frame type, command id, request id as uint16_t
+ *   little endian) followed by the payload. The request id is mirrored in
+ *   the response, which allows the client to pipeline requests.
+ *
+ * All outgoing messages are queued per client and sent as long as the
+ * client is able to take them. If the queue of a slow client is full, further
+ * messages are dropped. A queued message, which is superseded by a newer one
+ * of the same kind (e.g. a display frame), is replaced by a small negative
+ * response.
  */
 class WebSocketSrv : public Print
 {
 public:
 
+    /**
+     * Binary protocol frame types.
+     */
+    enum FrameType
+    {
+        FRAME_TYPE_REQ  = 1U,   /**< Request (client to server) */
+        FRAME_TYPE_ACK  = 2U,   /**< Positive response */
+        FRAME_TYPE_NACK = 3U,   /**< Negative response */
+        FRAME_TYPE_EVT  = 4U    /**< Event (server to client) */
+    };
+
+    /**
+     * Keys of messages, which supersede the already queued message with the same key.
+     */
+    enum CoalesceKey
+    {
+        COALESCE_KEY_NONE = 0U, /**< Never superseded */
+        COALESCE_KEY_DISPLAY    /**< Display frame */
+    };
+
+    /**
+     * Binary protocol frame header size in byte.
+     */
+    static const size_t FRAME_HEADER_SIZE = 4U;
+
     /**
      * Get websocket server instance.
      *
@@ -83,16 +141,152 @@ public:
      */
     void init(AsyncWebServer& srv);
 
+    /**
+     * Send queued messages to the clients, as long as they are able to take them.
+     * Call it periodically.
+     */
+    void process();
+
+    /**
+     * Send a response of the currently executed command to the client.
+     * For a binary client, the text response is converted to a binary frame.
+     *
+     * @param[in] clientId      Id of the websocket client
+     * @param[in] msg           Response message ("ACK;..." or "NACK;...")
+     * @param[in] coalesceKey   Key of the message, used to supersede an already queued one.
+     */
+    void sendResponse(uint32_t clientId, const String& msg, CoalesceKey coalesceKey = COALESCE_KEY_NONE);
+
+    /**
+     * Send a binary positive response of the currently executed command to the client.
+     *
+     * @param[in] clientId      Id of the websocket client
+     * @param[in] payload       Response payload
+     * @param[in] payloadSize   Response payload size in byte
+     * @param[in] coalesceKey   Key of the message, used to supersede an already queued one.
+     */
+    void sendBinaryResponse(uint32_t clientId, const uint8_t* payload, size_t payloadSize, CoalesceKey coalesceKey = COALESCE_KEY_NONE);
+
+    /**
+     * Is the currently executed command requested via binary protocol?
+     *
+     * @return If binary, it will return true otherwise false.
+     */
+    bool isBinaryRequest() const
+    {
+        return m_reqContext.isBinary;
+    }
+
+    /**
+     * Get the number of messages, which were dropped because of full client queues.
+     *
+     * @return Number of dropped messages
+     */
+    uint32_t getDroppedMsgCount() const
+    {
+        return m_droppedMsgCount;
+    }
+
+    /**
+     * Get the number of queued messages, which were superseded by newer ones.
+     *
+     * @return Number of superseded messages
+     */
+    uint32_t getCoalescedMsgCount() const
+    {
+        return m_coalescedMsgCount;
+    }
+
 private:
 
-    AsyncWebSocket  m_webSocket;    /**< Websocket */
+    /**
+     * A queued outgoing message.
+     */
+    struct Msg
+    {
+        bool                    isBinary;       /**< Binary or text frame */
+        CoalesceKey             coalesceKey;    /**< Key to supersede the message */
+        uint8_t                 cmdId;          /**< Binary: Command id of the response */
+        uint16_t                reqId;          /**< Binary: Request id of the response */
+        std::vector<uint8_t>    data;           /**< Frame data */
+
+        /**
+         * Constructs a message.
+         */
+        Msg() :
+            isBinary(false),
+            coalesceKey(COALESCE_KEY_NONE),
+            cmdId(0U),
+            reqId(0U),
+            data()
+        {
+        }
+    };
+
+    /**
+     * The send queue of a single client.
+     */
+    struct ClientQueue
+    {
+        uint32_t            clientId;   /**< Id of the websocket client */
+        bool                isBinary;   /**< Client uses the binary protocol */
+        std::deque<Msg*>    msgs;       /**< Queued messages */
+        size_t              size;       /**< Size of all queued messages in byte */
+        uint32_t            dropped;    /**< Number of dropped messages */
+        uint32_t            coalesced;  /**< Number of superseded messages */
+
+        /**
+         * Constructs a client queue.
+         *
+         * @param[in] id    Id of the websocket client
+         */
+        explicit ClientQueue(uint32_t id) :
+            clientId(id),
+            isBinary(false),
+            msgs(),
+            size(0U),
+            dropped(0U),
+            coalesced(0U)
+        {
+        }
+    };
+
+    /**
+     * The context of the currently executed command.
+     */
+    struct ReqContext
+    {
+        bool        isBinary;   /**< Requested via binary protocol */
+        uint8_t     cmdId;      /**< Binary: Command id */
+        uint16_t    reqId;      /**< Binary: Request id */
+    };
+
+    /** List of client queues */
+    typedef std::vector<ClientQueue*> ClientQueueList;
+
+    AsyncWebSocket          m_webSocket;            /**< Websocket */
+    mutable MutexRecursive  m_mutex;                /**< Protects the client queues against concurrent access. */
+    ClientQueueList         m_clientQueues;         /**< Send queue per client */
+    ReqContext              m_reqContext;           /**< Context of the currently executed command */
+    uint32_t                m_droppedMsgCount;      /**< Number of dropped messages of all clients */
+    uint32_t                m_coalescedMsgCount;    /**< Number of superseded messages of all clients */
 
     /**
      * Constructs the websocket server.
      */
     WebSocketSrv() :
-        m_webSocket(WebConfig::WEBSOCKET_PATH)
+        m_webSocket(WebConfig::WEBSOCKET_PATH),
+        m_mutex(),
+        m_clientQueues(),
+        m_reqContext(),
+        m_droppedMsgCount(0U),
+        m_coalescedMsgCount(0U)
     {
+        m_reqContext.isBinary   = false;
+        m_reqContext.cmdId      = 0U;
+        m_reqContext.reqId      = 0U;
+
+        (void)m_mutex.create();
     }
 
     /**
@@ -100,8 +294,12 @@ private:
      */
     ~WebSocketSrv()
     {
+        m_mutex.destroy();
     }
 
+    WebSocketSrv(const WebSocketSrv& srv);
+    WebSocketSrv& operator=(const WebSocketSrv& srv);
+
     /**
      * Websocket event handler.
      *
@@ -173,6 +371,82 @@ private:
      */
     void handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen);
 
+    /**
+     * Handle a binary websocket message.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Weboscket client
+     * @param[in] msg       Websocket message
+     * @param[in] msgLen    Websocket message length
+     */
+    void handleBinaryMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen);
+
+    /**
+     * Find websocket command by its name.
+     *
+     * @param[in] cmd       Command name (not '\0' terminated)
+     * @param[in] cmdLength Command name length
+     *
+     * @return If found, it will return the command otherwise nullptr.
+     */
+    WsCmd* findCmd(const char* cmd, size_t cmdLength);
+
+    /**
+     * Find websocket command by its binary protocol id.
+     *
+     * @param[in] cmdId Command id
+     *
+     * @return If found, it will return the command otherwise nullptr.
+     */
+    WsCmd* findCmd(uint8_t cmdId);
+
+    /**
+     * Set the command parameters, which are separated by delimiter.
+     *
+     * @param[in] wsCmd     Websocket command
+     * @param[in] par       Parameters (not '\0' terminated)
+     * @param[in] parLength Parameters length
+     */
+    void setPars(WsCmd* wsCmd, const char* par, size_t parLength);
+
+    /**
+     * Get the send queue of a client. Call it only with locked mutex.
+     *
+     * @param[in] clientId  Id of the websocket client
+     *
+     * @return If found, it will return the client queue otherwise nullptr.
+     */
+    ClientQueue* getClientQueue(uint32_t clientId);
+
+    /**
+     * Create a binary frame.
+     *
+     * @param[out] msg          Message, which contains the frame afterwards.
+     * @param[in]  frameType    Frame type
+     * @param[in]  cmdId        Command id
+     * @param[in]  reqId        Request id
+     * @param[in]  payload      Payload
+     * @param[in]  payloadSize  Payload size in byte
+     */
+    static void createBinaryFrame(Msg& msg, FrameType frameType, uint8_t cmdId, uint16_t reqId, const uint8_t* payload, size_t payloadSize);
+
+    /**
+     * Queue a message for a client. The message is taken over and will be
+     * destroyed, if it can not be queued.
+     *
+     * @param[in] clientId  Id of the websocket client
+     * @param[in] msg       Message
+     */
+    void enqueue(uint32_t clientId, Msg* msg);
+
+    /**
+     * Queue a message for a client. Call it only with locked mutex.
+     *
+     * @param[in] queue     Client queue
+     * @param[in] msg       Message
+     */
+    void enqueue(ClientQueue& queue, Msg* msg);
+
     /**
      * Write single data byte to all clients.
      *
@@ -182,23 +456,18 @@ private:
      */
     size_t write(uint8_t data) final
     {
-        m_webSocket.textAll(&data, 1);
-        return 1;
+        return write(&data, 1U);
     }
 
     /**
-     * Write data to all clients.
+     * Write data to all clients. It is used to send events, e.g. log messages.
      *
      * @param[in] buffer    Data buffer
      * @param[in] size      Data buffer size
      *
      * @return Number of written bytes.
      */
-    size_t write(const uint8_t* buffer, size_t size) final
-    {
-        m_webSocket.textAll(const_cast<uint8_t*>(buffer), size);
-        return size;
-    }
+    size_t write(const uint8_t* buffer, size_t size) final;
 };
 
 /******************************************************************************
@@ -85,7 +85,7 @@ void WsCmd::sendPositiveResponse(AsyncWebSocket* server, AsyncWebSocketClient* c
             rsp += msg;
         }
 
-        server->text(client->id(), rsp);
+        WebSocketSrv::getInstance().sendResponse(client->id(), rsp);
     }
 }
 
@@ -113,7 +113,7 @@ void WsCmd::sendNegativeResponse(AsyncWebSocket* server, AsyncWebSocketClient* c
             rsp += "\"Unknown.\"";
         }
 
-        server->text(client->id(), rsp);
+        WebSocketSrv::getInstance().sendResponse(client->id(), rsp);
     }
 }
 
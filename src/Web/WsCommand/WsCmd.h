@@ -45,6 +45,8 @@
  *****************************************************************************/
 #include <ESPAsyncWebServer.h>
 
+#include "WebSocket.h"
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -137,16 +139,46 @@ protected:
         msg += DELIMITER;
     }
 
+    /**
+     * Is the command requested via binary protocol?
+     * 
+     * @return If binary, it will return true otherwise false.
+     */
+    bool isBinaryRequest() const
+    {
+        return WebSocketSrv::getInstance().isBinaryRequest();
+    }
+
     /**
      * Send a response to the client.
      * 
-     * @param[in] server    Websocket server which is used to send a message to the client.
-     * @param[in] client    The client the message belongs to.
-     * @param[in] msg       The response messsage.
+     * @param[in] server        Websocket server which is used to send a message to the client.
+     * @param[in] client        The client the message belongs to.
+     * @param[in] msg           The response messsage.
+     * @param[in] coalesceKey   Key of the response, used to supersede an already queued one.
      */
-    void sendResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& msg)
+    void sendResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& msg, WebSocketSrv::CoalesceKey coalesceKey = WebSocketSrv::COALESCE_KEY_NONE)
     {
-        server->text(client->id(), msg);
+        (void)server;
+
+        WebSocketSrv::getInstance().sendResponse(client->id(), msg, coalesceKey);
+    }
+
+    /**
+     * Send a binary positive response to the client.
+     * Use it only, if the command is requested via binary protocol.
+     * 
+     * @param[in] server        Websocket server which is used to send a message to the client.
+     * @param[in] client        The client the message belongs to.
+     * @param[in] payload       The response payload.
+     * @param[in] payloadSize   The response payload size in byte.
+     * @param[in] coalesceKey   Key of the response, used to supersede an already queued one.
+     */
+    void sendBinaryResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* payload, size_t payloadSize, WebSocketSrv::CoalesceKey coalesceKey = WebSocketSrv::COALESCE_KEY_NONE)
+    {
+        (void)server;
+
+        WebSocketSrv::getInstance().sendBinaryResponse(client->id(), payload, payloadSize, coalesceKey);
     }
 
     /**
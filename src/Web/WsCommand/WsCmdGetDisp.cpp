@@ -86,6 +86,50 @@ void WsCmdGetDisp::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
         {
             sendNegativeResponse(server, client, "\"Internal error.\"");
         }
+        else if (true == isBinaryRequest())
+        {
+            /* Binary payload: slot id (uint8_t), width and height (uint16_t),
+             * followed by the colors (uint32_t), all little endian.
+             */
+            const size_t    HEADER_SIZE = 5U;
+            size_t          payloadSize = HEADER_SIZE + fbLength * sizeof(uint32_t);
+            uint8_t*        payload     = new(std::nothrow) uint8_t[payloadSize];
+
+            if (nullptr == payload)
+            {
+                sendNegativeResponse(server, client, "\"Internal error.\"");
+            }
+            else
+            {
+                uint32_t    index       = 0U;
+                uint8_t     slotId      = SlotList::SLOT_ID_INVALID;
+                uint8_t*    pixel       = &payload[HEADER_SIZE];
+
+                DisplayMgr::getInstance().getFBCopy(framebuffer, fbLength, &slotId);
+
+                payload[0U] = slotId;
+                payload[1U] = static_cast<uint8_t>(display.getWidth() & 0xffU);
+                payload[2U] = static_cast<uint8_t>((display.getWidth() >> 8U) & 0xffU);
+                payload[3U] = static_cast<uint8_t>(display.getHeight() & 0xffU);
+                payload[4U] = static_cast<uint8_t>((display.getHeight() >> 8U) & 0xffU);
+
+                for(index = 0U; index < fbLength; ++index)
+                {
+                    pixel[0U] = static_cast<uint8_t>(framebuffer[index] & 0xffU);
+                    pixel[1U] = static_cast<uint8_t>((framebuffer[index] >> 8U) & 0xffU);
+                    pixel[2U] = static_cast<uint8_t>((framebuffer[index] >> 16U) & 0xffU);
+                    pixel[3U] = static_cast<uint8_t>((framebuffer[index] >> 24U) & 0xffU);
+
+                    pixel += sizeof(uint32_t);
+                }
+
+                sendBinaryResponse(server, client, payload, payloadSize, WebSocketSrv::COALESCE_KEY_DISPLAY);
+
+                delete[] payload;
+            }
+
+            delete[] framebuffer;
+        }
         else
         {
             uint32_t    index       = 0U;
@@ -110,7 +154,7 @@ void WsCmdGetDisp::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
 
             delete[] framebuffer;
             
-            sendResponse(server, client, msg);
+            sendResponse(server, client, msg, WebSocketSrv::COALESCE_KEY_DISPLAY);
         }
     }
 
@@ -179,6 +179,12 @@ void setup()
     /* Set severity for Pixelix logging system. */
     Logging::getInstance().setLogLevel(CONFIG_LOG_SEVERITY);
 
+    /* Send the log messages by a low priority task, to keep the timing of the logging tasks. */
+    if (false == Logging::getInstance().startAsync())
+    {
+        LOG_WARNING("Logging stays synchronous.");
+    }
+
     /* The setup routine shall handle only the initialization state.
      * All other states are handled in the loop routine.
      */
@@ -211,6 +217,9 @@ void loop()
     /* Memory monitor */
     MemMon::getInstance().process();
 
+    /* Send queued websocket messages */
+    WebSocketSrv::getInstance().process();
+
     /* Process terminal */
     gTerminal.process();
 
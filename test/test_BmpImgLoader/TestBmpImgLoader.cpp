@@ -54,7 +54,9 @@
  * Prototypes
  *****************************************************************************/
 
+static void verifyPaletteTestImage(const YAGfxDynamicBitmap& bitmap, const uint32_t* expected);
 static void testBmpImgLoader();
+static void testBmpImgLoaderPalette();
 
 /******************************************************************************
  * Local Variables
@@ -90,6 +92,7 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testBmpImgLoader);
+    RUN_TEST(testBmpImgLoaderPalette);
 
     return UNITY_END();
 }
@@ -114,6 +117,31 @@ extern void tearDown(void)
  * Local Functions
  *****************************************************************************/
 
+/**
+ * Verify the loaded palette test image.
+ *
+ * @param[in] bitmap    Loaded bitmap
+ * @param[in] expected  Expected colors, row by row from top to bottom
+ */
+static void verifyPaletteTestImage(const YAGfxDynamicBitmap& bitmap, const uint32_t* expected)
+{
+    const uint16_t  WIDTH   = 7U;
+    const uint16_t  HEIGHT  = 4U;
+    uint16_t        x       = 0U;
+    uint16_t        y       = 0U;
+
+    TEST_ASSERT_EQUAL_UINT16(WIDTH, bitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(HEIGHT, bitmap.getHeight());
+
+    for(y = 0U; y < HEIGHT; ++y)
+    {
+        for(x = 0U; x < WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(expected[x + y * WIDTH], bitmap.getColor(x, y));
+        }
+    }
+}
+
 /**
  * Test bitmap image loader.
  */
@@ -159,3 +187,53 @@ static void testBmpImgLoader()
 
     return;
 }
+
+/**
+ * Test bitmap image loader with palette images, uncompressed and RLE compressed.
+ */
+static void testBmpImgLoaderPalette()
+{
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  bitmap;
+    FS                  localFileSystem;
+
+    /* All palette test images show the same 7x4 pixels, except the
+     * 1 bpp image, which has only 2 colors.
+     */
+    const uint32_t      EXPECTED[] =
+    {
+        0xff0000, 0xff0000, 0xff0000, 0x00ff00, 0x0000ff, 0xffffff, 0xffff00,
+        0x00ffff, 0xff00ff, 0x804020, 0x904824, 0xa05028, 0xb0582c, 0xc06030,
+        0xffffff, 0xffffff, 0xffffff, 0xffffff, 0xffffff, 0xffffff, 0xffffff,
+        0xd06834, 0xe07038, 0xf0783c, 0xff0000, 0xff0000, 0x00ff00, 0x00ff00
+    };
+    const uint32_t      EXPECTED_1BPP[] =
+    {
+        0xff0000, 0xff0000, 0xff0000, 0x000000, 0xff0000, 0x000000, 0xff0000,
+        0x000000, 0xff0000, 0x000000, 0xff0000, 0x000000, 0xff0000, 0x000000,
+        0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+        0xff0000, 0x000000, 0xff0000, 0xff0000, 0xff0000, 0x000000, 0x000000
+    };
+
+    /* 1 bpp, no compression */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test1bpp.bmp", bitmap));
+    verifyPaletteTestImage(bitmap, EXPECTED_1BPP);
+
+    /* 4 bpp, no compression */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test4bpp.bmp", bitmap));
+    verifyPaletteTestImage(bitmap, EXPECTED);
+
+    /* 8 bpp, no compression */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test8bpp.bmp", bitmap));
+    verifyPaletteTestImage(bitmap, EXPECTED);
+
+    /* 4 bpp, RLE4 compression with encoded and absolute mode (odd number of pixels) */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/testRle4.bmp", bitmap));
+    verifyPaletteTestImage(bitmap, EXPECTED);
+
+    /* 8 bpp, RLE8 compression with encoded and absolute mode (odd number of pixels) */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/testRle8.bmp", bitmap));
+    verifyPaletteTestImage(bitmap, EXPECTED);
+
+    return;
+}
@@ -0,0 +1,191 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test configuration change notifier.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <ConfigChangeNotifier.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Test listener, which counts the notifications.
+ */
+class TestListener : public ConfigChangeNotifier::Listener
+{
+public:
+
+    /**
+     * Constructs the test listener.
+     */
+    TestListener() :
+        ConfigChangeNotifier::Listener(),
+        m_cnt(0U),
+        m_fullPath()
+    {
+    }
+
+    /**
+     * Destroys the test listener.
+     */
+    ~TestListener()
+    {
+    }
+
+    /**
+     * Configuration file was written or removed.
+     *
+     * @param[in] fullPath  Full path of the configuration file
+     */
+    void onConfigChanged(const String& fullPath) override
+    {
+        ++m_cnt;
+        m_fullPath = fullPath;
+    }
+
+    uint32_t    m_cnt;      /**< Number of notifications */
+    String      m_fullPath; /**< Full path of the last notification */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testConfigChangeNotifier();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testConfigChangeNotifier);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the configuration change notifier.
+ */
+static void testConfigChangeNotifier()
+{
+    ConfigChangeNotifier&   notifier    = ConfigChangeNotifier::getInstance();
+    TestListener            listenerA;
+    TestListener            listenerB;
+
+    /* Invalid registrations */
+    TEST_ASSERT_FALSE(notifier.registerListener("/configuration/1.json", nullptr));
+    TEST_ASSERT_FALSE(notifier.registerListener("", &listenerA));
+
+    TEST_ASSERT_TRUE(notifier.registerListener("/configuration/1.json", &listenerA));
+    TEST_ASSERT_TRUE(notifier.registerListener("/configuration/2.json", &listenerB));
+
+    /* Only the affected listener is notified. */
+    notifier.notify("/configuration/1.json");
+    TEST_ASSERT_EQUAL_UINT32(1U, listenerA.m_cnt);
+    TEST_ASSERT_EQUAL_STRING("/configuration/1.json", listenerA.m_fullPath.c_str());
+    TEST_ASSERT_EQUAL_UINT32(0U, listenerB.m_cnt);
+
+    /* Files without listener are ignored. */
+    notifier.notify("/configuration/3.json");
+    TEST_ASSERT_EQUAL_UINT32(1U, listenerA.m_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0U, listenerB.m_cnt);
+
+    /* A unregistered listener is not notified anymore. */
+    notifier.unregisterListener(&listenerA);
+    notifier.notify("/configuration/1.json");
+    notifier.notify("/configuration/2.json");
+    TEST_ASSERT_EQUAL_UINT32(1U, listenerA.m_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1U, listenerB.m_cnt);
+
+    notifier.unregisterListener(&listenerB);
+
+    return;
+}
@@ -0,0 +1,201 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test configuration snapshot.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <ConfigSnapshot.h>
+#include <ConfigChangeNotifier.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testConfigSnapshotBasePath();
+static void testConfigSnapshot();
+static void testConfigSnapshotMemoryLimit();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testConfigSnapshotBasePath);
+    RUN_TEST(testConfigSnapshot);
+    RUN_TEST(testConfigSnapshotMemoryLimit);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    ConfigSnapshot::getInstance().clear();
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the path handling, which ignores the file extension.
+ */
+static void testConfigSnapshotBasePath()
+{
+    TEST_ASSERT_EQUAL_STRING("/configuration/1", ConfigSnapshot::getBasePath("/configuration/1.json").c_str());
+    TEST_ASSERT_EQUAL_STRING("/configuration/1", ConfigSnapshot::getBasePath("/configuration/1.msgpack").c_str());
+    TEST_ASSERT_EQUAL_STRING("/configuration/1", ConfigSnapshot::getBasePath("/configuration/1").c_str());
+    TEST_ASSERT_EQUAL_STRING("/dir.d/file", ConfigSnapshot::getBasePath("/dir.d/file").c_str());
+}
+
+/**
+ * Test taking, getting and invalidating snapshots.
+ */
+static void testConfigSnapshot()
+{
+    ConfigSnapshot&         snapshot    = ConfigSnapshot::getInstance();
+    const size_t            DOC_SIZE    = 256U;
+    DynamicJsonDocument     doc(DOC_SIZE);
+    DynamicJsonDocument     loadedDoc(DOC_SIZE);
+
+    /* No snapshot available */
+    TEST_ASSERT_FALSE(snapshot.get("/configuration/1.json", loadedDoc));
+    TEST_ASSERT_EQUAL(0U, snapshot.getMemoryUsage());
+
+    doc["name"]     = "test";
+    doc["value"]    = 42;
+    snapshot.put("/configuration/1.json", doc);
+    
+    /* MessagePack is more compact than JSON. */
+    TEST_ASSERT_LESS_THAN(measureJson(doc), snapshot.getMemoryUsage());
+
+    /* The extension doesn't matter. */
+    TEST_ASSERT_TRUE(snapshot.get("/configuration/1.msgpack", loadedDoc));
+    TEST_ASSERT_EQUAL_STRING("test", loadedDoc["name"].as<const char*>());
+    TEST_ASSERT_EQUAL(42, loadedDoc["value"].as<int>());
+
+    /* Replace the snapshot. */
+    doc["value"] = 43;
+    snapshot.put("/configuration/1.json", doc);
+    TEST_ASSERT_TRUE(snapshot.get("/configuration/1.json", loadedDoc));
+    TEST_ASSERT_EQUAL(43, loadedDoc["value"].as<int>());
+
+    /* Another configuration is not affected. */
+    TEST_ASSERT_FALSE(snapshot.get("/configuration/2.json", loadedDoc));
+
+    /* A notified change invalidates the snapshot. */
+    ConfigChangeNotifier::getInstance().notify("/configuration/1.msgpack");
+    TEST_ASSERT_FALSE(snapshot.get("/configuration/1.json", loadedDoc));
+    TEST_ASSERT_EQUAL(0U, snapshot.getMemoryUsage());
+}
+
+/**
+ * Test that the memory limit is considered.
+ */
+static void testConfigSnapshotMemoryLimit()
+{
+    ConfigSnapshot&         snapshot    = ConfigSnapshot::getInstance();
+    const size_t            DOC_SIZE    = ConfigSnapshot::MEMORY_LIMIT + 256U;
+    DynamicJsonDocument     doc(DOC_SIZE);
+    DynamicJsonDocument     loadedDoc(DOC_SIZE);
+    String                  value;
+
+    /* A configuration, which is larger than the limit, is not kept. */
+    while(ConfigSnapshot::MEMORY_LIMIT >= value.length())
+    {
+        value += "0123456789";
+    }
+
+    doc["value"] = value.c_str();
+    snapshot.put("/configuration/1.json", doc);
+    TEST_ASSERT_FALSE(snapshot.get("/configuration/1.json", loadedDoc));
+    TEST_ASSERT_EQUAL(0U, snapshot.getMemoryUsage());
+
+    /* A small one is kept. */
+    doc.clear();
+    doc["value"] = 1;
+    snapshot.put("/configuration/1.json", doc);
+    TEST_ASSERT_TRUE(snapshot.get("/configuration/1.json", loadedDoc));
+    TEST_ASSERT_EQUAL(1, loadedDoc["value"].as<int>());
+}
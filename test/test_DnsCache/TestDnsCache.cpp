@@ -0,0 +1,220 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test DNS cache.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <DnsCache.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testDnsCache();
+static void testExpiry();
+static void testReplacement();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testDnsCache);
+    RUN_TEST(testExpiry);
+    RUN_TEST(testReplacement);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test adding, finding and invalidating resolved hostnames.
+ */
+static void testDnsCache()
+{
+    DnsCache    cache;
+    uint32_t    ipAddress   = 0U;
+
+    /* Empty cache */
+    TEST_ASSERT_FALSE(cache.find("example.com", ipAddress));
+    TEST_ASSERT_FALSE(cache.find("", ipAddress));
+
+    /* The hostname is case insensitive. */
+    cache.add("example.com", 0x0100007fU);
+    TEST_ASSERT_TRUE(cache.find("example.com", ipAddress));
+    TEST_ASSERT_EQUAL_UINT32(0x0100007fU, ipAddress);
+    ipAddress = 0U;
+    TEST_ASSERT_TRUE(cache.find("EXAMPLE.com", ipAddress));
+    TEST_ASSERT_EQUAL_UINT32(0x0100007fU, ipAddress);
+    TEST_ASSERT_FALSE(cache.find("example.org", ipAddress));
+
+    /* An already cached hostname is updated. */
+    cache.add("Example.com", 0x0200007fU);
+    TEST_ASSERT_TRUE(cache.find("example.com", ipAddress));
+    TEST_ASSERT_EQUAL_UINT32(0x0200007fU, ipAddress);
+
+    /* Invalidated hostname, e.g. after a connection error. */
+    cache.add("example.org", 0x0300007fU);
+    cache.invalidate("EXAMPLE.COM");
+    TEST_ASSERT_FALSE(cache.find("example.com", ipAddress));
+    TEST_ASSERT_TRUE(cache.find("example.org", ipAddress));
+    TEST_ASSERT_EQUAL_UINT32(0x0300007fU, ipAddress);
+
+    cache.clear();
+    TEST_ASSERT_FALSE(cache.find("example.org", ipAddress));
+
+    return;
+}
+
+/**
+ * Test that resolved hostnames expire.
+ */
+static void testExpiry()
+{
+    DnsCache    cache;
+    uint32_t    ipAddress   = 0U;
+
+    cache.add("example.com", 0x0100007fU);
+
+    advanceMillis(DnsCache::TIMEOUT / 2U);
+    TEST_ASSERT_TRUE(cache.find("example.com", ipAddress));
+
+    /* Adding it again, restarts the timeout. */
+    cache.add("example.com", 0x0100007fU);
+    advanceMillis(DnsCache::TIMEOUT / 2U);
+    TEST_ASSERT_TRUE(cache.find("example.com", ipAddress));
+
+    advanceMillis(DnsCache::TIMEOUT / 2U);
+    TEST_ASSERT_FALSE(cache.find("example.com", ipAddress));
+
+    return;
+}
+
+/**
+ * Test that the oldest hostname is replaced, if the cache is full.
+ */
+static void testReplacement()
+{
+    DnsCache    cache;
+    uint32_t    ipAddress   = 0U;
+    size_t      index       = 0U;
+    String      hostnames[DnsCache::MAX_ENTRIES];
+
+    for(index = 0U; index < DnsCache::MAX_ENTRIES; ++index)
+    {
+        hostnames[index] = "host";
+        hostnames[index] += static_cast<char>('a' + index);
+
+        cache.add(hostnames[index], static_cast<uint32_t>(index));
+        advanceMillis(1000U);
+    }
+
+    /* The first one is the oldest. */
+    cache.add("hostz", 0x0100007fU);
+    TEST_ASSERT_FALSE(cache.find(hostnames[0U], ipAddress));
+    TEST_ASSERT_TRUE(cache.find("hostz", ipAddress));
+    TEST_ASSERT_EQUAL_UINT32(0x0100007fU, ipAddress);
+
+    for(index = 1U; index < DnsCache::MAX_ENTRIES; ++index)
+    {
+        TEST_ASSERT_TRUE(cache.find(hostnames[index], ipAddress));
+        TEST_ASSERT_EQUAL_UINT32(index, ipAddress);
+    }
+
+    /* A free entry is used before the oldest one is replaced. */
+    cache.invalidate(hostnames[3U]);
+    cache.add("hosty", 0x0200007fU);
+    TEST_ASSERT_TRUE(cache.find(hostnames[1U], ipAddress));
+    TEST_ASSERT_TRUE(cache.find("hosty", ipAddress));
+
+    return;
+}
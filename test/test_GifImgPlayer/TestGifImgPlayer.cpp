@@ -0,0 +1,197 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test streaming GIF image player.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <FS.h>
+#include <GifImgPlayer.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testGifImgPlayer();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/**
+ * Test image, 4x4 pixels, 3 frames:
+ * 1. Red, 500 ms, restore to background afterwards.
+ * 2. 2x2 pixels at (1, 1): green, transparent, transparent, blue, no delay.
+ * 3. Interlaced rows: blue, green, red, black, 250 ms.
+ */
+static const char*  TEST_IMAGE  = "./test/test_GifImgPlayer/testAnim.gif";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testGifImgPlayer);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test streaming GIF image player.
+ */
+static void testGifImgPlayer()
+{
+    GifImgPlayer    player;
+    FS              localFileSystem;
+    uint8_t         loop    = 0U;
+
+    /* Signature detection */
+    TEST_ASSERT_TRUE(GifImgPlayer::isGifImg(reinterpret_cast<const uint8_t*>("GIF89a"), 6U));
+    TEST_ASSERT_TRUE(GifImgPlayer::isGifImg(reinterpret_cast<const uint8_t*>("GIF87a"), 6U));
+    TEST_ASSERT_FALSE(GifImgPlayer::isGifImg(reinterpret_cast<const uint8_t*>("GIF8"), 4U));
+    TEST_ASSERT_FALSE(GifImgPlayer::isGifImg(nullptr, 6U));
+
+    /* Not existing file and not supported file format */
+    TEST_ASSERT_FALSE(player.open(localFileSystem, "./test/test_GifImgPlayer/notExisting.gif"));
+    TEST_ASSERT_FALSE(player.isOpen());
+    TEST_ASSERT_FALSE(player.open(localFileSystem, "./test/test_BmpImgLoader/test24bpp.bmp"));
+    TEST_ASSERT_FALSE(player.isOpen());
+    TEST_ASSERT_FALSE(player.next());
+
+    /* The first frame is decoded by opening the image. */
+    TEST_ASSERT_TRUE(player.open(localFileSystem, TEST_IMAGE));
+    TEST_ASSERT_TRUE(player.isOpen());
+    TEST_ASSERT_EQUAL_UINT16(4, player.getFrame().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(4, player.getFrame().getHeight());
+
+    /* The animation is repeated after the last frame. */
+    for(loop = 0U; loop < 2U; ++loop)
+    {
+        if (0U < loop)
+        {
+            TEST_ASSERT_TRUE(player.next());
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(500U, player.getDelay());
+        TEST_ASSERT_EQUAL_UINT32(0xff0000, player.getFrame().getColor(0, 0));
+        TEST_ASSERT_EQUAL_UINT32(0xff0000, player.getFrame().getColor(3, 3));
+
+        /* The previous frame area was restored to background and transparent
+         * pixels keep the background.
+         */
+        TEST_ASSERT_TRUE(player.next());
+        TEST_ASSERT_EQUAL_UINT32(GifImgPlayer::DEFAULT_DELAY, player.getDelay());
+        TEST_ASSERT_EQUAL_UINT32(0x000000, player.getFrame().getColor(0, 0));
+        TEST_ASSERT_EQUAL_UINT32(0x00ff00, player.getFrame().getColor(1, 1));
+        TEST_ASSERT_EQUAL_UINT32(0x000000, player.getFrame().getColor(2, 1));
+        TEST_ASSERT_EQUAL_UINT32(0x000000, player.getFrame().getColor(1, 2));
+        TEST_ASSERT_EQUAL_UINT32(0x0000ff, player.getFrame().getColor(2, 2));
+
+        /* Interlaced rows are in the right order. */
+        TEST_ASSERT_TRUE(player.next());
+        TEST_ASSERT_EQUAL_UINT32(250U, player.getDelay());
+        TEST_ASSERT_EQUAL_UINT32(0x0000ff, player.getFrame().getColor(0, 0));
+        TEST_ASSERT_EQUAL_UINT32(0x00ff00, player.getFrame().getColor(1, 1));
+        TEST_ASSERT_EQUAL_UINT32(0xff0000, player.getFrame().getColor(2, 2));
+        TEST_ASSERT_EQUAL_UINT32(0x000000, player.getFrame().getColor(3, 3));
+    }
+
+    /* A copy starts with the first frame. */
+    {
+        GifImgPlayer copy(player);
+
+        TEST_ASSERT_TRUE(copy.isOpen());
+        TEST_ASSERT_EQUAL_UINT32(0xff0000, copy.getFrame().getColor(0, 0));
+    }
+
+    player.close();
+    TEST_ASSERT_FALSE(player.isOpen());
+    TEST_ASSERT_EQUAL_UINT16(0, player.getFrame().getWidth());
+
+    return;
+}
@@ -0,0 +1,190 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test heap accounting.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <HeapAccounting.hpp>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testAccounting();
+static void testFailures();
+static void testInvalidTag();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testAccounting);
+    RUN_TEST(testFailures);
+    RUN_TEST(testInvalidTag);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test accounting of allocations, releases and the high-water mark.
+ */
+static void testAccounting()
+{
+    HeapAccounting&         accounting  = HeapAccounting::getInstance();
+    HeapAccounting::Stats   stats;
+
+    TEST_ASSERT_TRUE(accounting.getStats(HeapAccounting::TAG_GFX, stats));
+    TEST_ASSERT_EQUAL(0U, stats.current);
+    TEST_ASSERT_EQUAL(0U, stats.peak);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.allocations);
+
+    accounting.allocated(HeapAccounting::TAG_GFX, 100U);
+    accounting.allocated(HeapAccounting::TAG_GFX, 50U);
+    accounting.released(HeapAccounting::TAG_GFX, 100U);
+
+    TEST_ASSERT_TRUE(accounting.getStats(HeapAccounting::TAG_GFX, stats));
+    TEST_ASSERT_EQUAL(50U, stats.current);
+    TEST_ASSERT_EQUAL(150U, stats.peak);
+    TEST_ASSERT_EQUAL_UINT32(2U, stats.allocations);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.failures);
+
+    /* A lower allocation level doesn't change the high-water mark. */
+    accounting.allocated(HeapAccounting::TAG_GFX, 20U);
+    TEST_ASSERT_TRUE(accounting.getStats(HeapAccounting::TAG_GFX, stats));
+    TEST_ASSERT_EQUAL(70U, stats.current);
+    TEST_ASSERT_EQUAL(150U, stats.peak);
+
+    /* Reset the high-water mark to the current level. */
+    accounting.resetPeaks();
+    TEST_ASSERT_TRUE(accounting.getStats(HeapAccounting::TAG_GFX, stats));
+    TEST_ASSERT_EQUAL(70U, stats.peak);
+
+    /* Other tags are not affected. */
+    TEST_ASSERT_TRUE(accounting.getStats(HeapAccounting::TAG_HTTP, stats));
+    TEST_ASSERT_EQUAL(0U, stats.current);
+    TEST_ASSERT_EQUAL(0U, stats.peak);
+}
+
+/**
+ * Test accounting of failed allocations.
+ */
+static void testFailures()
+{
+    HeapAccounting&         accounting  = HeapAccounting::getInstance();
+    HeapAccounting::Stats   stats;
+    int                     dummy       = 0;
+
+    accounting.track(HeapAccounting::TAG_JSON, nullptr, 4096U);
+    accounting.track(HeapAccounting::TAG_JSON, &dummy, 1024U);
+
+    TEST_ASSERT_TRUE(accounting.getStats(HeapAccounting::TAG_JSON, stats));
+    TEST_ASSERT_EQUAL(1024U, stats.current);
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.allocations);
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.failures);
+    TEST_ASSERT_EQUAL(4096U, stats.lastFailedSize);
+}
+
+/**
+ * Test invalid tag and tag names.
+ */
+static void testInvalidTag()
+{
+    HeapAccounting&         accounting  = HeapAccounting::getInstance();
+    HeapAccounting::Stats   stats;
+
+    TEST_ASSERT_FALSE(accounting.getStats(HeapAccounting::TAG_MAX, stats));
+    TEST_ASSERT_EQUAL_STRING("gfx", HeapAccounting::tagToStr(HeapAccounting::TAG_GFX));
+    TEST_ASSERT_EQUAL_STRING("websocket", HeapAccounting::tagToStr(HeapAccounting::TAG_WEBSOCKET));
+    TEST_ASSERT_EQUAL_STRING("unknown", HeapAccounting::tagToStr(HeapAccounting::TAG_MAX));
+}
@@ -0,0 +1,389 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test HTTP response cache.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <HttpCache.h>
+#include <Arduino.h>
+#include <Util.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testHttpCacheMaxAge();
+static void testHttpCacheRevalidation();
+static void testHttpCacheEviction();
+static void testHttpCacheMemoryLimit();
+static void testHttpCacheWriter();
+
+static String getUrl(size_t index);
+static bool readPayload(const String& url, uint8_t* buffer, size_t bufferSize, size_t& size);
+static void waitForNextTick();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testHttpCacheMaxAge);
+    RUN_TEST(testHttpCacheRevalidation);
+    RUN_TEST(testHttpCacheEviction);
+    RUN_TEST(testHttpCacheMemoryLimit);
+    RUN_TEST(testHttpCacheWriter);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    HttpCache::getInstance().clear();
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the freshness of cached responses, given by the max. age.
+ */
+static void testHttpCacheMaxAge()
+{
+    HttpCache&      cache       = HttpCache::getInstance();
+    const uint8_t   PAYLOAD[]   = { 1U, 2U, 3U, 4U };
+    uint8_t         buffer[sizeof(PAYLOAD)];
+    size_t          size        = 0U;
+
+    /* Nothing cached. */
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_FALSE(readPayload(getUrl(0U), buffer, sizeof(buffer), size));
+
+    /* Fresh for a minute. */
+    cache.write(getUrl(0U), PAYLOAD, sizeof(PAYLOAD), "", "", 60U);
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_TRUE(readPayload(getUrl(0U), buffer, sizeof(buffer), size));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(PAYLOAD), size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(PAYLOAD, buffer, sizeof(PAYLOAD));
+
+    /* Stale immediately, but still cached for revalidation. */
+    cache.write(getUrl(1U), PAYLOAD, sizeof(PAYLOAD), "", "", 0U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(1U)));
+    TEST_ASSERT_TRUE(readPayload(getUrl(1U), buffer, sizeof(buffer), size));
+
+    /* A new response replaces the old one. */
+    cache.write(getUrl(0U), PAYLOAD, sizeof(PAYLOAD), "", "", 0U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(0U)));
+
+    /* Empty and too large responses are not cached. */
+    cache.write(getUrl(2U), PAYLOAD, 0U, "", "", 60U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(2U)));
+    cache.write(getUrl(2U), PAYLOAD, HttpCache::MAX_ENTRY_SIZE + 1U, "", "", 60U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(2U)));
+}
+
+/**
+ * Test the revalidation of stale responses.
+ */
+static void testHttpCacheRevalidation()
+{
+    HttpCache&      cache           = HttpCache::getInstance();
+    const uint8_t   PAYLOAD[]       = { 1U, 2U, 3U, 4U };
+    String          eTag;
+    String          lastModified;
+
+    /* No validators without cached response. */
+    TEST_ASSERT_FALSE(cache.getValidators(getUrl(0U), eTag, lastModified));
+
+    cache.write(getUrl(0U), PAYLOAD, sizeof(PAYLOAD), "\"abc\"", "Wed, 21 Oct 2015 07:28:00 GMT", 0U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_TRUE(cache.getValidators(getUrl(0U), eTag, lastModified));
+    TEST_ASSERT_EQUAL_STRING("\"abc\"", eTag.c_str());
+    TEST_ASSERT_EQUAL_STRING("Wed, 21 Oct 2015 07:28:00 GMT", lastModified.c_str());
+
+    /* Server confirmed with "304 Not Modified". */
+    cache.refresh(getUrl(0U), 60U);
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(0U)));
+
+    /* Refresh of a not cached response has no effect. */
+    cache.refresh(getUrl(1U), 60U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(1U)));
+
+    /* Server responded with a new payload, which is not cacheable. */
+    cache.remove(getUrl(0U));
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_FALSE(cache.getValidators(getUrl(0U), eTag, lastModified));
+}
+
+/**
+ * Test that the least recently used response is evicted, if all entries
+ * are used.
+ */
+static void testHttpCacheEviction()
+{
+    HttpCache&      cache       = HttpCache::getInstance();
+    const uint8_t   PAYLOAD[]   = { 1U, 2U, 3U, 4U };
+    uint8_t         buffer[sizeof(PAYLOAD)];
+    size_t          size        = 0U;
+    size_t          index       = 0U;
+
+    for(index = 0U; index < HttpCache::MAX_ENTRIES; ++index)
+    {
+        cache.write(getUrl(index), PAYLOAD, sizeof(PAYLOAD), "", "", 60U);
+        waitForNextTick();
+    }
+
+    for(index = 0U; index < HttpCache::MAX_ENTRIES; ++index)
+    {
+        TEST_ASSERT_TRUE(cache.isFresh(getUrl(index)));
+    }
+
+    /* Use the oldest one, so the second one becomes the least recently used. */
+    TEST_ASSERT_TRUE(readPayload(getUrl(0U), buffer, sizeof(buffer), size));
+    waitForNextTick();
+
+    cache.write(getUrl(HttpCache::MAX_ENTRIES), PAYLOAD, sizeof(PAYLOAD), "", "", 60U);
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(HttpCache::MAX_ENTRIES)));
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(1U)));
+
+    for(index = 2U; index < HttpCache::MAX_ENTRIES; ++index)
+    {
+        TEST_ASSERT_TRUE(cache.isFresh(getUrl(index)));
+    }
+}
+
+/**
+ * Test that the memory limit is considered.
+ */
+static void testHttpCacheMemoryLimit()
+{
+    HttpCache&      cache       = HttpCache::getInstance();
+    const size_t    SIZE        = HttpCache::MEMORY_LIMIT / 2U;
+    static uint8_t  payload[SIZE];
+
+    memset(payload, 0xA5, sizeof(payload));
+
+    cache.write(getUrl(0U), payload, sizeof(payload), "", "", 60U);
+    waitForNextTick();
+    cache.write(getUrl(1U), payload, sizeof(payload), "", "", 60U);
+    waitForNextTick();
+    TEST_ASSERT_EQUAL_UINT32(HttpCache::MEMORY_LIMIT, cache.getMemoryUsed());
+
+    /* The least recently used response must leave. */
+    cache.write(getUrl(2U), payload, sizeof(payload), "", "", 60U);
+    TEST_ASSERT_EQUAL_UINT32(HttpCache::MEMORY_LIMIT, cache.getMemoryUsed());
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(1U)));
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(2U)));
+
+    /* Releasing all frees the memory. */
+    cache.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, cache.getMemoryUsed());
+}
+
+/**
+ * Test collecting a payload part by part with the writer.
+ */
+static void testHttpCacheWriter()
+{
+    HttpCache&          cache       = HttpCache::getInstance();
+    HttpCache::Writer   writer;
+    const size_t        PART_SIZE   = 100U;
+    const size_t        PARTS       = 10U;
+    uint8_t             part[PART_SIZE];
+    static uint8_t      buffer[HttpCache::MAX_ENTRY_SIZE];
+    size_t              size        = 0U;
+    size_t              index       = 0U;
+
+    TEST_ASSERT_FALSE(writer.isValid());
+
+    /* Payload with unknown size. */
+    TEST_ASSERT_TRUE(writer.begin(0U));
+
+    for(index = 0U; index < PARTS; ++index)
+    {
+        memset(part, static_cast<int>(index), sizeof(part));
+        TEST_ASSERT_TRUE(writer.write(part, sizeof(part)));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(PARTS * PART_SIZE, writer.getSize());
+
+    /* The cache uses exactly the payload size, not the buffer size of the writer. */
+    cache.write(getUrl(0U), writer, "", "", 60U);
+    TEST_ASSERT_FALSE(writer.isValid());
+    TEST_ASSERT_EQUAL_UINT32(PARTS * PART_SIZE, cache.getMemoryUsed());
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(0U)));
+    TEST_ASSERT_TRUE(readPayload(getUrl(0U), buffer, sizeof(buffer), size));
+    TEST_ASSERT_EQUAL_UINT32(PARTS * PART_SIZE, size);
+
+    for(index = 0U; index < PARTS; ++index)
+    {
+        TEST_ASSERT_EACH_EQUAL_UINT8(static_cast<uint8_t>(index), &buffer[index * PART_SIZE], PART_SIZE);
+    }
+
+    /* Payload with known size. */
+    memset(part, 0x5A, sizeof(part));
+    TEST_ASSERT_TRUE(writer.begin(sizeof(part)));
+    TEST_ASSERT_TRUE(writer.write(part, sizeof(part)));
+    cache.write(getUrl(1U), writer, "", "", 60U);
+    TEST_ASSERT_TRUE(cache.isFresh(getUrl(1U)));
+    TEST_ASSERT_EQUAL_UINT32((PARTS + 1U) * PART_SIZE, cache.getMemoryUsed());
+
+    /* A payload which can't be cached, is not collected at all. */
+    TEST_ASSERT_FALSE(writer.begin(HttpCache::MAX_ENTRY_SIZE + 1U));
+    TEST_ASSERT_FALSE(writer.write(part, sizeof(part)));
+    cache.write(getUrl(2U), writer, "", "", 60U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(2U)));
+
+    /* Exceeding the limit part by part stops collecting. */
+    TEST_ASSERT_TRUE(writer.begin(0U));
+    TEST_ASSERT_TRUE(writer.write(buffer, HttpCache::MAX_ENTRY_SIZE));
+    TEST_ASSERT_FALSE(writer.write(part, 1U));
+    TEST_ASSERT_FALSE(writer.isValid());
+    TEST_ASSERT_EQUAL_UINT32(0U, writer.getSize());
+    cache.write(getUrl(2U), writer, "", "", 60U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(2U)));
+
+    /* A empty payload is not cached. */
+    TEST_ASSERT_TRUE(writer.begin(0U));
+    cache.write(getUrl(3U), writer, "", "", 60U);
+    TEST_ASSERT_FALSE(cache.isFresh(getUrl(3U)));
+}
+
+/**
+ * Get a URL for testing purposes.
+ *
+ * @param[in] index Index, which makes the URL unique.
+ *
+ * @return URL
+ */
+static String getUrl(size_t index)
+{
+    String url = "http://example.com/";
+
+    url += index;
+
+    return url;
+}
+
+/**
+ * Read a cached response payload.
+ *
+ * @param[in]   url         URL
+ * @param[out]  buffer      Buffer for the payload
+ * @param[in]   bufferSize  Buffer size in byte
+ * @param[out]  size        Payload size in byte
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool readPayload(const String& url, uint8_t* buffer, size_t bufferSize, size_t& size)
+{
+    size = 0U;
+
+    return HttpCache::getInstance().read(url,
+        [buffer, bufferSize, &size](const uint8_t* data, size_t dataSize) {
+            if (bufferSize >= (size + dataSize))
+            {
+                memcpy(&buffer[size], data, dataSize);
+            }
+
+            size += dataSize;
+        });
+}
+
+/**
+ * Wait until the millisecond tick changes, which is the base for the least
+ * recently used decision.
+ */
+static void waitForNextTick()
+{
+    unsigned long timestamp = millis();
+
+    while(millis() == timestamp)
+    {
+        ;
+    }
+}
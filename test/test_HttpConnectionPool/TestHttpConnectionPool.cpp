@@ -0,0 +1,328 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test HTTP connection pool.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <HttpConnectionSlot.hpp>
+#include <HttpConnectionPool.hpp>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Test client, which owns a connection.
+ */
+struct TestClient
+{
+    uint8_t id; /**< Client id */
+};
+
+/** Connection used by the test client. */
+typedef HttpConnectionSlot<TestClient> TestConnection;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testConnectionPool();
+static void testSecureConnection();
+static void testConnectionTimeouts();
+static void testConnectionGeneration();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of connections, like the HTTP scheduler uses. */
+static const size_t MAX_CONNECTIONS = 3U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testConnectionPool);
+    RUN_TEST(testSecureConnection);
+    RUN_TEST(testConnectionTimeouts);
+    RUN_TEST(testConnectionGeneration);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test acquiring connections and reusing the kept alive ones.
+ */
+static void testConnectionPool()
+{
+    HttpConnectionPool<TestConnection, MAX_CONNECTIONS> pool;
+    TestClient                                          client      = { 1U };
+    TestConnection*                                     connection  = nullptr;
+    TestConnection*                                     lruIdle     = nullptr;
+    TestConnection*                                     conA        = nullptr;
+    TestConnection*                                     conB        = nullptr;
+    TestConnection*                                     conC        = nullptr;
+
+    TEST_ASSERT_EQUAL(MAX_CONNECTIONS, pool.getSize());
+
+    /* Every server gets a closed connection. */
+    conA = pool.acquire("a.com", 80U, false, lruIdle);
+    TEST_ASSERT_NOT_NULL(conA);
+    TEST_ASSERT_NULL(lruIdle);
+    TEST_ASSERT_TRUE(conA->isServer("A.com", 80U, false));
+    conA->setOwner(&client);
+    conA->setState(TestConnection::STATE_CONNECTING);
+
+    conB = pool.acquire("b.com", 80U, false, lruIdle);
+    TEST_ASSERT_NOT_NULL(conB);
+    TEST_ASSERT_NOT_EQUAL(conA, conB);
+    conB->setOwner(&client);
+    conB->setState(TestConnection::STATE_CONNECTED);
+
+    conC = pool.acquire("c.com", 443U, true, lruIdle);
+    TEST_ASSERT_NOT_NULL(conC);
+    TEST_ASSERT_NOT_EQUAL(conA, conC);
+    TEST_ASSERT_NOT_EQUAL(conB, conC);
+    conC->setOwner(&client);
+    conC->setState(TestConnection::STATE_CONNECTED);
+
+    /* All connections are in use. */
+    TEST_ASSERT_NULL(pool.acquire("d.com", 80U, false, lruIdle));
+    TEST_ASSERT_NULL(lruIdle);
+
+    /* Kept alive connections are reused for the same server only. */
+    conA->setState(TestConnection::STATE_CONNECTED);
+    conA->setOwner(nullptr);
+    advanceMillis(1000U);
+    conB->setOwner(nullptr);
+    TEST_ASSERT_FALSE(conA->isServer("a.com", 443U, false));
+    TEST_ASSERT_FALSE(conA->isServer("a.com", 80U, true));
+
+    connection = pool.acquire("b.com", 80U, false, lruIdle);
+    TEST_ASSERT_EQUAL_PTR(conB, connection);
+    TEST_ASSERT_NULL(lruIdle);
+    TEST_ASSERT_EQUAL(TestConnection::STATE_CONNECTED, connection->getState());
+    connection->setOwner(&client);
+
+    /* No connection for a new server, but the least recently used idle
+     * connection shall be closed to make room.
+     */
+    conC->setOwner(nullptr);
+    TEST_ASSERT_NULL(pool.acquire("d.com", 80U, false, lruIdle));
+    TEST_ASSERT_EQUAL_PTR(conA, lruIdle);
+
+    /* A closed connection gets the new server. */
+    conA->setState(TestConnection::STATE_CLOSING);
+    TEST_ASSERT_NULL(pool.acquire("d.com", 80U, false, lruIdle));
+    TEST_ASSERT_EQUAL_PTR(conC, lruIdle);
+    conA->setState(TestConnection::STATE_CLOSED);
+    connection = pool.acquire("d.com", 80U, false, lruIdle);
+    TEST_ASSERT_EQUAL_PTR(conA, connection);
+    TEST_ASSERT_NULL(lruIdle);
+    TEST_ASSERT_TRUE(connection->isServer("d.com", 80U, false));
+
+    return;
+}
+
+/**
+ * Test that only one secure connection exists at a time.
+ */
+static void testSecureConnection()
+{
+    HttpConnectionPool<TestConnection, MAX_CONNECTIONS> pool;
+    TestClient                                          client      = { 1U };
+    TestConnection*                                     connection  = nullptr;
+    TestConnection*                                     lruIdle     = nullptr;
+    TestConnection*                                     conA        = nullptr;
+
+    /* Secure connection, which is kept alive. */
+    conA = pool.acquire("a.com", 443U, true, lruIdle);
+    TEST_ASSERT_NOT_NULL(conA);
+    conA->setOwner(&client);
+    conA->setState(TestConnection::STATE_CONNECTED);
+    conA->setOwner(nullptr);
+
+    /* It is reused for the same server. */
+    connection = pool.acquire("a.com", 443U, true, lruIdle);
+    TEST_ASSERT_EQUAL_PTR(conA, connection);
+    TEST_ASSERT_NULL(lruIdle);
+
+    /* A plain connection is available in parallel. */
+    connection = pool.acquire("b.com", 80U, false, lruIdle);
+    TEST_ASSERT_NOT_NULL(connection);
+    TEST_ASSERT_NOT_EQUAL(conA, connection);
+    TEST_ASSERT_NULL(lruIdle);
+
+    /* While the secure connection is used, no other one is available. */
+    conA->setOwner(&client);
+    TEST_ASSERT_NULL(pool.acquire("c.com", 443U, true, lruIdle));
+    TEST_ASSERT_NULL(lruIdle);
+
+    /* The idle secure connection shall be closed first. */
+    conA->setOwner(nullptr);
+    TEST_ASSERT_NULL(pool.acquire("c.com", 443U, true, lruIdle));
+    TEST_ASSERT_EQUAL_PTR(conA, lruIdle);
+
+    conA->setState(TestConnection::STATE_CLOSING);
+    TEST_ASSERT_NULL(pool.acquire("c.com", 443U, true, lruIdle));
+    TEST_ASSERT_NULL(lruIdle);
+
+    /* After it is closed, the new secure connection is available. */
+    conA->setState(TestConnection::STATE_CLOSED);
+    connection = pool.acquire("c.com", 443U, true, lruIdle);
+    TEST_ASSERT_NOT_NULL(connection);
+    TEST_ASSERT_NULL(lruIdle);
+    TEST_ASSERT_TRUE(connection->isServer("c.com", 443U, true));
+
+    return;
+}
+
+/**
+ * Test the keep-alive, close and request timeouts of a connection.
+ */
+static void testConnectionTimeouts()
+{
+    TestConnection  connection;
+    TestClient      client      = { 1U };
+
+    /* Request timeout while the connection is established and used. */
+    connection.setOwner(&client);
+    connection.setState(TestConnection::STATE_CONNECTING);
+    advanceMillis(TestConnection::REQUEST_TIMEOUT / 2U);
+    TEST_ASSERT_FALSE(connection.isRequestExpired());
+    advanceMillis(TestConnection::REQUEST_TIMEOUT / 2U);
+    TEST_ASSERT_TRUE(connection.isRequestExpired());
+
+    /* A state change restarts the request timeout. */
+    connection.setState(TestConnection::STATE_CONNECTED);
+    TEST_ASSERT_FALSE(connection.isRequestExpired());
+    TEST_ASSERT_FALSE(connection.isKeepAliveExpired());
+
+    /* Keep-alive timeout after the connection is released. */
+    connection.setOwner(nullptr);
+    TEST_ASSERT_TRUE(connection.isIdle());
+    advanceMillis(TestConnection::KEEP_ALIVE_TIMEOUT / 2U);
+    TEST_ASSERT_FALSE(connection.isKeepAliveExpired());
+    advanceMillis(TestConnection::KEEP_ALIVE_TIMEOUT / 2U);
+    TEST_ASSERT_TRUE(connection.isKeepAliveExpired());
+    TEST_ASSERT_FALSE(connection.isRequestExpired());
+
+    /* Close timeout, if no disconnect is notified. */
+    connection.setState(TestConnection::STATE_CLOSING);
+    TEST_ASSERT_FALSE(connection.isIdle());
+    TEST_ASSERT_FALSE(connection.isKeepAliveExpired());
+    advanceMillis(TestConnection::CLOSE_TIMEOUT / 2U);
+    TEST_ASSERT_FALSE(connection.isCloseExpired());
+    advanceMillis(TestConnection::CLOSE_TIMEOUT / 2U);
+    TEST_ASSERT_TRUE(connection.isCloseExpired());
+
+    return;
+}
+
+/**
+ * Test the generation of the transport connections, which is used to
+ * recognize notifications of a former transport connection.
+ */
+static void testConnectionGeneration()
+{
+    TestConnection  connection;
+    TestClient      client      = { 1U };
+    uint32_t        generation  = connection.getGeneration();
+
+    /* The owner and state changes of a kept-alive connection keep the generation. */
+    connection.setOwner(&client);
+    connection.setState(TestConnection::STATE_CONNECTED);
+    connection.setOwner(nullptr);
+    connection.setState(TestConnection::STATE_CLOSED);
+    TEST_ASSERT_EQUAL_UINT32(generation, connection.getGeneration());
+
+    /* A new transport connection starts the next generation. */
+    connection.nextGeneration();
+    TEST_ASSERT_NOT_EQUAL(generation, connection.getGeneration());
+    TEST_ASSERT_EQUAL_UINT32(generation + 1U, connection.getGeneration());
+
+    return;
+}
@@ -0,0 +1,229 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test HTTP request queue.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <HttpRequestQueue.hpp>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Test request with a priority.
+ */
+class TestRequest
+{
+public:
+
+    /**
+     * Constructs a request.
+     *
+     * @param[in] priority  Request priority
+     */
+    TestRequest(uint8_t priority) :
+        m_priority(priority)
+    {
+    }
+
+    /**
+     * Get the request priority.
+     *
+     * @return Request priority
+     */
+    uint8_t getPriority() const
+    {
+        return m_priority;
+    }
+
+private:
+
+    uint8_t m_priority; /**< Request priority */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testRequestQueue();
+static void testPriority();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of queued requests in the test */
+static const size_t MAX_REQUESTS    = 4U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testRequestQueue);
+    RUN_TEST(testPriority);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test adding and removing requests.
+ */
+static void testRequestQueue()
+{
+    HttpRequestQueue<TestRequest, MAX_REQUESTS> queue;
+    TestRequest                                 request1(0U);
+    TestRequest                                 request2(0U);
+    TestRequest                                 request3(0U);
+
+    /* Empty queue */
+    TEST_ASSERT_EQUAL(0U, queue.getCount());
+    TEST_ASSERT_NULL(queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL(0U, queue.getCount());
+
+    /* Requests with the same priority are served in order of arrival. */
+    TEST_ASSERT_TRUE(queue.add(request1));
+    TEST_ASSERT_TRUE(queue.add(request2));
+    TEST_ASSERT_TRUE(queue.add(request1));
+    TEST_ASSERT_TRUE(queue.add(request3));
+    TEST_ASSERT_EQUAL(MAX_REQUESTS, queue.getCount());
+    TEST_ASSERT_EQUAL_PTR(&request1, queue.getNext());
+
+    /* Full queue */
+    TEST_ASSERT_FALSE(queue.add(request3));
+    TEST_ASSERT_EQUAL(MAX_REQUESTS, queue.getCount());
+
+    queue.removeNext();
+    TEST_ASSERT_EQUAL(3U, queue.getCount());
+    TEST_ASSERT_EQUAL_PTR(&request2, queue.getNext());
+
+    /* All queued requests of a removed one are removed. */
+    queue.remove(request1);
+    TEST_ASSERT_EQUAL(2U, queue.getCount());
+    TEST_ASSERT_EQUAL_PTR(&request2, queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL_PTR(&request3, queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL(0U, queue.getCount());
+    TEST_ASSERT_NULL(queue.getNext());
+
+    return;
+}
+
+/**
+ * Test that the earliest request with the highest priority is served first.
+ */
+static void testPriority()
+{
+    HttpRequestQueue<TestRequest, MAX_REQUESTS> queue;
+    TestRequest                                 lowRequest1(0U);
+    TestRequest                                 lowRequest2(0U);
+    TestRequest                                 highRequest1(2U);
+    TestRequest                                 highRequest2(2U);
+    TestRequest                                 mediumRequest(1U);
+
+    TEST_ASSERT_TRUE(queue.add(lowRequest1));
+    TEST_ASSERT_TRUE(queue.add(highRequest1));
+    TEST_ASSERT_TRUE(queue.add(lowRequest2));
+    TEST_ASSERT_TRUE(queue.add(highRequest2));
+
+    TEST_ASSERT_EQUAL_PTR(&highRequest1, queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL_PTR(&highRequest2, queue.getNext());
+    queue.removeNext();
+
+    /* A later request with a higher priority overtakes the waiting ones. */
+    TEST_ASSERT_TRUE(queue.add(mediumRequest));
+    TEST_ASSERT_EQUAL_PTR(&mediumRequest, queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL_PTR(&lowRequest1, queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL_PTR(&lowRequest2, queue.getNext());
+    queue.removeNext();
+    TEST_ASSERT_EQUAL(0U, queue.getCount());
+
+    return;
+}
@@ -0,0 +1,231 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test decoded image cache.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <FS.h>
+#include <ImageCache.h>
+#include <NativeImg.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testImageCache();
+static void testImageCacheNativeImg();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Test image, 2x2 pixels, 24 bpp */
+static const char*  TEST_IMAGE          = "./test/test_BmpImgLoader/test24bpp.bmp";
+
+/** Bitmap image, which gets a native image companion during the test. */
+static const char*  TEST_BMP_IMAGE      = "./test/test_ImageCache/test.bmp";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testImageCache);
+    RUN_TEST(testImageCacheNativeImg);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    FS localFileSystem;
+
+    (void)localFileSystem.remove(NativeImg::getFileName(TEST_BMP_IMAGE));
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test decoded image cache.
+ */
+static void testImageCache()
+{
+    ImageCache&         cache           = ImageCache::getInstance();
+    FS                  localFileSystem;
+    ImageCache::Handle  handle1;
+    ImageCache::Handle  handle2;
+    size_t              memoryUsed      = 0U;
+
+    /* Empty handle */
+    TEST_ASSERT_TRUE(handle1.isEmpty());
+    TEST_ASSERT_FALSE(handle1.get().isAllocated());
+    TEST_ASSERT_EQUAL(0U, cache.getMemoryUsed());
+
+    /* Not existing file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, cache.load(localFileSystem, "./test/test_ImageCache/notExisting.bmp", handle1));
+    TEST_ASSERT_TRUE(handle1.isEmpty());
+
+    /* Unsupported file format is not cached. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, cache.load(localFileSystem, "./test/test_BmpImgLoader/test32bpp.bmp", handle1));
+    TEST_ASSERT_TRUE(handle1.isEmpty());
+    TEST_ASSERT_EQUAL(0U, cache.getMemoryUsed());
+
+    /* Load image */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE, handle1));
+    TEST_ASSERT_FALSE(handle1.isEmpty());
+    TEST_ASSERT_EQUAL_UINT16(2, handle1.get().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, handle1.get().getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, handle1.get().getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, handle1.get().getColor(1, 1));
+
+    memoryUsed = cache.getMemoryUsed();
+    TEST_ASSERT_GREATER_THAN(0U, memoryUsed);
+
+    /* Load same image again, which shall be shared. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE, handle2));
+    TEST_ASSERT_EQUAL_PTR(&handle1.get(), &handle2.get());
+    TEST_ASSERT_EQUAL(memoryUsed, cache.getMemoryUsed());
+
+    /* Copied handles share the image too. */
+    {
+        ImageCache::Handle handle3(handle1);
+
+        TEST_ASSERT_EQUAL_PTR(&handle1.get(), &handle3.get());
+    }
+
+    /* Invalidated image is kept as long as it is referenced, but not shared anymore. */
+    cache.invalidate(TEST_IMAGE);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE, handle2));
+    TEST_ASSERT_NOT_EQUAL(&handle1.get(), &handle2.get());
+    TEST_ASSERT_EQUAL(2U * memoryUsed, cache.getMemoryUsed());
+
+    /* Releasing the last reference destroys the invalidated image. */
+    handle1.release();
+    TEST_ASSERT_TRUE(handle1.isEmpty());
+    TEST_ASSERT_EQUAL(memoryUsed, cache.getMemoryUsed());
+
+    /* Referenced images are not removed by clearing the cache. */
+    cache.clear();
+    TEST_ASSERT_EQUAL(memoryUsed, cache.getMemoryUsed());
+
+    /* Unreferenced images are kept until the cache is cleared. */
+    handle2.release();
+    TEST_ASSERT_EQUAL(memoryUsed, cache.getMemoryUsed());
+    cache.clear();
+    TEST_ASSERT_EQUAL(0U, cache.getMemoryUsed());
+
+    return;
+}
+
+/**
+ * Test that a native image companion is preferred over the bitmap image.
+ */
+static void testImageCacheNativeImg()
+{
+    ImageCache&         cache           = ImageCache::getInstance();
+    FS                  localFileSystem;
+    NativeImg           nativeImg;
+    YAGfxDynamicBitmap  bitmap;
+    ImageCache::Handle  handle;
+
+    TEST_ASSERT_TRUE(bitmap.create(1U, 1U));
+    bitmap.fillScreen(0x123456);
+    TEST_ASSERT_TRUE(nativeImg.save(localFileSystem, NativeImg::getFileName(TEST_BMP_IMAGE), bitmap));
+
+    /* The bitmap image file itself doesn't exist, the companion is loaded instead. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_BMP_IMAGE, handle));
+    TEST_ASSERT_FALSE(handle.isEmpty());
+    TEST_ASSERT_EQUAL_UINT16(1, handle.get().getWidth());
+    TEST_ASSERT_EQUAL_UINT32(0x123456, handle.get().getColor(0, 0));
+    handle.release();
+
+    /* Invalidating the companion invalidates the cached image too. */
+    cache.invalidate(NativeImg::getFileName(TEST_BMP_IMAGE));
+    NativeImg::removeFileOf(localFileSystem, TEST_BMP_IMAGE);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, cache.load(localFileSystem, TEST_BMP_IMAGE, handle));
+    TEST_ASSERT_TRUE(handle.isEmpty());
+
+    cache.clear();
+    TEST_ASSERT_EQUAL(0U, cache.getMemoryUsed());
+
+    return;
+}
@@ -0,0 +1,313 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test incremental JSON stream filter.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <JsonStreamFilter.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeInChunks(JsonStreamFilter& filter, const char* json, size_t chunkSize);
+static void testFilter(void);
+static void testFilterWildcard(void);
+static void testFilterErrors(void);
+static void testFilterCopy(void);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Example response, similar to a OpenWeather current weather response. */
+static const char   TEST_JSON[]     =
+    "{\"coord\":{\"lon\":13.4,\"lat\":52.5},"
+    "\"weather\":[{\"id\":800,\"description\":\"clear \\\"sky\\\" }\",\"icon\":\"01d\"},{\"id\":1,\"icon\":\"02n\"}],"
+    "\"main\" : { \"temp\" : -3.5e2 , \"feels_like\":2,\"humidity\":81 },"
+    "\"wind\":{\"speed\":4.1,\"deg\":[1,2,{\"x\":[]}]},"
+    "\"name\":\"Berlin\",\"cod\":200}\r\n";
+
+/** Expected filtered response. */
+static const char   EXPECTED_JSON[] =
+    "{\"weather\":[{\"icon\":\"01d\"},{\"icon\":\"02n\"}],\"main\":{\"temp\":-3.5e2,\"humidity\":81},\"wind\":{\"speed\":4.1,\"deg\":[1,2,{\"x\":[]}]}}";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testFilter);
+    RUN_TEST(testFilterWildcard);
+    RUN_TEST(testFilterErrors);
+    RUN_TEST(testFilterCopy);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a JSON text in chunks to the filter.
+ *
+ * @param[in] filter    JSON stream filter
+ * @param[in] json      JSON text
+ * @param[in] chunkSize Chunk size in byte
+ */
+static void writeInChunks(JsonStreamFilter& filter, const char* json, size_t chunkSize)
+{
+    size_t          length  = strlen(json);
+    size_t          index   = 0U;
+    const void*     vJson   = json;
+    const uint8_t*  data    = static_cast<const uint8_t*>(vJson);
+
+    while(length > index)
+    {
+        size_t size = length - index;
+
+        if (chunkSize < size)
+        {
+            size = chunkSize;
+        }
+
+        (void)filter.write(&data[index], size);
+        index += size;
+    }
+}
+
+/**
+ * Test filtering of a JSON text, which is received in chunks of different size.
+ */
+static void testFilter(void)
+{
+    const size_t            BUFFER_SIZE = 256U;
+    const size_t            FILTER_SIZE = 256U;
+    JsonStreamFilter        streamFilter(BUFFER_SIZE, FILTER_SIZE);
+    StaticJsonDocument<256> filter;
+    StaticJsonDocument<256> doc;
+    size_t                  chunkSize   = 0U;
+
+    filter["main"]["temp"]          = true;
+    filter["main"]["humidity"]      = true;
+    filter["wind"]["speed"]         = true;
+    filter["wind"]["deg"]           = true;
+    filter["weather"][0]["icon"]    = true;
+
+    for(chunkSize = 1U; chunkSize <= sizeof(TEST_JSON); ++chunkSize)
+    {
+        size_t      size    = 0U;
+        const char* output  = nullptr;
+
+        streamFilter.begin(filter.as<JsonVariantConst>());
+        writeInChunks(streamFilter, TEST_JSON, chunkSize);
+
+        TEST_ASSERT_TRUE(streamFilter.isComplete());
+        TEST_ASSERT_FALSE(streamFilter.isError());
+
+        output = streamFilter.getOutput(size);
+        TEST_ASSERT_EQUAL_UINT32(strlen(EXPECTED_JSON), size);
+        TEST_ASSERT_EQUAL_MEMORY(EXPECTED_JSON, output, size);
+    }
+
+    /* The filtered output must be valid JSON. */
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, streamFilter.deserialize(doc).code());
+    TEST_ASSERT_EQUAL_STRING("02n", doc["weather"][1]["icon"].as<const char*>());
+    TEST_ASSERT_EQUAL_INT(81, doc["main"]["humidity"].as<int>());
+    TEST_ASSERT_TRUE(doc["name"].isNull());
+
+    return;
+}
+
+/**
+ * Test filtering with a wildcard filter.
+ */
+static void testFilterWildcard(void)
+{
+    const size_t            BUFFER_SIZE = 64U;
+    const size_t            FILTER_SIZE = 256U;
+    JsonStreamFilter        streamFilter(BUFFER_SIZE, FILTER_SIZE);
+    StaticJsonDocument<128> filter;
+    size_t                  size        = 0U;
+    const char*             output      = nullptr;
+    const char              JSON[]      = "{\"p\":{\"a\":1,\"b\":2},\"q\":{\"a\":[true,null]},\"r\":5}";
+    const char              EXPECTED[]  = "{\"p\":{\"a\":1},\"q\":{\"a\":[true,null]}}";
+
+    filter["*"]["a"] = true;
+
+    streamFilter.begin(filter.as<JsonVariantConst>());
+    writeInChunks(streamFilter, JSON, 3U);
+
+    TEST_ASSERT_TRUE(streamFilter.isComplete());
+
+    output = streamFilter.getOutput(size);
+    TEST_ASSERT_EQUAL_UINT32(strlen(EXPECTED), size);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, output, size);
+
+    return;
+}
+
+/**
+ * Test the error handling.
+ */
+static void testFilterErrors(void)
+{
+    const size_t            BUFFER_SIZE = 16U;
+    const size_t            FILTER_SIZE = 256U;
+    JsonStreamFilter        streamFilter(BUFFER_SIZE, FILTER_SIZE);
+    StaticJsonDocument<128> filter;
+    StaticJsonDocument<128> doc;
+
+    filter["a"] = true;
+
+    /* Output buffer too small. */
+    streamFilter.begin(filter.as<JsonVariantConst>());
+    writeInChunks(streamFilter, "{\"a\":\"abcdefghijklmnopqrstuvwxyz\"}", 4U);
+    TEST_ASSERT_TRUE(streamFilter.isError());
+    TEST_ASSERT_EQUAL(DeserializationError::NoMemory, streamFilter.deserialize(doc).code());
+
+    /* Syntax error */
+    streamFilter.begin(filter.as<JsonVariantConst>());
+    writeInChunks(streamFilter, "{\"a\" 1}", 1U);
+    TEST_ASSERT_TRUE(streamFilter.isError());
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, streamFilter.deserialize(doc).code());
+
+    /* Incomplete JSON text */
+    streamFilter.begin(filter.as<JsonVariantConst>());
+    writeInChunks(streamFilter, "{\"a\":1", 1U);
+    TEST_ASSERT_FALSE(streamFilter.isComplete());
+    TEST_ASSERT_FALSE(streamFilter.isError());
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput, streamFilter.deserialize(doc).code());
+
+    /* After begin, the filter shall be usable again. */
+    streamFilter.begin(filter.as<JsonVariantConst>());
+    writeInChunks(streamFilter, "{\"b\":2,\"a\":1}", 1U);
+    TEST_ASSERT_TRUE(streamFilter.isComplete());
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, streamFilter.deserialize(doc).code());
+    TEST_ASSERT_EQUAL_INT(1, doc["a"].as<int>());
+
+    return;
+}
+
+/**
+ * Test that the filter is copied and the original filter can be changed
+ * while a JSON text is processed.
+ */
+static void testFilterCopy(void)
+{
+    const size_t            BUFFER_SIZE = 64U;
+    const size_t            FILTER_SIZE = 128U;
+    JsonStreamFilter        streamFilter(BUFFER_SIZE, FILTER_SIZE);
+    JsonStreamFilter        smallStreamFilter(BUFFER_SIZE, 8U);
+    StaticJsonDocument<128> filter;
+    size_t                  size        = 0U;
+    const char*             output      = nullptr;
+    const char              JSON[]      = "{\"a\":1,\"b\":2}";
+    const char              EXPECTED[]  = "{\"a\":1}";
+
+    filter["a"] = true;
+
+    TEST_ASSERT_TRUE(streamFilter.begin(filter.as<JsonVariantConst>()));
+    writeInChunks(streamFilter, JSON, 3U);
+
+    /* Change the original filter while the JSON text is processed. */
+    filter.clear();
+    filter["b"] = true;
+
+    writeInChunks(streamFilter, &JSON[3U], 2U);
+
+    TEST_ASSERT_TRUE(streamFilter.isComplete());
+
+    output = streamFilter.getOutput(size);
+    TEST_ASSERT_EQUAL_UINT32(strlen(EXPECTED), size);
+    TEST_ASSERT_EQUAL_MEMORY(EXPECTED, output, size);
+
+    /* The filter doesn't fit into the filter copy. */
+    TEST_ASSERT_FALSE(smallStreamFilter.begin(filter.as<JsonVariantConst>()));
+    TEST_ASSERT_TRUE(smallStreamFilter.isError());
+
+    return;
+}
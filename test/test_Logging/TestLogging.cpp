@@ -51,11 +51,108 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Log sink, which captures the last binary log message frame.
+ */
+class BinaryLogSink : public LogSink
+{
+public:
+
+    /**
+     * Constructs the log sink.
+     */
+    BinaryLogSink() :
+        m_name("binary"),
+        m_frame(),
+        m_frameSize(0U)
+    {
+    }
+
+    /**
+     * Destroys the log sink.
+     */
+    ~BinaryLogSink()
+    {
+    }
+
+    /**
+     * Get sink name.
+     *
+     * @return Name of the sink.
+     */
+    const String& getName() const final
+    {
+        return m_name;
+    }
+
+    /**
+     * Text log messages are ignored.
+     *
+     * @param[in] msg   Log message
+     */
+    void send(const Logging::Msg& msg) final
+    {
+        UTIL_NOT_USED(msg);
+    }
+
+    /**
+     * Capture binary log message frame.
+     *
+     * @param[in] data  Frame data
+     * @param[in] size  Frame size in byte
+     *
+     * @return Always true
+     */
+    bool sendBinary(const uint8_t* data, size_t size) final
+    {
+        m_frameSize = (sizeof(m_frame) < size) ? sizeof(m_frame) : size;
+        memcpy(m_frame, data, m_frameSize);
+
+        return true;
+    }
+
+    /**
+     * Get captured frame.
+     *
+     * @return Frame data
+     */
+    const uint8_t* getFrame() const
+    {
+        return m_frame;
+    }
+
+    /**
+     * Get captured frame size.
+     *
+     * @return Frame size in byte
+     */
+    size_t getFrameSize() const
+    {
+        return m_frameSize;
+    }
+
+    /**
+     * Clear captured frame.
+     */
+    void clear()
+    {
+        m_frameSize = 0U;
+    }
+
+private:
+
+    String  m_name;         /**< Name of the sink */
+    uint8_t m_frame[128U];  /**< Captured frame */
+    size_t  m_frameSize;    /**< Captured frame size in byte */
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
 static void testLogging();
+static void testRateLimit();
+static void testBinaryLogging();
 
 /******************************************************************************
  * Local Variables
@@ -91,6 +188,8 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testLogging);
+    RUN_TEST(testRateLimit);
+    RUN_TEST(testBinaryLogging);
 
     return UNITY_END();
 }
@@ -208,3 +307,93 @@ static void testLogging()
 
     return;
 }
+
+/**
+ * Test the rate limit per module.
+ */
+static void testRateLimit()
+{
+    TestLogger      myTestLogger;
+    LogSinkPrinter  myLogSink("test", &myTestLogger);
+    uint32_t        idx                 = 0U;
+    const uint32_t  EXCEEDED            = 5U;
+    uint32_t        rateLimitedCount    = Logging::getInstance().getRateLimitedCount();
+
+    TEST_ASSERT_TRUE(Logging::getInstance().registerSink(&myLogSink));
+    TEST_ASSERT_TRUE(Logging::getInstance().selectSink("test"));
+    Logging::getInstance().setLogLevel(Logging::LOG_LEVEL_INFO);
+
+    /* Warnings of the same module are limited. */
+    for(idx = 0U; idx < (CONFIG_LOG_RATE_LIMIT + EXCEEDED); ++idx)
+    {
+        LOG_WARNING("Warning %u", idx);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(rateLimitedCount + EXCEEDED, Logging::getInstance().getRateLimitedCount());
+
+    /* Errors are never limited. */
+    myTestLogger.clear();
+    LOG_ERROR("Not limited.");
+    TEST_ASSERT_NOT_EQUAL(0, strlen(myTestLogger.getBuffer()));
+    TEST_ASSERT_EQUAL_UINT32(rateLimitedCount + EXCEEDED, Logging::getInstance().getRateLimitedCount());
+
+    Logging::getInstance().unregisterSink(&myLogSink);
+}
+
+/**
+ * Test the binary log mode.
+ */
+static void testBinaryLogging()
+{
+    BinaryLogSink                   mySink;
+    static const Logging::Site      SITE        = { __FILE__, __LINE__, Logging::LOG_LEVEL_ERROR };
+    static const Logging::Site      DEBUG_SITE  = { __FILE__, __LINE__, Logging::LOG_LEVEL_DEBUG };
+    const char*                     FORMAT      = "Value %d %s";
+    const uint8_t*                  frame       = nullptr;
+    uintptr_t                       siteAddr    = reinterpret_cast<uintptr_t>(&SITE);
+    size_t                          pos         = 0U;
+
+    TEST_ASSERT_TRUE(Logging::getInstance().registerSink(&mySink));
+    TEST_ASSERT_TRUE(Logging::getInstance().selectSink("binary"));
+    Logging::getInstance().setLogLevel(Logging::LOG_LEVEL_INFO);
+
+    /* Log level is considered. */
+    Logging::getInstance().processBinaryLogMessage(&DEBUG_SITE, FORMAT, 42, "ab");
+    TEST_ASSERT_EQUAL(0U, mySink.getFrameSize());
+
+    /* The format string is not part of a firmware image, so it is sent inline. */
+    Logging::getInstance().processBinaryLogMessage(&SITE, FORMAT, 42, "ab");
+    frame = mySink.getFrame();
+
+    TEST_ASSERT_EQUAL(Logging::BINARY_FRAME_HEADER_SIZE + 1U + strlen(FORMAT) + 4U + 1U + 2U, mySink.getFrameSize());
+    TEST_ASSERT_EQUAL_UINT8(Logging::BINARY_FRAME_SYNC, frame[0U]);
+    TEST_ASSERT_EQUAL_UINT8(mySink.getFrameSize() - 2U, frame[1U]);
+
+    /* Call site address */
+    TEST_ASSERT_EQUAL_UINT8(siteAddr & 0xffU, frame[6U]);
+    TEST_ASSERT_EQUAL_UINT8((siteAddr >> 8U) & 0xffU, frame[7U]);
+
+    /* No format string address */
+    TEST_ASSERT_EQUAL_UINT8(0U, frame[10U]);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame[13U]);
+
+    /* Inline format string */
+    pos = Logging::BINARY_FRAME_HEADER_SIZE;
+    TEST_ASSERT_EQUAL_UINT8(strlen(FORMAT), frame[pos]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(FORMAT, &frame[pos + 1U], strlen(FORMAT)));
+    pos += 1U + strlen(FORMAT);
+
+    /* Integer argument */
+    TEST_ASSERT_EQUAL_UINT8(42U, frame[pos + 0U]);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame[pos + 1U]);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame[pos + 2U]);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame[pos + 3U]);
+    pos += 4U;
+
+    /* String argument */
+    TEST_ASSERT_EQUAL_UINT8(2U, frame[pos]);
+    TEST_ASSERT_EQUAL_UINT8('a', frame[pos + 1U]);
+    TEST_ASSERT_EQUAL_UINT8('b', frame[pos + 2U]);
+
+    Logging::getInstance().unregisterSink(&mySink);
+}
@@ -0,0 +1,195 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test lock-free multi-producer single-consumer ring buffer.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <MpscRingBuffer.hpp>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testPushPop();
+static void testOverflow();
+static void testWrapAround();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testPushPop);
+    RUN_TEST(testOverflow);
+    RUN_TEST(testWrapAround);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test writing and reading values in order.
+ */
+static void testPushPop()
+{
+    MpscRingBuffer<uint32_t, 4U>    ringBuffer;
+    uint32_t                        value       = 0U;
+
+    TEST_ASSERT_EQUAL(4U, ringBuffer.getCapacity());
+    TEST_ASSERT_TRUE(ringBuffer.isEmpty());
+    TEST_ASSERT_FALSE(ringBuffer.pop(value));
+
+    TEST_ASSERT_TRUE(ringBuffer.push(1U));
+    TEST_ASSERT_TRUE(ringBuffer.push(2U));
+    TEST_ASSERT_FALSE(ringBuffer.isEmpty());
+
+    TEST_ASSERT_TRUE(ringBuffer.pop(value));
+    TEST_ASSERT_EQUAL_UINT32(1U, value);
+    TEST_ASSERT_TRUE(ringBuffer.pop(value));
+    TEST_ASSERT_EQUAL_UINT32(2U, value);
+
+    TEST_ASSERT_TRUE(ringBuffer.isEmpty());
+    TEST_ASSERT_FALSE(ringBuffer.pop(value));
+}
+
+/**
+ * Test that a full ring buffer rejects further values.
+ */
+static void testOverflow()
+{
+    MpscRingBuffer<uint32_t, 4U>    ringBuffer;
+    uint32_t                        value       = 0U;
+    uint32_t                        idx         = 0U;
+
+    for(idx = 0U; idx < 4U; ++idx)
+    {
+        TEST_ASSERT_TRUE(ringBuffer.push(idx));
+    }
+
+    TEST_ASSERT_FALSE(ringBuffer.push(4U));
+
+    /* After reading one value, there is space for one more. */
+    TEST_ASSERT_TRUE(ringBuffer.pop(value));
+    TEST_ASSERT_EQUAL_UINT32(0U, value);
+    TEST_ASSERT_TRUE(ringBuffer.push(4U));
+    TEST_ASSERT_FALSE(ringBuffer.push(5U));
+
+    for(idx = 1U; idx < 5U; ++idx)
+    {
+        TEST_ASSERT_TRUE(ringBuffer.pop(value));
+        TEST_ASSERT_EQUAL_UINT32(idx, value);
+    }
+
+    TEST_ASSERT_TRUE(ringBuffer.isEmpty());
+}
+
+/**
+ * Test many rounds over the ring buffer.
+ */
+static void testWrapAround()
+{
+    MpscRingBuffer<uint32_t, 8U>    ringBuffer;
+    uint32_t                        value       = 0U;
+    uint32_t                        round       = 0U;
+
+    for(round = 0U; round < 100U; ++round)
+    {
+        TEST_ASSERT_TRUE(ringBuffer.push(round));
+        TEST_ASSERT_TRUE(ringBuffer.push(round + 1000U));
+        TEST_ASSERT_TRUE(ringBuffer.pop(value));
+        TEST_ASSERT_EQUAL_UINT32(round, value);
+        TEST_ASSERT_TRUE(ringBuffer.pop(value));
+        TEST_ASSERT_EQUAL_UINT32(round + 1000U, value);
+    }
+
+    TEST_ASSERT_TRUE(ringBuffer.isEmpty());
+}
@@ -0,0 +1,354 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test native image format.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <FS.h>
+#include <NativeImg.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testNativeImg();
+static void testNativeImgEncodings();
+static void testNativeImgConvert();
+static bool copyFile(FS& fs, const char* srcFileName, const char* dstFileName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Test image, 2x2 pixels, 24 bpp */
+static const char*  TEST_BMP_IMAGE      = "./test/test_BmpImgLoader/test24bpp.bmp";
+
+/** Native image, which is created during the test. */
+static const char*  TEST_NATIVE_IMAGE   = "./test/test_NativeImg/test.img";
+
+/** Bitmap image, which is converted during the test. */
+static const char*  TEST_CONVERT_IMAGE  = "./test/test_NativeImg/convert.bmp";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testNativeImg);
+    RUN_TEST(testNativeImgEncodings);
+    RUN_TEST(testNativeImgConvert);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    FS localFileSystem;
+
+    (void)localFileSystem.remove(TEST_NATIVE_IMAGE);
+    (void)NativeImg::remove(localFileSystem, TEST_CONVERT_IMAGE);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test saving and loading native images.
+ */
+static void testNativeImg()
+{
+    BmpImgLoader            loader;
+    NativeImg               nativeImg;
+    YAGfxDynamicBitmap      bitmap;
+    YAGfxDynamicBitmap      nativeBitmap;
+    FS                      localFileSystem;
+    NativeImg::SpriteInfo   spriteInfo;
+    NativeImg::SpriteInfo   loadedSpriteInfo;
+
+    /* Not existing file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, nativeImg.load(localFileSystem, "./test/test_NativeImg/notExisting.img", nativeBitmap));
+
+    /* A bitmap image is not a native image. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, nativeImg.load(localFileSystem, TEST_BMP_IMAGE, nativeBitmap));
+    TEST_ASSERT_FALSE(nativeBitmap.isAllocated());
+
+    /* Signature detection */
+    TEST_ASSERT_TRUE(NativeImg::isNativeImg(reinterpret_cast<const uint8_t*>("PXIM"), 4U));
+    TEST_ASSERT_FALSE(NativeImg::isNativeImg(reinterpret_cast<const uint8_t*>("BM"), 2U));
+    TEST_ASSERT_FALSE(NativeImg::isNativeImg(nullptr, 4U));
+
+    /* Native image companion file name */
+    TEST_ASSERT_EQUAL_STRING("/a.b/c.pxim", NativeImg::getFileName("/a.b/c.bmp").c_str());
+    TEST_ASSERT_EQUAL_STRING("/a.b/c.pxim", NativeImg::getFileName("/a.b/c").c_str());
+    TEST_ASSERT_EQUAL_STRING("/a.b/c.pxim", NativeImg::getFileName("/a.b/c.pxim").c_str());
+
+    /* Round trip without sprite sheet information */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, TEST_BMP_IMAGE, bitmap));
+    TEST_ASSERT_TRUE(nativeImg.save(localFileSystem, TEST_NATIVE_IMAGE, bitmap));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TEST_NATIVE_IMAGE, nativeBitmap, &loadedSpriteInfo));
+    TEST_ASSERT_EQUAL_UINT16(2, nativeBitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, nativeBitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, nativeBitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff00, nativeBitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xff0000, nativeBitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, nativeBitmap.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT16(0, loadedSpriteInfo.frameWidth);
+    TEST_ASSERT_EQUAL_UINT16(0, loadedSpriteInfo.frameHeight);
+
+    /* Round trip with sprite sheet information */
+    spriteInfo.frameWidth   = 1U;
+    spriteInfo.frameHeight  = 2U;
+    spriteInfo.frameCnt     = 2U;
+    spriteInfo.fps          = 5U;
+    spriteInfo.isRepeated   = false;
+    TEST_ASSERT_TRUE(nativeImg.save(localFileSystem, TEST_NATIVE_IMAGE, bitmap, &spriteInfo));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TEST_NATIVE_IMAGE, nativeBitmap, &loadedSpriteInfo));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, nativeBitmap.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT16(1, loadedSpriteInfo.frameWidth);
+    TEST_ASSERT_EQUAL_UINT16(2, loadedSpriteInfo.frameHeight);
+    TEST_ASSERT_EQUAL_UINT8(2, loadedSpriteInfo.frameCnt);
+    TEST_ASSERT_EQUAL_UINT8(5, loadedSpriteInfo.fps);
+    TEST_ASSERT_FALSE(loadedSpriteInfo.isRepeated);
+
+    return;
+}
+
+/**
+ * Test the different pixel data encodings by images with different color
+ * distributions.
+ */
+static void testNativeImgEncodings()
+{
+    const uint16_t      WIDTH   = 20U;
+    const uint16_t      HEIGHT  = 16U;
+    NativeImg           nativeImg;
+    YAGfxDynamicBitmap  bitmap;
+    YAGfxDynamicBitmap  nativeBitmap;
+    FS                  localFileSystem;
+    uint16_t            x       = 0U;
+    uint16_t            y       = 0U;
+
+    TEST_ASSERT_TRUE(bitmap.create(WIDTH, HEIGHT));
+
+    /* Single color, which results in long runs. */
+    bitmap.fillScreen(0x123456);
+    TEST_ASSERT_TRUE(nativeImg.save(localFileSystem, TEST_NATIVE_IMAGE, bitmap));
+
+    {
+        File fd = localFileSystem.open(TEST_NATIVE_IMAGE);
+
+        TEST_ASSERT_TRUE(fd);
+        TEST_ASSERT_LESS_THAN(3U * WIDTH * HEIGHT, fd.size());
+        fd.close();
+    }
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TEST_NATIVE_IMAGE, nativeBitmap));
+    TEST_ASSERT_EQUAL_UINT32(0x123456, nativeBitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x123456, nativeBitmap.getColor(WIDTH - 1, HEIGHT - 1));
+
+    /* Few colors without runs, which results in palette indices. */
+    for(y = 0U; y < HEIGHT; ++y)
+    {
+        for(x = 0U; x < WIDTH; ++x)
+        {
+            bitmap.drawPixel(x, y, ((x + y) % 2U) * 0x0000ff + (x % 3U) * 0x00ff00);
+        }
+    }
+
+    TEST_ASSERT_TRUE(nativeImg.save(localFileSystem, TEST_NATIVE_IMAGE, bitmap));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TEST_NATIVE_IMAGE, nativeBitmap));
+
+    for(y = 0U; y < HEIGHT; ++y)
+    {
+        for(x = 0U; x < WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(bitmap.getColor(x, y), nativeBitmap.getColor(x, y));
+        }
+    }
+
+    /* More colors than the palette can hold, mixed with runs. */
+    for(y = 0U; y < HEIGHT; ++y)
+    {
+        for(x = 0U; x < WIDTH; ++x)
+        {
+            uint32_t value = (0U == (y % 4U)) ? 0x00ff00 : ((static_cast<uint32_t>(y) << 16U) | (static_cast<uint32_t>(x) << 8U) | (x * y));
+
+            bitmap.drawPixel(x, y, value);
+        }
+    }
+
+    TEST_ASSERT_TRUE(nativeImg.save(localFileSystem, TEST_NATIVE_IMAGE, bitmap));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TEST_NATIVE_IMAGE, nativeBitmap));
+
+    for(y = 0U; y < HEIGHT; ++y)
+    {
+        for(x = 0U; x < WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(bitmap.getColor(x, y), nativeBitmap.getColor(x, y));
+        }
+    }
+
+    return;
+}
+
+/**
+ * Test converting a bitmap image file to a native image file.
+ */
+static void testNativeImgConvert()
+{
+    NativeImg           nativeImg;
+    YAGfxDynamicBitmap  nativeBitmap;
+    FS                  localFileSystem;
+    String              nativeFileName  = NativeImg::getFileName(TEST_CONVERT_IMAGE);
+
+    /* Not existing file */
+    TEST_ASSERT_FALSE(NativeImg::exists(localFileSystem, TEST_CONVERT_IMAGE));
+    TEST_ASSERT_FALSE(nativeImg.convert(localFileSystem, TEST_CONVERT_IMAGE));
+    TEST_ASSERT_FALSE(NativeImg::remove(localFileSystem, TEST_CONVERT_IMAGE));
+
+    /* The bitmap image is replaced by the native image. */
+    TEST_ASSERT_TRUE(copyFile(localFileSystem, TEST_BMP_IMAGE, TEST_CONVERT_IMAGE));
+    TEST_ASSERT_TRUE(NativeImg::exists(localFileSystem, TEST_CONVERT_IMAGE));
+    TEST_ASSERT_TRUE(nativeImg.convert(localFileSystem, TEST_CONVERT_IMAGE));
+    TEST_ASSERT_FALSE(localFileSystem.exists(TEST_CONVERT_IMAGE));
+    TEST_ASSERT_TRUE(localFileSystem.exists(nativeFileName));
+    TEST_ASSERT_TRUE(NativeImg::exists(localFileSystem, TEST_CONVERT_IMAGE));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, nativeFileName, nativeBitmap));
+    TEST_ASSERT_EQUAL_UINT16(2, nativeBitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, nativeBitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, nativeBitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, nativeBitmap.getColor(1, 1));
+
+    /* A native image is not converted again. */
+    TEST_ASSERT_FALSE(nativeImg.convert(localFileSystem, nativeFileName));
+
+    /* The native image is removed by the bitmap image name. */
+    TEST_ASSERT_TRUE(NativeImg::remove(localFileSystem, TEST_CONVERT_IMAGE));
+    TEST_ASSERT_FALSE(NativeImg::exists(localFileSystem, TEST_CONVERT_IMAGE));
+
+    return;
+}
+
+/**
+ * Copy a file.
+ *
+ * @param[in] fs            File system
+ * @param[in] srcFileName   Name of the source file
+ * @param[in] dstFileName   Name of the destination file
+ *
+ * @return If successful copied, it will return true otherwise false.
+ */
+static bool copyFile(FS& fs, const char* srcFileName, const char* dstFileName)
+{
+    bool    isSuccessful    = false;
+    File    srcFile         = fs.open(srcFileName, "rb");
+
+    if (true == srcFile)
+    {
+        File dstFile = fs.open(dstFileName, "wb");
+
+        if (true == dstFile)
+        {
+            uint8_t buffer[64];
+            size_t  size    = 0U;
+
+            isSuccessful = true;
+
+            do
+            {
+                size = srcFile.read(buffer, sizeof(buffer));
+
+                if (size != dstFile.write(buffer, size))
+                {
+                    isSuccessful = false;
+                }
+            }
+            while((0U < size) && (true == isSuccessful));
+
+            dstFile.close();
+        }
+
+        srcFile.close();
+    }
+
+    return isSuccessful;
+}
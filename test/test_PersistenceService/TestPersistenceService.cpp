@@ -0,0 +1,244 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test persistence service.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <PersistenceService.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testWriteBehind();
+static void testMaxDelay();
+static void testRestartWithPendingWrites();
+static void testRestartFlushTimeout();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Full path of the first test file */
+static const char*  TEST_FILE_1 = "/configuration/test1.json";
+
+/** Full path of the second test file */
+static const char*  TEST_FILE_2 = "/configuration/test2.json";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testWriteBehind);
+    RUN_TEST(testMaxDelay);
+    RUN_TEST(testRestartWithPendingWrites);
+    RUN_TEST(testRestartFlushTimeout);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    TEST_ASSERT_TRUE(PersistenceService::getInstance().start());
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    PersistenceService::getInstance().cancelWrite(TEST_FILE_1);
+    PersistenceService::getInstance().cancelWrite(TEST_FILE_2);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test that several requests are written once after the quiet period.
+ */
+static void testWriteBehind()
+{
+    PersistenceService&             service = PersistenceService::getInstance();
+    PersistenceService::Statistics  before;
+    PersistenceService::Statistics  after;
+
+    service.getStatistics(before);
+
+    /* Nothing requested */
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_1));
+
+    /* The second request is merged and restarts the quiet period. */
+    service.requestWrite(TEST_FILE_1);
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_1));
+    advanceMillis(PersistenceService::QUIET_PERIOD / 2U);
+    service.requestWrite(TEST_FILE_1);
+    advanceMillis(PersistenceService::QUIET_PERIOD / 2U);
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_1));
+    advanceMillis(PersistenceService::QUIET_PERIOD / 2U);
+    TEST_ASSERT_TRUE(service.isWriteDue(TEST_FILE_1));
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_2));
+
+    service.reportWrite(TEST_FILE_1, true);
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_1));
+
+    service.getStatistics(after);
+    TEST_ASSERT_EQUAL_UINT32(before.requests + 2U, after.requests);
+    TEST_ASSERT_EQUAL_UINT32(before.coalesced + 1U, after.coalesced);
+    TEST_ASSERT_EQUAL_UINT32(before.writes + 1U, after.writes);
+    TEST_ASSERT_EQUAL_UINT32(0U, after.pending);
+}
+
+/**
+ * Test that a continuously changed file is written after the max. delay.
+ */
+static void testMaxDelay()
+{
+    PersistenceService& service = PersistenceService::getInstance();
+    uint32_t            elapsed = 0U;
+
+    service.requestWrite(TEST_FILE_1);
+
+    while(PersistenceService::MAX_DELAY > elapsed)
+    {
+        TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_1));
+
+        advanceMillis(PersistenceService::QUIET_PERIOD / 2U);
+        elapsed += PersistenceService::QUIET_PERIOD / 2U;
+        service.requestWrite(TEST_FILE_1);
+    }
+
+    TEST_ASSERT_TRUE(service.isWriteDue(TEST_FILE_1));
+}
+
+/**
+ * Test a restart with pending writes. The writes are due immediately and
+ * the restart waits until all of them are finished.
+ */
+static void testRestartWithPendingWrites()
+{
+    PersistenceService&             service = PersistenceService::getInstance();
+    PersistenceService::Statistics  statistics;
+
+    service.requestWrite(TEST_FILE_1);
+    service.requestWrite(TEST_FILE_2);
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_1));
+    TEST_ASSERT_FALSE(service.isWriteDue(TEST_FILE_2));
+
+    /* Not stopped yet */
+    TEST_ASSERT_FALSE(service.isFlushFinished());
+
+    /* Restart */
+    service.stop();
+    TEST_ASSERT_TRUE(service.isWriteDue(TEST_FILE_1));
+    TEST_ASSERT_TRUE(service.isWriteDue(TEST_FILE_2));
+    TEST_ASSERT_FALSE(service.isFlushFinished());
+
+    /* The owners write in their own context. */
+    service.reportWrite(TEST_FILE_1, true);
+    TEST_ASSERT_FALSE(service.isFlushFinished());
+
+    service.reportWrite(TEST_FILE_2, false);
+    TEST_ASSERT_TRUE(service.isFlushFinished());
+
+    service.getStatistics(statistics);
+    TEST_ASSERT_EQUAL_UINT32(0U, statistics.pending);
+
+    /* Started again, nothing pending */
+    TEST_ASSERT_TRUE(service.start());
+    TEST_ASSERT_FALSE(service.isFlushFinished());
+}
+
+/**
+ * Test a restart, where a pending write is never finished. The restart
+ * waits only until the flush timeout.
+ */
+static void testRestartFlushTimeout()
+{
+    PersistenceService&             service = PersistenceService::getInstance();
+    PersistenceService::Statistics  statistics;
+
+    service.requestWrite(TEST_FILE_1);
+    service.stop();
+
+    advanceMillis(PersistenceService::FLUSH_TIMEOUT / 2U);
+    TEST_ASSERT_FALSE(service.isFlushFinished());
+
+    advanceMillis(PersistenceService::FLUSH_TIMEOUT / 2U);
+    TEST_ASSERT_TRUE(service.isFlushFinished());
+
+    /* The write is still pending and lost by the restart. */
+    service.getStatistics(statistics);
+    TEST_ASSERT_EQUAL_UINT32(1U, statistics.pending);
+}
@@ -0,0 +1,381 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test polling service.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <PollingService.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t getMaxPeriod(uint32_t period);
+static void testPollingService();
+static void testBackoff();
+static void testBackoffLimit();
+static void testResultWithoutPoll();
+static void testPrefetch();
+static void testJitter();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** UID of the polled test plugin */
+static const uint16_t   TEST_UID    = 1U;
+
+/** Polling period in ms of the test plugin */
+static const uint32_t   TEST_PERIOD = SIMPLE_TIMER_SECONDS(1U);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testPollingService);
+    RUN_TEST(testBackoff);
+    RUN_TEST(testBackoffLimit);
+    RUN_TEST(testResultWithoutPoll);
+    RUN_TEST(testPrefetch);
+    RUN_TEST(testJitter);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    PollingService::getInstance().unregisterPoll(TEST_UID);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the period after which a poll is due in any case, which means
+ * including the max. jitter.
+ *
+ * @param[in] period    Period in ms
+ *
+ * @return Period in ms
+ */
+static uint32_t getMaxPeriod(uint32_t period)
+{
+    return period + (period / PollingService::JITTER_DIVISOR);
+}
+
+/**
+ * Test polling with the regular period.
+ */
+static void testPollingService()
+{
+    PollingService& service = PollingService::getInstance();
+
+    /* Not registered plugin */
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+
+    /* The first poll is due immediately. */
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, TEST_PERIOD, 0U));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    /* No further poll, as long as the result is pending. */
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    /* The period starts with the poll. */
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+    advanceMillis(TEST_PERIOD / 2U);
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    /* A pending result times out, which allows the next poll. */
+    advanceMillis(PollingService::RESULT_TIMEOUT);
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    service.process();
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, false);
+
+    /* A triggered poll is due immediately and cancels the backoff. */
+    service.triggerPoll(TEST_UID);
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    /* A not registered plugin is not polled anymore. */
+    service.unregisterPoll(TEST_UID);
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+
+    return;
+}
+
+/**
+ * Test the exponential backoff after failed polls and its reset after a
+ * successful poll.
+ */
+static void testBackoff()
+{
+    PollingService& service     = PollingService::getInstance();
+    const uint32_t  LONG_PERIOD = SIMPLE_TIMER_HOURS(1U);
+
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, TEST_PERIOD, 0U));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, false);
+
+    /* A short period is extended to the retry period. */
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, false);
+
+    /* Every further failure doubles the retry period. */
+    advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD));
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    advanceMillis(getMaxPeriod(2U * PollingService::RETRY_PERIOD) - getMaxPeriod(PollingService::RETRY_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    /* A successful poll resets the backoff. */
+    service.reportResult(TEST_UID, true);
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    /* A long period is shortened to the retry period. */
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, LONG_PERIOD, 0U));
+    service.reportResult(TEST_UID, false);
+    advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+    advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD));
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+
+    return;
+}
+
+/**
+ * Test that the retry period is limited, independent of the number of
+ * failed polls.
+ */
+static void testBackoffLimit()
+{
+    PollingService& service     = PollingService::getInstance();
+    const uint32_t  FAILURES    = 300U; /* More than fit into the failure counter. */
+    uint32_t        idx         = 0U;
+
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, TEST_PERIOD, 0U));
+
+    for(idx = 0U; idx < FAILURES; ++idx)
+    {
+        TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+        service.reportResult(TEST_UID, false);
+        advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD_MAX));
+    }
+
+    /* The max. retry period is not exceeded. */
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, false);
+    advanceMillis(PollingService::RETRY_PERIOD_MAX / 2U);
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD_MAX) - (PollingService::RETRY_PERIOD_MAX / 2U));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    return;
+}
+
+/**
+ * Test that results are ignored, if no poll is pending. E.g. a closed
+ * connection is reported after the response was already handled.
+ */
+static void testResultWithoutPoll()
+{
+    PollingService& service = PollingService::getInstance();
+
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, TEST_PERIOD, 0U));
+
+    /* No poll yet */
+    service.reportResult(TEST_UID, false);
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    /* Connection closed after the successful response */
+    service.reportResult(TEST_UID, true);
+    service.reportResult(TEST_UID, false);
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+
+    /* Connection closed after the failed response, counts only once. */
+    service.reportResult(TEST_UID, false);
+    service.reportResult(TEST_UID, false);
+    advanceMillis(getMaxPeriod(PollingService::RETRY_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    return;
+}
+
+/**
+ * Test polling depended on the slot schedule.
+ */
+static void testPrefetch()
+{
+    PollingService& service     = PollingService::getInstance();
+    const uint32_t  IDLE_PERIOD = SIMPLE_TIMER_MINUTES(1U);
+
+    /* Slot is disabled and no idle period, therefore never polled. */
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, TEST_PERIOD, 0U));
+    service.clearSchedule();
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+
+    /* Slot is far from activation. */
+    service.setSchedule(TEST_UID, 2U * PollingService::PREFETCH_PERIOD);
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+
+    /* Slot activation comes closer, till it is prefetched. */
+    advanceMillis(PollingService::PREFETCH_PERIOD / 2U);
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    advanceMillis(PollingService::PREFETCH_PERIOD / 2U);
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    /* Slot is active. */
+    service.setSchedule(TEST_UID, 0U);
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    /* Slot is far from activation, but polled with the idle period. */
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, TEST_PERIOD, IDLE_PERIOD));
+    service.setSchedule(TEST_UID, SIMPLE_TIMER_HOURS(1U));
+    advanceMillis(getMaxPeriod(TEST_PERIOD));
+    TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+    advanceMillis(getMaxPeriod(IDLE_PERIOD));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    return;
+}
+
+/**
+ * Test that the period is extended by a random jitter of up to 10 %.
+ */
+static void testJitter()
+{
+    PollingService& service     = PollingService::getInstance();
+    const uint32_t  PERIOD      = SIMPLE_TIMER_SECONDS(100U);
+    const uint32_t  POLLS       = 20U;
+    uint32_t        idx         = 0U;
+    uint32_t        dueCnt      = 0U;
+
+    TEST_ASSERT_TRUE(service.registerPoll(TEST_UID, PERIOD, 0U));
+    TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+    service.reportResult(TEST_UID, true);
+
+    for(idx = 0U; idx < POLLS; ++idx)
+    {
+        /* The period is never shortened. */
+        advanceMillis(PERIOD - SIMPLE_TIMER_SECONDS(1U));
+        TEST_ASSERT_FALSE(service.isPollDue(TEST_UID));
+
+        /* With the period, the poll is only due, if no jitter was chosen. */
+        advanceMillis(SIMPLE_TIMER_SECONDS(1U));
+
+        if (true == service.isPollDue(TEST_UID))
+        {
+            ++dueCnt;
+        }
+        else
+        {
+            /* The max. jitter is never exceeded. */
+            advanceMillis(getMaxPeriod(PERIOD) - PERIOD);
+            TEST_ASSERT_TRUE(service.isPollDue(TEST_UID));
+        }
+
+        service.reportResult(TEST_UID, true);
+    }
+
+    TEST_ASSERT_LESS_THAN_UINT32(POLLS, dueCnt);
+
+    return;
+}
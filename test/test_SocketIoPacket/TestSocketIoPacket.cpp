@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test Socket.IO packet decoder.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <SocketIoPacket.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool decode(SocketIoPacket& packet, const char* text);
+
+static void testEngineIoPackets();
+static void testConnect();
+static void testEvent();
+static void testEventWithNamespaceAndAck();
+static void testInvalidPackets();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testEngineIoPackets);
+    RUN_TEST(testConnect);
+    RUN_TEST(testEvent);
+    RUN_TEST(testEventWithNamespaceAndAck);
+    RUN_TEST(testInvalidPackets);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Decode a packet from a terminated text message.
+ *
+ * @param[in] packet    Packet
+ * @param[in] text      Text message
+ *
+ * @return If successful decoded, it will return true otherwise false.
+ */
+static bool decode(SocketIoPacket& packet, const char* text)
+{
+    return packet.decode(text, strlen(text));
+}
+
+/**
+ * Test the Engine.IO packets.
+ */
+static void testEngineIoPackets()
+{
+    SocketIoPacket  packet;
+    const char*     OPEN    = "0{\"sid\":\"abc\",\"pingInterval\":25000,\"pingTimeout\":5000}";
+    const char*     data    = nullptr;
+    size_t          size    = 0U;
+
+    TEST_ASSERT_TRUE(decode(packet, OPEN));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_OPEN, packet.getType());
+
+    data = packet.getData(size);
+    TEST_ASSERT_EQUAL(&OPEN[1], data);
+    TEST_ASSERT_EQUAL(strlen(OPEN) - 1U, size);
+
+    TEST_ASSERT_TRUE(decode(packet, "1"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_CLOSE, packet.getType());
+    TEST_ASSERT_NULL(packet.getData(size));
+    TEST_ASSERT_EQUAL(0U, size);
+
+    TEST_ASSERT_TRUE(decode(packet, "2"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_PING, packet.getType());
+
+    TEST_ASSERT_TRUE(decode(packet, "3"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_PONG, packet.getType());
+
+    TEST_ASSERT_TRUE(decode(packet, "6"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_OTHER, packet.getType());
+}
+
+/**
+ * Test the Socket.IO connect and disconnect packets.
+ */
+static void testConnect()
+{
+    SocketIoPacket packet;
+
+    TEST_ASSERT_TRUE(decode(packet, "40"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_CONNECT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("/", packet.getNamespace().c_str());
+
+    TEST_ASSERT_TRUE(decode(packet, "40/admin,"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_CONNECT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("/admin", packet.getNamespace().c_str());
+
+    /* The namespace of a previous packet is not kept. */
+    TEST_ASSERT_TRUE(decode(packet, "41"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_DISCONNECT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("/", packet.getNamespace().c_str());
+
+    TEST_ASSERT_TRUE(decode(packet, "43[]"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_OTHER, packet.getType());
+}
+
+/**
+ * Test the Socket.IO event packets.
+ */
+static void testEvent()
+{
+    SocketIoPacket  packet;
+    const char*     PUSH_STATE  = "42[\"pushState\",{\"status\":\"play\",\"title\":\"a]\"}]";
+    const char*     data        = nullptr;
+    size_t          size        = 0U;
+
+    TEST_ASSERT_TRUE(decode(packet, PUSH_STATE));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_EVENT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("pushState", packet.getEventName().c_str());
+
+    data = packet.getData(size);
+    TEST_ASSERT_EQUAL(&PUSH_STATE[15], data);
+    TEST_ASSERT_EQUAL(strlen("{\"status\":\"play\",\"title\":\"a]\"}"), size);
+    TEST_ASSERT_EQUAL('{', data[0]);
+    TEST_ASSERT_EQUAL('}', data[size - 1U]);
+
+    /* Event without arguments */
+    TEST_ASSERT_TRUE(decode(packet, "42[\"getState\"]"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_EVENT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("getState", packet.getEventName().c_str());
+    TEST_ASSERT_NULL(packet.getData(size));
+    TEST_ASSERT_EQUAL(0U, size);
+}
+
+/**
+ * Test a Socket.IO event packet with namespace and acknowledge id.
+ */
+static void testEventWithNamespaceAndAck()
+{
+    SocketIoPacket  packet;
+    const char*     data    = nullptr;
+    size_t          size    = 0U;
+
+    TEST_ASSERT_TRUE(decode(packet, "42/volumio,12[\"hello\",1,2]"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_EVENT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("/volumio", packet.getNamespace().c_str());
+    TEST_ASSERT_EQUAL_STRING("hello", packet.getEventName().c_str());
+
+    data = packet.getData(size);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL(3U, size);
+    TEST_ASSERT_EQUAL(0, strncmp("1,2", data, size));
+
+    TEST_ASSERT_TRUE(decode(packet, "427[\"hello\"]"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_EVENT, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("/", packet.getNamespace().c_str());
+    TEST_ASSERT_EQUAL_STRING("hello", packet.getEventName().c_str());
+}
+
+/**
+ * Test invalid packets. They shall not be decoded and leave a invalid packet.
+ */
+static void testInvalidPackets()
+{
+    SocketIoPacket  packet;
+    size_t          size    = 0U;
+
+    TEST_ASSERT_FALSE(packet.decode(nullptr, 0U));
+    TEST_ASSERT_FALSE(decode(packet, ""));
+    TEST_ASSERT_FALSE(decode(packet, "x"));
+    TEST_ASSERT_FALSE(decode(packet, "4"));
+    TEST_ASSERT_FALSE(decode(packet, "49"));
+    TEST_ASSERT_FALSE(decode(packet, "42"));
+    TEST_ASSERT_FALSE(decode(packet, "42{}"));
+    TEST_ASSERT_FALSE(decode(packet, "42[\"pushState\""));
+    TEST_ASSERT_FALSE(decode(packet, "42[\"pushState]"));
+    TEST_ASSERT_FALSE(decode(packet, "42[\"pushState\"{}]"));
+
+    /* A previous valid packet is cleared. */
+    TEST_ASSERT_TRUE(decode(packet, "42/admin,[\"a\",1]"));
+    TEST_ASSERT_FALSE(decode(packet, "42/admin,[1]"));
+    TEST_ASSERT_EQUAL(SocketIoPacket::TYPE_INVALID, packet.getType());
+    TEST_ASSERT_EQUAL_STRING("/", packet.getNamespace().c_str());
+    TEST_ASSERT_EQUAL_STRING("", packet.getEventName().c_str());
+    TEST_ASSERT_NULL(packet.getData(size));
+}
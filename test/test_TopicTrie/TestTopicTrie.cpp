@@ -0,0 +1,279 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test topic trie.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <TopicTrie.hpp>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t matchSum(TopicTrie<uint32_t>& trie, const char* topic);
+
+static void testInsertRemove();
+static void testExactMatch();
+static void testWildcardMatch();
+static void testForEachTopic();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testInsertRemove);
+    RUN_TEST(testExactMatch);
+    RUN_TEST(testWildcardMatch);
+    RUN_TEST(testForEachTopic);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Match a topic and sum up the values of all matching topic filters.
+ *
+ * @param[in] trie  Topic trie
+ * @param[in] topic Topic
+ *
+ * @return Sum of all matching values
+ */
+static uint32_t matchSum(TopicTrie<uint32_t>& trie, const char* topic)
+{
+    uint32_t sum = 0U;
+
+    (void)trie.match(topic, [&sum](uint32_t& value) {
+        sum += value;
+    });
+
+    return sum;
+}
+
+/**
+ * Test inserting and removing topic filters.
+ */
+static void testInsertRemove()
+{
+    TopicTrie<uint32_t> trie;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, trie.size());
+
+    /* Invalid topic filters */
+    TEST_ASSERT_FALSE(trie.insert(nullptr, 1U));
+    TEST_ASSERT_FALSE(trie.insert("", 1U));
+    TEST_ASSERT_FALSE(trie.insert("a/b+", 1U));
+    TEST_ASSERT_FALSE(trie.insert("a/#/b", 1U));
+    TEST_ASSERT_FALSE(trie.insert("a#", 1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, trie.size());
+
+    /* Valid topic filters */
+    TEST_ASSERT_TRUE(trie.insert("a/b/c", 1U));
+    TEST_ASSERT_TRUE(trie.insert("a/b", 2U));
+    TEST_ASSERT_TRUE(trie.insert("a/+/c", 3U));
+    TEST_ASSERT_TRUE(trie.insert("#", 4U));
+    TEST_ASSERT_EQUAL_UINT32(4U, trie.size());
+
+    /* Replacing a value doesn't change the size. */
+    TEST_ASSERT_TRUE(trie.insert("a/b", 5U));
+    TEST_ASSERT_EQUAL_UINT32(4U, trie.size());
+    TEST_ASSERT_NOT_NULL(trie.find("a/b"));
+    TEST_ASSERT_EQUAL_UINT32(5U, *trie.find("a/b"));
+
+    /* Wildcards are not resolved by find. */
+    TEST_ASSERT_NULL(trie.find("a"));
+    TEST_ASSERT_NULL(trie.find("a/x/c"));
+    TEST_ASSERT_NOT_NULL(trie.find("a/+/c"));
+
+    /* Remove */
+    TEST_ASSERT_FALSE(trie.remove("a"));
+    TEST_ASSERT_FALSE(trie.remove("x/y"));
+    TEST_ASSERT_TRUE(trie.remove("a/b"));
+    TEST_ASSERT_FALSE(trie.remove("a/b"));
+    TEST_ASSERT_EQUAL_UINT32(3U, trie.size());
+    TEST_ASSERT_NOT_NULL(trie.find("a/b/c"));
+    TEST_ASSERT_TRUE(trie.remove("a/b/c"));
+    TEST_ASSERT_NULL(trie.find("a/b/c"));
+    TEST_ASSERT_EQUAL_UINT32(2U, trie.size());
+
+    trie.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, trie.size());
+    TEST_ASSERT_NULL(trie.find("#"));
+
+    return;
+}
+
+/**
+ * Test matching topics without wildcard subscriptions.
+ */
+static void testExactMatch()
+{
+    TopicTrie<uint32_t> trie;
+
+    TEST_ASSERT_TRUE(trie.insert("display/power/set", 1U));
+    TEST_ASSERT_TRUE(trie.insert("display/power", 2U));
+    TEST_ASSERT_TRUE(trie.insert("display/brightness/set", 4U));
+    TEST_ASSERT_TRUE(trie.insert("/leading", 8U));
+
+    TEST_ASSERT_EQUAL_UINT32(1U, matchSum(trie, "display/power/set"));
+    TEST_ASSERT_EQUAL_UINT32(2U, matchSum(trie, "display/power"));
+    TEST_ASSERT_EQUAL_UINT32(4U, matchSum(trie, "display/brightness/set"));
+    TEST_ASSERT_EQUAL_UINT32(8U, matchSum(trie, "/leading"));
+    TEST_ASSERT_EQUAL_UINT32(0U, matchSum(trie, "display"));
+    TEST_ASSERT_EQUAL_UINT32(0U, matchSum(trie, "display/pow"));
+    TEST_ASSERT_EQUAL_UINT32(0U, matchSum(trie, "display/power/set/x"));
+    TEST_ASSERT_EQUAL_UINT32(0U, matchSum(trie, "leading"));
+
+    return;
+}
+
+/**
+ * Test matching topics with wildcard subscriptions.
+ */
+static void testWildcardMatch()
+{
+    TopicTrie<uint32_t> trie;
+
+    TEST_ASSERT_TRUE(trie.insert("a/+/c", 1U));
+    TEST_ASSERT_TRUE(trie.insert("a/#", 2U));
+    TEST_ASSERT_TRUE(trie.insert("a/b/c", 4U));
+    TEST_ASSERT_TRUE(trie.insert("+/b/+", 8U));
+    TEST_ASSERT_TRUE(trie.insert("#", 16U));
+
+    TEST_ASSERT_EQUAL_UINT32(1U + 2U + 4U + 8U + 16U, matchSum(trie, "a/b/c"));
+    TEST_ASSERT_EQUAL_UINT32(1U + 2U + 16U, matchSum(trie, "a/x/c"));
+    TEST_ASSERT_EQUAL_UINT32(2U + 8U + 16U, matchSum(trie, "a/b/x"));
+    TEST_ASSERT_EQUAL_UINT32(8U + 16U, matchSum(trie, "x/b/y"));
+
+    /* The multi-level wildcard matches the parent level too. */
+    TEST_ASSERT_EQUAL_UINT32(2U + 16U, matchSum(trie, "a"));
+
+    /* Single level wildcard matches exactly one level. */
+    TEST_ASSERT_EQUAL_UINT32(2U + 16U, matchSum(trie, "a/b/c/d"));
+
+    /* Topics starting with '$' are not matched by wildcards in the first level. */
+    TEST_ASSERT_EQUAL_UINT32(0U, matchSum(trie, "$SYS/b/c"));
+    TEST_ASSERT_TRUE(trie.insert("$SYS/#", 32U));
+    TEST_ASSERT_EQUAL_UINT32(32U, matchSum(trie, "$SYS/b/c"));
+
+    return;
+}
+
+/**
+ * Test iterating over all topic filters.
+ */
+static void testForEachTopic()
+{
+    TopicTrie<uint32_t> trie;
+    uint32_t            count   = 0U;
+    uint32_t            sum     = 0U;
+
+    TEST_ASSERT_TRUE(trie.insert("a/b", 1U));
+    TEST_ASSERT_TRUE(trie.insert("a", 2U));
+    TEST_ASSERT_TRUE(trie.insert("/c/+", 4U));
+    TEST_ASSERT_TRUE(trie.insert("#", 8U));
+
+    trie.forEachTopic([&count, &sum, &trie](const String& filter, uint32_t& value) {
+        uint32_t* found = trie.find(filter.c_str());
+
+        TEST_ASSERT_NOT_NULL(found);
+        TEST_ASSERT_EQUAL_UINT32(value, *found);
+
+        ++count;
+        sum += value;
+    });
+
+    TEST_ASSERT_EQUAL_UINT32(4U, count);
+    TEST_ASSERT_EQUAL_UINT32(1U + 2U + 4U + 8U, sum);
+
+    return;
+}
@@ -0,0 +1,218 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test hot path event tracer.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Tracer.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testRecord();
+static void testScope();
+static void testOverwrite();
+static void testDisabled();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Buffer for the read events. */
+static Tracer::Event    gEvents[Tracer::MAX_EVENTS];
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testRecord);
+    RUN_TEST(testScope);
+    RUN_TEST(testOverwrite);
+    RUN_TEST(testDisabled);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    Tracer::getInstance().setEnabled(true);
+    Tracer::getInstance().clear();
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test recording and reading events in order.
+ */
+static void testRecord()
+{
+    Tracer& tracer  = Tracer::getInstance();
+    size_t  count   = 0U;
+
+    TEST_ASSERT_EQUAL(0U, tracer.getEvents(gEvents, Tracer::MAX_EVENTS));
+
+    tracer.record(Tracer::EVENT_TYPE_BEGIN, "a", 0U);
+    tracer.record(Tracer::EVENT_TYPE_INSTANT, "b", 42U);
+    tracer.record(Tracer::EVENT_TYPE_END, "a", 0U);
+
+    count = tracer.getEvents(gEvents, Tracer::MAX_EVENTS);
+    TEST_ASSERT_EQUAL(3U, count);
+
+    TEST_ASSERT_EQUAL_STRING("a", gEvents[0].name);
+    TEST_ASSERT_EQUAL(Tracer::EVENT_TYPE_BEGIN, gEvents[0].type);
+    TEST_ASSERT_EQUAL_STRING("b", gEvents[1].name);
+    TEST_ASSERT_EQUAL(Tracer::EVENT_TYPE_INSTANT, gEvents[1].type);
+    TEST_ASSERT_EQUAL_UINT32(42U, gEvents[1].id);
+    TEST_ASSERT_EQUAL_STRING("a", gEvents[2].name);
+    TEST_ASSERT_EQUAL(Tracer::EVENT_TYPE_END, gEvents[2].type);
+
+    /* Timestamps never decrease. */
+    TEST_ASSERT_TRUE(gEvents[0].timestamp <= gEvents[1].timestamp);
+    TEST_ASSERT_TRUE(gEvents[1].timestamp <= gEvents[2].timestamp);
+
+    /* Reading doesn't remove the events. */
+    TEST_ASSERT_EQUAL(3U, tracer.getEvents(gEvents, Tracer::MAX_EVENTS));
+
+    /* Only the newest events are read, if the buffer is too small. */
+    TEST_ASSERT_EQUAL(1U, tracer.getEvents(gEvents, 1U));
+    TEST_ASSERT_EQUAL(Tracer::EVENT_TYPE_END, gEvents[0].type);
+
+    tracer.clear();
+    TEST_ASSERT_EQUAL(0U, tracer.getEvents(gEvents, Tracer::MAX_EVENTS));
+}
+
+/**
+ * Test tracing a scope.
+ */
+static void testScope()
+{
+    {
+        TraceScope traceScope("scope", 7U);
+
+        TEST_ASSERT_EQUAL(1U, Tracer::getInstance().getEvents(gEvents, Tracer::MAX_EVENTS));
+        TEST_ASSERT_EQUAL(Tracer::EVENT_TYPE_BEGIN, gEvents[0].type);
+    }
+
+    TEST_ASSERT_EQUAL(2U, Tracer::getInstance().getEvents(gEvents, Tracer::MAX_EVENTS));
+    TEST_ASSERT_EQUAL(Tracer::EVENT_TYPE_END, gEvents[1].type);
+    TEST_ASSERT_EQUAL_STRING("scope", gEvents[1].name);
+    TEST_ASSERT_EQUAL_UINT32(7U, gEvents[1].id);
+}
+
+/**
+ * Test that the oldest events are overwritten.
+ */
+static void testOverwrite()
+{
+    Tracer&     tracer  = Tracer::getInstance();
+    uint32_t    idx     = 0U;
+
+    for(idx = 0U; idx < (CONFIG_TRACE_BUFFER_SIZE + 10U); ++idx)
+    {
+        tracer.record(Tracer::EVENT_TYPE_INSTANT, "x", idx);
+    }
+
+    TEST_ASSERT_EQUAL(CONFIG_TRACE_BUFFER_SIZE, tracer.getEvents(gEvents, Tracer::MAX_EVENTS));
+    TEST_ASSERT_EQUAL_UINT32(10U, gEvents[0].id);
+    TEST_ASSERT_EQUAL_UINT32(CONFIG_TRACE_BUFFER_SIZE + 9U, gEvents[CONFIG_TRACE_BUFFER_SIZE - 1U].id);
+}
+
+/**
+ * Test that no events are recorded, while recording is disabled.
+ */
+static void testDisabled()
+{
+    Tracer& tracer = Tracer::getInstance();
+
+    tracer.setEnabled(false);
+    tracer.record(Tracer::EVENT_TYPE_INSTANT, "x", 0U);
+    TEST_ASSERT_EQUAL(0U, tracer.getEvents(gEvents, Tracer::MAX_EVENTS));
+
+    /* Reading keeps recording disabled. */
+    TEST_ASSERT_FALSE(tracer.isEnabled());
+
+    tracer.setEnabled(true);
+    tracer.record(Tracer::EVENT_TYPE_INSTANT, "x", 0U);
+    TEST_ASSERT_EQUAL(1U, tracer.getEvents(gEvents, Tracer::MAX_EVENTS));
+}
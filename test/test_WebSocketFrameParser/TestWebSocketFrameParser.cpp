@@ -0,0 +1,507 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test websocket frame parser.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <WebSocketFrameParser.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testTextMessage();
+static void testFragmentedMessage();
+static void testSplitData();
+static void testExtendedLength();
+static void testMaskedFrame();
+static void testControlFrames();
+static void testFragmentedControlFrame();
+static void testControlFrameTooLong();
+static void testOversizedLength();
+static void testMessageTooLong();
+static void testBinaryMessage();
+static void testUnexpectedContinuation();
+static void testReservedOpcode();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testTextMessage);
+    RUN_TEST(testFragmentedMessage);
+    RUN_TEST(testSplitData);
+    RUN_TEST(testExtendedLength);
+    RUN_TEST(testMaskedFrame);
+    RUN_TEST(testControlFrames);
+    RUN_TEST(testFragmentedControlFrame);
+    RUN_TEST(testControlFrameTooLong);
+    RUN_TEST(testOversizedLength);
+    RUN_TEST(testMessageTooLong);
+    RUN_TEST(testBinaryMessage);
+    RUN_TEST(testUnexpectedContinuation);
+    RUN_TEST(testReservedOpcode);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test a single unfragmented text message.
+ */
+static void testTextMessage()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  = { 0x81U, 0x05U, 'H', 'e', 'l', 'l', 'o' };
+    size_t                  index   = 0U;
+    size_t                  size    = 0U;
+    char*                   text    = nullptr;
+
+    /* No text available yet. */
+    TEST_ASSERT_NULL(parser.takeText(size));
+    TEST_ASSERT_EQUAL(0U, size);
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(sizeof(DATA), index);
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL(5U, size);
+    TEST_ASSERT_EQUAL_STRING("Hello", text);
+    delete[] text;
+
+    /* The text can be taken only once. */
+    TEST_ASSERT_NULL(parser.takeText(size));
+
+    /* All data is parsed. */
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_NONE, parser.parse(DATA, sizeof(DATA), index));
+}
+
+/**
+ * Test a fragmented text message with a control frame in between,
+ * see RFC6455 chapter 5.6.
+ */
+static void testFragmentedMessage()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]      =
+    {
+        0x01U, 0x03U, 'H', 'e', 'l',    /* Text, not final */
+        0x89U, 0x01U, 'p',              /* Ping */
+        0x80U, 0x02U, 'l', 'o'          /* Continuation, final */
+    };
+    size_t                  index       = 0U;
+    size_t                  size        = 0U;
+    char*                   text        = nullptr;
+    const uint8_t*          payload     = nullptr;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_PING, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(8U, index);
+    TEST_ASSERT_NULL(parser.takeText(size));
+
+    payload = parser.getCtrlPayload(size);
+    TEST_ASSERT_EQUAL(1U, size);
+    TEST_ASSERT_EQUAL('p', payload[0]);
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(sizeof(DATA), index);
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL(5U, size);
+    TEST_ASSERT_EQUAL_STRING("Hello", text);
+    delete[] text;
+}
+
+/**
+ * Test frames, which are received byte by byte.
+ */
+static void testSplitData()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  =
+    {
+        0x81U, 0x02U, 'h', 'i',
+        0x81U, 0x00U
+    };
+    size_t                  pos     = 0U;
+    size_t                  size    = 0U;
+    char*                   text    = nullptr;
+
+    for(pos = 0U; pos < 3U; ++pos)
+    {
+        size_t index = 0U;
+
+        TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_NONE, parser.parse(&DATA[pos], 1U, index));
+        TEST_ASSERT_EQUAL(1U, index);
+    }
+
+    /* The last byte completes the message. */
+    pos = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(&DATA[3], 1U, pos));
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL_STRING("hi", text);
+    delete[] text;
+
+    /* A empty text message */
+    pos = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_NONE, parser.parse(&DATA[4], 1U, pos));
+    pos = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(&DATA[5], 1U, pos));
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL(0U, size);
+    TEST_ASSERT_EQUAL_STRING("", text);
+    delete[] text;
+}
+
+/**
+ * Test a text message with a 16-bit and 64-bit extended payload length.
+ */
+static void testExtendedLength()
+{
+    WebSocketFrameParser    parser;
+    const size_t            PAYLOAD_SIZE    = 300U;
+    const size_t            HEADER_SIZE_16  = 4U;
+    const size_t            HEADER_SIZE_64  = 10U;
+    uint8_t                 data[HEADER_SIZE_64 + PAYLOAD_SIZE];
+    size_t                  index           = 0U;
+    size_t                  size            = 0U;
+    char*                   text            = nullptr;
+
+    memset(data, 'a', sizeof(data));
+
+    /* 16-bit payload length in network byte order */
+    data[0] = 0x81U;
+    data[1] = 126U;
+    data[2] = static_cast<uint8_t>(PAYLOAD_SIZE >> 8U);
+    data[3] = static_cast<uint8_t>(PAYLOAD_SIZE);
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(data, HEADER_SIZE_16 + PAYLOAD_SIZE, index));
+    TEST_ASSERT_EQUAL(HEADER_SIZE_16 + PAYLOAD_SIZE, index);
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL(PAYLOAD_SIZE, size);
+    TEST_ASSERT_EQUAL('a', text[PAYLOAD_SIZE - 1U]);
+    TEST_ASSERT_EQUAL('\0', text[PAYLOAD_SIZE]);
+    delete[] text;
+
+    /* 64-bit payload length in network byte order */
+    memset(data, 0, HEADER_SIZE_64);
+    data[0] = 0x81U;
+    data[1] = 127U;
+    data[8] = static_cast<uint8_t>(PAYLOAD_SIZE >> 8U);
+    data[9] = static_cast<uint8_t>(PAYLOAD_SIZE);
+
+    index = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(data, sizeof(data), index));
+    TEST_ASSERT_EQUAL(sizeof(data), index);
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL(PAYLOAD_SIZE, size);
+    delete[] text;
+}
+
+/**
+ * Test a masked frame, which a server shall not send.
+ */
+static void testMaskedFrame()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  = { 0x81U, 0x82U, 0x01U, 0x02U, 0x03U, 0x04U, 'h' ^ 0x01U, 'i' ^ 0x02U };
+    const uint8_t           VALID[] = { 0x81U, 0x02U, 'h', 'i' };
+    size_t                  index   = 0U;
+    size_t                  size    = 0U;
+    char*                   text    = nullptr;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(2U, index);
+
+    /* The parser stays in error state until it is reset. */
+    index = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(VALID, sizeof(VALID), index));
+    TEST_ASSERT_EQUAL(0U, index);
+
+    parser.reset();
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(VALID, sizeof(VALID), index));
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL_STRING("hi", text);
+    delete[] text;
+}
+
+/**
+ * Test ping, pong and close control frames.
+ */
+static void testControlFrames()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]      =
+    {
+        0x89U, 0x02U, 'a', 'b',     /* Ping */
+        0x8AU, 0x01U, 'c',          /* Pong */
+        0x88U, 0x02U, 0x03U, 0xE8U  /* Close with status code 1000 */
+    };
+    size_t                  index       = 0U;
+    size_t                  size        = 0U;
+    const uint8_t*          payload     = nullptr;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_PING, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(4U, index);
+
+    payload = parser.getCtrlPayload(size);
+    TEST_ASSERT_EQUAL(2U, size);
+    TEST_ASSERT_EQUAL('a', payload[0]);
+    TEST_ASSERT_EQUAL('b', payload[1]);
+
+    /* The pong is consumed without any event. */
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_CLOSE, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(sizeof(DATA), index);
+
+    payload = parser.getCtrlPayload(size);
+    TEST_ASSERT_EQUAL(2U, size);
+    TEST_ASSERT_EQUAL(0x03U, payload[0]);
+    TEST_ASSERT_EQUAL(0xE8U, payload[1]);
+}
+
+/**
+ * Test a fragmented control frame, which is not allowed.
+ */
+static void testFragmentedControlFrame()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  = { 0x09U, 0x01U, 'a' };
+    size_t                  index   = 0U;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(2U, index);
+}
+
+/**
+ * Test a control frame with a payload greater than allowed.
+ */
+static void testControlFrameTooLong()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  = { 0x89U, 126U, 0x00U, 126U };
+    size_t                  index   = 0U;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(sizeof(DATA), index);
+}
+
+/**
+ * Test a 64-bit payload length, which doesn't fit into 32-bit.
+ */
+static void testOversizedLength()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  = { 0x81U, 127U, 0x00U, 0x00U, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x00U, 'a' };
+    size_t                  index   = 0U;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(10U, index);
+}
+
+/**
+ * Test a fragmented message, which exceeds the max. message size. It shall
+ * be discarded, but the following message shall be received.
+ */
+static void testMessageTooLong()
+{
+    WebSocketFrameParser    parser;
+    const size_t            FRAGMENT_SIZE   = WebSocketFrameParser::MAX_MESSAGE_SIZE / 2U + 1U;
+    const size_t            HEADER_SIZE     = 4U;
+    uint8_t                 fragment[HEADER_SIZE + FRAGMENT_SIZE];
+    const uint8_t           NEXT[]          = { 0x81U, 0x02U, 'o', 'k' };
+    size_t                  index           = 0U;
+    size_t                  size            = 0U;
+    char*                   text            = nullptr;
+
+    memset(fragment, 'a', sizeof(fragment));
+    fragment[0] = 0x01U; /* Text, not final */
+    fragment[1] = 126U;
+    fragment[2] = static_cast<uint8_t>(FRAGMENT_SIZE >> 8U);
+    fragment[3] = static_cast<uint8_t>(FRAGMENT_SIZE);
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_NONE, parser.parse(fragment, sizeof(fragment), index));
+    TEST_ASSERT_EQUAL(sizeof(fragment), index);
+
+    /* Second fragment exceeds the max. message size. */
+    fragment[0] = 0x80U; /* Continuation, final */
+    index       = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_NONE, parser.parse(fragment, sizeof(fragment), index));
+    TEST_ASSERT_EQUAL(sizeof(fragment), index);
+    TEST_ASSERT_NULL(parser.takeText(size));
+
+    index = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(NEXT, sizeof(NEXT), index));
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL_STRING("ok", text);
+    delete[] text;
+}
+
+/**
+ * Test a binary message, which is discarded.
+ */
+static void testBinaryMessage()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           DATA[]  =
+    {
+        0x02U, 0x01U, 0x00U,        /* Binary, not final */
+        0x80U, 0x01U, 0x01U,        /* Continuation, final */
+        0x81U, 0x01U, 'x'           /* Text */
+    };
+    size_t                  index   = 0U;
+    size_t                  size    = 0U;
+    char*                   text    = nullptr;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_TEXT, parser.parse(DATA, sizeof(DATA), index));
+    TEST_ASSERT_EQUAL(sizeof(DATA), index);
+
+    text = parser.takeText(size);
+    TEST_ASSERT_NOT_NULL(text);
+    TEST_ASSERT_EQUAL_STRING("x", text);
+    delete[] text;
+}
+
+/**
+ * Test a continuation frame without a started message and a new message
+ * while a fragmented message is pending.
+ */
+static void testUnexpectedContinuation()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           CONTINUATION[]  = { 0x80U, 0x01U, 'a' };
+    const uint8_t           INTERLEAVED[]   = { 0x01U, 0x01U, 'a', 0x81U, 0x01U, 'b' };
+    size_t                  index           = 0U;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(CONTINUATION, sizeof(CONTINUATION), index));
+
+    parser.reset();
+    index = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(INTERLEAVED, sizeof(INTERLEAVED), index));
+    TEST_ASSERT_EQUAL(5U, index);
+}
+
+/**
+ * Test reserved opcodes and reserved bits, which are not negotiated.
+ */
+static void testReservedOpcode()
+{
+    WebSocketFrameParser    parser;
+    const uint8_t           RESERVED_DATA[] = { 0x83U, 0x00U };
+    const uint8_t           RESERVED_CTRL[] = { 0x8BU, 0x00U };
+    const uint8_t           RESERVED_BITS[] = { 0xC1U, 0x00U };
+    size_t                  index           = 0U;
+
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(RESERVED_DATA, sizeof(RESERVED_DATA), index));
+
+    parser.reset();
+    index = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(RESERVED_CTRL, sizeof(RESERVED_CTRL), index));
+
+    parser.reset();
+    index = 0U;
+    TEST_ASSERT_EQUAL(WebSocketFrameParser::EVENT_ERROR, parser.parse(RESERVED_BITS, sizeof(RESERVED_BITS), index));
+}
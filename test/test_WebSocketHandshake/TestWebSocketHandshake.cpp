@@ -0,0 +1,331 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test websocket opening handshake.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <WebSocketHandshake.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static WebSocketHandshake::Result parse(WebSocketHandshake& handshake, const char* response, size_t& index);
+
+static void testAcceptValue();
+static void testRequest();
+static void testAccepted();
+static void testFragmentedResponse();
+static void testAcceptMismatch();
+static void testMissingUpgrade();
+static void testRejectedStatus();
+static void testLineTooLong();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Sample handshake key, see RFC6455 chapter 1.3. */
+static const char*  SAMPLE_KEY      = "dGhlIHNhbXBsZSBub25jZQ==";
+
+/** Accept value of the sample handshake key, see RFC6455 chapter 1.3. */
+static const char*  SAMPLE_ACCEPT   = "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testAcceptValue);
+    RUN_TEST(testRequest);
+    RUN_TEST(testAccepted);
+    RUN_TEST(testFragmentedResponse);
+    RUN_TEST(testAcceptMismatch);
+    RUN_TEST(testMissingUpgrade);
+    RUN_TEST(testRejectedStatus);
+    RUN_TEST(testLineTooLong);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Parse a handshake response.
+ *
+ * @param[in]       handshake   Handshake
+ * @param[in]       response    Response
+ * @param[in,out]   index       Index of the next byte, which to parse.
+ *
+ * @return Handshake result
+ */
+static WebSocketHandshake::Result parse(WebSocketHandshake& handshake, const char* response, size_t& index)
+{
+    const void* vResponse = response;
+
+    return handshake.parse(static_cast<const uint8_t*>(vResponse), strlen(response), index);
+}
+
+/**
+ * Test the accept value calculation with the sample of RFC6455.
+ */
+static void testAcceptValue()
+{
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ACCEPT, WebSocketHandshake::getAcceptValue(SAMPLE_KEY).c_str());
+}
+
+/**
+ * Test the handshake request.
+ */
+static void testRequest()
+{
+    WebSocketHandshake  handshake;
+    String              request;
+
+    handshake.begin(SAMPLE_KEY);
+    request = handshake.getRequest("volumio", 3000U, "/socket.io/?EIO=3&transport=websocket");
+
+    TEST_ASSERT_EQUAL_STRING(
+        "GET /socket.io/?EIO=3&transport=websocket HTTP/1.1\r\n"
+        "Host: volumio:3000\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "\r\n",
+        request.c_str());
+}
+
+/**
+ * Test a accepted handshake. The data after the response header belongs
+ * to the websocket frames and shall not be parsed.
+ */
+static void testAccepted()
+{
+    WebSocketHandshake  handshake;
+    size_t              index       = 0U;
+    const char*         RESPONSE    =
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "upgrade: WebSocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept:  s3pPLMBiTxaQ9kYGzzhZRbK+xOo= \r\n"
+        "\r\n"
+        "\x81\x02hi";
+
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_ACCEPTED, parse(handshake, RESPONSE, index));
+    TEST_ASSERT_EQUAL(strlen(RESPONSE) - 4U, index);
+
+    /* The result is kept. */
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_ACCEPTED, parse(handshake, RESPONSE, index));
+    TEST_ASSERT_EQUAL(strlen(RESPONSE) - 4U, index);
+
+    /* A new handshake starts from scratch. */
+    index = 0U;
+    handshake.begin("AAAAAAAAAAAAAAAAAAAAAA==");
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, RESPONSE, index));
+}
+
+/**
+ * Test a handshake response, which is received in several parts with single
+ * LF line ends.
+ */
+static void testFragmentedResponse()
+{
+    WebSocketHandshake  handshake;
+    size_t              index       = 0U;
+    const char*         RESPONSE    =
+        "HTTP/1.1 101 Switching Protocols\n"
+        "Upgrade: websocket\n"
+        "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\n"
+        "\n";
+    const void*         vResponse   = RESPONSE;
+    const uint8_t*      data        = static_cast<const uint8_t*>(vResponse);
+    size_t              len         = strlen(RESPONSE);
+
+    handshake.begin(SAMPLE_KEY);
+
+    /* Byte by byte */
+    while((len - 1U) > index)
+    {
+        size_t partIndex = 0U;
+
+        TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_PENDING, handshake.parse(&data[index], 1U, partIndex));
+        TEST_ASSERT_EQUAL(1U, partIndex);
+        ++index;
+    }
+
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_ACCEPTED, handshake.parse(data, len, index));
+    TEST_ASSERT_EQUAL(len, index);
+}
+
+/**
+ * Test a handshake, where the server responds with a wrong accept value.
+ */
+static void testAcceptMismatch()
+{
+    WebSocketHandshake  handshake;
+    size_t              index       = 0U;
+    const char*         RESPONSE    =
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Sec-WebSocket-Accept: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "\r\n";
+
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, RESPONSE, index));
+
+    /* Without any accept value */
+    index = 0U;
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n\r\n", index));
+}
+
+/**
+ * Test a handshake, where the server doesn't upgrade to websocket.
+ */
+static void testMissingUpgrade()
+{
+    WebSocketHandshake  handshake;
+    size_t              index       = 0U;
+    const char*         RESPONSE    =
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: h2c\r\n"
+        "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"
+        "\r\n";
+
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, RESPONSE, index));
+}
+
+/**
+ * Test a handshake, where the server doesn't switch the protocol. The
+ * parsing stops at the status line.
+ */
+static void testRejectedStatus()
+{
+    WebSocketHandshake  handshake;
+    size_t              index       = 0U;
+    const char*         STATUS_LINE = "HTTP/1.1 400 Bad Request\r\n";
+    String              response    = STATUS_LINE;
+
+    response += "Upgrade: websocket\r\n";
+    response += "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n";
+    response += "\r\n";
+
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, response.c_str(), index));
+    TEST_ASSERT_EQUAL(strlen(STATUS_LINE), index);
+
+    /* Header line without colon */
+    index = 0U;
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, "HTTP/1.1 101 Switching Protocols\r\nUpgrade websocket\r\n\r\n", index));
+}
+
+/**
+ * Test a handshake response with a line, which is too long.
+ */
+static void testLineTooLong()
+{
+    WebSocketHandshake  handshake;
+    size_t              index       = 0U;
+    String              response    = "HTTP/1.1 101 Switching Protocols\r\nX-Padding: ";
+    size_t              count       = 0U;
+
+    for(count = 0U; count < WebSocketHandshake::MAX_LINE_LENGTH; ++count)
+    {
+        response += 'x';
+    }
+
+    response += "\r\n\r\n";
+
+    handshake.begin(SAMPLE_KEY);
+    TEST_ASSERT_EQUAL(WebSocketHandshake::RESULT_REJECTED, parse(handshake, response.c_str(), index));
+    TEST_ASSERT_LESS_THAN(response.length(), index);
+}